@@ -25,6 +25,29 @@ void on_success(uintptr_t ptr, const core::CommandResponse* message);
 void on_failure(uintptr_t ptr, const char* message,
                 core::RequestErrorType type);
 
+/**
+ * Callback function called when the server invalidates keys read by the
+ * client. The keys must be copied before the function returns.
+ * @param ptr The pointer to the NearCache object.
+ * @param keys The invalidated keys, or null if every key is invalidated.
+ * @param key_lens The lengths of the invalidated keys.
+ * @param key_count The number of invalidated keys.
+ */
+void on_invalidation(uintptr_t ptr, const uint8_t* const* keys,
+                     const uintptr_t* key_lens, uintptr_t key_count);
+
+/**
+ * Callback function called with each batch of keys found by a parallel scan.
+ * The keys are copied before being passed on.
+ * @param ptr The pointer to the std::function receiving the keys, deleted
+ * once the scan has ended.
+ * @param keys The keys found, or null once the scan has ended.
+ * @param key_lens The lengths of the keys.
+ * @param key_count The number of keys.
+ */
+void on_scan_keys(uintptr_t ptr, const uint8_t* const* keys,
+                  const uintptr_t* key_lens, uintptr_t key_count);
+
 }  // namespace glide
 
 #endif
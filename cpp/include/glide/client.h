@@ -5,16 +5,40 @@
 #include <absl/status/statusor.h>
 
 #include <cstdint>
+#include <functional>
 #include <map>
+#include <memory>
+#include <optional>
 #include <string>
 #include <vector>
 
 #include "config.h"
+#include "glide/coalescer.h"
 #include "glide/future.h"
+#include "glide/near_cache.h"
+#include "glide/stats.h"
 #include "glide_base.h"
 
 namespace glide {
 
+/**
+ * Options of Client::scanParallel().
+ */
+struct ParallelScanOptions {
+  /** The pattern keys must match, or all keys if not set. */
+  std::optional<std::string> match_pattern;
+  /** The COUNT hint sent with each SCAN command, 0 for the server's default. */
+  uint32_t count = 0;
+  /** The type keys must have, e.g. "hash", or any type if not set. */
+  std::optional<std::string> type;
+  /** The number of nodes scanned at the same time, 0 for the default. */
+  uint32_t concurrency = 0;
+  /** An upper bound on the SCAN commands sent per second, 0 for none. */
+  uint32_t max_scans_per_second = 0;
+  /** Scan the covered slots instead of failing when some aren't covered. */
+  bool allow_non_covered_slots = false;
+};
+
 /**
  * The Client class is responsible for managing the connection of a client
  * to a server using a given configuration. It provides methods
@@ -89,6 +113,74 @@ class Client {
   Future<absl::StatusOr<std::string>> hget(const std::string &key,
                                            const std::string &field);
 
+  /**
+   * Inserts the given values at the head of the list stored at the given key.
+   *
+   * @param key The key of the list.
+   * @param values The values to insert, the last one ending up at the head.
+   * @return A Future containing the status of the operation.
+   */
+  Future<absl::Status> lpush(const std::string &key,
+                             const std::vector<std::string> &values);
+
+  /**
+   * Pops the head of the first non-empty list among the given keys, waiting
+   * for one to be pushed if they are all empty.
+   *
+   * @param keys The keys of the lists, checked in order.
+   * @param timeout_seconds How long to wait, 0 to wait indefinitely.
+   * @return A Future containing the key and the popped value, or an empty
+   *         vector if the timeout elapsed.
+   */
+  Future<absl::StatusOr<std::vector<std::string>>> blpop(
+      const std::vector<std::string> &keys, double timeout_seconds);
+
+  /**
+   * Changes the database the client's connections use.
+   *
+   * @param database_id The index of the database.
+   * @return A Future containing the status of the operation.
+   */
+  Future<absl::Status> select(int64_t database_id);
+
+  /**
+   * Sends a command that has no dedicated method, e.g. {"CLIENT", "PAUSE",
+   * "100"}. The reply is discarded, only its status is returned.
+   *
+   * @param args The command name followed by its arguments.
+   * @return A Future containing the status of the operation.
+   */
+  Future<absl::Status> customCommand(std::vector<std::string> args);
+
+  /**
+   * Scans the keys of a cluster, several nodes at a time, passing each batch
+   * of keys found to `on_keys` as it arrives. Every key that exists from the
+   * start to the end of the scan is passed at least once, also while slots
+   * migrate or nodes fail over.
+   *
+   * `on_keys` is called from the client's thread, never concurrently, and
+   * should return quickly: the scan slows down while batches are pending. It
+   * is not called anymore once the future is ready. Requires cluster mode
+   * (see Config::withClusterMode()).
+   *
+   * @param options The filters, concurrency and rate limit of the scan.
+   * @param on_keys The function receiving the batches of keys.
+   * @return A Future containing the status of the scan once it has ended.
+   */
+  Future<absl::Status> scanParallel(
+      const ParallelScanOptions &options,
+      std::function<void(const std::vector<std::string> &)> on_keys);
+
+  /**
+   * Returns a snapshot of the per-command statistics recorded so far.
+   *
+   * Statistics are only recorded when enabled with Config::withStats();
+   * otherwise the snapshot is empty.
+   *
+   * @return Statistics keyed by request type.
+   */
+  StatsSnapshot stats() const;
+
   /**
    * Destructor for the Client class.
    */
@@ -97,6 +189,17 @@ class Client {
  private:
   glide::Config config_;
   const core::ConnectionResponse *connection_;
+  std::unique_ptr<StatsRecorder> stats_;
+  std::unique_ptr<RequestCoalescer> coalescer_;
+  std::unique_ptr<NearCache> near_cache_;
+  uint32_t trace_sample_percentage_ = 0;
+
+  /**
+   * Initializes OpenTelemetry from the configuration, if configured.
+   *
+   * @return True if telemetry is not configured or was initialized.
+   */
+  bool init_telemetry();
 
   /**
    * Executes a command with the given request type and arguments.
@@ -0,0 +1,94 @@
+#ifndef COALESCER_HPP_
+#define COALESCER_HPP_
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "glide/future.h"
+#include "glide/glide_base.h"
+
+namespace glide {
+
+class RequestCoalescer;
+
+/**
+ * @brief Future shared by identical concurrent read requests.
+ *
+ * It is the channel handed to the core for the single in-flight command, and
+ * fans the response out to every attached future before deleting itself.
+ */
+class CoalescedFuture final : public IFuture {
+ protected:
+  /**
+   * @brief Delivers the response to every attached future.
+   * @param resp The command response to share.
+   */
+  void set_value(const core::CommandResponse* resp) override;
+
+  /**
+   * @brief Delivers the error to every attached future.
+   * @param type The type of error.
+   * @param message The error message.
+   */
+  void set_value(const core::RequestErrorType type,
+                 const char* message) override;
+
+ private:
+  RequestCoalescer* owner_;
+  std::string key_;
+  std::vector<IFuture*> waiters_;
+
+  CoalescedFuture(RequestCoalescer* owner, std::string key);
+
+  friend class RequestCoalescer;
+};
+
+/**
+ * @brief Single-flight registry for read-only commands.
+ *
+ * While a read is in flight, identical requests (same request type and
+ * arguments) attach to it instead of issuing another command, and all of
+ * them complete from the same response.
+ */
+class RequestCoalescer {
+ public:
+  /**
+   * @brief Returns whether requests of the given type may be coalesced.
+   * @param type The request type.
+   */
+  static bool is_coalescable(core::RequestType type);
+
+  /**
+   * @brief Attaches a future to the in-flight request identical to this one,
+   * or registers a new in-flight request.
+   *
+   * @param type The request type.
+   * @param args The command arguments.
+   * @param future The future to complete with the response.
+   * @param channel Set to the channel to pass to the core when a new request
+   * must be issued.
+   * @return True if the future joined an in-flight request and no command
+   * must be sent.
+   */
+  bool attach(core::RequestType type, const std::vector<std::string>& args,
+              IFuture* future, uintptr_t* channel);
+
+ private:
+  std::mutex mtx_;
+  std::unordered_map<std::string, CoalescedFuture*> inflight_;
+
+  /**
+   * @brief Removes a completed request and returns the futures attached to
+   * it. Later identical requests are issued anew.
+   */
+  std::vector<IFuture*> complete(CoalescedFuture* group);
+
+  friend class CoalescedFuture;
+};
+
+}  // namespace glide
+
+#endif  // COALESCER_HPP_
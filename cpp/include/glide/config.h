@@ -21,6 +21,11 @@ const std::string DEFAULT_HOST = "localhost";
  */
 const uint32_t DEFAULT_PORT = 6379;
 
+/**
+ * Default percentage of requests sampled for OpenTelemetry tracing.
+ */
+const uint32_t DEFAULT_TRACE_SAMPLE_PERCENTAGE = 1;
+
 /**
  * TLS modes for client connections.
  */
@@ -58,8 +63,10 @@ enum class ReadFrom {
   PreferReplica = 1,
 
   /**
-   * LowestLatency: Read data from the node with the lowest latency in the
-   * cluster.
+   * LowestLatency: Read data from the node with the lowest expected latency,
+   * the primary included. The client keeps a moving average of the round trip
+   * time and the pending reads of each node, and sends each read to the better
+   * of two randomly drawn nodes. Applies to standalone and cluster clients.
    */
   LowestLatency = 2,
 
@@ -70,6 +77,26 @@ enum class ReadFrom {
   AZAffinity = 3,
 };
 
+/**
+ * Algorithms the client can compress values with.
+ */
+enum class ValueCompression {
+  /**
+   * Values are sent as they are.
+   */
+  None = 0,
+
+  /**
+   * LZ4: fast, with a moderate ratio.
+   */
+  LZ4 = 1,
+
+  /**
+   * Zstandard: a better ratio, at a higher CPU cost.
+   */
+  Zstd = 2,
+};
+
 /**
  * Represents a node in the cluster with a host and port.
  * Used to define the address of a cluster node in the configuration.
@@ -187,6 +214,44 @@ struct Credential {
   Credential& operator=(Credential&& other) noexcept;
 };
 
+/**
+ * OpenTelemetry exporters used by the client.
+ *
+ * OpenTelemetry is initialized once per process, by the first client that
+ * connects with a telemetry configuration; the trace sample percentage is
+ * applied per client.
+ */
+struct TelemetryConfig {
+  /**
+   * Endpoint to export traces to, e.g. "grpc://host:port",
+   * "http://host:port" or "file:///absolute/path/file.json".
+   */
+  std::optional<std::string> traces_endpoint;
+
+  /**
+   * Percentage of requests for which a span is created. Unsampled requests
+   * do not allocate a span.
+   */
+  uint32_t sample_percentage = DEFAULT_TRACE_SAMPLE_PERCENTAGE;
+
+  /**
+   * Endpoint to export metrics to, using the same formats as traces.
+   */
+  std::optional<std::string> metrics_endpoint;
+
+  /**
+   * Interval between consecutive exports. Zero uses the core default.
+   */
+  std::chrono::milliseconds flush_interval{0};
+
+  /**
+   * Returns true if at least one exporter is configured.
+   */
+  bool enabled() const {
+    return traces_endpoint.has_value() || metrics_endpoint.has_value();
+  }
+};
+
 /**
  * Configuration class for managing cluster nodes, credentials, TLS mode, and
  * database settings. Provides methods to construct configurations with single
@@ -317,6 +382,23 @@ class Config {
    */
   Config& withClientName(const std::string& client_name);
 
+  /**
+   * Connects to the nodes as a cluster: the given nodes are used to discover
+   * the topology, and commands are routed to the node owning their keys.
+   * Disabled by default.
+   *
+   * @param enabled Whether the nodes form a cluster.
+   * @return A reference to the updated Config object.
+   */
+  Config& withClusterMode(bool enabled = true);
+
+  /**
+   * Returns whether the client connects to a cluster.
+   *
+   * @return True if cluster mode is enabled.
+   */
+  bool clusterModeEnabled() const;
+
   /**
    * Sets the preferred node to read data from in a cluster.
    *
@@ -325,6 +407,185 @@ class Config {
    */
   Config& withReadFrom(ReadFrom read_from);
 
+  /**
+   * Enables or disables per-command client statistics (request and error
+   * counts, in-flight requests and latency histograms), exposed through
+   * Client::stats(). Disabled by default.
+   *
+   * @param enabled Whether statistics should be recorded.
+   * @return A reference to the updated Config object.
+   */
+  Config& withStats(bool enabled = true);
+
+  /**
+   * Enables or disables coalescing of identical concurrent reads. While a
+   * read-only command (GET, HGET, HGETALL, HMGET, MGET, ZRANGE) is in flight,
+   * identical requests attach to it instead of being sent, and all complete
+   * with the same response. Disabled by default.
+   *
+   * @param enabled Whether identical reads should be coalesced.
+   * @return A reference to the updated Config object.
+   */
+  Config& withRequestCoalescing(bool enabled = true);
+
+  /**
+   * Returns whether identical concurrent reads are coalesced.
+   *
+   * @return True if request coalescing is enabled.
+   */
+  bool requestCoalescingEnabled() const;
+
+  /**
+   * Enables a near cache of GET and HGET results inside the client, bounded
+   * to the given number of bytes with least-recently-used eviction. Cached
+   * results are kept coherent with server-assisted client side caching
+   * (CLIENT TRACKING): the server notifies the client when a key it read is
+   * modified, and every cached read of that key is dropped. Cache hits
+   * complete the future synchronously. Disabled by default.
+   *
+   * @param max_bytes The maximum size of the cache in bytes, or 0 to disable
+   * it.
+   * @return A reference to the updated Config object.
+   */
+  Config& withNearCache(size_t max_bytes);
+
+  /**
+   * Returns the maximum size of the near cache in bytes.
+   *
+   * @return The size bound, or 0 if the near cache is disabled.
+   */
+  size_t nearCacheMaxBytes() const;
+
+  /**
+   * Sets the number of multiplexed connections opened to each node of a
+   * standalone deployment. Requests are striped across the connections of a
+   * node, each one sent on the connection with the fewest outstanding
+   * requests. Commands that change connection state (SELECT, AUTH, CLIENT
+   * SETNAME, ...) are applied to every connection, while transactions, WATCH
+   * and subscriptions stay on the first one. Defaults to 1.
+   *
+   * @param connections The number of connections per node.
+   * @return A reference to the updated Config object.
+   */
+  Config& withConnectionsPerNode(uint32_t connections);
+
+  /**
+   * Returns the number of connections opened to each node.
+   *
+   * @return The number of connections per node.
+   */
+  uint32_t connectionsPerNode() const;
+
+  /**
+   * Hedges reads: a read without a reply after the given percentile of the
+   * recent read latencies is sent again, and the first reply wins. The second
+   * attempt goes through the read strategy, so it usually reaches another
+   * replica or the primary. Only applies when reading from replicas (see
+   * withReadFrom()) and to reads that don't block.
+   *
+   * @param percentile The latency percentile after which a read is hedged,
+   * e.g. 95. 0 disables hedging.
+   * @return A reference to the updated Config object.
+   */
+  Config& withReadHedging(float percentile = 95);
+
+  /**
+   * Returns the latency percentile after which reads are hedged.
+   *
+   * @return The percentile, or 0 if reads are not hedged.
+   */
+  float readHedgingPercentile() const;
+
+  /**
+   * Sends blocking commands, such as BLPOP or XREAD with BLOCK, over dedicated
+   * connections, so that they don't delay the other commands. Up to `limit`
+   * dedicated connections are opened on demand; when all of them are busy, a
+   * blocking command uses the shared connections.
+   *
+   * @param limit The maximum number of dedicated connections. 0 disables
+   * them.
+   * @return A reference to the updated Config object.
+   */
+  Config& withBlockingConnections(uint32_t limit = 4);
+
+  /**
+   * Returns the maximum number of dedicated connections for blocking commands.
+   *
+   * @return The limit, or 0 if blocking commands use the shared connections.
+   */
+  uint32_t blockingConnectionsLimit() const;
+
+  /**
+   * Compresses the values written by SET, SETEX, PSETEX, SETNX, GETSET, MSET
+   * and MSETNX, and decompresses the values read by GET, GETDEL, GETEX and
+   * MGET. Values shorter than `min_size`, or that don't get smaller, are sent
+   * as they are, and values that aren't compressed are read as they are, so
+   * clients with and without compression can share keys.
+   *
+   * @param compression The algorithm, or ValueCompression::None to send all
+   * values as they are.
+   * @param min_size The size in bytes from which values are compressed.
+   * @return A reference to the updated Config object.
+   */
+  Config& withValueCompression(ValueCompression compression,
+                               uint32_t min_size = 1024);
+
+  /**
+   * Returns the algorithm values are compressed with.
+   *
+   * @return The algorithm, or ValueCompression::None.
+   */
+  ValueCompression valueCompression() const;
+
+  /**
+   * Returns the size in bytes from which values are compressed.
+   *
+   * @return The minimum size.
+   */
+  uint32_t valueCompressionMinSize() const;
+
+  /**
+   * Returns whether per-command client statistics are enabled.
+   *
+   * @return True if statistics should be recorded.
+   */
+  bool statsEnabled() const;
+
+  /**
+   * Exports OpenTelemetry traces to the given endpoint, creating a span for
+   * the given percentage of requests.
+   *
+   * @param endpoint The traces collector endpoint.
+   * @param sample_percentage The percentage of requests to trace, 0 to 100.
+   * @return A reference to the updated Config object.
+   */
+  Config& withTracesExporter(
+      const std::string& endpoint,
+      uint32_t sample_percentage = DEFAULT_TRACE_SAMPLE_PERCENTAGE);
+
+  /**
+   * Exports OpenTelemetry metrics to the given endpoint.
+   *
+   * @param endpoint The metrics collector endpoint.
+   * @return A reference to the updated Config object.
+   */
+  Config& withMetricsExporter(const std::string& endpoint);
+
+  /**
+   * Sets the interval between consecutive OpenTelemetry exports.
+   *
+   * @param interval The flush interval.
+   * @return A reference to the updated Config object.
+   */
+  Config& withTelemetryFlushInterval(std::chrono::milliseconds interval);
+
+  /**
+   * Returns the OpenTelemetry configuration.
+   *
+   * @return A const reference to the telemetry configuration.
+   */
+  const TelemetryConfig& telemetry() const;
+
   /**
    * Serializes the configuration into a byte array using Protocol Buffers.
    *
@@ -335,12 +596,22 @@ class Config {
 
  private:
   std::vector<ClusterNode> cluster_nodes_;
+  bool cluster_mode_ = false;
   Credential credential_;
   TLSMode tls_mode_ = TLSMode::NoTLS;
   uint32_t database_ = 0;
   uint32_t request_timeout_ = 1000;
   std::optional<std::string> client_name_;
   ReadFrom read_from_ = ReadFrom::Primary;
+  bool stats_enabled_ = false;
+  bool request_coalescing_ = false;
+  size_t near_cache_max_bytes_ = 0;
+  uint32_t connections_per_node_ = 1;
+  float read_hedging_percentile_ = 0;
+  uint32_t blocking_connections_limit_ = 0;
+  ValueCompression value_compression_ = ValueCompression::None;
+  uint32_t value_compression_min_size_ = 1024;
+  TelemetryConfig telemetry_;
 };
 
 }  // namespace glide
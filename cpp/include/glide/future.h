@@ -4,14 +4,17 @@
 #include <absl/status/status.h>
 #include <absl/status/statusor.h>
 
+#include <chrono>
 #include <condition_variable>
 #include <memory>
 #include <mutex>
 #include <string>
 #include <type_traits>
+#include <vector>
 
 #include "glide/glide_base.h"
 #include "helper.h"
+#include "stats.h"
 
 namespace glide {
 
@@ -35,6 +38,14 @@ class IFuture {
   std::unique_ptr<std::mutex> mtx_;
   bool ready_;
 
+  /**
+   * Statistics recorder notified on completion, or null when stats are
+   * disabled.
+   */
+  StatsRecorder* stats_ = nullptr;
+  core::RequestType type_;
+  std::chrono::steady_clock::time_point start_;
+
   /**
    * @brief Marks the future as ready and notifies waiting threads.
    */
@@ -125,6 +136,16 @@ class MethodAccess {
    */
   static void set_value(IFuture* resp, core::RequestErrorType type,
                         const char* message);
+
+  /**
+   * @brief Registers a future with a statistics recorder so its completion
+   * latency and outcome are recorded.
+   * @param resp The future to track.
+   * @param stats The recorder to notify.
+   * @param type The request type of the command.
+   */
+  static void track(IFuture* resp, StatsRecorder* stats,
+                    core::RequestType type);
 };
 
 /**
@@ -148,13 +169,14 @@ class Future : public IFuture {
       result_ = std::string(resp->string_value, resp->string_value_len);
     else if constexpr (std::is_same_v<T, absl::StatusOr<bool>>)
       result_ = resp->bool_value;
+    else if constexpr (std::is_same_v<T,
+                                      absl::StatusOr<std::vector<std::string>>>)
+      result_ = ArrayToStrings(resp);
     else
       static_assert(false, "unsupported data type");
 
-    // Release the respoonse.
-    // TODO: needs to be managed in a better way.
-    core::free_command_response(const_cast<core::CommandResponse*>(resp));
-
+    // The response is owned and released by the success callback, since it
+    // may be shared by several coalesced futures.
     ready();
   }
 
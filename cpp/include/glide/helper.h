@@ -2,7 +2,9 @@
 #define HELPER_HPP_
 #include <absl/status/status.h>
 
+#include <cstdint>
 #include <string>
+#include <vector>
 
 #include "glide_base.h"
 
@@ -23,6 +25,41 @@ namespace glide {
 absl::Status ConvertRequestError(core::RequestErrorType type,
                                  const std::string& message);
 
+/**
+ * @brief Decides whether a request should be traced.
+ *
+ * Uses a per-thread pseudo-random generator, so the decision costs a few
+ * arithmetic operations and never allocates.
+ *
+ * @param percentage The percentage of requests to sample, 0 to 100.
+ * @return True if the request should be sampled.
+ */
+bool ShouldSample(uint32_t percentage);
+
+/**
+ * @brief Encodes a request type and its arguments into a lookup key.
+ *
+ * Arguments are length-prefixed, so distinct argument lists never share a
+ * key.
+ *
+ * @param type The request type.
+ * @param args The command arguments.
+ * @return The encoded key.
+ */
+std::string RequestKey(core::RequestType type,
+                       const std::vector<std::string>& args);
+
+/**
+ * @brief Copies the string elements of an array response.
+ *
+ * A null response, such as the reply of a blocking pop that timed out,
+ * yields an empty vector.
+ *
+ * @param resp The command response.
+ * @return The elements of the array.
+ */
+std::vector<std::string> ArrayToStrings(const core::CommandResponse* resp);
+
 }  // namespace glide
 
 #endif  // HELPER_HPP_
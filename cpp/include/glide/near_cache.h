@@ -0,0 +1,192 @@
+#ifndef NEAR_CACHE_HPP_
+#define NEAR_CACHE_HPP_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "glide/future.h"
+#include "glide/glide_base.h"
+
+namespace glide {
+
+class NearCache;
+
+/**
+ * @brief Future wrapping the channel of a cacheable read sent to the server.
+ *
+ * It stores the response in the near cache, unless the key was invalidated
+ * while the read was in flight, then completes the wrapped future and
+ * deletes itself.
+ */
+class CachingFuture final : public IFuture {
+ protected:
+  /**
+   * @brief Caches the response and delivers it to the wrapped future.
+   * @param resp The command response.
+   */
+  void set_value(const core::CommandResponse* resp) override;
+
+  /**
+   * @brief Delivers the error to the wrapped future.
+   * @param type The type of error.
+   * @param message The error message.
+   */
+  void set_value(const core::RequestErrorType type,
+                 const char* message) override;
+
+ private:
+  NearCache* owner_;
+  IFuture* target_;
+  std::string request_key_;
+  std::string key_;
+  uint64_t epoch_;
+
+  CachingFuture(NearCache* owner, IFuture* target, std::string request_key,
+                std::string key, uint64_t epoch);
+
+  friend class NearCache;
+};
+
+/**
+ * @brief Byte-bounded client side cache of read results, kept coherent with
+ * server-assisted client side caching (CLIENT TRACKING).
+ *
+ * Entries are keyed by request type and arguments, and indexed by the key
+ * they read so that an invalidation message drops every cached read of that
+ * key. A response is only cached if its key was not invalidated while the
+ * read was in flight. The cache is split into shards, each with its own lock,
+ * LRU list and share of the byte budget.
+ */
+class NearCache {
+ public:
+  /**
+   * Number of independently locked shards.
+   */
+  static constexpr size_t SHARD_COUNT = 16;
+
+  /**
+   * Bytes accounted for each entry on top of its keys and value.
+   */
+  static constexpr size_t ENTRY_OVERHEAD = 64;
+
+  /**
+   * @brief Returns whether results of the given request type may be cached.
+   * @param type The request type.
+   */
+  static bool is_cacheable(core::RequestType type);
+
+  /**
+   * @brief Constructs an empty cache.
+   * @param max_bytes The maximum number of bytes held by the cache.
+   */
+  explicit NearCache(size_t max_bytes);
+
+  NearCache(const NearCache&) = delete;
+  NearCache& operator=(const NearCache&) = delete;
+
+  /**
+   * @brief Completes the future from the cache, if the result is cached.
+   *
+   * @param type The request type.
+   * @param args The command arguments; the first one is the key.
+   * @param future The future to complete.
+   * @return True if the future was completed.
+   */
+  bool lookup(core::RequestType type, const std::vector<std::string>& args,
+              IFuture* future);
+
+  /**
+   * @brief Wraps the channel of a read sent to the server so that its
+   * response is cached.
+   *
+   * @param type The request type.
+   * @param args The command arguments; the first one is the key.
+   * @param channel The channel to pass to the core, replaced by the wrapper.
+   */
+  void track(core::RequestType type, const std::vector<std::string>& args,
+             uintptr_t* channel);
+
+  /**
+   * @brief Drops the cached reads a write sent through the client may modify.
+   *
+   * Any argument may be a key, so every argument is invalidated; dropping a
+   * few unrelated entries is harmless. FLUSHDB, FLUSHALL, SWAPDB and SELECT
+   * drop every cached read.
+   *
+   * @param type The request type.
+   * @param args The command arguments.
+   */
+  void note_write(core::RequestType type, const std::vector<std::string>& args);
+
+  /**
+   * @brief Drops every cached read of a key.
+   * @param key The invalidated key.
+   */
+  void invalidate(const std::string& key);
+
+  /**
+   * @brief Drops every cached read.
+   */
+  void invalidate_all();
+
+  /**
+   * @brief Returns the number of cached results.
+   */
+  size_t size() const;
+
+  /**
+   * @brief Returns the number of bytes accounted for the cached results.
+   */
+  size_t bytes() const;
+
+ private:
+  struct Entry {
+    std::string request_key;
+    std::string key;
+    core::ResponseType type;
+    std::string value;
+    size_t bytes;
+  };
+
+  // Reads of a key in flight, and the epoch they must still observe to be
+  // cached. Invalidating the key moves it to a new epoch.
+  struct Fill {
+    uint64_t epoch;
+    size_t outstanding;
+  };
+
+  struct Shard {
+    mutable std::mutex mtx;
+    std::list<Entry> lru;
+    std::unordered_map<std::string, std::list<Entry>::iterator> entries;
+    std::unordered_multimap<std::string, std::list<Entry>::iterator> by_key;
+    std::unordered_map<std::string, Fill> fills;
+    uint64_t next_epoch = 0;
+    size_t bytes = 0;
+  };
+
+  const size_t shard_max_bytes_;
+  std::array<Shard, SHARD_COUNT> shards_;
+
+  Shard& shard(const std::string& key);
+  void erase(Shard& shard, std::list<Entry>::iterator it);
+  void invalidate_locked(Shard& shard, const std::string& key);
+
+  /**
+   * @brief Caches a response if its key was not invalidated since the read
+   * was sent, and releases the fill.
+   */
+  void fill(CachingFuture* pending, const core::CommandResponse* resp);
+
+  friend class CachingFuture;
+};
+
+}  // namespace glide
+
+#endif  // NEAR_CACHE_HPP_
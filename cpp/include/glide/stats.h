@@ -0,0 +1,210 @@
+#ifndef STATS_HPP_
+#define STATS_HPP_
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "glide/glide_base.h"
+
+namespace glide {
+
+/**
+ * Number of distinct core::RequestErrorType values tracked per command.
+ */
+constexpr size_t STATS_ERROR_TYPES = 4;
+
+/**
+ * @brief Point-in-time copy of a log-linear latency histogram.
+ *
+ * Latencies are recorded in microseconds. Values below 2^SUB_BUCKET_BITS are
+ * stored exactly; larger values are grouped into 2^SUB_BUCKET_BITS linear
+ * sub-buckets per power of two, which bounds the relative error of any
+ * reported percentile to 1 / 2^SUB_BUCKET_BITS.
+ */
+class LatencyHistogram {
+ public:
+  /**
+   * Number of bits used for the linear sub-buckets of each power of two.
+   */
+  static constexpr uint32_t SUB_BUCKET_BITS = 3;
+
+  /**
+   * Largest power of two covered by the histogram; slower requests are
+   * accounted in the last bucket.
+   */
+  static constexpr uint32_t MAX_EXPONENT = 36;
+
+  /**
+   * Total number of buckets in the histogram.
+   */
+  static constexpr size_t BUCKET_COUNT =
+      (MAX_EXPONENT - SUB_BUCKET_BITS + 2) << SUB_BUCKET_BITS;
+
+  /**
+   * @brief Returns the bucket a latency falls into.
+   * @param micros The latency in microseconds.
+   */
+  static size_t bucket_index(uint64_t micros);
+
+  /**
+   * @brief Returns the smallest latency accounted in a bucket.
+   * @param index The bucket index.
+   */
+  static uint64_t bucket_lower_bound(size_t index);
+
+  /**
+   * @brief Returns the largest latency accounted in a bucket.
+   * @param index The bucket index.
+   */
+  static uint64_t bucket_upper_bound(size_t index);
+
+  /**
+   * @brief Constructs an empty histogram.
+   */
+  LatencyHistogram();
+
+  /**
+   * @brief Returns the number of recorded samples.
+   */
+  uint64_t count() const;
+
+  /**
+   * @brief Returns the per-bucket sample counts.
+   */
+  const std::vector<uint64_t>& buckets() const;
+
+  /**
+   * @brief Returns the latency below which the given percentage of samples
+   * fall, rounded up to the upper bound of its bucket.
+   * @param percentile The percentile in the range [0, 100].
+   */
+  std::chrono::microseconds percentile(double percentile) const;
+
+ private:
+  std::vector<uint64_t> buckets_;
+  uint64_t count_;
+
+  friend class StatsRecorder;
+};
+
+/**
+ * @brief Point-in-time statistics for a single request type.
+ */
+struct CommandStats {
+  /**
+   * Number of requests issued.
+   */
+  uint64_t requests = 0;
+
+  /**
+   * Number of failed requests, indexed by core::RequestErrorType.
+   */
+  std::array<uint64_t, STATS_ERROR_TYPES> errors{};
+
+  /**
+   * Number of requests issued but not yet completed.
+   */
+  int64_t in_flight = 0;
+
+  /**
+   * Latency from submission to completion for finished requests.
+   */
+  LatencyHistogram latency;
+};
+
+/**
+ * Statistics keyed by request type, as returned by Client::stats().
+ */
+using StatsSnapshot = std::map<core::RequestType, CommandStats>;
+
+/**
+ * @brief Lock-free recorder of per-request-type client statistics.
+ *
+ * Counters are spread over cache-line aligned shards selected per thread and
+ * updated with relaxed atomics, so concurrent callers never contend on the
+ * same line. Per-command storage is allocated on first use.
+ */
+class StatsRecorder {
+ public:
+  /**
+   * Upper bound (exclusive) on the request type values that are tracked.
+   */
+  static constexpr size_t MAX_REQUEST_TYPE = 4096;
+
+  /**
+   * Number of per-thread shards for each request type.
+   */
+  static constexpr size_t SHARD_COUNT = 8;
+
+  /**
+   * @brief Constructs an empty recorder.
+   */
+  StatsRecorder();
+
+  /**
+   * @brief Releases all per-command storage.
+   */
+  ~StatsRecorder();
+
+  StatsRecorder(const StatsRecorder&) = delete;
+  StatsRecorder& operator=(const StatsRecorder&) = delete;
+
+  /**
+   * @brief Records the submission of a request.
+   * @param type The request type.
+   */
+  void record_start(core::RequestType type);
+
+  /**
+   * @brief Records the successful completion of a request.
+   * @param type The request type.
+   * @param start The time at which the request was submitted.
+   */
+  void record_success(core::RequestType type,
+                      std::chrono::steady_clock::time_point start);
+
+  /**
+   * @brief Records the failed completion of a request.
+   * @param type The request type.
+   * @param error The type of the error.
+   * @param start The time at which the request was submitted.
+   */
+  void record_failure(core::RequestType type, core::RequestErrorType error,
+                      std::chrono::steady_clock::time_point start);
+
+  /**
+   * @brief Aggregates all shards into a snapshot.
+   * @return Statistics for every request type issued at least once.
+   */
+  StatsSnapshot snapshot() const;
+
+ private:
+  struct alignas(64) Shard {
+    std::atomic<uint64_t> requests{0};
+    std::atomic<uint64_t> completed{0};
+    std::array<std::atomic<uint64_t>, STATS_ERROR_TYPES> errors{};
+    std::array<std::atomic<uint64_t>, LatencyHistogram::BUCKET_COUNT>
+        buckets{};
+  };
+
+  struct Entry {
+    std::array<Shard, SHARD_COUNT> shards;
+  };
+
+  std::unique_ptr<std::atomic<Entry*>[]> entries_;
+
+  Entry* entry(core::RequestType type);
+  Shard* shard(core::RequestType type);
+  void record_completion(Shard* shard,
+                         std::chrono::steady_clock::time_point start);
+};
+
+}  // namespace glide
+
+#endif  // STATS_HPP_
@@ -2,6 +2,11 @@
 #include <glide/future.h>
 #include <glide/glide_base.h>
 #include <glide/helper.h>
+#include <glide/near_cache.h>
+
+#include <functional>
+#include <string>
+#include <vector>
 
 namespace glide {
 
@@ -13,6 +18,7 @@ namespace glide {
 void on_success(uintptr_t ptr, const core::CommandResponse *message) {
   auto *cb_ptr = reinterpret_cast<IFuture *>(ptr);
   if (cb_ptr) MethodAccess::set_value(cb_ptr, message);
+  core::free_command_response(const_cast<core::CommandResponse *>(message));
 }
 
 /**
@@ -26,4 +32,43 @@ void on_failure(uintptr_t ptr, const char *message,
   if (cb_ptr) MethodAccess::set_value(cb_ptr, type, message);
 }
 
+/**
+ * Callback function called when the server invalidates keys read by the
+ * client. The keys must be copied before the function returns.
+ */
+void on_invalidation(uintptr_t ptr, const uint8_t *const *keys,
+                     const uintptr_t *key_lens, uintptr_t key_count) {
+  auto *cache = reinterpret_cast<NearCache *>(ptr);
+  if (!cache) return;
+  if (!keys) {
+    cache->invalidate_all();
+    return;
+  }
+  for (uintptr_t i = 0; i < key_count; ++i) {
+    cache->invalidate(
+        std::string(reinterpret_cast<const char *>(keys[i]), key_lens[i]));
+  }
+}
+
+/**
+ * Callback function called with each batch of keys found by a parallel scan.
+ * The keys are copied before being passed on.
+ */
+void on_scan_keys(uintptr_t ptr, const uint8_t *const *keys,
+                  const uintptr_t *key_lens, uintptr_t key_count) {
+  auto *on_keys =
+      reinterpret_cast<std::function<void(const std::vector<std::string> &)> *>(
+          ptr);
+  if (!keys) {
+    delete on_keys;
+    return;
+  }
+  std::vector<std::string> batch;
+  batch.reserve(key_count);
+  for (uintptr_t i = 0; i < key_count; ++i) {
+    batch.emplace_back(reinterpret_cast<const char *>(keys[i]), key_lens[i]);
+  }
+  (*on_keys)(batch);
+}
+
 }  // namespace glide
@@ -12,22 +12,61 @@ namespace glide {
 /**
  * Constructs a Client with a const configuration.
  */
-Client::Client(const Config &config) : config_(config) {}
+Client::Client(const Config &config)
+    : config_(config),
+      stats_(config.statsEnabled() ? std::make_unique<StatsRecorder>()
+                                   : nullptr),
+      coalescer_(config.requestCoalescingEnabled()
+                     ? std::make_unique<RequestCoalescer>()
+                     : nullptr),
+      near_cache_(config.nearCacheMaxBytes() > 0
+                      ? std::make_unique<NearCache>(config.nearCacheMaxBytes())
+                      : nullptr) {}
 
 /**
  * Connects the client using the serialized configuration.
  */
 bool Client::connect() {
+  if (!init_telemetry()) {
+    return false;
+  }
   std::optional<std::vector<uint8_t>> serialized_conf = config_.serialize();
   if (!serialized_conf) {
     return false;
   }
-  connection_ = core::create_client(serialized_conf.value().data(),
-                                    serialized_conf.value().size(), on_success,
-                                    on_failure);
+  connection_ = core::create_client(
+      serialized_conf.value().data(), serialized_conf.value().size(),
+      on_success, on_failure, near_cache_ ? on_invalidation : nullptr,
+      reinterpret_cast<uintptr_t>(near_cache_.get()));
   return connection_->conn_ptr != nullptr;
 }
 
+/**
+ * Initializes OpenTelemetry from the configuration, if configured.
+ */
+bool Client::init_telemetry() {
+  const TelemetryConfig &telemetry = config_.telemetry();
+  if (!telemetry.enabled()) {
+    return true;
+  }
+  core::OpenTelemetryConfig otel_config = {
+      telemetry.traces_endpoint ? telemetry.traces_endpoint->c_str() : nullptr,
+      telemetry.sample_percentage,
+      telemetry.metrics_endpoint ? telemetry.metrics_endpoint->c_str()
+                                 : nullptr,
+      static_cast<int64_t>(telemetry.flush_interval.count()),
+  };
+  const char *error = core::init_open_telemetry(&otel_config);
+  if (error) {
+    core::free_c_string(const_cast<char *>(error));
+    return false;
+  }
+  if (telemetry.traces_endpoint) {
+    trace_sample_percentage_ = telemetry.sample_percentage;
+  }
+  return true;
+}
+
 /**
  * Sets a key-value pair in the client's configuration.
  */
@@ -95,12 +134,115 @@ Future<absl::StatusOr<std::string>> Client::hget(const std::string &key,
   return future;
 }
 
+/**
+ * Inserts the given values at the head of the list stored at the given key.
+ */
+Future<absl::Status> Client::lpush(const std::string &key,
+                                   const std::vector<std::string> &values) {
+  std::vector<std::string> args = {key};
+  args.insert(args.end(), values.begin(), values.end());
+  Future<absl::Status> future;
+  auto future_ptr = reinterpret_cast<uintptr_t>(&future);
+  exec_command(core::RequestType::LPush, args, future_ptr);
+  return future;
+}
+
+/**
+ * Pops the head of the first non-empty list among the given keys, waiting for
+ * one to be pushed if they are all empty.
+ */
+Future<absl::StatusOr<std::vector<std::string>>> Client::blpop(
+    const std::vector<std::string> &keys, double timeout_seconds) {
+  std::vector<std::string> args = keys;
+  args.push_back(std::to_string(timeout_seconds));
+  Future<absl::StatusOr<std::vector<std::string>>> future;
+  auto future_ptr = reinterpret_cast<uintptr_t>(&future);
+  exec_command(core::RequestType::BLPop, args, future_ptr);
+  return future;
+}
+
+/**
+ * Changes the database the client's connections use.
+ */
+Future<absl::Status> Client::select(int64_t database_id) {
+  std::vector<std::string> args = {std::to_string(database_id)};
+  Future<absl::Status> future;
+  auto future_ptr = reinterpret_cast<uintptr_t>(&future);
+  exec_command(core::RequestType::Select, args, future_ptr);
+  return future;
+}
+
+/**
+ * Sends a command that has no dedicated method.
+ */
+Future<absl::Status> Client::customCommand(std::vector<std::string> args) {
+  Future<absl::Status> future;
+  auto future_ptr = reinterpret_cast<uintptr_t>(&future);
+  exec_command(core::RequestType::CustomCommand, args, future_ptr);
+  return future;
+}
+
+/**
+ * Scans the keys of a cluster, several nodes at a time, passing each batch
+ * of keys found to `on_keys` as it arrives.
+ */
+Future<absl::Status> Client::scanParallel(
+    const ParallelScanOptions &options,
+    std::function<void(const std::vector<std::string> &)> on_keys) {
+  core::ParallelScanConfig scan_config = {
+      options.match_pattern
+          ? reinterpret_cast<const uint8_t *>(options.match_pattern->data())
+          : nullptr,
+      options.match_pattern ? options.match_pattern->size() : 0,
+      options.count,
+      options.type ? options.type->c_str() : nullptr,
+      options.concurrency,
+      options.max_scans_per_second,
+      options.allow_non_covered_slots,
+  };
+  Future<absl::Status> future;
+  auto future_ptr = reinterpret_cast<uintptr_t>(&future);
+  // Freed by on_scan_keys once the scan has ended.
+  auto *keys_context =
+      new std::function<void(const std::vector<std::string> &)>(
+          std::move(on_keys));
+  core::parallel_cluster_scan(connection_->conn_ptr, future_ptr, &scan_config,
+                              on_scan_keys,
+                              reinterpret_cast<uintptr_t>(keys_context));
+  return future;
+}
+
 /**
  * Executes a command with the given request type and arguments.
  */
 void Client::exec_command(core::RequestType type,
                           std::vector<std::string> &args,
                           uintptr_t channel_ptr) {
+  if (near_cache_) {
+    if (NearCache::is_cacheable(type)) {
+      if (near_cache_->lookup(type, args,
+                              reinterpret_cast<IFuture *>(channel_ptr))) {
+        return;
+      }
+    } else {
+      // Writes through this client drop their keys right away instead of
+      // waiting for the server's invalidation messages.
+      near_cache_->note_write(type, args);
+    }
+  }
+
+  // Identical reads already in flight complete this future as well.
+  if (coalescer_ && RequestCoalescer::is_coalescable(type) &&
+      coalescer_->attach(type, args, reinterpret_cast<IFuture *>(channel_ptr),
+                         &channel_ptr)) {
+    return;
+  }
+
+  // The response of a read sent to the server is cached on completion.
+  if (near_cache_ && NearCache::is_cacheable(type)) {
+    near_cache_->track(type, args, &channel_ptr);
+  }
+
   // Prepare arguments.
   std::vector<uintptr_t> cmd_args;
   cmd_args.reserve(args.size());
@@ -111,9 +253,32 @@ void Client::exec_command(core::RequestType type,
     cmd_args_len.push_back(static_cast<unsigned long>(arg.size()));
   };
 
+  if (stats_) {
+    MethodAccess::track(reinterpret_cast<IFuture *>(channel_ptr), stats_.get(),
+                        type);
+  }
+
+  // Only sampled requests pay for a span. The command holds its own
+  // reference to the span, so ours can be released right after submission.
+  uint64_t span_ptr = 0;
+  if (trace_sample_percentage_ && ShouldSample(trace_sample_percentage_)) {
+    span_ptr = core::create_otel_span(type);
+  }
+
   // Execute command.
   core::command(connection_->conn_ptr, channel_ptr, type, cmd_args.size(),
-                cmd_args.data(), cmd_args_len.data(), nullptr, 0);
+                cmd_args.data(), cmd_args_len.data(), nullptr, 0, span_ptr);
+
+  if (span_ptr) {
+    core::drop_otel_span(span_ptr);
+  }
+}
+
+/**
+ * Returns a snapshot of the per-command statistics recorded so far.
+ */
+StatsSnapshot Client::stats() const {
+  return stats_ ? stats_->snapshot() : StatsSnapshot();
 }
 
 /**
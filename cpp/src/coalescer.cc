@@ -0,0 +1,81 @@
+#include <glide/coalescer.h>
+#include <glide/helper.h>
+
+namespace glide {
+
+/**
+ * @brief Constructs a group owned by the given coalescer.
+ */
+CoalescedFuture::CoalescedFuture(RequestCoalescer* owner, std::string key)
+    : owner_(owner), key_(std::move(key)) {}
+
+/**
+ * @brief Delivers the response to every attached future.
+ */
+void CoalescedFuture::set_value(const core::CommandResponse* resp) {
+  for (IFuture* waiter : owner_->complete(this)) {
+    MethodAccess::set_value(waiter, resp);
+  }
+  delete this;
+}
+
+/**
+ * @brief Delivers the error to every attached future.
+ */
+void CoalescedFuture::set_value(const core::RequestErrorType type,
+                                const char* message) {
+  for (IFuture* waiter : owner_->complete(this)) {
+    MethodAccess::set_value(waiter, type, message);
+  }
+  delete this;
+}
+
+/**
+ * @brief Returns whether requests of the given type may be coalesced.
+ */
+bool RequestCoalescer::is_coalescable(core::RequestType type) {
+  switch (type) {
+    case core::RequestType::Get:
+    case core::RequestType::HGet:
+    case core::RequestType::HGetAll:
+    case core::RequestType::HMGet:
+    case core::RequestType::MGet:
+    case core::RequestType::ZRange:
+      return true;
+    default:
+      return false;
+  }
+}
+
+/**
+ * @brief Attaches a future to the identical in-flight request, or registers
+ * a new one.
+ */
+bool RequestCoalescer::attach(core::RequestType type,
+                              const std::vector<std::string>& args,
+                              IFuture* future, uintptr_t* channel) {
+  std::string key = RequestKey(type, args);
+
+  std::lock_guard<std::mutex> lock(mtx_);
+  auto it = inflight_.find(key);
+  if (it != inflight_.end()) {
+    it->second->waiters_.push_back(future);
+    return true;
+  }
+  auto* group = new CoalescedFuture(this, key);
+  group->waiters_.push_back(future);
+  inflight_.emplace(std::move(key), group);
+  *channel = reinterpret_cast<uintptr_t>(group);
+  return false;
+}
+
+/**
+ * @brief Removes a completed request and returns the attached futures.
+ */
+std::vector<IFuture*> RequestCoalescer::complete(CoalescedFuture* group) {
+  std::lock_guard<std::mutex> lock(mtx_);
+  inflight_.erase(group->key_);
+  return std::move(group->waiters_);
+}
+
+}  // namespace glide
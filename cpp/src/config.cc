@@ -124,9 +124,22 @@ Config::Config() = default;
  */
 Config::Config(const Config& other) noexcept
     : cluster_nodes_(other.cluster_nodes_),
+      cluster_mode_(other.cluster_mode_),
       credential_(other.credential_),
       tls_mode_(other.tls_mode_),
-      database_(other.database_) {}
+      database_(other.database_),
+      request_timeout_(other.request_timeout_),
+      client_name_(other.client_name_),
+      read_from_(other.read_from_),
+      stats_enabled_(other.stats_enabled_),
+      request_coalescing_(other.request_coalescing_),
+      near_cache_max_bytes_(other.near_cache_max_bytes_),
+      connections_per_node_(other.connections_per_node_),
+      read_hedging_percentile_(other.read_hedging_percentile_),
+      blocking_connections_limit_(other.blocking_connections_limit_),
+      value_compression_(other.value_compression_),
+      value_compression_min_size_(other.value_compression_min_size_),
+      telemetry_(other.telemetry_) {}
 
 /**
  * Move constructor for Config.
@@ -134,9 +147,22 @@ Config::Config(const Config& other) noexcept
  */
 Config::Config(Config&& other) noexcept
     : cluster_nodes_(std::move(other.cluster_nodes_)),
+      cluster_mode_(other.cluster_mode_),
       credential_(std::move(other.credential_)),
       tls_mode_(other.tls_mode_),
-      database_(other.database_) {}
+      database_(other.database_),
+      request_timeout_(other.request_timeout_),
+      client_name_(std::move(other.client_name_)),
+      read_from_(other.read_from_),
+      stats_enabled_(other.stats_enabled_),
+      request_coalescing_(other.request_coalescing_),
+      near_cache_max_bytes_(other.near_cache_max_bytes_),
+      connections_per_node_(other.connections_per_node_),
+      read_hedging_percentile_(other.read_hedging_percentile_),
+      blocking_connections_limit_(other.blocking_connections_limit_),
+      value_compression_(other.value_compression_),
+      value_compression_min_size_(other.value_compression_min_size_),
+      telemetry_(std::move(other.telemetry_)) {}
 
 /**
  * Sets the TLS mode to InsecureTLS.
@@ -182,6 +208,19 @@ Config& Config::withClientName(const std::string& client_name) {
   return *this;
 }
 
+/**
+ * Connects to the nodes as a cluster.
+ */
+Config& Config::withClusterMode(bool enabled) {
+  cluster_mode_ = enabled;
+  return *this;
+}
+
+/**
+ * Returns whether the client connects to a cluster.
+ */
+bool Config::clusterModeEnabled() const { return cluster_mode_; }
+
 /**
  * Sets the preferred node to read data from in a cluster.
  */
@@ -190,6 +229,140 @@ Config& Config::withReadFrom(ReadFrom read_from) {
   return *this;
 }
 
+/**
+ * Enables or disables per-command client statistics.
+ */
+Config& Config::withStats(bool enabled) {
+  stats_enabled_ = enabled;
+  return *this;
+}
+
+/**
+ * Returns whether per-command client statistics are enabled.
+ */
+bool Config::statsEnabled() const { return stats_enabled_; }
+
+/**
+ * Enables or disables coalescing of identical concurrent reads.
+ */
+Config& Config::withRequestCoalescing(bool enabled) {
+  request_coalescing_ = enabled;
+  return *this;
+}
+
+/**
+ * Returns whether identical concurrent reads are coalesced.
+ */
+bool Config::requestCoalescingEnabled() const { return request_coalescing_; }
+
+/**
+ * Enables a byte-bounded near cache of GET and HGET results.
+ */
+Config& Config::withNearCache(size_t max_bytes) {
+  near_cache_max_bytes_ = max_bytes;
+  return *this;
+}
+
+/**
+ * Returns the maximum size of the near cache in bytes.
+ */
+size_t Config::nearCacheMaxBytes() const { return near_cache_max_bytes_; }
+
+/**
+ * Sets the number of multiplexed connections opened to each node.
+ */
+Config& Config::withConnectionsPerNode(uint32_t connections) {
+  connections_per_node_ = connections;
+  return *this;
+}
+
+/**
+ * Returns the number of connections opened to each node.
+ */
+uint32_t Config::connectionsPerNode() const { return connections_per_node_; }
+
+/**
+ * Hedges reads slower than the given latency percentile.
+ */
+Config& Config::withReadHedging(float percentile) {
+  read_hedging_percentile_ = percentile;
+  return *this;
+}
+
+/**
+ * Returns the latency percentile after which reads are hedged.
+ */
+float Config::readHedgingPercentile() const { return read_hedging_percentile_; }
+
+/**
+ * Sends blocking commands over up to `limit` dedicated connections.
+ */
+Config& Config::withBlockingConnections(uint32_t limit) {
+  blocking_connections_limit_ = limit;
+  return *this;
+}
+
+/**
+ * Returns the maximum number of dedicated connections for blocking commands.
+ */
+uint32_t Config::blockingConnectionsLimit() const {
+  return blocking_connections_limit_;
+}
+
+/**
+ * Compresses values of at least `min_size` bytes with the given algorithm.
+ */
+Config& Config::withValueCompression(ValueCompression compression,
+                                     uint32_t min_size) {
+  value_compression_ = compression;
+  value_compression_min_size_ = min_size;
+  return *this;
+}
+
+/**
+ * Returns the algorithm values are compressed with.
+ */
+ValueCompression Config::valueCompression() const { return value_compression_; }
+
+/**
+ * Returns the size in bytes from which values are compressed.
+ */
+uint32_t Config::valueCompressionMinSize() const {
+  return value_compression_min_size_;
+}
+
+/**
+ * Exports OpenTelemetry traces to the given endpoint.
+ */
+Config& Config::withTracesExporter(const std::string& endpoint,
+                                   uint32_t sample_percentage) {
+  telemetry_.traces_endpoint = endpoint;
+  telemetry_.sample_percentage = sample_percentage;
+  return *this;
+}
+
+/**
+ * Exports OpenTelemetry metrics to the given endpoint.
+ */
+Config& Config::withMetricsExporter(const std::string& endpoint) {
+  telemetry_.metrics_endpoint = endpoint;
+  return *this;
+}
+
+/**
+ * Sets the interval between consecutive OpenTelemetry exports.
+ */
+Config& Config::withTelemetryFlushInterval(
+    std::chrono::milliseconds interval) {
+  telemetry_.flush_interval = interval;
+  return *this;
+}
+
+/**
+ * Returns the OpenTelemetry configuration.
+ */
+const TelemetryConfig& Config::telemetry() const { return telemetry_; }
+
 /**
  * Serializes the configuration into a byte array using Protocol Buffers.
  */
@@ -205,6 +378,9 @@ std::optional<std::vector<uint8_t>> Config::serialize() {
     na->set_port(i.port);
   }
 
+  // Cluster mode.
+  cr.set_cluster_mode_enabled(cluster_mode_);
+
   // Credentials.
   if (!credential_.username.empty() && !credential_.password.empty()) {
     connection_request::AuthenticationInfo* ai =
@@ -253,6 +429,35 @@ std::optional<std::vector<uint8_t>> Config::serialize() {
       break;
   }
 
+  // Client tracking, which keeps the near cache coherent.
+  if (near_cache_max_bytes_ > 0) {
+    cr.set_client_tracking(true);
+  }
+
+  // Connections per node.
+  if (connections_per_node_ > 1) {
+    cr.set_connections_per_node(connections_per_node_);
+  }
+
+  // Read hedging.
+  if (read_hedging_percentile_ > 0) {
+    cr.set_read_hedging_percentile(read_hedging_percentile_);
+  }
+
+  // Blocking commands.
+  if (blocking_connections_limit_ > 0) {
+    cr.set_blocking_connections_limit(blocking_connections_limit_);
+  }
+
+  // Value compression.
+  if (value_compression_ != ValueCompression::None) {
+    auto* compression = cr.mutable_value_compression();
+    compression->set_algorithm(value_compression_ == ValueCompression::Zstd
+                                   ? connection_request::Zstd
+                                   : connection_request::Lz4);
+    compression->set_min_size(value_compression_min_size_);
+  }
+
   // Serializing.
   std::vector<uint8_t> output(cr.ByteSizeLong());
   bool serialization_success =
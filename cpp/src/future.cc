@@ -36,6 +36,9 @@ void IFuture::wait() {
  */
 void MethodAccess::set_value(IFuture* resp,
                              const core::CommandResponse* message) {
+  // Recorded before the value is set since a waiter may release the future
+  // as soon as it becomes ready.
+  if (resp->stats_) resp->stats_->record_success(resp->type_, resp->start_);
   resp->set_value(message);
 }
 
@@ -47,7 +50,24 @@ void MethodAccess::set_value(IFuture* resp,
  */
 void MethodAccess::set_value(IFuture* resp, core::RequestErrorType type,
                              const char* message) {
+  if (resp->stats_) {
+    resp->stats_->record_failure(resp->type_, type, resp->start_);
+  }
   resp->set_value(type, message);
 }
 
+/**
+ * @brief Registers a future with a statistics recorder.
+ * @param resp The future to track.
+ * @param stats The recorder to notify.
+ * @param type The request type of the command.
+ */
+void MethodAccess::track(IFuture* resp, StatsRecorder* stats,
+                         core::RequestType type) {
+  resp->stats_ = stats;
+  resp->type_ = type;
+  resp->start_ = std::chrono::steady_clock::now();
+  stats->record_start(type);
+}
+
 }  // namespace glide
@@ -2,7 +2,12 @@
 #include <glide/glide_base.h>
 #include <glide/helper.h>
 
+#include <chrono>
+#include <cstdint>
+#include <functional>
 #include <string>
+#include <thread>
+#include <vector>
 
 namespace glide {
 
@@ -28,4 +33,59 @@ absl::Status ConvertRequestError(core::RequestErrorType type,
   }
 }
 
+/**
+ * @brief Decides whether a request should be traced.
+ */
+bool ShouldSample(uint32_t percentage) {
+  if (percentage == 0) return false;
+  if (percentage >= 100) return true;
+
+  // xorshift64*, seeded per thread.
+  thread_local uint64_t state =
+      (static_cast<uint64_t>(
+           std::chrono::steady_clock::now().time_since_epoch().count()) ^
+       std::hash<std::thread::id>()(std::this_thread::get_id())) |
+      1;
+  state ^= state >> 12;
+  state ^= state << 25;
+  state ^= state >> 27;
+  uint64_t value = state * 0x2545F4914F6CDD1DULL;
+  return (value >> 32) % 100 < percentage;
+}
+
+/**
+ * @brief Encodes a request type and its arguments into a lookup key.
+ */
+std::string RequestKey(core::RequestType type,
+                       const std::vector<std::string>& args) {
+  size_t size = sizeof(uint32_t);
+  for (const auto& arg : args) {
+    size += sizeof(uint64_t) + arg.size();
+  }
+  std::string key;
+  key.reserve(size);
+  auto type_value = static_cast<uint32_t>(type);
+  key.append(reinterpret_cast<const char*>(&type_value), sizeof(type_value));
+  for (const auto& arg : args) {
+    uint64_t len = arg.size();
+    key.append(reinterpret_cast<const char*>(&len), sizeof(len));
+    key.append(arg);
+  }
+  return key;
+}
+
+/**
+ * @brief Copies the string elements of an array response.
+ */
+std::vector<std::string> ArrayToStrings(const core::CommandResponse* resp) {
+  std::vector<std::string> values;
+  if (resp->response_type != core::ResponseType::Array) return values;
+  values.reserve(resp->array_value_len);
+  for (long i = 0; i < resp->array_value_len; ++i) {
+    const core::CommandResponse& element = resp->array_value[i];
+    values.emplace_back(element.string_value, element.string_value_len);
+  }
+  return values;
+}
+
 }  // namespace glide
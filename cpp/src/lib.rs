@@ -9,13 +9,22 @@ use glide_core::errors;
 use glide_core::errors::RequestErrorType;
 use glide_core::request_type::RequestType;
 use glide_core::ConnectionRequest;
+use glide_core::{
+    GlideOpenTelemetry, GlideOpenTelemetryConfigBuilder, GlideOpenTelemetrySignalsExporter,
+    GlideSpan, DEFAULT_FLUSH_SIGNAL_INTERVAL_MS,
+};
 use protobuf::Message;
 use redis::cluster_routing::{
     MultipleNodeRoutingInfo, Route, RoutingInfo, SingleNodeRoutingInfo, SlotAddr,
 };
 use redis::cluster_routing::{ResponsePolicy, Routable};
-use redis::{Cmd, RedisResult, Value};
+use redis::{
+    ClusterScanArgs, Cmd, ObjectType, ParallelScanOptions, PushInfo, PushKind, RedisResult, Value,
+};
+use std::ffi::CStr;
 use std::slice::from_raw_parts;
+use std::str::FromStr;
+use std::sync::Arc;
 use std::{
     ffi::{c_void, CString},
     mem,
@@ -118,6 +127,54 @@ pub type FailureCallback = unsafe extern "C" fn(
     error_type: RequestErrorType,
 ) -> ();
 
+/// Invalidation callback that is called when the server invalidates keys tracked for client side caching.
+///
+/// The callback is only invoked when client tracking is enabled in the connection request. It needs to copy the given keys synchronously, since they will be dropped by Rust once the callback returns.
+///
+/// `context` is the value passed as `invalidation_context` to [`create_client`].
+/// `keys` is an array of `key_count` pointers to the invalidated keys, whose lengths are given in `key_lens`.
+/// A null `keys` array means that every key must be invalidated, e.g. after the server was flushed or the connection was re-established.
+pub type InvalidationCallback = unsafe extern "C" fn(
+    context: usize,
+    keys: *const *const u8,
+    key_lens: *const usize,
+    key_count: usize,
+) -> ();
+
+/// Keys callback of [`parallel_cluster_scan`], called with each batch of keys found.
+///
+/// The callback needs to copy the given keys synchronously, since they will be dropped by Rust once the callback returns. The callback should return quickly, as the scan slows down while batches are pending.
+///
+/// `context` is the value passed as `keys_context` to [`parallel_cluster_scan`].
+/// `keys` is an array of `key_count` pointers to the keys, whose lengths are given in `key_lens`.
+/// A null `keys` array marks the end of the scan: the callback is not called again, and the success or failure callback is called on the scan's channel right after.
+pub type ScanKeysCallback = unsafe extern "C" fn(
+    context: usize,
+    keys: *const *const u8,
+    key_lens: *const usize,
+    key_count: usize,
+) -> ();
+
+/// Configuration of a parallel cluster scan.
+///
+/// - `match_pattern`: The pattern keys must match, `null` to return every key.
+/// - `match_pattern_len`: The number of bytes in `match_pattern`.
+/// - `count`: The `COUNT` hint sent with each `SCAN` command, `0` for the server's default.
+/// - `object_type`: The type keys must have, e.g. `hash`, `null` for any type.
+/// - `concurrency`: The number of nodes scanned at the same time, `0` for the default.
+/// - `max_scans_per_second`: An upper bound on the `SCAN` commands sent per second, `0` for none.
+/// - `allow_non_covered_slots`: Whether to scan the covered slots when some slots aren't covered, instead of failing.
+#[repr(C)]
+pub struct ParallelScanConfig {
+    pub match_pattern: *const u8,
+    pub match_pattern_len: usize,
+    pub count: u32,
+    pub object_type: *const c_char,
+    pub concurrency: u32,
+    pub max_scans_per_second: u32,
+    pub allow_non_covered_slots: bool,
+}
+
 /// The connection response.
 ///
 /// It contains either a connection or an error. It is represented as a struct instead of a union for ease of use in the wrapper language.
@@ -139,10 +196,52 @@ pub struct ClientAdapter {
     runtime: Runtime,
 }
 
+/// Forwards a key invalidation push message to the invalidation callback.
+///
+/// # Safety
+///
+/// * `callback` must be a valid [`InvalidationCallback`].
+unsafe fn dispatch_invalidation(callback: InvalidationCallback, context: usize, push: PushInfo) {
+    match push.kind {
+        PushKind::Invalidate => {}
+        // Invalidations sent while the connection was down were lost.
+        PushKind::Disconnection => {
+            unsafe { callback(context, std::ptr::null(), std::ptr::null(), 0) };
+            return;
+        }
+        _ => return,
+    }
+    match push.data.into_iter().next() {
+        Some(Value::Array(keys)) => unsafe { dispatch_keys(callback, context, keys) },
+        // A null payload invalidates every key, e.g. after FLUSHALL.
+        _ => unsafe { callback(context, std::ptr::null(), std::ptr::null(), 0) },
+    }
+}
+
+/// Passes the bulk string keys among `keys` to a keys callback.
+///
+/// # Safety
+///
+/// * `callback` must be a valid [`InvalidationCallback`] or [`ScanKeysCallback`].
+unsafe fn dispatch_keys(callback: ScanKeysCallback, context: usize, keys: Vec<Value>) {
+    let keys: Vec<Vec<u8>> = keys
+        .into_iter()
+        .filter_map(|key| match key {
+            Value::BulkString(bytes) => Some(bytes),
+            _ => None,
+        })
+        .collect();
+    let key_ptrs: Vec<*const u8> = keys.iter().map(|key| key.as_ptr()).collect();
+    let key_lens: Vec<usize> = keys.iter().map(|key| key.len()).collect();
+    unsafe { callback(context, key_ptrs.as_ptr(), key_lens.as_ptr(), keys.len()) };
+}
+
 fn create_client_internal(
     connection_request_bytes: &[u8],
     success_callback: SuccessCallback,
     failure_callback: FailureCallback,
+    invalidation_callback: Option<InvalidationCallback>,
+    invalidation_context: usize,
 ) -> Result<ClientAdapter, String> {
     let request = connection_request::ConnectionRequest::parse_from_bytes(connection_request_bytes)
         .map_err(|err| err.to_string())?;
@@ -156,8 +255,20 @@ fn create_client_internal(
             let redis_error = err.into();
             errors::error_message(&redis_error)
         })?;
+    let push_sender = invalidation_callback.map(|callback| {
+        let (push_tx, mut push_rx) = tokio::sync::mpsc::unbounded_channel();
+        runtime.spawn(async move {
+            while let Some(push) = push_rx.recv().await {
+                unsafe { dispatch_invalidation(callback, invalidation_context, push) };
+            }
+        });
+        push_tx
+    });
     let client = runtime
-        .block_on(GlideClient::new(ConnectionRequest::from(request), None))
+        .block_on(GlideClient::new(
+            ConnectionRequest::from(request),
+            push_sender,
+        ))
         .map_err(|err| err.to_string())?;
     Ok(ClientAdapter {
         client,
@@ -175,6 +286,8 @@ fn create_client_internal(
 /// `connection_request_len` is the number of bytes in `connection_request_bytes`.
 /// `success_callback` is the callback that will be called when a command succeeds.
 /// `failure_callback` is the callback that will be called when a command fails.
+/// `invalidation_callback` is the optional callback that will be called when tracked keys are invalidated.
+/// `invalidation_context` is passed back to `invalidation_callback` to identify the client.
 ///
 /// # Safety
 ///
@@ -183,6 +296,7 @@ fn create_client_internal(
 /// * The `conn_ptr` pointer in the returned `ConnectionResponse` must live while the client is open/active and must be explicitly freed by calling [`close_client`].
 /// * The `connection_error_message` pointer in the returned `ConnectionResponse` must live until the returned `ConnectionResponse` pointer is passed to [`free_connection_response`].
 /// * Both the `success_callback` and `failure_callback` function pointers need to live while the client is open/active. The caller is responsible for freeing both callbacks.
+/// * `invalidation_callback`, if not null, and `invalidation_context` need to live while the client is open/active.
 // TODO: Consider making this async
 #[no_mangle]
 pub unsafe extern "C" fn create_client(
@@ -190,10 +304,18 @@ pub unsafe extern "C" fn create_client(
     connection_request_len: usize,
     success_callback: SuccessCallback,
     failure_callback: FailureCallback,
+    invalidation_callback: Option<InvalidationCallback>,
+    invalidation_context: usize,
 ) -> *const ConnectionResponse {
     let request_bytes =
         unsafe { std::slice::from_raw_parts(connection_request_bytes, connection_request_len) };
-    let response = match create_client_internal(request_bytes, success_callback, failure_callback) {
+    let response = match create_client_internal(
+        request_bytes,
+        success_callback,
+        failure_callback,
+        invalidation_callback,
+        invalidation_context,
+    ) {
         Err(err) => ConnectionResponse {
             conn_ptr: std::ptr::null(),
             connection_error_message: CString::into_raw(
@@ -502,6 +624,8 @@ fn valkey_value_to_command_response(value: Value) -> RedisResult<CommandResponse
 ///
 /// # Safety
 ///
+/// * `span_ptr` is a valid pointer to [`Arc<GlideSpan>`], a span created by [`create_otel_span`] or `0`.
+///   The command keeps its own reference to the span, so the caller may drop it once this function returns.
 /// * TODO: finish safety section.
 #[no_mangle]
 pub unsafe extern "C" fn command(
@@ -513,6 +637,7 @@ pub unsafe extern "C" fn command(
     args_len: *const c_ulong,
     route_bytes: *const u8,
     route_bytes_len: usize,
+    span_ptr: u64,
 ) {
     let client_adapter =
         unsafe { Box::leak(Box::from_raw(client_adapter_ptr as *mut ClientAdapter)) };
@@ -533,15 +658,22 @@ pub unsafe extern "C" fn command(
     for command_arg in arg_vec {
         cmd.arg(command_arg);
     }
+    if span_ptr != 0 {
+        cmd.set_span(unsafe { get_unsafe_span_from_ptr(Some(span_ptr)) });
+    }
 
     let r_bytes = unsafe { std::slice::from_raw_parts(route_bytes, route_bytes_len) };
 
     let route = Routes::parse_from_bytes(r_bytes).unwrap();
 
     client_adapter.runtime.spawn(async move {
+        let child_span = create_child_span(cmd.span().as_ref(), "send_command");
         let result = client_clone
             .send_command(&cmd, get_route(route, Some(&cmd)))
             .await;
+        if let Ok(span) = child_span {
+            span.end();
+        }
         let client_adapter = unsafe { Box::leak(Box::from_raw(ptr_address as *mut ClientAdapter)) };
         let value = match result {
             Ok(value) => value,
@@ -578,6 +710,91 @@ pub unsafe extern "C" fn command(
     });
 }
 
+/// Scans the keys of a cluster, several nodes at a time, passing each batch of keys found to `keys_callback` as it arrives.
+///
+/// Every key that exists from the start to the end of the scan is passed at least once. Once the scan has ended, `keys_callback` is called with null keys, then the success callback is called on `channel` with an `OK` response, or the failure callback with the error. Standalone clients fail right away.
+///
+/// # Safety
+///
+/// * `client_adapter_ptr` must be obtained from the `ConnectionResponse` returned from [`create_client`], and must be valid until the scan has ended.
+/// * `scan_config` and the strings it points to must be valid until this function returns.
+/// * `keys_callback` and `keys_context` must be valid until `keys_callback` is called with null keys.
+#[no_mangle]
+pub unsafe extern "C" fn parallel_cluster_scan(
+    client_adapter_ptr: *const c_void,
+    channel: usize,
+    scan_config: *const ParallelScanConfig,
+    keys_callback: ScanKeysCallback,
+    keys_context: usize,
+) {
+    let client_adapter =
+        unsafe { Box::leak(Box::from_raw(client_adapter_ptr as *mut ClientAdapter)) };
+    let ptr_address = client_adapter_ptr as usize;
+    let scan_config = unsafe { &*scan_config };
+
+    let mut args =
+        ClusterScanArgs::builder().allow_non_covered_slots(scan_config.allow_non_covered_slots);
+    if !scan_config.match_pattern.is_null() {
+        let pattern =
+            unsafe { from_raw_parts(scan_config.match_pattern, scan_config.match_pattern_len) };
+        args = args.with_match_pattern(pattern);
+    }
+    if scan_config.count > 0 {
+        args = args.with_count(scan_config.count);
+    }
+    if !scan_config.object_type.is_null() {
+        let object_type = unsafe { CStr::from_ptr(scan_config.object_type) };
+        args = args.with_object_type(ObjectType::from(object_type.to_string_lossy().into_owned()));
+    }
+    let mut options = ParallelScanOptions::default();
+    if scan_config.concurrency > 0 {
+        options.concurrency = scan_config.concurrency as usize;
+    }
+    if scan_config.max_scans_per_second > 0 {
+        options.max_scans_per_second = Some(scan_config.max_scans_per_second);
+    }
+
+    // Room for a couple of batches per node, so that a slow callback doesn't stall every node.
+    let (keys_sender, mut keys_receiver) = tokio::sync::mpsc::channel(options.concurrency * 2);
+    let client_clone = client_adapter.client.clone();
+    client_adapter.runtime.spawn(async move {
+        let scan = client_clone.parallel_cluster_scan(args.build(), options, keys_sender);
+        tokio::pin!(scan);
+        let result = loop {
+            tokio::select! {
+                result = &mut scan => break result,
+                Some(keys) = keys_receiver.recv() => unsafe {
+                    dispatch_keys(keys_callback, keys_context, keys)
+                },
+            }
+        };
+        // Batches sent right before the scan ended.
+        while let Ok(keys) = keys_receiver.try_recv() {
+            unsafe { dispatch_keys(keys_callback, keys_context, keys) };
+        }
+        unsafe { keys_callback(keys_context, std::ptr::null(), std::ptr::null(), 0) };
+
+        let client_adapter = unsafe { Box::leak(Box::from_raw(ptr_address as *mut ClientAdapter)) };
+        let result = result.and_then(|()| valkey_value_to_command_response(Value::Okay));
+        unsafe {
+            match result {
+                Ok(message) => {
+                    (client_adapter.success_callback)(channel, Box::into_raw(Box::new(message)))
+                }
+                Err(err) => {
+                    let message = errors::error_message(&err);
+                    let error_type = errors::error_type(&err);
+
+                    let c_err_str = CString::into_raw(
+                        CString::new(message).expect("Couldn't convert error message to CString"),
+                    );
+                    (client_adapter.failure_callback)(channel, c_err_str, error_type);
+                }
+            };
+        }
+    });
+}
+
 fn get_route(route: Routes, cmd: Option<&Cmd>) -> Option<RoutingInfo> {
     use glide_core::command_request::routes::Value;
     let route = route.value?;
@@ -639,3 +856,157 @@ fn get_slot_addr(slot_type: &protobuf::EnumOrUnknown<SlotTypes>) -> SlotAddr {
         })
         .expect("Received unexpected slot id type")
 }
+
+/// Creates an OpenTelemetry span with the given name and returns a pointer to the span as u64.
+///
+/// Returns `0` if the request type has no command name. The span must be released with [`drop_otel_span`].
+#[no_mangle]
+pub extern "C" fn create_otel_span(request_type: RequestType) -> u64 {
+    let cmd = match request_type.get_command() {
+        Some(cmd) => cmd,
+        None => return 0,
+    };
+    let cmd_bytes = match cmd.command() {
+        Some(bytes) => bytes,
+        None => return 0,
+    };
+    let command_name = match std::str::from_utf8(cmd_bytes.as_slice()) {
+        Ok(name) => name,
+        Err(_) => return 0,
+    };
+
+    let span = GlideOpenTelemetry::new_span(command_name);
+    Arc::into_raw(Arc::new(span)) as u64
+}
+
+/// Drops an OpenTelemetry span given its pointer as u64.
+///
+/// # Safety
+/// * `span_ptr` must be a valid pointer to a [`Arc<GlideSpan>`] span created by [`create_otel_span`] or `0`.
+#[no_mangle]
+pub unsafe extern "C" fn drop_otel_span(span_ptr: u64) {
+    if span_ptr == 0 {
+        return;
+    }
+    unsafe {
+        drop(Arc::from_raw(span_ptr as *const GlideSpan));
+    }
+}
+
+/// Configuration for OpenTelemetry integration in the C++ client.
+///
+/// - `traces_endpoint`: The endpoint to which trace data will be exported, `null` to disable traces.
+/// - `sample_percentage`: The percentage of requests to sample and create a span for.
+/// - `metrics_endpoint`: The endpoint to which metrics data will be exported, `null` to disable metrics.
+/// - `flush_interval_ms`: Interval in milliseconds between consecutive exports, `0` for the default.
+///
+/// Endpoints are expected in the form `grpc://host:port`, `http(s)://host:port` or
+/// `file:///absolute/path/to/folder/file.json`. At least one endpoint must be provided.
+#[repr(C)]
+pub struct OpenTelemetryConfig {
+    pub traces_endpoint: *const c_char,
+    pub sample_percentage: u32,
+    pub metrics_endpoint: *const c_char,
+    pub flush_interval_ms: i64,
+}
+
+/// Initializes OpenTelemetry with the given configuration.
+///
+/// OpenTelemetry is process-wide and can only be initialized once; later calls are no-ops.
+/// Returns `null` on success, or an error message that must be freed with [`free_c_string`].
+///
+/// # Safety
+/// * `open_telemetry_config` and its endpoint strings must be valid until the function returns.
+#[no_mangle]
+pub unsafe extern "C" fn init_open_telemetry(
+    open_telemetry_config: *const OpenTelemetryConfig,
+) -> *const c_char {
+    let to_c_error = |message: String| {
+        CString::new(message)
+            .unwrap_or_else(|_| CString::new("Couldn't convert error message to C string").unwrap())
+            .into_raw() as *const c_char
+    };
+    let otel_config = unsafe { &*open_telemetry_config };
+    if otel_config.traces_endpoint.is_null() && otel_config.metrics_endpoint.is_null() {
+        return to_c_error(
+            "At least one of traces or metrics must be provided for OpenTelemetry configuration"
+                .to_string(),
+        );
+    }
+
+    let mut config = GlideOpenTelemetryConfigBuilder::default();
+
+    if !otel_config.traces_endpoint.is_null() {
+        let endpoint = unsafe { CStr::from_ptr(otel_config.traces_endpoint) }.to_string_lossy();
+        match GlideOpenTelemetrySignalsExporter::from_str(&endpoint) {
+            Ok(exporter) => {
+                config = config.with_trace_exporter(exporter, Some(otel_config.sample_percentage));
+            }
+            Err(e) => return to_c_error(format!("Invalid traces exporter configuration: {e}")),
+        }
+    }
+
+    if !otel_config.metrics_endpoint.is_null() {
+        let endpoint = unsafe { CStr::from_ptr(otel_config.metrics_endpoint) }.to_string_lossy();
+        match GlideOpenTelemetrySignalsExporter::from_str(&endpoint) {
+            Ok(exporter) => config = config.with_metrics_exporter(exporter),
+            Err(e) => return to_c_error(format!("Invalid metrics exporter configuration: {e}")),
+        }
+    }
+
+    let flush_interval_ms = match otel_config.flush_interval_ms {
+        0 => DEFAULT_FLUSH_SIGNAL_INTERVAL_MS as i64,
+        ms if ms < 0 => {
+            return to_c_error(format!(
+                "InvalidInput: flushIntervalMs must be a positive integer (got: {ms})"
+            ))
+        }
+        ms => ms,
+    };
+    config = config.with_flush_interval(std::time::Duration::from_millis(flush_interval_ms as u64));
+
+    match glide_core::client::get_or_init_runtime() {
+        Ok(glide_runtime) => match glide_runtime
+            .runtime
+            .block_on(async { GlideOpenTelemetry::initialise(config.build()) })
+        {
+            Ok(_) => std::ptr::null(),
+            Err(e) => to_c_error(format!("Failed to initialize OpenTelemetry: {e}")),
+        },
+        Err(e) => to_c_error(e),
+    }
+}
+
+/// Frees a C string returned by [`init_open_telemetry`].
+///
+/// # Safety
+/// * `s` must be a valid pointer to a C string or `null`.
+#[no_mangle]
+pub unsafe extern "C" fn free_c_string(s: *mut c_char) {
+    if !s.is_null() {
+        drop(unsafe { CString::from_raw(s) });
+    }
+}
+
+/// Converts a raw pointer to an [`Arc<GlideSpan>`] into a cloned [`GlideSpan`], leaving the
+/// caller's reference intact.
+///
+/// # Safety
+///
+/// * `command_span` must be `None` or a valid pointer created by [`create_otel_span`].
+unsafe fn get_unsafe_span_from_ptr(command_span: Option<u64>) -> Option<GlideSpan> {
+    command_span.map(|command_span| unsafe {
+        Arc::increment_strong_count(command_span as *const GlideSpan);
+        (*Arc::from_raw(command_span as *const GlideSpan)).clone()
+    })
+}
+
+/// Creates a child span for telemetry if a parent span is provided.
+fn create_child_span(span: Option<&GlideSpan>, name: &str) -> Result<GlideSpan, String> {
+    let parent_span = span.ok_or_else(|| "No parent span provided".to_string())?;
+    parent_span.add_span(name).map_err(|error_msg| {
+        format!(
+            "Opentelemetry failed to create child span with name `{name}`. Error: {error_msg:?}"
+        )
+    })
+}
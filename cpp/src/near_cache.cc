@@ -0,0 +1,307 @@
+#include <absl/strings/match.h>
+#include <glide/helper.h>
+#include <glide/near_cache.h>
+
+#include <functional>
+#include <iterator>
+
+namespace glide {
+
+/**
+ * @brief Constructs a wrapper for a read sent to the server.
+ */
+CachingFuture::CachingFuture(NearCache* owner, IFuture* target,
+                             std::string request_key, std::string key,
+                             uint64_t epoch)
+    : owner_(owner),
+      target_(target),
+      request_key_(std::move(request_key)),
+      key_(std::move(key)),
+      epoch_(epoch) {}
+
+/**
+ * @brief Caches the response and delivers it to the wrapped future.
+ */
+void CachingFuture::set_value(const core::CommandResponse* resp) {
+  owner_->fill(this, resp);
+  MethodAccess::set_value(target_, resp);
+  delete this;
+}
+
+/**
+ * @brief Delivers the error to the wrapped future.
+ */
+void CachingFuture::set_value(const core::RequestErrorType type,
+                              const char* message) {
+  owner_->fill(this, nullptr);
+  MethodAccess::set_value(target_, type, message);
+  delete this;
+}
+
+/**
+ * @brief Returns whether results of the given request type may be cached.
+ */
+bool NearCache::is_cacheable(core::RequestType type) {
+  switch (type) {
+    case core::RequestType::Get:
+    case core::RequestType::HGet:
+      return true;
+    default:
+      return false;
+  }
+}
+
+/**
+ * @brief Constructs an empty cache.
+ */
+NearCache::NearCache(size_t max_bytes)
+    : shard_max_bytes_(max_bytes / SHARD_COUNT) {}
+
+/**
+ * Returns the shard holding the reads of a key.
+ */
+NearCache::Shard& NearCache::shard(const std::string& key) {
+  return shards_[std::hash<std::string>()(key) % SHARD_COUNT];
+}
+
+/**
+ * Removes an entry from all the indexes of its shard.
+ */
+void NearCache::erase(Shard& shard, std::list<Entry>::iterator it) {
+  auto range = shard.by_key.equal_range(it->key);
+  for (auto k = range.first; k != range.second; ++k) {
+    if (k->second == it) {
+      shard.by_key.erase(k);
+      break;
+    }
+  }
+  shard.entries.erase(it->request_key);
+  shard.bytes -= it->bytes;
+  shard.lru.erase(it);
+}
+
+/**
+ * Drops the cached reads of a key and moves its in-flight reads to a new
+ * epoch. The shard lock must be held.
+ */
+void NearCache::invalidate_locked(Shard& shard, const std::string& key) {
+  auto range = shard.by_key.equal_range(key);
+  std::vector<std::list<Entry>::iterator> stale;
+  for (auto k = range.first; k != range.second; ++k) {
+    stale.push_back(k->second);
+  }
+  for (auto it : stale) {
+    erase(shard, it);
+  }
+  auto fill = shard.fills.find(key);
+  if (fill != shard.fills.end()) {
+    fill->second.epoch = shard.next_epoch++;
+  }
+}
+
+/**
+ * @brief Completes the future from the cache, if the result is cached.
+ */
+bool NearCache::lookup(core::RequestType type,
+                       const std::vector<std::string>& args, IFuture* future) {
+  if (args.empty()) {
+    return false;
+  }
+  std::string request_key = RequestKey(type, args);
+  Shard& s = shard(args.front());
+
+  core::ResponseType response_type;
+  std::string value;
+  {
+    std::lock_guard<std::mutex> lock(s.mtx);
+    auto it = s.entries.find(request_key);
+    if (it == s.entries.end()) {
+      return false;
+    }
+    s.lru.splice(s.lru.begin(), s.lru, it->second);
+    response_type = it->second->type;
+    value = it->second->value;
+  }
+
+  // Completed in place, as the core would for a response from the server.
+  core::CommandResponse resp{};
+  resp.response_type = response_type;
+  resp.string_value = value.data();
+  resp.string_value_len = static_cast<long>(value.size());
+  MethodAccess::set_value(future, &resp);
+  return true;
+}
+
+/**
+ * @brief Wraps the channel of a read sent to the server so that its response
+ * is cached.
+ */
+void NearCache::track(core::RequestType type,
+                      const std::vector<std::string>& args,
+                      uintptr_t* channel) {
+  if (args.empty()) {
+    return;
+  }
+  const std::string& key = args.front();
+  Shard& s = shard(key);
+
+  uint64_t epoch;
+  {
+    std::lock_guard<std::mutex> lock(s.mtx);
+    auto it = s.fills.find(key);
+    if (it == s.fills.end()) {
+      it = s.fills.emplace(key, Fill{s.next_epoch++, 0}).first;
+    }
+    ++it->second.outstanding;
+    epoch = it->second.epoch;
+  }
+
+  auto* pending =
+      new CachingFuture(this, reinterpret_cast<IFuture*>(*channel),
+                        RequestKey(type, args), key, epoch);
+  *channel = reinterpret_cast<uintptr_t>(pending);
+}
+
+/**
+ * @brief Caches a response if its key was not invalidated since the read was
+ * sent, and releases the fill.
+ */
+void NearCache::fill(CachingFuture* pending,
+                     const core::CommandResponse* resp) {
+  bool cacheable = resp && (resp->response_type == core::ResponseType::String ||
+                            resp->response_type == core::ResponseType::Null);
+  Entry entry;
+  if (cacheable) {
+    entry.request_key = pending->request_key_;
+    entry.key = pending->key_;
+    entry.type = resp->response_type;
+    if (resp->string_value) {
+      entry.value.assign(resp->string_value,
+                         static_cast<size_t>(resp->string_value_len));
+    }
+    entry.bytes = entry.request_key.size() + entry.key.size() +
+                  entry.value.size() + ENTRY_OVERHEAD;
+    cacheable = entry.bytes <= shard_max_bytes_;
+  }
+
+  Shard& s = shard(pending->key_);
+  std::lock_guard<std::mutex> lock(s.mtx);
+  auto fill = s.fills.find(pending->key_);
+  if (fill == s.fills.end()) {
+    return;
+  }
+  bool current = fill->second.epoch == pending->epoch_;
+  if (--fill->second.outstanding == 0) {
+    s.fills.erase(fill);
+  }
+  if (!cacheable || !current) {
+    return;
+  }
+
+  auto existing = s.entries.find(entry.request_key);
+  if (existing != s.entries.end()) {
+    erase(s, existing->second);
+  }
+  s.bytes += entry.bytes;
+  s.lru.push_front(std::move(entry));
+  auto it = s.lru.begin();
+  s.entries.emplace(it->request_key, it);
+  s.by_key.emplace(it->key, it);
+  while (s.bytes > shard_max_bytes_) {
+    erase(s, std::prev(s.lru.end()));
+  }
+}
+
+/**
+ * Returns whether a command replaces the contents of the database the client
+ * reads from.
+ */
+static bool ReplacesDatabase(core::RequestType type,
+                             const std::vector<std::string>& args) {
+  switch (type) {
+    case core::RequestType::FlushAll:
+    case core::RequestType::FlushDB:
+    case core::RequestType::SwapDb:
+    case core::RequestType::Select:
+      return true;
+    case core::RequestType::CustomCommand:
+      if (args.empty()) {
+        return false;
+      }
+      for (const char* name : {"FLUSHALL", "FLUSHDB", "SWAPDB", "SELECT"}) {
+        if (absl::EqualsIgnoreCase(args.front(), name)) {
+          return true;
+        }
+      }
+      return false;
+    default:
+      return false;
+  }
+}
+
+/**
+ * @brief Drops the cached reads a write sent through the client may modify.
+ */
+void NearCache::note_write(core::RequestType type,
+                           const std::vector<std::string>& args) {
+  if (ReplacesDatabase(type, args)) {
+    invalidate_all();
+    return;
+  }
+  // The first argument of a custom command is its name.
+  size_t first = type == core::RequestType::CustomCommand ? 1 : 0;
+  for (size_t i = first; i < args.size(); ++i) {
+    invalidate(args[i]);
+  }
+}
+
+/**
+ * @brief Drops every cached read of a key.
+ */
+void NearCache::invalidate(const std::string& key) {
+  Shard& s = shard(key);
+  std::lock_guard<std::mutex> lock(s.mtx);
+  invalidate_locked(s, key);
+}
+
+/**
+ * @brief Drops every cached read.
+ */
+void NearCache::invalidate_all() {
+  for (auto& s : shards_) {
+    std::lock_guard<std::mutex> lock(s.mtx);
+    s.lru.clear();
+    s.entries.clear();
+    s.by_key.clear();
+    s.bytes = 0;
+    for (auto& fill : s.fills) {
+      fill.second.epoch = s.next_epoch++;
+    }
+  }
+}
+
+/**
+ * @brief Returns the number of cached results.
+ */
+size_t NearCache::size() const {
+  size_t total = 0;
+  for (const auto& s : shards_) {
+    std::lock_guard<std::mutex> lock(s.mtx);
+    total += s.lru.size();
+  }
+  return total;
+}
+
+/**
+ * @brief Returns the number of bytes accounted for the cached results.
+ */
+size_t NearCache::bytes() const {
+  size_t total = 0;
+  for (const auto& s : shards_) {
+    std::lock_guard<std::mutex> lock(s.mtx);
+    total += s.bytes;
+  }
+  return total;
+}
+
+}  // namespace glide
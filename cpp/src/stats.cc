@@ -0,0 +1,246 @@
+#include <glide/stats.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace glide {
+
+namespace {
+
+/**
+ * Returns the shard assigned to the calling thread. Threads are assigned
+ * shards round-robin on first use.
+ */
+size_t thread_shard() {
+  static std::atomic<size_t> next_shard{0};
+  thread_local size_t shard =
+      next_shard.fetch_add(1, std::memory_order_relaxed) %
+      StatsRecorder::SHARD_COUNT;
+  return shard;
+}
+
+/**
+ * Returns the index of the most significant set bit of a non-zero value.
+ */
+uint32_t highest_bit(uint64_t value) {
+  uint32_t bit = 0;
+  while (value >>= 1) {
+    ++bit;
+  }
+  return bit;
+}
+
+}  // namespace
+
+/**
+ * @brief Returns the bucket a latency falls into.
+ */
+size_t LatencyHistogram::bucket_index(uint64_t micros) {
+  constexpr uint64_t sub_buckets = uint64_t{1} << SUB_BUCKET_BITS;
+  if (micros < sub_buckets) {
+    return static_cast<size_t>(micros);
+  }
+  uint32_t exponent = highest_bit(micros);
+  if (exponent > MAX_EXPONENT) {
+    return BUCKET_COUNT - 1;
+  }
+  uint32_t shift = exponent - SUB_BUCKET_BITS;
+  return (static_cast<size_t>(shift + 1) << SUB_BUCKET_BITS) +
+         static_cast<size_t>((micros >> shift) - sub_buckets);
+}
+
+/**
+ * @brief Returns the smallest latency accounted in a bucket.
+ */
+uint64_t LatencyHistogram::bucket_lower_bound(size_t index) {
+  constexpr uint64_t sub_buckets = uint64_t{1} << SUB_BUCKET_BITS;
+  if (index < sub_buckets) {
+    return index;
+  }
+  size_t group = index >> SUB_BUCKET_BITS;
+  uint64_t offset = index & (sub_buckets - 1);
+  return (sub_buckets + offset) << (group - 1);
+}
+
+/**
+ * @brief Returns the largest latency accounted in a bucket.
+ */
+uint64_t LatencyHistogram::bucket_upper_bound(size_t index) {
+  constexpr uint64_t sub_buckets = uint64_t{1} << SUB_BUCKET_BITS;
+  if (index < sub_buckets) {
+    return index;
+  }
+  size_t group = index >> SUB_BUCKET_BITS;
+  return bucket_lower_bound(index) + (uint64_t{1} << (group - 1)) - 1;
+}
+
+/**
+ * @brief Constructs an empty histogram.
+ */
+LatencyHistogram::LatencyHistogram() : buckets_(BUCKET_COUNT, 0), count_(0) {}
+
+/**
+ * @brief Returns the number of recorded samples.
+ */
+uint64_t LatencyHistogram::count() const { return count_; }
+
+/**
+ * @brief Returns the per-bucket sample counts.
+ */
+const std::vector<uint64_t>& LatencyHistogram::buckets() const {
+  return buckets_;
+}
+
+/**
+ * @brief Returns the latency below which the given percentage of samples
+ * fall.
+ */
+std::chrono::microseconds LatencyHistogram::percentile(
+    double percentile) const {
+  if (count_ == 0) {
+    return std::chrono::microseconds(0);
+  }
+  if (percentile < 0) percentile = 0;
+  if (percentile > 100) percentile = 100;
+  auto target = static_cast<uint64_t>(
+      std::ceil(percentile / 100.0 * static_cast<double>(count_)));
+  if (target == 0) target = 1;
+
+  uint64_t seen = 0;
+  for (size_t i = 0; i < buckets_.size(); ++i) {
+    seen += buckets_[i];
+    if (seen >= target) {
+      return std::chrono::microseconds(bucket_upper_bound(i));
+    }
+  }
+  return std::chrono::microseconds(bucket_upper_bound(buckets_.size() - 1));
+}
+
+/**
+ * @brief Constructs an empty recorder.
+ */
+StatsRecorder::StatsRecorder()
+    : entries_(new std::atomic<Entry*>[MAX_REQUEST_TYPE]) {
+  for (size_t i = 0; i < MAX_REQUEST_TYPE; ++i) {
+    entries_[i].store(nullptr, std::memory_order_relaxed);
+  }
+}
+
+/**
+ * @brief Releases all per-command storage.
+ */
+StatsRecorder::~StatsRecorder() {
+  for (size_t i = 0; i < MAX_REQUEST_TYPE; ++i) {
+    delete entries_[i].load(std::memory_order_acquire);
+  }
+}
+
+/**
+ * Returns the storage for a request type, allocating it on first use. Racing
+ * allocations are resolved with a compare-and-swap; the loser is discarded.
+ */
+StatsRecorder::Entry* StatsRecorder::entry(core::RequestType type) {
+  auto index = static_cast<size_t>(type);
+  if (index >= MAX_REQUEST_TYPE) {
+    return nullptr;
+  }
+  Entry* current = entries_[index].load(std::memory_order_acquire);
+  if (current) {
+    return current;
+  }
+  auto* created = new Entry();
+  if (entries_[index].compare_exchange_strong(current, created,
+                                              std::memory_order_acq_rel,
+                                              std::memory_order_acquire)) {
+    return created;
+  }
+  delete created;
+  return current;
+}
+
+/**
+ * Returns the calling thread's shard for a request type.
+ */
+StatsRecorder::Shard* StatsRecorder::shard(core::RequestType type) {
+  Entry* e = entry(type);
+  return e ? &e->shards[thread_shard()] : nullptr;
+}
+
+/**
+ * @brief Records the submission of a request.
+ */
+void StatsRecorder::record_start(core::RequestType type) {
+  Shard* s = shard(type);
+  if (s) s->requests.fetch_add(1, std::memory_order_relaxed);
+}
+
+/**
+ * Records the completion count and latency of a request.
+ */
+void StatsRecorder::record_completion(
+    Shard* shard, std::chrono::steady_clock::time_point start) {
+  auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now() - start);
+  auto micros = static_cast<uint64_t>(std::max<int64_t>(elapsed.count(), 0));
+  shard->completed.fetch_add(1, std::memory_order_relaxed);
+  shard->buckets[LatencyHistogram::bucket_index(micros)].fetch_add(
+      1, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Records the successful completion of a request.
+ */
+void StatsRecorder::record_success(
+    core::RequestType type, std::chrono::steady_clock::time_point start) {
+  Shard* s = shard(type);
+  if (s) record_completion(s, start);
+}
+
+/**
+ * @brief Records the failed completion of a request.
+ */
+void StatsRecorder::record_failure(
+    core::RequestType type, core::RequestErrorType error,
+    std::chrono::steady_clock::time_point start) {
+  Shard* s = shard(type);
+  if (!s) return;
+  auto error_index = static_cast<size_t>(error);
+  if (error_index >= STATS_ERROR_TYPES) error_index = 0;
+  s->errors[error_index].fetch_add(1, std::memory_order_relaxed);
+  record_completion(s, start);
+}
+
+/**
+ * @brief Aggregates all shards into a snapshot.
+ */
+StatsSnapshot StatsRecorder::snapshot() const {
+  StatsSnapshot result;
+  for (size_t i = 0; i < MAX_REQUEST_TYPE; ++i) {
+    const Entry* e = entries_[i].load(std::memory_order_acquire);
+    if (!e) continue;
+
+    CommandStats stats;
+    uint64_t completed = 0;
+    for (const auto& s : e->shards) {
+      stats.requests += s.requests.load(std::memory_order_relaxed);
+      completed += s.completed.load(std::memory_order_relaxed);
+      for (size_t err = 0; err < STATS_ERROR_TYPES; ++err) {
+        stats.errors[err] += s.errors[err].load(std::memory_order_relaxed);
+      }
+      for (size_t b = 0; b < LatencyHistogram::BUCKET_COUNT; ++b) {
+        uint64_t n = s.buckets[b].load(std::memory_order_relaxed);
+        stats.latency.buckets_[b] += n;
+        stats.latency.count_ += n;
+      }
+    }
+    // Shards are read without a global barrier, so a completion may be seen
+    // before its submission; clamp the gauge rather than report a negative.
+    stats.in_flight = stats.requests > completed
+                          ? static_cast<int64_t>(stats.requests - completed)
+                          : 0;
+    result.emplace(static_cast<core::RequestType>(i), std::move(stats));
+  }
+  return result;
+}
+
+}  // namespace glide
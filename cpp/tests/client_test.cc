@@ -3,6 +3,14 @@
 #include <glide/client.h>
 #include <gtest/gtest.h>
 
+#include <chrono>
+#include <cstdlib>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
 using namespace glide;
 
 TEST(ClientTest, ConnectTest) {
@@ -27,3 +35,284 @@ TEST(ClientTest, GetDelTest) {
   EXPECT_EQ(*c.getdel("GetDelTest").get(), "hello-world");
   EXPECT_EQ(*c.get("GetDelTest").get(), "");
 }
+
+TEST(ClientTest, StatsTest) {
+  Config g("localhost", 6379);
+  g.withStats();
+  Client c(g);
+  EXPECT_TRUE(c.connect());
+  EXPECT_TRUE(c.set("StatsTest", "hello-world").get().ok());
+  EXPECT_EQ(*c.get("StatsTest").get(), "hello-world");
+
+  auto stats = c.stats();
+  auto &get_stats = stats[core::RequestType::Get];
+  EXPECT_EQ(get_stats.requests, 1);
+  EXPECT_EQ(get_stats.in_flight, 0);
+  EXPECT_EQ(get_stats.latency.count(), 1);
+  EXPECT_GT(get_stats.latency.percentile(100).count(), 0);
+}
+
+TEST(ClientTest, StatsDisabledTest) {
+  Config g("localhost", 6379);
+  Client c(g);
+  EXPECT_TRUE(c.connect());
+  EXPECT_TRUE(c.set("StatsDisabledTest", "hello-world").get().ok());
+  EXPECT_TRUE(c.stats().empty());
+}
+
+TEST(ClientTest, CoalescingTest) {
+  Config g("localhost", 6379);
+  g.withRequestCoalescing().withStats();
+  Client c(g);
+  EXPECT_TRUE(c.connect());
+  EXPECT_TRUE(c.set("CoalescingTest", "hello-world").get().ok());
+
+  // The server holds the first GET back, so the other threads' GETs are
+  // issued while it is in flight and attach to it.
+  Config pauser_config("localhost", 6379);
+  Client pauser(pauser_config);
+  EXPECT_TRUE(pauser.connect());
+  EXPECT_TRUE(
+      pauser.customCommand({"CLIENT", "PAUSE", "300", "ALL"}).get().ok());
+
+  constexpr int kThreads = 16;
+  std::vector<std::thread> threads;
+  for (int i = 0; i < kThreads; ++i) {
+    threads.emplace_back([&c] {
+      EXPECT_EQ(*c.get("CoalescingTest").get(), "hello-world");
+    });
+  }
+  for (auto &t : threads) t.join();
+
+  // Coalesced GETs never reach the core, so they aren't counted.
+  auto stats = c.stats();
+  EXPECT_GE(stats[core::RequestType::Get].requests, 1);
+  EXPECT_LT(stats[core::RequestType::Get].requests, kThreads);
+}
+
+TEST(ClientTest, NearCacheTest) {
+  Config g("localhost", 6379);
+  g.withNearCache(1 << 20).withStats();
+  Client c(g);
+  EXPECT_TRUE(c.connect());
+  Config writer_config("localhost", 6379);
+  Client writer(writer_config);
+  EXPECT_TRUE(writer.connect());
+
+  EXPECT_TRUE(writer.set("NearCacheTest", "hello-world").get().ok());
+  EXPECT_EQ(*c.get("NearCacheTest").get(), "hello-world");
+  EXPECT_EQ(*c.get("NearCacheTest").get(), "hello-world");
+  EXPECT_EQ(c.stats()[core::RequestType::Get].requests, 1);
+
+  // The write by another client is delivered as an invalidation message.
+  EXPECT_TRUE(writer.set("NearCacheTest", "updated").get().ok());
+  auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+  std::string value;
+  do {
+    value = *c.get("NearCacheTest").get();
+  } while (value != "updated" && std::chrono::steady_clock::now() < deadline);
+  EXPECT_EQ(value, "updated");
+
+  // Writes through the caching client are visible right away.
+  EXPECT_TRUE(c.set("NearCacheTest", "local").get().ok());
+  EXPECT_EQ(*c.get("NearCacheTest").get(), "local");
+
+  // So are all the keys of a multi-key write, and a flush.
+  EXPECT_TRUE(c.set("NearCacheTest:other", "local").get().ok());
+  EXPECT_EQ(*c.get("NearCacheTest:other").get(), "local");
+  EXPECT_TRUE(c.customCommand({"MSET", "NearCacheTest", "first",
+                               "NearCacheTest:other", "second"})
+                  .get()
+                  .ok());
+  EXPECT_EQ(*c.get("NearCacheTest").get(), "first");
+  EXPECT_EQ(*c.get("NearCacheTest:other").get(), "second");
+  EXPECT_TRUE(c.customCommand({"FLUSHDB"}).get().ok());
+  EXPECT_EQ(*c.get("NearCacheTest").get(), "");
+  EXPECT_EQ(*c.get("NearCacheTest:other").get(), "");
+}
+
+TEST(ClientTest, ConnectionsPerNodeTest) {
+  Config g("localhost", 6379);
+  g.withConnectionsPerNode(4);
+  EXPECT_EQ(g.connectionsPerNode(), 4);
+  Client c(g);
+  EXPECT_TRUE(c.connect());
+  EXPECT_TRUE(c.set("ConnectionsPerNodeTest", "hello-world").get().ok());
+
+  // The BLPOP occupies one connection, so the GET goes out on another one.
+  // Over a single connection, it would only return once the BLPOP timed out.
+  auto pop = c.blpop({"ConnectionsPerNodeTest:list"}, 2);
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  auto start = std::chrono::steady_clock::now();
+  EXPECT_EQ(*c.get("ConnectionsPerNodeTest").get(), "hello-world");
+  EXPECT_LT(std::chrono::steady_clock::now() - start,
+            std::chrono::milliseconds(500));
+  EXPECT_TRUE(c.lpush("ConnectionsPerNodeTest:list", {"pushed"}).get().ok());
+  EXPECT_EQ(*pop.get(), (std::vector<std::string>{"ConnectionsPerNodeTest:list",
+                                                  "pushed"}));
+
+  constexpr int kThreads = 16;
+  std::vector<std::thread> threads;
+  for (int i = 0; i < kThreads; ++i) {
+    threads.emplace_back([&c, i] {
+      std::string key = "ConnectionsPerNodeTest" + std::to_string(i);
+      EXPECT_TRUE(c.set(key, "hello-world").get().ok());
+      EXPECT_EQ(*c.get(key).get(), "hello-world");
+    });
+  }
+  for (auto &t : threads) t.join();
+}
+
+TEST(ClientTest, BlockingConnectionsTest) {
+  Config g("localhost", 6379);
+  EXPECT_EQ(g.blockingConnectionsLimit(), 0);
+  g.withBlockingConnections(2);
+  EXPECT_EQ(g.blockingConnectionsLimit(), 2);
+  Client c(g);
+  EXPECT_TRUE(c.connect());
+  EXPECT_TRUE(c.set("BlockingConnectionsTest", "hello-world").get().ok());
+  EXPECT_EQ(*c.get("BlockingConnectionsTest").get(), "hello-world");
+
+  // The BLPOP holds a dedicated connection, so the GET and the LPUSH sent
+  // meanwhile aren't queued behind it. Over a shared connection, the GET
+  // would only return once the BLPOP timed out.
+  auto pop = c.blpop({"BlockingConnectionsTest:list"}, 2);
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  auto start = std::chrono::steady_clock::now();
+  EXPECT_EQ(*c.get("BlockingConnectionsTest").get(), "hello-world");
+  EXPECT_LT(std::chrono::steady_clock::now() - start,
+            std::chrono::milliseconds(500));
+  EXPECT_TRUE(c.lpush("BlockingConnectionsTest:list", {"pushed"}).get().ok());
+  EXPECT_EQ(*pop.get(), (std::vector<std::string>{
+                            "BlockingConnectionsTest:list", "pushed"}));
+}
+
+TEST(ClientTest, BlockingConnectionsSelectTest) {
+  Config g("localhost", 6379);
+  g.withBlockingConnections(1);
+  Client c(g);
+  EXPECT_TRUE(c.connect());
+
+  // Leaves an idle dedicated client connected to database 0.
+  EXPECT_TRUE(c.lpush("BlockingConnectionsSelectTest", {"db0"}).get().ok());
+  EXPECT_EQ(*c.blpop({"BlockingConnectionsSelectTest"}, 1).get(),
+            (std::vector<std::string>{"BlockingConnectionsSelectTest",
+                                      "db0"}));
+
+  // The BLPOP must pop from the selected database, like every other command.
+  EXPECT_TRUE(c.select(1).get().ok());
+  EXPECT_TRUE(c.lpush("BlockingConnectionsSelectTest", {"db1"}).get().ok());
+  EXPECT_EQ(*c.blpop({"BlockingConnectionsSelectTest"}, 1).get(),
+            (std::vector<std::string>{"BlockingConnectionsSelectTest",
+                                      "db1"}));
+}
+
+TEST(ClientTest, ValueCompressionTest) {
+  Config g("localhost", 6379);
+  EXPECT_EQ(g.valueCompression(), ValueCompression::None);
+  g.withValueCompression(ValueCompression::Zstd, 64);
+  EXPECT_EQ(g.valueCompression(), ValueCompression::Zstd);
+  EXPECT_EQ(g.valueCompressionMinSize(), 64);
+  Client c(g);
+  EXPECT_TRUE(c.connect());
+  std::string value;
+  for (int i = 0; i < 100; i++) {
+    value += "compressible-" + std::to_string(i) + ";";
+  }
+  EXPECT_TRUE(c.set("ValueCompressionTest", value).get().ok());
+  EXPECT_EQ(*c.get("ValueCompressionTest").get(), value);
+
+  // A client without compression reads the bytes as they are stored.
+  Config plain_config("localhost", 6379);
+  Client plain(plain_config);
+  EXPECT_TRUE(plain.connect());
+  std::string stored = *plain.get("ValueCompressionTest").get();
+  EXPECT_EQ(stored.substr(0, 4), std::string("\0GLZ", 4));
+  EXPECT_LT(stored.size(), value.size());
+  EXPECT_EQ(*c.getdel("ValueCompressionTest").get(), value);
+}
+
+TEST(ClientTest, TelemetryConfigTest) {
+  Config g("localhost", 6379);
+  EXPECT_FALSE(g.telemetry().enabled());
+
+  // Invalid settings are rejected before anything is initialized.
+  Config bad_endpoint("localhost", 6379);
+  bad_endpoint.withTracesExporter("not-an-endpoint");
+  EXPECT_TRUE(bad_endpoint.telemetry().enabled());
+  Client bad_endpoint_client(bad_endpoint);
+  EXPECT_FALSE(bad_endpoint_client.connect());
+
+  Config bad_interval("localhost", 6379);
+  bad_interval.withMetricsExporter("file:///tmp/TelemetryConfigTest.json")
+      .withTelemetryFlushInterval(std::chrono::milliseconds(-1));
+  Client bad_interval_client(bad_interval);
+  EXPECT_FALSE(bad_interval_client.connect());
+
+  g.withTracesExporter("file:///tmp/TelemetryConfigTest.json", 100)
+      .withTelemetryFlushInterval(std::chrono::milliseconds(100));
+  EXPECT_EQ(*g.telemetry().traces_endpoint,
+            "file:///tmp/TelemetryConfigTest.json");
+  EXPECT_EQ(g.telemetry().sample_percentage, 100u);
+  Client c(g);
+  EXPECT_TRUE(c.connect());
+  EXPECT_TRUE(c.set("TelemetryConfigTest", "hello-world").get().ok());
+  EXPECT_EQ(*c.get("TelemetryConfigTest").get(), "hello-world");
+}
+
+TEST(ClientTest, ScanParallelStandaloneTest) {
+  Config g("localhost", 6379);
+  EXPECT_FALSE(g.clusterModeEnabled());
+  Client c(g);
+  EXPECT_TRUE(c.connect());
+  size_t keys = 0;
+  absl::Status status =
+      c.scanParallel({}, [&keys](const std::vector<std::string> &batch) {
+         keys += batch.size();
+       }).get();
+  EXPECT_FALSE(status.ok());
+  EXPECT_EQ(keys, 0);
+}
+
+// Needs a cluster listening on localhost at the port in GLIDE_CLUSTER_PORT.
+TEST(ClientTest, ScanParallelClusterTest) {
+  const char *port = std::getenv("GLIDE_CLUSTER_PORT");
+  if (!port) {
+    GTEST_SKIP() << "GLIDE_CLUSTER_PORT is not set";
+  }
+  Config g("localhost", static_cast<uint32_t>(std::stoul(port)));
+  g.withClusterMode();
+  Client c(g);
+  ASSERT_TRUE(c.connect());
+
+  // Enough keys to spread over every shard.
+  std::set<std::string> expected;
+  for (int i = 0; i < 1000; ++i) {
+    std::string key = "ScanParallelClusterTest:" + std::to_string(i);
+    EXPECT_TRUE(c.set(key, "hello-world").get().ok());
+    expected.insert(key);
+  }
+
+  ParallelScanOptions options;
+  options.match_pattern = "ScanParallelClusterTest:*";
+  options.count = 10;
+  std::mutex mtx;
+  std::set<std::string> seen;
+  absl::Status status =
+      c.scanParallel(options, [&](const std::vector<std::string> &batch) {
+         std::lock_guard<std::mutex> lock(mtx);
+         seen.insert(batch.begin(), batch.end());
+       }).get();
+  EXPECT_TRUE(status.ok()) << status;
+  EXPECT_EQ(seen, expected);
+}
+
+TEST(LatencyHistogramTest, BucketBoundsTest) {
+  for (uint64_t micros = 0; micros < (1 << 16); ++micros) {
+    size_t index = LatencyHistogram::bucket_index(micros);
+    EXPECT_LE(LatencyHistogram::bucket_lower_bound(index), micros);
+    EXPECT_GE(LatencyHistogram::bucket_upper_bound(index), micros);
+  }
+  EXPECT_EQ(LatencyHistogram::bucket_index(UINT64_MAX),
+            LatencyHistogram::BUCKET_COUNT - 1);
+}
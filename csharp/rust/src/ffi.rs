@@ -151,7 +151,13 @@ pub(crate) unsafe fn create_connection_request(
         periodic_checks: None,
         pubsub_subscriptions: None,
         inflight_requests_limit: None,
+        inflight_requests_wait: false,
         lazy_connect: false,
+        client_tracking: None,
+        connections_per_node: None,
+        read_hedging_percentile: None,
+        blocking_connections_limit: None,
+        value_compression: None,
     }
 }
 
@@ -22,7 +22,7 @@ use redis::cluster_routing::{
     MultipleNodeRoutingInfo, Route, RoutingInfo, SingleNodeRoutingInfo, SlotAddr,
 };
 use redis::cluster_routing::{ResponsePolicy, Routable};
-use redis::{ClusterScanArgs, RedisError};
+use redis::{ClusterScanArgs, ParallelScanOptions, RedisError};
 use redis::{Cmd, Pipeline, PipelineRetryStrategy, RedisResult, Value};
 use std::ffi::CStr;
 use std::future::Future;
@@ -31,6 +31,7 @@ use std::slice::from_raw_parts;
 use std::str;
 use std::str::FromStr;
 use std::sync::Arc;
+use std::time::Instant;
 use std::{
     ffi::{CString, c_void},
     mem,
@@ -38,6 +39,8 @@ use std::{
 };
 use tokio::runtime::Builder;
 use tokio::runtime::Runtime;
+use tokio::sync::mpsc;
+use tokio::task::JoinHandle;
 
 #[repr(C)]
 pub struct ScriptHashBuffer {
@@ -269,6 +272,39 @@ pub type PubSubCallback = unsafe extern "C-unwind" fn(
     pattern_len: i64,
 ) -> ();
 
+/// A push notification delivered by a [`PubSubBatchCallback`].
+///
+/// Absent parts are null pointers with a length of 0: the pattern of a message not received through a
+/// pattern subscription, the channel of an invalidation, and the key of an invalidation of every key.
+#[repr(C)]
+#[derive(Debug)]
+pub struct PushNotification {
+    pub kind: PushKind,
+    pub message: *const u8,
+    pub message_len: i64,
+    pub channel: *const u8,
+    pub channel_len: i64,
+    pub pattern: *const u8,
+    pub pattern_len: i64,
+}
+
+/// PubSub callback that receives the push notifications of a client in batches, see [`create_client_with_push_batches`].
+///
+/// # Parameters
+/// * `client_ptr`: A baton-pass back to the caller language to uniquely identify the client.
+/// * `messages`: A pointer to `message_count` consecutive messages, in the order they were received.
+/// * `message_count`: The number of messages, at least 1.
+///
+/// # Safety
+/// The messages and the bytes they point to are stored in buffers that are reused for the next batch, so
+/// they are only valid during the callback execution. Any data needed beyond the callback's execution must
+/// be copied.
+pub type PubSubBatchCallback = unsafe extern "C-unwind" fn(
+    client_ptr: usize,
+    messages: *const PushNotification,
+    message_count: usize,
+) -> ();
+
 /// The connection response.
 ///
 /// It contains either a connection or an error. It is represented as a struct instead of a union for ease of use in the wrapper language.
@@ -631,73 +667,287 @@ impl From<redis::PushKind> for PushKind {
     }
 }
 
+/// Splits a Message, PMessage or SMessage push into its pattern, if any, its channel and its message.
+fn pubsub_message_parts(push_msg: &redis::PushInfo) -> Option<(Option<&[u8]>, &[u8], &[u8])> {
+    fn bytes(value: &Value) -> Option<&[u8]> {
+        match value {
+            Value::BulkString(bytes) => Some(bytes),
+            _ => None,
+        }
+    }
+    match push_msg.data.as_slice() {
+        [pattern, channel, message] => {
+            Some((Some(bytes(pattern)?), bytes(channel)?, bytes(message)?))
+        }
+        [channel, message] => Some((None, bytes(channel)?, bytes(message)?)),
+        _ => None,
+    }
+}
+
 /// Processes a push notification message and calls the provided callback function.
 ///
-/// This function converts a PushInfo message to a CommandResponse, determines the
-/// notification type, and invokes the callback with the appropriate parameters.
+/// The callback receives pointers into `push_msg`, which is dropped once it returns.
 ///
 /// # Parameters
 /// - `push_msg`: The push notification message to process.
 /// - `pubsub_callback`: The callback function to invoke with the processed notification.
 /// - `client_adapter_ptr`: A pointer to the client adapter to pass to the callback.
 ///
-/// # Returns
-/// - `true` if the message was successfully processed and the callback was called.
-/// - `false` if there was an error processing the message (e.g., conversion failed).
-///
 /// # Safety
-/// This function is unsafe because it:
-/// - Dereferences raw pointers
-/// - Calls an FFI function (`pubsub_callback`) that may have undefined behavior
-/// - Creates and destroys vectors via `Vec::from_raw_parts`
-/// - Assumes push_msg.data contains valid BulkString values
+/// This function is unsafe because it calls an FFI function (`pubsub_callback`) that may have undefined behavior.
 ///
 /// The caller must ensure:
 /// - `pubsub_callback` is a valid function pointer to a properly implemented callback
 /// - `client_adapter_ptr` is a valid usize representing a client adapter pointer
-/// - Memory allocated during conversion is properly freed after the callback completes
 unsafe fn process_push_notification(
     push_msg: redis::PushInfo,
     pubsub_callback: PubSubCallback,
     client_adapter_ptr: usize,
 ) {
-    let strings: Vec<(*mut u8, i64)> = push_msg
-        .data
-        .iter()
-        .map(|v| {
-            let Value::BulkString(str) = v else {
-                unreachable!()
-            };
-            let (ptr, len) = convert_vec_to_pointer(str.clone());
-            (ptr, len)
-        })
-        .collect();
-
-    let ((pattern_ptr, pattern_len), (channel, channel_len), (message_ptr, message_len)) = {
-        if strings.len() == 3 {
-            (strings[0], strings[1], strings[2])
-        } else {
-            ((std::ptr::null_mut::<u8>(), 0), strings[0], strings[1])
-        }
+    let Some((pattern, channel, message)) = pubsub_message_parts(&push_msg) else {
+        return;
     };
+    let (pattern_ptr, pattern_len) = pattern.map_or((std::ptr::null(), 0), |pattern| {
+        (pattern.as_ptr(), pattern.len() as i64)
+    });
 
     // Call the pubsub callback with the push notification data
     unsafe {
         pubsub_callback(
             client_adapter_ptr,
-            push_msg.kind.into(),
-            message_ptr,
-            message_len,
-            channel,
-            channel_len,
+            push_msg.kind.clone().into(),
+            message.as_ptr(),
+            message.len() as i64,
+            channel.as_ptr(),
+            channel.len() as i64,
             pattern_ptr,
             pattern_len,
         );
-        // Free memory
-        let _ = Vec::from_raw_parts(message_ptr, message_len as usize, message_len as usize);
-        let _ = Vec::from_raw_parts(channel, channel_len as usize, channel_len as usize);
-        if !pattern_ptr.is_null() {
-            let _ = Vec::from_raw_parts(pattern_ptr, pattern_len as usize, pattern_len as usize);
+    }
+}
+
+/// Forwards a client tracking invalidation to the provided callback.
+///
+/// The callback is invoked once per invalidated key with `kind` set to `PushInvalidate` and the key
+/// passed as the message. A null message means that every key must be invalidated, which happens when
+/// the server is flushed or the connection was lost, since invalidations may have been missed.
+///
+/// # Safety
+///
+/// The caller must ensure:
+/// - `pubsub_callback` is a valid function pointer to a properly implemented callback
+/// - `client_adapter_ptr` is a valid usize representing a client adapter pointer
+unsafe fn process_invalidation_notification(
+    push_msg: redis::PushInfo,
+    pubsub_callback: PubSubCallback,
+    client_adapter_ptr: usize,
+) {
+    let invalidate = |key: *const u8, key_len: i64| unsafe {
+        pubsub_callback(
+            client_adapter_ptr,
+            PushKind::PushInvalidate,
+            key,
+            key_len,
+            std::ptr::null(),
+            0,
+            std::ptr::null(),
+            0,
+        );
+    };
+    match (push_msg.kind, push_msg.data.first()) {
+        (redis::PushKind::Invalidate, Some(Value::Array(keys))) => {
+            for key in keys {
+                if let Value::BulkString(key) = key {
+                    invalidate(key.as_ptr(), key.len() as i64);
+                }
+            }
+        }
+        _ => invalidate(std::ptr::null(), 0),
+    }
+}
+
+/// Push notifications received together, delivered by a single [`PubSubBatchCallback`] call.
+///
+/// The bytes of every message are copied into one buffer, and both the buffer and the message array
+/// keep their capacity from one batch to the next, so a steady flow of messages allocates nothing.
+struct PushBatch {
+    callback: PubSubBatchCallback,
+    max_batch_size: usize,
+    client_adapter_ptr: usize,
+    data: Vec<u8>,
+    parts: Vec<(PushKind, [Option<(usize, usize)>; 3])>,
+    messages: Vec<PushNotification>,
+}
+
+// The pointers in `messages` only refer to `data`, and only while `deliver` runs
+unsafe impl Send for PushBatch {}
+
+impl PushBatch {
+    fn new(
+        callback: PubSubBatchCallback,
+        max_batch_size: usize,
+        client_adapter_ptr: usize,
+    ) -> Self {
+        PushBatch {
+            callback,
+            max_batch_size: max_batch_size.max(1),
+            client_adapter_ptr,
+            data: Vec::new(),
+            parts: Vec::new(),
+            messages: Vec::new(),
+        }
+    }
+
+    /// Copies a message, its channel and its pattern at the end of the batch, delivering it once full.
+    ///
+    /// # Safety
+    ///
+    /// See [`PushBatch::deliver`].
+    unsafe fn add(
+        &mut self,
+        kind: PushKind,
+        message: Option<&[u8]>,
+        channel: Option<&[u8]>,
+        pattern: Option<&[u8]>,
+    ) {
+        let data = &mut self.data;
+        let parts = [message, channel, pattern].map(|bytes| {
+            bytes.map(|bytes| {
+                data.extend_from_slice(bytes);
+                (data.len() - bytes.len(), bytes.len())
+            })
+        });
+        self.parts.push((kind, parts));
+        if self.parts.len() >= self.max_batch_size {
+            unsafe { self.deliver() };
+        }
+    }
+
+    /// Adds the messages of a push that the wrapper is interested in.
+    ///
+    /// # Safety
+    ///
+    /// See [`PushBatch::deliver`].
+    unsafe fn add_push(&mut self, push_msg: &redis::PushInfo, is_tracking: bool) {
+        match push_msg.kind {
+            redis::PushKind::Message | redis::PushKind::PMessage | redis::PushKind::SMessage => {
+                if let Some((pattern, channel, message)) = pubsub_message_parts(push_msg) {
+                    let kind = push_msg.kind.clone().into();
+                    unsafe { self.add(kind, Some(message), Some(channel), pattern) };
+                }
+            }
+            redis::PushKind::Invalidate | redis::PushKind::Disconnection if is_tracking => {
+                match (&push_msg.kind, push_msg.data.first()) {
+                    (redis::PushKind::Invalidate, Some(Value::Array(keys))) => {
+                        for key in keys {
+                            if let Value::BulkString(key) = key {
+                                unsafe {
+                                    self.add(
+                                        PushKind::PushInvalidate,
+                                        Some(key.as_slice()),
+                                        None,
+                                        None,
+                                    )
+                                };
+                            }
+                        }
+                    }
+                    // Flushed server or lost connection: every key must be invalidated
+                    _ => unsafe { self.add(PushKind::PushInvalidate, None, None, None) },
+                }
+            }
+            _ => {}
+        }
+    }
+
+    /// Calls the callback with the messages of the batch, if any, then empties it.
+    ///
+    /// # Safety
+    ///
+    /// The caller must ensure that the callback is a valid function pointer to a properly implemented
+    /// callback.
+    unsafe fn deliver(&mut self) {
+        if self.parts.is_empty() {
+            return;
+        }
+        // The pointers are taken once the buffer is complete, since growing it moves the bytes
+        let data = self.data.as_ptr();
+        let pointer = |part: Option<(usize, usize)>| match part {
+            Some((start, len)) => (unsafe { data.add(start) }, len as i64),
+            None => (std::ptr::null(), 0),
+        };
+        self.messages.extend(
+            self.parts
+                .drain(..)
+                .map(|(kind, [message, channel, pattern])| {
+                    let (message, message_len) = pointer(message);
+                    let (channel, channel_len) = pointer(channel);
+                    let (pattern, pattern_len) = pointer(pattern);
+                    PushNotification {
+                        kind,
+                        message,
+                        message_len,
+                        channel,
+                        channel_len,
+                        pattern,
+                        pattern_len,
+                    }
+                }),
+        );
+        unsafe {
+            (self.callback)(
+                self.client_adapter_ptr,
+                self.messages.as_ptr(),
+                self.messages.len(),
+            )
+        };
+        self.messages.clear();
+        self.data.clear();
+    }
+}
+
+/// Forwards the push notifications of a client in batches of up to `max_batch_size` messages.
+///
+/// A batch holds the messages already queued when the first one is taken, so no message is held back
+/// waiting for more: under a light load every batch has a single message, and batches grow with the load.
+///
+/// # Safety
+///
+/// The caller must ensure that `callback` is a valid function pointer to a properly implemented callback.
+async unsafe fn deliver_push_batches(
+    mut push_rx: tokio::sync::mpsc::UnboundedReceiver<redis::PushInfo>,
+    callback: PubSubBatchCallback,
+    max_batch_size: usize,
+    is_tracking: bool,
+    client_adapter_ptr: usize,
+) {
+    let mut batch = PushBatch::new(callback, max_batch_size, client_adapter_ptr);
+    while let Some(push_msg) = push_rx.recv().await {
+        unsafe { batch.add_push(&push_msg, is_tracking) };
+        while let Ok(push_msg) = push_rx.try_recv() {
+            unsafe { batch.add_push(&push_msg, is_tracking) };
+        }
+        unsafe { batch.deliver() };
+    }
+}
+
+/// How a client hands its push notifications to the wrapper.
+#[derive(Clone, Copy)]
+enum PushHandler {
+    /// One callback call per message.
+    PerMessage(PubSubCallback),
+    /// One callback call per batch of up to `max_batch_size` messages.
+    Batched {
+        callback: PubSubBatchCallback,
+        max_batch_size: usize,
+    },
+}
+
+impl PushHandler {
+    fn is_set(&self) -> bool {
+        match self {
+            PushHandler::PerMessage(callback) => *callback as usize != 0,
+            PushHandler::Batched { callback, .. } => *callback as usize != 0,
         }
     }
 }
@@ -705,7 +955,8 @@ unsafe fn process_push_notification(
 fn create_client_internal(
     connection_request_bytes: &[u8],
     client_type: ClientType,
-    pubsub_callback: PubSubCallback,
+    push_handler: PushHandler,
+    push_context: Option<usize>,
 ) -> Result<*const ClientAdapter, String> {
     let request = connection_request::ConnectionRequest::parse_from_bytes(connection_request_bytes)
         .map_err(|err| err.to_string())?;
@@ -720,7 +971,9 @@ fn create_client_internal(
             errors::error_message(&redis_error)
         })?;
 
-    let is_subscriber = request.pubsub_subscriptions.is_some() && pubsub_callback as usize != 0;
+    let is_tracking = request.client_tracking || request.client_tracking_broadcast.is_some();
+    let is_subscriber =
+        (request.pubsub_subscriptions.is_some() || is_tracking) && push_handler.is_set();
     let (push_tx, mut push_rx) = tokio::sync::mpsc::unbounded_channel();
     let tx = match is_subscriber {
         true => Some(push_tx),
@@ -737,23 +990,55 @@ fn create_client_internal(
         client_type,
     });
     let client_adapter = Arc::new(ClientAdapter { runtime, core });
-    // Clone client_adapter before moving it into the async block
-    let client_adapter_ptr = Arc::as_ptr(&client_adapter).addr();
-
-    // If pubsub_callback is provided (not null), spawn a task to handle push notifications
-    if is_subscriber {
-        client_adapter.runtime.spawn(async move {
-            while let Some(push_msg) = push_rx.recv().await {
-                if push_msg.kind == redis::PushKind::Message
-                    || push_msg.kind == redis::PushKind::PMessage
-                    || push_msg.kind == redis::PushKind::SMessage
-                {
-                    unsafe {
-                        process_push_notification(push_msg, pubsub_callback, client_adapter_ptr);
+    // Identifies the client in the push callbacks, unless the caller gave its own context
+    let client_adapter_ptr = push_context.unwrap_or_else(|| Arc::as_ptr(&client_adapter).addr());
+
+    // If a push callback is provided (not null), spawn a task to handle push notifications
+    match push_handler {
+        _ if !is_subscriber => {}
+        PushHandler::Batched {
+            callback,
+            max_batch_size,
+        } => {
+            client_adapter.runtime.spawn(unsafe {
+                deliver_push_batches(
+                    push_rx,
+                    callback,
+                    max_batch_size,
+                    is_tracking,
+                    client_adapter_ptr,
+                )
+            });
+        }
+        PushHandler::PerMessage(pubsub_callback) => {
+            client_adapter.runtime.spawn(async move {
+                while let Some(push_msg) = push_rx.recv().await {
+                    if push_msg.kind == redis::PushKind::Message
+                        || push_msg.kind == redis::PushKind::PMessage
+                        || push_msg.kind == redis::PushKind::SMessage
+                    {
+                        unsafe {
+                            process_push_notification(
+                                push_msg,
+                                pubsub_callback,
+                                client_adapter_ptr,
+                            );
+                        }
+                    } else if is_tracking
+                        && (push_msg.kind == redis::PushKind::Invalidate
+                            || push_msg.kind == redis::PushKind::Disconnection)
+                    {
+                        unsafe {
+                            process_invalidation_notification(
+                                push_msg,
+                                pubsub_callback,
+                                client_adapter_ptr,
+                            );
+                        }
                     }
                 }
-            }
-        });
+            });
+        }
     }
 
     Ok(Arc::into_raw(client_adapter))
@@ -787,8 +1072,81 @@ pub unsafe extern "C-unwind" fn create_client(
     let request_bytes =
         unsafe { std::slice::from_raw_parts(connection_request_bytes, connection_request_len) };
     let client_type = unsafe { &*client_type };
-    let response = match create_client_internal(request_bytes, client_type.clone(), pubsub_callback)
-    {
+    connection_response(create_client_internal(
+        request_bytes,
+        client_type.clone(),
+        PushHandler::PerMessage(pubsub_callback),
+        None,
+    ))
+}
+
+/// Creates a new `ClientAdapter` like [`create_client`], passing `push_context` to `pubsub_callback` as its
+/// `client_ptr` instead of the client pointer.
+///
+/// The context is known before the client connects, so the wrapper can route the pushes received during
+/// the connection, and those of a client being replaced, without looking the client pointer up.
+///
+/// # Safety
+///
+/// * The requirements of [`create_client`] apply.
+#[unsafe(no_mangle)]
+pub unsafe extern "C-unwind" fn create_client_with_push_context(
+    connection_request_bytes: *const u8,
+    connection_request_len: usize,
+    client_type: *const ClientType,
+    pubsub_callback: PubSubCallback,
+    push_context: usize,
+) -> *const ConnectionResponse {
+    assert!(!connection_request_bytes.is_null());
+    let request_bytes =
+        unsafe { std::slice::from_raw_parts(connection_request_bytes, connection_request_len) };
+    let client_type = unsafe { &*client_type };
+    connection_response(create_client_internal(
+        request_bytes,
+        client_type.clone(),
+        PushHandler::PerMessage(pubsub_callback),
+        Some(push_context),
+    ))
+}
+
+/// Creates a new `ClientAdapter` like [`create_client`], delivering push notifications in batches.
+///
+/// Push notifications are received by a single task, which hands `batch_callback` every message queued at
+/// that time, up to `max_batch_size` messages per call. Their bytes are copied into a buffer reused from one
+/// batch to the next, instead of one callback call per message. Messages of exact, pattern and sharded
+/// subscriptions are delivered alike; in cluster mode, sharded messages come from the nodes owning the slots
+/// of their channels.
+///
+/// # Safety
+///
+/// * The requirements of [`create_client`] apply, with `batch_callback` in place of `pubsub_callback`.
+/// * `batch_callback` must live while the client is open/active.
+#[unsafe(no_mangle)]
+pub unsafe extern "C-unwind" fn create_client_with_push_batches(
+    connection_request_bytes: *const u8,
+    connection_request_len: usize,
+    client_type: *const ClientType,
+    batch_callback: PubSubBatchCallback,
+    max_batch_size: usize,
+) -> *const ConnectionResponse {
+    assert!(!connection_request_bytes.is_null());
+    let request_bytes =
+        unsafe { std::slice::from_raw_parts(connection_request_bytes, connection_request_len) };
+    let client_type = unsafe { &*client_type };
+    connection_response(create_client_internal(
+        request_bytes,
+        client_type.clone(),
+        PushHandler::Batched {
+            callback: batch_callback,
+            max_batch_size,
+        },
+        None,
+    ))
+}
+
+/// Wraps the result of [`create_client_internal`] in a `ConnectionResponse` for the wrapper.
+fn connection_response(result: Result<*const ClientAdapter, String>) -> *const ConnectionResponse {
+    let response = match result {
         Err(err) => ConnectionResponse {
             conn_ptr: std::ptr::null(),
             connection_error_message: CString::into_raw(
@@ -889,6 +1247,26 @@ pub unsafe extern "C" fn free_command_response(command_response_ptr: *mut Comman
     }
 }
 
+/// Deallocates the strings, arrays and maps held by an element of a `CommandResponse`, leaving it
+/// as an empty `Null` response. Lets callers release a large response as they consume it; the
+/// enclosing response is freed as usual afterwards.
+///
+/// # Safety
+///
+/// * `command_response_ptr` must point to an element of the `array_value` or `sets_value` of a
+///   `CommandResponse` that has not been freed yet.
+/// * The elements of the response must not be used after this call.
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn release_command_response_elements(
+    command_response_ptr: *mut CommandResponse,
+) {
+    if !command_response_ptr.is_null() {
+        let command_response =
+            unsafe { std::ptr::replace(command_response_ptr, CommandResponse::default()) };
+        unsafe { free_command_response_elements(command_response) };
+    }
+}
+
 /// Frees the nested elements of `CommandResponse`.
 /// TODO: Add a test case to check for memory leak.
 ///
@@ -1118,27 +1496,12 @@ pub unsafe extern "C-unwind" fn command(
         Arc::from_raw(client_adapter_ptr as *mut ClientAdapter)
     };
 
-    let arg_vec: Vec<&[u8]> = if !args.is_null() && !args_len.is_null() {
-        unsafe { convert_double_pointer_to_vec(args as *const *const c_void, arg_count, args_len) }
-    } else {
-        Vec::new()
-    };
-
     // Create the command outside of the task to ensure that the command arguments passed
     // from the foreign code are still valid
-    let mut cmd = match command_type.get_command() {
-        Some(cmd) => cmd,
-        None => {
-            let err = RedisError::from((ErrorKind::ClientError, "Couldn't fetch command type"));
-            return unsafe { client_adapter.handle_redis_error(err, request_id) };
-        }
+    let cmd = match unsafe { build_cmd(command_type, arg_count, args, args_len, span_ptr) } {
+        Ok(cmd) => cmd,
+        Err(err) => return unsafe { client_adapter.handle_redis_error(err, request_id) },
     };
-    for command_arg in arg_vec {
-        cmd.arg(command_arg);
-    }
-    if span_ptr != 0 {
-        cmd.set_span(unsafe { get_unsafe_span_from_ptr(Some(span_ptr)) });
-    }
 
     let route = if !route_bytes.is_null() {
         let r_bytes = unsafe { std::slice::from_raw_parts(route_bytes, route_bytes_len) };
@@ -1156,11 +1519,99 @@ pub unsafe extern "C-unwind" fn command(
     } else {
         Routes::default()
     };
+    let routing_info = match get_route(route, Some(&cmd)) {
+        Ok(routing_info) => routing_info,
+        Err(err) => return unsafe { client_adapter.handle_redis_error(err, request_id) },
+    };
+
+    send_command(&client_adapter, request_id, cmd, routing_info)
+}
 
+/// Executes a command routed by a [`RouteInfo`], which unlike the Protobuf `Routes` of
+/// [`command`] is read in place, without decoding.
+///
+/// # Safety
+///
+/// * The safety requirements of [`command`] apply to all parameters but the route.
+/// * `route_info` could be `null`, to route the command by its key, but if it is not `null`, it
+///   must be a valid pointer to a [`RouteInfo`], valid until this function returns. See the
+///   safety documentation of [`create_route`].
+#[unsafe(no_mangle)]
+pub unsafe extern "C-unwind" fn command_with_route_info(
+    client_adapter_ptr: *const c_void,
+    request_id: usize,
+    command_type: RequestType,
+    arg_count: c_ulong,
+    args: *const usize,
+    args_len: *const c_ulong,
+    route_info: *const RouteInfo,
+    span_ptr: u64,
+) -> *mut CommandResult {
+    let client_adapter = unsafe {
+        // we increment the strong count to ensure that the client is not dropped just because we turned it into an Arc.
+        Arc::increment_strong_count(client_adapter_ptr);
+        Arc::from_raw(client_adapter_ptr as *mut ClientAdapter)
+    };
+
+    let cmd = match unsafe { build_cmd(command_type, arg_count, args, args_len, span_ptr) } {
+        Ok(cmd) => cmd,
+        Err(err) => return unsafe { client_adapter.handle_redis_error(err, request_id) },
+    };
+    let routing_info = match unsafe { create_route(route_info, Some(&cmd)) } {
+        Ok(routing_info) => routing_info,
+        Err(err) => {
+            return unsafe {
+                client_adapter.handle_custom_error(err, RequestErrorType::Unspecified, request_id)
+            };
+        }
+    };
+
+    send_command(&client_adapter, request_id, cmd, routing_info)
+}
+
+/// Builds the command of [`command`] and [`command_with_route_info`] from the foreign arguments.
+///
+/// # Safety
+///
+/// See the safety documentation of [`command`].
+unsafe fn build_cmd(
+    command_type: RequestType,
+    arg_count: c_ulong,
+    args: *const usize,
+    args_len: *const c_ulong,
+    span_ptr: u64,
+) -> RedisResult<Cmd> {
+    let arg_vec: Vec<&[u8]> = if !args.is_null() && !args_len.is_null() {
+        unsafe { convert_double_pointer_to_vec(args as *const *const c_void, arg_count, args_len) }
+    } else {
+        Vec::new()
+    };
+
+    let Some(mut cmd) = command_type.get_command() else {
+        return Err(RedisError::from((
+            ErrorKind::ClientError,
+            "Couldn't fetch command type",
+        )));
+    };
+    for command_arg in arg_vec {
+        cmd.arg(command_arg);
+    }
+    if span_ptr != 0 {
+        cmd.set_span(unsafe { get_unsafe_span_from_ptr(Some(span_ptr)) });
+    }
+    Ok(cmd)
+}
+
+/// Sends a command built by [`build_cmd`] with its routing, see [`ClientAdapter::execute_request`].
+fn send_command(
+    client_adapter: &ClientAdapter,
+    request_id: usize,
+    cmd: Cmd,
+    routing_info: Option<RoutingInfo>,
+) -> *mut CommandResult {
     let child_span = create_child_span(cmd.span().as_ref(), "send_command");
     let mut client = client_adapter.core.client.clone();
     let result = client_adapter.execute_request(request_id, async move {
-        let routing_info = get_route(route, Some(&cmd))?;
         client.send_command(&cmd, routing_info).await
     });
     if let Ok(span) = child_span {
@@ -1510,6 +1961,291 @@ pub unsafe extern "C" fn remove_cluster_scan_cursor(cursor_id: *const c_char) {
     }
 }
 
+/// A parallel cluster scan started by [`start_parallel_cluster_scan`], whose keys are pulled in
+/// batches with [`next_parallel_cluster_scan_batch`].
+pub struct ParallelClusterScan {
+    client_adapter: Arc<ClientAdapter>,
+    keys_receiver: mpsc::Receiver<Vec<Value>>,
+    scan: Option<JoinHandle<RedisResult<()>>>,
+}
+
+impl Drop for ParallelClusterScan {
+    fn drop(&mut self) {
+        // Dropping the receiver stops the scan as well, aborting doesn't wait for the SCAN in flight.
+        if let Some(scan) = self.scan.take() {
+            scan.abort();
+        }
+    }
+}
+
+/// Parses the arguments of a parallel cluster scan: `MATCH pattern`, `COUNT count`, `TYPE type`,
+/// `CONCURRENCY nodes` and `RATE scans-per-second`.
+fn parse_parallel_scan_args(args: &[&[u8]]) -> RedisResult<(ClusterScanArgs, ParallelScanOptions)> {
+    let mut builder = ClusterScanArgs::builder();
+    let mut options = ParallelScanOptions::default();
+    let parse_u32 = |name: &str, value: &[u8]| -> RedisResult<u32> {
+        str::from_utf8(value)?.parse::<u32>().map_err(|_| {
+            RedisError::from((
+                ErrorKind::ClientError,
+                "Invalid scan argument",
+                format!("{name} must be a non-negative integer"),
+            ))
+        })
+    };
+
+    let mut iter = args.iter();
+    while let Some(arg) = iter.next() {
+        let name = str::from_utf8(arg).unwrap_or_default();
+        let Some(value) = iter.next() else {
+            return Err(RedisError::from((
+                ErrorKind::ClientError,
+                "Missing scan argument value",
+                format!("No argument following {name}."),
+            )));
+        };
+        match *arg {
+            b"MATCH" => builder = builder.with_match_pattern(*value),
+            b"COUNT" => builder = builder.with_count(parse_u32(name, value)?),
+            b"TYPE" => {
+                builder = builder.with_object_type(ObjectType::from(
+                    String::from_utf8_lossy(value).into_owned(),
+                ))
+            }
+            b"CONCURRENCY" => match parse_u32(name, value)? {
+                0 => {}
+                concurrency => options.concurrency = concurrency as usize,
+            },
+            b"RATE" => match parse_u32(name, value)? {
+                0 => {}
+                rate => options.max_scans_per_second = Some(rate),
+            },
+            _ => {
+                return Err(RedisError::from((
+                    ErrorKind::ClientError,
+                    "Unknown scan argument",
+                    name.to_string(),
+                )));
+            }
+        }
+    }
+    Ok((builder.build(), options))
+}
+
+/// Starts scanning the keys of a cluster, several nodes at a time. The keys are pulled with
+/// [`next_parallel_cluster_scan_batch`] as they are found, and the scan keeps at most a few
+/// batches per node ahead of the caller.
+///
+/// `client_adapter_ptr` is a pointer to a valid `GlideClusterClient` returned in the `ConnectionResponse` from [`create_client`].
+/// `args` holds `arg_count` options: `MATCH pattern`, `COUNT count`, `TYPE type`, `CONCURRENCY nodes`
+/// and `RATE scans-per-second`. Invalid options are reported by the first call to
+/// [`next_parallel_cluster_scan_batch`].
+///
+/// # Safety
+///
+/// * `client_adapter_ptr` must be obtained from the `ConnectionResponse` returned from [`create_client`].
+/// * `args` and `args_len` must point to `arg_count` valid strings and lengths, valid until this function returns.
+/// * The returned pointer must be freed with [`free_parallel_cluster_scan`].
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn start_parallel_cluster_scan(
+    client_adapter_ptr: *const c_void,
+    arg_count: c_ulong,
+    args: *const usize,
+    args_len: *const c_ulong,
+) -> *mut ParallelClusterScan {
+    let client_adapter = unsafe {
+        // we increment the strong count to ensure that the client is not dropped just because we turned it into an Arc.
+        Arc::increment_strong_count(client_adapter_ptr);
+        Arc::from_raw(client_adapter_ptr as *mut ClientAdapter)
+    };
+    let arg_vec = if arg_count > 0 {
+        unsafe { convert_double_pointer_to_vec(args as *const *const c_void, arg_count, args_len) }
+    } else {
+        Vec::new()
+    };
+
+    let parsed_args = parse_parallel_scan_args(&arg_vec);
+    let concurrency = parsed_args
+        .as_ref()
+        .map_or(1, |(_, options)| options.concurrency);
+    let (keys_sender, keys_receiver) = mpsc::channel(concurrency * 2);
+    let client = client_adapter.core.client.clone();
+    let scan = client_adapter.runtime.spawn(async move {
+        let (cluster_scan_args, options) = parsed_args?;
+        client
+            .parallel_cluster_scan(cluster_scan_args, options, keys_sender)
+            .await
+    });
+    Box::into_raw(Box::new(ParallelClusterScan {
+        client_adapter,
+        keys_receiver,
+        scan: Some(scan),
+    }))
+}
+
+/// Waits for the next batch of keys of a parallel cluster scan.
+///
+/// Returns a `CommandResult` holding an array of keys, or holding the error that ended the scan,
+/// or null once every key was returned. Must not be called again after it returned null or an
+/// error.
+///
+/// # Safety
+///
+/// * `scan_ptr` must be obtained from [`start_parallel_cluster_scan`] and not yet freed.
+/// * The returned `CommandResult` must be freed with [`free_command_result`].
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn next_parallel_cluster_scan_batch(
+    scan_ptr: *mut ParallelClusterScan,
+) -> *mut CommandResult {
+    let parallel_scan = unsafe { &mut *scan_ptr };
+    let runtime = &parallel_scan.client_adapter.runtime;
+    if let Some(keys) = runtime.block_on(parallel_scan.keys_receiver.recv()) {
+        return ClientAdapter::handle_result(Ok(Value::Array(keys)), None, None, 0);
+    }
+    // The scan has ended: report how.
+    let Some(scan) = parallel_scan.scan.take() else {
+        return std::ptr::null_mut();
+    };
+    match runtime.block_on(scan) {
+        Ok(Ok(())) => std::ptr::null_mut(),
+        Ok(Err(err)) => create_error_result_with_redis_error(err),
+        Err(join_error) => create_error_result_with_custom_error(
+            format!("Parallel cluster scan failed: {join_error}"),
+            RequestErrorType::Unspecified,
+        ),
+    }
+}
+
+/// Stops a parallel cluster scan, if still running, and frees it.
+///
+/// # Safety
+///
+/// * `scan_ptr` must be obtained from [`start_parallel_cluster_scan`], or be null.
+/// * `free_parallel_cluster_scan` can only be called once per scan.
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn free_parallel_cluster_scan(scan_ptr: *mut ParallelClusterScan) {
+    if !scan_ptr.is_null() {
+        drop(unsafe { Box::from_raw(scan_ptr) });
+    }
+}
+
+/// A command sent by [`start_command`], whose reply is collected with [`wait_pending_command`].
+pub struct PendingCommand {
+    client_adapter: Arc<ClientAdapter>,
+    /// The reply, and how long the server took to send it in microseconds.
+    reply: Option<JoinHandle<(RedisResult<Value>, u64)>>,
+}
+
+impl Drop for PendingCommand {
+    fn drop(&mut self) {
+        // A reply nobody waits for is dropped when it arrives.
+        if let Some(reply) = self.reply.take() {
+            reply.abort();
+        }
+    }
+}
+
+/// Sends a command without waiting for its reply, so that the caller can keep working while it's
+/// in flight. The command is routed by its key, like [`command`] without a route.
+///
+/// # Safety
+///
+/// * `client_adapter_ptr` must be obtained from the `ConnectionResponse` returned from [`create_client`].
+/// * `args` and `args_len` must point to `arg_count` valid strings and lengths, valid until this function returns.
+/// * The returned pointer must be freed with [`free_pending_command`].
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn start_command(
+    client_adapter_ptr: *const c_void,
+    command_type: RequestType,
+    arg_count: c_ulong,
+    args: *const usize,
+    args_len: *const c_ulong,
+) -> *mut PendingCommand {
+    let client_adapter = unsafe {
+        // we increment the strong count to ensure that the client is not dropped just because we turned it into an Arc.
+        Arc::increment_strong_count(client_adapter_ptr);
+        Arc::from_raw(client_adapter_ptr as *mut ClientAdapter)
+    };
+    let arg_vec = if arg_count > 0 {
+        unsafe { convert_double_pointer_to_vec(args as *const *const c_void, arg_count, args_len) }
+    } else {
+        Vec::new()
+    };
+
+    // The arguments are only valid until this function returns.
+    let cmd = command_type.get_command().map(|mut cmd| {
+        for arg in arg_vec {
+            cmd.arg(arg);
+        }
+        cmd
+    });
+    let mut client = client_adapter.core.client.clone();
+    let reply = client_adapter.runtime.spawn(async move {
+        let start = Instant::now();
+        let result = match cmd {
+            Some(cmd) => client.send_command(&cmd, None).await,
+            None => Err(RedisError::from((
+                ErrorKind::ClientError,
+                "Couldn't fetch command type",
+            ))),
+        };
+        (result, start.elapsed().as_micros() as u64)
+    });
+    Box::into_raw(Box::new(PendingCommand {
+        client_adapter,
+        reply: Some(reply),
+    }))
+}
+
+/// Waits for the reply of a command sent by [`start_command`].
+///
+/// `latency_us` receives how long the server took to reply, in microseconds, and `was_ready`
+/// whether the reply had already arrived, i.e. whether the caller didn't have to wait. Must be
+/// called at most once per command.
+///
+/// # Safety
+///
+/// * `pending_ptr` must be obtained from [`start_command`] and not yet freed.
+/// * `latency_us` and `was_ready` must be valid pointers.
+/// * The returned `CommandResult` must be freed with [`free_command_result`].
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn wait_pending_command(
+    pending_ptr: *mut PendingCommand,
+    latency_us: *mut u64,
+    was_ready: *mut bool,
+) -> *mut CommandResult {
+    let pending = unsafe { &mut *pending_ptr };
+    let Some(reply) = pending.reply.take() else {
+        return create_error_result_with_custom_error(
+            "The reply was already received".to_string(),
+            RequestErrorType::Unspecified,
+        );
+    };
+    unsafe { *was_ready = reply.is_finished() };
+    match pending.client_adapter.runtime.block_on(reply) {
+        Ok((result, latency)) => {
+            unsafe { *latency_us = latency };
+            ClientAdapter::handle_result(result, None, None, 0)
+        }
+        Err(join_error) => create_error_result_with_custom_error(
+            format!("Command failed: {join_error}"),
+            RequestErrorType::Unspecified,
+        ),
+    }
+}
+
+/// Frees a command sent by [`start_command`], dropping its reply if it wasn't received.
+///
+/// # Safety
+///
+/// * `pending_ptr` must be obtained from [`start_command`], or be null.
+/// * `free_pending_command` can only be called once per command.
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn free_pending_command(pending_ptr: *mut PendingCommand) {
+    if !pending_ptr.is_null() {
+        drop(unsafe { Box::from_raw(pending_ptr) });
+    }
+}
+
 /// Allows the client to request an update to the connection password.
 ///
 /// `client_adapter_ptr` is a pointer to a valid `GlideClusterClient` returned in the `ConnectionResponse` from [`create_client`].
@@ -1560,6 +2296,9 @@ pub unsafe extern "C-unwind" fn update_connection_password(
 
 /// Executes a Lua script.
 ///
+/// A script stored with [`store_script`] is loaded on the client's nodes before the client first
+/// invokes it, and loaded again if a node replies NOSCRIPT; afterwards EVALSHA is sent directly.
+///
 /// # Parameters
 ///
 /// * `client_adapter_ptr`: Pointer to a valid `GlideClusterClient` returned from [`create_client`].
@@ -1779,7 +2518,19 @@ pub unsafe extern "C" fn batch(
         pipeline.set_pipeline_span(unsafe { get_unsafe_span_from_ptr(Some(span_ptr)) });
     }
     let child_span = create_child_span(pipeline.span().as_ref(), "send_batch");
-    let (routing, timeout, pipeline_retry_strategy) = unsafe { get_pipeline_options(options_ptr) };
+    let (routing, timeout, pipeline_retry_strategy) =
+        match unsafe { get_pipeline_options(options_ptr) } {
+            Ok(options) => options,
+            Err(err) => {
+                return unsafe {
+                    client_adapter.handle_custom_error(
+                        err,
+                        RequestErrorType::Unspecified,
+                        callback_index,
+                    )
+                };
+            }
+        };
 
     let result = client_adapter.execute_request(callback_index, async move {
         if pipeline.is_atomic() {
@@ -1805,20 +2556,37 @@ pub unsafe extern "C" fn batch(
     result
 }
 
-/// Convert raw C string to a rust string.
+/// Convert raw C string to a rust string, failing if it is not valid UTF-8.
 ///
 /// # Safety
 ///
 /// * `ptr` must be able to be safely casted to a valid [`CStr`] via [`CStr::from_ptr`]. See the safety documentation of [`std::ffi::CStr::from_ptr`].
-unsafe fn ptr_to_str(ptr: *const c_char) -> String {
+unsafe fn ptr_to_str(ptr: *const c_char) -> Result<String, String> {
     if !ptr.is_null() {
-        unsafe { CStr::from_ptr(ptr) }.to_str().unwrap().into()
+        match unsafe { CStr::from_ptr(ptr) }.to_str() {
+            Ok(str) => Ok(str.into()),
+            Err(err) => Err(format!("Invalid UTF-8 string: {err}")),
+        }
     } else {
-        "".into()
+        Ok("".into())
     }
 }
 
-/// Convert route configuration to a corresponding object.
+/// Convert raw C string to bytes, without requiring them to be valid UTF-8.
+///
+/// # Safety
+///
+/// See the safety documentation of [`ptr_to_str`].
+unsafe fn ptr_to_bytes<'a>(ptr: *const c_char) -> &'a [u8] {
+    if !ptr.is_null() {
+        unsafe { CStr::from_ptr(ptr) }.to_bytes()
+    } else {
+        &[]
+    }
+}
+
+/// Convert route configuration to a corresponding object. Fails if the host name of an address
+/// route is not valid UTF-8.
 ///
 /// # Safety
 /// * `route_ptr` could be `null`, but if it is not `null`, it must be a valid pointer to a [`RouteInfo`] struct.
@@ -1827,12 +2595,12 @@ unsafe fn ptr_to_str(ptr: *const c_char) -> String {
 pub(crate) unsafe fn create_route(
     route_ptr: *const RouteInfo,
     cmd: Option<&Cmd>,
-) -> Option<RoutingInfo> {
+) -> Result<Option<RoutingInfo>, String> {
     if route_ptr.is_null() {
-        return None;
+        return Ok(None);
     }
     let route = unsafe { *route_ptr };
-    match route.route_type {
+    let routing_info = match route.route_type {
         RouteType::Random => Some(RoutingInfo::SingleNode(SingleNodeRoutingInfo::Random)),
         RouteType::AllNodes => Some(RoutingInfo::MultiNode((
             MultipleNodeRoutingInfo::AllNodes,
@@ -1850,15 +2618,16 @@ pub(crate) unsafe fn create_route(
         )),
         RouteType::SlotKey => Some(RoutingInfo::SingleNode(
             SingleNodeRoutingInfo::SpecificNode(Route::new(
-                redis::cluster_topology::get_slot(unsafe { ptr_to_str(route.slot_key) }.as_bytes()),
+                redis::cluster_topology::get_slot(unsafe { ptr_to_bytes(route.slot_key) }),
                 (&route.slot_type).into(),
             )),
         )),
         RouteType::ByAddress => Some(RoutingInfo::SingleNode(SingleNodeRoutingInfo::ByAddress {
-            host: unsafe { ptr_to_str(route.hostname) },
+            host: unsafe { ptr_to_str(route.hostname) }?,
             port: route.port as u16,
         })),
-    }
+    };
+    Ok(routing_info)
 }
 
 /// Convert [`CmdInfo`] to a [`Cmd`].
@@ -1921,9 +2690,9 @@ pub(crate) unsafe fn create_pipeline(ptr: *const BatchInfo) -> Result<Pipeline,
 ///   See description of [`RouteInfo`] and the safety documentation of [`create_route`].
 pub(crate) unsafe fn get_pipeline_options(
     ptr: *const BatchOptionsInfo,
-) -> (Option<RoutingInfo>, Option<u32>, PipelineRetryStrategy) {
+) -> Result<(Option<RoutingInfo>, Option<u32>, PipelineRetryStrategy), String> {
     if ptr.is_null() {
-        return (None, None, PipelineRetryStrategy::new(false, false));
+        return Ok((None, None, PipelineRetryStrategy::new(false, false)));
     }
     let info = unsafe { *ptr };
     let timeout = if info.has_timeout {
@@ -1931,13 +2700,13 @@ pub(crate) unsafe fn get_pipeline_options(
     } else {
         None
     };
-    let route = unsafe { create_route(info.route_info, None) };
+    let route = unsafe { create_route(info.route_info, None) }?;
 
-    (
+    Ok((
         route,
         timeout,
         PipelineRetryStrategy::new(info.retry_server_error, info.retry_connection_error),
-    )
+    ))
 }
 
 /// Creates an OpenTelemetry span with the given name and returns a pointer to the span as u64.
@@ -1,4 +1,6 @@
-use glide_core::connection_request::{ConnectionRequest, NodeAddress, TlsMode};
+use glide_core::connection_request::{
+    ConnectionRequest, NodeAddress, PubSubChannelsOrPatterns, PubSubSubscriptions, TlsMode,
+};
 use glide_core::errors::RequestErrorType;
 use glide_core::request_type::RequestType;
 use glide_ffi::*;
@@ -10,7 +12,7 @@ use std::ffi::{CStr, c_char, c_ulong, c_void};
 use std::net::TcpListener;
 use std::process::{Child, Command};
 use std::sync::{
-    Arc, RwLock,
+    Arc, Mutex, RwLock,
     atomic::{AtomicUsize, Ordering},
 };
 use tokio::runtime::Runtime;
@@ -30,6 +32,11 @@ lazy_static! {
     }));
 }
 
+lazy_static! {
+    /// The (kind, channel, message) of the push notifications received, one entry per batch
+    static ref PUSH_BATCHES: Mutex<Vec<Vec<(String, Vec<u8>, Vec<u8>)>>> = Mutex::new(Vec::new());
+}
+
 const ASYNC_WRITE_LOCK_ERR: &str = "Failed to aquire ASYNC_METRICS the write lock";
 const ASYNC_READ_LOCK_ERR: &str = "Failed to aquire ASYNC_METRICS the write lock";
 
@@ -55,6 +62,26 @@ extern "C-unwind" fn failure_callback(
     metrics.failure_count.fetch_add(1, Ordering::SeqCst);
 }
 
+/// Batched PubSub callback, copying the messages out of the reused buffers
+extern "C-unwind" fn push_batch_callback(
+    _client_ptr: usize,
+    messages: *const PushNotification,
+    message_count: usize,
+) {
+    let messages = unsafe { std::slice::from_raw_parts(messages, message_count) };
+    let batch = messages
+        .iter()
+        .map(|message| unsafe {
+            (
+                format!("{:?}", message.kind),
+                std::slice::from_raw_parts(message.channel, message.channel_len as usize).to_vec(),
+                std::slice::from_raw_parts(message.message, message.message_len as usize).to_vec(),
+            )
+        })
+        .collect();
+    PUSH_BATCHES.lock().unwrap().push(batch);
+}
+
 fn parse_string_res(response_ptr: *const CommandResponse) -> String {
     assert!(!response_ptr.is_null());
     let response: &CommandResponse = unsafe { &*response_ptr };
@@ -310,3 +337,102 @@ fn test_ffi_client_command_execution(#[values(false, true)] async_client: bool)
         close_client(client_ptr);
     }
 }
+
+#[test]
+fn test_ffi_client_push_batches() {
+    const MAX_BATCH_SIZE: usize = 8;
+    const MESSAGE_COUNT: usize = 20;
+
+    let server = Server::new();
+    let mut request = ConnectionRequest::parse_from_bytes(&create_connection_request(server.port))
+        .expect("Failed to parse");
+    let mut channels = PubSubChannelsOrPatterns::new();
+    channels.channels_or_patterns.push(b"news".to_vec());
+    let mut shard_channels = PubSubChannelsOrPatterns::new();
+    shard_channels.channels_or_patterns.push(b"orders".to_vec());
+    let mut subscriptions = PubSubSubscriptions::new();
+    // PubSubChannelType::Exact
+    subscriptions
+        .channels_or_patterns_by_type
+        .insert(0, channels);
+    // PubSubChannelType::Sharded
+    subscriptions
+        .channels_or_patterns_by_type
+        .insert(2, shard_channels);
+    request.pubsub_subscriptions = protobuf::MessageField::some(subscriptions);
+    let subscriber_request_bytes = request.write_to_bytes().expect("Failed to serialize");
+    let publisher_request_bytes = create_connection_request(server.port);
+    let client_type = Box::into_raw(Box::new(ClientType::SyncClient));
+    unsafe {
+        let subscriber_response_ptr = create_client_with_push_batches(
+            subscriber_request_bytes.as_ptr(),
+            subscriber_request_bytes.len(),
+            client_type,
+            push_batch_callback,
+            MAX_BATCH_SIZE,
+        );
+        assert!(
+            !(*subscriber_response_ptr).conn_ptr.is_null(),
+            "Failed to create subscriber"
+        );
+        let publisher_response_ptr = create_client_with_push_batches(
+            publisher_request_bytes.as_ptr(),
+            publisher_request_bytes.len(),
+            client_type,
+            push_batch_callback,
+            MAX_BATCH_SIZE,
+        );
+        let publisher_ptr = (*publisher_response_ptr).conn_ptr;
+        assert!(!publisher_ptr.is_null(), "Failed to create publisher");
+
+        // Exact and sharded messages are interleaved, and delivered in the order they were published
+        let publications = [
+            (RequestType::Publish, "PushMessage", b"news".as_slice()),
+            (RequestType::SPublish, "PushSMessage", b"orders".as_slice()),
+        ];
+        let mut expected = Vec::new();
+        for i in 0..MESSAGE_COUNT {
+            for (request_type, kind, channel) in publications {
+                let message = format!("message-{i}");
+                let args = [channel.as_ptr(), message.as_ptr()];
+                let args_len = [channel.len() as c_ulong, message.len() as c_ulong];
+                let result = command(
+                    publisher_ptr,
+                    i,
+                    request_type,
+                    2,
+                    args.as_ptr() as *const usize,
+                    args_len.as_ptr(),
+                    std::ptr::null(),
+                    0,
+                    0,
+                );
+                assert!(!result.is_null());
+                assert!(Box::from_raw(result).command_error.is_null());
+                expected.push((kind.to_string(), channel.to_vec(), message.into_bytes()));
+            }
+        }
+
+        let mut received = Vec::new();
+        for _ in 0..100 {
+            received = PUSH_BATCHES.lock().unwrap().clone();
+            if received.iter().map(Vec::len).sum::<usize>() >= expected.len() {
+                break;
+            }
+            std::thread::sleep(Duration::from_millis(10));
+        }
+        assert!(
+            received
+                .iter()
+                .all(|batch| !batch.is_empty() && batch.len() <= MAX_BATCH_SIZE)
+        );
+        let messages: Vec<_> = received.into_iter().flatten().collect();
+        assert_eq!(messages, expected);
+
+        close_client((*subscriber_response_ptr).conn_ptr);
+        close_client(publisher_ptr);
+        free_connection_response(subscriber_response_ptr as *mut ConnectionResponse);
+        free_connection_response(publisher_response_ptr as *mut ConnectionResponse);
+        drop(Box::from_raw(client_type));
+    }
+}
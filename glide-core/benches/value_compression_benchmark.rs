@@ -0,0 +1,142 @@
+// Copyright Valkey GLIDE Project Contributors - SPDX Identifier: Apache-2.0
+
+//! Compares raw values with values compressed by the client, against a valkey-server listening on
+//! localhost:6379. Besides the latency measured by criterion, prints the bytes the server received
+//! for the writes and sent for the reads, from its `total_net_input_bytes` and
+//! `total_net_output_bytes` stats.
+
+use criterion::{BenchmarkId, Criterion, Throughput, criterion_group, criterion_main};
+use glide_core::{
+    client::Client,
+    connection_request::{
+        CompressionAlgorithm, ConnectionRequest, NodeAddress, TlsMode, ValueCompression,
+    },
+};
+use redis::{Value, cmd, from_owned_redis_value};
+use tokio::runtime::{Builder, Runtime};
+
+const VALUE_SIZES: [usize; 3] = [512, 4 * 1024, 64 * 1024];
+const KEYS: usize = 100;
+
+fn create_connection_request(compression: Option<CompressionAlgorithm>) -> ConnectionRequest {
+    let mut request = ConnectionRequest::new();
+    request.tls_mode = TlsMode::NoTls.into();
+    let mut address_info = NodeAddress::new();
+    address_info.host = "localhost".into();
+    address_info.port = 6379;
+    request.addresses.push(address_info);
+    if let Some(algorithm) = compression {
+        let mut value_compression = ValueCompression::new();
+        value_compression.algorithm = algorithm.into();
+        value_compression.min_size = 256;
+        request.value_compression = Some(value_compression).into();
+    }
+    request
+}
+
+/// A JSON document of about `size` bytes, compressible like typical cached objects.
+fn create_value(size: usize) -> Vec<u8> {
+    let mut value = String::from("[");
+    let mut id = 0;
+    while value.len() < size {
+        value.push_str(&format!(
+            r#"{{"id":{id},"name":"user-{id}","email":"user-{id}@example.com","active":{},"score":{}}},"#,
+            id % 3 == 0,
+            (id * 7919) % 1000
+        ));
+        id += 1;
+    }
+    value.truncate(size - 1);
+    value.push(']');
+    value.into_bytes()
+}
+
+async fn net_bytes(client: &mut Client) -> (u64, u64) {
+    let info = client
+        .send_command(cmd("INFO").arg("stats"), None)
+        .await
+        .unwrap();
+    let info: String = from_owned_redis_value(info).unwrap();
+    let stat = |name: &str| {
+        info.lines()
+            .find_map(|line| line.strip_prefix(name)?.strip_prefix(':'))
+            .and_then(|bytes| bytes.trim().parse::<u64>().ok())
+            .unwrap()
+    };
+    (
+        stat("total_net_input_bytes"),
+        stat("total_net_output_bytes"),
+    )
+}
+
+async fn write_and_read(client: &mut Client, value: &[u8]) {
+    for key in 0..KEYS {
+        client
+            .send_command(cmd("SET").arg(key).arg(value), None)
+            .await
+            .unwrap();
+    }
+    for key in 0..KEYS {
+        let read = client
+            .send_command(cmd("GET").arg(key), None)
+            .await
+            .unwrap();
+        assert_eq!(read, Value::BulkString(value.to_vec()));
+    }
+}
+
+fn report_bytes_on_wire(runtime: &Runtime, clients: &mut [(&str, Client)]) {
+    for size in VALUE_SIZES {
+        let value = create_value(size);
+        for (name, client) in clients.iter_mut() {
+            let (written, read) = runtime.block_on(async {
+                let (input_before, output_before) = net_bytes(client).await;
+                write_and_read(client, &value).await;
+                let (input_after, output_after) = net_bytes(client).await;
+                (input_after - input_before, output_after - output_before)
+            });
+            println!(
+                "{name} values of {size} bytes: {} bytes written, {} bytes read per key",
+                written / KEYS as u64,
+                read / KEYS as u64
+            );
+        }
+    }
+}
+
+fn value_compression_benchmarks(c: &mut Criterion) {
+    let runtime = Builder::new_current_thread().enable_all().build().unwrap();
+    let mut clients: Vec<(&str, Client)> = [
+        ("raw", None),
+        ("lz4", Some(CompressionAlgorithm::Lz4)),
+        ("zstd", Some(CompressionAlgorithm::Zstd)),
+    ]
+    .into_iter()
+    .map(|(name, compression)| {
+        let request = create_connection_request(compression).into();
+        (name, runtime.block_on(Client::new(request, None)).unwrap())
+    })
+    .collect();
+
+    report_bytes_on_wire(&runtime, &mut clients);
+
+    let mut group = c.benchmark_group("value compression");
+    group.sample_size(20);
+    for size in VALUE_SIZES {
+        let value = create_value(size);
+        group.throughput(Throughput::Bytes((size * KEYS * 2) as u64));
+        for (name, client) in clients.iter() {
+            group.bench_with_input(BenchmarkId::new(*name, size), &value, |b, value| {
+                b.to_async(&runtime).iter(|| {
+                    let mut client = client.clone();
+                    async move { write_and_read(&mut client, value).await }
+                });
+            });
+        }
+    }
+    group.finish();
+}
+
+criterion_group!(benches, value_compression_benchmarks);
+
+criterion_main!(benches);
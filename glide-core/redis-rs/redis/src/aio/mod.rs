@@ -221,6 +221,30 @@ where
         }
     }
 
+    if let Some(client_tracking) = &connection_info.client_tracking {
+        if connection_info.protocol == ProtocolVersion::RESP2 {
+            fail!((
+                ErrorKind::InvalidClientConfig,
+                "Client tracking requires RESP3"
+            ));
+        }
+        let mut command = cmd("CLIENT");
+        command.arg("TRACKING").arg("ON");
+        if client_tracking.broadcast {
+            command.arg("BCAST");
+            for prefix in &client_tracking.prefixes {
+                command.arg("PREFIX").arg(prefix);
+            }
+        }
+        match command.query_async(con).await {
+            Ok(Value::Okay) => {}
+            _ => fail!((
+                ErrorKind::ResponseError,
+                "Redis server refused to enable client tracking"
+            )),
+        }
+    }
+
     if discover_az {
         update_az_from_info(con).await?;
     }
@@ -524,6 +524,15 @@ impl MultiplexedConnection {
             }
         };
 
+        if connection_info.redis.client_tracking.is_some() {
+            // Invalidations sent to any previous connection were lost, so whatever the client
+            // cached before this connection was established can no longer be trusted.
+            con.push_manager.try_send_raw(&Value::Push {
+                kind: PushKind::Invalidate,
+                data: vec![Value::Nil],
+            });
+        }
+
         Ok((con, driver))
     }
 
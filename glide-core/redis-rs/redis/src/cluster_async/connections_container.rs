@@ -2,6 +2,7 @@ use crate::cluster_async::ConnectionFuture;
 use crate::cluster_routing::{Route, ShardAddrs, SlotAddr};
 use crate::cluster_slotmap::{ReadFromReplicaStrategy, SlotMap, SlotMapValue};
 use crate::cluster_topology::TopologyHash;
+use crate::node_latency::{pick_two, NodeLatencies};
 use dashmap::DashMap;
 use futures::FutureExt;
 use rand::seq::IteratorRandom;
@@ -480,6 +481,37 @@ where
         self.round_robin_read_from_replica(slot_map_value)
     }
 
+    /// Returns the connection of the node expected to answer a read the fastest, choosing between two random
+    /// candidates among the shard's replicas, and its primary if `include_primary` is set.
+    /// Falls back to round robin if neither candidate is connected.
+    fn lowest_latency_read(
+        &self,
+        slot_map_value: &SlotMapValue,
+        latencies: &NodeLatencies,
+        include_primary: bool,
+    ) -> Option<ConnectionAndAddress<Connection>> {
+        let addrs = &slot_map_value.addrs;
+        let (first, second) = {
+            let replicas = addrs.replicas();
+            let candidate = |index: usize| {
+                replicas
+                    .get(index)
+                    .cloned()
+                    .unwrap_or_else(|| addrs.primary())
+            };
+            let (first, second) = pick_two(replicas.len() + usize::from(include_primary));
+            (candidate(first), candidate(second))
+        };
+        let (preferred, other) = if latencies.cost(&second) < latencies.cost(&first) {
+            (second, first)
+        } else {
+            (first, second)
+        };
+        self.connection_for_address(preferred.as_str())
+            .or_else(|| self.connection_for_address(other.as_str()))
+            .or_else(|| self.round_robin_read_from_replica(slot_map_value))
+    }
+
     fn lookup_route(&self, route: &Route) -> Option<ConnectionAndAddress<Connection>> {
         let slot_map_value = self.slot_map.slot_value_for_route(route)?;
         let addrs = &slot_map_value.addrs;
@@ -508,6 +540,9 @@ where
                         slot_map_value,
                         az.to_string(),
                     ),
+                ReadFromReplicaStrategy::LowestLatency(latencies) => {
+                    self.lowest_latency_read(slot_map_value, latencies, true)
+                }
             },
             // when the user strategy per command is replica_preffered
             SlotAddr::ReplicaRequired => match &self.read_from_replica_strategy {
@@ -521,6 +556,9 @@ where
                         slot_map_value,
                         az.to_string(),
                     ),
+                ReadFromReplicaStrategy::LowestLatency(latencies) => {
+                    self.lowest_latency_read(slot_map_value, latencies, false)
+                }
                 _ => self.round_robin_read_from_replica(slot_map_value),
             },
         }
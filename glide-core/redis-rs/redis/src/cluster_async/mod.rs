@@ -38,7 +38,9 @@ use crate::{
         DEFAULT_REFRESH_SLOTS_RETRY_BASE_DURATION_MILLIS, DEFAULT_REFRESH_SLOTS_RETRY_BASE_FACTOR,
     },
     cmd,
-    commands::cluster_scan::{cluster_scan, ClusterScanArgs, ScanStateRC},
+    commands::cluster_scan::{
+        cluster_scan, parallel_cluster_scan, ClusterScanArgs, ParallelScanOptions, ScanStateRC,
+    },
     types::ServerError,
     FromRedisValue, InfoDict, PipelineRetryStrategy,
 };
@@ -82,7 +84,9 @@ use crate::{
         self, MultipleNodeRoutingInfo, Redirect, ResponsePolicy, Route, SingleNodeRoutingInfo,
         SlotAddr,
     },
+    cluster_slotmap::ReadFromReplicaStrategy,
     connection::{PubSubSubscriptionInfo, PubSubSubscriptionKind},
+    node_latency::{NodeLatencies, NodeLatency},
     push_manager::PushInfo,
     Cmd, ConnectionInfo, ErrorKind, IntoConnectionInfo, RedisError, RedisFuture, RedisResult,
     Value,
@@ -200,7 +204,7 @@ where
     ///     }
     /// ```
     pub async fn cluster_scan(
-        &mut self,
+        &self,
         scan_state_rc: ScanStateRC,
         mut cluster_scan_args: ClusterScanArgs,
     ) -> RedisResult<(ScanStateRC, Vec<Value>)> {
@@ -210,7 +214,7 @@ where
 
     /// Route cluster scan to be handled by internal cluster_scan command
     async fn route_cluster_scan(
-        &mut self,
+        &self,
         cluster_scan_args: ClusterScanArgs,
     ) -> RedisResult<(ScanStateRC, Vec<Value>)> {
         let (sender, receiver) = oneshot::channel();
@@ -240,9 +244,76 @@ where
             })
     }
 
+    /// Scans the whole cluster, scanning up to `options.concurrency` nodes at the same time, and
+    /// sends the keys found to `keys_sender`, one batch per `SCAN` reply, as they arrive.
+    ///
+    /// Gives the same guarantees as [`cluster_scan`](Self::cluster_scan): every key that exists in
+    /// the cluster from the start to the end of the scan is returned, possibly more than once. The
+    /// scan state cursor in `cluster_scan_args` is ignored. A bounded channel lets a slow consumer
+    /// slow the scan down, and `options.max_scans_per_second` bounds the load on the cluster.
+    ///
+    /// Returns once all the slots were scanned, or as soon as `keys_sender`'s receiver is dropped.
+    ///
+    /// # Example
+    /// ```rust,no_run
+    /// use redis::cluster::ClusterClient;
+    /// use redis::{ClusterScanArgs, ParallelScanOptions};
+    ///
+    /// async fn count_keys() -> usize {
+    ///     let client = ClusterClient::new(vec!["redis://127.0.0.1/"]).unwrap();
+    ///     let connection = client.get_async_connection(None).await.unwrap();
+    ///     let (sender, mut receiver) = tokio::sync::mpsc::channel(16);
+    ///     let options = ParallelScanOptions { concurrency: 8, max_scans_per_second: Some(1000) };
+    ///     let scan = tokio::spawn(async move {
+    ///         connection
+    ///             .parallel_cluster_scan(ClusterScanArgs::builder().with_count(1000).build(), options, sender)
+    ///             .await
+    ///     });
+    ///     let mut count = 0;
+    ///     while let Some(keys) = receiver.recv().await {
+    ///         count += keys.len();
+    ///     }
+    ///     scan.await.unwrap().unwrap();
+    ///     count
+    /// }
+    /// ```
+    pub async fn parallel_cluster_scan(
+        &self,
+        cluster_scan_args: ClusterScanArgs,
+        options: ParallelScanOptions,
+        keys_sender: mpsc::Sender<Vec<Value>>,
+    ) -> RedisResult<()> {
+        let (sender, receiver) = oneshot::channel();
+        self.0
+            .send(Message {
+                cmd: CmdArg::ParallelClusterScan {
+                    cluster_scan_args,
+                    options,
+                    keys_sender,
+                },
+                sender,
+            })
+            .await
+            .map_err(|e| {
+                RedisError::from(io::Error::new(
+                    io::ErrorKind::BrokenPipe,
+                    format!("Cluster: Error occurred while trying to send SCAN command to internal send task. {e:?}"),
+                ))
+            })?;
+        receiver
+            .await
+            .unwrap_or_else(|e| {
+                Err(RedisError::from(io::Error::new(
+                    io::ErrorKind::BrokenPipe,
+                    format!("Cluster: Failed to receive SCAN command response from internal send task. {e:?}"),
+                )))
+            })
+            .map(|_| ())
+    }
+
     /// Send a command to the given `routing`. If `routing` is [None], it will be computed from `cmd`.
     pub async fn route_command(
-        &mut self,
+        &self,
         cmd: &Cmd,
         routing: cluster_routing::RoutingInfo,
     ) -> RedisResult<Value> {
@@ -285,7 +356,7 @@ where
     ///   - `retry_connection_error`: If `true`, retries on connection errors (may lead to duplicate executions).  
     ///     TODO: add wiki link.
     pub async fn route_pipeline<'a>(
-        &'a mut self,
+        &'a self,
         pipeline: &'a crate::Pipeline,
         offset: usize,
         count: usize,
@@ -323,25 +394,40 @@ where
                 Response::ClusterScanResult(..) | Response::Single(_) => unreachable!(),
             })
     }
+
+    /// Send commands in `pipeline` to the node chosen by the keys of its commands, the same way
+    /// [ConnectionLike::req_packed_commands] does, without requiring exclusive access.
+    pub async fn route_pipeline_by_keys(
+        &self,
+        pipeline: &crate::Pipeline,
+        offset: usize,
+        count: usize,
+        pipeline_retry_strategy: Option<PipelineRetryStrategy>,
+    ) -> RedisResult<Vec<Value>> {
+        let route = route_for_pipeline(pipeline)?;
+        self.route_pipeline(
+            pipeline,
+            offset,
+            count,
+            route.map(|r| Some(r).into()),
+            pipeline_retry_strategy,
+        )
+        .await
+    }
+
     /// Update the password used to authenticate with all cluster servers
-    pub async fn update_connection_password(
-        &mut self,
-        password: Option<String>,
-    ) -> RedisResult<Value> {
+    pub async fn update_connection_password(&self, password: Option<String>) -> RedisResult<Value> {
         self.route_operation_request(Operation::UpdateConnectionPassword(password))
             .await
     }
 
     /// Get the username used to authenticate with all cluster servers
-    pub async fn get_username(&mut self) -> RedisResult<Value> {
+    pub async fn get_username(&self) -> RedisResult<Value> {
         self.route_operation_request(Operation::GetUsername).await
     }
 
     /// Routes an operation request to the appropriate handler.
-    async fn route_operation_request(
-        &mut self,
-        operation_request: Operation,
-    ) -> RedisResult<Value> {
+    async fn route_operation_request(&self, operation_request: Operation) -> RedisResult<Value> {
         let (sender, receiver) = oneshot::channel();
         self.0
             .send(Message {
@@ -413,6 +499,8 @@ pub(crate) struct InnerCore<C> {
     subscriptions_by_address: TokioRwLock<HashMap<String, PubSubSubscriptionInfo>>,
     unassigned_subscriptions: TokioRwLock<PubSubSubscriptionInfo>,
     glide_connection_options: GlideConnectionOptions,
+    // The round trip times of reads, when they are routed by ReadFromReplicaStrategy::LowestLatency.
+    read_latencies: Option<NodeLatencies>,
 }
 
 pub(crate) type Core<C> = Arc<InnerCore<C>>;
@@ -647,6 +735,13 @@ enum CmdArg<C> {
         // struct containing the arguments for the cluster scan command - scan state cursor, match pattern, count and object type.
         cluster_scan_args: ClusterScanArgs,
     },
+    ParallelClusterScan {
+        // the arguments for the cluster scan command, the scan state cursor is ignored.
+        cluster_scan_args: ClusterScanArgs,
+        options: ParallelScanOptions,
+        // receives the keys found, one batch per SCAN reply.
+        keys_sender: mpsc::Sender<Vec<Value>>,
+    },
     // Operational requests which are connected to the internal state of the connection and not send as a command to the server.
     OperationRequest(Operation),
 }
@@ -764,7 +859,7 @@ impl<C> RequestInfo<C> {
                     *route = Some(redirect);
                 }
                 // cluster_scan is sent as a normal command internally so we will not reach that point.
-                CmdArg::ClusterScan { .. } => {
+                CmdArg::ClusterScan { .. } | CmdArg::ParallelClusterScan { .. } => {
                     unreachable!()
                 }
                 // Operation requests are not routed.
@@ -805,7 +900,7 @@ impl<C> RequestInfo<C> {
                 }
             }
             // cluster_scan is sent as a normal command internally so we will not reach that point.
-            CmdArg::ClusterScan { .. } => {
+            CmdArg::ClusterScan { .. } | CmdArg::ParallelClusterScan { .. } => {
                 unreachable!()
             }
             // Operation requests are not routed.
@@ -1147,6 +1242,10 @@ where
             ),
             subscriptions_by_address: TokioRwLock::new(Default::default()),
             glide_connection_options,
+            read_latencies: match &cluster_params.read_from_replicas {
+                ReadFromReplicaStrategy::LowestLatency(latencies) => Some(latencies.clone()),
+                _ => None,
+            },
         });
         let mut connection = ClusterConnInner {
             inner,
@@ -2511,13 +2610,28 @@ where
         };
         trace!("route request to single node");
 
+        // Time the reads that may go to replicas, unless they block on the server.
+        let read_latencies = match &routing {
+            InternalSingleNodeRouting::SpecificNode(route)
+                if route.slot_addr() != SlotAddr::Master && cmd.position(b"BLOCK").is_none() =>
+            {
+                core.read_latencies.clone()
+            }
+            _ => None,
+        };
+
         // if we reached this point, we're sending the command only to single node, and we need to find the
         // right connection to the node.
         let (address, mut conn) = Self::get_connection(routing, core, Some(cmd.clone()))
             .await
             .map_err(|err| (OperationTarget::NotFound, err))?;
-        conn.req_packed_command(&cmd)
-            .await
+        let node_latency = read_latencies.map(|latencies| latencies.node(&address));
+        let sample = node_latency.as_deref().map(NodeLatency::start);
+        let result = conn.req_packed_command(&cmd).await;
+        if let (Ok(_), Some(sample)) = (&result, sample) {
+            sample.finish();
+        }
+        result
             .map(Response::Single)
             .map_err(|err| (address.into(), err))
     }
@@ -2586,6 +2700,17 @@ where
                     Err(err) => Err((OperationTarget::FanOut, err)),
                 }
             }
+            CmdArg::ParallelClusterScan {
+                cluster_scan_args,
+                options,
+                keys_sender,
+            } => {
+                match parallel_cluster_scan(core, cluster_scan_args, options, keys_sender).await {
+                    Ok(()) => Ok(Response::Single(Value::Okay)),
+                    // The workers retry their own nodes, so the scan as a whole isn't retried.
+                    Err(err) => Err((OperationTarget::FanOut, err)),
+                }
+            }
             CmdArg::OperationRequest(operation_request) => match operation_request {
                 Operation::UpdateConnectionPassword(password) => {
                     core.set_cluster_param(|params| params.password = password)
@@ -3455,18 +3580,8 @@ where
         count: usize,
         pipeline_retry_strategy: Option<PipelineRetryStrategy>,
     ) -> RedisFuture<'a, Vec<Value>> {
-        async move {
-            let route = route_for_pipeline(pipeline)?;
-            self.route_pipeline(
-                pipeline,
-                offset,
-                count,
-                route.map(|r| Some(r).into()),
-                pipeline_retry_strategy,
-            )
-            .await
-        }
-        .boxed()
+        self.route_pipeline_by_keys(pipeline, offset, count, pipeline_retry_strategy)
+            .boxed()
     }
 
     fn get_db(&self) -> i64 {
@@ -3,7 +3,9 @@ use crate::cluster_slotmap::ReadFromReplicaStrategy;
 use crate::cluster_topology::{
     DEFAULT_SLOTS_REFRESH_MAX_JITTER_MILLI, DEFAULT_SLOTS_REFRESH_WAIT_DURATION,
 };
-use crate::connection::{ConnectionAddr, ConnectionInfo, IntoConnectionInfo};
+use crate::connection::{
+    ClientTrackingOptions, ConnectionAddr, ConnectionInfo, IntoConnectionInfo,
+};
 use crate::types::{ErrorKind, ProtocolVersion, RedisError, RedisResult};
 use crate::{cluster, cluster::TlsMode};
 use crate::{PubSubSubscriptionInfo, PushInfo, RetryStrategy};
@@ -43,6 +45,7 @@ struct BuilderParams {
     response_timeout: Option<Duration>,
     protocol: ProtocolVersion,
     pubsub_subscriptions: Option<PubSubSubscriptionInfo>,
+    client_tracking: Option<ClientTrackingOptions>,
     reconnect_retry_strategy: Option<RetryStrategy>,
 }
 
@@ -143,6 +146,7 @@ pub struct ClusterParams {
     pub(crate) response_timeout: Duration,
     pub(crate) protocol: ProtocolVersion,
     pub(crate) pubsub_subscriptions: Option<PubSubSubscriptionInfo>,
+    pub(crate) client_tracking: Option<ClientTrackingOptions>,
     pub(crate) reconnect_retry_strategy: Option<RetryStrategy>,
 }
 
@@ -172,6 +176,7 @@ impl ClusterParams {
             response_timeout: value.response_timeout.unwrap_or(Duration::MAX),
             protocol: value.protocol,
             pubsub_subscriptions: value.pubsub_subscriptions,
+            client_tracking: value.client_tracking,
             reconnect_retry_strategy: value.reconnect_retry_strategy,
         })
     }
@@ -514,6 +519,17 @@ impl ClusterClientBuilder {
         self.builder_params.pubsub_subscriptions = Some(pubsub_subscriptions);
         self
     }
+
+    /// Enables server-assisted client side caching (`CLIENT TRACKING`) on every node connection.
+    ///
+    /// Invalidation messages are delivered through the push sender of the connections, so this requires RESP3.
+    pub fn client_tracking(
+        mut self,
+        client_tracking: ClientTrackingOptions,
+    ) -> ClusterClientBuilder {
+        self.builder_params.client_tracking = Some(client_tracking);
+        self
+    }
 }
 
 /// This is a Redis Cluster client.
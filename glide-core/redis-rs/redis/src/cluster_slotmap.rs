@@ -8,6 +8,8 @@ use std::{
 use dashmap::DashMap;
 
 use crate::cluster_routing::{Route, ShardAddrs, Slot, SlotAddr};
+#[cfg(feature = "cluster-async")]
+pub use crate::node_latency::NodeLatencies;
 use crate::ErrorKind;
 use crate::RedisError;
 use crate::RedisResult;
@@ -35,6 +37,10 @@ pub enum ReadFromReplicaStrategy {
     /// Spread the read requests among nodes within the client's Availability Zone (AZ) in a round robin manner,
     /// prioritizing local replicas, then the local primary, and falling back to any replica or the primary if needed.
     AZAffinityReplicasAndPrimary(String),
+    /// Send each read request to the node of the shard, replica or primary, expected to answer it the fastest,
+    /// based on the round trip times of previous reads and the reads in flight. See [crate::node_latency].
+    #[cfg(feature = "cluster-async")]
+    LowestLatency(NodeLatencies),
 }
 
 #[derive(Debug, Default)]
@@ -62,6 +68,11 @@ fn get_address_from_slot(
                 % addrs.replicas().len();
             addrs.replicas()[index].clone()
         }
+        // The synchronous client doesn't time its reads.
+        #[cfg(feature = "cluster-async")]
+        ReadFromReplicaStrategy::LowestLatency(_) => {
+            get_address_from_slot(slot, ReadFromReplicaStrategy::RoundRobin, slot_addr)
+        }
         ReadFromReplicaStrategy::AZAffinity(_az) => todo!(), // Drop sync client
         ReadFromReplicaStrategy::AZAffinityReplicasAndPrimary(_az) => todo!(), // Drop sync client
     }
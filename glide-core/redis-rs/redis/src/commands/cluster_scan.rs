@@ -45,8 +45,14 @@ use crate::cluster_async::{ClusterConnInner, Connect, InnerCore, RefreshPolicy,
 use crate::cluster_routing::SlotAddr;
 use crate::cluster_topology::SLOT_SIZE;
 use crate::{cmd, from_redis_value, ErrorKind, RedisError, RedisResult, Value};
-use std::sync::Arc;
+use futures::future;
+use std::collections::HashSet;
+use std::pin::pin;
+use std::sync::{Arc, Mutex};
+use std::time::Duration;
 use strum_macros::{Display, EnumString};
+use tokio::sync::{mpsc, Notify};
+use tokio::time::Instant;
 
 const BITS_PER_U64: u16 = u64::BITS as u16;
 const NUM_OF_SLOTS: u16 = SLOT_SIZE;
@@ -504,6 +510,12 @@ fn mark_slot_as_scanned(scanned_slots_map: &mut SlotsBitsArray, slot: u16) {
     scanned_slots_map[slot_index] |= 1 << slot_bit;
 }
 
+fn is_slot_scanned(scanned_slots_map: &SlotsBitsArray, slot: u16) -> bool {
+    let slot_index = (slot as u64 / BITS_PER_U64 as u64) as usize;
+    let slot_bit = slot as u64 % (BITS_PER_U64 as u64);
+    scanned_slots_map[slot_index] & (1 << slot_bit) != 0
+}
+
 #[derive(PartialEq, Debug, Clone)]
 /// The address type representing a connection address
 ///
@@ -567,16 +579,20 @@ where
             slot = next_slot(scanned_slots_map).unwrap();
         } else {
             // Error if slots are not covered and scanning is not allowed
-            return Err(RedisError::from((
-                    ErrorKind::NotAllSlotsCovered,
-                    "Could not find an address covering a slot, SCAN operation cannot continue \n 
-                    If you want to continue scanning even if some slots are not covered, set allow_non_covered_slots to true \n 
-                    Note that this may lead to incomplete scanning, and the SCAN operation lose its all guarantees ",
-                )));
+            return Err(non_covered_slot_error());
         }
     }
 }
 
+fn non_covered_slot_error() -> RedisError {
+    RedisError::from((
+        ErrorKind::NotAllSlotsCovered,
+        "Could not find an address covering a slot, SCAN operation cannot continue \n 
+                    If you want to continue scanning even if some slots are not covered, set allow_non_covered_slots to true \n 
+                    Note that this may lead to incomplete scanning, and the SCAN operation lose its all guarantees ",
+    ))
+}
+
 /// Get the next slot to be scanned based on the scanned slots map.
 /// If all slots have been scanned, the method returns [`END_OF_SCAN`].
 fn next_slot(scanned_slots_map: &SlotsBitsArray) -> Option<u16> {
@@ -692,13 +708,29 @@ async fn send_scan<C>(
 where
     C: ConnectionLike + Connect + Clone + Send + Sync + 'static,
 {
-    if let Some(conn_future) = core
-        .connection_for_address(&scan_state.address_in_scan)
-        .await
-    {
+    send_scan_to_address(
+        &scan_state.address_in_scan,
+        scan_state.cursor,
+        cluster_scan_args,
+        core,
+    )
+    .await
+}
+
+/// Sends the `SCAN` command with the given cursor to `address`.
+async fn send_scan_to_address<C>(
+    address: &Arc<String>,
+    cursor: u64,
+    cluster_scan_args: &ClusterScanArgs,
+    core: Arc<InnerCore<C>>,
+) -> RedisResult<Value>
+where
+    C: ConnectionLike + Connect + Clone + Send + Sync + 'static,
+{
+    if let Some(conn_future) = core.connection_for_address(address).await {
         let mut conn = conn_future.await;
         let mut scan_command = cmd("SCAN");
-        scan_command.arg(scan_state.cursor);
+        scan_command.arg(cursor);
         if let Some(match_pattern) = cluster_scan_args.match_pattern.as_ref() {
             scan_command.arg("MATCH").arg(match_pattern);
         }
@@ -713,7 +745,7 @@ where
         Err(RedisError::from((
             ErrorKind::ConnectionNotFoundForRoute,
             "Cluster scan failed. No connection available for address: ",
-            format!("{}", scan_state.address_in_scan),
+            format!("{address}"),
         )))
     }
 }
@@ -809,6 +841,284 @@ where
     }
 }
 
+/// The number of nodes a parallel scan scans at the same time by default.
+const DEFAULT_SCAN_CONCURRENCY: usize = 4;
+/// A parallel scan fails once a worker's scans failed this many times in a row.
+const MAX_CONSECUTIVE_SCAN_FAILURES: u32 = 5;
+
+/// Options of a parallel cluster scan, see [`ClusterConnection::parallel_cluster_scan`].
+///
+/// [`ClusterConnection::parallel_cluster_scan`]: crate::cluster_async::ClusterConnection::parallel_cluster_scan
+#[derive(Clone, Debug)]
+pub struct ParallelScanOptions {
+    /// The number of nodes scanned at the same time, 4 by default.
+    pub concurrency: usize,
+    /// An upper bound on the number of `SCAN` commands sent per second over all the nodes, so
+    /// that a scan doesn't take over the cluster. Unbounded by default.
+    pub max_scans_per_second: Option<u32>,
+}
+
+impl Default for ParallelScanOptions {
+    fn default() -> Self {
+        Self {
+            concurrency: DEFAULT_SCAN_CONCURRENCY,
+            max_scans_per_second: None,
+        }
+    }
+}
+
+/// What a worker of a parallel scan does next.
+enum ScanClaim {
+    /// Scan the shard whose primary is at `primary`, reading from the node at `address`.
+    Shard {
+        primary: Arc<String>,
+        address: Arc<String>,
+    },
+    /// All the slots left are owned by nodes scanned by other workers.
+    Wait,
+    /// All the slots were scanned, or the scan was stopped.
+    Done,
+}
+
+/// The result of scanning a node from cursor 0 back to cursor 0.
+enum NodeScanOutcome {
+    /// The node was scanned. Holds the slots it owns, or None if its epoch changed during the
+    /// scan, in which case it isn't known which of its slots were owned throughout.
+    Completed(Option<Vec<u16>>),
+    /// The receiver of the keys was dropped.
+    ReceiverDropped,
+}
+
+struct ParallelScanProgress {
+    scanned_slots_map: SlotsBitsArray,
+    // The primaries of the shards being scanned by a worker, so that no shard is scanned twice at
+    // the same time, whichever of its nodes is read from.
+    addresses_in_scan: HashSet<Arc<String>>,
+    stopped: bool,
+}
+
+/// The state shared by the workers of a parallel scan.
+struct ParallelScan {
+    progress: Mutex<ParallelScanProgress>,
+    // Notified when a worker releases a node, so that waiting workers look for slots again.
+    released: Notify,
+    scan_interval: Option<Duration>,
+    next_scan_at: Mutex<Instant>,
+}
+
+impl ParallelScan {
+    fn new(options: &ParallelScanOptions) -> Self {
+        Self {
+            progress: Mutex::new(ParallelScanProgress {
+                scanned_slots_map: [0; BITS_ARRAY_SIZE as usize],
+                addresses_in_scan: HashSet::new(),
+                stopped: false,
+            }),
+            released: Notify::new(),
+            scan_interval: options
+                .max_scans_per_second
+                .filter(|rate| *rate > 0)
+                .map(|rate| Duration::from_secs(1) / rate),
+            next_scan_at: Mutex::new(Instant::now()),
+        }
+    }
+
+    /// Claims the shard owning the first slot that is neither scanned nor owned by a shard in scan.
+    /// Shards are identified by their primary, then read from a replica if there is one.
+    fn claim<C>(&self, core: &InnerCore<C>, allow_non_covered_slots: bool) -> RedisResult<ScanClaim>
+    where
+        C: ConnectionLike + Connect + Clone + Send + Sync + 'static,
+    {
+        let mut progress = self.progress.lock().unwrap();
+        if progress.stopped {
+            return Ok(ScanClaim::Done);
+        }
+        let conn_lock = core.conn_lock.read().expect(MUTEX_READ_ERR);
+        for slot in 0..NUM_OF_SLOTS {
+            if is_slot_scanned(&progress.scanned_slots_map, slot) {
+                continue;
+            }
+            match conn_lock
+                .slot_map
+                .node_address_for_slot(slot, SlotAddr::Master)
+            {
+                Some(primary) if progress.addresses_in_scan.contains(&primary) => {}
+                Some(primary) => {
+                    let address = conn_lock
+                        .slot_map
+                        .node_address_for_slot(slot, SlotAddr::ReplicaRequired)
+                        .unwrap_or_else(|| primary.clone());
+                    progress.addresses_in_scan.insert(primary.clone());
+                    return Ok(ScanClaim::Shard { primary, address });
+                }
+                None if allow_non_covered_slots => {
+                    mark_slot_as_scanned(&mut progress.scanned_slots_map, slot)
+                }
+                None => return Err(non_covered_slot_error()),
+            }
+        }
+        if progress.addresses_in_scan.is_empty() {
+            Ok(ScanClaim::Done)
+        } else {
+            Ok(ScanClaim::Wait)
+        }
+    }
+
+    /// Releases a claimed shard, marking `scanned_slots` as scanned.
+    fn release(&self, primary: &Arc<String>, scanned_slots: &[u16]) {
+        {
+            let mut progress = self.progress.lock().unwrap();
+            progress.addresses_in_scan.remove(primary);
+            for slot in scanned_slots {
+                mark_slot_as_scanned(&mut progress.scanned_slots_map, *slot);
+            }
+        }
+        self.released.notify_waiters();
+    }
+
+    fn stop(&self) {
+        self.progress.lock().unwrap().stopped = true;
+        self.released.notify_waiters();
+    }
+
+    /// Waits until the rate limit allows one more `SCAN` command.
+    async fn pace(&self) {
+        let Some(scan_interval) = self.scan_interval else {
+            return;
+        };
+        let scan_at = {
+            let mut next_scan_at = self.next_scan_at.lock().unwrap();
+            let scan_at = (*next_scan_at).max(Instant::now());
+            *next_scan_at = scan_at + scan_interval;
+            scan_at
+        };
+        tokio::time::sleep_until(scan_at).await;
+    }
+
+    /// Scans a node from cursor 0 back to cursor 0, sending the keys found to `keys_sender`.
+    async fn scan_address<C>(
+        &self,
+        core: &Arc<InnerCore<C>>,
+        address: &Arc<String>,
+        cluster_scan_args: &ClusterScanArgs,
+        keys_sender: &mpsc::Sender<Vec<Value>>,
+    ) -> RedisResult<NodeScanOutcome>
+    where
+        C: ConnectionLike + Connect + Clone + Send + Sync + 'static,
+    {
+        let address_epoch = core.address_epoch(address).await.unwrap_or(0);
+        let mut cursor = 0;
+        loop {
+            self.pace().await;
+            let scan_response =
+                send_scan_to_address(address, cursor, cluster_scan_args, core.clone()).await?;
+            let (new_cursor, keys) = from_redis_value::<(u64, Vec<Value>)>(&scan_response)?;
+            if !keys.is_empty() && keys_sender.send(keys).await.is_err() {
+                return Ok(NodeScanOutcome::ReceiverDropped);
+            }
+            if new_cursor == 0 {
+                break;
+            }
+            cursor = new_cursor;
+        }
+
+        // As in the sequential scan, the slots of the node count as scanned only if its epoch didn't
+        // change, otherwise some of them may have moved in during the scan.
+        ClusterConnInner::check_topology_and_refresh_if_diff(
+            core.clone(),
+            &RefreshPolicy::NotThrottable,
+        )
+        .await?;
+        if core.address_epoch(address).await.unwrap_or(0) != address_epoch {
+            return Ok(NodeScanOutcome::Completed(None));
+        }
+        let slots = core.slots_of_address(address.clone()).await;
+        Ok(NodeScanOutcome::Completed(Some(slots)))
+    }
+
+    /// Claims and scans nodes until all the slots are scanned.
+    async fn run_worker<C>(
+        &self,
+        core: &Arc<InnerCore<C>>,
+        cluster_scan_args: &ClusterScanArgs,
+        keys_sender: &mpsc::Sender<Vec<Value>>,
+    ) -> RedisResult<()>
+    where
+        C: ConnectionLike + Connect + Clone + Send + Sync + 'static,
+    {
+        let mut consecutive_failures = 0;
+        loop {
+            // Registered before claiming, so that a release between the claim and the wait isn't missed.
+            let mut released = pin!(self.released.notified());
+            released.as_mut().enable();
+            let (primary, address) =
+                match self.claim(core, cluster_scan_args.allow_non_covered_slots)? {
+                    ScanClaim::Shard { primary, address } => (primary, address),
+                    ScanClaim::Wait => {
+                        released.await;
+                        continue;
+                    }
+                    ScanClaim::Done => return Ok(()),
+                };
+
+            match self
+                .scan_address(core, &address, cluster_scan_args, keys_sender)
+                .await
+            {
+                Ok(NodeScanOutcome::Completed(scanned_slots)) => {
+                    consecutive_failures = 0;
+                    self.release(&primary, scanned_slots.as_deref().unwrap_or_default());
+                }
+                Ok(NodeScanOutcome::ReceiverDropped) => {
+                    self.stop();
+                    return Ok(());
+                }
+                Err(err)
+                    if is_scanwise_retryable_error(&err)
+                        && consecutive_failures < MAX_CONSECUTIVE_SCAN_FAILURES =>
+                {
+                    consecutive_failures += 1;
+                    // Refresh before releasing, so that the slots are claimed again on their new owner.
+                    ClusterConnInner::check_topology_and_refresh_if_diff(
+                        core.clone(),
+                        &RefreshPolicy::NotThrottable,
+                    )
+                    .await?;
+                    self.release(&primary, &[]);
+                }
+                Err(err) => return Err(err),
+            }
+        }
+    }
+}
+
+/// Scans the whole cluster, scanning up to `options.concurrency` nodes at the same time, and sends
+/// the keys found to `keys_sender` as they arrive.
+///
+/// Each worker claims the shard owning the first slot that is neither scanned nor owned by a shard
+/// claimed by another worker, and scans one of its nodes from cursor 0 until the cursor is 0 again. The slots
+/// of the node are then marked as scanned, unless its epoch changed, in which case they are
+/// claimed and scanned again from their current owner. A node whose scan fails with a retryable
+/// error is released after a topology refresh and scanned again from the start. Like `SCAN`, the
+/// scan may return a key more than once, but returns every key that exists throughout the scan.
+///
+/// The scan stops early, without an error, if the receiver of the keys is dropped.
+pub(crate) async fn parallel_cluster_scan<C>(
+    core: Arc<InnerCore<C>>,
+    cluster_scan_args: ClusterScanArgs,
+    options: ParallelScanOptions,
+    keys_sender: mpsc::Sender<Vec<Value>>,
+) -> RedisResult<()>
+where
+    C: ConnectionLike + Connect + Clone + Send + Sync + 'static,
+{
+    let scan = ParallelScan::new(&options);
+    let workers = (0..options.concurrency.max(1))
+        .map(|_| scan.run_worker(&core, &cluster_scan_args, &keys_sender));
+    future::try_join_all(workers).await?;
+    Ok(())
+}
+
 #[cfg(test)]
 mod tests {
     use super::*;
@@ -865,6 +1175,16 @@ mod tests {
         assert_eq!(scanned_slots_map[0], 1 << 5);
     }
 
+    #[tokio::test]
+    async fn test_is_slot_scanned() {
+        let mut scanned_slots_map = [0; BITS_ARRAY_SIZE as usize];
+        mark_slot_as_scanned(&mut scanned_slots_map, 100);
+
+        assert!(is_slot_scanned(&scanned_slots_map, 100));
+        assert!(!is_slot_scanned(&scanned_slots_map, 99));
+        assert!(!is_slot_scanned(&scanned_slots_map, NUM_OF_SLOTS - 1));
+    }
+
     #[tokio::test]
     async fn test_next_slot() {
         let scan_state = ScanState::new(
@@ -15,6 +15,9 @@ pub use cluster_scan::ScanStateRC;
 #[cfg(feature = "cluster-async")]
 pub use cluster_scan::ClusterScanArgs;
 
+#[cfg(feature = "cluster-async")]
+pub use cluster_scan::ParallelScanOptions;
+
 #[cfg(feature = "cluster-async")]
 pub(crate) mod cluster_scan;
 
@@ -219,6 +219,16 @@ pub type PubSubChannelOrPattern = Vec<u8>;
 /// Type for pubsub channels/patterns
 pub type PubSubSubscriptionInfo = HashMap<PubSubSubscriptionKind, HashSet<PubSubChannelOrPattern>>;
 
+/// Server-assisted client side caching options, see `CLIENT TRACKING`.
+#[derive(Clone, Debug, Default, PartialEq, Eq)]
+pub struct ClientTrackingOptions {
+    /// Whether to use broadcasting mode, in which the connection is notified about every modified key
+    /// matching `prefixes`, instead of only the keys it read.
+    pub broadcast: bool,
+    /// The key prefixes to be notified about in broadcasting mode. All keys are reported when empty.
+    pub prefixes: Vec<Vec<u8>>,
+}
+
 /// Redis specific/connection independent information used to establish a connection to redis.
 #[derive(Clone, Debug, Default)]
 pub struct RedisConnectionInfo {
@@ -234,6 +244,9 @@ pub struct RedisConnectionInfo {
     pub client_name: Option<String>,
     /// Optionally a pubsub subscriptions that should be used for connection
     pub pubsub_subscriptions: Option<PubSubSubscriptionInfo>,
+    /// Optionally server-assisted client side caching (`CLIENT TRACKING`) options, enabling it on the connection.
+    /// Requires RESP3, as invalidation messages are delivered as push messages.
+    pub client_tracking: Option<ClientTrackingOptions>,
 }
 
 impl FromStr for ConnectionInfo {
@@ -392,6 +405,7 @@ fn url_to_tcp_connection_info(url: url::Url) -> RedisResult<ConnectionInfo> {
             },
             client_name: None,
             pubsub_subscriptions: None,
+            client_tracking: None,
         },
     })
 }
@@ -425,6 +439,7 @@ fn url_to_unix_connection_info(url: url::Url) -> RedisResult<ConnectionInfo> {
             },
             client_name: None,
             pubsub_subscriptions: None,
+            client_tracking: None,
         },
     })
 }
@@ -1841,6 +1856,7 @@ mod tests {
                         protocol: ProtocolVersion::RESP2,
                         client_name: None,
                         pubsub_subscriptions: None,
+                        client_tracking: None,
                     },
                 },
             ),
@@ -343,9 +343,9 @@ pub use crate::commands::{
     Commands, ControlFlow, Direction, LposOptions, PubSubCommands, SetOptions,
 };
 pub use crate::connection::{
-    parse_redis_url, transaction, Connection, ConnectionAddr, ConnectionInfo, ConnectionLike,
-    IntoConnectionInfo, Msg, PubSub, PubSubChannelOrPattern, PubSubSubscriptionInfo,
-    PubSubSubscriptionKind, RedisConnectionInfo, TlsMode,
+    parse_redis_url, transaction, ClientTrackingOptions, Connection, ConnectionAddr,
+    ConnectionInfo, ConnectionLike, IntoConnectionInfo, Msg, PubSub, PubSubChannelOrPattern,
+    PubSubSubscriptionInfo, PubSubSubscriptionKind, RedisConnectionInfo, TlsMode,
 };
 pub use crate::parser::{parse_redis_value, Parser};
 pub use crate::pipeline::{Pipeline, PipelineRetryStrategy};
@@ -416,6 +416,9 @@ pub use crate::commands::ObjectType;
 #[cfg(feature = "cluster-async")]
 pub use crate::commands::ClusterScanArgs;
 
+#[cfg(feature = "cluster-async")]
+pub use crate::commands::ParallelScanOptions;
+
 #[cfg(feature = "cluster")]
 mod cluster_client;
 
@@ -439,6 +442,10 @@ pub mod cluster_topology;
 #[cfg(feature = "cluster-async")]
 pub mod cluster_async;
 
+/// Round trip time statistics used to route reads to the fastest node.
+#[cfg(feature = "cluster-async")]
+pub mod node_latency;
+
 #[cfg(feature = "sentinel")]
 pub mod sentinel;
 
@@ -0,0 +1,207 @@
+//! Latency tracking used to route reads to the fastest node.
+//!
+//! Each node keeps a peak-sensitive, exponentially weighted moving average (EWMA) of the round trip
+//! time of the reads sent to it, and the number of reads in flight. A slow sample raises the
+//! average at once, while fast samples lower it gradually, over [`DECAY_WINDOW`]. The average also
+//! decays while no sample arrives, so a node that was avoided because it was slow is eventually
+//! tried again.
+//!
+//! Nodes are chosen with the "power of two choices": two candidates are drawn at random and the
+//! one with the lower cost, the average multiplied by the number of reads in flight plus one, is
+//! used. This avoids sending every read to the single best node, which would then become the worst.
+
+use dashmap::DashMap;
+use rand::Rng;
+use std::sync::atomic::{AtomicU64, AtomicUsize, Ordering};
+use std::sync::Arc;
+use std::time::{Duration, Instant};
+
+/// The time over which the weight of a sample decays by a factor of e.
+pub const DECAY_WINDOW: Duration = Duration::from_secs(5);
+
+/// The round trip time statistics of a single node.
+#[derive(Debug)]
+pub struct NodeLatency {
+    created: Instant,
+    // f64 bits of the average round trip time, in microseconds. 0 until the first sample.
+    ewma_micros: AtomicU64,
+    // Microseconds since `created` at the last sample.
+    last_sample_micros: AtomicU64,
+    in_flight: AtomicUsize,
+}
+
+impl Default for NodeLatency {
+    fn default() -> Self {
+        Self {
+            created: Instant::now(),
+            ewma_micros: AtomicU64::new(0),
+            last_sample_micros: AtomicU64::new(0),
+            in_flight: AtomicUsize::new(0),
+        }
+    }
+}
+
+impl NodeLatency {
+    fn now_micros(&self) -> u64 {
+        self.created.elapsed().as_micros() as u64
+    }
+
+    fn decay(elapsed_micros: u64) -> f64 {
+        (-(elapsed_micros as f64) / DECAY_WINDOW.as_micros() as f64).exp()
+    }
+
+    /// Starts timing a read. The read counts as in flight until the returned sample is finished or
+    /// dropped.
+    pub fn start(&self) -> LatencySample<'_> {
+        self.in_flight.fetch_add(1, Ordering::Relaxed);
+        LatencySample {
+            node: self,
+            started: Instant::now(),
+        }
+    }
+
+    fn record(&self, rtt: Duration) {
+        let now = self.now_micros();
+        let last = self.last_sample_micros.swap(now, Ordering::Relaxed);
+        let rtt = rtt.as_micros() as f64;
+        let average = f64::from_bits(self.ewma_micros.load(Ordering::Relaxed));
+        let updated = if rtt > average {
+            rtt
+        } else {
+            let weight = Self::decay(now.saturating_sub(last));
+            average * weight + rtt * (1.0 - weight)
+        };
+        // Concurrent samples may overwrite each other; losing one doesn't skew the average.
+        self.ewma_micros.store(updated.to_bits(), Ordering::Relaxed);
+    }
+
+    /// The average round trip time in microseconds, decayed by the time since the last sample.
+    pub fn average_micros(&self) -> f64 {
+        let average = f64::from_bits(self.ewma_micros.load(Ordering::Relaxed));
+        if average == 0.0 {
+            return 0.0;
+        }
+        let last = self.last_sample_micros.load(Ordering::Relaxed);
+        average * Self::decay(self.now_micros().saturating_sub(last))
+    }
+
+    /// The number of reads in flight.
+    pub fn in_flight(&self) -> usize {
+        self.in_flight.load(Ordering::Relaxed)
+    }
+
+    /// The expected cost of sending one more read to the node. Nodes without samples cost only
+    /// their reads in flight, so they are tried before the others.
+    pub fn cost(&self) -> f64 {
+        let in_flight = self.in_flight() as f64;
+        let average = self.average_micros();
+        if average == 0.0 {
+            in_flight
+        } else {
+            average * (in_flight + 1.0)
+        }
+    }
+}
+
+/// A read being timed. Finish it when the node replied; a dropped sample, e.g. on an error, only
+/// stops counting the read as in flight, so that failing fast doesn't make a node look fast.
+pub struct LatencySample<'a> {
+    node: &'a NodeLatency,
+    started: Instant,
+}
+
+impl LatencySample<'_> {
+    /// Records the round trip time of the read.
+    pub fn finish(self) {
+        self.node.record(self.started.elapsed());
+    }
+}
+
+impl Drop for LatencySample<'_> {
+    fn drop(&mut self) {
+        self.node.in_flight.fetch_sub(1, Ordering::Relaxed);
+    }
+}
+
+/// The latency statistics of the nodes of a cluster, by address. Clones share the statistics, so
+/// they survive topology refreshes.
+#[derive(Debug, Default, Clone)]
+pub struct NodeLatencies(Arc<DashMap<String, Arc<NodeLatency>>>);
+
+impl PartialEq for NodeLatencies {
+    fn eq(&self, other: &Self) -> bool {
+        Arc::ptr_eq(&self.0, &other.0)
+    }
+}
+
+impl NodeLatencies {
+    /// Returns the statistics of a node, creating them on first use.
+    pub fn node(&self, address: &str) -> Arc<NodeLatency> {
+        if let Some(node) = self.0.get(address) {
+            return node.clone();
+        }
+        self.0.entry(address.to_string()).or_default().clone()
+    }
+
+    /// The cost of sending one more read to a node; 0 for nodes without statistics.
+    pub fn cost(&self, address: &str) -> f64 {
+        self.0.get(address).map_or(0.0, |node| node.cost())
+    }
+}
+
+/// Draws two distinct indices below `count` for a power of two choices. Both are 0 if `count` is 1.
+pub fn pick_two(count: usize) -> (usize, usize) {
+    if count < 2 {
+        return (0, 0);
+    }
+    let mut rng = rand::rng();
+    let first = rng.random_range(0..count);
+    // Draw from the other count - 1 indices, skipping over the first.
+    let second = (first + 1 + rng.random_range(0..count - 1)) % count;
+    (first, second)
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn test_slow_sample_raises_average_at_once() {
+        let node = NodeLatency::default();
+        node.record(Duration::from_micros(100));
+        node.record(Duration::from_micros(10_000));
+        assert!(node.average_micros() > 9_000.0);
+    }
+
+    #[test]
+    fn test_fast_samples_lower_average_gradually() {
+        let node = NodeLatency::default();
+        node.record(Duration::from_micros(10_000));
+        node.record(Duration::from_micros(100));
+        let average = node.average_micros();
+        assert!(average > 100.0 && average <= 10_000.0);
+    }
+
+    #[test]
+    fn test_in_flight_reads_raise_cost() {
+        let node = NodeLatency::default();
+        node.record(Duration::from_micros(100));
+        let idle = node.cost();
+        let sample = node.start();
+        assert!(node.cost() > idle);
+        drop(sample);
+        assert_eq!(node.in_flight(), 0);
+    }
+
+    #[test]
+    fn test_pick_two_is_distinct() {
+        for count in 2..10 {
+            for _ in 0..100 {
+                let (first, second) = pick_two(count);
+                assert_ne!(first, second);
+                assert!(first < count && second < count);
+            }
+        }
+        assert_eq!(pick_two(1), (0, 0));
+    }
+}
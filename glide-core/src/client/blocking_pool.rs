@@ -0,0 +1,402 @@
+// Copyright Valkey GLIDE Project Contributors - SPDX Identifier: Apache-2.0
+
+use super::types::{AuthenticationInfo, ConnectionRequest};
+use super::{ClientWrapper, connect_client};
+use logger_core::log_warn;
+use redis::cluster_routing::Routable;
+use redis::{Arg, Cmd, Pipeline, RedisResult, Value};
+use std::sync::atomic::{AtomicUsize, Ordering};
+use std::sync::{Arc, Mutex};
+
+/// Sends blocking commands, such as BLPOP or XREAD BLOCK, over dedicated connections.
+///
+/// A blocking command holds its connection until it returns, delaying every command queued after
+/// it on the same connection. The pool lends each blocking command a client of its own, with one
+/// connection per node, so that the shared connections keep serving the other commands. Clients
+/// are created on demand, up to `limit`, and reused once their command returned. When all of them
+/// are busy, or a new one fails to connect, the command is sent over the shared connections.
+///
+/// The pooled clients follow the connection state set on the shared connections: after SELECT,
+/// CLIENT SETNAME, AUTH, HELLO or a password update, the configuration of new clients is updated
+/// and the clients connected with the previous one are closed instead of being reused. When the
+/// new state can't be told, e.g. after a batch holding SELECT failed, the pool is disabled for
+/// good and every command uses the shared connections.
+pub(crate) struct BlockingPool {
+    limit: usize,
+    state: Mutex<PoolState>,
+    // Clients created and not dropped, idle or lent, plus the ones being connected.
+    open: AtomicUsize,
+}
+
+struct PoolState {
+    config: ConnectionRequest,
+    // Incremented whenever `config` changes. Clients connected with an older one aren't reused.
+    generation: u64,
+    idle: Vec<ClientWrapper>,
+    // Set once the state of the shared connections is unknown: no client is lent anymore.
+    disabled: bool,
+}
+
+impl BlockingPool {
+    pub(crate) fn new(mut config: ConnectionRequest, limit: u32) -> Self {
+        // The pooled clients only send blocking commands: no subscriptions nor invalidations.
+        config.lazy_connect = false;
+        config.pubsub_subscriptions = None;
+        config.client_tracking = None;
+        config.connections_per_node = None;
+        BlockingPool {
+            limit: limit as usize,
+            state: Mutex::new(PoolState {
+                config,
+                generation: 0,
+                idle: Vec::new(),
+                disabled: false,
+            }),
+            open: AtomicUsize::new(0),
+        }
+    }
+
+    /// Applies the connection state set by `cmd`, which succeeded on the shared connections.
+    pub(crate) fn track_state_change(&self, cmd: &Cmd) {
+        let Some(command) = Routable::command(cmd) else {
+            return;
+        };
+        if !is_state_change(&command) {
+            return;
+        }
+        let args: Vec<Option<String>> = cmd
+            .args_iter()
+            .map(|arg| match arg {
+                Arg::Simple(arg) => String::from_utf8(arg.to_vec()).ok(),
+                Arg::Cursor => None,
+            })
+            .collect();
+        let arg = |index: usize| args.get(index).cloned().flatten();
+
+        match command.as_slice() {
+            b"SELECT" => match arg(1).and_then(|database_id| database_id.parse().ok()) {
+                Some(database_id) => self.update_config(|config| config.database_id = database_id),
+                None => self.disable(),
+            },
+            b"CLIENT SETNAME" => match arg(2) {
+                Some(name) => self.update_config(|config| config.client_name = Some(name)),
+                None => self.disable(),
+            },
+            // AUTH [username] password
+            b"AUTH" => {
+                let (username, password) = match args.len() {
+                    2 => (None, arg(1)),
+                    3 => (arg(1), arg(2)),
+                    _ => return,
+                };
+                if password.is_none() || (args.len() == 3 && username.is_none()) {
+                    return self.disable();
+                }
+                self.update_config(|config| {
+                    config.authentication_info = Some(AuthenticationInfo { username, password })
+                });
+            }
+            // HELLO [protover [AUTH username password] [SETNAME clientname]]
+            b"HELLO" => {
+                let mut authentication_info = None;
+                let mut client_name = None;
+                let mut index = 2;
+                while index < args.len() {
+                    let option = arg(index).unwrap_or_default().to_ascii_uppercase();
+                    if option == "AUTH" && index + 2 < args.len() {
+                        let (Some(username), Some(password)) = (arg(index + 1), arg(index + 2))
+                        else {
+                            return self.disable();
+                        };
+                        authentication_info = Some(AuthenticationInfo {
+                            username: Some(username),
+                            password: Some(password),
+                        });
+                        index += 3;
+                    } else if option == "SETNAME" && index + 1 < args.len() {
+                        let Some(name) = arg(index + 1) else {
+                            return self.disable();
+                        };
+                        client_name = Some(name);
+                        index += 2;
+                    } else {
+                        index += 1;
+                    }
+                }
+                if authentication_info.is_some() || client_name.is_some() {
+                    self.update_config(|config| {
+                        if authentication_info.is_some() {
+                            config.authentication_info = authentication_info;
+                        }
+                        if client_name.is_some() {
+                            config.client_name = client_name;
+                        }
+                    });
+                }
+            }
+            _ => {}
+        }
+    }
+
+    /// Applies the connection state set by the commands of a batch sent over the shared
+    /// connections. The state set by a command is applied if its own reply isn't an error. If
+    /// that can't be told, because the whole batch failed or a transaction was aborted, the pool
+    /// is disabled, as the command may or may not have run.
+    pub(crate) fn track_batch_state_changes(
+        &self,
+        pipeline: &Pipeline,
+        result: &RedisResult<Value>,
+    ) {
+        for (index, cmd) in pipeline.cmd_iter().enumerate() {
+            if !Routable::command(cmd).is_some_and(|command| is_state_change(&command)) {
+                continue;
+            }
+            match result {
+                Ok(Value::Array(values)) => match values.get(index) {
+                    Some(Value::ServerError(_)) => {}
+                    Some(_) => self.track_state_change(cmd),
+                    None => self.disable(),
+                },
+                _ => self.disable(),
+            }
+        }
+    }
+
+    /// Applies a password update that succeeded on the shared connections.
+    pub(crate) fn update_password(&self, password: Option<String>) {
+        self.update_config(|config| {
+            config
+                .authentication_info
+                .get_or_insert_with(AuthenticationInfo::default)
+                .password = password
+        });
+    }
+
+    /// Stops lending clients, and closes the idle ones.
+    fn disable(&self) {
+        self.update_state(|state| state.disabled = true);
+    }
+
+    fn update_config(&self, update: impl FnOnce(&mut ConnectionRequest)) {
+        self.update_state(|state| update(&mut state.config));
+    }
+
+    fn update_state(&self, update: impl FnOnce(&mut PoolState)) {
+        let outdated = {
+            let mut state = self.state.lock().unwrap();
+            update(&mut *state);
+            state.generation += 1;
+            std::mem::take(&mut state.idle)
+        };
+        self.open.fetch_sub(outdated.len(), Ordering::Relaxed);
+    }
+
+    /// Lends a dedicated client, connecting a new one if none is idle and the limit allows it.
+    /// Returns None if the command should use the shared connections.
+    pub(crate) async fn checkout(self: &Arc<Self>) -> Option<PooledClient> {
+        let (idle, config, generation) = {
+            let mut state = self.state.lock().unwrap();
+            if state.disabled {
+                return None;
+            }
+            match state.idle.pop() {
+                Some(client) => (Some(client), None, state.generation),
+                None => (None, Some(state.config.clone()), state.generation),
+            }
+        };
+        if let Some(client) = idle {
+            return Some(PooledClient {
+                pool: self.clone(),
+                client: Some(client),
+                generation,
+                reusable: false,
+            });
+        }
+        if self
+            .open
+            .fetch_update(Ordering::Relaxed, Ordering::Relaxed, |open| {
+                (open < self.limit).then_some(open + 1)
+            })
+            .is_err()
+        {
+            return None;
+        }
+        let mut pooled = PooledClient {
+            pool: self.clone(),
+            client: None,
+            generation,
+            reusable: false,
+        };
+        // If the command times out while connecting, dropping `pooled` releases the slot.
+        let config = config.expect("The configuration is cloned when no client is idle");
+        match connect_client(config, None).await {
+            Ok(client) => {
+                pooled.client = Some(client);
+                Some(pooled)
+            }
+            Err(err) => {
+                log_warn(
+                    "blocking pool",
+                    format!("Failed to connect a dedicated client, using the shared one: {err}"),
+                );
+                None
+            }
+        }
+    }
+}
+
+/// Whether a command changes the connection state that the pooled clients follow.
+fn is_state_change(command: &[u8]) -> bool {
+    matches!(command, b"SELECT" | b"CLIENT SETNAME" | b"AUTH" | b"HELLO")
+}
+
+/// A client lent by [`BlockingPool`]. It goes back to the pool when dropped, unless its command
+/// didn't complete: a command abandoned on timeout may still block the server side of the
+/// connection, so the client is closed instead.
+pub(crate) struct PooledClient {
+    pool: Arc<BlockingPool>,
+    client: Option<ClientWrapper>,
+    // The configuration generation the client was connected with.
+    generation: u64,
+    reusable: bool,
+}
+
+impl PooledClient {
+    pub(crate) fn client(&self) -> &ClientWrapper {
+        self.client
+            .as_ref()
+            .expect("A lent client is always connected")
+    }
+
+    /// Records the result of the command sent with the client.
+    pub(crate) fn finish<T>(&mut self, result: &RedisResult<T>) {
+        self.reusable = match result {
+            Ok(_) => true,
+            Err(err) => !err.is_io_error() && !err.is_timeout(),
+        };
+    }
+}
+
+impl Drop for PooledClient {
+    fn drop(&mut self) {
+        if let Some(client) = self.client.take().filter(|_| self.reusable) {
+            let mut state = self.pool.state.lock().unwrap();
+            if state.generation == self.generation {
+                state.idle.push(client);
+                return;
+            }
+        }
+        self.pool.open.fetch_sub(1, Ordering::Relaxed);
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[tokio::test]
+    async fn test_no_client_lent_past_the_limit() {
+        let pool = Arc::new(BlockingPool::new(ConnectionRequest::default(), 0));
+        assert!(pool.checkout().await.is_none());
+        assert_eq!(pool.open.load(Ordering::Relaxed), 0);
+    }
+
+    #[tokio::test]
+    async fn test_failed_connection_releases_its_slot() {
+        // No address to connect to.
+        let pool = Arc::new(BlockingPool::new(ConnectionRequest::default(), 1));
+        assert!(pool.checkout().await.is_none());
+        assert_eq!(pool.open.load(Ordering::Relaxed), 0);
+    }
+
+    #[test]
+    fn test_state_commands_update_the_configuration() {
+        let pool = BlockingPool::new(ConnectionRequest::default(), 1);
+        pool.track_state_change(redis::cmd("SELECT").arg(3));
+        pool.track_state_change(redis::cmd("CLIENT").arg("SETNAME").arg("worker"));
+        pool.track_state_change(redis::cmd("GET").arg("key"));
+        pool.update_password(Some("secret".to_string()));
+
+        let state = pool.state.lock().unwrap();
+        assert_eq!(state.config.database_id, 3);
+        assert_eq!(state.config.client_name.as_deref(), Some("worker"));
+        assert_eq!(
+            state.config.authentication_info,
+            Some(AuthenticationInfo {
+                username: None,
+                password: Some("secret".to_string()),
+            })
+        );
+        assert_eq!(state.generation, 3);
+    }
+
+    #[test]
+    fn test_auth_and_hello_update_the_configuration() {
+        let pool = BlockingPool::new(ConnectionRequest::default(), 1);
+        pool.track_state_change(redis::cmd("AUTH").arg("first"));
+        assert_eq!(
+            pool.state.lock().unwrap().config.authentication_info,
+            Some(AuthenticationInfo {
+                username: None,
+                password: Some("first".to_string()),
+            })
+        );
+
+        pool.track_state_change(
+            redis::cmd("HELLO")
+                .arg(3)
+                .arg("AUTH")
+                .arg("user")
+                .arg("second")
+                .arg("SETNAME")
+                .arg("worker"),
+        );
+        let state = pool.state.lock().unwrap();
+        assert_eq!(
+            state.config.authentication_info,
+            Some(AuthenticationInfo {
+                username: Some("user".to_string()),
+                password: Some("second".to_string()),
+            })
+        );
+        assert_eq!(state.config.client_name.as_deref(), Some("worker"));
+        assert_eq!(state.generation, 2);
+    }
+
+    #[test]
+    fn test_batch_state_changes() {
+        let pool = BlockingPool::new(ConnectionRequest::default(), 1);
+        let mut pipeline = Pipeline::new();
+        pipeline
+            .cmd("GET")
+            .arg("key")
+            .cmd("SELECT")
+            .arg(3)
+            .cmd("GET")
+            .arg("key");
+
+        let values = vec![Value::Nil, Value::Okay, Value::Nil];
+        pool.track_batch_state_changes(&pipeline, &Ok(Value::Array(values)));
+        {
+            let state = pool.state.lock().unwrap();
+            assert_eq!(state.config.database_id, 3);
+            assert!(!state.disabled);
+        }
+
+        // An aborted transaction doesn't tell whether the SELECT ran.
+        pool.track_batch_state_changes(&pipeline, &Ok(Value::Nil));
+        assert!(pool.state.lock().unwrap().disabled);
+    }
+
+    #[tokio::test]
+    async fn test_disabled_pool_lends_no_client() {
+        let pool = Arc::new(BlockingPool::new(ConnectionRequest::default(), 1));
+        pool.track_batch_state_changes(
+            redis::pipe().cmd("AUTH").arg("secret"),
+            &Err(redis::RedisError::from(std::io::Error::from(
+                std::io::ErrorKind::TimedOut,
+            ))),
+        );
+        assert!(pool.checkout().await.is_none());
+    }
+}
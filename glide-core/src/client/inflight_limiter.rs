@@ -0,0 +1,212 @@
+// Copyright Valkey GLIDE Project Contributors - SPDX Identifier: Apache-2.0
+
+use std::pin::pin;
+use std::sync::atomic::{AtomicIsize, AtomicUsize, Ordering, fence};
+use std::thread;
+use std::time::Duration;
+use tokio::sync::Notify;
+use tokio::time::Instant;
+
+/// Upper bound on the number of shards, whatever the number of cores.
+const MAX_SHARDS: usize = 64;
+/// Upper bound on the number of permits a shard takes from the shared pool at once.
+const MAX_BATCH: isize = 32;
+
+/// A pool of permits, aligned so that no two pools share a cache line.
+#[repr(align(128))]
+#[derive(Default)]
+struct Permits(AtomicIsize);
+
+impl Permits {
+    /// Takes up to `max` permits, returning how many were taken.
+    fn take(&self, max: isize) -> isize {
+        let mut available = self.0.load(Ordering::Relaxed);
+        loop {
+            if available <= 0 {
+                return 0;
+            }
+            let taken = available.min(max);
+            match self.0.compare_exchange_weak(
+                available,
+                available - taken,
+                Ordering::Relaxed,
+                Ordering::Relaxed,
+            ) {
+                Ok(_) => return taken,
+                Err(actual) => available = actual,
+            }
+        }
+    }
+
+    fn give(&self, permits: isize) {
+        self.0.fetch_add(permits, Ordering::Relaxed);
+    }
+}
+
+static NEXT_SHARD_HINT: AtomicUsize = AtomicUsize::new(0);
+
+thread_local! {
+    // Spreads threads over the shards in the order they first reserve a request.
+    static SHARD_HINT: usize = NEXT_SHARD_HINT.fetch_add(1, Ordering::Relaxed);
+}
+
+/// Limits the number of requests in flight.
+///
+/// The permits are split between a shared pool and one pool per shard. A thread reserves from the
+/// shard it is assigned to, refills it from the shared pool in batches, and only takes permits
+/// cached by other shards once the shared pool is empty, so while permits are plentiful threads
+/// never write to a common cache line. Released permits go back to the releasing thread's shard,
+/// and a shard holding more than two batches returns one to the shared pool.
+///
+/// A reservation fails only when no pool holds a permit. Under concurrent reservations a permit in
+/// transit between pools can be missed, so a reservation may fail slightly before the limit is
+/// reached, never after.
+pub(crate) struct InflightLimiter {
+    shards: Box<[Permits]>,
+    shared: Permits,
+    batch: isize,
+    // When set, reservations wait for a released permit instead of failing right away.
+    wait: bool,
+    waiters: AtomicUsize,
+    released: Notify,
+}
+
+impl InflightLimiter {
+    pub(crate) fn new(limit: u32, wait: bool) -> Self {
+        let shard_count = thread::available_parallelism()
+            .map_or(1, |cores| cores.get())
+            .min(MAX_SHARDS)
+            .next_power_of_two();
+        let limit = limit as isize;
+        // Keep batches small relative to the limit, so that shards don't hoard the permits.
+        let batch = (limit / (shard_count as isize * 4)).clamp(1, MAX_BATCH);
+        InflightLimiter {
+            shards: (0..shard_count).map(|_| Permits::default()).collect(),
+            shared: Permits(AtomicIsize::new(limit)),
+            batch,
+            wait,
+            waiters: AtomicUsize::new(0),
+            released: Notify::new(),
+        }
+    }
+
+    fn home_shard(&self) -> &Permits {
+        let hint = SHARD_HINT.with(|hint| *hint);
+        &self.shards[hint & (self.shards.len() - 1)]
+    }
+
+    /// Reserves a permit without waiting. Returns false if none is available.
+    pub(crate) fn try_reserve(&self) -> bool {
+        let home = self.home_shard();
+        if home.take(1) == 1 {
+            return true;
+        }
+        let taken = self.shared.take(self.batch);
+        if taken > 0 {
+            if taken > 1 {
+                home.give(taken - 1);
+            }
+            return true;
+        }
+        self.shards.iter().any(|shard| shard.take(1) == 1)
+    }
+
+    /// Reserves a permit. If none is available and the limiter was created in waiting mode, waits
+    /// up to `timeout` for one to be released. Returns false if no permit was reserved.
+    pub(crate) async fn reserve(&self, timeout: Duration) -> bool {
+        if self.try_reserve() {
+            return true;
+        }
+        if !self.wait {
+            return false;
+        }
+
+        let deadline = Instant::now() + timeout;
+        self.waiters.fetch_add(1, Ordering::SeqCst);
+        // Pairs with the fence in `release`: either the releaser sees this waiter and notifies it,
+        // or the reservation below sees the released permit.
+        fence(Ordering::SeqCst);
+        let reserved = loop {
+            let mut notified = pin!(self.released.notified());
+            notified.as_mut().enable();
+            if self.try_reserve() {
+                break true;
+            }
+            if tokio::time::timeout_at(deadline, notified).await.is_err() {
+                break false;
+            }
+        };
+        self.waiters.fetch_sub(1, Ordering::SeqCst);
+        reserved
+    }
+
+    /// Returns a permit reserved by `try_reserve` or `reserve`.
+    pub(crate) fn release(&self) {
+        let home = self.home_shard();
+        home.give(1);
+        if self.wait {
+            fence(Ordering::SeqCst);
+            if self.waiters.load(Ordering::Relaxed) > 0 {
+                self.released.notify_one();
+                return;
+            }
+        }
+        if home.0.load(Ordering::Relaxed) > 2 * self.batch {
+            let surplus = home.take(self.batch);
+            if surplus > 0 {
+                self.shared.give(surplus);
+            }
+        }
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn test_reserves_exactly_the_limit() {
+        let limiter = InflightLimiter::new(10, false);
+        for _ in 0..10 {
+            assert!(limiter.try_reserve());
+        }
+        assert!(!limiter.try_reserve());
+        limiter.release();
+        assert!(limiter.try_reserve());
+        assert!(!limiter.try_reserve());
+    }
+
+    #[test]
+    fn test_releases_from_other_threads_are_reusable() {
+        let limiter = std::sync::Arc::new(InflightLimiter::new(100, false));
+        for _ in 0..100 {
+            assert!(limiter.try_reserve());
+        }
+        let releaser = limiter.clone();
+        thread::spawn(move || {
+            for _ in 0..100 {
+                releaser.release();
+            }
+        })
+        .join()
+        .unwrap();
+        for _ in 0..100 {
+            assert!(limiter.try_reserve());
+        }
+        assert!(!limiter.try_reserve());
+    }
+
+    #[tokio::test]
+    async fn test_waiting_reservation_gets_released_permit() {
+        let limiter = std::sync::Arc::new(InflightLimiter::new(1, true));
+        assert!(limiter.reserve(Duration::from_millis(10)).await);
+        assert!(!limiter.reserve(Duration::from_millis(10)).await);
+
+        let releaser = limiter.clone();
+        tokio::spawn(async move {
+            tokio::time::sleep(Duration::from_millis(10)).await;
+            releaser.release();
+        });
+        assert!(limiter.reserve(Duration::from_secs(5)).await);
+    }
+}
@@ -3,37 +3,43 @@
 mod types;
 
 use crate::cluster_scan_container::insert_cluster_scan_cursor;
-use crate::scripts_container::get_script;
+use crate::scripts_container::{Script, get_script, next_loader_bit};
 use futures::FutureExt;
 use logger_core::{log_error, log_info, log_warn};
 use once_cell::sync::OnceCell;
-use redis::aio::ConnectionLike;
 use redis::cluster_async::ClusterConnection;
 use redis::cluster_routing::{
-    MultipleNodeRoutingInfo, ResponsePolicy, Routable, RoutingInfo, SingleNodeRoutingInfo,
+    MultipleNodeRoutingInfo, ResponsePolicy, Routable, RoutingInfo, SingleNodeRoutingInfo, SlotAddr,
 };
 use redis::cluster_slotmap::ReadFromReplicaStrategy;
 use redis::{
-    ClusterScanArgs, Cmd, ErrorKind, FromRedisValue, PipelineRetryStrategy, PushInfo, RedisError,
-    RedisResult, RetryStrategy, ScanStateRC, Value,
+    ClusterScanArgs, Cmd, ErrorKind, FromRedisValue, ParallelScanOptions, PipelineRetryStrategy,
+    PushInfo, RedisError, RedisResult, RetryStrategy, ScanStateRC, Value,
 };
 pub use standalone_client::StandaloneClient;
 use std::io;
 use std::sync::Arc;
-use std::sync::atomic::{AtomicIsize, Ordering};
 use std::thread;
 use std::thread::JoinHandle;
 use std::time::Duration;
 use tokio::runtime::{Builder, Handle};
 pub use types::*;
 
+use self::blocking_pool::BlockingPool;
+use self::inflight_limiter::InflightLimiter;
+use self::read_hedging::ReadHedging;
+use self::value_codec::ValueCodec;
 use self::value_conversion::{convert_to_expected_type, expected_type_for_cmd, get_value_type};
+mod blocking_pool;
+mod inflight_limiter;
+mod read_hedging;
 mod reconnecting_connection;
 mod standalone_client;
+mod value_codec;
 mod value_conversion;
 use redis::InfoDict;
 use telemetrylib::GlideOpenTelemetry;
-use tokio::sync::{Notify, RwLock, mpsc, oneshot};
+use tokio::sync::{Notify, OnceCell as AsyncOnceCell, mpsc, oneshot};
 use versions::Versioning;
 
 pub const HEARTBEAT_SLEEP_DURATION: Duration = Duration::from_secs(1);
@@ -139,6 +145,7 @@ pub(super) fn get_redis_connection_info(
     let db = connection_request.database_id;
     let client_name = connection_request.client_name.clone();
     let pubsub_subscriptions = connection_request.pubsub_subscriptions.clone();
+    let client_tracking = connection_request.client_tracking.clone();
     match &connection_request.authentication_info {
         Some(info) => redis::RedisConnectionInfo {
             db,
@@ -147,12 +154,14 @@ pub(super) fn get_redis_connection_info(
             protocol,
             client_name,
             pubsub_subscriptions,
+            client_tracking,
         },
         None => redis::RedisConnectionInfo {
             db,
             protocol,
             client_name,
             pubsub_subscriptions,
+            client_tracking,
             ..Default::default()
         },
     }
@@ -183,22 +192,64 @@ pub(super) fn get_connection_info(
 pub enum ClientWrapper {
     Standalone(StandaloneClient),
     Cluster { client: ClusterConnection },
-    Lazy(Box<LazyClient>),
 }
 
-/// A client wrapper that defers connection until the first command is executed.
-#[derive(Clone)]
+/// The configuration of a client that defers connection until the first command is executed.
 pub struct LazyClient {
     config: ConnectionRequest,
     push_sender: Option<mpsc::UnboundedSender<PushInfo>>,
 }
 
+impl LazyClient {
+    async fn connect(&self) -> RedisResult<ClientWrapper> {
+        let mut config = self.config.clone();
+
+        // When initializing the actual connection from a lazy client,
+        // the underlying connection attempt itself should not be lazy.
+        config.lazy_connect = false;
+        connect_client(config, self.push_sender.clone()).await
+    }
+}
+
+/// Creates the appropriate client based on configuration.
+async fn connect_client(
+    config: ConnectionRequest,
+    push_sender: Option<mpsc::UnboundedSender<PushInfo>>,
+) -> RedisResult<ClientWrapper> {
+    if config.cluster_mode_enabled {
+        let client = create_cluster_client(config, push_sender).await?;
+        Ok(ClientWrapper::Cluster { client })
+    } else {
+        let client = StandaloneClient::create_client(config, push_sender)
+            .await
+            .map_err(|e| {
+                RedisError::from((
+                    ErrorKind::IoError,
+                    "Standalone connect failed",
+                    format!("{e:?}"),
+                ))
+            })?;
+        Ok(ClientWrapper::Standalone(client))
+    }
+}
+
 #[derive(Clone)]
 pub struct Client {
-    internal_client: Arc<RwLock<ClientWrapper>>,
+    // Set once, either on creation or by the first command of a lazy client. Once set, reading it
+    // is a single atomic load, so commands neither lock nor clone the underlying client.
+    internal_client: Arc<AsyncOnceCell<ClientWrapper>>,
+    lazy_client: Option<Arc<LazyClient>>,
     request_timeout: Duration,
-    // Setting this counter to limit the inflight requests, in case of any queue is blocked, so we return error to the customer.
-    inflight_requests_allowed: Arc<AtomicIsize>,
+    // Limits the inflight requests, in case of any queue is blocked, so we return error to the customer.
+    inflight_requests: Arc<InflightLimiter>,
+    // Set when reads are hedged, and the read strategy has more than one node to read from.
+    read_hedging: Option<Arc<ReadHedging>>,
+    // Set when blocking commands are sent over dedicated connections.
+    blocking_pool: Option<Arc<BlockingPool>>,
+    // Set when the values of the SET and GET commands are compressed.
+    value_codec: Option<ValueCodec>,
+    // Marks the scripts this client loaded on its nodes, see `Script::is_loaded`.
+    script_loader_bit: u64,
 }
 
 async fn run_with_timeout<T>(
@@ -312,8 +363,7 @@ fn get_request_timeout(cmd: &Cmd, default_timeout: Duration) -> RedisResult<Opti
             get_timeout_from_cmd_arg(cmd, cmd.args_iter().len() - 1, TimeUnit::Seconds)
         }
         b"BLMPOP" | b"BZMPOP" => get_timeout_from_cmd_arg(cmd, 1, TimeUnit::Seconds),
-        b"XREAD" | b"XREADGROUP" => cmd
-            .position(b"BLOCK")
+        b"XREAD" | b"XREADGROUP" => stream_block_position(cmd)
             .map(|idx| get_timeout_from_cmd_arg(cmd, idx + 1, TimeUnit::Milliseconds))
             .unwrap_or(Ok(RequestTimeoutOption::ClientConfig)),
         b"WAIT" => get_timeout_from_cmd_arg(cmd, 2, TimeUnit::Milliseconds),
@@ -329,49 +379,71 @@ fn get_request_timeout(cmd: &Cmd, default_timeout: Duration) -> RedisResult<Opti
     }
 }
 
-impl Client {
-    async fn get_or_initialize_client(&self) -> RedisResult<ClientWrapper> {
-        {
-            let guard = self.internal_client.read().await;
-            if !matches!(&*guard, ClientWrapper::Lazy(_)) {
-                return Ok(guard.clone()); // ✅ Already initialized, return clone
-            }
+/// The position of the BLOCK option of XREAD or XREADGROUP, if it is set. Only the options before
+/// STREAMS are looked at, so that a key, a group or a consumer named "block" isn't taken for it.
+fn stream_block_position(cmd: &Cmd) -> Option<usize> {
+    if !matches!(cmd.command()?.as_slice(), b"XREAD" | b"XREADGROUP") {
+        return None;
+    }
+    let mut index = 1;
+    while let Some(arg) = cmd.arg_idx(index) {
+        match arg.to_ascii_uppercase().as_slice() {
+            b"BLOCK" => return Some(index),
+            b"STREAMS" => return None,
+            // GROUP group consumer
+            b"GROUP" => index += 3,
+            b"COUNT" => index += 2,
+            _ => index += 1,
         }
+    }
+    None
+}
 
-        let mut guard = self.internal_client.write().await;
-
-        if let ClientWrapper::Lazy(lazy_client) = &mut *guard {
-            let mut config = lazy_client.config.clone();
-            let push_sender = lazy_client.push_sender.clone();
+/// Whether a command blocks its connection until it returns. WAIT isn't included, since it waits for
+/// the writes sent earlier on the same connection.
+fn is_blocking_command(cmd: &Cmd) -> bool {
+    match cmd.command().unwrap_or_default().as_slice() {
+        b"BLPOP" | b"BRPOP" | b"BLMOVE" | b"BZPOPMAX" | b"BZPOPMIN" | b"BRPOPLPUSH" | b"BLMPOP"
+        | b"BZMPOP" => true,
+        b"XREAD" | b"XREADGROUP" => stream_block_position(cmd).is_some(),
+        _ => false,
+    }
+}
 
-            // When initializing the actual connection from a lazy client,
-            // the underlying connection attempt itself should not be lazy.
-            config.lazy_connect = false;
+/// Whether a command is a single node read that can be sent twice: hedged reads must not block,
+/// since a blocking read is slow by design.
+fn is_hedgeable_read(cmd: &Cmd) -> bool {
+    let command = cmd.command().unwrap_or_default();
+    redis::cluster_routing::is_readonly_cmd(&command)
+        && !RoutingInfo::is_all_nodes(&command)
+        && stream_block_position(cmd).is_none()
+}
 
-            // Create the appropriate client based on configuration
-            let real_client = if config.cluster_mode_enabled {
-                // Create cluster client
-                let client = create_cluster_client(config, push_sender).await?;
-                ClientWrapper::Cluster { client }
-            } else {
-                // Create standalone client
-                let client = StandaloneClient::create_client(config, push_sender)
-                    .await
-                    .map_err(|e| {
-                        RedisError::from((
-                            ErrorKind::IoError,
-                            "Standalone connect failed",
-                            format!("{e:?}"),
-                        ))
-                    })?;
-                ClientWrapper::Standalone(client)
-            };
+/// Whether a cluster read may be served by more than one node of the slot.
+fn is_hedgeable_route(routing: &RoutingInfo) -> bool {
+    match routing {
+        RoutingInfo::SingleNode(SingleNodeRoutingInfo::Random) => true,
+        RoutingInfo::SingleNode(SingleNodeRoutingInfo::SpecificNode(route)) => {
+            route.slot_addr() != SlotAddr::Master
+        }
+        _ => false,
+    }
+}
 
-            // Replace the lazy client with the real client
-            *guard = real_client;
+impl Client {
+    async fn get_or_initialize_client(&self) -> RedisResult<&ClientWrapper> {
+        if let Some(client) = self.internal_client.get() {
+            return Ok(client);
         }
+        let Some(lazy_client) = &self.lazy_client else {
+            unreachable!("Only lazy clients are created without an underlying client")
+        };
 
-        Ok(guard.clone()) // ✅ Return clone of the now-initialized wrapper
+        // Concurrent first commands wait for a single connection attempt. A failed attempt leaves
+        // the cell empty, so the next command tries again.
+        self.internal_client
+            .get_or_try_init(|| lazy_client.connect())
+            .await
     }
 
     /// Send a command to the server.
@@ -380,9 +452,36 @@ impl Client {
         &'a mut self,
         cmd: &'a Cmd,
         routing: Option<RoutingInfo>,
+    ) -> redis::RedisFuture<'a, Value> {
+        self.send_command_with_codec(cmd, routing, true)
+    }
+
+    /// Send a command with its values as they are, and return its reply as it is, even if the
+    /// client compresses values.
+    pub fn send_command_uncompressed<'a>(
+        &'a mut self,
+        cmd: &'a Cmd,
+        routing: Option<RoutingInfo>,
+    ) -> redis::RedisFuture<'a, Value> {
+        self.send_command_with_codec(cmd, routing, false)
+    }
+
+    fn send_command_with_codec<'a>(
+        &'a mut self,
+        cmd: &'a Cmd,
+        routing: Option<RoutingInfo>,
+        use_value_codec: bool,
     ) -> redis::RedisFuture<'a, Value> {
         Box::pin(async move {
+            let value_codec = self.value_codec.filter(|_| use_value_codec);
+            let encoded = value_codec.and_then(|value_codec| value_codec.encode(cmd));
+            let cmd = encoded.as_ref().unwrap_or(cmd);
+
             let client = self.get_or_initialize_client().await?;
+            let read_hedging = self
+                .read_hedging
+                .as_deref()
+                .filter(|_| is_hedgeable_read(cmd));
 
             let expected_type = expected_type_for_cmd(cmd);
             let request_timeout = match get_request_timeout(cmd, self.request_timeout) {
@@ -390,10 +489,30 @@ impl Client {
                 Err(err) => return Err(err),
             };
 
+            let inflight_requests = self.inflight_requests.as_ref();
+            let state_pool = self.blocking_pool.as_deref();
+            let blocking_pool = self
+                .blocking_pool
+                .as_ref()
+                .filter(|_| is_blocking_command(cmd));
+
             let value = run_with_timeout(request_timeout, async move {
-                match client {
-                    ClientWrapper::Standalone(mut client) => client.send_command(cmd).await,
-                    ClientWrapper::Cluster {mut client } => {
+                // Connecting a dedicated client counts against the command's own timeout.
+                let mut pooled = match blocking_pool {
+                    Some(blocking_pool) => blocking_pool.checkout().await,
+                    None => None,
+                };
+                let client = pooled.as_ref().map_or(client, |pooled| pooled.client());
+                let result = match client {
+                    ClientWrapper::Standalone(client) => match read_hedging {
+                        Some(read_hedging) => {
+                            read_hedging
+                                .send(inflight_requests, || client.send_command(cmd))
+                                .await
+                        }
+                        None => client.send_command(cmd).await,
+                    },
+                    ClientWrapper::Cluster { client } => {
                         let final_routing =
                             if let Some(RoutingInfo::SingleNode(SingleNodeRoutingInfo::Random)) =
                                 routing
@@ -419,11 +538,30 @@ impl Client {
                                     .or_else(|| RoutingInfo::for_routable(cmd))
                                     .unwrap_or(RoutingInfo::SingleNode(SingleNodeRoutingInfo::Random))
                             };
-                        client.route_command(cmd, final_routing).await
+                        match read_hedging {
+                            Some(read_hedging) if is_hedgeable_route(&final_routing) => {
+                                read_hedging
+                                    .send(inflight_requests, || {
+                                        client.route_command(cmd, final_routing.clone())
+                                    })
+                                    .await
+                            }
+                            _ => client.route_command(cmd, final_routing).await,
+                        }
                     },
-                    ClientWrapper::Lazy(_) => unreachable!("Lazy client should have been initialized"),
+                };
+                match (&mut pooled, state_pool) {
+                    (Some(pooled), _) => pooled.finish(&result),
+                    (None, Some(state_pool)) if result.is_ok() => {
+                        state_pool.track_state_change(cmd)
+                    }
+                    _ => {}
                 }
-                .and_then(|value| convert_to_expected_type(value, expected_type))
+                let result = match value_codec {
+                    Some(value_codec) => result.map(|value| value_codec.decode(cmd, value)),
+                    None => result,
+                };
+                result.and_then(|value| convert_to_expected_type(value, expected_type))
             })
             .await?;
 
@@ -460,7 +598,7 @@ impl Client {
             ClientWrapper::Standalone(_) => {
                 unreachable!("Cluster scan is not supported in standalone mode")
             }
-            ClientWrapper::Cluster { mut client } => {
+            ClientWrapper::Cluster { client } => {
                 let (cursor, keys) = client
                     .cluster_scan(scan_state_cursor_clone, cluster_scan_args_clone) // Use clones
                     .await?;
@@ -471,8 +609,28 @@ impl Client {
                 };
                 Ok(Value::Array(vec![cluster_cursor_id, Value::Array(keys)]))
             }
-            // Lazy case is now handled by the initial check
-            ClientWrapper::Lazy(_) => unreachable!("Lazy client should have been initialized"),
+        }
+    }
+
+    // Scans the whole cluster, several nodes at a time, streaming the keys found to `keys_sender`
+    // instead of returning them in batches to be fetched with a cursor. No request timeout applies:
+    // the scan runs until all the slots were scanned, an error occurs, or the receiver is dropped.
+    pub async fn parallel_cluster_scan(
+        &self,
+        cluster_scan_args: ClusterScanArgs,
+        options: ParallelScanOptions,
+        keys_sender: mpsc::Sender<Vec<Value>>,
+    ) -> RedisResult<()> {
+        match self.get_or_initialize_client().await? {
+            ClientWrapper::Standalone(_) => Err(RedisError::from((
+                ErrorKind::ClientError,
+                "Parallel cluster scan is not supported in standalone mode",
+            ))),
+            ClientWrapper::Cluster { client } => {
+                client
+                    .parallel_cluster_scan(cluster_scan_args, options, keys_sender)
+                    .await
+            }
         }
     }
 
@@ -570,11 +728,11 @@ impl Client {
             // which is an array containing the results of all the commands in the pipeline.
             let offset = command_count + 1;
 
-            run_with_timeout(
+            let result = run_with_timeout(
                 Some(to_duration(transaction_timeout, self.request_timeout)),
                 async move {
                     match client {
-                        ClientWrapper::Standalone(mut client) => {
+                        ClientWrapper::Standalone(client) => {
                             let values = client.send_pipeline(pipeline, offset, 1).await?;
                             Client::get_transaction_values(
                                 pipeline,
@@ -584,7 +742,7 @@ impl Client {
                                 raise_on_error,
                             )
                         }
-                        ClientWrapper::Cluster { mut client } => {
+                        ClientWrapper::Cluster { client } => {
                             let values = match routing {
                                 Some(RoutingInfo::SingleNode(route)) => {
                                     client
@@ -593,7 +751,7 @@ impl Client {
                                 }
                                 _ => {
                                     client
-                                        .req_packed_commands(pipeline, offset, 1, None)
+                                        .route_pipeline_by_keys(pipeline, offset, 1, None)
                                         .await?
                                 }
                             };
@@ -605,13 +763,14 @@ impl Client {
                                 raise_on_error,
                             )
                         }
-                        ClientWrapper::Lazy(_) => {
-                            unreachable!("Lazy client should have been initialized")
-                        }
                     }
                 },
             )
-            .await
+            .await;
+            if let Some(blocking_pool) = &self.blocking_pool {
+                blocking_pool.track_batch_state_changes(pipeline, &result);
+            }
+            result
         })
     }
 
@@ -647,15 +806,15 @@ impl Client {
                 )));
             }
 
-            run_with_timeout(
+            let result = run_with_timeout(
                 Some(to_duration(pipeline_timeout, self.request_timeout)),
                 async move {
                     let values = match client {
-                        ClientWrapper::Standalone(mut client) => {
+                        ClientWrapper::Standalone(client) => {
                             client.send_pipeline(pipeline, 0, command_count).await
                         }
 
-                        ClientWrapper::Cluster { mut client } => match routing {
+                        ClientWrapper::Cluster { client } => match routing {
                             Some(RoutingInfo::SingleNode(route)) => {
                                 client
                                     .route_pipeline(
@@ -669,7 +828,7 @@ impl Client {
                             }
                             _ => {
                                 client
-                                    .req_packed_commands(
+                                    .route_pipeline_by_keys(
                                         pipeline,
                                         0,
                                         command_count,
@@ -678,9 +837,6 @@ impl Client {
                                     .await
                             }
                         },
-                        ClientWrapper::Lazy(_) => {
-                            unreachable!("Lazy client should have been initialized")
-                        }
                     }?;
 
                     Client::convert_pipeline_values_to_expected_types(
@@ -691,7 +847,11 @@ impl Client {
                     )
                 },
             )
-            .await
+            .await;
+            if let Some(blocking_pool) = &self.blocking_pool {
+                blocking_pool.track_batch_state_changes(pipeline, &result);
+            }
+            result
         })
     }
 
@@ -704,50 +864,58 @@ impl Client {
     ) -> redis::RedisResult<Value> {
         let _ = self.get_or_initialize_client().await?;
 
-        let eval = eval_cmd(hash, keys, args);
+        let Some(script) = get_script(hash) else {
+            // Not stored in this process, so it can't be loaded, but the server may have it.
+            return self
+                .send_command(&eval_cmd(hash, keys, args), routing)
+                .await;
+        };
+        // Load the script before the first invocation, instead of waiting for a NOSCRIPT error.
+        // This is only an optimization: if the load fails, EVALSHA still reloads on NOSCRIPT.
+        if !script.is_loaded(self.script_loader_bit) {
+            if let Err(err) = self.load_script(&script).await {
+                log_warn(
+                    "invoke_script",
+                    format!("Failed to load the script before invoking it: {err}"),
+                );
+            }
+        }
+        let eval = eval_cmd(script.hash(), keys, args);
         let result = self.send_command(&eval, routing.clone()).await;
         let Err(err) = result else {
             return result;
         };
         if err.kind() == ErrorKind::NoScriptError {
-            let Some(code) = get_script(hash) else {
-                return Err(err);
-            };
-            let load = load_cmd(&code);
-            self.send_command(&load, None).await?;
+            // A node lost the script, e.g. it restarted, or it joined after the script was loaded.
+            script.clear_loaded(self.script_loader_bit);
+            self.load_script(&script).await?;
             self.send_command(&eval, routing).await
         } else {
             Err(err)
         }
     }
 
+    /// Loads a script on every node, replicas included, so that it survives failovers.
+    async fn load_script(&mut self, script: &Script) -> RedisResult<()> {
+        self.send_command(&load_cmd(script.code()), None).await?;
+        script.set_loaded(self.script_loader_bit);
+        Ok(())
+    }
+
+    /// Reserves an inflight request without waiting. Returns false if the limit was reached.
     pub fn reserve_inflight_request(&self) -> bool {
-        // We use this approach of checking the `inflight_requests_allowed` value
-        // twice, before and after decrementing, to prevent it from reaching negative
-        // values. Allowing the `inflight_requests_allowed` value to go below zero
-        // could lead to a race condition where tasks might not be able to run even
-        // when there are available slots.
-        if self.inflight_requests_allowed.load(Ordering::SeqCst) <= 0 {
-            false
-        } else {
-            // The value is being checked again because it might have changed
-            // during the intervening period since the load by other tasks.
-            if self
-                .inflight_requests_allowed
-                .fetch_sub(1, Ordering::SeqCst)
-                <= 0
-            {
-                self.inflight_requests_allowed
-                    .fetch_add(1, Ordering::SeqCst);
-                return false;
-            }
-            true
-        }
+        self.inflight_requests.try_reserve()
     }
 
-    pub fn release_inflight_request(&self) -> isize {
-        self.inflight_requests_allowed
-            .fetch_add(1, Ordering::SeqCst)
+    /// Reserves an inflight request. If the limit was reached and the client was created with
+    /// `inflight_requests_wait`, waits up to the request timeout for another request to complete.
+    /// Returns false if no request could be reserved.
+    pub async fn reserve_inflight_request_or_wait(&self) -> bool {
+        self.inflight_requests.reserve(self.request_timeout).await
+    }
+
+    pub fn release_inflight_request(&self) {
+        self.inflight_requests.release()
     }
 
     /// Update the password used to authenticate with the servers.
@@ -766,20 +934,21 @@ impl Client {
         // Since the password update operation is not a command that go through the regular command pipeline,
         // it is not have the regular timeout handling, as such we need to handle it separately.
         match tokio::time::timeout(timeout, async {
-            let mut client = self.get_or_initialize_client().await?;
-            match client {
-                ClientWrapper::Standalone(ref mut client) => {
+            match self.get_or_initialize_client().await? {
+                ClientWrapper::Standalone(client) => {
                     client.update_connection_password(password.clone()).await
                 }
-                ClientWrapper::Cluster { ref mut client } => {
+                ClientWrapper::Cluster { client } => {
                     client.update_connection_password(password.clone()).await
                 }
-                ClientWrapper::Lazy(_) => unreachable!("Lazy client should have been initialized"),
             }
         })
         .await
         {
             Ok(result) => {
+                if let (Ok(_), Some(blocking_pool)) = (&result, &self.blocking_pool) {
+                    blocking_pool.update_password(password.clone());
+                }
                 if immediate_auth {
                     self.send_immediate_auth(password).await
                 } else {
@@ -823,7 +992,7 @@ impl Client {
         let client = self.get_or_initialize_client().await?;
 
         match client {
-            ClientWrapper::Cluster { mut client } => match client.get_username().await {
+            ClientWrapper::Cluster { client } => match client.get_username().await {
                 Ok(Value::SimpleString(username)) => Ok(Some(username)),
                 Ok(Value::Nil) => Ok(None),
                 Ok(other) => Err(RedisError::from((
@@ -838,7 +1007,6 @@ impl Client {
                 ))),
             },
             ClientWrapper::Standalone(client) => Ok(client.get_username()),
-            ClientWrapper::Lazy(_) => unreachable!("Lazy client should have been initialized"),
         }
     }
 }
@@ -896,6 +1064,7 @@ async fn create_cluster_client(
             ReadFromReplicaStrategy::AZAffinityReplicasAndPrimary(az)
         }
         ReadFrom::PreferReplica => ReadFromReplicaStrategy::RoundRobin,
+        ReadFrom::LowestLatency => ReadFromReplicaStrategy::LowestLatency(Default::default()),
         ReadFrom::Primary => ReadFromReplicaStrategy::AlwaysFromPrimary,
     });
     if let Some(interval_duration) = periodic_topology_checks {
@@ -916,6 +1085,9 @@ async fn create_cluster_client(
     if let Some(pubsub_subscriptions) = redis_connection_info.pubsub_subscriptions.clone() {
         builder = builder.pubsub_subscriptions(pubsub_subscriptions);
     }
+    if let Some(client_tracking) = redis_connection_info.client_tracking.clone() {
+        builder = builder.client_tracking(client_tracking);
+    }
 
     let retry_strategy = match request.connection_retry_strategy {
         Some(strategy) => RetryStrategy::new(
@@ -1062,6 +1234,7 @@ fn sanitized_request_string(request: &ConnectionRequest) -> String {
                 match rfr {
                     ReadFrom::Primary => "Only primary",
                     ReadFrom::PreferReplica => "Prefer replica",
+                    ReadFrom::LowestLatency => "Lowest latency",
                     ReadFrom::AZAffinity(_) => "Prefer replica in user's availability zone",
                     ReadFrom::AZAffinityReplicasAndPrimary(_) =>
                         "Prefer replica and primary in user's availability zone",
@@ -1108,8 +1281,37 @@ fn sanitized_request_string(request: &ConnectionRequest) -> String {
         request.inflight_requests_limit,
     );
 
+    let inflight_requests_wait = if request.inflight_requests_wait {
+        "\nInflight requests wait"
+    } else {
+        ""
+    };
+
+    let client_tracking = request
+        .client_tracking
+        .as_ref()
+        .map(|client_tracking| format!("\nClient tracking: {client_tracking:?}"))
+        .unwrap_or_default();
+
+    let connections_per_node =
+        format_optional_value("Connections per node", request.connections_per_node);
+
+    let read_hedging_percentile =
+        format_optional_value("Read hedging percentile", request.read_hedging_percentile);
+
+    let blocking_connections_limit = format_optional_value(
+        "Blocking connections limit",
+        request.blocking_connections_limit,
+    );
+
+    let value_compression = request
+        .value_compression
+        .as_ref()
+        .map(|value_compression| format!("\nValue compression: {value_compression:?}"))
+        .unwrap_or_default();
+
     format!(
-        "\nAddresses: {addresses}{tls_mode}{cluster_mode}{request_timeout}{connection_timeout}{rfr_strategy}{connection_retry_strategy}{database_id}{protocol}{client_name}{periodic_checks}{pubsub_subscriptions}{inflight_requests_limit}",
+        "\nAddresses: {addresses}{tls_mode}{cluster_mode}{request_timeout}{connection_timeout}{rfr_strategy}{connection_retry_strategy}{database_id}{protocol}{client_name}{periodic_checks}{pubsub_subscriptions}{inflight_requests_limit}{inflight_requests_wait}{client_tracking}{connections_per_node}{read_hedging_percentile}{blocking_connections_limit}{value_compression}",
     )
 }
 
@@ -1128,33 +1330,56 @@ impl Client {
         let inflight_requests_limit = request
             .inflight_requests_limit
             .unwrap_or(DEFAULT_MAX_INFLIGHT_REQUESTS);
-        let inflight_requests_allowed = Arc::new(AtomicIsize::new(
-            inflight_requests_limit.try_into().unwrap(),
+        let inflight_requests = Arc::new(InflightLimiter::new(
+            inflight_requests_limit,
+            request.inflight_requests_wait,
         ));
+        // With a single node to read from, a hedged read would only load it twice.
+        let has_read_candidates = !matches!(request.read_from, None | Some(ReadFrom::Primary))
+            && (request.cluster_mode_enabled || request.addresses.len() > 1);
+        let read_hedging = request
+            .read_hedging_percentile
+            .filter(|_| has_read_candidates)
+            .map(|percentile| Arc::new(ReadHedging::new(percentile)));
+        let blocking_pool = request
+            .blocking_connections_limit
+            .map(|limit| Arc::new(BlockingPool::new(request.clone(), limit)));
+        let value_codec = request.value_compression.as_ref().map(ValueCodec::new);
 
         tokio::time::timeout(DEFAULT_CLIENT_CREATION_TIMEOUT, async move {
-            let internal_client = if request.lazy_connect {
-                ClientWrapper::Lazy(Box::new(LazyClient {
+            let (internal_client, lazy_client) = if request.lazy_connect {
+                let lazy_client = LazyClient {
                     config: request,
                     push_sender,
-                }))
+                };
+                (AsyncOnceCell::new(), Some(Arc::new(lazy_client)))
             } else if request.cluster_mode_enabled {
                 let client = create_cluster_client(request, push_sender)
                     .await
                     .map_err(ConnectionError::Cluster)?;
-                ClientWrapper::Cluster { client }
+                (
+                    AsyncOnceCell::new_with(Some(ClientWrapper::Cluster { client })),
+                    None,
+                )
             } else {
-                ClientWrapper::Standalone(
-                    StandaloneClient::create_client(request, push_sender)
-                        .await
-                        .map_err(ConnectionError::Standalone)?,
+                let client = StandaloneClient::create_client(request, push_sender)
+                    .await
+                    .map_err(ConnectionError::Standalone)?;
+                (
+                    AsyncOnceCell::new_with(Some(ClientWrapper::Standalone(client))),
+                    None,
                 )
             };
 
             Ok(Self {
-                internal_client: Arc::new(RwLock::new(internal_client)),
+                internal_client: Arc::new(internal_client),
+                lazy_client,
                 request_timeout,
-                inflight_requests_allowed,
+                inflight_requests,
+                read_hedging,
+                blocking_pool,
+                value_codec,
+                script_loader_bit: next_loader_bit(),
             })
         })
         .await
@@ -1200,7 +1425,28 @@ mod tests {
         BLOCKING_CMD_TIMEOUT_EXTENSION, RequestTimeoutOption, TimeUnit, get_request_timeout,
     };
 
-    use super::get_timeout_from_cmd_arg;
+    use super::{get_timeout_from_cmd_arg, stream_block_position};
+
+    #[test]
+    fn test_stream_block_position_only_looks_at_the_options() {
+        let mut cmd = Cmd::new();
+        cmd.arg("XREAD").arg("COUNT").arg(1).arg("block").arg(500);
+        cmd.arg("STREAMS").arg("key").arg("$");
+        assert_eq!(stream_block_position(&cmd), Some(3));
+
+        // A stream named BLOCK, and a group and a consumer named BLOCK.
+        let mut cmd = Cmd::new();
+        cmd.arg("XREAD").arg("STREAMS").arg("BLOCK").arg("$");
+        assert_eq!(stream_block_position(&cmd), None);
+        let mut cmd = Cmd::new();
+        cmd.arg("XREADGROUP").arg("GROUP").arg("BLOCK").arg("BLOCK");
+        cmd.arg("STREAMS").arg("key").arg(">");
+        assert_eq!(stream_block_position(&cmd), None);
+
+        let mut cmd = Cmd::new();
+        cmd.arg("GET").arg("BLOCK");
+        assert_eq!(stream_block_position(&cmd), None);
+    }
 
     #[test]
     fn test_get_timeout_from_cmd_returns_correct_duration_int() {
@@ -0,0 +1,223 @@
+// Copyright Valkey GLIDE Project Contributors - SPDX Identifier: Apache-2.0
+
+use super::inflight_limiter::InflightLimiter;
+use futures::future::{self, Either};
+use redis::{RedisResult, Value};
+use std::pin::pin;
+use std::sync::atomic::{AtomicU32, AtomicU64, Ordering};
+use std::time::Duration;
+use tokio::time::Instant;
+
+/// Buckets per doubling of the latency, giving a resolution of about 19%.
+const SUB_BUCKETS: u32 = 4;
+/// Latencies up to 2^32 microseconds, a bit over an hour, get their own bucket.
+const BUCKET_COUNT: usize = (32 * SUB_BUCKETS) as usize;
+/// No read is hedged until this many latencies were recorded.
+const MIN_SAMPLES: u64 = 100;
+/// The counts are halved every this many samples, so the delay follows changes in latency.
+const DECAY_SAMPLES: u64 = 1024;
+
+/// Hedges reads: if a read has no reply after the configured percentile of the recent read
+/// latencies, the same read is sent again, and the first successful reply wins.
+///
+/// The read strategy chooses the node of each attempt, so with several candidates the hedge
+/// usually goes to another replica or to the primary. A hedge counts as an inflight request of
+/// its own, and is not sent when the inflight request limit is reached. The latencies are kept in a histogram with
+/// logarithmic buckets, whose counts decay so that the delay follows the latency of the nodes.
+pub(crate) struct ReadHedging {
+    percentile: f64,
+    buckets: Box<[AtomicU32]>,
+    samples: AtomicU64,
+}
+
+impl ReadHedging {
+    /// `percentile` is in (0, 100); the delay before a hedge is that percentile of the latencies.
+    pub(crate) fn new(percentile: f64) -> Self {
+        ReadHedging {
+            percentile: percentile.clamp(1.0, 99.99),
+            buckets: (0..BUCKET_COUNT).map(|_| AtomicU32::new(0)).collect(),
+            samples: AtomicU64::new(0),
+        }
+    }
+
+    fn bucket_index(micros: u64) -> usize {
+        if micros < 2 {
+            return 0;
+        }
+        let log2 = (micros as f64).log2();
+        ((log2 * SUB_BUCKETS as f64) as usize).min(BUCKET_COUNT - 1)
+    }
+
+    fn bucket_upper_bound(index: usize) -> Duration {
+        let micros = 2f64.powf((index + 1) as f64 / SUB_BUCKETS as f64);
+        Duration::from_micros(micros.ceil() as u64)
+    }
+
+    fn record(&self, latency: Duration) {
+        let index = Self::bucket_index(latency.as_micros() as u64);
+        self.buckets[index].fetch_add(1, Ordering::Relaxed);
+        let samples = self.samples.fetch_add(1, Ordering::Relaxed) + 1;
+        if samples % DECAY_SAMPLES == 0 {
+            // Concurrent samples may be halved or not; the percentile stays close enough.
+            for bucket in self.buckets.iter() {
+                let count = bucket.load(Ordering::Relaxed);
+                bucket.store(count / 2, Ordering::Relaxed);
+            }
+        }
+    }
+
+    /// The delay before a read is hedged, or None while too few latencies were recorded.
+    pub(crate) fn delay(&self) -> Option<Duration> {
+        if self.samples.load(Ordering::Relaxed) < MIN_SAMPLES {
+            return None;
+        }
+        let counts: Vec<u64> = self
+            .buckets
+            .iter()
+            .map(|bucket| bucket.load(Ordering::Relaxed) as u64)
+            .collect();
+        let total: u64 = counts.iter().sum();
+        if total == 0 {
+            return None;
+        }
+        let rank = (total as f64 * self.percentile / 100.0).ceil() as u64;
+        let mut seen = 0;
+        for (index, count) in counts.iter().enumerate() {
+            seen += count;
+            if seen >= rank {
+                return Some(Self::bucket_upper_bound(index));
+            }
+        }
+        Some(Self::bucket_upper_bound(BUCKET_COUNT - 1))
+    }
+
+    /// Sends a read with `send`, and sends it once more if it has no reply after the hedging
+    /// delay and `inflight_requests` has a request to spare. Returns the first successful reply,
+    /// or the last error if both attempts failed.
+    pub(crate) async fn send<F, Fut>(
+        &self,
+        inflight_requests: &InflightLimiter,
+        send: F,
+    ) -> RedisResult<Value>
+    where
+        F: Fn() -> Fut,
+        Fut: Future<Output = RedisResult<Value>>,
+    {
+        let started = Instant::now();
+        let Some(delay) = self.delay() else {
+            let result = send().await;
+            if result.is_ok() {
+                self.record(started.elapsed());
+            }
+            return result;
+        };
+
+        let mut first = pin!(send());
+        let result = match tokio::time::timeout(delay, first.as_mut()).await {
+            Ok(result) => result,
+            Err(_) if !inflight_requests.try_reserve() => first.await,
+            Err(_) => {
+                // Released once both attempts completed, or when the caller gives up on the read.
+                let _hedge = ReservedRequest(inflight_requests);
+                let second = pin!(send());
+                match future::select(first, second).await {
+                    Either::Left((Ok(value), _)) | Either::Right((Ok(value), _)) => Ok(value),
+                    Either::Left((Err(_), other)) => other.await,
+                    Either::Right((Err(_), other)) => other.await,
+                }
+            }
+        };
+        // The latency seen by the caller, so that hedging that works lowers the delay.
+        if result.is_ok() {
+            self.record(started.elapsed());
+        }
+        result
+    }
+}
+
+/// An inflight request reserved for a hedge, released when dropped.
+struct ReservedRequest<'a>(&'a InflightLimiter);
+
+impl Drop for ReservedRequest<'_> {
+    fn drop(&mut self) {
+        self.0.release();
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use std::sync::atomic::AtomicUsize;
+
+    #[test]
+    fn test_no_delay_before_min_samples() {
+        let hedging = ReadHedging::new(95.0);
+        for _ in 0..MIN_SAMPLES - 1 {
+            hedging.record(Duration::from_millis(1));
+        }
+        assert_eq!(hedging.delay(), None);
+        hedging.record(Duration::from_millis(1));
+        assert!(hedging.delay().is_some());
+    }
+
+    #[test]
+    fn test_delay_is_the_percentile() {
+        let hedging = ReadHedging::new(90.0);
+        for _ in 0..95 {
+            hedging.record(Duration::from_micros(100));
+        }
+        for _ in 0..5 {
+            hedging.record(Duration::from_millis(100));
+        }
+        let delay = hedging.delay().unwrap();
+        assert!(delay >= Duration::from_micros(100) && delay < Duration::from_micros(200));
+    }
+
+    #[tokio::test]
+    async fn test_slow_read_is_hedged() {
+        let hedging = ReadHedging::new(50.0);
+        for _ in 0..MIN_SAMPLES {
+            hedging.record(Duration::from_millis(1));
+        }
+        let inflight_requests = InflightLimiter::new(1, false);
+        let attempts = AtomicUsize::new(0);
+        let result = hedging
+            .send(&inflight_requests, || {
+                let attempt = attempts.fetch_add(1, Ordering::Relaxed);
+                async move {
+                    if attempt == 0 {
+                        tokio::time::sleep(Duration::from_secs(10)).await;
+                    }
+                    Ok(Value::Int(attempt as i64))
+                }
+            })
+            .await;
+        assert_eq!(result.unwrap(), Value::Int(1));
+        assert_eq!(attempts.load(Ordering::Relaxed), 2);
+        // The hedge released its request.
+        assert!(inflight_requests.try_reserve());
+    }
+
+    #[tokio::test]
+    async fn test_no_hedge_past_the_inflight_limit() {
+        let hedging = ReadHedging::new(50.0);
+        for _ in 0..MIN_SAMPLES {
+            hedging.record(Duration::from_millis(1));
+        }
+        // The read being hedged holds the only request.
+        let inflight_requests = InflightLimiter::new(1, false);
+        assert!(inflight_requests.try_reserve());
+        let attempts = AtomicUsize::new(0);
+        let result = hedging
+            .send(&inflight_requests, || {
+                let attempt = attempts.fetch_add(1, Ordering::Relaxed);
+                async move {
+                    tokio::time::sleep(Duration::from_millis(20)).await;
+                    Ok(Value::Int(attempt as i64))
+                }
+            })
+            .await;
+        assert_eq!(result.unwrap(), Value::Int(0));
+        assert_eq!(attempts.load(Ordering::Relaxed), 1);
+    }
+}
@@ -11,6 +11,7 @@ use logger_core::log_warn;
 use rand::Rng;
 use redis::aio::ConnectionLike;
 use redis::cluster_routing::{self, ResponsePolicy, Routable, RoutingInfo, is_readonly_cmd};
+use redis::node_latency::{NodeLatency, pick_two};
 use redis::{PushInfo, RedisError, RedisResult, RetryStrategy, Value};
 use std::sync::Arc;
 use std::sync::atomic::AtomicUsize;
@@ -34,20 +35,93 @@ enum ReadFrom {
         client_az: String,
         last_read_replica_index: Arc<AtomicUsize>,
     },
+    /// Reads go to the node with the lowest expected latency, the primary included.
+    LowestLatency,
+}
+
+/// The connections to a single node.
+///
+/// Requests are striped across the connections, preferring the one with the fewest outstanding
+/// requests, so that a slow command or a large value on one connection doesn't hold back the
+/// requests sent on the others. The first connection is the node's main connection: it carries
+/// the pubsub subscriptions, and the requests that rely on connection state (WATCH, transactions).
+#[derive(Debug)]
+struct NodeConnections {
+    connections: Vec<ReconnectingConnection>,
+    outstanding: Vec<AtomicUsize>,
+    /// Rotates the connection preferred among equally loaded ones.
+    next_index: AtomicUsize,
+    /// Round trip times of the reads sent to the node, used by `ReadFrom::LowestLatency`.
+    latency: NodeLatency,
+}
+
+/// Counts a request as outstanding on a connection until it completes or is dropped.
+struct OutstandingRequest<'a>(&'a AtomicUsize);
+
+impl Drop for OutstandingRequest<'_> {
+    fn drop(&mut self) {
+        self.0.fetch_sub(1, Ordering::Relaxed);
+    }
+}
+
+impl NodeConnections {
+    fn new(connections: Vec<ReconnectingConnection>) -> Self {
+        let outstanding = connections.iter().map(|_| AtomicUsize::new(0)).collect();
+        Self {
+            connections,
+            outstanding,
+            next_index: AtomicUsize::new(0),
+            latency: NodeLatency::default(),
+        }
+    }
+
+    fn main(&self) -> &ReconnectingConnection {
+        &self.connections[0]
+    }
+
+    fn is_connected(&self) -> bool {
+        self.connections
+            .iter()
+            .any(|connection| connection.is_connected())
+    }
+
+    /// Returns the connected connection with the fewest outstanding requests, or the main
+    /// connection if none is connected, along with the request's outstanding count.
+    fn pick(&self) -> (&ReconnectingConnection, OutstandingRequest<'_>) {
+        let count = self.connections.len();
+        let mut picked = 0;
+        if count > 1 {
+            let start = self.next_index.fetch_add(1, Ordering::Relaxed);
+            let mut lowest = usize::MAX;
+            for offset in 0..count {
+                let index = (start + offset) % count;
+                let load = self.outstanding[index].load(Ordering::Relaxed);
+                if load < lowest && self.connections[index].is_connected() {
+                    lowest = load;
+                    picked = index;
+                }
+            }
+        }
+        self.outstanding[picked].fetch_add(1, Ordering::Relaxed);
+        (
+            &self.connections[picked],
+            OutstandingRequest(&self.outstanding[picked]),
+        )
+    }
 }
 
 #[derive(Debug)]
 struct DropWrapper {
     /// Connection to the primary node in the client.
     primary_index: usize,
-    nodes: Vec<ReconnectingConnection>,
+    nodes: Vec<NodeConnections>,
     read_from: ReadFrom,
 }
 
 impl Drop for DropWrapper {
     fn drop(&mut self) {
-        for node in self.nodes.iter() {
-            node.mark_as_dropped();
+        for connection in self.nodes.iter().flat_map(|node| node.connections.iter()) {
+            connection.mark_as_dropped();
         }
     }
 }
@@ -134,6 +208,7 @@ impl StandaloneClient {
         };
 
         let tls_mode = connection_request.tls_mode;
+        let connections_per_node = connection_request.connections_per_node.unwrap_or(1).max(1);
         let node_count = connection_request.addresses.len();
         // randomize pubsub nodes, maybe a batter option is to always use the primary
         let pubsub_node_index = rand::thread_rng().gen_range(0..node_count);
@@ -162,8 +237,15 @@ impl StandaloneClient {
                 let discover = discover_az;
                 let timeout = connection_timeout;
                 async move {
-                    get_connection_and_replication_info(
-                        &address, &retry, &info, tls, &sender, discover, timeout,
+                    get_node_connections_and_replication_info(
+                        &address,
+                        &retry,
+                        &info,
+                        tls,
+                        &sender,
+                        discover,
+                        timeout,
+                        connections_per_node,
                     )
                     .await
                     .map_err(|err| (format!("{}:{}", address.host, address.port), err))
@@ -226,12 +308,12 @@ impl StandaloneClient {
         let read_from = get_read_from(connection_request.read_from);
 
         #[cfg(feature = "standalone_heartbeat")]
-        for node in nodes.iter() {
-            Self::start_heartbeat(node.clone());
+        for connection in nodes.iter().flat_map(|node| node.connections.iter()) {
+            Self::start_heartbeat(connection.clone());
         }
 
-        for node in nodes.iter() {
-            Self::start_periodic_connection_check(node.clone());
+        for connection in nodes.iter().flat_map(|node| node.connections.iter()) {
+            Self::start_periodic_connection_check(connection.clone());
         }
 
         // Successfully created new client. Update the telemetry
@@ -246,14 +328,14 @@ impl StandaloneClient {
         })
     }
 
-    fn get_primary_connection(&self) -> &ReconnectingConnection {
+    fn get_primary_connection(&self) -> &NodeConnections {
         self.inner.nodes.get(self.inner.primary_index).unwrap()
     }
 
     fn round_robin_read_from_replica(
         &self,
         latest_read_replica_index: &Arc<AtomicUsize>,
-    ) -> &ReconnectingConnection {
+    ) -> &NodeConnections {
         let initial_index = latest_read_replica_index.load(Ordering::Relaxed);
         let mut check_count = 0;
         loop {
@@ -286,7 +368,7 @@ impl StandaloneClient {
         &self,
         latest_read_replica_index: &Arc<AtomicUsize>,
         client_az: String,
-    ) -> &ReconnectingConnection {
+    ) -> &NodeConnections {
         let initial_index = latest_read_replica_index.load(Ordering::Relaxed);
         let mut retries = 0usize;
 
@@ -303,7 +385,7 @@ impl StandaloneClient {
             let replica = &self.inner.nodes[index];
 
             // Attempt to get a connection and retrieve the replica's AZ.
-            if let Ok(connection) = replica.get_connection().await {
+            if let Ok(connection) = replica.main().get_connection().await {
                 if let Some(replica_az) = connection.get_az().as_deref() {
                     if replica_az == client_az {
                         // Update `latest_used_replica` with the index of this replica.
@@ -324,7 +406,7 @@ impl StandaloneClient {
         &self,
         latest_read_replica_index: &Arc<AtomicUsize>,
         client_az: String,
-    ) -> &ReconnectingConnection {
+    ) -> &NodeConnections {
         let initial_index = latest_read_replica_index.load(Ordering::Relaxed);
         let mut retries = 0usize;
 
@@ -341,7 +423,7 @@ impl StandaloneClient {
             let replica = &self.inner.nodes[index];
 
             // Attempt to get a connection and retrieve the replica's AZ.
-            if let Ok(connection) = replica.get_connection().await {
+            if let Ok(connection) = replica.main().get_connection().await {
                 if let Some(replica_az) = connection.get_az().as_deref() {
                     if replica_az == client_az {
                         // Update `latest_used_replica` with the index of this replica.
@@ -359,7 +441,7 @@ impl StandaloneClient {
 
         // Step 2: Check if primary is in the same AZ
         let primary = self.get_primary_connection();
-        if let Ok(connection) = primary.get_connection().await {
+        if let Ok(connection) = primary.main().get_connection().await {
             if let Some(primary_az) = connection.get_az().as_deref() {
                 if primary_az == client_az {
                     return primary;
@@ -371,7 +453,25 @@ impl StandaloneClient {
         self.round_robin_read_from_replica(latest_read_replica_index)
     }
 
-    async fn get_connection(&self, readonly: bool) -> &ReconnectingConnection {
+    /// Picks two nodes at random and returns the connected one with the lower expected latency,
+    /// or the primary if neither is connected.
+    fn lowest_latency_read(&self) -> &NodeConnections {
+        let nodes = &self.inner.nodes;
+        let (first, second) = pick_two(nodes.len());
+        let (mut preferred, mut other) = (&nodes[first], &nodes[second]);
+        if other.latency.cost() < preferred.latency.cost() {
+            std::mem::swap(&mut preferred, &mut other);
+        }
+        if preferred.is_connected() {
+            preferred
+        } else if other.is_connected() {
+            other
+        } else {
+            self.get_primary_connection()
+        }
+    }
+
+    async fn get_connection(&self, readonly: bool) -> &NodeConnections {
         if self.inner.nodes.len() == 1 || !readonly {
             return self.get_primary_connection();
         }
@@ -401,10 +501,16 @@ impl StandaloneClient {
                 )
                 .await
             }
+            ReadFrom::LowestLatency => self.lowest_latency_read(),
         }
     }
 
-    async fn send_request(
+    async fn send_request(cmd: &redis::Cmd, node: &NodeConnections) -> RedisResult<Value> {
+        let (reconnecting_connection, _outstanding) = node.pick();
+        Self::send_request_on(cmd, reconnecting_connection).await
+    }
+
+    async fn send_request_on(
         cmd: &redis::Cmd,
         reconnecting_connection: &ReconnectingConnection,
     ) -> RedisResult<Value> {
@@ -421,7 +527,7 @@ impl StandaloneClient {
     }
 
     async fn send_request_to_all_nodes(
-        &mut self,
+        &self,
         cmd: &redis::Cmd,
         response_policy: Option<ResponsePolicy>,
     ) -> RedisResult<Value> {
@@ -477,7 +583,9 @@ impl StandaloneClient {
                     .nodes
                     .iter()
                     .zip(results)
-                    .map(|(node, result)| (Value::BulkString(node.node_address().into()), result))
+                    .map(|(node, result)| {
+                        (Value::BulkString(node.main().node_address().into()), result)
+                    })
                     .collect();
 
                 Ok(Value::Map(node_result_pairs))
@@ -492,15 +600,40 @@ impl StandaloneClient {
     }
 
     async fn send_request_to_single_node(
-        &mut self,
+        &self,
         cmd: &redis::Cmd,
         readonly: bool,
     ) -> RedisResult<Value> {
-        let reconnecting_connection = self.get_connection(readonly).await;
-        Self::send_request(cmd, reconnecting_connection).await
+        let node = self.get_connection(readonly).await;
+        // Blocking reads take as long as the server waits for data, so they aren't timed.
+        if !readonly
+            || !matches!(self.inner.read_from, ReadFrom::LowestLatency)
+            || super::stream_block_position(cmd).is_some()
+        {
+            return Self::send_request(cmd, node).await;
+        }
+        let sample = node.latency.start();
+        let result = Self::send_request(cmd, node).await;
+        if result.is_ok() {
+            sample.finish();
+        }
+        result
     }
 
-    pub async fn send_command(&mut self, cmd: &redis::Cmd) -> RedisResult<Value> {
+    /// Sends a command that changes the state of the connection it is sent on to every
+    /// connection of the primary node, so that all of them stay interchangeable.
+    async fn send_request_to_all_connections(&self, cmd: &redis::Cmd) -> RedisResult<Value> {
+        let node = self.get_primary_connection();
+        let requests = node
+            .connections
+            .iter()
+            .map(|connection| Self::send_request_on(cmd, connection));
+        future::try_join_all(requests)
+            .await
+            .map(|mut results| results.swap_remove(0))
+    }
+
+    pub async fn send_command(&self, cmd: &redis::Cmd) -> RedisResult<Value> {
         let Some(cmd_bytes) = Routable::command(cmd) else {
             return self.send_request_to_single_node(cmd, false).await;
         };
@@ -509,17 +642,32 @@ impl StandaloneClient {
             let response_policy = ResponsePolicy::for_command(cmd_bytes.as_slice());
             return self.send_request_to_all_nodes(cmd, response_policy).await;
         }
+        if self.get_primary_connection().connections.len() > 1 {
+            if is_connection_state_cmd(cmd_bytes.as_slice()) {
+                return self.send_request_to_all_connections(cmd).await;
+            }
+            if is_main_connection_cmd(cmd_bytes.as_slice()) {
+                return Self::send_request_on(cmd, self.get_primary_connection().main()).await;
+            }
+        }
         self.send_request_to_single_node(cmd, is_readonly_cmd(cmd_bytes.as_slice()))
             .await
     }
 
     pub async fn send_pipeline(
-        &mut self,
+        &self,
         pipeline: &redis::Pipeline,
         offset: usize,
         count: usize,
     ) -> RedisResult<Vec<Value>> {
-        let reconnecting_connection = self.get_primary_connection();
+        // Transactions must run on the connection holding the WATCHed keys.
+        let node = self.get_primary_connection();
+        let (reconnecting_connection, _outstanding) = if pipeline.is_atomic() {
+            (node.main(), None)
+        } else {
+            let (connection, outstanding) = node.pick();
+            (connection, Some(outstanding))
+        };
         let mut connection = reconnecting_connection.get_connection().await?;
         let result = connection
             .send_packed_commands(pipeline, offset, count)
@@ -619,8 +767,13 @@ impl StandaloneClient {
         &self,
         new_password: Option<String>,
     ) -> RedisResult<Value> {
-        for node in self.inner.nodes.iter() {
-            node.update_connection_password(new_password.clone());
+        for connection in self
+            .inner
+            .nodes
+            .iter()
+            .flat_map(|node| node.connections.iter())
+        {
+            connection.update_connection_password(new_password.clone());
         }
 
         Ok(Value::Okay)
@@ -629,7 +782,7 @@ impl StandaloneClient {
     /// Retrieve the username used to authenticate with the server.
     pub fn get_username(&self) -> Option<String> {
         // All nodes in the client should have the same username configured, thus any connection would work here.
-        self.get_primary_connection().get_username()
+        self.get_primary_connection().main().get_username()
     }
 }
 
@@ -678,6 +831,98 @@ async fn get_connection_and_replication_info(
     }
 }
 
+/// Opens the connections to a node. The first one reports the node's replication info and keeps
+/// the given connection info; the additional ones never carry pubsub subscriptions.
+#[allow(clippy::too_many_arguments)]
+async fn get_node_connections_and_replication_info(
+    address: &NodeAddress,
+    retry_strategy: &RetryStrategy,
+    connection_info: &redis::RedisConnectionInfo,
+    tls_mode: TlsMode,
+    push_sender: &Option<mpsc::UnboundedSender<PushInfo>>,
+    discover_az: bool,
+    connection_timeout: Duration,
+    connections_per_node: u32,
+) -> Result<(NodeConnections, Value), (NodeConnections, RedisError)> {
+    let main = get_connection_and_replication_info(
+        address,
+        retry_strategy,
+        connection_info,
+        tls_mode,
+        push_sender,
+        discover_az,
+        connection_timeout,
+    )
+    .await;
+
+    let additional_info = redis::RedisConnectionInfo {
+        pubsub_subscriptions: None,
+        ..connection_info.clone()
+    };
+    let additional = future::join_all((1..connections_per_node).map(|_| {
+        ReconnectingConnection::new(
+            address,
+            *retry_strategy,
+            additional_info.clone(),
+            tls_mode,
+            push_sender.clone(),
+            discover_az,
+            connection_timeout,
+        )
+    }))
+    .await
+    .into_iter()
+    // A connection that failed is kept, it keeps reconnecting in the background.
+    .map(|result| result.unwrap_or_else(|(connection, _)| connection));
+
+    match main {
+        Ok((connection, replication_status)) => Ok((
+            NodeConnections::new(std::iter::once(connection).chain(additional).collect()),
+            replication_status,
+        )),
+        Err((connection, err)) => Err((
+            NodeConnections::new(std::iter::once(connection).chain(additional).collect()),
+            err,
+        )),
+    }
+}
+
+/// Commands that change the state of the connection they are sent on.
+fn is_connection_state_cmd(cmd: &[u8]) -> bool {
+    matches!(
+        cmd,
+        b"SELECT"
+            | b"AUTH"
+            | b"HELLO"
+            | b"READONLY"
+            | b"READWRITE"
+            | b"CLIENT SETNAME"
+            | b"CLIENT SETINFO"
+            | b"CLIENT TRACKING"
+            | b"CLIENT NO-EVICT"
+            | b"CLIENT NO-TOUCH"
+    )
+}
+
+/// Commands bound to the main connection: transactions, and subscriptions so that every push
+/// message arrives on the connection restoring the subscriptions after a reconnect.
+fn is_main_connection_cmd(cmd: &[u8]) -> bool {
+    matches!(
+        cmd,
+        b"WATCH"
+            | b"UNWATCH"
+            | b"MULTI"
+            | b"EXEC"
+            | b"DISCARD"
+            | b"SUBSCRIBE"
+            | b"PSUBSCRIBE"
+            | b"SSUBSCRIBE"
+            | b"UNSUBSCRIBE"
+            | b"PUNSUBSCRIBE"
+            | b"SUNSUBSCRIBE"
+    )
+}
+
 fn get_read_from(read_from: Option<super::ReadFrom>) -> ReadFrom {
     match read_from {
         Some(super::ReadFrom::Primary) => ReadFrom::Primary,
@@ -694,6 +939,7 @@ fn get_read_from(read_from: Option<super::ReadFrom>) -> ReadFrom {
                 last_read_replica_index: Default::default(),
             }
         }
+        Some(super::ReadFrom::LowestLatency) => ReadFrom::LowestLatency,
         None => ReadFrom::Primary,
     }
 }
@@ -25,7 +25,13 @@ pub struct ConnectionRequest {
     pub periodic_checks: Option<PeriodicCheck>,
     pub pubsub_subscriptions: Option<redis::PubSubSubscriptionInfo>,
     pub inflight_requests_limit: Option<u32>,
+    pub inflight_requests_wait: bool,
     pub lazy_connect: bool,
+    pub client_tracking: Option<redis::ClientTrackingOptions>,
+    pub connections_per_node: Option<u32>,
+    pub read_hedging_percentile: Option<f64>,
+    pub blocking_connections_limit: Option<u32>,
+    pub value_compression: Option<ValueCompressionConfig>,
 }
 
 #[derive(PartialEq, Eq, Clone, Default, Debug)]
@@ -59,6 +65,7 @@ pub enum ReadFrom {
     #[default]
     Primary,
     PreferReplica,
+    LowestLatency,
     AZAffinity(String),
     AZAffinityReplicasAndPrimary(String),
 }
@@ -81,6 +88,23 @@ pub struct ConnectionRetryStrategy {
     pub jitter_percent: Option<u32>,
 }
 
+#[derive(PartialEq, Eq, Clone, Copy, Default, Debug)]
+pub enum CompressionAlgorithm {
+    #[default]
+    Lz4,
+    Zstd,
+}
+
+/// Compression of the values written by the SET family of commands, see `ValueCodec`.
+#[derive(PartialEq, Eq, Clone, Copy, Default, Debug)]
+pub struct ValueCompressionConfig {
+    pub algorithm: CompressionAlgorithm,
+    /// Shorter values are sent as they are.
+    pub min_size: Option<usize>,
+    /// The zstd compression level; LZ4 has a single level.
+    pub level: Option<i32>,
+}
+
 #[cfg(feature = "proto")]
 fn chars_to_string_option(chars: &::protobuf::Chars) -> Option<String> {
     if chars.is_empty() {
@@ -101,7 +125,7 @@ impl From<protobuf::ConnectionRequest> for ConnectionRequest {
         let read_from = value.read_from.enum_value().ok().map(|val| match val {
             protobuf::ReadFrom::Primary => ReadFrom::Primary,
             protobuf::ReadFrom::PreferReplica => ReadFrom::PreferReplica,
-            protobuf::ReadFrom::LowestLatency => todo!(),
+            protobuf::ReadFrom::LowestLatency => ReadFrom::LowestLatency,
             protobuf::ReadFrom::AZAffinity => {
                 if let Some(client_az) = chars_to_string_option(&value.client_az) {
                     ReadFrom::AZAffinity(client_az)
@@ -223,7 +247,35 @@ impl From<protobuf::ConnectionRequest> for ConnectionRequest {
         }
 
         let inflight_requests_limit = none_if_zero(value.inflight_requests_limit);
+        let inflight_requests_wait = value.inflight_requests_wait;
         let lazy_connect = value.lazy_connect;
+        let client_tracking = match value.client_tracking_broadcast.0 {
+            Some(broadcast) => Some(redis::ClientTrackingOptions {
+                broadcast: true,
+                prefixes: broadcast
+                    .prefixes
+                    .into_iter()
+                    .map(|prefix| prefix.to_vec())
+                    .collect(),
+            }),
+            None if value.client_tracking => Some(redis::ClientTrackingOptions::default()),
+            None => None,
+        };
+        let connections_per_node = none_if_zero(value.connections_per_node);
+        let read_hedging_percentile =
+            (value.read_hedging_percentile > 0.0).then_some(value.read_hedging_percentile as f64);
+        let blocking_connections_limit = none_if_zero(value.blocking_connections_limit);
+        let value_compression = value.value_compression.0.map(|compression| {
+            let algorithm = match compression.algorithm.enum_value_or_default() {
+                protobuf::CompressionAlgorithm::Lz4 => CompressionAlgorithm::Lz4,
+                protobuf::CompressionAlgorithm::Zstd => CompressionAlgorithm::Zstd,
+            };
+            ValueCompressionConfig {
+                algorithm,
+                min_size: none_if_zero(compression.min_size).map(|min_size| min_size as usize),
+                level: (compression.level != 0).then_some(compression.level),
+            }
+        });
 
         ConnectionRequest {
             read_from,
@@ -240,7 +292,13 @@ impl From<protobuf::ConnectionRequest> for ConnectionRequest {
             periodic_checks,
             pubsub_subscriptions,
             inflight_requests_limit,
+            inflight_requests_wait,
             lazy_connect,
+            client_tracking,
+            connections_per_node,
+            read_hedging_percentile,
+            blocking_connections_limit,
+            value_compression,
             // otel_endpoint,
             //otel_span_flush_interval_ms: Some(otel_span_flush_interval_ms),
         }
@@ -0,0 +1,251 @@
+// Copyright Valkey GLIDE Project Contributors - SPDX Identifier: Apache-2.0
+
+use super::types::{CompressionAlgorithm, ValueCompressionConfig};
+use redis::cluster_routing::Routable;
+use redis::{Arg, Cmd, Value};
+
+/// Compressed values start with this magic, then the algorithm tag and the uncompressed length as
+/// a little endian u32. The leading NUL byte keeps the magic out of the way of text values.
+const MAGIC: &[u8; 4] = b"\x00GLZ";
+const HEADER_LEN: usize = MAGIC.len() + 1 + 4;
+const LZ4_TAG: u8 = 1;
+const ZSTD_TAG: u8 = 2;
+/// Values shorter than this are sent as they are when the configuration doesn't set a threshold.
+pub const DEFAULT_MIN_COMPRESSION_SIZE: usize = 1024;
+/// The server's default proto-max-bulk-len: a header claiming more than this is not trusted.
+const MAX_UNCOMPRESSED_LEN: usize = 512 * 1024 * 1024;
+
+/// Compresses the values of the SET family of commands, and decompresses the replies of the GET
+/// family of commands.
+///
+/// A value is compressed when it's at least the minimum size and compressing makes it smaller,
+/// so that small or incompressible values cost nothing on reads. Replies are decompressed
+/// whatever algorithm wrote them, and bytes that don't decompress are returned as they are, so
+/// clients with and without compression can share the same keys.
+#[derive(Clone, Copy, Debug)]
+pub(crate) struct ValueCodec {
+    algorithm: CompressionAlgorithm,
+    min_size: usize,
+    level: i32,
+}
+
+impl ValueCodec {
+    pub(crate) fn new(config: &ValueCompressionConfig) -> Self {
+        ValueCodec {
+            algorithm: config.algorithm,
+            min_size: config.min_size.unwrap_or(DEFAULT_MIN_COMPRESSION_SIZE),
+            level: config.level.unwrap_or(zstd::DEFAULT_COMPRESSION_LEVEL),
+        }
+    }
+
+    /// Returns a copy of `cmd` with its values compressed, or `None` if none of them was.
+    pub(crate) fn encode(&self, cmd: &Cmd) -> Option<Cmd> {
+        let command = cmd.command()?;
+        let is_value: fn(usize) -> bool = match command.as_slice() {
+            b"SET" | b"SETNX" | b"GETSET" => |idx| idx == 2,
+            b"SETEX" | b"PSETEX" => |idx| idx == 3,
+            b"MSET" | b"MSETNX" => |idx| idx >= 2 && idx % 2 == 0,
+            _ => return None,
+        };
+
+        let compressed: Vec<(usize, Vec<u8>)> = cmd
+            .args_iter()
+            .enumerate()
+            .filter(|(idx, _)| is_value(*idx))
+            .filter_map(|(idx, arg)| match arg {
+                Arg::Simple(value) => self.compress(value).map(|value| (idx, value)),
+                Arg::Cursor => None,
+            })
+            .collect();
+        if compressed.is_empty() {
+            return None;
+        }
+
+        let mut encoded = Cmd::new();
+        let mut compressed = compressed.into_iter().peekable();
+        for (idx, arg) in cmd.args_iter().enumerate() {
+            match (arg, compressed.next_if(|(value_idx, _)| *value_idx == idx)) {
+                (_, Some((_, value))) => encoded.arg(value),
+                (Arg::Simple(arg), None) => encoded.arg(arg),
+                (Arg::Cursor, None) => return None,
+            };
+        }
+        encoded.set_span(cmd.span());
+        Some(encoded)
+    }
+
+    /// Decompresses the values in the reply of `cmd`, and returns any other reply as it is.
+    pub(crate) fn decode(&self, cmd: &Cmd, value: Value) -> Value {
+        match cmd.command().as_deref() {
+            // SET replies with the old value when it has the GET option.
+            Some(b"GET" | b"GETDEL" | b"GETEX" | b"GETSET" | b"SET") => decode_value(value),
+            Some(b"MGET") => match value {
+                Value::Array(values) => {
+                    Value::Array(values.into_iter().map(decode_value).collect())
+                }
+                value => value,
+            },
+            _ => value,
+        }
+    }
+
+    fn compress(&self, value: &[u8]) -> Option<Vec<u8>> {
+        if value.len() < self.min_size || value.len() > MAX_UNCOMPRESSED_LEN {
+            return None;
+        }
+        let (tag, payload) = match self.algorithm {
+            CompressionAlgorithm::Lz4 => (LZ4_TAG, lz4_flex::block::compress(value)),
+            CompressionAlgorithm::Zstd => (ZSTD_TAG, zstd::bulk::compress(value, self.level).ok()?),
+        };
+        if HEADER_LEN + payload.len() >= value.len() {
+            return None;
+        }
+        let mut compressed = Vec::with_capacity(HEADER_LEN + payload.len());
+        compressed.extend_from_slice(MAGIC);
+        compressed.push(tag);
+        compressed.extend_from_slice(&(value.len() as u32).to_le_bytes());
+        compressed.extend_from_slice(&payload);
+        Some(compressed)
+    }
+}
+
+fn decode_value(value: Value) -> Value {
+    match value {
+        Value::BulkString(bytes) => match decompress(&bytes) {
+            Some(decompressed) => Value::BulkString(decompressed),
+            None => Value::BulkString(bytes),
+        },
+        value => value,
+    }
+}
+
+/// Returns the uncompressed bytes of a value written by [`ValueCodec::encode`], or `None` if the
+/// bytes don't start with a valid header or don't decompress to the length it states.
+fn decompress(bytes: &[u8]) -> Option<Vec<u8>> {
+    let header = bytes.get(..HEADER_LEN)?;
+    if !header.starts_with(MAGIC) {
+        return None;
+    }
+    let len = u32::from_le_bytes(header[MAGIC.len() + 1..].try_into().ok()?) as usize;
+    if len > MAX_UNCOMPRESSED_LEN {
+        return None;
+    }
+    let payload = &bytes[HEADER_LEN..];
+    let decompressed = match header[MAGIC.len()] {
+        LZ4_TAG => lz4_flex::block::decompress(payload, len).ok()?,
+        ZSTD_TAG => zstd::bulk::decompress(payload, len).ok()?,
+        _ => return None,
+    };
+    (decompressed.len() == len).then_some(decompressed)
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    fn codec(algorithm: CompressionAlgorithm) -> ValueCodec {
+        ValueCodec::new(&ValueCompressionConfig {
+            algorithm,
+            min_size: Some(64),
+            level: None,
+        })
+    }
+
+    fn args(cmd: &Cmd) -> Vec<Vec<u8>> {
+        cmd.args_iter()
+            .map(|arg| match arg {
+                Arg::Simple(arg) => arg.to_vec(),
+                Arg::Cursor => panic!("unexpected cursor"),
+            })
+            .collect()
+    }
+
+    #[test]
+    fn test_round_trip() {
+        let value = "compressible ".repeat(100);
+        for algorithm in [CompressionAlgorithm::Lz4, CompressionAlgorithm::Zstd] {
+            let codec = codec(algorithm);
+            let encoded = codec
+                .encode(redis::cmd("SET").arg("key").arg(&value).arg("EX").arg(10))
+                .unwrap();
+            let encoded_args = args(&encoded);
+            assert_eq!(encoded_args.len(), 5);
+            assert!(encoded_args[2].starts_with(MAGIC));
+            assert!(encoded_args[2].len() < value.len());
+            assert_eq!(encoded_args[3], b"EX");
+
+            let reply = Value::BulkString(encoded_args[2].clone());
+            assert_eq!(
+                codec.decode(&redis::cmd("GET"), reply),
+                Value::BulkString(value.clone().into_bytes())
+            );
+        }
+    }
+
+    #[test]
+    fn test_small_and_incompressible_values_are_kept() {
+        let codec = codec(CompressionAlgorithm::Lz4);
+        assert!(
+            codec
+                .encode(redis::cmd("SET").arg("key").arg("small"))
+                .is_none()
+        );
+        let random: Vec<u8> = (0..1000).map(|_| rand::random::<u8>()).collect();
+        assert!(
+            codec
+                .encode(redis::cmd("SET").arg("key").arg(random))
+                .is_none()
+        );
+        // Keys are never compressed.
+        let key = "k".repeat(1000);
+        assert!(codec.encode(redis::cmd("GET").arg(&key)).is_none());
+    }
+
+    #[test]
+    fn test_mset_values_only() {
+        let codec = codec(CompressionAlgorithm::Zstd);
+        let long_key = "key".repeat(100);
+        let value = "value".repeat(100);
+        let encoded = codec
+            .encode(
+                redis::cmd("MSET")
+                    .arg(&long_key)
+                    .arg(&value)
+                    .arg("other")
+                    .arg("small"),
+            )
+            .unwrap();
+        let encoded_args = args(&encoded);
+        assert_eq!(encoded_args[1], long_key.as_bytes());
+        assert!(encoded_args[2].starts_with(MAGIC));
+        assert_eq!(encoded_args[3], b"other");
+        assert_eq!(encoded_args[4], b"small");
+
+        let reply = Value::Array(vec![
+            Value::BulkString(encoded_args[2].clone()),
+            Value::Nil,
+            Value::BulkString(b"small".to_vec()),
+        ]);
+        assert_eq!(
+            codec.decode(&redis::cmd("MGET"), reply),
+            Value::Array(vec![
+                Value::BulkString(value.into_bytes()),
+                Value::Nil,
+                Value::BulkString(b"small".to_vec()),
+            ])
+        );
+    }
+
+    #[test]
+    fn test_invalid_payload_is_returned_as_is() {
+        let codec = codec(CompressionAlgorithm::Lz4);
+        let mut bytes = MAGIC.to_vec();
+        bytes.push(LZ4_TAG);
+        bytes.extend_from_slice(&100u32.to_le_bytes());
+        bytes.extend_from_slice(b"not lz4");
+        assert_eq!(
+            codec.decode(&redis::cmd("GET"), Value::BulkString(bytes.clone())),
+            Value::BulkString(bytes)
+        );
+    }
+}
@@ -1,10 +1,10 @@
 // Copyright Valkey GLIDE Project Contributors - SPDX Identifier: Apache-2.0
 
-use logger_core::log_debug;
-use nanoid::nanoid;
+use logger_core::{Level, log_debug, log_enabled};
 use once_cell::sync::Lazy;
 use redis::{RedisResult, ScanStateRC};
-use std::{collections::HashMap, sync::Mutex};
+use std::sync::Mutex;
+use std::sync::atomic::{AtomicUsize, Ordering};
 
 // This is a container for storing the cursor of a cluster scan.
 // The cursor for a cluster scan is a ref to the actual ScanState struct in redis-rs.
@@ -13,26 +13,102 @@ use std::{collections::HashMap, sync::Mutex};
 // The cursor is stored in the container and can be retrieved using the id.
 // In wrapper layer we wrap the id in an object, which, when dropped, trigger the removal of the cursor from the container.
 // When the ref is removed from the container, the actual ScanState struct is dropped by Rust GC.
+//
+// The container is split into shards, each a slab of slots behind its own lock, so that scans
+// running on different threads don't contend. The id of a cursor is a 64 bit handle, formatted in
+// decimal, made of the shard, the slot in the shard and the slot's generation. The generation is
+// bumped whenever the slot is freed, so the id of a removed cursor never resolves to the cursor
+// that reuses its slot.
 
-static CONTAINER: Lazy<Mutex<HashMap<String, ScanStateRC>>> =
-    Lazy::new(|| Mutex::new(HashMap::new()));
+const SHARD_BITS: u32 = 4;
+const SHARD_COUNT: usize = 1 << SHARD_BITS;
+const SLOT_BITS: u32 = 28;
+
+struct Slot {
+    // Odd while the slot holds a cursor, so that no id has generation 0 and "0" is never an id.
+    generation: u32,
+    scan_state: Option<ScanStateRC>,
+}
+
+#[derive(Default)]
+struct Shard {
+    slots: Vec<Slot>,
+    free: Vec<u32>,
+}
+
+static SHARDS: Lazy<[Mutex<Shard>; SHARD_COUNT]> =
+    Lazy::new(|| std::array::from_fn(|_| Mutex::default()));
+
+static NEXT_SHARD_HINT: AtomicUsize = AtomicUsize::new(0);
+
+thread_local! {
+    // Spreads threads over the shards in the order they first insert a cursor.
+    static SHARD_HINT: usize = NEXT_SHARD_HINT.fetch_add(1, Ordering::Relaxed) % SHARD_COUNT;
+}
+
+fn encode_id(shard: usize, slot: u32, generation: u32) -> String {
+    let handle = ((generation as u64) << (SLOT_BITS + SHARD_BITS))
+        | ((slot as u64) << SHARD_BITS)
+        | shard as u64;
+    handle.to_string()
+}
+
+fn decode_id(id: &str) -> Option<(usize, u32, u32)> {
+    let handle = id.parse::<u64>().ok()?;
+    let shard = (handle & (SHARD_COUNT as u64 - 1)) as usize;
+    let slot = ((handle >> SHARD_BITS) & ((1 << SLOT_BITS) - 1)) as u32;
+    let generation = (handle >> (SLOT_BITS + SHARD_BITS)) as u32;
+    // Ids of live cursors never have generation 0, so the initial cursor "0" takes no lock.
+    (generation != 0).then_some((shard, slot, generation))
+}
 
 pub fn insert_cluster_scan_cursor(scan_state: ScanStateRC) -> String {
-    let id = nanoid!();
-    CONTAINER.lock().unwrap().insert(id.clone(), scan_state);
-    log_debug(
-        "scan_state_cursor insert",
-        format!("Inserted to container scan_state_cursor with id: `{id:?}`"),
-    );
+    let shard_index = SHARD_HINT.with(|hint| *hint);
+    let (slot, generation) = {
+        let mut shard = SHARDS[shard_index].lock().unwrap();
+        match shard.free.pop() {
+            Some(slot) => {
+                let entry = &mut shard.slots[slot as usize];
+                entry.generation = entry.generation.wrapping_add(1);
+                entry.scan_state = Some(scan_state);
+                (slot, entry.generation)
+            }
+            None => {
+                let slot = shard.slots.len() as u32;
+                assert!(slot < 1 << SLOT_BITS, "Too many cluster scan cursors");
+                shard.slots.push(Slot {
+                    generation: 1,
+                    scan_state: Some(scan_state),
+                });
+                (slot, 1)
+            }
+        }
+    };
+    let id = encode_id(shard_index, slot, generation);
+    if log_enabled(Level::Debug) {
+        log_debug(
+            "scan_state_cursor insert",
+            format!("Inserted to container scan_state_cursor with id: `{id:?}`"),
+        );
+    }
     id
 }
 
 pub fn get_cluster_scan_cursor(id: String) -> RedisResult<ScanStateRC> {
-    let scan_state_rc = CONTAINER.lock().unwrap().get(&id).cloned();
-    log_debug(
-        "scan_state_cursor get",
-        format!("Retrieved from container scan_state_cursor with id: `{id:?}`"),
-    );
+    let scan_state_rc = decode_id(&id).and_then(|(shard, slot, generation)| {
+        let shard = SHARDS[shard].lock().unwrap();
+        shard
+            .slots
+            .get(slot as usize)
+            .filter(|entry| entry.generation == generation)
+            .and_then(|entry| entry.scan_state.clone())
+    });
+    if log_enabled(Level::Debug) {
+        log_debug(
+            "scan_state_cursor get",
+            format!("Retrieved from container scan_state_cursor with id: `{id:?}`"),
+        );
+    }
     match scan_state_rc {
         Some(scan_state_rc) => Ok(scan_state_rc),
         None => Err(redis::RedisError::from((
@@ -44,9 +120,57 @@ pub fn get_cluster_scan_cursor(id: String) -> RedisResult<ScanStateRC> {
 }
 
 pub fn remove_scan_state_cursor(id: String) {
-    log_debug(
-        "scan_state_cursor remove",
-        format!("Removed from container scan_state_cursor with id: `{id:?}`"),
-    );
-    CONTAINER.lock().unwrap().remove(&id);
+    if log_enabled(Level::Debug) {
+        log_debug(
+            "scan_state_cursor remove",
+            format!("Removed from container scan_state_cursor with id: `{id:?}`"),
+        );
+    }
+    let Some((shard, slot, generation)) = decode_id(&id) else {
+        return;
+    };
+    // Drop the cursor after releasing the lock.
+    let _scan_state = {
+        let mut shard = SHARDS[shard].lock().unwrap();
+        let Some(entry) = shard.slots.get_mut(slot as usize) else {
+            return;
+        };
+        if entry.generation != generation || entry.scan_state.is_none() {
+            return;
+        }
+        let scan_state = entry.scan_state.take();
+        entry.generation = entry.generation.wrapping_add(1);
+        shard.free.push(slot);
+        scan_state
+    };
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn test_removed_id_does_not_resolve_to_reused_slot() {
+        let first = insert_cluster_scan_cursor(ScanStateRC::new());
+        assert!(get_cluster_scan_cursor(first.clone()).is_ok());
+        remove_scan_state_cursor(first.clone());
+        assert!(get_cluster_scan_cursor(first.clone()).is_err());
+
+        let second = insert_cluster_scan_cursor(ScanStateRC::new());
+        assert_ne!(first, second);
+        assert!(get_cluster_scan_cursor(first.clone()).is_err());
+        assert!(get_cluster_scan_cursor(second.clone()).is_ok());
+        // Removing a stale id leaves the new cursor in place.
+        remove_scan_state_cursor(first);
+        assert!(get_cluster_scan_cursor(second.clone()).is_ok());
+        remove_scan_state_cursor(second);
+    }
+
+    #[test]
+    fn test_invalid_ids_are_rejected() {
+        for id in ["", "0", "finished", "18446744073709551615"] {
+            assert!(get_cluster_scan_cursor(id.to_string()).is_err());
+            remove_scan_state_cursor(id.to_string());
+        }
+    }
 }
@@ -6,56 +6,96 @@ use logger_core::log_error;
 use protobuf::Message;
 use std::io;
 
+/// The smallest read size the buffer adapts down to.
+const MIN_READ_SIZE: usize = 1024;
+/// The buffer is sized to hold this many messages of the average size.
+const MESSAGES_PER_READ: usize = 16;
+
 /// An object handling a arranging read buffers, and parsing the data in the buffers into requests.
+///
+/// The parsed requests reference the received bytes, and a message that was only partially
+/// received stays in place until the rest of it arrives, so request bytes are never copied. The
+/// space reserved for each read follows the average message size, up to the size the buffer was
+/// created with, and grows to fit a partially received message whole.
 pub struct RotatingBuffer {
     backing_buffer: BytesMut,
+    max_read_size: usize,
+    read_size: usize,
+    average_message_size: usize,
+    // The length of the partially received message at the start of the buffer, or 0.
+    pending_message_size: usize,
 }
 
 impl RotatingBuffer {
     pub fn new(buffer_size: usize) -> Self {
         Self {
             backing_buffer: BytesMut::with_capacity(buffer_size),
+            max_read_size: buffer_size,
+            read_size: buffer_size,
+            average_message_size: 0,
+            pending_message_size: 0,
         }
     }
 
+    fn record_message_size(&mut self, message_size: usize) {
+        self.average_message_size = if self.average_message_size == 0 {
+            message_size
+        } else {
+            (self.average_message_size * 7 + message_size) / 8
+        };
+        self.read_size = (self.average_message_size * MESSAGES_PER_READ)
+            .clamp(MIN_READ_SIZE.min(self.max_read_size), self.max_read_size);
+    }
+
     /// Parses the requests in the buffer.
     pub fn get_requests<T: Message>(&mut self) -> io::Result<Vec<T>> {
-        let buffer = self.backing_buffer.split().freeze();
-        let mut results: Vec<T> = vec![];
-        let mut prev_position = 0;
-        let buffer_len = buffer.len();
-        while prev_position < buffer_len {
-            if let Some((request_len, bytes_read)) = u32::decode_var(&buffer[prev_position..]) {
-                let start_pos = prev_position + bytes_read;
-                if (start_pos + request_len as usize) > buffer_len {
-                    break;
-                } else {
-                    match T::parse_from_tokio_bytes(
-                        &buffer.slice(start_pos..start_pos + request_len as usize),
-                    ) {
-                        Ok(request) => {
-                            prev_position += request_len as usize + bytes_read;
-                            results.push(request);
-                        }
-                        Err(err) => {
-                            log_error("parse input", format!("Failed to parse request: {err}"));
-                            return Err(err.into());
-                        }
-                    }
-                }
-            } else {
+        // Find the complete messages before splitting them off, so that a partial message at the
+        // end stays in the buffer rather than being copied back into it.
+        let mut message_ranges = vec![];
+        let mut position = 0;
+        self.pending_message_size = 0;
+        let buffer_len = self.backing_buffer.len();
+        while position < buffer_len {
+            let Some((request_len, bytes_read)) = u32::decode_var(&self.backing_buffer[position..])
+            else {
+                break;
+            };
+            let start_pos = position + bytes_read;
+            let end_pos = start_pos + request_len as usize;
+            if end_pos > buffer_len {
+                self.pending_message_size = end_pos - position;
                 break;
             }
+            message_ranges.push(start_pos..end_pos);
+            position = end_pos;
         }
 
-        if prev_position != buffer.len() {
-            self.backing_buffer
-                .extend_from_slice(&buffer[prev_position..]);
+        let buffer = self.backing_buffer.split_to(position).freeze();
+        let mut results: Vec<T> = Vec::with_capacity(message_ranges.len());
+        let mut message_start = 0;
+        for range in message_ranges {
+            let message_end = range.end;
+            match T::parse_from_tokio_bytes(&buffer.slice(range)) {
+                Ok(request) => results.push(request),
+                Err(err) => {
+                    log_error("parse input", format!("Failed to parse request: {err}"));
+                    return Err(err.into());
+                }
+            }
+            self.record_message_size(message_end - message_start);
+            message_start = message_end;
         }
         Ok(results)
     }
 
+    /// The buffer to read into, with room for the next read.
     pub fn current_buffer(&mut self) -> &mut BytesMut {
+        let pending = self
+            .pending_message_size
+            .saturating_sub(self.backing_buffer.len());
+        // Doesn't reallocate while the buffer has room, and otherwise reclaims the allocation of
+        // the parsed requests once they were all dropped.
+        self.backing_buffer.reserve(pending.max(self.read_size));
         &mut self.backing_buffer
     }
 }
@@ -365,4 +405,49 @@ mod tests {
             args_pointer,
         );
     }
+
+    #[rstest]
+    fn read_size_follows_message_size() {
+        let mut rotating_buffer = RotatingBuffer::new(65_536);
+        for index in 0..32 {
+            write_get(rotating_buffer.current_buffer(), index, "key", false);
+            assert_eq!(
+                rotating_buffer
+                    .get_requests::<CommandRequest>()
+                    .unwrap()
+                    .len(),
+                1
+            );
+        }
+        assert_eq!(rotating_buffer.read_size, MIN_READ_SIZE);
+    }
+
+    #[rstest]
+    fn partial_message_stays_in_place() {
+        const KEY_LENGTH: usize = 100_000;
+        let mut rotating_buffer = RotatingBuffer::new(1024);
+        let key = generate_random_string(KEY_LENGTH);
+        let mut request_bytes = BytesMut::new();
+        write_get(&mut request_bytes, 100, key.as_str(), false);
+
+        rotating_buffer
+            .current_buffer()
+            .extend_from_slice(&request_bytes[..1024]);
+        assert!(
+            rotating_buffer
+                .get_requests::<CommandRequest>()
+                .unwrap()
+                .is_empty()
+        );
+        // The rest of the message fits without reallocating, so the received part stays in place.
+        let buffer = rotating_buffer.current_buffer();
+        let received_part = buffer.as_ptr();
+        assert!(buffer.capacity() >= request_bytes.len());
+        buffer.extend_from_slice(&request_bytes[1024..]);
+        assert_eq!(buffer.as_ptr(), received_part);
+
+        let requests = rotating_buffer.get_requests().unwrap();
+        assert_eq!(requests.len(), 1);
+        assert_request(&requests[0], RequestType::Get, 100, vec![key.into()], false);
+    }
 }
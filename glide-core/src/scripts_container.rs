@@ -1,26 +1,79 @@
 // Copyright Valkey GLIDE Project Contributors - SPDX Identifier: Apache-2.0
 
-use bytes::BytesMut;
+use bytes::Bytes;
 use logger_core::{log_info, log_warn};
 use once_cell::sync::Lazy;
 use sha1_smol::Sha1;
-use std::cell::Cell;
 use std::collections::HashMap;
-use std::sync::{Arc, Mutex};
+use std::sync::atomic::{AtomicU32, AtomicU64, Ordering};
+use std::sync::{Arc, RwLock};
 
 const LOCK_ERR: &str = "Failed to acquire the scripts container lock";
 
-/// A script entry stored in the global container.
+// Scripts are looked up on every invocation and added or removed rarely, so the container is split
+// into shards by the first hex digit of the hash, each behind a read-write lock.
+const SHARD_COUNT: usize = 16;
+
+/// A script stored in the global container.
 ///
-/// `ScriptEntry` holds the compiled script bytes and a reference count
-/// to track how many times the script has been added via `add_script`.
-struct ScriptEntry {
-    script: Arc<BytesMut>,
-    ref_count: Cell<u32>,
+/// The hash is computed once, when the script is first added. `Script` also tracks, for each
+/// client, whether the client already loaded it on its nodes, so that invocations send EVALSHA
+/// right away instead of waiting for a NOSCRIPT error.
+pub struct Script {
+    hash: String,
+    code: Bytes,
+    // Bit `i` is set once a client holding loader bit `i` loaded the script.
+    loaded: AtomicU64,
+    // How many times the script has been added via `add_script`.
+    ref_count: AtomicU32,
 }
 
-static CONTAINER: Lazy<Mutex<HashMap<String, ScriptEntry>>> =
-    Lazy::new(|| Mutex::new(HashMap::new()));
+impl Script {
+    /// The SHA1 hash of the script, in hex.
+    pub fn hash(&self) -> &str {
+        &self.hash
+    }
+
+    pub fn code(&self) -> &[u8] {
+        &self.code
+    }
+
+    /// Whether the client holding `loader_bit` loaded the script on its nodes.
+    pub fn is_loaded(&self, loader_bit: u64) -> bool {
+        self.loaded.load(Ordering::Relaxed) & loader_bit != 0
+    }
+
+    pub fn set_loaded(&self, loader_bit: u64) {
+        self.loaded.fetch_or(loader_bit, Ordering::Relaxed);
+    }
+
+    pub fn clear_loaded(&self, loader_bit: u64) {
+        self.loaded.fetch_and(!loader_bit, Ordering::Relaxed);
+    }
+}
+
+type Shard = RwLock<HashMap<String, Arc<Script>>>;
+
+static SHARDS: Lazy<[Shard; SHARD_COUNT]> =
+    Lazy::new(|| std::array::from_fn(|_| RwLock::default()));
+
+fn shard(hash: &str) -> &'static Shard {
+    let first = hash.as_bytes().first().copied().unwrap_or_default();
+    let index = match first {
+        b'0'..=b'9' => first - b'0',
+        b'a'..=b'f' => first - b'a' + 10,
+        _ => first,
+    };
+    &SHARDS[index as usize % SHARD_COUNT]
+}
+
+/// Returns a bit to mark the scripts loaded by a new client. There are only 64 bits, so clients
+/// beyond the 64th share them: a client may then see a script as loaded by another client, and
+/// falls back to loading it when the server replies NOSCRIPT.
+pub fn next_loader_bit() -> u64 {
+    static NEXT_LOADER: AtomicU32 = AtomicU32::new(0);
+    1 << (NEXT_LOADER.fetch_add(1, Ordering::Relaxed) % u64::BITS)
+}
 
 pub fn add_script(script: &[u8]) -> String {
     let mut hash = Sha1::new();
@@ -31,15 +84,18 @@ pub fn add_script(script: &[u8]) -> String {
         format!("Added script with hash: `{hash}`"),
     );
 
-    let mut container = CONTAINER.lock().expect(LOCK_ERR);
-    let entry = container
-        .entry(hash.clone())
-        .or_insert_with(|| ScriptEntry {
-            script: Arc::new(BytesMut::from(script)),
-            ref_count: Cell::new(0),
-        });
-    let new_count = entry.ref_count.get() + 1;
-    entry.ref_count.set(new_count);
+    let mut container = shard(&hash).write().expect(LOCK_ERR);
+    let entry = container.entry(hash.clone()).or_insert_with(|| {
+        Arc::new(Script {
+            hash: hash.clone(),
+            code: Bytes::copy_from_slice(script),
+            loaded: AtomicU64::new(0),
+            ref_count: AtomicU32::new(0),
+        })
+    });
+    // The count is only changed under the write lock.
+    let new_count = entry.ref_count.load(Ordering::Relaxed) + 1;
+    entry.ref_count.store(new_count, Ordering::Relaxed);
     log_info(
         "script_lifetime",
         format!("Added script with hash: `{hash}`, ref_count = {new_count}"),
@@ -47,19 +103,15 @@ pub fn add_script(script: &[u8]) -> String {
     hash
 }
 
-pub fn get_script(hash: &str) -> Option<Arc<BytesMut>> {
-    CONTAINER
-        .lock()
-        .expect(LOCK_ERR)
-        .get(hash)
-        .map(|entry| entry.script.clone())
+pub fn get_script(hash: &str) -> Option<Arc<Script>> {
+    shard(hash).read().expect(LOCK_ERR).get(hash).cloned()
 }
 
 pub fn remove_script(hash: &str) {
-    let mut container = CONTAINER.lock().expect(LOCK_ERR);
+    let mut container = shard(hash).write().expect(LOCK_ERR);
     if let Some(entry) = container.get(hash) {
-        let new_count = entry.ref_count.get() - 1;
-        entry.ref_count.set(new_count);
+        let new_count = entry.ref_count.load(Ordering::Relaxed) - 1;
+        entry.ref_count.store(new_count, Ordering::Relaxed);
 
         if new_count == 0 {
             container.remove(hash);
@@ -92,7 +144,9 @@ mod script_tests {
 
         let retrieved = get_script(&hash);
         assert!(retrieved.is_some());
-        assert_eq!(&retrieved.unwrap()[..], script);
+        let retrieved = retrieved.unwrap();
+        assert_eq!(retrieved.code(), script);
+        assert_eq!(retrieved.hash(), hash);
     }
 
     #[test]
@@ -117,4 +171,20 @@ mod script_tests {
         let fake_hash = "nonexistenthash";
         remove_script(fake_hash); // Should not panic
     }
+
+    #[test]
+    fn test_loaded_bits_are_per_client() {
+        let hash = add_script(b"return 'loaded bits test'");
+        let script = get_script(&hash).unwrap();
+        let first = next_loader_bit();
+        let second = next_loader_bit();
+
+        script.set_loaded(first);
+        assert!(script.is_loaded(first));
+        assert!(!script.is_loaded(second));
+
+        script.clear_loaded(first);
+        assert!(!script.is_loaded(first));
+        remove_script(&hash);
+    }
 }
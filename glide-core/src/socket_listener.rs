@@ -34,7 +34,7 @@ use std::ptr::from_mut;
 use std::rc::Rc;
 use std::str;
 use std::sync::{Arc, RwLock};
-use telemetrylib::{GlideSpan, GlideSpanStatus};
+use telemetrylib::{GlideSpan, GlideSpanStatus, Telemetry};
 use thiserror::Error;
 use tokio::net::{UnixListener, UnixStream};
 use tokio::sync::Mutex;
@@ -65,11 +65,19 @@ struct UnixStreamListener {
     rotating_buffer: RotatingBuffer,
 }
 
+/// Responses are written in batches once this many bytes accumulated, without waiting for more.
+const MAX_BATCH_BYTES: usize = 64 * 1024;
+/// Output buffers larger than this aren't kept for reuse after a large batch.
+const MAX_RETAINED_OUTPUT_CAPACITY: usize = 1024 * 1024;
+
 /// struct containing all objects needed to write to a socket.
 struct Writer {
     socket: Rc<UnixStream>,
     lock: Mutex<()>,
+    // Responses are encoded here while the previous batch is written.
     accumulated_outputs: Cell<Vec<u8>>,
+    // The buffer of the last written batch, kept to accumulate the batch after the next one.
+    spare_outputs: Cell<Vec<u8>>,
     closing_sender: Sender<ClosingReason>,
 }
 
@@ -132,19 +140,35 @@ impl UnixStreamListener {
     }
 }
 
+/// Writes the accumulated responses to the socket, in batches.
+///
+/// Only one task writes at a time; responses completed meanwhile are encoded into the next batch
+/// and written by the same task, so each batch is a single buffer written with as few syscalls as
+/// the socket allows. A small batch is delayed by one yield, which lets the response tasks that are
+/// already ready on this thread add their responses to it.
 async fn write_to_output(writer: &Rc<Writer>) {
     let Ok(_guard) = writer.lock.try_lock() else {
         return;
     };
 
     let mut output = writer.accumulated_outputs.take();
+    if !output.is_empty() && output.len() < MAX_BATCH_BYTES {
+        writer.accumulated_outputs.set(output);
+        task::yield_now().await;
+        output = writer.accumulated_outputs.take();
+    }
+    writer.accumulated_outputs.set(writer.spare_outputs.take());
     loop {
         if output.is_empty() {
+            writer.spare_outputs.set(output);
             return;
         }
+        let batch_len = output.len();
+        Telemetry::incr_pending_response_bytes(batch_len);
         let mut total_written_bytes = 0;
         while total_written_bytes < output.len() {
             if let Err(err) = writer.socket.writable().await {
+                Telemetry::decr_pending_response_bytes(batch_len);
                 let _res = writer.closing_sender.send(err.into()).await; // we ignore the error, because it means that the reader was dropped, which is ok.
                 return;
             }
@@ -159,11 +183,15 @@ async fn write_to_output(writer: &Rc<Writer>) {
                     continue;
                 }
                 Err(err) => {
+                    Telemetry::decr_pending_response_bytes(batch_len);
                     let _res = writer.closing_sender.send(err.into()).await; // we ignore the error, because it means that the reader was dropped, which is ok.
+                    return;
                 }
             }
         }
+        Telemetry::decr_pending_response_bytes(batch_len);
         output.clear();
+        output.shrink_to(MAX_RETAINED_OUTPUT_CAPACITY);
         output = writer.accumulated_outputs.replace(output);
     }
 }
@@ -324,12 +352,15 @@ async fn send_command(
     cmd: Cmd,
     mut client: Client,
     routing: Option<RoutingInfo>,
+    skip_value_compression: bool,
 ) -> ClientUsageResult<Value> {
     let child_span = create_child_span(cmd.span().as_ref(), "send_command");
-    let res = client
-        .send_command(&cmd, routing)
-        .await
-        .map_err(|err| err.into());
+    let res = if skip_value_compression {
+        client.send_command_uncompressed(&cmd, routing).await
+    } else {
+        client.send_command(&cmd, routing).await
+    }
+    .map_err(|err| err.into());
 
     if let Some(c) = child_span {
         c.end()
@@ -535,7 +566,7 @@ fn handle_request(request: CommandRequest, mut client: Client, writer: Rc<Writer
         let mut updated_inflight_counter = true;
         let client_clone = client.clone();
 
-        let result = match client.reserve_inflight_request() {
+        let result = match client.reserve_inflight_request_or_wait().await {
             false => {
                 updated_inflight_counter = false;
                 Err(ClientUsageError::User(
@@ -553,7 +584,13 @@ fn handle_request(request: CommandRequest, mut client: Client, writer: Rc<Writer
                             Ok(mut cmd) => match get_route(request.route.0, Some(&cmd)) {
                                 Ok(routes) => {
                                     cmd.set_span(get_unsafe_span_from_ptr(request.root_span_ptr));
-                                    send_command(cmd, client, routes).await
+                                    send_command(
+                                        cmd,
+                                        client,
+                                        routes,
+                                        command.skip_value_compression,
+                                    )
+                                    .await
                                 }
                                 Err(e) => Err(e),
                             },
@@ -765,12 +802,14 @@ async fn listen_on_client_stream(socket: UnixStream) {
     let write_lock = Mutex::new(());
     let mut client_listener = UnixStreamListener::new(socket.clone());
     let accumulated_outputs = Cell::new(Vec::new());
+    let spare_outputs = Cell::new(Vec::new());
     let (sender, mut receiver) = channel(1);
     let (push_tx, push_rx) = tokio::sync::mpsc::unbounded_channel();
     let writer = Rc::new(Writer {
         socket,
         lock: write_lock,
         accumulated_outputs,
+        spare_outputs,
         closing_sender: sender,
     });
     let client_creation = wait_for_connection_configuration_and_create_client(
@@ -1056,3 +1095,55 @@ where
 {
     start_socket_listener_internal(init_callback, None);
 }
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use tokio::io::AsyncReadExt;
+
+    #[tokio::test]
+    async fn test_responses_ready_together_are_written_in_one_batch() {
+        let (socket, mut peer) = UnixStream::pair().unwrap();
+        let (closing_sender, _closing_receiver) = channel(1);
+        let writer = Rc::new(Writer {
+            socket: Rc::new(socket),
+            lock: Mutex::new(()),
+            accumulated_outputs: Cell::new(Vec::new()),
+            spare_outputs: Cell::new(Vec::new()),
+            closing_sender,
+        });
+
+        let mut expected = Vec::new();
+        let local = task::LocalSet::new();
+        local
+            .run_until(async {
+                let tasks: Vec<_> = (0..8)
+                    .map(|callback_idx| {
+                        let mut response = Response::new();
+                        response.callback_idx = callback_idx;
+                        response.value = Some(response::response::Value::ConstantResponse(
+                            response::ConstantResponse::OK.into(),
+                        ));
+                        response
+                            .write_length_delimited_to_vec(&mut expected)
+                            .unwrap();
+                        let writer = writer.clone();
+                        task::spawn_local(async move { write_to_writer(response, &writer).await })
+                    })
+                    .collect();
+                for task in tasks {
+                    task.await.unwrap().unwrap();
+                }
+            })
+            .await;
+
+        // The task writing the first response waited for the others, so the second buffer never
+        // held a batch.
+        assert_eq!(writer.spare_outputs.take().capacity(), 0);
+        assert_eq!(Telemetry::pending_response_bytes(), 0);
+
+        let mut received = vec![0; expected.len()];
+        peer.read_exact(&mut received).await.unwrap();
+        assert_eq!(received, expected);
+    }
+}
@@ -1,6 +1,7 @@
 use lazy_static::lazy_static;
 use serde::Serialize;
 use std::sync::RwLock as StdRwLock;
+use std::sync::atomic::{AtomicUsize, Ordering};
 mod metrics_exporter_file;
 mod open_telemetry;
 mod span_exporter_file;
@@ -22,6 +23,11 @@ lazy_static! {
     static ref TELEMETRY: StdRwLock<Telemetry> = StdRwLock::<Telemetry>::default();
 }
 
+/// Bytes of responses being written to the sockets of the wrappers. A value that stays high
+/// means the wrappers don't read the responses as fast as they arrive. Kept outside of
+/// `TELEMETRY` since it changes on every batch of responses written.
+static PENDING_RESPONSE_BYTES: AtomicUsize = AtomicUsize::new(0);
+
 const MUTEX_WRITE_ERR: &str = "Failed to obtain write lock for mutex. Poisoned mutex";
 const MUTEX_READ_ERR: &str = "Failed to obtain read lock for mutex. Poisoned mutex";
 
@@ -58,6 +64,26 @@ impl Telemetry {
         t.total_clients
     }
 
+    /// Increment the bytes of responses being written to the wrappers by `incr_by`
+    /// Return the number of pending response bytes after the increment
+    pub fn incr_pending_response_bytes(incr_by: usize) -> usize {
+        PENDING_RESPONSE_BYTES
+            .fetch_add(incr_by, Ordering::Relaxed)
+            .saturating_add(incr_by)
+    }
+
+    /// Decrease the bytes of responses being written to the wrappers by `decr_by`
+    /// Return the number of pending response bytes after the decrease
+    pub fn decr_pending_response_bytes(decr_by: usize) -> usize {
+        // Saturates, since `reset` may clear the bytes of batches still being written.
+        let previous = PENDING_RESPONSE_BYTES
+            .fetch_update(Ordering::Relaxed, Ordering::Relaxed, |pending| {
+                Some(pending.saturating_sub(decr_by))
+            })
+            .unwrap_or_default();
+        previous.saturating_sub(decr_by)
+    }
+
     /// Return the number of active connections
     pub fn total_connections() -> usize {
         TELEMETRY.read().expect(MUTEX_READ_ERR).total_connections
@@ -68,8 +94,14 @@ impl Telemetry {
         TELEMETRY.read().expect(MUTEX_READ_ERR).total_clients
     }
 
+    /// Return the bytes of responses being written to the wrappers
+    pub fn pending_response_bytes() -> usize {
+        PENDING_RESPONSE_BYTES.load(Ordering::Relaxed)
+    }
+
     /// Reset the telemetry collected thus far
     pub fn reset() {
         *TELEMETRY.write().expect(MUTEX_WRITE_ERR) = Telemetry::default();
+        PENDING_RESPONSE_BYTES.store(0, Ordering::Relaxed);
     }
 }
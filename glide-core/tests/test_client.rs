@@ -1516,4 +1516,70 @@ pub(crate) mod shared_client_tests {
             );
         });
     }
+
+    #[rstest]
+    #[serial_test::serial]
+    #[timeout(SHORT_CLUSTER_TEST_TIMEOUT)]
+    fn test_invoke_script_loads_eagerly_and_reloads_after_flush(
+        #[values(false, true)] use_cluster: bool,
+    ) {
+        block_on_all(async {
+            let mut test_basics = setup_test_basics(
+                use_cluster,
+                TestConfiguration {
+                    shared_server: true,
+                    ..Default::default()
+                },
+            )
+            .await;
+
+            let key = generate_random_string(10);
+            let hash = glide_core::scripts_container::add_script(
+                br#"redis.call("SET", KEYS[1], ARGV[1]); return redis.call("GET", KEYS[1])"#,
+            );
+            let mut script_exists = cmd("SCRIPT");
+            script_exists.arg("EXISTS").arg(&hash);
+
+            // The first invocation loads the script before sending EVALSHA.
+            let result = test_basics
+                .client
+                .invoke_script(
+                    &hash,
+                    &vec![key.as_bytes()],
+                    &vec![b"first".as_slice()],
+                    None,
+                )
+                .await;
+            assert_eq!(result, Ok(Value::BulkString(b"first".to_vec())));
+            let exists = test_basics
+                .client
+                .send_command(&script_exists, None)
+                .await
+                .unwrap();
+            assert_eq!(Vec::<bool>::from_redis_value(&exists).unwrap(), vec![true]);
+
+            // The script is still marked as loaded, so EVALSHA fails with NOSCRIPT and reloads it.
+            test_basics
+                .client
+                .send_command(cmd("SCRIPT").arg("FLUSH"), None)
+                .await
+                .unwrap();
+            let result = test_basics
+                .client
+                .invoke_script(
+                    &hash,
+                    &vec![key.as_bytes()],
+                    &vec![b"second".as_slice()],
+                    None,
+                )
+                .await;
+            assert_eq!(result, Ok(Value::BulkString(b"second".to_vec())));
+            let exists = test_basics
+                .client
+                .send_command(&script_exists, None)
+                .await
+                .unwrap();
+            assert_eq!(Vec::<bool>::from_redis_value(&exists).unwrap(), vec![true]);
+        });
+    }
 }
@@ -373,6 +373,19 @@ mod standalone_client_tests {
         });
     }
 
+    #[rstest]
+    #[serial_test::serial]
+    #[timeout(SHORT_STANDALONE_TEST_TIMEOUT)]
+    fn test_read_from_lowest_latency_read_from_primary_if_no_replica_is_connected() {
+        test_read_from_replica(ReadFromReplicaTestConfig {
+            read_from: ReadFrom::LowestLatency,
+            expected_primary_reads: 3,
+            expected_replica_reads: vec![],
+            number_of_missing_replicas: 3,
+            ..Default::default()
+        });
+    }
+
     #[rstest]
     #[serial_test::serial]
     #[timeout(SHORT_STANDALONE_TEST_TIMEOUT)]
@@ -401,6 +414,61 @@ mod standalone_client_tests {
         });
     }
 
+    #[rstest]
+    #[serial_test::serial]
+    #[timeout(SHORT_STANDALONE_TEST_TIMEOUT)]
+    fn test_slow_read_is_hedged_to_another_replica() {
+        const WARM_UP_READS: usize = 100;
+        let servers = create_primary_mock_with_replicas(2);
+        let mut cmd = redis::cmd("GET");
+        cmd.arg("foo");
+
+        let mut connection_request =
+            create_connection_request(&get_mock_addresses(&servers), &Default::default());
+        connection_request.read_from = ReadFrom::PreferReplica.into();
+        connection_request.read_hedging_percentile = 50.0;
+
+        block_on_all(async {
+            let mut client = GlideClient::new(connection_request.into(), None)
+                .await
+                .unwrap();
+            for server in servers.iter().skip(1) {
+                for _ in 0..WARM_UP_READS / 2 {
+                    server.add_response(&cmd, "$-1\r\n".to_string());
+                }
+            }
+
+            // No read is hedged before the latencies of these are known.
+            client.send_command(&cmd, None).await.unwrap();
+            let (first, other) = if servers[1].get_number_of_received_commands() == 1 {
+                (&servers[1], &servers[2])
+            } else {
+                (&servers[2], &servers[1])
+            };
+            for _ in 1..WARM_UP_READS {
+                client.send_command(&cmd, None).await.unwrap();
+            }
+            assert_eq!(first.get_number_of_received_commands(), 50);
+            assert_eq!(other.get_number_of_received_commands(), 50);
+
+            // Round robin sends the next read to the first replica again, which stalls, so the
+            // hedge goes to the other replica and its reply wins.
+            first.add_delayed_response(
+                &cmd,
+                "$4\r\nslow\r\n".to_string(),
+                std::time::Duration::from_secs(3),
+            );
+            other.add_response(&cmd, "$4\r\nfast\r\n".to_string());
+            let started = std::time::Instant::now();
+            let value = client.send_command(&cmd, None).await.unwrap();
+            assert_eq!(value, Value::BulkString(b"fast".to_vec()));
+            assert!(started.elapsed() < std::time::Duration::from_secs(1));
+            assert_eq!(first.get_number_of_received_commands(), 51);
+            assert_eq!(other.get_number_of_received_commands(), 51);
+        });
+        assert_eq!(servers[0].get_number_of_received_commands(), 0);
+    }
+
     #[rstest]
     #[timeout(SHORT_STANDALONE_TEST_TIMEOUT)]
     fn test_send_acl_request_to_all_nodes() {
@@ -13,11 +13,13 @@ use std::sync::{
     Arc,
     atomic::{AtomicU16, Ordering},
 };
+use std::time::Duration;
 use tokio::sync::mpsc::UnboundedSender;
 
 pub struct MockedRequest {
     pub expected_message: String,
     pub response: String,
+    pub delay: Duration,
 }
 
 pub struct ServerMock {
@@ -108,6 +110,7 @@ fn receive_and_respond_to_next_message(
     };
     received_commands.fetch_add(1, Ordering::AcqRel);
     assert_eq!(message, request.expected_message);
+    std::thread::sleep(request.delay);
     socket.write_all(request.response.as_bytes()).unwrap();
     true
 }
@@ -117,6 +120,9 @@ pub trait Mock {
 
     fn add_response(&self, request: &Cmd, response: String);
 
+    /// Like `add_response`, but the response is only written after `delay`.
+    fn add_delayed_response(&self, request: &Cmd, response: String, delay: Duration);
+
     fn get_number_of_received_commands(&self) -> u16;
 }
 
@@ -189,10 +195,15 @@ impl Mock for ServerMock {
     }
 
     fn add_response(&self, request: &Cmd, response: String) {
+        self.add_delayed_response(request, response, Duration::ZERO);
+    }
+
+    fn add_delayed_response(&self, request: &Cmd, response: String, delay: Duration) {
         let expected_message = String::from_utf8(request.get_packed_command()).unwrap();
         let _ = self.request_sender.send(MockedRequest {
             expected_message,
             response,
+            delay,
         });
     }
 
@@ -252,6 +252,18 @@ create_log!(log_info, INFO);
 create_log!(log_warn, WARN);
 create_log!(log_error, ERROR);
 
+/// Whether a log of the given level would be recorded, so that callers can skip formatting a
+/// message that would be dropped anyway. Checking is a single atomic load.
+pub fn log_enabled(log_level: Level) -> bool {
+    if INITIATE_ONCE.init_once.get().is_none() {
+        init(Some(Level::Warn), None);
+    };
+    match log_level {
+        Level::Off => false,
+        level => level.to_filter() <= LevelFilter::current(),
+    }
+}
+
 // Logs the given log, with log_identifier and log level prefixed. If the given log level is below the threshold of given when the logger was initialized, the log will be ignored.
 // log_identifier should be used to add context to a log, and make it easier to connect it to other relevant logs. For example, it can be used to pass a task identifier.
 // If this is called before a logger was initialized the log will not be registered.
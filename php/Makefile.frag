@@ -12,6 +12,8 @@ else
         VALKEY_GLIDE_SHARED_LIBADD = ../ffi/target/release/libglide_ffi.a -lresolv -lprotobuf-c
     endif
 endif
+# Libraries of the optional compression codecs, from configure
+VALKEY_GLIDE_SHARED_LIBADD += $(VALKEY_GLIDE_EXTRA_LIBS)
 INCLUDES += -Iinclude
 PROTOC = protoc
 PROTOC_C_PLUGIN := protoc-c
@@ -67,13 +69,21 @@ cluster_scan_cursor_arginfo.h: cluster_scan_cursor.stub.php
 	@echo "Generating arginfo from cluster_scan_cursor.stub.php"
 	$(PHP_EXECUTABLE) build/gen_stub.php --no-legacy-arginfo cluster_scan_cursor.stub.php
 
-ARGINFO_HEADERS = valkey_glide_arginfo.h valkey_glide_cluster_arginfo.h cluster_scan_cursor_arginfo.h
+cluster_scan_iterator_arginfo.h: cluster_scan_iterator.stub.php
+	@echo "Generating arginfo from cluster_scan_iterator.stub.php"
+	$(PHP_EXECUTABLE) build/gen_stub.php --no-legacy-arginfo cluster_scan_iterator.stub.php
+
+collection_scan_iterator_arginfo.h: collection_scan_iterator.stub.php
+	@echo "Generating arginfo from collection_scan_iterator.stub.php"
+	$(PHP_EXECUTABLE) build/gen_stub.php --no-legacy-arginfo collection_scan_iterator.stub.php
+
+ARGINFO_HEADERS = valkey_glide_arginfo.h valkey_glide_cluster_arginfo.h cluster_scan_cursor_arginfo.h cluster_scan_iterator_arginfo.h collection_scan_iterator_arginfo.h
 
 all: $(ARGINFO_HEADERS)
 
 .PHONY: build-modules-pre
 
-build-modules-pre: valkey_glide_arginfo.h valkey_glide_cluster_arginfo.h cluster_scan_cursor_arginfo.h
+build-modules-pre: valkey_glide_arginfo.h valkey_glide_cluster_arginfo.h cluster_scan_cursor_arginfo.h cluster_scan_iterator_arginfo.h collection_scan_iterator_arginfo.h
 	@$(MAKE) generate-proto
 	@$(MAKE) generate-bindings
 
@@ -49,9 +49,11 @@ zend_object* create_cluster_scan_cursor_object(zend_class_entry* ce) {
 void free_cluster_scan_cursor_object(zend_object* object) {
     cluster_scan_cursor_object* cursor_obj = CLUSTER_SCAN_CURSOR_GET_OBJECT(object);
 
-
-    /* Call FFI function to clean up Rust-side cursor */
-    remove_cluster_scan_cursor(cursor_obj->cursor_id);
+    /* Call FFI function to clean up Rust-side cursor; initial and finished cursors have none */
+    if (cursor_obj->cursor_id && strcmp(cursor_obj->cursor_id, FINISHED_SCAN_CURSOR) != 0 &&
+        strcmp(cursor_obj->cursor_id, "0") != 0) {
+        remove_cluster_scan_cursor(cursor_obj->cursor_id);
+    }
 
     /* Free cursor string */
     if (cursor_obj->cursor_id) {
@@ -0,0 +1,205 @@
+/*
+  +----------------------------------------------------------------------+
+  | ValkeyGlide ClusterScanIterator Implementation                       |
+  +----------------------------------------------------------------------+
+  | Copyright (c) 2023-2025 The PHP Group                                |
+  +----------------------------------------------------------------------+
+  | This source file is subject to version 3.01 of the PHP license,      |
+  | that is bundled with this package in the file LICENSE, and is        |
+  | available through the world-wide-web at the following url:           |
+  | http://www.php.net/license/3_01.txt                                  |
+  +----------------------------------------------------------------------+
+*/
+
+#include "cluster_scan_iterator.h"
+
+#include <zend_exceptions.h>
+#include <zend_interfaces.h>
+
+#include "cluster_scan_iterator_arginfo.h"
+#include "command_response.h"
+
+/* Global variables */
+zend_class_entry*    cluster_scan_iterator_ce;
+zend_object_handlers cluster_scan_iterator_object_handlers;
+
+/* Object creation and destruction */
+zend_object* create_cluster_scan_iterator_object(zend_class_entry* ce) {
+    cluster_scan_iterator_object* iter_obj =
+        ecalloc(1, sizeof(cluster_scan_iterator_object) + zend_object_properties_size(ce));
+
+    zend_object_std_init(&iter_obj->std, ce);
+    object_properties_init(&iter_obj->std, ce);
+
+    iter_obj->scan = NULL;
+    ZVAL_UNDEF(&iter_obj->batch);
+
+    memcpy(&cluster_scan_iterator_object_handlers,
+           zend_get_std_object_handlers(),
+           sizeof(cluster_scan_iterator_object_handlers));
+    cluster_scan_iterator_object_handlers.offset    = XtOffsetOf(cluster_scan_iterator_object, std);
+    cluster_scan_iterator_object_handlers.free_obj  = free_cluster_scan_iterator_object;
+    cluster_scan_iterator_object_handlers.clone_obj = NULL;
+    iter_obj->std.handlers                          = &cluster_scan_iterator_object_handlers;
+
+    return &iter_obj->std;
+}
+
+static void finish_scan(cluster_scan_iterator_object* iter_obj) {
+    /* Stops the scan on the Rust side if it is still running */
+    if (iter_obj->scan) {
+        free_parallel_cluster_scan(iter_obj->scan);
+        iter_obj->scan = NULL;
+    }
+}
+
+void free_cluster_scan_iterator_object(zend_object* object) {
+    cluster_scan_iterator_object* iter_obj = CLUSTER_SCAN_ITERATOR_GET_OBJECT(object);
+
+    finish_scan(iter_obj);
+    zval_ptr_dtor(&iter_obj->batch);
+    ZVAL_UNDEF(&iter_obj->batch);
+
+    /* Clean up the standard object */
+    zend_object_std_dtor(&iter_obj->std);
+}
+
+/**
+ * Replaces the current batch with the next one holding keys, waiting for the scan to find them.
+ * Leaves no batch once the scan is finished. Throws and returns false if the scan failed.
+ */
+static bool fetch_batch(cluster_scan_iterator_object* iter_obj) {
+    zval_ptr_dtor(&iter_obj->batch);
+    ZVAL_UNDEF(&iter_obj->batch);
+    iter_obj->position = 0;
+
+    while (iter_obj->scan) {
+        CommandResult* result = next_parallel_cluster_scan_batch(iter_obj->scan);
+        if (!result) {
+            /* Every key was returned */
+            finish_scan(iter_obj);
+            return true;
+        }
+
+        if (result->command_error) {
+            zend_throw_exception_ex(zend_ce_exception,
+                                    0,
+                                    "Parallel cluster scan failed: %s",
+                                    result->command_error->command_error_message
+                                        ? result->command_error->command_error_message
+                                        : "unknown error");
+            free_command_result(result);
+            finish_scan(iter_obj);
+            return false;
+        }
+
+        zval batch;
+        ZVAL_UNDEF(&batch);
+        if (command_response_to_zval(result->response, &batch, 0, false) == 1 &&
+            Z_TYPE(batch) == IS_ARRAY && zend_hash_num_elements(Z_ARRVAL(batch)) > 0) {
+            ZVAL_COPY_VALUE(&iter_obj->batch, &batch);
+            free_command_result(result);
+            return true;
+        }
+        zval_ptr_dtor(&batch);
+        free_command_result(result);
+    }
+    return true;
+}
+
+static zval* current_key(cluster_scan_iterator_object* iter_obj) {
+    if (Z_TYPE(iter_obj->batch) != IS_ARRAY) {
+        return NULL;
+    }
+    return zend_hash_index_find(Z_ARRVAL(iter_obj->batch), iter_obj->position);
+}
+
+void cluster_scan_iterator_init(zval* return_value, ParallelClusterScan* scan) {
+    object_init_ex(return_value, cluster_scan_iterator_ce);
+    cluster_scan_iterator_object* iter_obj = CLUSTER_SCAN_ITERATOR_ZVAL_GET_OBJECT(return_value);
+    iter_obj->scan                         = scan;
+}
+
+/* Class methods implementation */
+
+/**
+ * Constructor: instances are only created by ValkeyGlideCluster::scanParallel
+ */
+PHP_METHOD(ClusterScanIterator, __construct) {
+    ZEND_PARSE_PARAMETERS_NONE();
+}
+
+/**
+ * current(): Returns the current key
+ */
+PHP_METHOD(ClusterScanIterator, current) {
+    ZEND_PARSE_PARAMETERS_NONE();
+
+    zval* key = current_key(CLUSTER_SCAN_ITERATOR_ZVAL_GET_OBJECT(getThis()));
+    if (key) {
+        RETURN_COPY(key);
+    }
+    RETURN_NULL();
+}
+
+/**
+ * key(): Returns the position of the current key in the scan
+ */
+PHP_METHOD(ClusterScanIterator, key) {
+    cluster_scan_iterator_object* iter_obj;
+
+    ZEND_PARSE_PARAMETERS_NONE();
+
+    iter_obj = CLUSTER_SCAN_ITERATOR_ZVAL_GET_OBJECT(getThis());
+    RETURN_LONG(iter_obj->index);
+}
+
+/**
+ * next(): Moves to the next key, fetching the next batch once the current one is exhausted
+ */
+PHP_METHOD(ClusterScanIterator, next) {
+    cluster_scan_iterator_object* iter_obj;
+
+    ZEND_PARSE_PARAMETERS_NONE();
+
+    iter_obj = CLUSTER_SCAN_ITERATOR_ZVAL_GET_OBJECT(getThis());
+    if (!current_key(iter_obj)) {
+        return;
+    }
+
+    iter_obj->index++;
+    iter_obj->position++;
+    if (!current_key(iter_obj)) {
+        fetch_batch(iter_obj);
+    }
+}
+
+/**
+ * rewind(): Fetches the first batch; the scan can't be restarted
+ */
+PHP_METHOD(ClusterScanIterator, rewind) {
+    cluster_scan_iterator_object* iter_obj;
+
+    ZEND_PARSE_PARAMETERS_NONE();
+
+    iter_obj = CLUSTER_SCAN_ITERATOR_ZVAL_GET_OBJECT(getThis());
+    if (!iter_obj->started) {
+        iter_obj->started = true;
+        fetch_batch(iter_obj);
+    }
+}
+
+/**
+ * valid(): Checks if the iterator points to a key
+ */
+PHP_METHOD(ClusterScanIterator, valid) {
+    ZEND_PARSE_PARAMETERS_NONE();
+
+    RETURN_BOOL(current_key(CLUSTER_SCAN_ITERATOR_ZVAL_GET_OBJECT(getThis())) != NULL);
+}
+
+/* Class registration function using generated arginfo */
+void register_cluster_scan_iterator_class(void) {
+    cluster_scan_iterator_ce                = register_class_ClusterScanIterator(zend_ce_iterator);
+    cluster_scan_iterator_ce->create_object = create_cluster_scan_iterator_object;
+}
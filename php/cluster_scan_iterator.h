@@ -0,0 +1,46 @@
+#ifndef CLUSTER_SCAN_ITERATOR_H
+#define CLUSTER_SCAN_ITERATOR_H
+
+#include "common.h"
+#include "php.h"
+#include "valkey_glide_commands_common.h"
+
+/* ClusterScanIterator object structure */
+typedef struct {
+    ParallelClusterScan* scan;     /* The running scan, NULL once finished */
+    zval                 batch;    /* The batch of keys being iterated */
+    uint32_t             position; /* Position of the current key in the batch */
+    zend_long            index;    /* Position of the current key in the whole scan */
+    bool                 started;  /* Whether the first batch was fetched */
+    zend_object          std;      /* Standard PHP object */
+} cluster_scan_iterator_object;
+
+/* Class entry and handlers */
+extern zend_class_entry*    cluster_scan_iterator_ce;
+extern zend_object_handlers cluster_scan_iterator_object_handlers;
+
+/* Object creation and destruction */
+zend_object* create_cluster_scan_iterator_object(zend_class_entry* ce);
+void         free_cluster_scan_iterator_object(zend_object* object);
+
+/* Class methods */
+PHP_METHOD(ClusterScanIterator, __construct);
+PHP_METHOD(ClusterScanIterator, current);
+PHP_METHOD(ClusterScanIterator, key);
+PHP_METHOD(ClusterScanIterator, next);
+PHP_METHOD(ClusterScanIterator, rewind);
+PHP_METHOD(ClusterScanIterator, valid);
+
+/* Helper macros */
+#define CLUSTER_SCAN_ITERATOR_GET_OBJECT(obj) \
+    VALKEY_GLIDE_PHP_GET_OBJECT(cluster_scan_iterator_object, obj)
+#define CLUSTER_SCAN_ITERATOR_ZVAL_GET_OBJECT(zv) \
+    VALKEY_GLIDE_PHP_ZVAL_GET_OBJECT(cluster_scan_iterator_object, zv)
+
+/* Wraps a scan started with start_parallel_cluster_scan in a new ClusterScanIterator */
+void cluster_scan_iterator_init(zval* return_value, ParallelClusterScan* scan);
+
+/* Class registration function */
+void register_cluster_scan_iterator_class(void);
+
+#endif /* CLUSTER_SCAN_ITERATOR_H */
@@ -0,0 +1,57 @@
+<?php
+
+/**
+ * @generate-function-entries
+ * @generate-legacy-arginfo
+ * @generate-class-entries
+ */
+
+/**
+ * ClusterScanIterator iterates over the keys of a parallel cluster scan.
+ *
+ * The keys are scanned on several nodes at once and fetched in batches as the
+ * iteration advances. The scan can only be iterated once; rewinding it after
+ * the first key was read has no effect.
+ */
+final class ClusterScanIterator implements Iterator {
+
+    /**
+     * ClusterScanIterator instances are returned by ValkeyGlideCluster::scanParallel.
+     */
+    private function __construct() {}
+
+    /**
+     * Get the current key.
+     *
+     * @return string|null The current key, or null once the scan is finished
+     */
+    public function current(): ?string {}
+
+    /**
+     * Get the position of the current key in the scan.
+     *
+     * @return int The position, starting at 0
+     */
+    public function key(): int {}
+
+    /**
+     * Move to the next key, waiting for the next batch if needed.
+     *
+     * @throws Exception If the scan failed
+     */
+    public function next(): void {}
+
+    /**
+     * Start the iteration, waiting for the first batch.
+     *
+     * @throws Exception If the scan failed
+     */
+    public function rewind(): void {}
+
+    /**
+     * Check if the iterator points to a key.
+     *
+     * @return bool False once every key was returned
+     */
+    public function valid(): bool {}
+}
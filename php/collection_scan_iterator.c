@@ -0,0 +1,387 @@
+/*
+  +----------------------------------------------------------------------+
+  | ValkeyGlide CollectionScanIterator Implementation                    |
+  +----------------------------------------------------------------------+
+  | Copyright (c) 2023-2025 The PHP Group                                |
+  +----------------------------------------------------------------------+
+  | This source file is subject to version 3.01 of the PHP license,      |
+  | that is bundled with this package in the file LICENSE, and is        |
+  | available through the world-wide-web at the following url:           |
+  | http://www.php.net/license/3_01.txt                                  |
+  +----------------------------------------------------------------------+
+*/
+
+#include "collection_scan_iterator.h"
+
+#include <zend_exceptions.h>
+#include <zend_interfaces.h>
+
+#include "collection_scan_iterator_arginfo.h"
+#include "command_response.h"
+#include "valkey_glide_s_common.h"
+
+/* Global variables */
+zend_class_entry*    collection_scan_iterator_ce;
+zend_object_handlers collection_scan_iterator_object_handlers;
+
+/* Object creation and destruction */
+zend_object* create_collection_scan_iterator_object(zend_class_entry* ce) {
+    collection_scan_iterator_object* iter_obj =
+        ecalloc(1, sizeof(collection_scan_iterator_object) + zend_object_properties_size(ce));
+
+    zend_object_std_init(&iter_obj->std, ce);
+    object_properties_init(&iter_obj->std, ce);
+
+    ZVAL_UNDEF(&iter_obj->client);
+    ZVAL_UNDEF(&iter_obj->page);
+    iter_obj->key     = NULL;
+    iter_obj->pattern = NULL;
+    iter_obj->pending = NULL;
+
+    memcpy(&collection_scan_iterator_object_handlers,
+           zend_get_std_object_handlers(),
+           sizeof(collection_scan_iterator_object_handlers));
+    collection_scan_iterator_object_handlers.offset =
+        XtOffsetOf(collection_scan_iterator_object, std);
+    collection_scan_iterator_object_handlers.free_obj  = free_collection_scan_iterator_object;
+    collection_scan_iterator_object_handlers.clone_obj = NULL;
+    iter_obj->std.handlers                             = &collection_scan_iterator_object_handlers;
+
+    return &iter_obj->std;
+}
+
+static void drop_pending_page(collection_scan_iterator_object* iter_obj) {
+    /* The reply is dropped on the Rust side when it arrives */
+    if (iter_obj->pending) {
+        free_pending_command(iter_obj->pending);
+        iter_obj->pending = NULL;
+    }
+}
+
+void free_collection_scan_iterator_object(zend_object* object) {
+    collection_scan_iterator_object* iter_obj = COLLECTION_SCAN_ITERATOR_GET_OBJECT(object);
+
+    drop_pending_page(iter_obj);
+    zval_ptr_dtor(&iter_obj->page);
+    ZVAL_UNDEF(&iter_obj->page);
+    zval_ptr_dtor(&iter_obj->client);
+    ZVAL_UNDEF(&iter_obj->client);
+    if (iter_obj->key) {
+        zend_string_release(iter_obj->key);
+    }
+    if (iter_obj->pattern) {
+        zend_string_release(iter_obj->pattern);
+    }
+
+    /* Clean up the standard object */
+    zend_object_std_dtor(&iter_obj->std);
+}
+
+static const char* scan_command_name(enum RequestType cmd_type) {
+    switch (cmd_type) {
+        case HScan:
+            return "HSCAN";
+        case SScan:
+            return "SSCAN";
+        default:
+            return "ZSCAN";
+    }
+}
+
+/* Sets always have one element per member, hashes and sorted sets have two */
+static uint32_t element_width(const collection_scan_iterator_object* iter_obj) {
+    return iter_obj->cmd_type == SScan ? 1 : 2;
+}
+
+/**
+ * Sends the request for the page at cursor, without waiting for it.
+ * Returns false if the client isn't connected.
+ */
+static bool send_page(collection_scan_iterator_object* iter_obj,
+                      const char*                      cursor,
+                      size_t                           cursor_len) {
+    valkey_glide_object* valkey_glide =
+        VALKEY_GLIDE_PHP_ZVAL_GET_OBJECT(valkey_glide_object, &iter_obj->client);
+    if (!valkey_glide || !valkey_glide->glide_client) {
+        return false;
+    }
+
+    /* key, cursor, MATCH pattern and COUNT count */
+    uintptr_t     args[6];
+    unsigned long args_len[6];
+    int           arg_count = 0;
+
+    args[arg_count]       = (uintptr_t)ZSTR_VAL(iter_obj->key);
+    args_len[arg_count++] = ZSTR_LEN(iter_obj->key);
+    args[arg_count]       = (uintptr_t)cursor;
+    args_len[arg_count++] = cursor_len;
+    if (iter_obj->pattern) {
+        args[arg_count]       = (uintptr_t)"MATCH";
+        args_len[arg_count++] = 5;
+        args[arg_count]       = (uintptr_t)ZSTR_VAL(iter_obj->pattern);
+        args_len[arg_count++] = ZSTR_LEN(iter_obj->pattern);
+    }
+    size_t count_len      = 0;
+    char*  count_str      = alloc_long_string(iter_obj->count, &count_len);
+    args[arg_count]       = (uintptr_t)"COUNT";
+    args_len[arg_count++] = 5;
+    args[arg_count]       = (uintptr_t)count_str;
+    args_len[arg_count++] = count_len;
+
+    iter_obj->pending =
+        start_command(valkey_glide->glide_client, iter_obj->cmd_type, arg_count, args, args_len);
+    efree(count_str);
+    return iter_obj->pending != NULL;
+}
+
+/**
+ * Adapts COUNT to how the last page went: pages the server is slow to return are halved, so
+ * that no single request holds the server up, and pages PHP had to wait for are doubled, so
+ * that fewer round trips are left to wait for.
+ */
+static void adapt_count(collection_scan_iterator_object* iter_obj,
+                        uint64_t                         latency_us,
+                        bool                             was_ready) {
+    if (latency_us > COLLECTION_SCAN_LATENCY_BUDGET_US) {
+        iter_obj->count = MAX(iter_obj->count / 2, iter_obj->min_count);
+    } else if (!was_ready) {
+        iter_obj->count = MIN(iter_obj->count * 2, iter_obj->max_count);
+    }
+}
+
+/**
+ * Replaces the current page with the next one holding elements, waiting for it if it didn't
+ * arrive yet. The request for the following page is sent before the page is converted, so that
+ * it's in flight while PHP iterates. Leaves no page once the scan is finished. Throws and
+ * returns false if the scan failed.
+ */
+static bool fetch_page(collection_scan_iterator_object* iter_obj) {
+    zval_ptr_dtor(&iter_obj->page);
+    ZVAL_UNDEF(&iter_obj->page);
+    iter_obj->position = 0;
+
+    while (iter_obj->pending) {
+        uint64_t latency_us = 0;
+        bool     was_ready  = false;
+
+        CommandResult* result = wait_pending_command(iter_obj->pending, &latency_us, &was_ready);
+        drop_pending_page(iter_obj);
+
+        if (!result) {
+            return true;
+        }
+        if (result->command_error) {
+            zend_throw_exception_ex(zend_ce_exception,
+                                    0,
+                                    "%s failed: %s",
+                                    scan_command_name(iter_obj->cmd_type),
+                                    result->command_error->command_error_message
+                                        ? result->command_error->command_error_message
+                                        : "unknown error");
+            free_command_result(result);
+            return false;
+        }
+
+        /* [cursor, [elements]] */
+        CommandResponse* response = result->response;
+        if (!response || response->response_type != Array || response->array_value_len < 2 ||
+            response->array_value[0].response_type != String ||
+            response->array_value[1].response_type != Array) {
+            zend_throw_exception_ex(zend_ce_exception,
+                                    0,
+                                    "%s failed: unexpected reply",
+                                    scan_command_name(iter_obj->cmd_type));
+            free_command_result(result);
+            return false;
+        }
+
+        adapt_count(iter_obj, latency_us, was_ready);
+
+        CommandResponse* cursor = &response->array_value[0];
+        if (!(cursor->string_value_len == 1 && cursor->string_value[0] == '0') &&
+            !send_page(iter_obj, cursor->string_value, cursor->string_value_len)) {
+            zend_throw_exception_ex(zend_ce_exception,
+                                    0,
+                                    "%s failed: the client is closed",
+                                    scan_command_name(iter_obj->cmd_type));
+            free_command_result(result);
+            return false;
+        }
+
+        zval page;
+        ZVAL_UNDEF(&page);
+        if (command_response_to_zval(
+                &response->array_value[1], &page, COMMAND_RESPONSE_NOT_ASSOSIATIVE, false) == 1 &&
+            Z_TYPE(page) == IS_ARRAY && zend_hash_num_elements(Z_ARRVAL(page)) > 0) {
+            ZVAL_COPY_VALUE(&iter_obj->page, &page);
+            free_command_result(result);
+            return true;
+        }
+        zval_ptr_dtor(&page);
+        free_command_result(result);
+    }
+    return true;
+}
+
+static zval* page_element(collection_scan_iterator_object* iter_obj, uint32_t offset) {
+    if (Z_TYPE(iter_obj->page) != IS_ARRAY) {
+        return NULL;
+    }
+    return zend_hash_index_find(Z_ARRVAL(iter_obj->page), iter_obj->position + offset);
+}
+
+int execute_collection_scan_iterator(zval*             object,
+                                     int               argc,
+                                     zval*             return_value,
+                                     zend_class_entry* ce,
+                                     enum RequestType  cmd_type) {
+    valkey_glide_object* valkey_glide;
+    zend_string *        key = NULL, *pattern = NULL;
+    zend_long            count = 0, max_count = 0;
+
+    if (zend_parse_method_parameters(
+            argc, object, "OS|S!ll", &object, ce, &key, &pattern, &count, &max_count) ==
+        FAILURE) {
+        return 0;
+    }
+
+    valkey_glide = VALKEY_GLIDE_PHP_ZVAL_GET_OBJECT(valkey_glide_object, object);
+    if (!valkey_glide || !valkey_glide->glide_client) {
+        return 0;
+    }
+
+    object_init_ex(return_value, collection_scan_iterator_ce);
+    collection_scan_iterator_object* iter_obj =
+        COLLECTION_SCAN_ITERATOR_ZVAL_GET_OBJECT(return_value);
+
+    /* 0 leaves the defaults; a maximum equal to the count keeps it fixed */
+    iter_obj->count     = count > 0 ? count : COLLECTION_SCAN_DEFAULT_COUNT;
+    iter_obj->min_count = MIN(iter_obj->count, COLLECTION_SCAN_MIN_COUNT);
+    iter_obj->max_count = max_count > 0 ? MAX(max_count, iter_obj->count)
+                                        : iter_obj->count * COLLECTION_SCAN_MAX_COUNT_FACTOR;
+    if (max_count > 0 && max_count <= iter_obj->count) {
+        iter_obj->min_count = iter_obj->count;
+    }
+    iter_obj->cmd_type = cmd_type;
+    iter_obj->key      = zend_string_copy(key);
+    if (pattern && ZSTR_LEN(pattern) > 0) {
+        iter_obj->pattern = zend_string_copy(pattern);
+    }
+    ZVAL_COPY(&iter_obj->client, object);
+
+    /* The first page is requested right away, so it's on its way before the loop starts */
+    if (!send_page(iter_obj, "0", 1)) {
+        zval_ptr_dtor(return_value);
+        ZVAL_UNDEF(return_value);
+        return 0;
+    }
+    return 1;
+}
+
+/* Class methods implementation */
+
+/**
+ * Constructor: instances are only created by hscanIterator(), sscanIterator() and zscanIterator()
+ */
+PHP_METHOD(CollectionScanIterator, __construct) {
+    ZEND_PARSE_PARAMETERS_NONE();
+}
+
+/**
+ * current(): Returns the value of a hash field, the score of a sorted set member or a set member
+ */
+PHP_METHOD(CollectionScanIterator, current) {
+    collection_scan_iterator_object* iter_obj;
+
+    ZEND_PARSE_PARAMETERS_NONE();
+
+    iter_obj      = COLLECTION_SCAN_ITERATOR_ZVAL_GET_OBJECT(getThis());
+    zval* element = page_element(iter_obj, element_width(iter_obj) - 1);
+    if (!element) {
+        RETURN_NULL();
+    }
+    if (iter_obj->cmd_type == ZScan) {
+        RETURN_DOUBLE(zval_get_double(element));
+    }
+    RETURN_COPY(element);
+}
+
+/**
+ * key(): Returns the hash field or sorted set member, or the position of the set member
+ */
+PHP_METHOD(CollectionScanIterator, key) {
+    collection_scan_iterator_object* iter_obj;
+
+    ZEND_PARSE_PARAMETERS_NONE();
+
+    iter_obj = COLLECTION_SCAN_ITERATOR_ZVAL_GET_OBJECT(getThis());
+    if (iter_obj->cmd_type == SScan) {
+        RETURN_LONG(iter_obj->index);
+    }
+    zval* element = page_element(iter_obj, 0);
+    if (element) {
+        RETURN_COPY(element);
+    }
+    RETURN_NULL();
+}
+
+/**
+ * next(): Moves to the next element, fetching the next page once the current one is exhausted
+ */
+PHP_METHOD(CollectionScanIterator, next) {
+    collection_scan_iterator_object* iter_obj;
+
+    ZEND_PARSE_PARAMETERS_NONE();
+
+    iter_obj = COLLECTION_SCAN_ITERATOR_ZVAL_GET_OBJECT(getThis());
+    if (!page_element(iter_obj, 0)) {
+        return;
+    }
+
+    iter_obj->index++;
+    iter_obj->position += element_width(iter_obj);
+    if (!page_element(iter_obj, 0)) {
+        fetch_page(iter_obj);
+    }
+}
+
+/**
+ * rewind(): Fetches the first page, restarting the scan if it was already iterated
+ */
+PHP_METHOD(CollectionScanIterator, rewind) {
+    collection_scan_iterator_object* iter_obj;
+
+    ZEND_PARSE_PARAMETERS_NONE();
+
+    iter_obj = COLLECTION_SCAN_ITERATOR_ZVAL_GET_OBJECT(getThis());
+    if (iter_obj->started) {
+        drop_pending_page(iter_obj);
+        iter_obj->index = 0;
+        if (!send_page(iter_obj, "0", 1)) {
+            zval_ptr_dtor(&iter_obj->page);
+            ZVAL_UNDEF(&iter_obj->page);
+            zend_throw_exception_ex(zend_ce_exception,
+                                    0,
+                                    "%s failed: the client is closed",
+                                    scan_command_name(iter_obj->cmd_type));
+            return;
+        }
+    }
+    iter_obj->started = true;
+    fetch_page(iter_obj);
+}
+
+/**
+ * valid(): Checks if the iterator points to an element
+ */
+PHP_METHOD(CollectionScanIterator, valid) {
+    ZEND_PARSE_PARAMETERS_NONE();
+
+    RETURN_BOOL(page_element(COLLECTION_SCAN_ITERATOR_ZVAL_GET_OBJECT(getThis()), 0) != NULL);
+}
+
+/* Class registration function using generated arginfo */
+void register_collection_scan_iterator_class(void) {
+    collection_scan_iterator_ce = register_class_CollectionScanIterator(zend_ce_iterator);
+    collection_scan_iterator_ce->create_object = create_collection_scan_iterator_object;
+}
@@ -0,0 +1,84 @@
+#ifndef COLLECTION_SCAN_ITERATOR_H
+#define COLLECTION_SCAN_ITERATOR_H
+
+#include "common.h"
+#include "php.h"
+#include "valkey_glide_commands_common.h"
+
+/* COUNT used when the caller doesn't give one */
+#define COLLECTION_SCAN_DEFAULT_COUNT 100
+/* COUNT is never lowered below this, nor below the COUNT given by the caller */
+#define COLLECTION_SCAN_MIN_COUNT 10
+/* Without a maximum, COUNT grows up to this many times its initial value */
+#define COLLECTION_SCAN_MAX_COUNT_FACTOR 16
+/* Pages the server takes longer than this to reply are made smaller */
+#define COLLECTION_SCAN_LATENCY_BUDGET_US 10000
+
+/* CollectionScanIterator object structure */
+typedef struct {
+    zval             client;    /* The ValkeyGlide or ValkeyGlideCluster object, kept alive */
+    enum RequestType cmd_type;  /* HScan, SScan or ZScan */
+    zend_string*     key;       /* The scanned key */
+    zend_string*     pattern;   /* MATCH pattern, NULL to match everything */
+    zend_long        count;     /* COUNT of the next page */
+    zend_long        min_count; /* Lowest COUNT the latency can bring it down to */
+    zend_long        max_count; /* Highest COUNT waiting for pages can bring it up to */
+    PendingCommand*  pending;   /* The next page, NULL once the last page was received */
+    zval             page;      /* Flat array of the elements being iterated */
+    uint32_t         position;  /* Position of the current element in the page */
+    zend_long        index;     /* Position of the current element in the whole scan */
+    bool             started;   /* Whether the first page was fetched */
+    zend_object      std;       /* Standard PHP object */
+} collection_scan_iterator_object;
+
+/* Class entry and handlers */
+extern zend_class_entry*    collection_scan_iterator_ce;
+extern zend_object_handlers collection_scan_iterator_object_handlers;
+
+/* Object creation and destruction */
+zend_object* create_collection_scan_iterator_object(zend_class_entry* ce);
+void         free_collection_scan_iterator_object(zend_object* object);
+
+/* Class methods */
+PHP_METHOD(CollectionScanIterator, __construct);
+PHP_METHOD(CollectionScanIterator, current);
+PHP_METHOD(CollectionScanIterator, key);
+PHP_METHOD(CollectionScanIterator, next);
+PHP_METHOD(CollectionScanIterator, rewind);
+PHP_METHOD(CollectionScanIterator, valid);
+
+/* Helper macros */
+#define COLLECTION_SCAN_ITERATOR_GET_OBJECT(obj) \
+    VALKEY_GLIDE_PHP_GET_OBJECT(collection_scan_iterator_object, obj)
+#define COLLECTION_SCAN_ITERATOR_ZVAL_GET_OBJECT(zv) \
+    VALKEY_GLIDE_PHP_ZVAL_GET_OBJECT(collection_scan_iterator_object, zv)
+
+/*
+ * Implements hscanIterator(), sscanIterator() and zscanIterator(): parses
+ * (key, ?pattern, count, maxCount), sends the first page and returns the iterator.
+ * Returns 0 if the arguments are invalid or the client isn't connected
+ */
+int execute_collection_scan_iterator(zval*             object,
+                                     int               argc,
+                                     zval*             return_value,
+                                     zend_class_entry* ce,
+                                     enum RequestType  cmd_type);
+
+#define COLLECTION_SCAN_ITERATOR_METHOD_IMPL(class_name, method_name, cmd_type)             \
+    PHP_METHOD(class_name, method_name) {                                                   \
+        if (execute_collection_scan_iterator(getThis(),                                     \
+                                             ZEND_NUM_ARGS(),                               \
+                                             return_value,                                  \
+                                             strcmp(#class_name, "ValkeyGlideCluster") == 0 \
+                                                 ? get_valkey_glide_cluster_ce()            \
+                                                 : get_valkey_glide_ce(),                   \
+                                             cmd_type)) {                                   \
+            return;                                                                         \
+        }                                                                                   \
+        RETURN_FALSE;                                                                       \
+    }
+
+/* Class registration function */
+void register_collection_scan_iterator_class(void);
+
+#endif /* COLLECTION_SCAN_ITERATOR_H */
@@ -0,0 +1,67 @@
+<?php
+
+/**
+ * @generate-function-entries
+ * @generate-legacy-arginfo
+ * @generate-class-entries
+ */
+
+/**
+ * CollectionScanIterator iterates over the elements of a hash, set or sorted set
+ * with HSCAN, SSCAN or ZSCAN.
+ *
+ * The next page is requested as soon as a page arrives, so that it is on its
+ * way while the current page is iterated. The COUNT of the requests adapts to
+ * how the pages go: it is halved when the server takes more than 10ms to
+ * return a page, and doubled, up to the maximum, when the iteration had to
+ * wait for a page. Rewinding the iterator restarts the scan.
+ *
+ * Like the SCAN commands, elements changed during the iteration may be
+ * returned more than once, or not at all.
+ */
+final class CollectionScanIterator implements Iterator {
+
+    /**
+     * CollectionScanIterator instances are returned by hscanIterator, sscanIterator
+     * and zscanIterator.
+     */
+    private function __construct() {}
+
+    /**
+     * Get the current element.
+     *
+     * @return string|float|null The value of the hash field, the score of the
+     *                           sorted set member or the set member, or null
+     *                           once the scan is finished
+     */
+    public function current(): string|float|null {}
+
+    /**
+     * Get the key of the current element.
+     *
+     * @return string|int|null The hash field, the sorted set member or the
+     *                         position of the set member in the scan
+     */
+    public function key(): string|int|null {}
+
+    /**
+     * Move to the next element, waiting for the next page if needed.
+     *
+     * @throws Exception If the scan failed
+     */
+    public function next(): void {}
+
+    /**
+     * Start the scan over, waiting for its first page.
+     *
+     * @throws Exception If the scan failed
+     */
+    public function rewind(): void {}
+
+    /**
+     * Check if the iterator points to an element.
+     *
+     * @return bool False once every element was returned
+     */
+    public function valid(): bool {}
+}
@@ -16,66 +16,109 @@
 #include "command_response.h"
 
 #include "ext/standard/php_var.h"
-#include "include/glide/command_request.pb-c.h"
 #include "include/glide/response.pb-c.h"
 #include "include/glide_bindings.h"
+#include "valkey_glide_cluster_fanout.h"
 #include "valkey_glide_commands_common.h"
+#include "valkey_glide_near_cache.h"
+#include "valkey_glide_otel.h"
+#include "valkey_glide_serializer.h"
 
-/* Parse a cluster route from a zval parameter */
-typedef struct {
-    enum {
-        ROUTE_TYPE_KEY,       /* Route by key */
-        ROUTE_TYPE_HOST_PORT, /* Route by host:port */
-        ROUTE_TYPE_SIMPLE     /* Simple route: "randomNode", "allPrimaries", "allNodes" */
-    } type;
-
-    union {
-        struct {
-            char*  key;
-            size_t key_len;
-            int    key_allocated; /* Flag to indicate if key was dynamically allocated */
-        } key_route;
-
-        struct {
-            char* host;
-            int   port;
-        } host_port_route;
-
-        int simple_route_type; /* Using SimpleRoutes_C enum values */
-    } data;
-} cluster_route_t;
-
-/* Parse a cluster route parameter from a zval */
-int parse_cluster_route(zval* route_zval, cluster_route_t* route) {
-    /* Default to route by key */
-    route->type                         = ROUTE_TYPE_KEY;
-    route->data.key_route.key_allocated = 0;
+/*
+ * Routes are passed to the core as a RouteInfo, read in place instead of being packed into a
+ * Protobuf message and decoded again. Keys are routed by their hash slot, computed here, so
+ * no route holds a pointer to a key. The keyword routes are built once.
+ */
+static const RouteInfo random_node_route   = {.route_type = Random};
+static const RouteInfo all_primaries_route = {.route_type = AllPrimaries};
+static const RouteInfo all_nodes_route     = {.route_type = AllNodes};
+
+static const RouteInfo* slot_route(RouteInfo* route, const char* key, size_t key_len) {
+    if (key_len == 0) {
+        return NULL;
+    }
+    route->route_type = SlotId;
+    route->slot_id    = valkey_glide_key_slot(key, key_len);
+    route->slot_type  = Primary;
+    return route;
+}
+
+/* Helper: whether a string is valid UTF-8, as the core reads the host as a Rust string */
+static bool is_valid_utf8(const unsigned char* str, size_t len) {
+    size_t i = 0;
+    while (i < len) {
+        unsigned char c = str[i];
+        size_t        n;
+        uint32_t      code_point;
+        if (c < 0x80) {
+            i++;
+            continue;
+        } else if (c >= 0xC2 && c <= 0xDF) {
+            n          = 1;
+            code_point = c & 0x1F;
+        } else if (c >= 0xE0 && c <= 0xEF) {
+            n          = 2;
+            code_point = c & 0x0F;
+        } else if (c >= 0xF0 && c <= 0xF4) {
+            n          = 3;
+            code_point = c & 0x07;
+        } else {
+            return false;
+        }
+        if (len - i <= n) {
+            return false;
+        }
+        for (size_t j = 1; j <= n; j++) {
+            if ((str[i + j] & 0xC0) != 0x80) {
+                return false;
+            }
+            code_point = (code_point << 6) | (str[i + j] & 0x3F);
+        }
+        /* Reject overlong forms, surrogates and code points past U+10FFFF */
+        if ((n == 2 && code_point < 0x800) || (n == 3 && code_point < 0x10000) ||
+            (code_point >= 0xD800 && code_point <= 0xDFFF) || code_point > 0x10FFFF) {
+            return false;
+        }
+        i += n + 1;
+    }
+    return true;
+}
+
+/* Returns NULL if the host is not valid UTF-8 or holds a NUL byte */
+static const RouteInfo* address_route(RouteInfo* route, zval* host_zv, zval* port_zv) {
+    if (memchr(Z_STRVAL_P(host_zv), '\0', Z_STRLEN_P(host_zv)) ||
+        !is_valid_utf8((const unsigned char*)Z_STRVAL_P(host_zv), Z_STRLEN_P(host_zv))) {
+        return NULL;
+    }
+    route->route_type = ByAddress;
+    route->hostname   = Z_STRVAL_P(host_zv);
+    route->port       = (int32_t)zval_get_long(port_zv);
+    return route;
+}
+
+/*
+ * Parse a cluster route parameter from a zval. Returns the route, pointing either to one of the
+ * keyword routes or to storage, or NULL if the parameter isn't a valid route. An address route
+ * points to the host string of route_zval
+ */
+static const RouteInfo* parse_cluster_route(zval* route_zval, RouteInfo* storage) {
+    memset(storage, 0, sizeof(*storage));
 
     if (Z_TYPE_P(route_zval) == IS_STRING) {
-        char*  route_str = Z_STRVAL_P(route_zval);
-        size_t route_len = Z_STRLEN_P(route_zval);
+        const char* route_str = Z_STRVAL_P(route_zval);
+        size_t      route_len = Z_STRLEN_P(route_zval);
 
         /* Check for special routing keywords */
         if (route_len == 10 && strncasecmp(route_str, "randomNode", 10) == 0) {
-            route->type = ROUTE_TYPE_SIMPLE;
-            route->data.simple_route_type =
-                COMMAND_REQUEST__SIMPLE_ROUTES__Random; /* SimpleRoutes_Random */
-            return 1;
+            return &random_node_route;
         } else if (route_len == 12 && strncasecmp(route_str, "allPrimaries", 12) == 0) {
-            route->type                   = ROUTE_TYPE_SIMPLE;
-            route->data.simple_route_type = COMMAND_REQUEST__SIMPLE_ROUTES__AllPrimaries;
-            return 1;
+            return &all_primaries_route;
         } else if (route_len == 8 && strncasecmp(route_str, "allNodes", 8) == 0) {
-            route->type                   = ROUTE_TYPE_SIMPLE;
-            route->data.simple_route_type = COMMAND_REQUEST__SIMPLE_ROUTES__AllNodes;
-            return 1;
+            return &all_nodes_route;
         }
 
         /* String parameter - use as key */
-        route->type                   = ROUTE_TYPE_KEY;
-        route->data.key_route.key     = route_str;
-        route->data.key_route.key_len = route_len;
-        return 1;
+        return slot_route(storage, route_str, route_len);
     } else if (Z_TYPE_P(route_zval) == IS_ARRAY) {
         HashTable* route_ht = Z_ARRVAL_P(route_zval);
         zval *     type_zv = NULL, *key_zv = NULL, *host_zv = NULL, *port_zv = NULL;
@@ -90,24 +133,13 @@ int parse_cluster_route(zval* route_zval, cluster_route_t* route) {
                 strcasecmp(type_str, "slotKey") == 0) {
                 /* Slot key routing */
                 key_zv = zend_hash_str_find(route_ht, "key", sizeof("key") - 1);
-                if (key_zv && (Z_TYPE_P(key_zv) == IS_STRING || Z_TYPE_P(key_zv) == IS_LONG)) {
-                    route->type                         = ROUTE_TYPE_KEY;
-                    route->data.key_route.key_allocated = 0; /* Initialize flag */
-
-                    if (Z_TYPE_P(key_zv) == IS_STRING) {
-                        /* String key - use directly */
-                        route->data.key_route.key     = Z_STRVAL_P(key_zv);
-                        route->data.key_route.key_len = Z_STRLEN_P(key_zv);
-                    } else if (Z_TYPE_P(key_zv) == IS_LONG) {
-                        /* Integer key - convert to string */
-                        route->data.key_route.key =
-                            long_to_string(Z_LVAL_P(key_zv), &route->data.key_route.key_len);
-                        if (!route->data.key_route.key) {
-                            return 0; /* Memory allocation failed */
-                        }
-                        route->data.key_route.key_allocated = 1; /* Mark as allocated */
-                    }
-                    return 1;
+                if (key_zv && Z_TYPE_P(key_zv) == IS_STRING) {
+                    return slot_route(storage, Z_STRVAL_P(key_zv), Z_STRLEN_P(key_zv));
+                } else if (key_zv && Z_TYPE_P(key_zv) == IS_LONG) {
+                    /* Integer key - hash its decimal form */
+                    char key[MAX_LENGTH_OF_LONG];
+                    int  key_len = snprintf(key, sizeof(key), ZEND_LONG_FMT, Z_LVAL_P(key_zv));
+                    return slot_route(storage, key, key_len);
                 }
             } else if (strcasecmp(type_str, "routeByAddress") == 0) {
                 /* Route by address */
@@ -115,24 +147,11 @@ int parse_cluster_route(zval* route_zval, cluster_route_t* route) {
                 port_zv = zend_hash_str_find(route_ht, "port", sizeof("port") - 1);
 
                 if (host_zv && port_zv && Z_TYPE_P(host_zv) == IS_STRING) {
-                    route->type                      = ROUTE_TYPE_HOST_PORT;
-                    route->data.host_port_route.host = Z_STRVAL_P(host_zv);
-
-                    /* Get port from array */
-                    if (Z_TYPE_P(port_zv) == IS_LONG) {
-                        route->data.host_port_route.port = Z_LVAL_P(port_zv);
-                    } else {
-                        zval temp;
-                        ZVAL_COPY(&temp, port_zv);
-                        convert_to_long(&temp);
-                        route->data.host_port_route.port = Z_LVAL(temp);
-                        zval_dtor(&temp);
-                    }
-                    return 1;
+                    return address_route(storage, host_zv, port_zv);
                 }
             }
 
-            return 0; /* Invalid type-based routing */
+            return NULL; /* Invalid type-based routing */
         }
 
         /* Try direct host/port keys */
@@ -146,120 +165,12 @@ int parse_cluster_route(zval* route_zval, cluster_route_t* route) {
         }
 
         if (host_zv && port_zv && Z_TYPE_P(host_zv) == IS_STRING) {
-            /* Set route type to host:port */
-            route->type = ROUTE_TYPE_HOST_PORT;
-
-            /* Get host from array */
-            route->data.host_port_route.host = Z_STRVAL_P(host_zv);
-
-            /* Get port from array */
-            if (Z_TYPE_P(port_zv) == IS_LONG) {
-                route->data.host_port_route.port = Z_LVAL_P(port_zv);
-            } else {
-                zval temp;
-                ZVAL_COPY(&temp, port_zv);
-                convert_to_long(&temp);
-                route->data.host_port_route.port = Z_LVAL(temp);
-                zval_dtor(&temp);
-            }
-
-            return 1;
+            return address_route(storage, host_zv, port_zv);
         }
     }
 
     /* Could not parse route properly */
-    return 0;
-}
-
-/* Create serialized route bytes from a cluster_route_t structure */
-uint8_t* create_route_bytes_from_route(cluster_route_t* route, size_t* route_bytes_len) {
-    /* Initialize route structure */
-    CommandRequest__Routes routes      = COMMAND_REQUEST__ROUTES__INIT;
-    uint8_t*               route_bytes = NULL;
-
-    /* Validate input parameters */
-    if (!route || !route_bytes_len) {
-        if (route_bytes_len)
-            *route_bytes_len = 0;
-        return NULL;
-    }
-
-    /* Declare protobuf structures outside switch to keep them in scope */
-    CommandRequest__SlotKeyRoute   slot_key_route   = COMMAND_REQUEST__SLOT_KEY_ROUTE__INIT;
-    CommandRequest__ByAddressRoute by_address_route = COMMAND_REQUEST__BY_ADDRESS_ROUTE__INIT;
-    CommandRequest__SimpleRoutes   simple_route;
-
-    switch (route->type) {
-        case ROUTE_TYPE_KEY:
-            /* Validate key data */
-            if (!route->data.key_route.key || route->data.key_route.key_len == 0) {
-                printf("Error: Invalid key data for route\n");
-                *route_bytes_len = 0;
-                return NULL;
-            }
-
-            /* Configure slot key route */
-            slot_key_route.slot_type = COMMAND_REQUEST__SLOT_TYPES__Primary;
-            slot_key_route.slot_key  = route->data.key_route.key;
-
-            routes.value_case     = COMMAND_REQUEST__ROUTES__VALUE_SLOT_KEY_ROUTE;
-            routes.slot_key_route = &slot_key_route;
-            break;
-
-        case ROUTE_TYPE_HOST_PORT:
-            // printf("Creating route by address: %s:%d\n",
-            //       route->data.host_port_route.host, route->data.host_port_route.port);
-            /* Configure by address route */
-            by_address_route.host = route->data.host_port_route.host;
-            by_address_route.port = route->data.host_port_route.port;
-
-            routes.value_case       = COMMAND_REQUEST__ROUTES__VALUE_BY_ADDRESS_ROUTE;
-            routes.by_address_route = &by_address_route;
-            break;
-
-        case ROUTE_TYPE_SIMPLE:
-            // printf("Creating simple route type: %d\n", route->data.simple_route_type);
-            /* Configure simple route */
-            simple_route = route->data.simple_route_type;
-
-            routes.value_case    = COMMAND_REQUEST__ROUTES__VALUE_SIMPLE_ROUTES;
-            routes.simple_routes = simple_route;
-            break;
-
-        default:
-            /* Unknown route type */
-            printf("Error: Unknown route type: %d\n", route->type);
-            *route_bytes_len = 0;
-            return NULL;
-    }
-
-    /* Get serialized size and allocate buffer */
-    *route_bytes_len = command_request__routes__get_packed_size(&routes);
-    if (*route_bytes_len == 0) {
-        printf("Error: Failed to get packed size for route\n");
-        return NULL;
-    }
-
-    route_bytes = (uint8_t*)emalloc(*route_bytes_len);
-
-    if (!route_bytes) {
-        printf("Error: Failed to allocate memory for route bytes\n");
-        *route_bytes_len = 0;
-        return NULL;
-    }
-
-    /* Serialize the routes */
-    size_t packed_size = command_request__routes__pack(&routes, route_bytes);
-    if (packed_size != *route_bytes_len) {
-        printf(
-            "Error: Packed size mismatch: expected %zu, got %zu\n", *route_bytes_len, packed_size);
-        efree(route_bytes);
-        *route_bytes_len = 0;
-        return NULL;
-    }
-
-    // printf("Successfully created route bytes: %zu bytes\n", *route_bytes_len);
-    return route_bytes;
+    return NULL;
 }
 
 /* Execute a command and handle common error checking */
@@ -282,32 +193,14 @@ CommandResult* execute_command_with_route(const void*          glide_client,
     }
 
     /* Parse the route from the first parameter */
-    cluster_route_t route;
-    memset(&route, 0, sizeof(cluster_route_t));
-    if (!parse_cluster_route(arg_route, &route)) {
+    RouteInfo        route_storage;
+    const RouteInfo* route = parse_cluster_route(arg_route, &route_storage);
+    if (!route) {
         /* Failed to parse the route */
         printf("Error: Failed to parse cluster route\n");
         return NULL;
     }
 
-    /* Create serialized route bytes */
-    size_t   route_bytes_len = 0;
-    uint8_t* route_bytes     = create_route_bytes_from_route(&route, &route_bytes_len);
-    if (!route_bytes) {
-        printf("Error: Failed to create route bytes\n");
-        /* Free dynamically allocated key if needed before returning */
-        if (route.type == ROUTE_TYPE_KEY && route.data.key_route.key_allocated) {
-            efree(route.data.key_route.key);
-        }
-        return NULL;
-    }
-
-    /* Validate all parameters before FFI call */
-    if (!glide_client) {
-        printf("ERROR: glide_client is NULL\n");
-        return NULL;
-    }
-
     if (arg_count > 0) {
         if (!args) {
             printf("ERROR: args is NULL but arg_count is %lu\n", arg_count);
@@ -319,34 +212,19 @@ CommandResult* execute_command_with_route(const void*          glide_client,
         }
     }
 
-    if (route_bytes_len > 0) {
-        if (!route_bytes) {
-            printf("ERROR: route_bytes is NULL but route_bytes_len is %zu\n", route_bytes_len);
-            return NULL;
-        }
-    }
-
     /* Execute the command */
-    CommandResult* result = command(glide_client,
-                                    0,               /* channel */
-                                    command_type,    /* command type */
-                                    arg_count,       /* number of arguments */
-                                    args,            /* arguments */
-                                    args_len,        /* argument lengths */
-                                    route_bytes,     /* route bytes */
-                                    route_bytes_len, /* route bytes length */
-                                    0                /* span pointer */
+    uint64_t       span_ptr = valkey_glide_otel_start_span(command_type);
+    CommandResult* result   = command_with_route_info(glide_client,
+                                                      0,            /* channel */
+                                                      command_type, /* command type */
+                                                      arg_count,    /* number of arguments */
+                                                      args,         /* arguments */
+                                                      args_len,     /* argument lengths */
+                                                      route,        /* route */
+                                                      span_ptr      /* span pointer */
     );
-
-    /* Free route bytes */
-    if (route_bytes) {
-        efree(route_bytes);
-    }
-
-    /* Free dynamically allocated key if needed */
-    if (route.type == ROUTE_TYPE_KEY && route.data.key_route.key_allocated) {
-        efree(route.data.key_route.key);
-    }
+    valkey_glide_otel_end_span(span_ptr);
+    valkey_glide_near_cache_note_command(glide_client, command_type, arg_count, args, args_len);
 
     /* Validate result before returning */
     if (!result) {
@@ -373,16 +251,19 @@ CommandResult* execute_command(const void*          glide_client,
     }
 
     /* Execute the command */
-    CommandResult* result = command(glide_client,
-                                    0,            /* channel */
-                                    command_type, /* command type */
-                                    arg_count,    /* number of arguments */
-                                    args,         /* arguments */
-                                    args_len,     /* argument lengths */
-                                    NULL,         /* route bytes */
-                                    0,            /* route bytes length */
-                                    0             /* span pointer */
+    uint64_t       span_ptr = valkey_glide_otel_start_span(command_type);
+    CommandResult* result   = command(glide_client,
+                                      0,            /* channel */
+                                      command_type, /* command type */
+                                      arg_count,    /* number of arguments */
+                                      args,         /* arguments */
+                                      args_len,     /* argument lengths */
+                                      NULL,         /* route bytes */
+                                      0,            /* route bytes length */
+                                      span_ptr      /* span pointer */
     );
+    valkey_glide_otel_end_span(span_ptr);
+    valkey_glide_near_cache_note_command(glide_client, command_type, arg_count, args, args_len);
 
     return result;
 }
@@ -633,6 +514,113 @@ int handle_double_response(CommandResult* result, double* output) {
     return ret_val;
 }
 
+/*
+ * Add a field/value pair to an associative array. The key is created once from the bytes of the
+ * field, and numeric fields become integer keys as with add_assoc_*(). Returns 0, adding
+ * nothing, if the field isn't a string
+ */
+static int add_response_pair(HashTable*                       ht,
+                             const CommandResponse*           field,
+                             CommandResponse*                 value,
+                             int                              use_associative_array,
+                             bool                             use_false_if_null,
+                             const valkey_glide_serializer_t* serializer) {
+    zval         z_value;
+    zend_string* key;
+
+    if (field->response_type != String) {
+        return 0;
+    }
+
+    if (value->response_type == String) {
+        valkey_glide_unpack(serializer, value->string_value, value->string_value_len, &z_value);
+    } else {
+        command_response_to_unpacked_zval(
+            value, &z_value, use_associative_array, use_false_if_null, serializer);
+    }
+
+    key = zend_string_init(field->string_value, field->string_value_len, 0);
+    zend_symtable_update(ht, key, &z_value);
+    zend_string_release(key);
+    return 1;
+}
+
+/*
+ * Add an element of a Map: as a key and its value in associative mode, or else as two
+ * consecutive entries, which is also the fallback for keys that aren't strings
+ */
+static void add_map_element(zval*                            output,
+                            CommandResponse*                 element,
+                            int                              use_associative_array,
+                            bool                             use_false_if_null,
+                            const valkey_glide_serializer_t* serializer) {
+    zval key, value;
+
+    if (use_associative_array != COMMAND_RESPONSE_NOT_ASSOSIATIVE && element->map_key &&
+        element->map_value &&
+        add_response_pair(Z_ARRVAL_P(output),
+                          element->map_key,
+                          element->map_value,
+                          use_associative_array,
+                          use_false_if_null,
+                          serializer)) {
+        return;
+    }
+
+    if (element->map_key != NULL) {
+        command_response_to_zval(element->map_key, &key, use_associative_array, use_false_if_null);
+    } else {
+        ZVAL_NULL(&key);
+    }
+    if (element->map_value != NULL) {
+        command_response_to_unpacked_zval(
+            element->map_value, &value, use_associative_array, use_false_if_null, serializer);
+    } else {
+        ZVAL_NULL(&value);
+    }
+    add_next_index_zval(output, &key);
+    add_next_index_zval(output, &value);
+}
+
+int command_response_consume_pairs(CommandResponse*                 response,
+                                   zval*                            output,
+                                   const valkey_glide_serializer_t* serializer) {
+    if (!response) {
+        ZVAL_NULL(output);
+        return 0;
+    }
+
+    switch (response->response_type) {
+        case Map:
+            array_init_size(output, response->array_value_len);
+            for (int64_t i = 0; i < response->array_value_len; i++) {
+                add_map_element(output,
+                                &response->array_value[i],
+                                COMMAND_RESPONSE_ASSOSIATIVE_ARRAY_MAP,
+                                false,
+                                serializer);
+                release_command_response_elements(&response->array_value[i]);
+            }
+            return 1;
+        case Array:
+            array_init_size(output, response->array_value_len / 2);
+            for (int64_t i = 0; i + 1 < response->array_value_len; i += 2) {
+                add_response_pair(Z_ARRVAL_P(output),
+                                  &response->array_value[i],
+                                  &response->array_value[i + 1],
+                                  COMMAND_RESPONSE_NOT_ASSOSIATIVE,
+                                  false,
+                                  serializer);
+                release_command_response_elements(&response->array_value[i]);
+                release_command_response_elements(&response->array_value[i + 1]);
+            }
+            return 1;
+        default:
+            return command_response_to_unpacked_zval(
+                response, output, COMMAND_RESPONSE_NOT_ASSOSIATIVE, false, serializer);
+    }
+}
+
 /* Helper function to convert a CommandResponse to a PHP value
  * use_associative_array:
  * - 0: regular array processing
@@ -642,6 +630,15 @@ int command_response_to_zval(CommandResponse* response,
                              zval*            output,
                              int              use_associative_array,
                              bool             use_false_if_null) {
+    return command_response_to_unpacked_zval(
+        response, output, use_associative_array, use_false_if_null, NULL);
+}
+
+int command_response_to_unpacked_zval(CommandResponse*                 response,
+                                      zval*                            output,
+                                      int                              use_associative_array,
+                                      bool                             use_false_if_null,
+                                      const valkey_glide_serializer_t* serializer) {
     if (!response) {
         ZVAL_NULL(output);
         return 0;
@@ -678,32 +675,22 @@ int command_response_to_zval(CommandResponse* response,
         case String:
             // printf("%s:%d - CommandResponse is String with length: %ld string = %s\n", __FILE__,
             // __LINE__, response->string_value_len, response->string_value);
-            ZVAL_STRINGL(output, response->string_value, response->string_value_len);
+            valkey_glide_unpack(
+                serializer, response->string_value, response->string_value_len, output);
             return 1;
         case Array:
             //  printf("%s:%d - CommandResponse is Array with length: %ld, use_associative_array =
             //  %d\n", __FILE__, __LINE__, response->array_value_len, use_associative_array);
             array_init(output);
             if (use_associative_array == COMMAND_RESPONSE_SCAN_ASSOSIATIVE_ARRAY) {
+                zend_hash_extend(Z_ARRVAL_P(output), response->array_value_len / 2, 0);
                 for (int64_t i = 0; i + 1 < response->array_value_len; i += 2) {
-                    zval field, value;
-
-                    command_response_to_zval(&response->array_value[i],
-                                             &field,
-                                             COMMAND_RESPONSE_NOT_ASSOSIATIVE,
-                                             use_false_if_null);
-                    command_response_to_zval(&response->array_value[i + 1],
-                                             &value,
-                                             COMMAND_RESPONSE_NOT_ASSOSIATIVE,
-                                             use_false_if_null);
-
-                    if (Z_TYPE(field) == IS_STRING) {
-                        add_assoc_zval(output, Z_STRVAL(field), &value);
-                        zval_dtor(&field);
-                    } else {
-                        zval_dtor(&field);
-                        zval_dtor(&value);
-                    }
+                    add_response_pair(Z_ARRVAL_P(output),
+                                      &response->array_value[i],
+                                      &response->array_value[i + 1],
+                                      COMMAND_RESPONSE_NOT_ASSOSIATIVE,
+                                      use_false_if_null,
+                                      serializer);
                 }
             } else if (response->array_value_len == 2 &&
                        use_associative_array == COMMAND_RESPONSE_STREAM_ARRAY_ASSOCIATIVE) {
@@ -762,10 +749,11 @@ int command_response_to_zval(CommandResponse* response,
                 for (int64_t i = 0; i < response->array_value_len; i++) {
                     zval value;
 
-                    command_response_to_zval(&response->array_value[i],
-                                             &value,
-                                             use_associative_array,
-                                             use_false_if_null);
+                    command_response_to_unpacked_zval(&response->array_value[i],
+                                                      &value,
+                                                      use_associative_array,
+                                                      use_false_if_null,
+                                                      serializer);
                     // printf("%s:%d - DEBUG: Adding array value %d\n", __FILE__, __LINE__, i);
                     //   php_var_dump(&value, 2); // No need to modify this as it's not printf
 
@@ -780,41 +768,16 @@ int command_response_to_zval(CommandResponse* response,
         case Map:
             // printf("%s:%d - CommandResponse is Map with length: %ld\n", __FILE__, __LINE__,
             // response->array_value_len);
-            array_init(output);
+            array_init_size(output,
+                            use_associative_array != COMMAND_RESPONSE_NOT_ASSOSIATIVE
+                                ? response->array_value_len
+                                : response->array_value_len * 2);
             for (int i = 0; i < response->array_value_len; i++) {
-                zval             key, value;
-                CommandResponse* element = &response->array_value[i];
-
-                // Process the key
-                if (element->map_key != NULL) {
-                    command_response_to_zval(
-                        element->map_key, &key, use_associative_array, use_false_if_null);
-                } else {
-                    ZVAL_NULL(&key);
-                }
-
-                // Process the value
-                if (element->map_value != NULL) {
-                    // printf("%s:%d - DEBUG: Processing map value %d\n", __FILE__, __LINE__, i);
-                    command_response_to_zval(
-                        element->map_value, &value, use_associative_array, use_false_if_null);
-                    // printf("%s:%d - DEBUG: Map value %d processed\n", __FILE__, __LINE__, i);
-                } else {
-                    ZVAL_NULL(&value);
-                }
-
-                if (use_associative_array != COMMAND_RESPONSE_NOT_ASSOSIATIVE &&
-                    Z_TYPE(key) == IS_STRING) {
-                    // printf("%s:%d - DEBUG: Adding key %s \n", __FILE__, __LINE__, Z_STRVAL(key));
-                    // php_var_dump(&value, 2); // No need to modify this as it's not printf
-                    add_assoc_zval(output, Z_STRVAL(key), &value);
-                    zval_dtor(&key);  // Clean up the key since we're using it as an index
-                } else {
-                    // Add the key as a separate array element (original behavior)
-                    add_next_index_zval(output, &key);
-                    // Add the value as the next array element
-                    add_next_index_zval(output, &value);
-                }
+                add_map_element(output,
+                                &response->array_value[i],
+                                use_associative_array,
+                                use_false_if_null,
+                                serializer);
             }
             // php_var_dump(output, 2); // No need to modify this as it's not printf
             return 1;
@@ -826,7 +789,8 @@ int command_response_to_zval(CommandResponse* response,
                 CommandResponse* set_item = &response->sets_value[i];
 
                 if (set_item->response_type == String) {
-                    ZVAL_STRINGL(&value, set_item->string_value, set_item->string_value_len);
+                    valkey_glide_unpack(
+                        serializer, set_item->string_value, set_item->string_value_len, &value);
                     add_next_index_zval(output, &value);
                 }
             }
@@ -19,6 +19,7 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include "common.h"
 #include "include/glide_bindings.h"
 #include "php.h"
 #include "zend.h"
@@ -134,6 +135,27 @@ int command_response_to_zval(CommandResponse* response,
                              int              use_associative_array,
                              bool             use_false_if_null);
 
+/*
+ * As command_response_to_zval(), unpacking values with the serializer (see
+ * valkey_glide_serializer.h): strings, array and set elements and map values. Map keys and
+ * the fields of COMMAND_RESPONSE_SCAN_ASSOSIATIVE_ARRAY replies are kept as they are
+ */
+int command_response_to_unpacked_zval(CommandResponse*                 response,
+                                      zval*                            output,
+                                      int                              use_associative_array,
+                                      bool                             use_false_if_null,
+                                      const valkey_glide_serializer_t* serializer);
+
+/*
+ * Convert the field/value pairs of HGETALL, HSCAN or ZSCAN replies, a Map or an Array of
+ * alternating fields and values, into an associative array sized up front. Each pair is released
+ * as soon as it's inserted, so that a large reply isn't held twice; the reply itself must still be
+ * freed afterwards. Fields are kept as they are and values are unpacked with the serializer
+ */
+int command_response_consume_pairs(CommandResponse*                 response,
+                                   zval*                            output,
+                                   const valkey_glide_serializer_t* serializer);
+
 /*
  * Helper function to convert a long value to a string
  * Returns a newly allocated string or NULL on error
@@ -43,12 +43,30 @@
 #define MULTI 1
 #define PIPELINE 2
 
+/* setOption() options and values, numbered as phpredis' so that both read each other's values */
+#define VALKEY_GLIDE_OPT_SERIALIZER 1
+#define VALKEY_GLIDE_OPT_COMPRESSION 7
+#define VALKEY_GLIDE_OPT_COMPRESSION_LEVEL 9
+/* Values shorter than this many bytes are not compressed; not a phpredis option */
+#define VALKEY_GLIDE_OPT_COMPRESSION_MIN_SIZE 100
+
+#define VALKEY_GLIDE_SERIALIZER_NONE 0
+#define VALKEY_GLIDE_SERIALIZER_PHP 1
+#define VALKEY_GLIDE_SERIALIZER_IGBINARY 2
+#define VALKEY_GLIDE_SERIALIZER_MSGPACK 3
+#define VALKEY_GLIDE_SERIALIZER_JSON 4
+
+#define VALKEY_GLIDE_COMPRESSION_NONE 0
+#define VALKEY_GLIDE_COMPRESSION_ZSTD 2
+#define VALKEY_GLIDE_COMPRESSION_LZ4 3
+
 /* ValkeyGlide Configuration Enums */
 typedef enum {
     VALKEY_GLIDE_READ_FROM_PRIMARY                          = 0,
     VALKEY_GLIDE_READ_FROM_PREFER_REPLICA                   = 1,
     VALKEY_GLIDE_READ_FROM_AZ_AFFINITY                      = 2,
-    VALKEY_GLIDE_READ_FROM_AZ_AFFINITY_REPLICAS_AND_PRIMARY = 3
+    VALKEY_GLIDE_READ_FROM_AZ_AFFINITY_REPLICAS_AND_PRIMARY = 3,
+    VALKEY_GLIDE_READ_FROM_LOWEST_LATENCY                   = 4
 } valkey_glide_read_from_t;
 
 typedef enum {
@@ -79,8 +97,27 @@ typedef struct {
 } valkey_glide_tls_advanced_configuration_t;
 
 typedef struct {
-    int                                        connection_timeout; /* -1 if not set */
-    valkey_glide_tls_advanced_configuration_t* tls_config;         /* NULL if not set */
+    char* traces_endpoint;   /* NULL if traces are not exported */
+    int   sample_percentage; /* -1 if not set */
+    char* metrics_endpoint;  /* NULL if metrics are not exported */
+    long  flush_interval_ms; /* -1 if not set */
+} valkey_glide_otel_configuration_t;
+
+typedef struct {
+    long    max_bytes;    /* Upper bound on the cached bytes */
+    long    ttl;          /* Seconds an entry may be served, 0 if not set */
+    char**  prefixes;     /* Cached key prefixes, NULL to cache every key */
+    size_t* prefix_lens;  /* Lengths of the prefixes */
+    int     prefix_count; /* 0 if not set */
+} valkey_glide_near_cache_configuration_t;
+
+typedef struct {
+    int                                        connection_timeout;         /* -1 if not set */
+    valkey_glide_tls_advanced_configuration_t* tls_config;                 /* NULL if not set */
+    valkey_glide_otel_configuration_t*         otel_config;                /* NULL if not set */
+    valkey_glide_near_cache_configuration_t*   near_cache_config;          /* NULL if not set */
+    int                                        connections_per_node;       /* -1 if not set */
+    int                                        blocking_connections_limit; /* -1 if not set */
 } valkey_glide_advanced_base_client_configuration_t;
 
 typedef struct {
@@ -141,8 +178,18 @@ struct batch_command {
     void*            route_info; /* Optional routing info for cluster mode */
 };
 
+typedef struct valkey_glide_near_cache valkey_glide_near_cache_t;
+typedef struct valkey_glide_pubsub     valkey_glide_pubsub_t;
+typedef struct valkey_glide_serializer valkey_glide_serializer_t;
+
 typedef struct {
-    const void* glide_client; /* Valkey Glide client pointer */
+    const void*                glide_client; /* Valkey Glide client pointer */
+    valkey_glide_near_cache_t* near_cache;   /* Per-worker read cache, NULL if disabled */
+    valkey_glide_pubsub_t*     pubsub;       /* Subscriptions, NULL for cluster clients */
+    valkey_glide_serializer_t* serializer;   /* setOption() packing, NULL to send values as is */
+
+    /* Cluster MGET/MSET/DEL/UNLINK report failed slots instead of failing as a whole */
+    bool partial_results;
 
     /* Batch mode tracking */
     bool is_in_batch_mode;
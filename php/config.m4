@@ -4,6 +4,18 @@ PHP_ARG_ENABLE(valkey_glide, whether to enable Valkey Glide support,
 PHP_ARG_ENABLE(valkey_glide_asan, whether to enable AddressSanitizer for Valkey Glide,
 [  --enable-valkey-glide-asan   Enable AddressSanitizer for debugging (requires clang/gcc with ASAN support)], no, no)
 
+PHP_ARG_ENABLE(valkey_glide_igbinary, whether to enable the igbinary serializer,
+[  --enable-valkey-glide-igbinary   Enable ValkeyGlide::SERIALIZER_IGBINARY (requires the igbinary extension)], no, no)
+
+PHP_ARG_ENABLE(valkey_glide_msgpack, whether to enable the msgpack serializer,
+[  --enable-valkey-glide-msgpack   Enable ValkeyGlide::SERIALIZER_MSGPACK (requires the msgpack extension)], no, no)
+
+PHP_ARG_ENABLE(valkey_glide_lz4, whether to enable lz4 compression,
+[  --enable-valkey-glide-lz4   Enable ValkeyGlide::COMPRESSION_LZ4 (requires liblz4)], no, no)
+
+PHP_ARG_ENABLE(valkey_glide_zstd, whether to enable zstd compression,
+[  --enable-valkey-glide-zstd   Enable ValkeyGlide::COMPRESSION_ZSTD (requires libzstd)], no, no)
+
 if test "$PHP_VALKEY_GLIDE" != "no"; then
 
   dnl Check if ASAN is enabled
@@ -51,8 +63,30 @@ if test "$PHP_VALKEY_GLIDE" != "no"; then
   if test -n "$PHP_VALKEY_GLIDE_LDFLAGS"; then
     LDFLAGS="$LDFLAGS $PHP_VALKEY_GLIDE_LDFLAGS"
   fi
+
+  dnl Optional serializers and compression codecs for setOption()
+  VALKEY_GLIDE_EXTRA_LIBS=""
+  if test "$PHP_VALKEY_GLIDE_IGBINARY" = "yes"; then
+    PHP_ADD_EXTENSION_DEP(valkey_glide, igbinary)
+    AC_DEFINE([HAVE_VALKEY_GLIDE_IGBINARY], [1], [Define to enable the igbinary serializer])
+  fi
+  if test "$PHP_VALKEY_GLIDE_MSGPACK" = "yes"; then
+    PHP_ADD_EXTENSION_DEP(valkey_glide, msgpack)
+    AC_DEFINE([HAVE_VALKEY_GLIDE_MSGPACK], [1], [Define to enable the msgpack serializer])
+  fi
+  if test "$PHP_VALKEY_GLIDE_LZ4" = "yes"; then
+    AC_CHECK_HEADER([lz4hc.h], [], [AC_MSG_ERROR([lz4 compression requested but lz4hc.h was not found])])
+    AC_DEFINE([HAVE_VALKEY_GLIDE_LZ4], [1], [Define to enable lz4 compression])
+    VALKEY_GLIDE_EXTRA_LIBS="$VALKEY_GLIDE_EXTRA_LIBS -llz4"
+  fi
+  if test "$PHP_VALKEY_GLIDE_ZSTD" = "yes"; then
+    AC_CHECK_HEADER([zstd.h], [], [AC_MSG_ERROR([zstd compression requested but zstd.h was not found])])
+    AC_DEFINE([HAVE_VALKEY_GLIDE_ZSTD], [1], [Define to enable zstd compression])
+    VALKEY_GLIDE_EXTRA_LIBS="$VALKEY_GLIDE_EXTRA_LIBS -lzstd"
+  fi
+  PHP_SUBST(VALKEY_GLIDE_EXTRA_LIBS)
   PHP_NEW_EXTENSION(valkey_glide,
-    valkey_glide.c valkey_glide_cluster.c cluster_scan_cursor.c command_response.c valkey_glide_commands.c valkey_glide_commands_2.c valkey_glide_commands_3.c valkey_glide_core_commands.c valkey_glide_core_common.c valkey_glide_expire_commands.c valkey_glide_geo_commands.c valkey_glide_geo_common.c valkey_glide_hash_common.c valkey_glide_list_common.c valkey_glide_s_common.c valkey_glide_str_commands.c valkey_glide_x_commands.c valkey_glide_x_common.c valkey_glide_z.c valkey_glide_z_common.c valkey_z_php_methods.c src/command_request.pb-c.c src/connection_request.pb-c.c src/response.pb-c.c,
+    valkey_glide.c valkey_glide_cluster.c cluster_scan_cursor.c cluster_scan_iterator.c collection_scan_iterator.c command_response.c valkey_glide_arena.c valkey_glide_cluster_fanout.c valkey_glide_near_cache.c valkey_glide_otel.c valkey_glide_pubsub.c valkey_glide_serializer.c valkey_glide_commands.c valkey_glide_commands_2.c valkey_glide_commands_3.c valkey_glide_core_commands.c valkey_glide_core_common.c valkey_glide_expire_commands.c valkey_glide_geo_commands.c valkey_glide_geo_common.c valkey_glide_hash_common.c valkey_glide_list_common.c valkey_glide_s_common.c valkey_glide_str_commands.c valkey_glide_x_commands.c valkey_glide_x_common.c valkey_glide_z.c valkey_glide_z_common.c valkey_z_php_methods.c src/command_request.pb-c.c src/connection_request.pb-c.c src/response.pb-c.c,
     $ext_shared)
 
   EXTRA_DIST="$EXTRA_DIST valkey_glide.stub.php valkey_glide_cluster.stub.php"
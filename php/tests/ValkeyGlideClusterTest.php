@@ -98,6 +98,7 @@ class ValkeyGlide_Cluster_Test extends ValkeyGlide_Test {
      * such as sortAsc, or sortDesc and other commands such as SELECT are
      * simply invalid in ValkeyGlide Cluster */
     public function testPipelinePublish() { $this->markTestSkipped(); }
+    public function testSubscribeBufferFull() { $this->markTestSkipped(); }
     public function testSortAsc()  { $this->markTestSkipped(); }
     public function testSortDesc() { $this->markTestSkipped(); }
     public function testWait()     { $this->markTestSkipped(); }
@@ -376,6 +377,32 @@ class ValkeyGlide_Cluster_Test extends ValkeyGlide_Test {
         set_time_limit(0);  // Reset to unlimited (or default) at the end
     }
 
+    public function testScanParallel() {
+        set_time_limit(10);
+        $key_count = $this->valkey_glide->dbsize("allPrimaries");
+
+        /* Like SCAN, a key may be returned more than once, but every key is returned */
+        $keys  = [];
+        $count = 0;
+        foreach ($this->valkey_glide->scanParallel(null, 100, null, 2) as $index => $key) {
+            $this->assertEquals($count++, $index);
+            $keys[$key] = true;
+        }
+        $this->assertEquals($key_count, count($keys));
+
+        $expected = [];
+        for ($i = 0; $i < 50; $i++) {
+            $expected[] = "scanparallel:$i";
+            $this->valkey_glide->set("scanparallel:$i", 'value');
+        }
+        $matches = array_unique(iterator_to_array($this->valkey_glide->scanParallel('scanparallel:*')));
+        sort($matches);
+        sort($expected);
+        $this->assertEquals($expected, $matches);
+        $this->valkey_glide->del($expected);
+        set_time_limit(0);
+    }
+
     // Run some simple tests against the PUBSUB command.  This is problematic, as we
     // can't be sure what's going on in the instance, but we can do some things.
     public function testPubSub() {
@@ -438,6 +465,30 @@ class ValkeyGlide_Cluster_Test extends ValkeyGlide_Test {
         $this->assertFalse($this->valkey_glide->msetnx([])); // set ø → FALSE
     }
 
+    /* MGET, MSET and DEL are split by slot, and the replies put back in the order of the keys */
+    public function testMultiKeyAcrossSlots() {
+        $kvals = [];
+        for ($i = 0; $i < 500; $i++) {
+            $kvals["multislot:$i"] = "value:$i";
+        }
+        /* Keys sharing a hash tag go to the same slot, in between the others */
+        $kvals['{multislot}:a'] = 'a';
+        $kvals['{multislot}:b'] = 'b';
+        $keys = array_keys($kvals);
+
+        $this->valkey_glide->del($keys);
+        $this->assertTrue($this->valkey_glide->mset($kvals));
+        $this->assertEquals(array_values($kvals), $this->valkey_glide->mget($keys));
+
+        $reversed = array_reverse($keys);
+        $this->assertEquals(array_values(array_reverse($kvals)), $this->valkey_glide->mget($reversed));
+        $this->assertEquals(['value:7', false, 'b'],
+                            $this->valkey_glide->mget(['multislot:7', 'multislot:missing', '{multislot}:b']));
+
+        $this->assertEquals(250, $this->valkey_glide->del(array_slice($keys, 0, 250)));
+        $this->assertEquals(252, $this->valkey_glide->unlink($keys));
+    }
+
     /* Slowlog needs to take a key or [ip, port], to direct it to a node */
     public function testSlowlog() {
         $this->markTestSkipped();
@@ -757,6 +808,18 @@ class ValkeyGlide_Cluster_Test extends ValkeyGlide_Test {
         $this->valkey_glide->del('mylist');
         $this->valkey_glide->rpush('mylist', 'A', 'B', 'C', 'D');
         $this->assertEquals(['A', 'B', 'C', 'D'], $this->valkey_glide->lrange('mylist', 0, -1));
+
+        /* Keys and slot key routes go to the node owning the slot, binary and integer keys too */
+        $key = "{raw\0key}";
+        $this->valkey_glide->rawCommand($key, 'set', $key, 'binary');
+        $route = ['type' => 'primarySlotKey', 'key' => $key];
+        $this->assertEquals('binary', $this->valkey_glide->rawCommand($route, 'get', $key));
+        $this->valkey_glide->del($key);
+
+        $this->valkey_glide->set('12345', 'numeric');
+        $route = ['type' => 'slotKey', 'key' => 12345];
+        $this->assertEquals('numeric', $this->valkey_glide->rawCommand($route, 'get', '12345'));
+        $this->valkey_glide->del('12345');
     }
 
     protected function rawCommandArray($key, $args) {
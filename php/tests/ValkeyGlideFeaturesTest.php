@@ -404,5 +404,60 @@ class ValkeyGlide_Features_Test extends ValkeyGlideBaseTest {
         $this->assertTrue($valkey_glide->ping());
         $valkey_glide->close();
     }
+
+    // How long a GET takes while another client holds the server paused
+    private function timeGetWhilePaused($pauser, $client, $key, &$value) {
+        $pauser->rawCommand('CLIENT', 'PAUSE', '300', 'ALL');
+        $start = microtime(true);
+        $value = $client->get($key);
+        return microtime(true) - $start;
+    }
+
+    public function testNearCache() {
+        $addresses = [
+            ['host' => $this->getHost(), 'port' => $this->getPort()]
+        ];
+
+        // Caches are shared per worker by server and database, so this one gets its own database
+        $db = 9;
+        $writer = new ValkeyGlide($addresses, false, null, ValkeyGlide::READ_FROM_PRIMARY, null, null, $db);
+        $client = new ValkeyGlide(
+            $addresses, false, null, ValkeyGlide::READ_FROM_PRIMARY, null, null, $db,
+            null, null, null, ['near_cache' => ['max_bytes' => 1 << 20, 'ttl' => 3]]
+        );
+        $key = 'near_cache_' . uniqid();
+
+        // A hit is served without the server, so the paused server doesn't hold it back. The
+        // invalidation pushed for the SET must land first, or it would drop the entry
+        $this->assertTrue($writer->set($key, 'first'));
+        usleep(100000);
+        $this->assertEquals('first', $client->get($key));
+        $this->assertLT(0.15, $this->timeGetWhilePaused($writer, $client, $key, $value));
+        $this->assertEquals('first', $value);
+
+        // A write by another client is pushed as an invalidation, well before the entry expires
+        $this->assertTrue($writer->set($key, 'second'));
+        $deadline = microtime(true) + 1;
+        do {
+            $value = $client->get($key);
+        } while ($value != 'second' && microtime(true) < $deadline);
+        $this->assertEquals('second', $value);
+
+        // Writes through the caching client are visible right away
+        $this->assertTrue($client->set($key, 'third'));
+        $this->assertEquals('third', $client->get($key));
+
+        // Once the entry expired, the GET waits for the paused server again
+        usleep(100000);
+        $this->assertEquals('third', $client->get($key));
+        $this->assertLT(0.15, $this->timeGetWhilePaused($writer, $client, $key, $value));
+        sleep(4);
+        $this->assertGTE(0.2, $this->timeGetWhilePaused($writer, $client, $key, $value));
+        $this->assertEquals('third', $value);
+
+        $writer->del($key);
+        $client->close();
+        $writer->close();
+    }
 }
 ?>
@@ -146,6 +146,73 @@ class ValkeyGlide_Test extends ValkeyGlideBaseTest {
         $this->assertFalse(@$this->valkey_glide->pubsub('numsub', 'not-an-array'));
     }*/
 
+    public function testSubscribe() {
+        $channel    = 'pubsub:' . uniqid();
+        $subscriber = $this->newInstance();
+
+        // Without a callback, messages are buffered until getMessages()
+        $this->assertTrue($subscriber->subscribe([$channel]));
+        $this->assertTrue($subscriber->psubscribe(["$channel:*"]));
+        $this->assertGT(0, $this->valkey_glide->publish($channel, 'one'));
+        $this->assertGT(0, $this->valkey_glide->publish("$channel:x", 'two'));
+
+        $messages = [];
+        for ($i = 0; $i < 100 && count($messages) < 2; $i++) {
+            usleep(10000);
+            $messages = array_merge($messages, $subscriber->getMessages());
+        }
+        $this->assertEquals(['kind' => 'message', 'channel' => $channel, 'message' => 'one'],
+                            $messages[0] ?? null);
+        $this->assertEquals(['kind' => 'pmessage', 'channel' => "$channel:x", 'message' => 'two',
+                             'pattern' => "$channel:*"], $messages[1] ?? null);
+        $this->assertEquals(["$channel:*" => true], $subscriber->punsubscribe(["$channel:*"]));
+
+        // The callback loop runs until the last channel is unsubscribed
+        $this->assertGT(0, $this->valkey_glide->publish($channel, 'quit'));
+        $received = [];
+        $this->assertTrue($subscriber->subscribe([$channel], function ($r, $chan, $msg) use (&$received) {
+            $received[] = [$chan, $msg];
+            if ($msg == 'quit')
+                $r->unsubscribe([$chan]);
+        }));
+        $this->assertEquals([[$channel, 'quit']], $received);
+        $this->assertEquals([], $subscriber->getMessages());
+
+        $subscriber->close();
+    }
+
+    public function testSubscribeBufferFull() {
+        $channel    = 'pubsub:' . uniqid();
+        $subscriber = new ValkeyGlide([['host' => $this->getHost(), 'port' => $this->getPort()]],
+                                      false, null, ValkeyGlide::READ_FROM_PRIMARY, null, null,
+                                      null, null, null, null, ['pubsub_buffer_size' => 4]);
+        if ($this->getAuth()) {
+            $this->assertTrue($subscriber->auth($this->getAuth()));
+        }
+        $this->assertTrue($subscriber->subscribe([$channel]));
+
+        // The messages that don't fit in the buffer are dropped and counted
+        for ($i = 0; $i < 10; $i++) {
+            $this->assertGT(0, $this->valkey_glide->publish($channel, "m$i"));
+        }
+        usleep(200000);
+
+        $warnings = [];
+        set_error_handler(function ($errno, $errstr) use (&$warnings) {
+            $warnings[] = $errstr;
+            return true;
+        }, E_WARNING);
+        $messages = $subscriber->getMessages();
+        restore_error_handler();
+
+        $this->assertEquals(['m0', 'm1', 'm2', 'm3'], array_column($messages, 'message'));
+        $this->assertEquals(1, count($warnings));
+        $this->assertStringContains('6 Pub/Sub messages were dropped', $warnings[0] ?? '');
+        $this->assertEquals([], $subscriber->getMessages());
+
+        $subscriber->close();
+    }
+
     /* These test cases were generated randomly.  We're just trying to test
        that PhpValkeyGlide handles all combination of arguments correctly. */
     public function testBitcount() {
@@ -592,6 +659,95 @@ class ValkeyGlide_Test extends ValkeyGlideBaseTest {
         $this->assertEquals(0, $this->valkey_glide->exists('key'));
     }
 
+    public function testSerializer() {
+        $client = $this->newInstance();
+        $value  = ['a' => 1, 'b' => [true, 1.5, 'c']];
+
+        $this->assertEquals(ValkeyGlide::SERIALIZER_NONE, $client->getOption(ValkeyGlide::OPT_SERIALIZER));
+        $this->assertEquals(64, $client->getOption(ValkeyGlide::OPT_COMPRESSION_MIN_SIZE));
+        $this->assertFalse($client->setOption(ValkeyGlide::OPT_SERIALIZER, 42));
+
+        $this->assertTrue($client->setOption(ValkeyGlide::OPT_SERIALIZER, ValkeyGlide::SERIALIZER_PHP));
+        $this->assertEquals(ValkeyGlide::SERIALIZER_PHP, $client->getOption(ValkeyGlide::OPT_SERIALIZER));
+
+        // Values are stored serialized and read back with their type
+        $this->valkey_glide->del('{ser}str', '{ser}hash', '{ser}raw');
+        $this->assertTrue($client->set('{ser}str', $value));
+        $this->assertEquals(serialize($value), $this->valkey_glide->get('{ser}str'));
+        $this->assertEquals($value, $client->get('{ser}str'));
+        $this->assertEquals($value, $client->getSet('{ser}str', 42));
+        $this->assertTrue($client->mset(['{ser}str' => 1.5, '{ser}other' => null]));
+        $this->assertEquals([1.5, null, false], $client->mget(['{ser}str', '{ser}other', '{ser}none']));
+
+        $this->assertEquals(2, $client->hSet('{ser}hash', 'x', $value, 'y', 7));
+        $this->assertEquals($value, $client->hGet('{ser}hash', 'x'));
+        $this->assertEquals(['x' => $value, 'y' => 7], $client->hGetAll('{ser}hash'));
+        $this->assertEquals(['y' => 7, 'z' => false], $client->hMget('{ser}hash', ['y', 'z']));
+
+        // Values that weren't serialized are returned as they are
+        $this->valkey_glide->set('{ser}raw', 'not serialized');
+        $this->assertEquals('not serialized', $client->get('{ser}raw'));
+
+        $this->assertTrue($client->setOption(ValkeyGlide::OPT_SERIALIZER, ValkeyGlide::SERIALIZER_JSON));
+        $this->assertTrue($client->set('{ser}str', $value));
+        $this->assertEquals(json_encode($value), $this->valkey_glide->get('{ser}str'));
+        $this->assertEquals($value, $client->get('{ser}str'));
+
+        $this->assertTrue($client->setOption(ValkeyGlide::OPT_SERIALIZER, ValkeyGlide::SERIALIZER_NONE));
+        $this->assertEquals(json_encode($value), $client->get('{ser}str'));
+
+        $this->assertEquals(ValkeyGlide::COMPRESSION_NONE, $client->getOption(ValkeyGlide::OPT_COMPRESSION));
+        $this->assertFalse($client->setOption(ValkeyGlide::OPT_COMPRESSION, 42));
+        $this->assertFalse($client->setOption(ValkeyGlide::OPT_COMPRESSION_MIN_SIZE, -1));
+
+        $compressible = str_repeat('compress me ', 100);
+        $incompressible = random_bytes(256);
+        $codecs = ['lz4' => ValkeyGlide::COMPRESSION_LZ4, 'zstd' => ValkeyGlide::COMPRESSION_ZSTD];
+        foreach ($codecs as $name => $codec) {
+            // Codecs that weren't compiled in are refused
+            if ( ! $client->setOption(ValkeyGlide::OPT_COMPRESSION, $codec)) {
+                continue;
+            }
+            $this->assertEquals($codec, $client->getOption(ValkeyGlide::OPT_COMPRESSION));
+            $this->assertTrue($client->setOption(ValkeyGlide::OPT_COMPRESSION_LEVEL, 3));
+            $this->assertEquals(3, $client->getOption(ValkeyGlide::OPT_COMPRESSION_LEVEL));
+
+            // Values are stored compressed and read back uncompressed
+            $this->assertTrue($client->set('{ser}str', $compressible));
+            $raw = $this->valkey_glide->get('{ser}str');
+            $this->assertTrue(strlen($raw) < strlen($compressible), "$name didn't compress");
+            $this->assertEquals($compressible, $client->get('{ser}str'));
+            if ($codec == ValkeyGlide::COMPRESSION_ZSTD) {
+                $this->assertEquals("\x28\xb5\x2f\xfd", substr($raw, 0, 4));
+            } else {
+                $this->assertEquals(pack('V', strlen($compressible)), substr($raw, 1, 4));
+            }
+
+            // Values under the threshold are stored as they are
+            $this->assertTrue($client->setOption(ValkeyGlide::OPT_COMPRESSION_MIN_SIZE, 2000));
+            $this->assertEquals(2000, $client->getOption(ValkeyGlide::OPT_COMPRESSION_MIN_SIZE));
+            $this->assertTrue($client->set('{ser}str', $compressible));
+            $this->assertEquals($compressible, $this->valkey_glide->get('{ser}str'));
+            $this->assertEquals($compressible, $client->get('{ser}str'));
+            $this->assertTrue($client->setOption(ValkeyGlide::OPT_COMPRESSION_MIN_SIZE, 64));
+
+            // So are values compression wouldn't make smaller
+            $this->assertTrue($client->set('{ser}str', $incompressible));
+            $this->assertEquals($incompressible, $this->valkey_glide->get('{ser}str'));
+            $this->assertEquals($incompressible, $client->get('{ser}str'));
+
+            // Serialized values are compressed after being serialized
+            $this->assertTrue($client->setOption(ValkeyGlide::OPT_SERIALIZER, ValkeyGlide::SERIALIZER_PHP));
+            $this->assertTrue($client->set('{ser}str', [$compressible]));
+            $this->assertTrue(strlen($this->valkey_glide->get('{ser}str')) < strlen($compressible));
+            $this->assertEquals([$compressible], $client->get('{ser}str'));
+            $this->assertTrue($client->setOption(ValkeyGlide::OPT_SERIALIZER, ValkeyGlide::SERIALIZER_NONE));
+
+            $this->assertTrue($client->setOption(ValkeyGlide::OPT_COMPRESSION_LEVEL, 0));
+            $this->assertTrue($client->setOption(ValkeyGlide::OPT_COMPRESSION, ValkeyGlide::COMPRESSION_NONE));
+        }
+    }
+
     public function testRandomKey() {
         for ($i = 0; $i < 1000; $i++) {
             $k = $this->valkey_glide->randomKey();
@@ -5370,6 +5526,43 @@ class ValkeyGlide_Test extends ValkeyGlideBaseTest {
         set_time_limit(0);  // Reset to unlimited (or default) at the end
     }
 
+    public function testLargeHashConversion() {
+        $this->valkey_glide->del('hash');
+
+        $fields = [];
+        for ($i = 0; $i < 50000; $i++) {
+            $fields["field:$i"] = "value:$i";
+        }
+        // Numeric fields become integer keys, binary ones are kept whole
+        $fields['42'] = 'numeric';
+        $fields['-7'] = 'negative';
+        $fields['007'] = 'padded';
+        $fields["bin\0ary"] = 'binary';
+        $this->valkey_glide->hMSet('hash', $fields);
+
+        $all = $this->valkey_glide->hGetAll('hash');
+        $this->assertEquals(count($fields), count($all));
+        $this->assertEquals('numeric', $all[42]);
+        $this->assertEquals('negative', $all[-7]);
+        $this->assertEquals('padded', $all['007']);
+        $this->assertEquals('binary', $all["bin\0ary"]);
+        $this->assertEquals('value:49999', $all['field:49999']);
+
+        $scanned = [];
+        $it = NULL;
+        do {
+            $pairs = $this->valkey_glide->hscan('hash', $it, '*', 5000);
+            if ($pairs) {
+                $scanned += $pairs;
+            }
+        } while ($it != 0);
+        $this->assertEquals(count($fields), count($scanned));
+        $this->assertEquals('numeric', $scanned[42]);
+        $this->assertEquals('binary', $scanned["bin\0ary"]);
+
+        $this->valkey_glide->del('hash');
+    }
+
     public function testSScan() {
         set_time_limit(10); // Enforce a 10-second limit on this test
         if (version_compare($this->version, '2.8.0') < 0)
@@ -5484,6 +5677,57 @@ class ValkeyGlide_Test extends ValkeyGlideBaseTest {
         set_time_limit(0);  // Reset to unlimited (or default) at the end
     }
 
+    public function testScanIterators() {
+        set_time_limit(10);
+        $this->valkey_glide->del('hash', 'set', 'zset');
+
+        $fields = [];
+        for ($i = 0; $i < 5000; $i++) {
+            $fields["field:$i"] = "value:$i";
+        }
+        $this->valkey_glide->hMSet('hash', $fields);
+
+        /* Small pages with room to grow, so that several pages are prefetched */
+        $scanned = [];
+        foreach ($this->valkey_glide->hscanIterator('hash', null, 10, 1000) as $field => $value) {
+            $scanned[$field] = $value;
+        }
+        $this->assertEquals(count($fields), count($scanned));
+        $this->assertEquals('value:4999', $scanned['field:4999']);
+
+        $matches = iterator_to_array($this->valkey_glide->hscanIterator('hash', 'field:12?'));
+        $this->assertEquals(10, count($matches));
+
+        /* Rewinding restarts the scan */
+        $it = $this->valkey_glide->hscanIterator('hash', 'field:1', 1000, 1000);
+        $this->assertEquals(['field:1' => 'value:1'], iterator_to_array($it));
+        $this->assertEquals(['field:1' => 'value:1'], iterator_to_array($it));
+
+        for ($i = 0; $i < 500; $i++) {
+            $this->valkey_glide->sadd('set', "member:$i");
+            $this->valkey_glide->zadd('zset', $i, "member:$i");
+        }
+
+        $members = [];
+        foreach ($this->valkey_glide->sscanIterator('set', '*0') as $index => $member) {
+            $this->assertEquals(count($members), $index);
+            $members[] = $member;
+        }
+        $this->assertEquals(50, count($members));
+
+        $total = 0;
+        foreach ($this->valkey_glide->zscanIterator('zset') as $member => $score) {
+            $this->assertIsFloat($score);
+            $this->assertEquals("member:$score", $member);
+            $total += $score;
+        }
+        $this->assertEquals(499 * 500 / 2, $total);
+
+        $this->assertEquals([], iterator_to_array($this->valkey_glide->hscanIterator('missing')));
+        $this->valkey_glide->del('hash', 'set', 'zset');
+        set_time_limit(0);
+    }
+
     /* Make sure we capture errors when scanning */
     public function testScanErrors() {
         
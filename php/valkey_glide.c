@@ -6,11 +6,17 @@
 #endif
 #include "cluster_scan_cursor.h"          // Include ClusterScanCursor class
 #include "cluster_scan_cursor_arginfo.h"  // Include ClusterScanCursor arginfo header
+#include "cluster_scan_iterator.h"        // Include ClusterScanIterator class
+#include "collection_scan_iterator.h"     // Include CollectionScanIterator class
 #include "common.h"
 #include "php_valkey_glide.h"
 #include "valkey_glide_arginfo.h"          // Include generated arginfo header
 #include "valkey_glide_cluster_arginfo.h"  // Include generated arginfo header
 #include "valkey_glide_commands_common.h"
+#include "valkey_glide_near_cache.h"
+#include "valkey_glide_otel.h"
+#include "valkey_glide_pubsub.h"
+#include "valkey_glide_serializer.h"
 
 /* Enum support includes - must be BEFORE arginfo includes */
 #if PHP_VERSION_ID >= 80100
@@ -115,6 +121,12 @@ PHP_MINIT_FUNCTION(valkey_glide) {
     /* Register ClusterScanCursor class */
     register_cluster_scan_cursor_class();
 
+    /* Register ClusterScanIterator class */
+    register_cluster_scan_iterator_class();
+
+    /* Register CollectionScanIterator class */
+    register_collection_scan_iterator_class();
+
     /* ValkeyGlideException class */
     // TODO   valkey_glide_exception_ce =
     // register_class_ValkeyGlideException(spl_ce_RuntimeException);
@@ -124,11 +136,33 @@ PHP_MINIT_FUNCTION(valkey_glide) {
     return SUCCESS;
 }
 
-zend_module_entry valkey_glide_module_entry = {STANDARD_MODULE_HEADER,
+/**
+ * PHP_MSHUTDOWN_FUNCTION
+ */
+PHP_MSHUTDOWN_FUNCTION(valkey_glide) {
+    /* Near caches outlive requests; release them with the worker */
+    valkey_glide_near_cache_shutdown();
+
+    return SUCCESS;
+}
+
+/* The serializers of these extensions are called directly, so they must be loaded first */
+static const zend_module_dep valkey_glide_deps[] = {
+#ifdef HAVE_VALKEY_GLIDE_IGBINARY
+    ZEND_MOD_REQUIRED("igbinary")
+#endif
+#ifdef HAVE_VALKEY_GLIDE_MSGPACK
+    ZEND_MOD_REQUIRED("msgpack")
+#endif
+    ZEND_MOD_END};
+
+zend_module_entry valkey_glide_module_entry = {STANDARD_MODULE_HEADER_EX,
+                                               NULL,
+                                               valkey_glide_deps,
                                                "valkey_glide",
                                                NULL,
                                                PHP_MINIT(valkey_glide),
-                                               NULL,
+                                               PHP_MSHUTDOWN(valkey_glide),
                                                NULL,
                                                NULL,
                                                NULL,
@@ -144,10 +178,18 @@ void free_valkey_glide_object(zend_object* object) {
 
     /* Free the Valkey Glide client if it exists */
     if (valkey_glide->glide_client) {
+        valkey_glide_near_cache_detach(valkey_glide->glide_client);
+        valkey_glide->near_cache = NULL;
         close_glide_client(valkey_glide->glide_client);
         valkey_glide->glide_client = NULL;
     }
 
+    valkey_glide_pubsub_free(valkey_glide->pubsub);
+    valkey_glide->pubsub = NULL;
+
+    valkey_glide_serializer_free(valkey_glide->serializer);
+    valkey_glide->serializer = NULL;
+
     /* Clean up the standard object */
     zend_object_std_dtor(&valkey_glide->std);
 }
@@ -172,6 +214,9 @@ static void cleanup_client_config(valkey_glide_client_configuration_t* config) {
     }
 
     if (config->base.advanced_config) {
+        free_valkey_glide_otel_configuration(config->base.advanced_config->otel_config);
+        free_valkey_glide_near_cache_configuration(
+            config->base.advanced_config->near_cache_config);
         efree(config->base.advanced_config);
         config->base.advanced_config = NULL;
     }
@@ -270,6 +315,9 @@ PHP_METHOD(ValkeyGlide, __construct) {
         case 3: /* AZ_AFFINITY_REPLICAS_AND_PRIMARY */
             client_config.base.read_from = VALKEY_GLIDE_READ_FROM_AZ_AFFINITY_REPLICAS_AND_PRIMARY;
             break;
+        case 4: /* LOWEST_LATENCY */
+            client_config.base.read_from = VALKEY_GLIDE_READ_FROM_LOWEST_LATENCY;
+            break;
         case 0: /* PRIMARY */
         default:
             client_config.base.read_from = VALKEY_GLIDE_READ_FROM_PRIMARY;
@@ -399,6 +447,9 @@ PHP_METHOD(ValkeyGlide, __construct) {
         client_config.base.reconnect_strategy = NULL;
     }
 
+    /* Messages buffered for subscribe() and getMessages() */
+    long pubsub_buffer_size = VALKEY_GLIDE_PUBSUB_DEFAULT_BUFFER;
+
     /* Process advanced config if provided */
     if (advanced_config && Z_TYPE_P(advanced_config) == IS_ARRAY) {
         HashTable* advanced_ht = Z_ARRVAL_P(advanced_config);
@@ -415,8 +466,47 @@ PHP_METHOD(ValkeyGlide, __construct) {
             client_config.base.advanced_config->connection_timeout = -1; /* Not set */
         }
 
+        /* Check for connections_per_node */
+        zval* conns_per_node_val = zend_hash_str_find(advanced_ht, "connections_per_node", 20);
+        if (conns_per_node_val && Z_TYPE_P(conns_per_node_val) == IS_LONG) {
+            client_config.base.advanced_config->connections_per_node = Z_LVAL_P(conns_per_node_val);
+        } else {
+            client_config.base.advanced_config->connections_per_node = -1; /* Not set */
+        }
+
+        /* Check for blocking_connections_limit */
+        zval* blocking_conns_val =
+            zend_hash_str_find(advanced_ht, "blocking_connections_limit", 26);
+        if (blocking_conns_val && Z_TYPE_P(blocking_conns_val) == IS_LONG) {
+            client_config.base.advanced_config->blocking_connections_limit =
+                Z_LVAL_P(blocking_conns_val);
+        } else {
+            client_config.base.advanced_config->blocking_connections_limit = -1; /* Not set */
+        }
+
         /* Check for TLS config - for now just set to NULL */
         client_config.base.advanced_config->tls_config = NULL;
+
+        /* Check for OpenTelemetry config */
+        client_config.base.advanced_config->otel_config = parse_valkey_glide_otel_configuration(
+            zend_hash_str_find(advanced_ht, "otel", 4));
+
+        /* Check for near cache config */
+        client_config.base.advanced_config->near_cache_config =
+            parse_valkey_glide_near_cache_configuration(
+                zend_hash_str_find(advanced_ht, "near_cache", 10));
+
+        zval* pubsub_buffer_val = zend_hash_str_find(advanced_ht, "pubsub_buffer_size", 18);
+        if (pubsub_buffer_val && Z_TYPE_P(pubsub_buffer_val) == IS_LONG) {
+            if (Z_LVAL_P(pubsub_buffer_val) > 0) {
+                pubsub_buffer_size = Z_LVAL_P(pubsub_buffer_val);
+            } else {
+                php_error_docref(NULL,
+                                 E_WARNING,
+                                 "pubsub_buffer_size must be positive, using %d",
+                                 VALKEY_GLIDE_PUBSUB_DEFAULT_BUFFER);
+            }
+        }
     } else {
         client_config.base.advanced_config = NULL;
     }
@@ -431,6 +521,11 @@ PHP_METHOD(ValkeyGlide, __construct) {
     }
 
     valkey_glide->glide_client = create_glide_client(&client_config, false);
+    valkey_glide->near_cache   = valkey_glide_near_cache_attach(
+        &client_config, false, valkey_glide->glide_client, &valkey_glide->near_cache);
+    if (valkey_glide->glide_client) {
+        valkey_glide->pubsub = valkey_glide_pubsub_create(&client_config, pubsub_buffer_size);
+    }
 
     /* Clean up temporary configuration structures */
     cleanup_client_config(&client_config);
@@ -458,19 +553,95 @@ PHP_METHOD(ValkeyGlide, close) {
 /* Basic method stubs - these need to be implemented with ValkeyGlide */
 PHP_METHOD(ValkeyGlide, pipeline) { /* TODO: Implement */
 }
-PHP_METHOD(ValkeyGlide, publish) { /* TODO: Implement */
+
+/* Pub/Sub */
+PHP_METHOD(ValkeyGlide, publish) {
+    if (execute_publish_command(getThis(), ZEND_NUM_ARGS(), return_value, get_valkey_glide_ce())) {
+        return;
+    }
+    zval_dtor(return_value);
+    RETURN_FALSE;
+}
+
+PHP_METHOD(ValkeyGlide, psubscribe) {
+    if (execute_subscribe_command(getThis(),
+                                  ZEND_NUM_ARGS(),
+                                  return_value,
+                                  get_valkey_glide_ce(),
+                                  VALKEY_GLIDE_PUBSUB_PATTERN)) {
+        return;
+    }
+    zval_dtor(return_value);
+    RETURN_FALSE;
 }
-PHP_METHOD(ValkeyGlide, psubscribe) { /* TODO: Implement */
+
+PHP_METHOD(ValkeyGlide, ssubscribe) {
+    if (execute_subscribe_command(getThis(),
+                                  ZEND_NUM_ARGS(),
+                                  return_value,
+                                  get_valkey_glide_ce(),
+                                  VALKEY_GLIDE_PUBSUB_SHARDED)) {
+        return;
+    }
+    zval_dtor(return_value);
+    RETURN_FALSE;
 }
-PHP_METHOD(ValkeyGlide, ssubscribe) { /* TODO: Implement */
+
+PHP_METHOD(ValkeyGlide, subscribe) {
+    if (execute_subscribe_command(getThis(),
+                                  ZEND_NUM_ARGS(),
+                                  return_value,
+                                  get_valkey_glide_ce(),
+                                  VALKEY_GLIDE_PUBSUB_EXACT)) {
+        return;
+    }
+    zval_dtor(return_value);
+    RETURN_FALSE;
 }
-PHP_METHOD(ValkeyGlide, subscribe) { /* TODO: Implement */
+
+PHP_METHOD(ValkeyGlide, unsubscribe) {
+    if (execute_unsubscribe_command(getThis(),
+                                    ZEND_NUM_ARGS(),
+                                    return_value,
+                                    get_valkey_glide_ce(),
+                                    VALKEY_GLIDE_PUBSUB_EXACT)) {
+        return;
+    }
+    zval_dtor(return_value);
+    RETURN_FALSE;
 }
-PHP_METHOD(ValkeyGlide, unsubscribe) { /* TODO: Implement */
+
+PHP_METHOD(ValkeyGlide, punsubscribe) {
+    if (execute_unsubscribe_command(getThis(),
+                                    ZEND_NUM_ARGS(),
+                                    return_value,
+                                    get_valkey_glide_ce(),
+                                    VALKEY_GLIDE_PUBSUB_PATTERN)) {
+        return;
+    }
+    zval_dtor(return_value);
+    RETURN_FALSE;
 }
-PHP_METHOD(ValkeyGlide, punsubscribe) { /* TODO: Implement */
+
+PHP_METHOD(ValkeyGlide, sunsubscribe) {
+    if (execute_unsubscribe_command(getThis(),
+                                    ZEND_NUM_ARGS(),
+                                    return_value,
+                                    get_valkey_glide_ce(),
+                                    VALKEY_GLIDE_PUBSUB_SHARDED)) {
+        return;
+    }
+    zval_dtor(return_value);
+    RETURN_FALSE;
 }
-PHP_METHOD(ValkeyGlide, sunsubscribe) { /* TODO: Implement */
+
+PHP_METHOD(ValkeyGlide, getMessages) {
+    if (execute_get_messages_command(
+            getThis(), ZEND_NUM_ARGS(), return_value, get_valkey_glide_ce())) {
+        return;
+    }
+    zval_dtor(return_value);
+    RETURN_FALSE;
 }
 
 PHP_METHOD(ValkeyGlide, pubsub) { /* TODO: Implement */
@@ -163,6 +163,14 @@ class ValkeyGlide {
            */
           public const  READ_FROM_AZ_AFFINITY_REPLICAS_AND_PRIMARY = 3;
 
+          /**
+           *  @var int
+           * Send each read to the node with the lowest expected latency, the primary included.
+           * The client keeps a moving average of each node's round trip time and its pending
+           * reads, and picks the better of two randomly drawn nodes.
+           */
+          public const  READ_FROM_LOWEST_LATENCY = 4;
+
 
     /**
      *
@@ -214,6 +222,102 @@ class ValkeyGlide {
      *
      */
     public const PIPELINE = UNKNOWN;
+
+    /**
+     *
+     * @var int
+     * @cvalue VALKEY_GLIDE_OPT_SERIALIZER
+     *
+     */
+    public const OPT_SERIALIZER = UNKNOWN;
+
+    /**
+     *
+     * @var int
+     * @cvalue VALKEY_GLIDE_OPT_COMPRESSION
+     *
+     */
+    public const OPT_COMPRESSION = UNKNOWN;
+
+    /**
+     *
+     * @var int
+     * @cvalue VALKEY_GLIDE_OPT_COMPRESSION_LEVEL
+     *
+     */
+    public const OPT_COMPRESSION_LEVEL = UNKNOWN;
+
+    /**
+     *
+     * @var int
+     * @cvalue VALKEY_GLIDE_OPT_COMPRESSION_MIN_SIZE
+     *
+     */
+    public const OPT_COMPRESSION_MIN_SIZE = UNKNOWN;
+
+    /**
+     *
+     * @var int
+     * @cvalue VALKEY_GLIDE_SERIALIZER_NONE
+     *
+     */
+    public const SERIALIZER_NONE = UNKNOWN;
+
+    /**
+     *
+     * @var int
+     * @cvalue VALKEY_GLIDE_SERIALIZER_PHP
+     *
+     */
+    public const SERIALIZER_PHP = UNKNOWN;
+
+    /**
+     *
+     * @var int
+     * @cvalue VALKEY_GLIDE_SERIALIZER_IGBINARY
+     *
+     */
+    public const SERIALIZER_IGBINARY = UNKNOWN;
+
+    /**
+     *
+     * @var int
+     * @cvalue VALKEY_GLIDE_SERIALIZER_MSGPACK
+     *
+     */
+    public const SERIALIZER_MSGPACK = UNKNOWN;
+
+    /**
+     *
+     * @var int
+     * @cvalue VALKEY_GLIDE_SERIALIZER_JSON
+     *
+     */
+    public const SERIALIZER_JSON = UNKNOWN;
+
+    /**
+     *
+     * @var int
+     * @cvalue VALKEY_GLIDE_COMPRESSION_NONE
+     *
+     */
+    public const COMPRESSION_NONE = UNKNOWN;
+
+    /**
+     *
+     * @var int
+     * @cvalue VALKEY_GLIDE_COMPRESSION_ZSTD
+     *
+     */
+    public const COMPRESSION_ZSTD = UNKNOWN;
+
+    /**
+     *
+     * @var int
+     * @cvalue VALKEY_GLIDE_COMPRESSION_LZ4
+     *
+     */
+    public const COMPRESSION_LZ4 = UNKNOWN;
    
     /**
      * Create a new ValkeyGlide instance with the provided configuration.
@@ -228,7 +332,18 @@ class ValkeyGlide {
      * @param string|null $client_name           Client name identifier
      * @param int|null $inflight_requests_limit  Maximum number of concurrent requests
      * @param string|null $client_az             Client availability zone
-     * @param array|null $advanced_config        Advanced configuration ['connection_timeout' => 5000, 'tls_config' => [...]]
+     * @param array|null $advanced_config        Advanced configuration ['connection_timeout' => 5000, 'tls_config' => [...],
+     *                                          'otel' => ['traces' => ['endpoint' => 'grpc://host:4317', 'sample_percentage' => 1],
+     *                                          'metrics' => ['endpoint' => ...], 'flush_interval_ms' => 5000],
+     *                                          'near_cache' => ['max_bytes' => 8388608, 'ttl' => 60, 'prefixes' => ['user:']]]
+     *                                          The near cache keeps GET, HGET and HGETALL replies across requests in this worker,
+     *                                          invalidated through RESP3 client tracking. Requires Valkey/Redis 6.0 or later.
+     *                                          'connections_per_node' => 4 opens several multiplexed connections to a standalone server
+     *                                          and sends each request on the one with the fewest outstanding requests (default 1).
+     *                                          'blocking_connections_limit' => 4 sends blocking commands (BLPOP, XREAD BLOCK, ...) over up to
+     *                                          4 dedicated connections, opened on demand, so they don't delay other commands (default 0).
+     *                                          'pubsub_buffer_size' => 16384 is the number of Pub/Sub messages buffered until they are
+     *                                          read by subscribe() or getMessages(); further messages are dropped with a warning.
      * @param bool|null $lazy_connect            Whether to use lazy connection
      */
     public function __construct(
@@ -1143,6 +1258,29 @@ class ValkeyGlide {
      */
     public function getDel(string $key): ValkeyGlide|string|bool;
 
+    /**
+     * Read the Pub/Sub messages received since the last call, without waiting for more.
+     *
+     * @param int $max The maximum number of messages to return.
+     *
+     * @return array The messages, oldest first, each as
+     *               ['kind' => 'message', 'channel' => ..., 'message' => ...]. The kind is
+     *               'pmessage' for a pattern subscription, which adds a 'pattern' entry, and
+     *               'smessage' for a shard channel.
+     *
+     * @see ValkeyGlide::subscribe()
+     *
+     * @example
+     * $valkey_glide->subscribe(['news']);
+     * while (true) {
+     *     foreach ($valkey_glide->getMessages(100) as $message) {
+     *         echo "[{$message['channel']}]: {$message['message']}\n";
+     *     }
+     *     // ... other work ...
+     * }
+     */
+    public function getMessages(int $max = 1000): array;
+
   
     /**
      * Get the persistent connection ID, if there is one.
@@ -1488,6 +1626,29 @@ class ValkeyGlide {
      */
     public function hscan(string $key, null|string &$iterator, ?string $pattern = null, int $count = 0): ValkeyGlide|array|bool;
 
+    /**
+     * Iterate over the fields and values of a hash with HSCAN, requesting the
+     * next page while the current one is iterated.
+     *
+     * @see CollectionScanIterator
+     *
+     * @param string      $key      The hash to scan.
+     * @param string|null $pattern  An optional glob-style pattern to filter fields with.
+     * @param int         $count    The initial COUNT of each HSCAN, 100 by default.
+     * @param int         $maxCount The COUNT the iterator may grow up to, 16 times the
+     *                              initial COUNT by default. A maximum equal to the
+     *                              initial COUNT keeps it fixed.
+     *
+     * @return CollectionScanIterator|false An iterator of field => value, or false if the
+     *                                      client isn't connected.
+     *
+     * @example
+     * foreach ($valkey_glide->hscanIterator('big-hash', '*:1?3') as $field => $value) {
+     *     echo "[$field] => $value\n";
+     * }
+     */
+    public function hscanIterator(string $key, ?string $pattern = null, int $count = 0, int $maxCount = 0): CollectionScanIterator|false;
+
     /**
      * Set an expiration on a key member (KeyDB only).
      *
@@ -1982,17 +2143,21 @@ class ValkeyGlide {
      * Subscribe to one or more glob-style patterns
      *
      * @param array     $patterns One or more patterns to subscribe to.
-     * @param callable  $cb       A callback with the following prototype:
+     * @param ?callable $cb       A callback with the following prototype:
      *
      *                            <code>
-     *                            function ($valkey_glide, $channel, $message) { }
+     *                            function ($valkey_glide, $pattern, $channel, $message) { }
      *                            </code>
      *
+     *                            Without a callback, this returns at once and the messages are
+     *                            read with getMessages().
+     *
      * @see https://valkey.io/commands/psubscribe
+     * @see ValkeyGlide::subscribe()
      *
      * @return bool True if we were subscribed.
      */
-    public function psubscribe(array $patterns, callable $cb): bool;
+    public function psubscribe(array $patterns, ?callable $cb = null): bool;
 
     /**
      * Get a keys time to live in milliseconds.
@@ -2583,6 +2748,47 @@ class ValkeyGlide {
      */
     public function set(string $key, mixed $value, mixed $options = null): ValkeyGlide|string|bool;
 
+    /**
+     * Set a client option. Values are serialized, then compressed, as they are sent, and
+     * unpacked as they are read, by the string commands (GET, SET, MGET, MSET, ...) and the
+     * hash commands (HGET, HSET, HMGET, HGETALL, ...). Values that weren't packed, such as
+     * those written before the option was set, are returned as they are.
+     *
+     * OPTION                     VALUE
+     * -------------------------  --------------------------------------------------------------
+     * OPT_SERIALIZER             SERIALIZER_NONE, SERIALIZER_PHP, SERIALIZER_JSON,
+     *                            SERIALIZER_IGBINARY or SERIALIZER_MSGPACK if compiled in.
+     * OPT_COMPRESSION            COMPRESSION_NONE, COMPRESSION_LZ4 or COMPRESSION_ZSTD if
+     *                            compiled in.
+     * OPT_COMPRESSION_LEVEL      The codec's compression level, 0 for its default.
+     * OPT_COMPRESSION_MIN_SIZE   Values shorter than this many bytes are sent uncompressed
+     *                            (default 64).
+     *
+     * Batches (multi() and pipeline()) send their values as they are.
+     *
+     * @param int   $option The option to set.
+     * @param mixed $value  The option's value.
+     *
+     * @return bool True if the option was set, false if it is unknown or not compiled in.
+     *
+     * @example $valkey_glide->setOption(ValkeyGlide::OPT_SERIALIZER, ValkeyGlide::SERIALIZER_PHP);
+     * @example $valkey_glide->setOption(ValkeyGlide::OPT_COMPRESSION, ValkeyGlide::COMPRESSION_ZSTD);
+     */
+    public function setOption(int $option, mixed $value): bool;
+
+    /**
+     * Get the value of a client option.
+     *
+     * @see ValkeyGlide::setOption()
+     *
+     * @param int $option The option to get.
+     *
+     * @return mixed The option's value, or false if the option is unknown.
+     *
+     * @example $valkey_glide->getOption(ValkeyGlide::OPT_SERIALIZER);
+     */
+    public function getOption(int $option): mixed;
+
     /**
      * Set a specific bit in a ValkeyGlide string to zero or one
      *
@@ -2803,15 +3009,33 @@ class ValkeyGlide {
      */
     public function sscan(string $key, null|string &$iterator, ?string $pattern = null, int $count = 0): array|false;
 
+    /**
+     * Iterate over the members of a set with SSCAN, requesting the next page
+     * while the current one is iterated.
+     *
+     * @see CollectionScanIterator
+     * @see ValkeyGlide::hscanIterator()
+     *
+     * @return CollectionScanIterator|false An iterator of the members, or false if the
+     *                                      client isn't connected.
+     *
+     * @example
+     * foreach ($valkey_glide->sscanIterator('myset') as $member) {
+     *     echo "$member\n";
+     * }
+     */
+    public function sscanIterator(string $key, ?string $pattern = null, int $count = 0, int $maxCount = 0): CollectionScanIterator|false;
+
     /**
      * Subscribes the client to the specified shard channels.
      *
-     * @param array    $channels One or more channel names.
-     * @param callable $cb       The callback PhpValkeyGlide will invoke when we receive a message
-     *                           from one of the subscribed channels.
+     * @param array     $channels One or more channel names.
+     * @param ?callable $cb       The callback PhpValkeyGlide will invoke when we receive a message
+     *                            from one of the subscribed channels. Without a callback, this
+     *                            returns at once and the messages are read with getMessages().
      *
-     * @return bool True on success, false on faiilure.  Note that this command will block the
-     *              client in a subscribe loop, waiting for messages to arrive.
+     * @return bool True on success, false on faiilure.  Note that with a callback this command
+     *              will block the client in a subscribe loop, waiting for messages to arrive.
      *
      * @see https://valkey.io/commands/ssubscribe
      *
@@ -2832,7 +3056,7 @@ class ValkeyGlide {
      * // broken and this command will execute.
      * echo "Subscribe loop ended\n";
      */
-    public function ssubscribe(array $channels, callable $cb): bool;
+    public function ssubscribe(array $channels, ?callable $cb = null): bool;
 
     /**
      * Retrieve the length of a ValkeyGlide STRING key.
@@ -2851,12 +3075,17 @@ class ValkeyGlide {
     /**
      * Subscribe to one or more ValkeyGlide pubsub channels.
      *
-     * @param array    $channels One or more channel names.
-     * @param callable $cb       The callback PhpValkeyGlide will invoke when we receive a message
-     *                           from one of the subscribed channels.
+     * Messages are received by a dedicated connection, which is reopened whenever the
+     * subscriptions change; a message published meanwhile may be received twice.
+     *
+     * @param array     $channels One or more channel names.
+     * @param ?callable $cb       The callback PhpValkeyGlide will invoke when we receive a message
+     *                            from one of the subscribed channels. Without a callback, this
+     *                            returns at once and the messages are read with getMessages().
      *
-     * @return bool True on success, false on faiilure.  Note that this command will block the
-     *              client in a subscribe loop, waiting for messages to arrive.
+     * @return bool True on success, false on faiilure.  Note that with a callback this command
+     *              will block the client in a subscribe loop, until every channel is
+     *              unsubscribed or the callback throws.
      *
      * @see https://valkey.io/commands/subscribe
      *
@@ -2877,7 +3106,7 @@ class ValkeyGlide {
      * // broken and this command will execute.
      * echo "Subscribe loop ended\n";
      */
-    public function subscribe(array $channels, callable $cb): bool;
+    public function subscribe(array $channels, ?callable $cb = null): bool;
 
     /**
      * Unsubscribes the client from the given shard channels,
@@ -4062,6 +4291,23 @@ class ValkeyGlide {
      */
     public function zscan(string $key, null|string &$iterator, ?string $pattern = null, int $count = 0): ValkeyGlide|array|false;
 
+    /**
+     * Iterate over the members and scores of a sorted set with ZSCAN, requesting
+     * the next page while the current one is iterated.
+     *
+     * @see CollectionScanIterator
+     * @see ValkeyGlide::hscanIterator()
+     *
+     * @return CollectionScanIterator|false An iterator of member => score, or false if the
+     *                                      client isn't connected.
+     *
+     * @example
+     * foreach ($valkey_glide->zscanIterator('leaderboard') as $member => $score) {
+     *     echo "$member: $score\n";
+     * }
+     */
+    public function zscanIterator(string $key, ?string $pattern = null, int $count = 0, int $maxCount = 0): CollectionScanIterator|false;
+
     /**
      * Retrieve the union of one or more sorted sets
      *
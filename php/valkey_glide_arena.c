@@ -0,0 +1,179 @@
+/*
+  +----------------------------------------------------------------------+
+  | Copyright (c) 2023-2025 The PHP Group                                |
+  +----------------------------------------------------------------------+
+  | This source file is subject to version 3.01 of the PHP license,      |
+  | that is bundled with this package in the file LICENSE, and is        |
+  | available through the world-wide-web at the following url:           |
+  | http://www.php.net/license/3_01.txt                                  |
+  | If you did not receive a copy of the PHP license and are unable to   |
+  | obtain it through the world-wide-web, please send a note to          |
+  | license@php.net so we can mail you a copy immediately.               |
+  +----------------------------------------------------------------------+
+*/
+
+#include "valkey_glide_arena.h"
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+
+#define ARENA_ALIGNMENT sizeof(uintptr_t)
+
+struct arena_block {
+    arena_block_t* next;
+    uintptr_t      data[];
+};
+
+void arena_init(arg_arena_t* arena) {
+    arena->pos    = (char*)arena->inline_storage;
+    arena->end    = arena->pos + sizeof(arena->inline_storage);
+    arena->blocks = NULL;
+}
+
+void arena_free(arg_arena_t* arena) {
+    arena_block_t* block = arena->blocks;
+    while (block) {
+        arena_block_t* next = block->next;
+        efree(block);
+        block = next;
+    }
+    arena_init(arena);
+}
+
+/* Make size bytes available at an aligned position, moving to a new heap block if needed */
+static void arena_reserve(arg_arena_t* arena, size_t size) {
+    uintptr_t aligned =
+        ((uintptr_t)arena->pos + ARENA_ALIGNMENT - 1) & ~(uintptr_t)(ARENA_ALIGNMENT - 1);
+    if (aligned <= (uintptr_t)arena->end && (size_t)((uintptr_t)arena->end - aligned) >= size) {
+        arena->pos = (char*)aligned;
+        return;
+    }
+
+    /* The rest of the current buffer is abandoned until the arena is freed */
+    size_t         block_size = MAX(size, VALKEY_GLIDE_ARENA_MIN_BLOCK);
+    arena_block_t* block      = emalloc(sizeof(*block) + block_size);
+    block->next   = arena->blocks;
+    arena->blocks = block;
+    arena->pos    = (char*)block->data;
+    arena->end    = arena->pos + block_size;
+}
+
+void* arena_alloc(arg_arena_t* arena, size_t size) {
+    arena_reserve(arena, size);
+    void* ptr = arena->pos;
+    arena->pos += size;
+    return ptr;
+}
+
+int arena_alloc_args(arg_arena_t*    arena,
+                     int             count,
+                     uintptr_t**     args_out,
+                     unsigned long** args_len_out) {
+    if (count <= 0) {
+        return 0;
+    }
+
+    size_t arrays_size = (size_t)count * (sizeof(uintptr_t) + sizeof(unsigned long));
+    arena_reserve(arena, arrays_size + (size_t)count * VALKEY_GLIDE_ARENA_NUMBER_SIZE);
+
+    *args_out     = (uintptr_t*)arena->pos;
+    *args_len_out = (unsigned long*)(arena->pos + (size_t)count * sizeof(uintptr_t));
+    arena->pos += arrays_size;
+    return 1;
+}
+
+/* Unaligned bytes for text */
+static char* arena_alloc_text(arg_arena_t* arena, size_t size) {
+    if ((size_t)(arena->end - arena->pos) < size) {
+        arena_reserve(arena, size);
+    }
+    char* text = arena->pos;
+    arena->pos += size;
+    return text;
+}
+
+char* arena_strndup(arg_arena_t* arena, const char* str, size_t len) {
+    char* copy = arena_alloc_text(arena, len + 1);
+    memcpy(copy, str, len);
+    copy[len] = '\0';
+    return copy;
+}
+
+char* arena_long_to_string(arg_arena_t* arena, long value, size_t* len) {
+    char  digits[24];
+    char* p = digits + sizeof(digits);
+    /* Negate as unsigned, so that LONG_MIN doesn't overflow */
+    unsigned long magnitude = value < 0 ? 0UL - (unsigned long)value : (unsigned long)value;
+
+    do {
+        *--p = (char)('0' + magnitude % 10);
+        magnitude /= 10;
+    } while (magnitude);
+    if (value < 0) {
+        *--p = '-';
+    }
+
+    *len = (size_t)(digits + sizeof(digits) - p);
+    return arena_strndup(arena, p, *len);
+}
+
+char* arena_double_to_string(arg_arena_t* arena, double value, size_t* len) {
+    return arena_printf(arena, len, "%.17g", value);
+}
+
+char* arena_printf(arg_arena_t* arena, size_t* len, const char* format, ...) {
+    va_list args;
+    size_t  available = (size_t)(arena->end - arena->pos);
+
+    va_start(args, format);
+    int written = vsnprintf(arena->pos, available, format, args);
+    va_end(args);
+    if (written < 0) {
+        *len = 0;
+        return NULL;
+    }
+
+    if ((size_t)written >= available) {
+        /* Didn't fit: format again where there is room */
+        arena_reserve(arena, (size_t)written + 1);
+        va_start(args, format);
+        vsnprintf(arena->pos, (size_t)written + 1, format, args);
+        va_end(args);
+    }
+
+    char* text = arena->pos;
+    arena->pos += written + 1;
+    *len = (size_t)written;
+    return text;
+}
+
+char* arena_zval_to_string(arg_arena_t* arena, zval* z, size_t* len) {
+    switch (Z_TYPE_P(z)) {
+        case IS_STRING:
+            *len = Z_STRLEN_P(z);
+            return Z_STRVAL_P(z);
+
+        case IS_LONG:
+            return arena_long_to_string(arena, Z_LVAL_P(z), len);
+
+        case IS_DOUBLE:
+            return arena_printf(arena, len, "%.6g", Z_DVAL_P(z));
+
+        case IS_TRUE:
+            *len = 1;
+            return (char*)"1";
+
+        case IS_FALSE:
+            *len = 1;
+            return (char*)"0";
+
+        default: {
+            zend_string* str  = zval_get_string(z);
+            char*        copy = arena_strndup(arena, ZSTR_VAL(str), ZSTR_LEN(str));
+            *len              = ZSTR_LEN(str);
+            zend_string_release(str);
+            return copy;
+        }
+    }
+}
@@ -0,0 +1,79 @@
+/*
+  +----------------------------------------------------------------------+
+  | Copyright (c) 2023-2025 The PHP Group                                |
+  +----------------------------------------------------------------------+
+  | This source file is subject to version 3.01 of the PHP license,      |
+  | that is bundled with this package in the file LICENSE, and is        |
+  | available through the world-wide-web at the following url:           |
+  | http://www.php.net/license/3_01.txt                                  |
+  | If you did not receive a copy of the PHP license and are unable to   |
+  | obtain it through the world-wide-web, please send a note to          |
+  | license@php.net so we can mail you a copy immediately.               |
+  +----------------------------------------------------------------------+
+*/
+
+#ifndef VALKEY_GLIDE_ARENA_H
+#define VALKEY_GLIDE_ARENA_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "php.h"
+
+/* Bytes kept on the stack: the arrays and numbers of a command with a few dozen arguments */
+#define VALKEY_GLIDE_ARENA_INLINE_SIZE 2048
+/* Room kept per argument for its text, so that formatting one number per argument never
+ * allocates once the argument arrays are reserved */
+#define VALKEY_GLIDE_ARENA_NUMBER_SIZE 32
+/* Smallest heap block, for the strings added after the arrays outgrew their reservation */
+#define VALKEY_GLIDE_ARENA_MIN_BLOCK 4096
+
+typedef struct arena_block arena_block_t;
+
+/*
+ * Per-call storage for the arguments of a command: the argument arrays and the text of
+ * numeric arguments. Storage comes from a buffer on the stack, then from heap blocks once
+ * the buffer is full, and is released all at once by arena_free().
+ * The arena points into itself, so it must stay where it was initialized
+ */
+typedef struct {
+    char*          pos;    /* Next free byte of the current buffer or block */
+    char*          end;    /* End of the current buffer or block */
+    arena_block_t* blocks; /* Heap blocks, most recent first */
+    uintptr_t      inline_storage[VALKEY_GLIDE_ARENA_INLINE_SIZE / sizeof(uintptr_t)];
+} arg_arena_t;
+
+void arena_init(arg_arena_t* arena);
+void arena_free(arg_arena_t* arena);
+
+/* Allocate size bytes aligned for pointers; never returns NULL */
+void* arena_alloc(arg_arena_t* arena, size_t size);
+
+/*
+ * Allocate the argument arrays of a command with count arguments, together with room to
+ * format one number per argument. Returns 1 on success, 0 if count is not positive
+ */
+int arena_alloc_args(arg_arena_t*    arena,
+                     int             count,
+                     uintptr_t**     args_out,
+                     unsigned long** args_len_out);
+
+/* Copy len bytes of str as a NUL-terminated string */
+char* arena_strndup(arg_arena_t* arena, const char* str, size_t len);
+
+/* Format a long in decimal */
+char* arena_long_to_string(arg_arena_t* arena, long value, size_t* len);
+
+/* Format a double with "%.17g", precise enough to parse back to the same value */
+char* arena_double_to_string(arg_arena_t* arena, double value, size_t* len);
+
+/* Format with a printf-style format, e.g. "%.6g" where double_to_string() was used */
+char* arena_printf(arg_arena_t* arena, size_t* len, const char* format, ...);
+
+/*
+ * Convert a zval to a command argument, as zval_to_string_safe() does: strings are used in
+ * place, other types are formatted in the arena
+ */
+char* arena_zval_to_string(arg_arena_t* arena, zval* z, size_t* len);
+
+#endif /* VALKEY_GLIDE_ARENA_H */
@@ -10,12 +10,16 @@
 
 #include <ext/spl/spl_exceptions.h>
 
+#include "cluster_scan_iterator.h"
+#include "collection_scan_iterator.h"
 #include "common.h"
 #include "ext/standard/info.h"
 #include "valkey_glide_commands_common.h"
 #include "valkey_glide_geo_common.h"
 #include "valkey_glide_hash_common.h" /* Include hash command framework */
 #include "valkey_glide_list_common.h"
+#include "valkey_glide_near_cache.h"
+#include "valkey_glide_otel.h"
 #include "valkey_glide_s_common.h"
 #include "valkey_glide_x_common.h"
 #include "valkey_glide_z_common.h"
@@ -99,6 +103,9 @@ PHP_METHOD(ValkeyGlideCluster, __construct) {
         case 3: /* AZ_AFFINITY_REPLICAS_AND_PRIMARY */
             client_config.base.read_from = VALKEY_GLIDE_READ_FROM_AZ_AFFINITY_REPLICAS_AND_PRIMARY;
             break;
+        case 4: /* LOWEST_LATENCY */
+            client_config.base.read_from = VALKEY_GLIDE_READ_FROM_LOWEST_LATENCY;
+            break;
         case 0: /* PRIMARY */
         default:
             client_config.base.read_from = VALKEY_GLIDE_READ_FROM_PRIMARY;
@@ -149,15 +156,60 @@ PHP_METHOD(ValkeyGlideCluster, __construct) {
         client_config.base.addresses[0].port = 7001;
     }
 
+    /* Process advanced config if provided */
+    if (advanced_config && Z_TYPE_P(advanced_config) == IS_ARRAY) {
+        HashTable* advanced_ht = Z_ARRVAL_P(advanced_config);
+
+        client_config.base.advanced_config =
+            ecalloc(1, sizeof(valkey_glide_advanced_base_client_configuration_t));
+
+        zval* conn_timeout_val = zend_hash_str_find(advanced_ht, "connection_timeout", 18);
+        client_config.base.advanced_config->connection_timeout =
+            (conn_timeout_val && Z_TYPE_P(conn_timeout_val) == IS_LONG)
+                ? Z_LVAL_P(conn_timeout_val)
+                : -1; /* Not set */
+        zval* conns_per_node_val = zend_hash_str_find(advanced_ht, "connections_per_node", 20);
+        client_config.base.advanced_config->connections_per_node =
+            (conns_per_node_val && Z_TYPE_P(conns_per_node_val) == IS_LONG)
+                ? Z_LVAL_P(conns_per_node_val)
+                : -1; /* Not set */
+        zval* blocking_conns_val =
+            zend_hash_str_find(advanced_ht, "blocking_connections_limit", 26);
+        client_config.base.advanced_config->blocking_connections_limit =
+            (blocking_conns_val && Z_TYPE_P(blocking_conns_val) == IS_LONG)
+                ? Z_LVAL_P(blocking_conns_val)
+                : -1; /* Not set */
+        client_config.base.advanced_config->tls_config  = NULL;
+        client_config.base.advanced_config->otel_config = parse_valkey_glide_otel_configuration(
+            zend_hash_str_find(advanced_ht, "otel", 4));
+        client_config.base.advanced_config->near_cache_config =
+            parse_valkey_glide_near_cache_configuration(
+                zend_hash_str_find(advanced_ht, "near_cache", 10));
+
+        zval* partial_results_val = zend_hash_str_find(advanced_ht, "partial_results", 15);
+        valkey_glide->partial_results = partial_results_val && zend_is_true(partial_results_val);
+    }
+
     /* Note: This should use a cluster-specific create function */
     /* For now, we'll cast to regular client config */
     valkey_glide->glide_client =
         create_glide_client((valkey_glide_client_configuration_t*)&client_config, true);
+    valkey_glide->near_cache =
+        valkey_glide_near_cache_attach((valkey_glide_client_configuration_t*)&client_config,
+                                       true,
+                                       valkey_glide->glide_client,
+                                       &valkey_glide->near_cache);
 
     /* Clean up temporary configuration structures */
     if (client_config.base.addresses) {
         efree(client_config.base.addresses);
     }
+    if (client_config.base.advanced_config) {
+        free_valkey_glide_otel_configuration(client_config.base.advanced_config->otel_config);
+        free_valkey_glide_near_cache_configuration(
+            client_config.base.advanced_config->near_cache_config);
+        efree(client_config.base.advanced_config);
+    }
 }
 
 static zend_function_entry valkey_glide_cluster_methods[] = {
@@ -721,6 +773,12 @@ SORT_RO_METHOD_IMPL(ValkeyGlideCluster)
 /* {{{ proto ValkeyGlideCluster::object(string subcmd, string key) */
 OBJECT_METHOD_IMPL(ValkeyGlideCluster)
 
+/* {{{ proto bool ValkeyGlideCluster::setOption(int option, mixed value) */
+SETOPTION_METHOD_IMPL(ValkeyGlideCluster)
+
+/* {{{ proto mixed ValkeyGlideCluster::getOption(int option) */
+GETOPTION_METHOD_IMPL(ValkeyGlideCluster)
+
 /* {{{ proto null ValkeyGlideCluster::subscribe(array chans, callable cb) */
 PHP_METHOD(ValkeyGlideCluster, subscribe) {
 }
@@ -791,14 +849,99 @@ SCAN_METHOD_IMPL(ValkeyGlideCluster)
 SSCAN_METHOD_IMPL(ValkeyGlideCluster)
 /* }}} */
 
+/* {{{ proto CollectionScanIterator ValkeyGlideCluster::sscanIterator(string key,
+ *                                    [string pattern, long count, long maxCount]) */
+COLLECTION_SCAN_ITERATOR_METHOD_IMPL(ValkeyGlideCluster, sscanIterator, SScan)
+/* }}} */
+
 /* {{{ proto ValkeyGlideCluster::zscan(string key, long it [string pat, long cnt]) */
 ZSCAN_METHOD_IMPL(ValkeyGlideCluster)
 /* }}} */
 
+/* {{{ proto CollectionScanIterator ValkeyGlideCluster::zscanIterator(string key,
+ *                                    [string pattern, long count, long maxCount]) */
+COLLECTION_SCAN_ITERATOR_METHOD_IMPL(ValkeyGlideCluster, zscanIterator, ZScan)
+/* }}} */
+
 /* {{{ proto ValkeyGlideCluster::hscan(string key, long it [string pat, long cnt]) */
 HSCAN_METHOD_IMPL(ValkeyGlideCluster)
 /* }}} */
 
+/* {{{ proto CollectionScanIterator ValkeyGlideCluster::hscanIterator(string key,
+ *                                    [string pattern, long count, long maxCount]) */
+COLLECTION_SCAN_ITERATOR_METHOD_IMPL(ValkeyGlideCluster, hscanIterator, HScan)
+/* }}} */
+
+/* {{{ proto ClusterScanIterator ValkeyGlideCluster::scanParallel([string pat, long cnt, string type,
+ *                                                                 long concurrency, long rate]) */
+PHP_METHOD(ValkeyGlideCluster, scanParallel) {
+    valkey_glide_object* valkey_glide;
+    char *               pattern = NULL, *type = NULL;
+    size_t               pattern_len = 0, type_len = 0;
+    zend_long            count = 0, concurrency = 0, max_scans_per_second = 0;
+
+    ZEND_PARSE_PARAMETERS_START(0, 5)
+    Z_PARAM_OPTIONAL
+    Z_PARAM_STRING_OR_NULL(pattern, pattern_len)
+    Z_PARAM_LONG(count)
+    Z_PARAM_STRING_OR_NULL(type, type_len)
+    Z_PARAM_LONG(concurrency)
+    Z_PARAM_LONG(max_scans_per_second)
+    ZEND_PARSE_PARAMETERS_END();
+
+    valkey_glide = VALKEY_GLIDE_PHP_ZVAL_GET_OBJECT(valkey_glide_object, getThis());
+    if (!valkey_glide || !valkey_glide->glide_client) {
+        RETURN_FALSE;
+    }
+
+    /* Up to five options, each a name and a value */
+    uintptr_t     args[10];
+    unsigned long args_len[10];
+    char*         numbers[3] = {NULL, NULL, NULL};
+    int           arg_count  = 0, number_count = 0;
+
+    if (pattern && pattern_len > 0) {
+        args[arg_count]       = (uintptr_t)"MATCH";
+        args_len[arg_count++] = 5;
+        args[arg_count]       = (uintptr_t)pattern;
+        args_len[arg_count++] = pattern_len;
+    }
+    if (type && type_len > 0) {
+        args[arg_count]       = (uintptr_t)"TYPE";
+        args_len[arg_count++] = 4;
+        args[arg_count]       = (uintptr_t)type;
+        args_len[arg_count++] = type_len;
+    }
+
+    const char* number_names[3]  = {"COUNT", "CONCURRENCY", "RATE"};
+    zend_long   number_values[3] = {count, concurrency, max_scans_per_second};
+    for (int i = 0; i < 3; i++) {
+        /* 0 leaves the default */
+        if (number_values[i] <= 0) {
+            continue;
+        }
+        size_t number_len     = 0;
+        numbers[number_count] = alloc_long_string(number_values[i], &number_len);
+        args[arg_count]       = (uintptr_t)number_names[i];
+        args_len[arg_count++] = strlen(number_names[i]);
+        args[arg_count]       = (uintptr_t)numbers[number_count++];
+        args_len[arg_count++] = number_len;
+    }
+
+    ParallelClusterScan* scan =
+        start_parallel_cluster_scan(valkey_glide->glide_client, arg_count, args, args_len);
+
+    for (int i = 0; i < number_count; i++) {
+        efree(numbers[i]);
+    }
+
+    if (!scan) {
+        RETURN_FALSE;
+    }
+    cluster_scan_iterator_init(return_value, scan);
+}
+/* }}} */
+
 /* {{{ proto ValkeyGlideCluster::flushdb(string key, [bool async])
  *     proto ValkeyGlideCluster::flushdb(array host_port, [bool async]) */
 FLUSHDB_METHOD_IMPL(ValkeyGlideCluster)
@@ -91,6 +91,102 @@ class ValkeyGlideCluster {
          * Disables the periodic checks.
          */
         public const    PERIODIC_CHECK_DISABLED = 1;
+
+    /**
+     *
+     * @var int
+     * @cvalue VALKEY_GLIDE_OPT_SERIALIZER
+     *
+     */
+    public const OPT_SERIALIZER = UNKNOWN;
+
+    /**
+     *
+     * @var int
+     * @cvalue VALKEY_GLIDE_OPT_COMPRESSION
+     *
+     */
+    public const OPT_COMPRESSION = UNKNOWN;
+
+    /**
+     *
+     * @var int
+     * @cvalue VALKEY_GLIDE_OPT_COMPRESSION_LEVEL
+     *
+     */
+    public const OPT_COMPRESSION_LEVEL = UNKNOWN;
+
+    /**
+     *
+     * @var int
+     * @cvalue VALKEY_GLIDE_OPT_COMPRESSION_MIN_SIZE
+     *
+     */
+    public const OPT_COMPRESSION_MIN_SIZE = UNKNOWN;
+
+    /**
+     *
+     * @var int
+     * @cvalue VALKEY_GLIDE_SERIALIZER_NONE
+     *
+     */
+    public const SERIALIZER_NONE = UNKNOWN;
+
+    /**
+     *
+     * @var int
+     * @cvalue VALKEY_GLIDE_SERIALIZER_PHP
+     *
+     */
+    public const SERIALIZER_PHP = UNKNOWN;
+
+    /**
+     *
+     * @var int
+     * @cvalue VALKEY_GLIDE_SERIALIZER_IGBINARY
+     *
+     */
+    public const SERIALIZER_IGBINARY = UNKNOWN;
+
+    /**
+     *
+     * @var int
+     * @cvalue VALKEY_GLIDE_SERIALIZER_MSGPACK
+     *
+     */
+    public const SERIALIZER_MSGPACK = UNKNOWN;
+
+    /**
+     *
+     * @var int
+     * @cvalue VALKEY_GLIDE_SERIALIZER_JSON
+     *
+     */
+    public const SERIALIZER_JSON = UNKNOWN;
+
+    /**
+     *
+     * @var int
+     * @cvalue VALKEY_GLIDE_COMPRESSION_NONE
+     *
+     */
+    public const COMPRESSION_NONE = UNKNOWN;
+
+    /**
+     *
+     * @var int
+     * @cvalue VALKEY_GLIDE_COMPRESSION_ZSTD
+     *
+     */
+    public const COMPRESSION_ZSTD = UNKNOWN;
+
+    /**
+     *
+     * @var int
+     * @cvalue VALKEY_GLIDE_COMPRESSION_LZ4
+     *
+     */
+    public const COMPRESSION_LZ4 = UNKNOWN;
     
     /**
      * Create a new ValkeyGlideCluster instance with the provided configuration.
@@ -105,7 +201,19 @@ class ValkeyGlideCluster {
      * @param int|null $periodic_checks               Periodic checks configuration
      * @param int|null $inflight_requests_limit       Maximum number of concurrent requests
      * @param string|null $client_az                  Client availability zone
-     * @param array|null $advanced_config             Advanced configuration ['connection_timeout' => 5000, 'tls_config' => [...]]
+     * @param array|null $advanced_config             Advanced configuration ['connection_timeout' => 5000, 'tls_config' => [...],
+     *                                               'otel' => ['traces' => ['endpoint' => 'grpc://host:4317', 'sample_percentage' => 1],
+     *                                               'metrics' => ['endpoint' => ...], 'flush_interval_ms' => 5000],
+     *                                               'near_cache' => ['max_bytes' => 8388608, 'ttl' => 60, 'prefixes' => ['user:']]]
+     *                                               The near cache keeps GET, HGET and HGETALL replies across requests in this worker,
+     *                                               invalidated through RESP3 client tracking. Requires Valkey/Redis 6.0 or later.
+     *                                               'connections_per_node' => 4 opens several multiplexed connections to a standalone server
+     *                                               and sends each request on the one with the fewest outstanding requests (default 1).
+     *                                               'blocking_connections_limit' => 4 sends blocking commands (BLPOP, XREAD BLOCK, ...) over up to
+     *                                               4 dedicated connections, opened on demand, so they don't delay other commands (default 0).
+     *                                               'partial_results' => true makes mget, mset, del and unlink warn about the hash slots
+     *                                               that failed instead of failing as a whole: mget returns false for their keys and
+     *                                               del/unlink count the keys removed from the other slots.
      * @param bool|null $lazy_connect                 Whether to use lazy connection
      */
     public function __construct(
@@ -493,6 +601,11 @@ class ValkeyGlideCluster {
      */
     public function hscan(string $key, null|string &$iterator, ?string $pattern = null, int $count = 0): array|bool;
 
+    /**
+     * @see ValkeyGlide::hscanIterator
+     */
+    public function hscanIterator(string $key, ?string $pattern = null, int $count = 0, int $maxCount = 0): CollectionScanIterator|false;
+
     /**
      * @see ValkeyGlide::expiremember
      */
@@ -802,6 +915,23 @@ class ValkeyGlideCluster {
      */
     public function scan(ClusterScanCursor $iterator, ?string $pattern = null, int $count = 0, ?string $type = null): bool|array;
 
+    /**
+     * Scan the keys of the whole cluster, several nodes at a time.
+     *
+     * The keys are fetched in batches while the returned iterator is consumed,
+     * and the scan never runs more than a few batches per node ahead of it.
+     * Slots that move during the scan are scanned again on their new node.
+     *
+     * @param string|null $pattern           Only return keys matching this pattern.
+     * @param int         $count             The COUNT hint of each SCAN, 0 for the server default.
+     * @param string|null $type              Only return keys of this type.
+     * @param int         $concurrency       The number of nodes scanned at once, 0 for the default of 4.
+     * @param int         $maxScansPerSecond Limit on the SCAN commands sent per second, 0 for no limit.
+     *
+     * @return ClusterScanIterator|false An iterator over the keys, or false on failure.
+     */
+    public function scanParallel(?string $pattern = null, int $count = 0, ?string $type = null, int $concurrency = 0, int $maxScansPerSecond = 0): ClusterScanIterator|false;
+
     /**
      * @see ValkeyGlide::scard
      */
@@ -827,6 +957,16 @@ class ValkeyGlideCluster {
      */
     public function set(string $key, mixed $value, mixed $options = null): ValkeyGlideCluster|string|bool;
 
+    /**
+     * @see ValkeyGlide::setOption()
+     */
+    public function setOption(int $option, mixed $value): bool;
+
+    /**
+     * @see ValkeyGlide::getOption()
+     */
+    public function getOption(int $option): mixed;
+
     /**
      * @see ValkeyGlide::setbit
      */
@@ -913,6 +1053,11 @@ class ValkeyGlideCluster {
      */
     public function sscan(string $key, null|string &$iterator, ?string $pattern = null, int $count = 0): array|false;
 
+    /**
+     * @see ValkeyGlide::sscanIterator
+     */
+    public function sscanIterator(string $key, ?string $pattern = null, int $count = 0, int $maxCount = 0): CollectionScanIterator|false;
+
     /**
      * @see ValkeyGlide::strlen
      */
@@ -1160,6 +1305,11 @@ class ValkeyGlideCluster {
      */
     public function zscan(string $key, null|string &$iterator, ?string $pattern = null, int $count = 0): ValkeyGlideCluster|bool|array;
 
+    /**
+     * @see ValkeyGlide::zscanIterator
+     */
+    public function zscanIterator(string $key, ?string $pattern = null, int $count = 0, int $maxCount = 0): CollectionScanIterator|false;
+
     /**
      * @see ValkeyGlide::zScore
      */
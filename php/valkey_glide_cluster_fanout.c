@@ -0,0 +1,391 @@
+/*
+  +----------------------------------------------------------------------+
+  | Copyright (c) 2023-2025 The PHP Group                                |
+  +----------------------------------------------------------------------+
+  | This source file is subject to version 3.01 of the PHP license,      |
+  | that is bundled with this package in the file LICENSE, and is        |
+  | available through the world-wide-web at the following url:           |
+  | http://www.php.net/license/3_01.txt                                  |
+  | If you did not receive a copy of the PHP license and are unable to   |
+  | obtain it through the world-wide-web, please send a note to          |
+  | license@php.net so we can mail you a copy immediately.               |
+  +----------------------------------------------------------------------+
+*/
+
+#include "valkey_glide_cluster_fanout.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "command_response.h"
+#include "valkey_glide_arena.h"
+#include "valkey_glide_near_cache.h"
+#include "valkey_glide_otel.h"
+#include "valkey_glide_serializer.h"
+
+#define CLUSTER_SLOT_MASK 16383
+
+/* CRC16-CCITT (XModem), the key hash of the cluster specification */
+static const uint16_t crc16_table[256] = {
+    0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50a5, 0x60c6, 0x70e7,
+    0x8108, 0x9129, 0xa14a, 0xb16b, 0xc18c, 0xd1ad, 0xe1ce, 0xf1ef,
+    0x1231, 0x0210, 0x3273, 0x2252, 0x52b5, 0x4294, 0x72f7, 0x62d6,
+    0x9339, 0x8318, 0xb37b, 0xa35a, 0xd3bd, 0xc39c, 0xf3ff, 0xe3de,
+    0x2462, 0x3443, 0x0420, 0x1401, 0x64e6, 0x74c7, 0x44a4, 0x5485,
+    0xa56a, 0xb54b, 0x8528, 0x9509, 0xe5ee, 0xf5cf, 0xc5ac, 0xd58d,
+    0x3653, 0x2672, 0x1611, 0x0630, 0x76d7, 0x66f6, 0x5695, 0x46b4,
+    0xb75b, 0xa77a, 0x9719, 0x8738, 0xf7df, 0xe7fe, 0xd79d, 0xc7bc,
+    0x48c4, 0x58e5, 0x6886, 0x78a7, 0x0840, 0x1861, 0x2802, 0x3823,
+    0xc9cc, 0xd9ed, 0xe98e, 0xf9af, 0x8948, 0x9969, 0xa90a, 0xb92b,
+    0x5af5, 0x4ad4, 0x7ab7, 0x6a96, 0x1a71, 0x0a50, 0x3a33, 0x2a12,
+    0xdbfd, 0xcbdc, 0xfbbf, 0xeb9e, 0x9b79, 0x8b58, 0xbb3b, 0xab1a,
+    0x6ca6, 0x7c87, 0x4ce4, 0x5cc5, 0x2c22, 0x3c03, 0x0c60, 0x1c41,
+    0xedae, 0xfd8f, 0xcdec, 0xddcd, 0xad2a, 0xbd0b, 0x8d68, 0x9d49,
+    0x7e97, 0x6eb6, 0x5ed5, 0x4ef4, 0x3e13, 0x2e32, 0x1e51, 0x0e70,
+    0xff9f, 0xefbe, 0xdfdd, 0xcffc, 0xbf1b, 0xaf3a, 0x9f59, 0x8f78,
+    0x9188, 0x81a9, 0xb1ca, 0xa1eb, 0xd10c, 0xc12d, 0xf14e, 0xe16f,
+    0x1080, 0x00a1, 0x30c2, 0x20e3, 0x5004, 0x4025, 0x7046, 0x6067,
+    0x83b9, 0x9398, 0xa3fb, 0xb3da, 0xc33d, 0xd31c, 0xe37f, 0xf35e,
+    0x02b1, 0x1290, 0x22f3, 0x32d2, 0x4235, 0x5214, 0x6277, 0x7256,
+    0xb5ea, 0xa5cb, 0x95a8, 0x8589, 0xf56e, 0xe54f, 0xd52c, 0xc50d,
+    0x34e2, 0x24c3, 0x14a0, 0x0481, 0x7466, 0x6447, 0x5424, 0x4405,
+    0xa7db, 0xb7fa, 0x8799, 0x97b8, 0xe75f, 0xf77e, 0xc71d, 0xd73c,
+    0x26d3, 0x36f2, 0x0691, 0x16b0, 0x6657, 0x7676, 0x4615, 0x5634,
+    0xd94c, 0xc96d, 0xf90e, 0xe92f, 0x99c8, 0x89e9, 0xb98a, 0xa9ab,
+    0x5844, 0x4865, 0x7806, 0x6827, 0x18c0, 0x08e1, 0x3882, 0x28a3,
+    0xcb7d, 0xdb5c, 0xeb3f, 0xfb1e, 0x8bf9, 0x9bd8, 0xabbb, 0xbb9a,
+    0x4a75, 0x5a54, 0x6a37, 0x7a16, 0x0af1, 0x1ad0, 0x2ab3, 0x3a92,
+    0xfd2e, 0xed0f, 0xdd6c, 0xcd4d, 0xbdaa, 0xad8b, 0x9de8, 0x8dc9,
+    0x7c26, 0x6c07, 0x5c64, 0x4c45, 0x3ca2, 0x2c83, 0x1ce0, 0x0cc1,
+    0xef1f, 0xff3e, 0xcf5d, 0xdf7c, 0xaf9b, 0xbfba, 0x8fd9, 0x9ff8,
+    0x6e17, 0x7e36, 0x4e55, 0x5e74, 0x2e93, 0x3eb2, 0x0ed1, 0x1ef0,
+};
+
+/* A key of the command, with the position of its reply in the result */
+typedef struct {
+    uint16_t slot;
+    uint32_t index;
+} fanout_key_t;
+
+/* State of a fanned out call, released by fanout_finish() */
+typedef struct {
+    arg_arena_t    arena;
+    fanout_key_t*  keys;        /* Sorted by slot */
+    uint32_t*      group_start; /* First key of each slot group, followed by the key count */
+    uint32_t       group_count;
+    CommandResult* result;
+} fanout_call_t;
+
+uint16_t valkey_glide_key_slot(const char* key, size_t key_len) {
+    const char* open = memchr(key, '{', key_len);
+    if (open) {
+        const char* close = memchr(open + 1, '}', key_len - (size_t)(open + 1 - key));
+        /* An empty tag doesn't count: the whole key is hashed */
+        if (close && close > open + 1) {
+            key     = open + 1;
+            key_len = (size_t)(close - key);
+        }
+    }
+
+    uint16_t crc = 0;
+    for (size_t i = 0; i < key_len; i++) {
+        crc = (uint16_t)(crc << 8) ^ crc16_table[((crc >> 8) ^ (unsigned char)key[i]) & 0xff];
+    }
+    return crc & CLUSTER_SLOT_MASK;
+}
+
+static int compare_fanout_keys(const void* a, const void* b) {
+    const fanout_key_t* key_a = a;
+    const fanout_key_t* key_b = b;
+    if (key_a->slot != key_b->slot) {
+        return key_a->slot < key_b->slot ? -1 : 1;
+    }
+    /* Keep the caller's order within a slot */
+    return key_a->index < key_b->index ? -1 : key_a->index > key_b->index;
+}
+
+/* Text of a key, as convert_to_string() gives it, without converting the caller's zval */
+static char* fanout_key_to_string(arg_arena_t* arena, zval* key, size_t* len) {
+    if (Z_TYPE_P(key) == IS_STRING) {
+        *len = Z_STRLEN_P(key);
+        return Z_STRVAL_P(key);
+    }
+    if (Z_TYPE_P(key) == IS_LONG) {
+        return arena_long_to_string(arena, Z_LVAL_P(key), len);
+    }
+
+    zend_string* str  = zval_get_string(key);
+    char*        copy = arena_strndup(arena, ZSTR_VAL(str), ZSTR_LEN(str));
+    *len              = ZSTR_LEN(str);
+    zend_string_release(str);
+    return copy;
+}
+
+/*
+ * Group the keys of ht by slot and send one cmd_type command per slot, in a non-atomic batch.
+ * The keys are the values of ht, or its keys when with_values is set (key => value pairs).
+ * Returns 1 if the batch returned one reply per group. fanout_finish() must be called either way
+ */
+static int fanout_send(valkey_glide_object* valkey_glide,
+                       enum RequestType     cmd_type,
+                       HashTable*           ht,
+                       bool                 with_values,
+                       fanout_call_t*       call) {
+    uint32_t count = zend_hash_num_elements(ht);
+    int      width = with_values ? 2 : 1;
+
+    arena_init(&call->arena);
+    call->group_count = 0;
+    call->result      = NULL;
+
+    /* Arguments in the caller's order */
+    uintptr_t*     args;
+    unsigned long* args_len;
+    if (!arena_alloc_args(&call->arena, (int)count * width, &args, &args_len)) {
+        return 0;
+    }
+    call->keys = arena_alloc(&call->arena, count * sizeof(fanout_key_t));
+
+    uint32_t     i = 0;
+    zend_string* key;
+    zend_ulong   num_key;
+    zval*        data;
+
+    ZEND_HASH_FOREACH_KEY_VAL(ht, num_key, key, data) {
+        size_t len;
+        char*  str;
+
+        ZVAL_DEREF(data);
+        if (!with_values) {
+            str = fanout_key_to_string(&call->arena, data, &len);
+        } else if (key) {
+            str = ZSTR_VAL(key);
+            len = ZSTR_LEN(key);
+        } else {
+            str = arena_long_to_string(&call->arena, (long)num_key, &len);
+        }
+        args[i * width]     = (uintptr_t)str;
+        args_len[i * width] = len;
+        call->keys[i].slot  = valkey_glide_key_slot(str, len);
+        call->keys[i].index = i;
+
+        if (with_values) {
+            str = valkey_glide_pack(valkey_glide->serializer, &call->arena, data, &len);
+            if (!str) {
+                return 0;
+            }
+            args[i * width + 1]     = (uintptr_t)str;
+            args_len[i * width + 1] = len;
+        }
+        i++;
+    }
+    ZEND_HASH_FOREACH_END();
+
+    qsort(call->keys, count, sizeof(fanout_key_t), compare_fanout_keys);
+
+    /* Lay the arguments out by slot, so that the arguments of a group are contiguous */
+    uintptr_t*     sorted_args = arena_alloc(&call->arena, count * width * sizeof(uintptr_t));
+    unsigned long* sorted_len  = arena_alloc(&call->arena, count * width * sizeof(unsigned long));
+    call->group_start          = arena_alloc(&call->arena, (count + 1) * sizeof(uint32_t));
+
+    for (i = 0; i < count; i++) {
+        uint32_t from = call->keys[i].index * width;
+        if (i == 0 || call->keys[i].slot != call->keys[i - 1].slot) {
+            call->group_start[call->group_count++] = i;
+        }
+        for (int j = 0; j < width; j++) {
+            sorted_args[i * width + j] = args[from + j];
+            sorted_len[i * width + j]  = args_len[from + j];
+        }
+    }
+    call->group_start[call->group_count] = count;
+
+    struct CmdInfo*  cmds      = arena_alloc(&call->arena, call->group_count * sizeof(*cmds));
+    struct CmdInfo** cmd_infos = arena_alloc(&call->arena, call->group_count * sizeof(*cmd_infos));
+    for (uint32_t g = 0; g < call->group_count; g++) {
+        uint32_t first = call->group_start[g] * width;
+
+        cmds[g].request_type = cmd_type;
+        cmds[g].args         = (const uint8_t* const*)(sorted_args + first);
+        cmds[g].arg_count    = (call->group_start[g + 1] - call->group_start[g]) * width;
+        cmds[g].args_len     = (const uintptr_t*)(sorted_len + first);
+        cmd_infos[g]         = &cmds[g];
+    }
+
+    /* The core sends the commands of each node together, and the nodes concurrently */
+    struct BatchInfo batch_info = {.cmd_count = call->group_count,
+                                   .cmds      = (const struct CmdInfo* const*)cmd_infos,
+                                   .is_atomic = false};
+
+    uint64_t span_ptr = valkey_glide_otel_start_batch_span();
+    call->result     = batch(valkey_glide->glide_client,
+                             0, /* callback_index (not used for sync) */
+                             &batch_info,
+                             false, /* raise_on_error: failed groups are reported one by one */
+                             NULL,
+                             span_ptr);
+    valkey_glide_otel_end_span(span_ptr);
+    for (uint32_t g = 0; g < call->group_count; g++) {
+        valkey_glide_near_cache_note_command(valkey_glide->glide_client,
+                                             cmd_type,
+                                             cmds[g].arg_count,
+                                             (const uintptr_t*)cmds[g].args,
+                                             (const unsigned long*)cmds[g].args_len);
+    }
+
+    return call->result && !call->result->command_error && call->result->response &&
+           call->result->response->response_type == Array &&
+           call->result->response->array_value_len == (long)call->group_count;
+}
+
+/*
+ * Reply to the command of group g, or NULL if it failed or didn't reply with the expected
+ * type. With partial results, the failure is reported as a warning
+ */
+static CommandResponse* fanout_group_reply(fanout_call_t*    call,
+                                           uint32_t          g,
+                                           const char*       name,
+                                           enum ResponseType expected,
+                                           bool              partial_results) {
+    CommandResponse* reply = &call->result->response->array_value[g];
+    if (reply->response_type == expected) {
+        return reply;
+    }
+
+    if (partial_results) {
+        unsigned int key_count = call->group_start[g + 1] - call->group_start[g];
+        unsigned int slot      = call->keys[call->group_start[g]].slot;
+        if (reply->response_type == Error && reply->string_value) {
+            php_error_docref(NULL,
+                             E_WARNING,
+                             "%s failed for %u key(s) in slot %u: %.*s",
+                             name,
+                             key_count,
+                             slot,
+                             (int)reply->string_value_len,
+                             reply->string_value);
+        } else {
+            php_error_docref(
+                NULL, E_WARNING, "%s failed for %u key(s) in slot %u", name, key_count, slot);
+        }
+    }
+    return NULL;
+}
+
+static void fanout_finish(fanout_call_t* call) {
+    if (call->result) {
+        free_command_result(call->result);
+    }
+    arena_free(&call->arena);
+}
+
+int execute_cluster_mget(valkey_glide_object* valkey_glide, HashTable* keys, zval* return_value) {
+    fanout_call_t call;
+    uint32_t      failed = 0;
+
+    if (!fanout_send(valkey_glide, MGet, keys, false, &call)) {
+        fanout_finish(&call);
+        return 0;
+    }
+
+    /* Pre-size the result; the keys of failed groups stay false */
+    uint32_t count = zend_hash_num_elements(keys);
+    zval     value;
+
+    array_init_size(return_value, count);
+    zend_hash_real_init_packed(Z_ARRVAL_P(return_value));
+    ZVAL_FALSE(&value);
+    ZEND_HASH_FILL_PACKED(Z_ARRVAL_P(return_value)) {
+        for (uint32_t i = 0; i < count; i++) {
+            ZEND_HASH_FILL_ADD(&value);
+        }
+    }
+    ZEND_HASH_FILL_END();
+
+    for (uint32_t g = 0; g < call.group_count; g++) {
+        uint32_t         first = call.group_start[g];
+        uint32_t         size  = call.group_start[g + 1] - first;
+        CommandResponse* reply =
+            fanout_group_reply(&call, g, "MGET", Array, valkey_glide->partial_results);
+
+        if (!reply || reply->array_value_len != (long)size) {
+            failed++;
+            if (!valkey_glide->partial_results) {
+                break;
+            }
+            continue;
+        }
+
+        /* Scatter the values back to the positions of their keys */
+        for (uint32_t j = 0; j < size; j++) {
+            zval* slot_value =
+                zend_hash_index_find(Z_ARRVAL_P(return_value), call.keys[first + j].index);
+            command_response_to_unpacked_zval(&reply->array_value[j],
+                                              slot_value,
+                                              COMMAND_RESPONSE_NOT_ASSOSIATIVE,
+                                              true,
+                                              valkey_glide->serializer);
+        }
+    }
+
+    fanout_finish(&call);
+    return !failed || valkey_glide->partial_results;
+}
+
+int execute_cluster_mset(valkey_glide_object* valkey_glide, HashTable* key_values) {
+    fanout_call_t call;
+    uint32_t      failed = 0;
+
+    if (!fanout_send(valkey_glide, MSet, key_values, true, &call)) {
+        fanout_finish(&call);
+        return 0;
+    }
+
+    for (uint32_t g = 0; g < call.group_count; g++) {
+        if (!fanout_group_reply(&call, g, "MSET", Ok, valkey_glide->partial_results)) {
+            failed++;
+            if (!valkey_glide->partial_results) {
+                break;
+            }
+        }
+    }
+
+    fanout_finish(&call);
+    /* MSET only succeeds if every slot was written */
+    return !failed;
+}
+
+int execute_cluster_del(valkey_glide_object* valkey_glide,
+                        enum RequestType     cmd_type,
+                        HashTable*           keys,
+                        long*                output_value) {
+    fanout_call_t call;
+    uint32_t      failed  = 0;
+    long          removed = 0;
+    const char*   name    = cmd_type == Unlink ? "UNLINK" : "DEL";
+
+    if (!fanout_send(valkey_glide, cmd_type, keys, false, &call)) {
+        fanout_finish(&call);
+        return 0;
+    }
+
+    for (uint32_t g = 0; g < call.group_count; g++) {
+        CommandResponse* reply =
+            fanout_group_reply(&call, g, name, Int, valkey_glide->partial_results);
+        if (reply) {
+            removed += reply->int_value;
+            continue;
+        }
+        failed++;
+        if (!valkey_glide->partial_results) {
+            break;
+        }
+    }
+
+    fanout_finish(&call);
+    if (failed && !valkey_glide->partial_results) {
+        return 0;
+    }
+    *output_value = removed;
+    return 1;
+}
@@ -0,0 +1,50 @@
+/*
+  +----------------------------------------------------------------------+
+  | Copyright (c) 2023-2025 The PHP Group                                |
+  +----------------------------------------------------------------------+
+  | This source file is subject to version 3.01 of the PHP license,      |
+  | that is bundled with this package in the file LICENSE, and is        |
+  | available through the world-wide-web at the following url:           |
+  | http://www.php.net/license/3_01.txt                                  |
+  | If you did not receive a copy of the PHP license and are unable to   |
+  | obtain it through the world-wide-web, please send a note to          |
+  | license@php.net so we can mail you a copy immediately.               |
+  +----------------------------------------------------------------------+
+*/
+
+#ifndef VALKEY_GLIDE_CLUSTER_FANOUT_H
+#define VALKEY_GLIDE_CLUSTER_FANOUT_H
+
+#include <stdint.h>
+
+#include "common.h"
+#include "include/glide_bindings.h"
+
+/*
+ * Multi-key commands of ValkeyGlideCluster, split by hash slot on this side.
+ *
+ * The keys are grouped by slot once, and each group becomes one command of a non-atomic batch,
+ * which the core sends to the nodes owning the slots concurrently. Replies are written straight
+ * to their position in the result.
+ *
+ * When a group fails, the whole call fails, unless the client was created with the
+ * 'partial_results' advanced option: a warning then names the failed slot, MGET returns false
+ * for its keys and DEL/UNLINK count the keys removed from the other slots.
+ */
+
+/* Hash slot of a key: CRC16 of the key, or of its {hash tag} if it has one */
+uint16_t valkey_glide_key_slot(const char* key, size_t key_len);
+
+/* MGET: sets return_value to the values of the keys, in order. Returns 1 on success */
+int execute_cluster_mget(valkey_glide_object* valkey_glide, HashTable* keys, zval* return_value);
+
+/* MSET of key => value pairs. Returns 1 on success */
+int execute_cluster_mset(valkey_glide_object* valkey_glide, HashTable* key_values);
+
+/* DEL or UNLINK: sets output_value to the number of keys removed. Returns 1 on success */
+int execute_cluster_del(valkey_glide_object* valkey_glide,
+                        enum RequestType     cmd_type,
+                        HashTable*           keys,
+                        long*                output_value);
+
+#endif /* VALKEY_GLIDE_CLUSTER_FANOUT_H */
@@ -19,6 +19,7 @@
 
 #include "command_response.h"
 #include "include/glide_bindings.h"
+#include "valkey_glide_cluster_fanout.h"
 #include "valkey_glide_commands_common.h"
 #include "valkey_glide_core_common.h"
 
@@ -35,11 +36,17 @@ int execute_mset_command(zval* object, int argc, zval* return_value, zend_class_
     /* Get ValkeyGlide object */
     valkey_glide = VALKEY_GLIDE_PHP_ZVAL_GET_OBJECT(valkey_glide_object, object);
 
+    /* Cluster: split the pairs by slot here and write the slots concurrently */
+    if (valkey_glide->glide_client && ce == get_valkey_glide_cluster_ce()) {
+        return execute_cluster_mset(valkey_glide, Z_ARRVAL_P(z_arr));
+    }
+
     /* If we have a Glide client, use it */
     if (valkey_glide->glide_client) {
         core_command_args_t args = {0};
         args.glide_client        = valkey_glide->glide_client;
         args.cmd_type            = MSet;
+        args.serializer          = valkey_glide->serializer;
 
         /* Set up array argument for key-value pairs */
         args.args[0].type                 = CORE_ARG_TYPE_ARRAY;
@@ -74,6 +81,7 @@ int execute_msetnx_command(zval* object, int argc, zval* return_value, zend_clas
         core_command_args_t args = {0};
         args.glide_client        = valkey_glide->glide_client;
         args.cmd_type            = MSetNX;
+        args.serializer          = valkey_glide->serializer;
 
         /* Set up array argument for key-value pairs */
         args.args[0].type                 = CORE_ARG_TYPE_ARRAY;
@@ -16,8 +16,10 @@
 
 #include "command_response.h" /* Include command_response.h for string conversion functions */
 #include "php.h"
+#include "valkey_glide_cluster_fanout.h"
 #include "valkey_glide_commands_common.h"
 #include "valkey_glide_core_common.h"
+#include "valkey_glide_serializer.h"
 
 #if PHP_VERSION_ID < 80400
 #include <ext/standard/php_random.h>
@@ -204,7 +206,7 @@ int execute_getdel_command(zval* object, int argc, zval* return_value, zend_clas
     /* Process the result */
     if (result == 1 && response != NULL) {
         /* Return the value */
-        ZVAL_STRINGL(return_value, response, response_len);
+        valkey_glide_unpack(valkey_glide->serializer, response, response_len, return_value);
         efree(response);
         return 1;
     } else if (result == 0) {
@@ -262,7 +264,7 @@ int execute_getex_command(zval* object, int argc, zval* return_value, zend_class
     /* Process the result */
     if (result == 1 && response != NULL) {
         /* Return the value */
-        ZVAL_STRINGL(return_value, response, response_len);
+        valkey_glide_unpack(valkey_glide->serializer, response, response_len, return_value);
         efree(response);
         return 1;
     } else if (result == 0) {
@@ -552,6 +554,11 @@ int execute_mget_command(zval* object, int argc, zval* return_value, zend_class_
         return 0;
     }
 
+    /* Cluster: split the keys by slot here and read the slots concurrently */
+    if (ce == get_valkey_glide_cluster_ce()) {
+        return execute_cluster_mget(valkey_glide, Z_ARRVAL_P(z_array), return_value);
+    }
+
     /* Execute the MGET command using the Glide client */
     array_init(return_value);
 
@@ -565,7 +572,8 @@ int execute_mget_command(zval* object, int argc, zval* return_value, zend_class_
     args.args[0].data.array_arg.count = zend_hash_num_elements(Z_ARRVAL_P(z_array));
     args.arg_count                    = 1;
 
-    if (execute_core_command(&args, return_value, process_core_array_result)) {
+    core_unpack_output_t output = {return_value, valkey_glide->serializer};
+    if (execute_core_command(&args, &output, process_core_unpacked_array_result)) {
         /* Command succeeded, return_value is already set */
         return 1;
     } else {
@@ -709,7 +717,12 @@ int execute_unlink_command(zval* object, int argc, zval* return_value, zend_clas
     /* Check if we have a single array argument */
     if (argc == 1 && Z_TYPE(z_args[0]) == IS_ARRAY) {
         /* Use array elements as keys */
-        if (execute_unlink_array(valkey_glide->glide_client, Z_ARRVAL(z_args[0]), &result_value)) {
+        int status =
+            ce == get_valkey_glide_cluster_ce()
+                ? execute_cluster_del(valkey_glide, Unlink, Z_ARRVAL(z_args[0]), &result_value)
+                : execute_unlink_array(
+                      valkey_glide->glide_client, Z_ARRVAL(z_args[0]), &result_value);
+        if (status) {
             ZVAL_LONG(return_value, result_value);
             return 1;
         }
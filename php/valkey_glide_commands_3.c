@@ -21,6 +21,9 @@
 #include "include/glide_bindings.h"
 #include "valkey_glide_commands_common.h"
 #include "valkey_glide_core_common.h"
+#include "valkey_glide_near_cache.h"
+#include "valkey_glide_otel.h"
+#include "valkey_glide_serializer.h"
 
 /* Helper functions for batch state management */
 static void clear_batch_state(valkey_glide_object* valkey_glide);
@@ -562,13 +565,23 @@ int execute_exec_command(zval* object, int argc, zval* return_value, zend_class_
         .is_atomic = (valkey_glide->batch_type == MULTI || valkey_glide->batch_type == ATOMIC)};
 
     /* Execute via FFI batch() function */
-    struct CommandResult* result = batch(valkey_glide->glide_client,
-                                         0, /* callback_index (not used for sync) */
-                                         &batch_info,
-                                         false, /* raise_on_error */
-                                         NULL,  /* options */
-                                         0      /* span_ptr */
+    uint64_t              span_ptr = valkey_glide_otel_start_batch_span();
+    struct CommandResult* result   = batch(valkey_glide->glide_client,
+                                           0, /* callback_index (not used for sync) */
+                                           &batch_info,
+                                           false,   /* raise_on_error */
+                                           NULL,    /* options */
+                                           span_ptr /* span_ptr */
     );
+    valkey_glide_otel_end_span(span_ptr);
+    for (i = 0; i < valkey_glide->command_count; i++) {
+        struct batch_command* buffered = &valkey_glide->buffered_commands[i];
+        valkey_glide_near_cache_note_command(valkey_glide->glide_client,
+                                             buffered->request_type,
+                                             buffered->arg_count,
+                                             (const uintptr_t*)buffered->args,
+                                             (const unsigned long*)buffered->arg_lengths);
+    }
 
     /* Free CmdInfo structures */
     for (i = 0; i < valkey_glide->command_count; i++) {
@@ -1349,6 +1362,50 @@ int execute_getreadtimeout_command(zval*             object,
     return 0;
 }
 
+/* setOption(): client side only, nothing is sent to the server */
+int execute_setoption_command(zval* object, int argc, zval* return_value, zend_class_entry* ce) {
+    valkey_glide_object* valkey_glide;
+    zend_long            option;
+    zval*                value;
+
+    /* Parse parameters */
+    if (zend_parse_method_parameters(argc, object, "Olz", &object, ce, &option, &value) ==
+        FAILURE) {
+        return 0;
+    }
+
+    /* Get ValkeyGlide object */
+    valkey_glide = VALKEY_GLIDE_PHP_ZVAL_GET_OBJECT(valkey_glide_object, object);
+    if (!valkey_glide) {
+        return 0;
+    }
+
+    if (!valkey_glide_serializer_set_option(&valkey_glide->serializer, option, value)) {
+        return 0;
+    }
+    ZVAL_TRUE(return_value);
+    return 1;
+}
+
+/* getOption(): the value given to setOption(), or the default */
+int execute_getoption_command(zval* object, int argc, zval* return_value, zend_class_entry* ce) {
+    valkey_glide_object* valkey_glide;
+    zend_long            option;
+
+    /* Parse parameters */
+    if (zend_parse_method_parameters(argc, object, "Ol", &object, ce, &option) == FAILURE) {
+        return 0;
+    }
+
+    /* Get ValkeyGlide object */
+    valkey_glide = VALKEY_GLIDE_PHP_ZVAL_GET_OBJECT(valkey_glide_object, object);
+    if (!valkey_glide) {
+        return 0;
+    }
+
+    return valkey_glide_serializer_get_option(valkey_glide->serializer, option, return_value);
+}
+
 /* Execute getPersistentID command using the Valkey Glide client */
 int execute_get_persistent_id_command(const void* glide_client, char** result, size_t* result_len) {
     /* Check if client is valid */
@@ -59,6 +59,20 @@ void free_command_result(CommandResult* command_result_ptr);
 
 /* Helper functions for Valkey Glide integration */
 const void* create_glide_client(valkey_glide_client_configuration_t* config, bool is_cluster);
+const void* create_glide_tracking_client(
+    valkey_glide_client_configuration_t*           config,
+    bool                                           is_cluster,
+    const valkey_glide_near_cache_configuration_t* tracking,
+    PubSubCallback                                 invalidation_callback);
+uint8_t*    create_glide_connection_request(valkey_glide_client_configuration_t* config,
+                                            bool                                 is_cluster,
+                                            size_t*                              len);
+const void* create_glide_subscriber_client(
+    const uint8_t*                          request,
+    size_t                                  request_len,
+    ConnectionRequest__PubSubSubscriptions* subscriptions,
+    PubSubCallback                          message_callback,
+    uintptr_t                               push_context);
 
 /* Bit operations - UNIFIED SIGNATURES */
 int execute_bitcount_command(zval* object, int argc, zval* return_value, zend_class_entry* ce);
@@ -66,15 +80,15 @@ int execute_bitop_command(zval* object, int argc, zval* return_value, zend_class
 int execute_bitpos_command(zval* object, int argc, zval* return_value, zend_class_entry* ce);
 
 /* String operations */
-int execute_set_command_internal(const void* glide_client,
-                                 const char* key,
-                                 size_t      key_len,
-                                 const char* val,
-                                 size_t      val_len,
-                                 long        expire,
-                                 zval*       opts,
-                                 char**      old_val,
-                                 size_t*     old_val_len);
+int execute_set_command_internal(const void*                      glide_client,
+                                 const valkey_glide_serializer_t* serializer,
+                                 const char*                      key,
+                                 size_t                           key_len,
+                                 zval*                            value,
+                                 long                             expire,
+                                 zval*                            opts,
+                                 char**                           old_val,
+                                 size_t*                          old_val_len);
 int execute_set_command(zval* object, int argc, zval* return_value, zend_class_entry* ce);
 int execute_setex_command(zval* object, int argc, zval* return_value, zend_class_entry* ce);
 int execute_psetex_command(zval* object, int argc, zval* return_value, zend_class_entry* ce);
@@ -158,6 +172,8 @@ int execute_getreadtimeout_command(zval*             object,
                                    int               argc,
                                    zval*             return_value,
                                    zend_class_entry* ce);
+int execute_setoption_command(zval* object, int argc, zval* return_value, zend_class_entry* ce);
+int execute_getoption_command(zval* object, int argc, zval* return_value, zend_class_entry* ce);
 int execute_client_command(zval* object, int argc, zval* return_value, zend_class_entry* ce);
 int execute_rawcommand_command(zval* object, int argc, zval* return_value, zend_class_entry* ce);
 int execute_dbsize_command(zval* object, int argc, zval* return_value, zend_class_entry* ce);
@@ -784,6 +800,34 @@ int buffer_current_command_generic(valkey_glide_object* valkey_glide,
         RETURN_FALSE;                                                                     \
     }
 
+#define SETOPTION_METHOD_IMPL(class_name)                                            \
+    PHP_METHOD(class_name, setOption) {                                              \
+        if (execute_setoption_command(getThis(),                                     \
+                                      ZEND_NUM_ARGS(),                               \
+                                      return_value,                                  \
+                                      strcmp(#class_name, "ValkeyGlideCluster") == 0 \
+                                          ? get_valkey_glide_cluster_ce()            \
+                                          : get_valkey_glide_ce())) {                \
+            return;                                                                  \
+        }                                                                            \
+        zval_dtor(return_value);                                                     \
+        RETURN_FALSE;                                                                \
+    }
+
+#define GETOPTION_METHOD_IMPL(class_name)                                            \
+    PHP_METHOD(class_name, getOption) {                                              \
+        if (execute_getoption_command(getThis(),                                     \
+                                      ZEND_NUM_ARGS(),                               \
+                                      return_value,                                  \
+                                      strcmp(#class_name, "ValkeyGlideCluster") == 0 \
+                                          ? get_valkey_glide_cluster_ce()            \
+                                          : get_valkey_glide_ce())) {                \
+            return;                                                                  \
+        }                                                                            \
+        zval_dtor(return_value);                                                     \
+        RETURN_FALSE;                                                                \
+    }
+
 #define CLIENT_METHOD_IMPL(class_name)                                            \
     PHP_METHOD(class_name, client) {                                              \
         if (execute_client_command(getThis(),                                     \
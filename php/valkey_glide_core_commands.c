@@ -26,25 +26,27 @@
 
 #include "command_response.h"
 #include "include/glide_bindings.h"
+#include "valkey_glide_cluster_fanout.h"
 #include "valkey_glide_commands_common.h"
 #include "valkey_glide_core_common.h"
 #include "valkey_glide_list_common.h"
+#include "valkey_glide_near_cache.h"
+#include "valkey_glide_otel.h"
+#include "valkey_glide_serializer.h"
 
 extern zend_class_entry* ce;
 extern zend_class_entry* get_valkey_glide_exception_ce();
 
-/* Import the string conversion functions from command_response.c */
-extern char* long_to_string(long value, size_t* len);
-extern char* double_to_string(double value, size_t* len);
-
 /* Create a connection request in protobuf format */
-static uint8_t* create_connection_request(const char*                          host,
-                                          int                                  port,
-                                          const char*                          user,
-                                          const char*                          pass,
-                                          size_t*                              len,
-                                          valkey_glide_client_configuration_t* config,
-                                          bool                                 is_cluster) {
+static uint8_t* create_connection_request(
+    const char*                                    host,
+    int                                            port,
+    const char*                                    user,
+    const char*                                    pass,
+    size_t*                                        len,
+    valkey_glide_client_configuration_t*           config,
+    bool                                           is_cluster,
+    const valkey_glide_near_cache_configuration_t* tracking) {
     /* Create a connection request */
     ConnectionRequest__ConnectionRequest conn_req = CONNECTION_REQUEST__CONNECTION_REQUEST__INIT;
 
@@ -80,6 +82,8 @@ static uint8_t* create_connection_request(const char*                          h
         conn_req.read_from = CONNECTION_REQUEST__READ_FROM__AZAffinity;
     } else if (config->base.read_from == VALKEY_GLIDE_READ_FROM_AZ_AFFINITY_REPLICAS_AND_PRIMARY) {
         conn_req.read_from = CONNECTION_REQUEST__READ_FROM__AZAffinityReplicasAndPrimary;
+    } else if (config->base.read_from == VALKEY_GLIDE_READ_FROM_LOWEST_LATENCY) {
+        conn_req.read_from = CONNECTION_REQUEST__READ_FROM__LowestLatency;
     } else {
         conn_req.read_from = CONNECTION_REQUEST__READ_FROM__Primary;
     }
@@ -96,6 +100,37 @@ static uint8_t* create_connection_request(const char*                          h
     /* Set client name */
     conn_req.client_name = config->base.client_name ? config->base.client_name : "valkey-glide-php";
 
+    /* Stripe requests across several connections per node; a tracking client needs only one */
+    if (!tracking && config->base.advanced_config &&
+        config->base.advanced_config->connections_per_node > 1) {
+        conn_req.connections_per_node = config->base.advanced_config->connections_per_node;
+    }
+
+    /* Send blocking commands over dedicated connections, so they don't stall the shared ones */
+    if (!tracking && config->base.advanced_config &&
+        config->base.advanced_config->blocking_connections_limit > 0) {
+        conn_req.blocking_connections_limit =
+            config->base.advanced_config->blocking_connections_limit;
+    }
+
+    /* Enable broadcast client tracking for the connection feeding a near cache */
+    ConnectionRequest__ClientTrackingBroadcast broadcast =
+        CONNECTION_REQUEST__CLIENT_TRACKING_BROADCAST__INIT;
+    ProtobufCBinaryData* prefixes = NULL;
+    if (tracking) {
+        if (tracking->prefix_count > 0) {
+            prefixes = ecalloc(tracking->prefix_count, sizeof(ProtobufCBinaryData));
+            for (int i = 0; i < tracking->prefix_count; i++) {
+                prefixes[i].data = (uint8_t*)tracking->prefixes[i];
+                prefixes[i].len  = tracking->prefix_lens[i];
+            }
+        }
+        broadcast.n_prefixes               = tracking->prefix_count;
+        broadcast.prefixes                 = prefixes;
+        conn_req.client_tracking_broadcast = &broadcast;
+        conn_req.client_name               = "valkey-glide-php-tracking";
+    }
+
     /* Calculate the size of the serialized message */
     *len = connection_request__connection_request__get_packed_size(&conn_req);
 
@@ -103,19 +138,27 @@ static uint8_t* create_connection_request(const char*                          h
     uint8_t* buffer = (uint8_t*)emalloc(*len);
     if (!buffer) {
         *len = 0;
+        if (prefixes) {
+            efree(prefixes);
+        }
         return NULL;
     }
 
     /* Serialize the message */
     connection_request__connection_request__pack(&conn_req, buffer);
 
+    if (prefixes) {
+        efree(prefixes);
+    }
     return buffer;
 }
 
-/* Create a Valkey Glide client */
-const void* create_glide_client(valkey_glide_client_configuration_t* config, bool is_cluster) {
-    /* Create a connection request using first address or default */
-    size_t      len;
+/* Serialize the connection request of a client configuration, using its first address */
+static uint8_t* build_connection_request(
+    valkey_glide_client_configuration_t*           config,
+    bool                                           is_cluster,
+    const valkey_glide_near_cache_configuration_t* tracking,
+    size_t*                                        len) {
     const char* host     = "localhost";
     int         port     = 6379;
     const char* username = NULL;
@@ -133,21 +176,24 @@ const void* create_glide_client(valkey_glide_client_configuration_t* config, boo
         password = config->base.credentials->password;
     }
 
-    uint8_t* request_bytes =
-        create_connection_request(host, port, username, password, &len, config, is_cluster);
-
-    if (!request_bytes) {
-        return NULL;
-    }
+    return create_connection_request(
+        host, port, username, password, len, config, is_cluster, tracking);
+}
 
+/* Create a client from a serialized connection request, which is freed */
+static const void* open_glide_client(uint8_t*       request_bytes,
+                                     size_t         len,
+                                     PubSubCallback push_callback,
+                                     uintptr_t      push_context) {
     /* Set up client type for synchronous operation */
     ClientType client_type;
     client_type.tag = SyncClient;
 
-    /* Create the client */
+    /* Create the client. Push callbacks are given push_context if set, else the client pointer */
     const ConnectionResponse* conn_resp =
-        create_client(request_bytes, len, &client_type, NULL /* No PubSub callback */
-        );
+        push_context ? create_client_with_push_context(
+                           request_bytes, len, &client_type, push_callback, push_context)
+                     : create_client(request_bytes, len, &client_type, push_callback);
 
     /* Free the request bytes as they're no longer needed */
     efree(request_bytes);
@@ -168,6 +214,78 @@ const void* create_glide_client(valkey_glide_client_configuration_t* config, boo
     return client;
 }
 
+/* Connect a client, forwarding push notifications to push_callback when it is not NULL */
+static const void* connect_glide_client(
+    valkey_glide_client_configuration_t*           config,
+    bool                                           is_cluster,
+    const valkey_glide_near_cache_configuration_t* tracking,
+    PubSubCallback                                 push_callback) {
+    /* OpenTelemetry is process-wide; a failure only disables tracing */
+    if (config->base.advanced_config) {
+        valkey_glide_otel_init(config->base.advanced_config->otel_config);
+    }
+
+    size_t   len;
+    uint8_t* request_bytes = build_connection_request(config, is_cluster, tracking, &len);
+    if (!request_bytes) {
+        return NULL;
+    }
+    return open_glide_client(request_bytes, len, push_callback, 0);
+}
+
+/* Create a Valkey Glide client */
+const void* create_glide_client(valkey_glide_client_configuration_t* config, bool is_cluster) {
+    return connect_glide_client(config, is_cluster, NULL, NULL /* No PubSub callback */);
+}
+
+/* Create a client receiving the invalidations of every key matching the near cache prefixes */
+const void* create_glide_tracking_client(
+    valkey_glide_client_configuration_t*           config,
+    bool                                           is_cluster,
+    const valkey_glide_near_cache_configuration_t* tracking,
+    PubSubCallback                                 invalidation_callback) {
+    return connect_glide_client(config, is_cluster, tracking, invalidation_callback);
+}
+
+/* Serialize the connection request of a client, to connect its subscriber clients later */
+uint8_t* create_glide_connection_request(valkey_glide_client_configuration_t* config,
+                                         bool                                 is_cluster,
+                                         size_t*                              len) {
+    return build_connection_request(config, is_cluster, NULL, len);
+}
+
+/* Create a client subscribed to subscriptions, from a connection request serialized by
+ * create_glide_connection_request() */
+const void* create_glide_subscriber_client(
+    const uint8_t*                          request,
+    size_t                                  request_len,
+    ConnectionRequest__PubSubSubscriptions* subscriptions,
+    PubSubCallback                          message_callback,
+    uintptr_t                               push_context) {
+    ConnectionRequest__ConnectionRequest* conn_req =
+        connection_request__connection_request__unpack(NULL, request_len, request);
+    if (!conn_req) {
+        return NULL;
+    }
+
+    /* One connection receives every message. The strings set here are not owned by conn_req */
+    char* client_name                    = conn_req->client_name;
+    conn_req->client_name                = "valkey-glide-php-subscriber";
+    conn_req->connections_per_node       = 0;
+    conn_req->blocking_connections_limit = 0;
+    conn_req->pubsub_subscriptions       = subscriptions;
+
+    size_t   len           = connection_request__connection_request__get_packed_size(conn_req);
+    uint8_t* request_bytes = (uint8_t*)emalloc(len);
+    connection_request__connection_request__pack(conn_req, request_bytes);
+
+    conn_req->client_name          = client_name;
+    conn_req->pubsub_subscriptions = NULL;
+    connection_request__connection_request__free_unpacked(conn_req, NULL);
+
+    return open_glide_client(request_bytes, len, message_callback, push_context);
+}
+
 /* Custom result processor for SET commands with GET option support */
 struct set_result_data {
     char**  old_val;
@@ -395,12 +513,11 @@ int execute_bitpos_command(zval* object, int argc, zval* return_value, zend_clas
 int execute_set_command(zval* object, int argc, zval* return_value, zend_class_entry* ce) {
     valkey_glide_object* valkey_glide;
     zval *               z_value, *z_expire = NULL, *z_opts = NULL;
-    char *               key = NULL, *val = NULL;
-    size_t               key_len, val_len;
+    char*                key = NULL;
+    size_t               key_len;
     double               expire     = 0;
     zend_long            expire_int = 0;
     zval*  z_set_opts  = NULL; /* Will hold our options either from z_expire or z_opts */
-    int    free_val    = 0;    /* Flag to track if we need to free val */
     char*  old_val     = NULL; /* For storing GET response */
     size_t old_val_len = 0;
 
@@ -448,67 +565,22 @@ int execute_set_command(zval* object, int argc, zval* return_value, zend_class_e
         z_set_opts = z_opts;
     }
 
-    /* Convert value based on its type */
-    switch (Z_TYPE_P(z_value)) {
-        case IS_STRING:
-            /* It's already a string, use directly */
-            val     = Z_STRVAL_P(z_value);
-            val_len = Z_STRLEN_P(z_value);
-            break;
-        case IS_LONG:
-            /* Convert integer to string */
-            val      = long_to_string(Z_LVAL_P(z_value), &val_len);
-            free_val = 1;  // We'll need to free this
-            break;
-        case IS_DOUBLE:
-            /* Convert float to string */
-            val      = double_to_string(Z_DVAL_P(z_value), &val_len);
-            free_val = 1;  // We'll need to free this
-            break;
-        case IS_TRUE:
-            /* Convert boolean TRUE to "1" */
-            val      = estrdup("1");
-            val_len  = 1;
-            free_val = 1;
-            break;
-        case IS_FALSE:
-            /* Convert boolean FALSE to "0" */
-            val      = estrdup("0");
-            val_len  = 1;
-            free_val = 1;
-            break;
-        case IS_NULL:
-            /* Convert NULL to empty string */
-            val      = estrdup("");
-            val_len  = 0;
-            free_val = 1;
-            break;
-        default:
-            /* Unsupported type */
-            return 0;
-    }
-
-    /* Check if conversion succeeded */
-    if (!val) {
+    /* Without a serializer, only scalars can be stored */
+    if (!valkey_glide->serializer && Z_TYPE_P(z_value) > IS_STRING) {
         return 0;
     }
 
     /* Execute the SET command using the internal helper function */
     int result = execute_set_command_internal(valkey_glide->glide_client,
+                                              valkey_glide->serializer,
                                               key,
                                               key_len,
-                                              val,
-                                              val_len,
+                                              z_value,
                                               expire_int,
                                               z_set_opts,
                                               &old_val,
                                               &old_val_len);
 
-    /* Free the allocated string if needed */
-    if (free_val) {
-        efree(val);
-    }
-
     /* Process the result */
     switch (result) {
         case 1: /* Success */
@@ -521,7 +593,7 @@ int execute_set_command(zval* object, int argc, zval* return_value, zend_class_e
             /* If GET option was used and old value was returned */
             if (old_val != NULL) {
                 /* Return the old value */
-                ZVAL_STRINGL(return_value, old_val, old_val_len);
+                valkey_glide_unpack(valkey_glide->serializer, old_val, old_val_len, return_value);
                 efree(old_val); /* Free the allocated old value */
                 return 1;
             }
@@ -536,27 +608,27 @@ int execute_set_command(zval* object, int argc, zval* return_value, zend_class_e
 }
 
 /* Execute a SET command using the Valkey Glide client - INTERNAL HELPER FUNCTION */
-int execute_set_command_internal(const void* glide_client,
-                                 const char* key,
-                                 size_t      key_len,
-                                 const char* val,
-                                 size_t      val_len,
-                                 long        expire,
-                                 zval*       opts,
-                                 char**      old_val,
-                                 size_t*     old_val_len) {
+int execute_set_command_internal(const void*                      glide_client,
+                                 const valkey_glide_serializer_t* serializer,
+                                 const char*                      key,
+                                 size_t                           key_len,
+                                 zval*                            value,
+                                 long                             expire,
+                                 zval*                            opts,
+                                 char**                           old_val,
+                                 size_t*                          old_val_len) {
     core_command_args_t args = {0};
     args.glide_client        = glide_client;
+    args.serializer          = serializer;
     args.cmd_type            = Set;
     args.key                 = key;
     args.key_len             = key_len;
     args.raw_options         = opts;
 
     /* Add value argument */
-    args.args[0].type                  = CORE_ARG_TYPE_STRING;
-    args.args[0].data.string_arg.value = val;
-    args.args[0].data.string_arg.len   = val_len;
-    args.arg_count                     = 1;
+    args.args[0].type                 = CORE_ARG_TYPE_VALUE;
+    args.args[0].data.value_arg.value = value;
+    args.arg_count                    = 1;
 
     /* Parse options */
     if (opts) {
@@ -581,14 +653,14 @@ int execute_set_command_internal(const void* glide_client,
 /* Execute a SETEX command using the Valkey Glide client - UNIFIED IMPLEMENTATION */
 int execute_setex_command(zval* object, int argc, zval* return_value, zend_class_entry* ce) {
     valkey_glide_object* valkey_glide;
-    char *               key = NULL, *val = NULL;
-    size_t               key_len, val_len;
+    char*                key = NULL;
+    size_t               key_len;
+    zval*                z_value;
     zend_long            expire;
 
     /* Parse parameters */
     if (zend_parse_method_parameters(
-            argc, object, "Osls", &object, ce, &key, &key_len, &expire, &val, &val_len) ==
-        FAILURE) {
+            argc, object, "Oslz", &object, ce, &key, &key_len, &expire, &z_value) == FAILURE) {
         return 0;
     }
 
@@ -597,10 +669,20 @@ int execute_setex_command(zval* object, int argc, zval* return_value, zend_class
     if (!valkey_glide || !valkey_glide->glide_client) {
         return 0;
     }
+    if (!valkey_glide->serializer && Z_TYPE_P(z_value) > IS_STRING) {
+        return 0;
+    }
 
     /* Call execute_set_command_internal with expire in seconds (EX) and no special options */
-    int result = execute_set_command_internal(
-        valkey_glide->glide_client, key, key_len, val, val_len, expire, NULL, NULL, NULL);
+    int result = execute_set_command_internal(valkey_glide->glide_client,
+                                              valkey_glide->serializer,
+                                              key,
+                                              key_len,
+                                              z_value,
+                                              expire,
+                                              NULL,
+                                              NULL,
+                                              NULL);
 
     if (result == 1) {
         ZVAL_TRUE(return_value);
@@ -614,14 +696,14 @@ int execute_setex_command(zval* object, int argc, zval* return_value, zend_class
 /* Execute a PSETEX command using the Valkey Glide client - UNIFIED IMPLEMENTATION */
 int execute_psetex_command(zval* object, int argc, zval* return_value, zend_class_entry* ce) {
     valkey_glide_object* valkey_glide;
-    char *               key = NULL, *val = NULL;
-    size_t               key_len, val_len;
+    char*                key = NULL;
+    size_t               key_len;
+    zval*                z_value;
     zend_long            expire;
 
     /* Parse parameters */
     if (zend_parse_method_parameters(
-            argc, object, "Osls", &object, ce, &key, &key_len, &expire, &val, &val_len) ==
-        FAILURE) {
+            argc, object, "Oslz", &object, ce, &key, &key_len, &expire, &z_value) == FAILURE) {
         return 0;
     }
 
@@ -630,6 +712,9 @@ int execute_psetex_command(zval* object, int argc, zval* return_value, zend_clas
     if (!valkey_glide || !valkey_glide->glide_client) {
         return 0;
     }
+    if (!valkey_glide->serializer && Z_TYPE_P(z_value) > IS_STRING) {
+        return 0;
+    }
 
     /* Create options array for PX option */
     zval options;
@@ -639,8 +724,15 @@ int execute_psetex_command(zval* object, int argc, zval* return_value, zend_clas
     add_assoc_long_ex(&options, "PX", sizeof("PX") - 1, expire);
 
     /* Call execute_set_command_internal with the PX option */
-    int result = execute_set_command_internal(
-        valkey_glide->glide_client, key, key_len, val, val_len, 0, &options, NULL, NULL);
+    int result = execute_set_command_internal(valkey_glide->glide_client,
+                                              valkey_glide->serializer,
+                                              key,
+                                              key_len,
+                                              z_value,
+                                              0,
+                                              &options,
+                                              NULL,
+                                              NULL);
 
     /* Clean up options array */
     zval_dtor(&options);
@@ -657,12 +749,13 @@ int execute_psetex_command(zval* object, int argc, zval* return_value, zend_clas
 /* Execute a SETNX command using the Valkey Glide client - UNIFIED IMPLEMENTATION */
 int execute_setnx_command(zval* object, int argc, zval* return_value, zend_class_entry* ce) {
     valkey_glide_object* valkey_glide;
-    char *               key = NULL, *val = NULL;
-    size_t               key_len, val_len;
+    char*                key = NULL;
+    size_t               key_len;
+    zval*                z_value;
 
     /* Parse parameters */
-    if (zend_parse_method_parameters(
-            argc, object, "Oss", &object, ce, &key, &key_len, &val, &val_len) == FAILURE) {
+    if (zend_parse_method_parameters(argc, object, "Osz", &object, ce, &key, &key_len, &z_value) ==
+        FAILURE) {
         return 0;
     }
 
@@ -671,6 +764,9 @@ int execute_setnx_command(zval* object, int argc, zval* return_value, zend_class
     if (!valkey_glide || !valkey_glide->glide_client) {
         return 0;
     }
+    if (!valkey_glide->serializer && Z_TYPE_P(z_value) > IS_STRING) {
+        return 0;
+    }
 
     /* Create options array for NX option */
     zval options;
@@ -682,8 +778,15 @@ int execute_setnx_command(zval* object, int argc, zval* return_value, zend_class
     add_next_index_zval(&options, &nx_option);
 
     /* Call execute_set_command_internal with the NX option and no expiration */
-    int result = execute_set_command_internal(
-        valkey_glide->glide_client, key, key_len, val, val_len, 0, &options, NULL, NULL);
+    int result = execute_set_command_internal(valkey_glide->glide_client,
+                                              valkey_glide->serializer,
+                                              key,
+                                              key_len,
+                                              z_value,
+                                              0,
+                                              &options,
+                                              NULL,
+                                              NULL);
 
     /* Clean up options array */
     zval_dtor(&options);
@@ -1247,6 +1350,17 @@ int execute_get_command(zval* object, int argc, zval* return_value, zend_class_e
         return 0;
     }
 
+    /* Serve the read from the near cache, filling it on a miss */
+    uint64_t fill_token = 0;
+    if (valkey_glide->near_cache) {
+        if (valkey_glide_near_cache_get_string(
+                valkey_glide->near_cache, Get, key, key_len, NULL, 0, return_value)) {
+            valkey_glide_unpack_zval(valkey_glide->serializer, return_value);
+            return 1;
+        }
+        fill_token = valkey_glide_near_cache_begin_fill(valkey_glide->near_cache);
+    }
+
     /* Execute using core framework */
     core_command_args_t args = {0};
     args.glide_client        = valkey_glide->glide_client;
@@ -1262,7 +1376,18 @@ int execute_get_command(zval* object, int argc, zval* return_value, zend_class_e
 
     if (execute_core_command(&args, &output, process_core_string_result)) {
         if (response != NULL) {
-            ZVAL_STRINGL(return_value, response, response_len);
+            if (valkey_glide->near_cache) {
+                valkey_glide_near_cache_put_string(valkey_glide->near_cache,
+                                                   Get,
+                                                   key,
+                                                   key_len,
+                                                   NULL,
+                                                   0,
+                                                   response,
+                                                   response_len,
+                                                   fill_token);
+            }
+            valkey_glide_unpack(valkey_glide->serializer, response, response_len, return_value);
             efree(response);
             return 1;
         } else {
@@ -1481,7 +1606,11 @@ int execute_del_command(zval* object, int argc, zval* return_value, zend_class_e
     }
 
     if (keys_count == 1 && Z_TYPE(keys[0]) == IS_ARRAY) {
-        if (execute_del_array(valkey_glide->glide_client, Z_ARRVAL(keys[0]), &result_value)) {
+        int status =
+            ce == get_valkey_glide_cluster_ce()
+                ? execute_cluster_del(valkey_glide, Del, Z_ARRVAL(keys[0]), &result_value)
+                : execute_del_array(valkey_glide->glide_client, Z_ARRVAL(keys[0]), &result_value);
+        if (status) {
             ZVAL_LONG(return_value, result_value);
             return 1;
         }
@@ -1721,14 +1850,15 @@ int execute_pttl_command(zval* object, int argc, zval* return_value, zend_class_
 /* Execute a GETSET command using the Valkey Glide client - UNIFIED IMPLEMENTATION */
 int execute_getset_command(zval* object, int argc, zval* return_value, zend_class_entry* ce) {
     valkey_glide_object* valkey_glide;
-    char *               key = NULL, *val = NULL;
-    size_t               key_len, val_len;
+    char*                key = NULL;
+    size_t               key_len;
+    zval*                z_value;
     char*                response     = NULL;
     size_t               response_len = 0;
 
     /* Parse parameters */
-    if (zend_parse_method_parameters(
-            argc, object, "Oss", &object, ce, &key, &key_len, &val, &val_len) == FAILURE) {
+    if (zend_parse_method_parameters(argc, object, "Osz", &object, ce, &key, &key_len, &z_value) ==
+        FAILURE) {
         return 0;
     }
 
@@ -1737,6 +1867,9 @@ int execute_getset_command(zval* object, int argc, zval* return_value, zend_clas
     if (!valkey_glide || !valkey_glide->glide_client) {
         return 0;
     }
+    if (!valkey_glide->serializer && Z_TYPE_P(z_value) > IS_STRING) {
+        return 0;
+    }
 
     /* Create a zval array for the GET option */
     zval z_opts;
@@ -1745,10 +1878,10 @@ int execute_getset_command(zval* object, int argc, zval* return_value, zend_clas
 
     /* Execute the SET command with GET option using the Glide client */
     int result = execute_set_command_internal(valkey_glide->glide_client,
+                                              valkey_glide->serializer,
                                               key,
                                               key_len,
-                                              val,
-                                              val_len,
+                                              z_value,
                                               0,       /* No expiry */
                                               &z_opts, /* Use GET option */
                                               &response,
@@ -1760,7 +1893,7 @@ int execute_getset_command(zval* object, int argc, zval* return_value, zend_clas
     /* Process the result */
     if ((result == 1 || result == 2) && response != NULL) {
         /* Return the old value */
-        ZVAL_STRINGL(return_value, response, response_len);
+        valkey_glide_unpack(valkey_glide->serializer, response, response_len, return_value);
         efree(response);
         return 1;
     } else if (result == 0 || (result == 2 && response == NULL)) {
@@ -1810,6 +1943,8 @@ int execute_lcs_command(zval* object, int argc, zval* return_value, zend_class_e
     uintptr_t
         args[7]; /* Maximum 7 arguments: key1, key2, LEN, IDX, MINMATCHLEN, value, WITHMATCHLEN */
     unsigned long args_len[7];
+    arg_arena_t   arena; /* Holds the MINMATCHLEN value */
+    arena_init(&arena);
 
     /* First argument: key1 */
     args[0]     = (uintptr_t)key1;
@@ -1889,11 +2024,8 @@ int execute_lcs_command(zval* object, int argc, zval* return_value, zend_class_e
 
         /* Add the minmatchlen value */
         size_t minmatchlen_len;
-        char*  minmatchlen_str = long_to_string(minmatchlen_value, &minmatchlen_len);
-        if (!minmatchlen_str) {
-            return 0;
-        }
-        args[arg_count]     = (uintptr_t)minmatchlen_str;
+        args[arg_count] =
+            (uintptr_t)arena_long_to_string(&arena, minmatchlen_value, &minmatchlen_len);
         args_len[arg_count] = minmatchlen_len;
         arg_count++;
     }
@@ -1912,6 +2044,7 @@ int execute_lcs_command(zval* object, int argc, zval* return_value, zend_class_e
                                                 args,      /* arguments */
                                                 args_len   /* argument lengths */
     );
+    arena_free(&arena);
 
     /* Check if the command was successful */
     if (!cmd_result) {
@@ -20,6 +20,8 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include "valkey_glide_serializer.h"
+
 /* ====================================================================
  * CORE FRAMEWORK IMPLEMENTATION
  * ==================================================================== */
@@ -35,21 +37,21 @@ int execute_core_command(core_command_args_t*    args,
         return 0;
     }
 
-    uintptr_t*     cmd_args          = NULL;
-    unsigned long* cmd_args_len      = NULL;
-    char**         allocated_strings = NULL;
-    int            allocated_count   = 0;
-    int            arg_count         = 0;
-    int            res               = 0;
-    CommandResult* result            = NULL;
+    arg_arena_t    arena;
+    uintptr_t*     cmd_args     = NULL;
+    unsigned long* cmd_args_len = NULL;
+    int            arg_count    = 0;
+    int            res          = 0;
+    CommandResult* result       = NULL;
 
     debug_print_core_args(args);
 
     /* Prepare command arguments based on command type */
-    arg_count =
-        prepare_core_args(args, &cmd_args, &cmd_args_len, &allocated_strings, &allocated_count);
+    arena_init(&arena);
+    arg_count = prepare_core_args(args, &arena, &cmd_args, &cmd_args_len);
 
     if (arg_count < 0) {
+        arena_free(&arena);
         return 0;
     }
 
@@ -83,7 +85,7 @@ int execute_core_command(core_command_args_t*    args,
     }
 
     /* Cleanup */
-    free_core_args(cmd_args, cmd_args_len, allocated_strings, allocated_count);
+    arena_free(&arena);
 
     return res;
 }
@@ -92,10 +94,9 @@ int execute_core_command(core_command_args_t*    args,
  * Prepare command arguments based on command type and structure
  */
 int prepare_core_args(core_command_args_t* args,
+                      arg_arena_t*         arena,
                       uintptr_t**          cmd_args,
-                      unsigned long**      cmd_args_len,
-                      char***              allocated_strings,
-                      int*                 allocated_count) {
+                      unsigned long**      cmd_args_len) {
     if (!args) {
         return 0;
     }
@@ -109,7 +110,7 @@ int prepare_core_args(core_command_args_t* args,
         case Time:
         case Role:
         case DBSize:
-            return prepare_zero_args(args, cmd_args, cmd_args_len);
+            return prepare_zero_args(args, arena, cmd_args, cmd_args_len);
 
         /* Single key operations */
         case GetDel:
@@ -122,16 +123,15 @@ int prepare_core_args(core_command_args_t* args,
         case PExpireTime:
         case Persist:
         case Dump:
-            return prepare_key_only_args(args, cmd_args, cmd_args_len);
+            return prepare_key_only_args(args, arena, cmd_args, cmd_args_len);
 
         /* Pattern-based operations */
         case Keys:
-            return prepare_message_args(
-                args, cmd_args, cmd_args_len, allocated_strings, allocated_count);
+            return prepare_message_args(args, arena, cmd_args, cmd_args_len);
 
         /* Zero-argument operations */
         case UnWatch:
-            return prepare_zero_args(args, cmd_args, cmd_args_len);
+            return prepare_zero_args(args, arena, cmd_args, cmd_args_len);
 
         /* Key-value operations */
         case Set:
@@ -152,8 +152,7 @@ int prepare_core_args(core_command_args_t* args,
         case IncrByFloat:
         case Move:
         case Copy:
-            return prepare_key_value_args(
-                args, cmd_args, cmd_args_len, allocated_strings, allocated_count);
+            return prepare_key_value_args(args, arena, cmd_args, cmd_args_len);
 
         /* DEL and UNLINK: Support both single-key and multi-key operations */
         case Del:
@@ -162,11 +161,11 @@ int prepare_core_args(core_command_args_t* args,
             if (args->key && args->key_len > 0 && args->arg_count == 0) {
                 /* Single key: DEL key */
 
-                return prepare_key_only_args(args, cmd_args, cmd_args_len);
+                return prepare_key_only_args(args, arena, cmd_args, cmd_args_len);
             } else if (args->arg_count > 0 && args->args[0].type == CORE_ARG_TYPE_ARRAY) {
                 /* Multi-key: DEL key1 key2 key3 */
 
-                return prepare_multi_key_args(args, cmd_args, cmd_args_len);
+                return prepare_multi_key_args(args, arena, cmd_args, cmd_args_len);
             }
             return 0;
 
@@ -175,25 +174,24 @@ int prepare_core_args(core_command_args_t* args,
         case Touch:
         case MGet:
         case Watch:
-            return prepare_multi_key_args(args, cmd_args, cmd_args_len);
+            return prepare_multi_key_args(args, arena, cmd_args, cmd_args_len);
 
         /* PFCOUNT: Support both single-key and multi-key operations */
         case PfCount:
             /* Check if single key or multi-key operation */
             if (args->key && args->key_len > 0 && args->arg_count == 0) {
                 /* Single key: PFCOUNT key */
-                return prepare_key_only_args(args, cmd_args, cmd_args_len);
+                return prepare_key_only_args(args, arena, cmd_args, cmd_args_len);
             } else if (args->arg_count > 0 && args->args[0].type == CORE_ARG_TYPE_ARRAY) {
                 /* Multi-key: PFCOUNT key1 key2 key3 */
-                return prepare_multi_key_args(args, cmd_args, cmd_args_len);
+                return prepare_multi_key_args(args, arena, cmd_args, cmd_args_len);
             }
             return 0;
 
         /* HyperLogLog operations */
         case PfAdd:
         case PfMerge:
-            return prepare_key_value_args(
-                args, cmd_args, cmd_args_len, allocated_strings, allocated_count);
+            return prepare_key_value_args(args, arena, cmd_args, cmd_args_len);
 
         /* Bit operations */
         case BitCount:
@@ -201,22 +199,19 @@ int prepare_core_args(core_command_args_t* args,
         case GetBit:
         case SetBit:
         case BitOp:
-            return prepare_bit_operation_args(
-                args, cmd_args, cmd_args_len, allocated_strings, allocated_count);
+            return prepare_bit_operation_args(args, arena, cmd_args, cmd_args_len);
 
         /* Expire operations */
         case Expire:
         case ExpireAt:
         case PExpire:
         case PExpireAt:
-            return prepare_expire_args(
-                args, cmd_args, cmd_args_len, allocated_strings, allocated_count);
+            return prepare_expire_args(args, arena, cmd_args, cmd_args_len);
 
         /* Range operations */
         case GetRange:
         case SetRange:
-            return prepare_range_args(
-                args, cmd_args, cmd_args_len, allocated_strings, allocated_count);
+            return prepare_range_args(args, arena, cmd_args, cmd_args_len);
 
         /* Message operations (no key, just arguments) */
         case Ping:
@@ -226,39 +221,18 @@ int prepare_core_args(core_command_args_t* args,
         case FlushAll:
         case Select:
         case SwapDb:
-            return prepare_message_args(
-                args, cmd_args, cmd_args_len, allocated_strings, allocated_count);
+            return prepare_message_args(args, arena, cmd_args, cmd_args_len);
 
         /* Key-value pair operations */
         case MSet:
         case MSetNX:
-            return prepare_key_value_pairs_args(
-                args, cmd_args, cmd_args_len, allocated_strings, allocated_count);
+            return prepare_key_value_pairs_args(args, arena, cmd_args, cmd_args_len);
 
         default:
             return 0;
     }
 }
 
-/**
- * Free all allocated command arguments and strings
- */
-void free_core_args(uintptr_t*     cmd_args,
-                    unsigned long* cmd_args_len,
-                    char**         allocated_strings,
-                    int            allocated_count) {
-    if (cmd_args) {
-        efree(cmd_args);
-    }
-    if (cmd_args_len) {
-        efree(cmd_args_len);
-    }
-    if (allocated_strings) {
-        free_tracked_strings(allocated_strings, allocated_count);
-        efree(allocated_strings);
-    }
-}
-
 /* ====================================================================
  * ARGUMENT PREPARATION HELPERS
  * ==================================================================== */
@@ -267,6 +241,7 @@ void free_core_args(uintptr_t*     cmd_args,
  * Prepare arguments for zero-argument operations (RANDOMKEY, etc.)
  */
 int prepare_zero_args(core_command_args_t* args,
+                      arg_arena_t*         arena,
                       uintptr_t**          cmd_args,
                       unsigned long**      cmd_args_len) {
     /* No arguments needed - just return 0 to indicate success but no args */
@@ -279,13 +254,14 @@ int prepare_zero_args(core_command_args_t* args,
  * Prepare arguments for single key operations
  */
 int prepare_key_only_args(core_command_args_t* args,
+                          arg_arena_t*         arena,
                           uintptr_t**          cmd_args,
                           unsigned long**      cmd_args_len) {
     if (!args->key || args->key_len == 0) {
         return 0;
     }
 
-    if (!allocate_core_arg_arrays(1, cmd_args, cmd_args_len)) {
+    if (!arena_alloc_args(arena, 1, cmd_args, cmd_args_len)) {
         return 0;
     }
 
@@ -299,10 +275,9 @@ int prepare_key_only_args(core_command_args_t* args,
  * Prepare arguments for key-value operations
  */
 int prepare_key_value_args(core_command_args_t* args,
+                           arg_arena_t*         arena,
                            uintptr_t**          cmd_args,
-                           unsigned long**      cmd_args_len,
-                           char***              allocated_strings,
-                           int*                 allocated_count) {
+                           unsigned long**      cmd_args_len) {
     if (!args->key || args->key_len == 0) {
         return 0;
     }
@@ -315,6 +290,7 @@ int prepare_key_value_args(core_command_args_t* args,
             case CORE_ARG_TYPE_STRING:
             case CORE_ARG_TYPE_LONG:
             case CORE_ARG_TYPE_DOUBLE:
+            case CORE_ARG_TYPE_VALUE:
                 total_args++;
                 break;
             case CORE_ARG_TYPE_MULTI_STRING:
@@ -352,14 +328,10 @@ int prepare_key_value_args(core_command_args_t* args,
         total_args++; /* PERSIST */
     }
 
-    if (!allocate_core_arg_arrays(total_args, cmd_args, cmd_args_len)) {
+    if (!arena_alloc_args(arena, total_args, cmd_args, cmd_args_len)) {
         return 0;
     }
 
-    /* Initialize string tracking */
-    *allocated_strings = create_string_tracker(total_args);
-    *allocated_count   = 0;
-
     int arg_idx = 0;
 
     /* Add key */
@@ -377,26 +349,35 @@ int prepare_key_value_args(core_command_args_t* args,
                 break;
 
             case CORE_ARG_TYPE_LONG: {
+                long   value = args->args[i].data.long_arg.value;
                 size_t len;
-                char*  str = core_long_to_string(args->args[i].data.long_arg.value, &len);
-                if (str) {
-                    (*cmd_args)[arg_idx]     = (uintptr_t)str;
-                    (*cmd_args_len)[arg_idx] = len;
-                    add_tracked_string(*allocated_strings, allocated_count, str);
-                    arg_idx++;
-                }
+                char*  str = arena_long_to_string(arena, value, &len);
+                (*cmd_args)[arg_idx]     = (uintptr_t)str;
+                (*cmd_args_len)[arg_idx] = len;
+                arg_idx++;
                 break;
             }
 
             case CORE_ARG_TYPE_DOUBLE: {
+                double value = args->args[i].data.double_arg.value;
                 size_t len;
-                char*  str = core_double_to_string(args->args[i].data.double_arg.value, &len);
-                if (str) {
-                    (*cmd_args)[arg_idx]     = (uintptr_t)str;
-                    (*cmd_args_len)[arg_idx] = len;
-                    add_tracked_string(*allocated_strings, allocated_count, str);
-                    arg_idx++;
+                char*  str = arena_double_to_string(arena, value, &len);
+                (*cmd_args)[arg_idx]     = (uintptr_t)str;
+                (*cmd_args_len)[arg_idx] = len;
+                arg_idx++;
+                break;
+            }
+
+            case CORE_ARG_TYPE_VALUE: {
+                size_t len;
+                char*  str = valkey_glide_pack(
+                    args->serializer, arena, args->args[i].data.value_arg.value, &len);
+                if (!str) {
+                    return -1;
                 }
+                (*cmd_args)[arg_idx]     = (uintptr_t)str;
+                (*cmd_args_len)[arg_idx] = len;
+                arg_idx++;
                 break;
             }
 
@@ -422,21 +403,11 @@ int prepare_key_value_args(core_command_args_t* args,
                             arg_idx++;
                         } else {
                             /* Convert non-string to string */
-                            zend_string* str = zval_get_string(element);
-                            if (str) {
-                                size_t len      = ZSTR_LEN(str);
-                                char*  str_copy = emalloc(len + 1);
-                                if (str_copy) {
-                                    memcpy(str_copy, ZSTR_VAL(str), len);
-                                    str_copy[len]            = '\0';
-                                    (*cmd_args)[arg_idx]     = (uintptr_t)str_copy;
-                                    (*cmd_args_len)[arg_idx] = len;
-                                    add_tracked_string(
-                                        *allocated_strings, allocated_count, str_copy);
-                                    arg_idx++;
-                                }
-                                zend_string_release(str);
-                            }
+                            size_t len;
+                            char*  str = arena_zval_to_string(arena, element, &len);
+                            (*cmd_args)[arg_idx]     = (uintptr_t)str;
+                            (*cmd_args_len)[arg_idx] = len;
+                            arg_idx++;
                         }
                     }
                     ZEND_HASH_FOREACH_END();
@@ -457,52 +428,40 @@ int prepare_key_value_args(core_command_args_t* args,
             arg_idx++;
 
             size_t len;
-            char*  str = core_long_to_string(args->options.expire_at_milliseconds, &len);
-            if (str) {
-                (*cmd_args)[arg_idx]     = (uintptr_t)str;
-                (*cmd_args_len)[arg_idx] = len;
-                add_tracked_string(*allocated_strings, allocated_count, str);
-                arg_idx++;
-            }
+            char*  str = arena_long_to_string(arena, args->options.expire_at_milliseconds, &len);
+            (*cmd_args)[arg_idx]     = (uintptr_t)str;
+            (*cmd_args_len)[arg_idx] = len;
+            arg_idx++;
         } else if (args->options.has_exat) {
             (*cmd_args)[arg_idx]     = (uintptr_t)"EXAT";
             (*cmd_args_len)[arg_idx] = 4;
             arg_idx++;
 
             size_t len;
-            char*  str = core_long_to_string(args->options.expire_at_seconds, &len);
-            if (str) {
-                (*cmd_args)[arg_idx]     = (uintptr_t)str;
-                (*cmd_args_len)[arg_idx] = len;
-                add_tracked_string(*allocated_strings, allocated_count, str);
-                arg_idx++;
-            }
+            char*  str = arena_long_to_string(arena, args->options.expire_at_seconds, &len);
+            (*cmd_args)[arg_idx]     = (uintptr_t)str;
+            (*cmd_args_len)[arg_idx] = len;
+            arg_idx++;
         } else if (args->options.has_pexpire) {
             (*cmd_args)[arg_idx]     = (uintptr_t)"PX";
             (*cmd_args_len)[arg_idx] = 2;
             arg_idx++;
 
             size_t len;
-            char*  str = core_long_to_string(args->options.expire_milliseconds, &len);
-            if (str) {
-                (*cmd_args)[arg_idx]     = (uintptr_t)str;
-                (*cmd_args_len)[arg_idx] = len;
-                add_tracked_string(*allocated_strings, allocated_count, str);
-                arg_idx++;
-            }
+            char*  str = arena_long_to_string(arena, args->options.expire_milliseconds, &len);
+            (*cmd_args)[arg_idx]     = (uintptr_t)str;
+            (*cmd_args_len)[arg_idx] = len;
+            arg_idx++;
         } else {
             (*cmd_args)[arg_idx]     = (uintptr_t)"EX";
             (*cmd_args_len)[arg_idx] = 2;
             arg_idx++;
 
             size_t len;
-            char*  str = core_long_to_string(args->options.expire_seconds, &len);
-            if (str) {
-                (*cmd_args)[arg_idx]     = (uintptr_t)str;
-                (*cmd_args_len)[arg_idx] = len;
-                add_tracked_string(*allocated_strings, allocated_count, str);
-                arg_idx++;
-            }
+            char*  str = arena_long_to_string(arena, args->options.expire_seconds, &len);
+            (*cmd_args)[arg_idx]     = (uintptr_t)str;
+            (*cmd_args_len)[arg_idx] = len;
+            arg_idx++;
         }
     }
 
@@ -553,10 +512,9 @@ int prepare_key_value_args(core_command_args_t* args,
  * Prepare arguments for message operations (ECHO, etc.)
  */
 int prepare_message_args(core_command_args_t* args,
+                         arg_arena_t*         arena,
                          uintptr_t**          cmd_args,
-                         unsigned long**      cmd_args_len,
-                         char***              allocated_strings,
-                         int*                 allocated_count) {
+                         unsigned long**      cmd_args_len) {
     if (args->arg_count == 0) {
         return 0;
     }
@@ -579,14 +537,10 @@ int prepare_message_args(core_command_args_t* args,
         }
     }
 
-    if (!allocate_core_arg_arrays(total_args, cmd_args, cmd_args_len)) {
+    if (!arena_alloc_args(arena, total_args, cmd_args, cmd_args_len)) {
         return 0;
     }
 
-    /* Initialize string tracking */
-    *allocated_strings = create_string_tracker(total_args);
-    *allocated_count   = 0;
-
     int arg_idx = 0;
 
     /* Add all arguments */
@@ -599,26 +553,22 @@ int prepare_message_args(core_command_args_t* args,
                 break;
 
             case CORE_ARG_TYPE_LONG: {
+                long   value = args->args[i].data.long_arg.value;
                 size_t len;
-                char*  str = core_long_to_string(args->args[i].data.long_arg.value, &len);
-                if (str) {
-                    (*cmd_args)[arg_idx]     = (uintptr_t)str;
-                    (*cmd_args_len)[arg_idx] = len;
-                    add_tracked_string(*allocated_strings, allocated_count, str);
-                    arg_idx++;
-                }
+                char*  str = arena_long_to_string(arena, value, &len);
+                (*cmd_args)[arg_idx]     = (uintptr_t)str;
+                (*cmd_args_len)[arg_idx] = len;
+                arg_idx++;
                 break;
             }
 
             case CORE_ARG_TYPE_DOUBLE: {
+                double value = args->args[i].data.double_arg.value;
                 size_t len;
-                char*  str = core_double_to_string(args->args[i].data.double_arg.value, &len);
-                if (str) {
-                    (*cmd_args)[arg_idx]     = (uintptr_t)str;
-                    (*cmd_args_len)[arg_idx] = len;
-                    add_tracked_string(*allocated_strings, allocated_count, str);
-                    arg_idx++;
-                }
+                char*  str = arena_double_to_string(arena, value, &len);
+                (*cmd_args)[arg_idx]     = (uintptr_t)str;
+                (*cmd_args_len)[arg_idx] = len;
+                arg_idx++;
                 break;
             }
 
@@ -642,10 +592,9 @@ int prepare_message_args(core_command_args_t* args,
  * Prepare arguments for key-value pairs operations (MSET, MSETNX)
  */
 int prepare_key_value_pairs_args(core_command_args_t* args,
+                                 arg_arena_t*         arena,
                                  uintptr_t**          cmd_args,
-                                 unsigned long**      cmd_args_len,
-                                 char***              allocated_strings,
-                                 int*                 allocated_count) {
+                                 unsigned long**      cmd_args_len) {
     if (args->arg_count == 0 || args->args[0].type != CORE_ARG_TYPE_ARRAY) {
         return 0;
     }
@@ -665,14 +614,10 @@ int prepare_key_value_pairs_args(core_command_args_t* args,
     /* Each key-value pair requires 2 arguments */
     int total_args = key_count * 2;
 
-    if (!allocate_core_arg_arrays(total_args, cmd_args, cmd_args_len)) {
+    if (!arena_alloc_args(arena, total_args, cmd_args, cmd_args_len)) {
         return 0;
     }
 
-    /* Initialize string tracking */
-    *allocated_strings = create_string_tracker(total_args);
-    *allocated_count   = 0;
-
     int          arg_idx = 0;
     zval*        data;
     zend_string* key;
@@ -683,13 +628,10 @@ int prepare_key_value_pairs_args(core_command_args_t* args,
         if (!key) {
             /* Numeric key - convert to string */
             size_t key_len;
-            char*  key_str = core_long_to_string((long)num_key, &key_len);
-            if (key_str) {
-                (*cmd_args)[arg_idx]     = (uintptr_t)key_str;
-                (*cmd_args_len)[arg_idx] = key_len;
-                add_tracked_string(*allocated_strings, allocated_count, key_str);
-                arg_idx++;
-            }
+            char*  key_str           = arena_long_to_string(arena, (long)num_key, &key_len);
+            (*cmd_args)[arg_idx]     = (uintptr_t)key_str;
+            (*cmd_args_len)[arg_idx] = key_len;
+            arg_idx++;
         } else {
             /* String key */
             (*cmd_args)[arg_idx]     = (uintptr_t)ZSTR_VAL(key);
@@ -697,20 +639,15 @@ int prepare_key_value_pairs_args(core_command_args_t* args,
             arg_idx++;
         }
 
-        /* Add value */
-        if (Z_TYPE_P(data) == IS_STRING) {
-            (*cmd_args)[arg_idx]     = (uintptr_t)Z_STRVAL_P(data);
-            (*cmd_args_len)[arg_idx] = Z_STRLEN_P(data);
-            arg_idx++;
-        } else {
-            /* Convert non-string value to string using safe method */
-            zend_string* str = zval_get_string(data);
-            if (str) {
-                (*cmd_args)[arg_idx]     = (uintptr_t)ZSTR_VAL(str);
-                (*cmd_args_len)[arg_idx] = ZSTR_LEN(str);
-                arg_idx++;
-            }
+        /* Add value, converted or packed in the arena unless it is a string sent as is */
+        size_t len;
+        char*  str = valkey_glide_pack(args->serializer, arena, data, &len);
+        if (!str) {
+            return -1;
         }
+        (*cmd_args)[arg_idx]     = (uintptr_t)str;
+        (*cmd_args_len)[arg_idx] = len;
+        arg_idx++;
     }
     ZEND_HASH_FOREACH_END();
 
@@ -721,6 +658,7 @@ int prepare_key_value_pairs_args(core_command_args_t* args,
  * Prepare arguments for multi-key operations
  */
 int prepare_multi_key_args(core_command_args_t* args,
+                           arg_arena_t*         arena,
                            uintptr_t**          cmd_args,
                            unsigned long**      cmd_args_len) {
     if (args->arg_count == 0 || args->args[0].type != CORE_ARG_TYPE_ARRAY) {
@@ -730,7 +668,7 @@ int prepare_multi_key_args(core_command_args_t* args,
     zval* keys      = args->args[0].data.array_arg.array;
     int   key_count = args->args[0].data.array_arg.count;
 
-    if (!allocate_core_arg_arrays(key_count, cmd_args, cmd_args_len)) {
+    if (!arena_alloc_args(arena, key_count, cmd_args, cmd_args_len)) {
         return 0;
     }
 
@@ -755,10 +693,9 @@ int prepare_multi_key_args(core_command_args_t* args,
  * Prepare arguments for bit operations
  */
 int prepare_bit_operation_args(core_command_args_t* args,
+                               arg_arena_t*         arena,
                                uintptr_t**          cmd_args,
-                               unsigned long**      cmd_args_len,
-                               char***              allocated_strings,
-                               int*                 allocated_count) {
+                               unsigned long**      cmd_args_len) {
     if (!args->key || args->key_len == 0) {
         return 0;
     }
@@ -791,13 +728,10 @@ int prepare_bit_operation_args(core_command_args_t* args,
             return 0;
     }
 
-    if (!allocate_core_arg_arrays(total_args, cmd_args, cmd_args_len)) {
+    if (!arena_alloc_args(arena, total_args, cmd_args, cmd_args_len)) {
         return 0;
     }
 
-    *allocated_strings = create_string_tracker(total_args);
-    *allocated_count   = 0;
-
     int arg_idx = 0;
 
     /* Handle BitOp differently - operation comes first */
@@ -830,14 +764,12 @@ int prepare_bit_operation_args(core_command_args_t* args,
         for (int i = 0; i < args->arg_count; i++) {
             switch (args->args[i].type) {
                 case CORE_ARG_TYPE_LONG: {
+                    long   value = args->args[i].data.long_arg.value;
                     size_t len;
-                    char*  str = core_long_to_string(args->args[i].data.long_arg.value, &len);
-                    if (str) {
-                        (*cmd_args)[arg_idx]     = (uintptr_t)str;
-                        (*cmd_args_len)[arg_idx] = len;
-                        add_tracked_string(*allocated_strings, allocated_count, str);
-                        arg_idx++;
-                    }
+                    char*  str = arena_long_to_string(arena, value, &len);
+                    (*cmd_args)[arg_idx]     = (uintptr_t)str;
+                    (*cmd_args_len)[arg_idx] = len;
+                    arg_idx++;
                     break;
                 }
                 default:
@@ -848,21 +780,15 @@ int prepare_bit_operation_args(core_command_args_t* args,
         /* Add range arguments if present */
         if (args->options.has_range) {
             size_t len;
-            char*  start_str = core_long_to_string(args->options.start, &len);
-            if (start_str) {
-                (*cmd_args)[arg_idx]     = (uintptr_t)start_str;
-                (*cmd_args_len)[arg_idx] = len;
-                add_tracked_string(*allocated_strings, allocated_count, start_str);
-                arg_idx++;
-            }
+            char*  start_str = arena_long_to_string(arena, args->options.start, &len);
+            (*cmd_args)[arg_idx]     = (uintptr_t)start_str;
+            (*cmd_args_len)[arg_idx] = len;
+            arg_idx++;
 
-            char* end_str = core_long_to_string(args->options.end, &len);
-            if (end_str) {
-                (*cmd_args)[arg_idx]     = (uintptr_t)end_str;
-                (*cmd_args_len)[arg_idx] = len;
-                add_tracked_string(*allocated_strings, allocated_count, end_str);
-                arg_idx++;
-            }
+            char* end_str = arena_long_to_string(arena, args->options.end, &len);
+            (*cmd_args)[arg_idx]     = (uintptr_t)end_str;
+            (*cmd_args_len)[arg_idx] = len;
+            arg_idx++;
         }
 
         /* Add BYBIT flag if present */
@@ -880,10 +806,9 @@ int prepare_bit_operation_args(core_command_args_t* args,
  * Prepare arguments for expire operations
  */
 int prepare_expire_args(core_command_args_t* args,
+                        arg_arena_t*         arena,
                         uintptr_t**          cmd_args,
-                        unsigned long**      cmd_args_len,
-                        char***              allocated_strings,
-                        int*                 allocated_count) {
+                        unsigned long**      cmd_args_len) {
     if (!args->key || args->key_len == 0 || args->arg_count == 0) {
         return 0;
     }
@@ -891,13 +816,10 @@ int prepare_expire_args(core_command_args_t* args,
     /* Calculate total arguments: key + time + optional mode */
     int total_args = 1 + args->arg_count; /* key + all provided arguments */
 
-    if (!allocate_core_arg_arrays(total_args, cmd_args, cmd_args_len)) {
+    if (!arena_alloc_args(arena, total_args, cmd_args, cmd_args_len)) {
         return 0;
     }
 
-    *allocated_strings = create_string_tracker(total_args);
-    *allocated_count   = 0;
-
     int arg_idx = 0;
 
     /* Add key */
@@ -909,14 +831,12 @@ int prepare_expire_args(core_command_args_t* args,
     for (int i = 0; i < args->arg_count; i++) {
         switch (args->args[i].type) {
             case CORE_ARG_TYPE_LONG: {
+                long   value = args->args[i].data.long_arg.value;
                 size_t len;
-                char*  str = core_long_to_string(args->args[i].data.long_arg.value, &len);
-                if (str) {
-                    (*cmd_args)[arg_idx]     = (uintptr_t)str;
-                    (*cmd_args_len)[arg_idx] = len;
-                    add_tracked_string(*allocated_strings, allocated_count, str);
-                    arg_idx++;
-                }
+                char*  str = arena_long_to_string(arena, value, &len);
+                (*cmd_args)[arg_idx]     = (uintptr_t)str;
+                (*cmd_args_len)[arg_idx] = len;
+                arg_idx++;
                 break;
             }
             case CORE_ARG_TYPE_STRING:
@@ -936,10 +856,9 @@ int prepare_expire_args(core_command_args_t* args,
  * Prepare arguments for range operations
  */
 int prepare_range_args(core_command_args_t* args,
+                       arg_arena_t*         arena,
                        uintptr_t**          cmd_args,
-                       unsigned long**      cmd_args_len,
-                       char***              allocated_strings,
-                       int*                 allocated_count) {
+                       unsigned long**      cmd_args_len) {
     if (!args->key || args->key_len == 0) {
         return 0;
     }
@@ -958,13 +877,10 @@ int prepare_range_args(core_command_args_t* args,
             return 0;
     }
 
-    if (!allocate_core_arg_arrays(total_args, cmd_args, cmd_args_len)) {
+    if (!arena_alloc_args(arena, total_args, cmd_args, cmd_args_len)) {
         return 0;
     }
 
-    *allocated_strings = create_string_tracker(total_args);
-    *allocated_count   = 0;
-
     int arg_idx = 0;
 
     /* Add key */
@@ -976,14 +892,12 @@ int prepare_range_args(core_command_args_t* args,
     for (int i = 0; i < args->arg_count && arg_idx < total_args; i++) {
         switch (args->args[i].type) {
             case CORE_ARG_TYPE_LONG: {
+                long   value = args->args[i].data.long_arg.value;
                 size_t len;
-                char*  str = core_long_to_string(args->args[i].data.long_arg.value, &len);
-                if (str) {
-                    (*cmd_args)[arg_idx]     = (uintptr_t)str;
-                    (*cmd_args_len)[arg_idx] = len;
-                    add_tracked_string(*allocated_strings, allocated_count, str);
-                    arg_idx++;
-                }
+                char*  str = arena_long_to_string(arena, value, &len);
+                (*cmd_args)[arg_idx]     = (uintptr_t)str;
+                (*cmd_args_len)[arg_idx] = len;
+                arg_idx++;
                 break;
             }
             case CORE_ARG_TYPE_STRING:
@@ -1186,96 +1100,26 @@ int process_core_type_result(CommandResult* result, void* output) {
     return -1; /* Error */
 }
 
-/* ====================================================================
- * MEMORY MANAGEMENT UTILITIES
- * ==================================================================== */
-
-/**
- * Allocate command argument arrays
- */
-int allocate_core_arg_arrays(int count, uintptr_t** args_out, unsigned long** args_len_out) {
-    *args_out     = (uintptr_t*)emalloc(count * sizeof(uintptr_t));
-    *args_len_out = (unsigned long*)emalloc(count * sizeof(unsigned long));
-
-    if (!*args_out || !*args_len_out) {
-        if (*args_out)
-            efree(*args_out);
-        if (*args_len_out)
-            efree(*args_len_out);
-        return 0;
-    }
-
-    return 1;
-}
-
 /**
- * Free command argument arrays
+ * Process an array of stored values (MGET)
  */
-void free_core_arg_arrays(uintptr_t* args, unsigned long* args_len) {
-    if (args)
-        efree(args);
-    if (args_len)
-        efree(args_len);
-}
+int process_core_unpacked_array_result(CommandResult* result, void* output) {
+    core_unpack_output_t* unpack_output = output;
 
-/**
- * Create string tracker for memory management
- */
-char** create_string_tracker(int max_strings) {
-    return (char**)ecalloc(max_strings, sizeof(char*));
-}
-
-/**
- * Add string to tracker
- */
-void add_tracked_string(char** tracker, int* count, char* str) {
-    if (tracker && str) {
-        tracker[*count] = str;
-        (*count)++;
+    if (!result || !result->response || !unpack_output) {
+        return 0;
     }
-}
 
-/**
- * Free all tracked strings
- */
-void free_tracked_strings(char** tracker, int count) {
-    if (!tracker)
-        return;
-
-    for (int i = 0; i < count; i++) {
-        if (tracker[i]) {
-            efree(tracker[i]);
-        }
-    }
+    return command_response_to_unpacked_zval(result->response,
+                                             unpack_output->value,
+                                             COMMAND_RESPONSE_NOT_ASSOSIATIVE,
+                                             true,
+                                             unpack_output->serializer);
 }
 
-/**
- * Convert long to string
- */
-char* core_long_to_string(long value, size_t* len) {
-    char buffer[32];
-    *len      = snprintf(buffer, sizeof(buffer), "%ld", value);
-    char* str = (char*)emalloc(*len + 1);
-    if (str) {
-        memcpy(str, buffer, *len);
-        str[*len] = '\0';
-    }
-    return str;
-}
-
-/**
- * Convert double to string
- */
-char* core_double_to_string(double value, size_t* len) {
-    char buffer[64];
-    *len      = snprintf(buffer, sizeof(buffer), "%.17g", value);
-    char* str = (char*)emalloc(*len + 1);
-    if (str) {
-        memcpy(str, buffer, *len);
-        str[*len] = '\0';
-    }
-    return str;
-}
+/* ====================================================================
+ * CONVERSION UTILITIES
+ * ==================================================================== */
 
 /**
  * Convert zval to string safely
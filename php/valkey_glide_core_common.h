@@ -18,6 +18,7 @@
 #define VALKEY_GLIDE_CORE_COMMON_H
 
 #include "command_response.h"
+#include "valkey_glide_arena.h"
 #include "valkey_glide_commands_common.h"
 
 /* ====================================================================
@@ -32,7 +33,8 @@ typedef enum {
     CORE_ARG_TYPE_DOUBLE,
     CORE_ARG_TYPE_ARRAY,
     CORE_ARG_TYPE_MULTI_STRING,
-    CORE_ARG_TYPE_KEY_VALUE_PAIRS
+    CORE_ARG_TYPE_KEY_VALUE_PAIRS,
+    CORE_ARG_TYPE_VALUE /* A stored value, packed with the command's serializer */
 } core_arg_type_t;
 
 /* Flexible argument container */
@@ -66,6 +68,10 @@ typedef struct {
         struct {
             HashTable* pairs;
         } key_value_arg;
+
+        struct {
+            zval* value;
+        } value_arg;
     } data;
 } core_arg_t;
 
@@ -112,6 +118,9 @@ typedef struct {
     const void*      glide_client;
     enum RequestType cmd_type;
 
+    /* Packs CORE_ARG_TYPE_VALUE arguments and MSET values, NULL to send them as they are */
+    const valkey_glide_serializer_t* serializer;
+
     /* Primary key */
     const char* key;
     size_t      key_len;
@@ -142,17 +151,11 @@ int execute_core_command(core_command_args_t*    args,
                          void*                   result_ptr,
                          core_result_processor_t processor);
 
-/* Command argument preparation utilities */
+/* Command argument preparation utilities; arrays and strings are allocated in the arena */
 int prepare_core_args(core_command_args_t* args,
+                      arg_arena_t*         arena,
                       uintptr_t**          cmd_args,
-                      unsigned long**      cmd_args_len,
-                      char***              allocated_strings,
-                      int*                 allocated_count);
-
-void free_core_args(uintptr_t*     cmd_args,
-                    unsigned long* cmd_args_len,
-                    char**         allocated_strings,
-                    int            allocated_count);
+                      unsigned long**      cmd_args_len);
 
 /* ====================================================================
  * ARGUMENT PREPARATION HELPERS
@@ -160,56 +163,53 @@ void free_core_args(uintptr_t*     cmd_args,
 
 /* Single key operations */
 int prepare_key_only_args(core_command_args_t* args,
+                          arg_arena_t*         arena,
                           uintptr_t**          cmd_args,
                           unsigned long**      cmd_args_len);
 
 /* Key-value operations */
 int prepare_key_value_args(core_command_args_t* args,
+                           arg_arena_t*         arena,
                            uintptr_t**          cmd_args,
-                           unsigned long**      cmd_args_len,
-                           char***              allocated_strings,
-                           int*                 allocated_count);
+                           unsigned long**      cmd_args_len);
 
 int prepare_key_value_pairs_args(core_command_args_t* args,
+                                 arg_arena_t*         arena,
                                  uintptr_t**          cmd_args,
-                                 unsigned long**      cmd_args_len,
-                                 char***              allocated_strings,
-                                 int*                 allocated_count);
+                                 unsigned long**      cmd_args_len);
 
 /* Message operations (no key, just arguments) */
 int prepare_message_args(core_command_args_t* args,
+                         arg_arena_t*         arena,
                          uintptr_t**          cmd_args,
-                         unsigned long**      cmd_args_len,
-                         char***              allocated_strings,
-                         int*                 allocated_count);
+                         unsigned long**      cmd_args_len);
 
 /* Multi-key operations */
 int prepare_multi_key_args(core_command_args_t* args,
+                           arg_arena_t*         arena,
                            uintptr_t**          cmd_args,
                            unsigned long**      cmd_args_len);
 
 /* Bit operations */
 int prepare_bit_operation_args(core_command_args_t* args,
+                               arg_arena_t*         arena,
                                uintptr_t**          cmd_args,
-                               unsigned long**      cmd_args_len,
-                               char***              allocated_strings,
-                               int*                 allocated_count);
+                               unsigned long**      cmd_args_len);
 
 /* Expire operations */
 int prepare_expire_args(core_command_args_t* args,
+                        arg_arena_t*         arena,
                         uintptr_t**          cmd_args,
-                        unsigned long**      cmd_args_len,
-                        char***              allocated_strings,
-                        int*                 allocated_count);
+                        unsigned long**      cmd_args_len);
 
 /* Range operations */
 int prepare_range_args(core_command_args_t* args,
+                       arg_arena_t*         arena,
                        uintptr_t**          cmd_args,
-                       unsigned long**      cmd_args_len,
-                       char***              allocated_strings,
-                       int*                 allocated_count);
+                       unsigned long**      cmd_args_len);
 
 int prepare_zero_args(core_command_args_t* args,
+                      arg_arena_t*         arena,
                       uintptr_t**          cmd_args,
                       unsigned long**      cmd_args_len);
 
@@ -238,24 +238,20 @@ int process_core_null_or_value_result(CommandResult* result, void* output);
 /* Core type result processor */
 int process_core_type_result(CommandResult* result, void* output);
 
-/* ====================================================================
- * MEMORY MANAGEMENT UTILITIES
- * ==================================================================== */
-
-/* Allocate command argument arrays */
-int allocate_core_arg_arrays(int count, uintptr_t** args_out, unsigned long** args_len_out);
+/* Output of the unpacking processors */
+typedef struct {
+    zval*                            value;
+    const valkey_glide_serializer_t* serializer;
+} core_unpack_output_t;
 
-/* Free command argument arrays */
-void free_core_arg_arrays(uintptr_t* args, unsigned long* args_len);
+/* Array of stored values (MGET), unpacked; missing values are false */
+int process_core_unpacked_array_result(CommandResult* result, void* output);
 
-/* Track allocated strings for cleanup */
-char** create_string_tracker(int max_strings);
-void   add_tracked_string(char** tracker, int* count, char* str);
-void   free_tracked_strings(char** tracker, int count);
+/* ====================================================================
+ * CONVERSION UTILITIES
+ * ==================================================================== */
 
-/* Convert various types to string arguments */
-char* core_long_to_string(long value, size_t* len);
-char* core_double_to_string(double value, size_t* len);
+/* Convert a zval to a string argument */
 char* core_zval_to_string(zval* z, size_t* len, int* need_free);
 
 /* ====================================================================
@@ -23,10 +23,6 @@
 #include "command_response.h"
 #include "valkey_glide_commands_common.h"
 
-/* Import the string conversion functions from command_response.c */
-extern char* long_to_string(long value, size_t* len);
-extern char* double_to_string(double value, size_t* len);
-
 /* ====================================================================
  * OPTION PARSING HELPERS
  * ==================================================================== */
@@ -188,6 +184,7 @@ int parse_geo_radius_options(zval* options, geo_radius_options_t* opts) {
  * Prepare basic geo command arguments (just key)
  */
 int prepare_geo_key_args(geo_command_args_t* args,
+                         arg_arena_t*        arena,
                          uintptr_t**         args_out,
                          unsigned long**     args_len_out) {
     if (!args || !args->key || !args_out || !args_len_out) {
@@ -196,14 +193,7 @@ int prepare_geo_key_args(geo_command_args_t* args,
 
     unsigned long arg_count = 1; /* just key */
 
-    *args_out     = (uintptr_t*)emalloc(arg_count * sizeof(uintptr_t));
-    *args_len_out = (unsigned long*)emalloc(arg_count * sizeof(unsigned long));
-
-    if (!(*args_out) || !(*args_len_out)) {
-        if (*args_out)
-            efree(*args_out);
-        if (*args_len_out)
-            efree(*args_len_out);
+    if (!arena_alloc_args(arena, arg_count, args_out, args_len_out)) {
         return 0;
     }
 
@@ -218,28 +208,18 @@ int prepare_geo_key_args(geo_command_args_t* args,
  * Prepare member-based geo command arguments (key + members)
  */
 int prepare_geo_members_args(geo_command_args_t* args,
+                             arg_arena_t*        arena,
                              uintptr_t**         args_out,
-                             unsigned long**     args_len_out,
-                             char***             allocated_strings,
-                             int*                allocated_count) {
+                             unsigned long**     args_len_out) {
     if (!args || !args->key || !args->members || args->member_count <= 0 || !args_out ||
-        !args_len_out || !allocated_strings || !allocated_count) {
+        !args_len_out) {
         return 0;
     }
 
-    *allocated_count = 0;
-
     /* Prepare command arguments: key + members */
     unsigned long arg_count = 1 + args->member_count;
 
-    *args_out     = (uintptr_t*)emalloc(arg_count * sizeof(uintptr_t));
-    *args_len_out = (unsigned long*)emalloc(arg_count * sizeof(unsigned long));
-
-    if (!(*args_out) || !(*args_len_out)) {
-        if (*args_out)
-            efree(*args_out);
-        if (*args_len_out)
-            efree(*args_len_out);
+    if (!arena_alloc_args(arena, arg_count, args_out, args_len_out)) {
         return 0;
     }
 
@@ -249,27 +229,16 @@ int prepare_geo_members_args(geo_command_args_t* args,
 
     /* Add members as arguments */
     for (int i = 0; i < args->member_count; i++) {
-        zval*  member    = &args->members[i];
-        char*  str_val   = NULL;
-        size_t str_len   = 0;
-        int    need_free = 0;
-
-        str_val = zval_to_string_safe(member, &str_len, &need_free);
+        zval*  member  = &args->members[i];
+        size_t str_len = 0;
+        char*  str_val = arena_zval_to_string(arena, member, &str_len);
 
         if (!str_val) {
-            /* Cleanup on error */
-            free_allocated_strings(*allocated_strings, *allocated_count);
-            efree(*args_out);
-            efree(*args_len_out);
             return 0;
         }
 
         (*args_out)[i + 1]     = (uintptr_t)str_val;
         (*args_len_out)[i + 1] = str_len;
-
-        if (need_free) {
-            (*allocated_strings)[(*allocated_count)++] = str_val;
-        }
     }
 
     return arg_count;
@@ -279,6 +248,7 @@ int prepare_geo_members_args(geo_command_args_t* args,
  * Prepare GEODIST command arguments (key + source + destination + optional unit)
  */
 int prepare_geo_dist_args(geo_command_args_t* args,
+                          arg_arena_t*        arena,
                           uintptr_t**         args_out,
                           unsigned long**     args_len_out) {
     /* Check if client, key, src, dst are valid */
@@ -289,14 +259,8 @@ int prepare_geo_dist_args(geo_command_args_t* args,
 
     /* Prepare command arguments */
     unsigned long arg_count = args->unit ? 4 : 3;
-    *args_out               = (uintptr_t*)emalloc(arg_count * sizeof(uintptr_t));
-    *args_len_out           = (unsigned long*)emalloc(arg_count * sizeof(unsigned long));
-
-    if (!(*args_out) || !(*args_len_out)) {
-        if (*args_out)
-            efree(*args_out);
-        if (*args_len_out)
-            efree(*args_len_out);
+
+    if (!arena_alloc_args(arena, arg_count, args_out, args_len_out)) {
         return 0;
     }
 
@@ -323,30 +287,20 @@ int prepare_geo_dist_args(geo_command_args_t* args,
  * Prepare GEOADD command arguments (key + [lon, lat, member] triplets)
  */
 int prepare_geo_add_args(geo_command_args_t* args,
+                         arg_arena_t*        arena,
                          uintptr_t**         args_out,
-                         unsigned long**     args_len_out,
-                         char***             allocated_strings,
-                         int*                allocated_count) {
+                         unsigned long**     args_len_out) {
     /* Check if client, key, and args are valid */
     if (!args || !args->key || !args->geo_args || args->geo_args_count < 3 ||
-        args->geo_args_count % 3 != 0 || !args_out || !args_len_out || !allocated_strings ||
-        !allocated_count) {
+        args->geo_args_count % 3 != 0 || !args_out || !args_len_out) {
         return 0;
     }
 
-    *allocated_count = 0;
-
     /* Prepare command arguments */
     unsigned long arg_count =
         1 + args->geo_args_count; /* key + (longitude, latitude, member) triplets */
-    *args_out     = (uintptr_t*)emalloc(arg_count * sizeof(uintptr_t));
-    *args_len_out = (unsigned long*)emalloc(arg_count * sizeof(unsigned long));
-
-    if (!(*args_out) || !(*args_len_out)) {
-        if (*args_out)
-            efree(*args_out);
-        if (*args_len_out)
-            efree(*args_len_out);
+
+    if (!arena_alloc_args(arena, arg_count, args_out, args_len_out)) {
         return 0;
     }
 
@@ -356,27 +310,16 @@ int prepare_geo_add_args(geo_command_args_t* args,
 
     /* Add arguments: lon, lat, member, lon, lat, member, ... */
     for (int i = 0; i < args->geo_args_count; i++) {
-        zval*  value     = &args->geo_args[i];
-        char*  str_val   = NULL;
-        size_t str_len   = 0;
-        int    need_free = 0;
-
-        str_val = zval_to_string_safe(value, &str_len, &need_free);
+        zval*  value   = &args->geo_args[i];
+        size_t str_len = 0;
+        char*  str_val = arena_zval_to_string(arena, value, &str_len);
 
         if (!str_val) {
-            /* Cleanup on error */
-            free_allocated_strings(*allocated_strings, *allocated_count);
-            efree(*args_out);
-            efree(*args_len_out);
             return 0;
         }
 
         (*args_out)[i + 1]     = (uintptr_t)str_val;
         (*args_len_out)[i + 1] = str_len;
-
-        if (need_free) {
-            (*allocated_strings)[(*allocated_count)++] = str_val;
-        }
     }
 
     return arg_count;
@@ -386,18 +329,14 @@ int prepare_geo_add_args(geo_command_args_t* args,
  * Prepare GEORADIUS/GEORADIUS_RO command arguments
  */
 int prepare_geo_radius_args(geo_command_args_t* args,
+                            arg_arena_t*        arena,
                             uintptr_t**         args_out,
-                            unsigned long**     args_len_out,
-                            char***             allocated_strings,
-                            int*                allocated_count) {
+                            unsigned long**     args_len_out) {
     /* Check if client and key are valid */
-    if (!args || !args->key || !args->unit || !args_out || !args_len_out || !allocated_strings ||
-        !allocated_count) {
+    if (!args || !args->key || !args->unit || !args_out || !args_len_out) {
         return 0;
     }
 
-    *allocated_count = 0;
-
     /* Count arguments - start with base parameters */
     unsigned long arg_count = 6; /* key + longitude + latitude + radius + unit */
 
@@ -416,50 +355,23 @@ int prepare_geo_radius_args(geo_command_args_t* args,
         arg_count++;
 
     /* Allocate argument arrays */
-    *args_out     = (uintptr_t*)emalloc(arg_count * sizeof(uintptr_t));
-    *args_len_out = (unsigned long*)emalloc(arg_count * sizeof(unsigned long));
-
-    if (!(*args_out) || !(*args_len_out)) {
-        if (*args_out)
-            efree(*args_out);
-        if (*args_len_out)
-            efree(*args_len_out);
+    if (!arena_alloc_args(arena, arg_count, args_out, args_len_out)) {
         return 0;
     }
 
     /* Convert numeric values to strings */
     size_t longitude_len = 0, latitude_len = 0, radius_len = 0, count_len = 0;
-    char*  longitude_str = double_to_string(args->longitude, &longitude_len);
-    char*  latitude_str  = double_to_string(args->latitude, &latitude_len);
-    char*  radius_str    = double_to_string(args->radius, &radius_len);
+    char*  longitude_str = arena_printf(arena, &longitude_len, "%.6g", args->longitude);
+    char*  latitude_str  = arena_printf(arena, &latitude_len, "%.6g", args->latitude);
+    char*  radius_str    = arena_printf(arena, &radius_len, "%.6g", args->radius);
     char*  count_str     = NULL;
 
     if (args->radius_opts.count > 0) {
-        count_str = long_to_string(args->radius_opts.count, &count_len);
-    }
-
-    if (!longitude_str || !latitude_str || !radius_str ||
-        (args->radius_opts.count > 0 && !count_str)) {
-        if (longitude_str)
-            efree(longitude_str);
-        if (latitude_str)
-            efree(latitude_str);
-        if (radius_str)
-            efree(radius_str);
-        if (count_str)
-            efree(count_str);
-
-        efree(*args_out);
-        efree(*args_len_out);
-        return 0;
+        count_str = arena_long_to_string(arena, args->radius_opts.count, &count_len);
     }
 
-    /* Track allocated strings */
-    (*allocated_strings)[(*allocated_count)++] = longitude_str;
-    (*allocated_strings)[(*allocated_count)++] = latitude_str;
-    (*allocated_strings)[(*allocated_count)++] = radius_str;
-    if (count_str) {
-        (*allocated_strings)[(*allocated_count)++] = count_str;
+    if (!longitude_str || !latitude_str || !radius_str) {
+        return 0;
     }
 
     /* Set up base arguments */
@@ -520,28 +432,19 @@ int prepare_geo_radius_args(geo_command_args_t* args,
  * Prepare GEOSEARCH command arguments
  */
 int prepare_geo_search_args(geo_command_args_t* args,
+                            arg_arena_t*        arena,
                             uintptr_t**         args_out,
-                            unsigned long**     args_len_out,
-                            char***             allocated_strings,
-                            int*                allocated_count) {
+                            unsigned long**     args_len_out) {
     /* Check if client is valid */
     if (!args || !args->key || !args->from || !args->by_radius || !args->unit || !args_out ||
-        !args_len_out || !allocated_strings || !allocated_count) {
+        !args_len_out) {
         return 0;
     }
 
-    *allocated_count = 0;
-
     /* Calculate the maximum arguments we might need */
     unsigned long max_args = 15; /* Conservative estimate */
-    *args_out              = (uintptr_t*)emalloc(max_args * sizeof(uintptr_t));
-    *args_len_out          = (unsigned long*)emalloc(max_args * sizeof(unsigned long));
-
-    if (!(*args_out) || !(*args_len_out)) {
-        if (*args_out)
-            efree(*args_out);
-        if (*args_len_out)
-            efree(*args_len_out);
+
+    if (!arena_alloc_args(arena, max_args, args_out, args_len_out)) {
         return 0;
     }
 
@@ -572,26 +475,19 @@ int prepare_geo_search_args(geo_command_args_t* args,
 
             /* Convert longitude and latitude to strings */
             size_t lon_str_len, lat_str_len;
-            char*  lon_str = double_to_string(zval_get_double(lon), &lon_str_len);
+            char*  lon_str = arena_printf(arena, &lon_str_len, "%.6g", zval_get_double(lon));
             if (!lon_str) {
-                efree(*args_out);
-                efree(*args_len_out);
                 return 0;
             }
-            (*args_out)[arg_idx]                       = (uintptr_t)lon_str;
-            (*args_len_out)[arg_idx++]                 = lon_str_len;
-            (*allocated_strings)[(*allocated_count)++] = lon_str;
+            (*args_out)[arg_idx]       = (uintptr_t)lon_str;
+            (*args_len_out)[arg_idx++] = lon_str_len;
 
-            char* lat_str = double_to_string(zval_get_double(lat), &lat_str_len);
+            char* lat_str = arena_printf(arena, &lat_str_len, "%.6g", zval_get_double(lat));
             if (!lat_str) {
-                free_allocated_strings(*allocated_strings, *allocated_count);
-                efree(*args_out);
-                efree(*args_len_out);
                 return 0;
             }
-            (*args_out)[arg_idx]                       = (uintptr_t)lat_str;
-            (*args_len_out)[arg_idx++]                 = lat_str_len;
-            (*allocated_strings)[(*allocated_count)++] = lat_str;
+            (*args_out)[arg_idx]       = (uintptr_t)lat_str;
+            (*args_len_out)[arg_idx++] = lat_str_len;
         }
     }
 
@@ -603,16 +499,12 @@ int prepare_geo_search_args(geo_command_args_t* args,
 
         /* Convert radius to string */
         size_t radius_str_len;
-        char*  radius_str = double_to_string(*args->by_radius, &radius_str_len);
+        char*  radius_str = arena_printf(arena, &radius_str_len, "%.6g", *args->by_radius);
         if (!radius_str) {
-            free_allocated_strings(*allocated_strings, *allocated_count);
-            efree(*args_out);
-            efree(*args_len_out);
             return 0;
         }
-        (*args_out)[arg_idx]                       = (uintptr_t)radius_str;
-        (*args_len_out)[arg_idx++]                 = radius_str_len;
-        (*allocated_strings)[(*allocated_count)++] = radius_str;
+        (*args_out)[arg_idx]       = (uintptr_t)radius_str;
+        (*args_len_out)[arg_idx++] = radius_str_len;
 
         (*args_out)[arg_idx]       = (uintptr_t)args->unit;
         (*args_len_out)[arg_idx++] = args->unit_len;
@@ -641,17 +533,10 @@ int prepare_geo_search_args(geo_command_args_t* args,
 
         /* Convert count to string */
         size_t count_str_len;
-        char*  count_str = long_to_string(args->radius_opts.count, &count_str_len);
-        if (!count_str) {
-            free_allocated_strings(*allocated_strings, *allocated_count);
-            efree(*args_out);
-            efree(*args_len_out);
-            return 0;
-        }
+        char*  count_str = arena_long_to_string(arena, args->radius_opts.count, &count_str_len);
 
-        (*args_out)[arg_idx]                       = (uintptr_t)count_str;
-        (*args_len_out)[arg_idx++]                 = count_str_len;
-        (*allocated_strings)[(*allocated_count)++] = count_str;
+        (*args_out)[arg_idx]       = (uintptr_t)count_str;
+        (*args_len_out)[arg_idx++] = count_str_len;
 
         /* Add ANY if specified */
         if (args->radius_opts.any) {
@@ -673,28 +558,19 @@ int prepare_geo_search_args(geo_command_args_t* args,
  * Prepare GEOSEARCHSTORE command arguments
  */
 int prepare_geo_search_store_args(geo_command_args_t* args,
+                                  arg_arena_t*        arena,
                                   uintptr_t**         args_out,
-                                  unsigned long**     args_len_out,
-                                  char***             allocated_strings,
-                                  int*                allocated_count) {
+                                  unsigned long**     args_len_out) {
     /* Check if client is valid */
     if (!args || !args->dest || !args->src || !args->from || !args->by_radius || !args->unit ||
-        !args_out || !args_len_out || !allocated_strings || !allocated_count) {
+        !args_out || !args_len_out) {
         return 0;
     }
 
-    *allocated_count = 0;
-
     /* Calculate the maximum arguments we might need */
     unsigned long max_args = 16; /* Conservative estimate */
-    *args_out              = (uintptr_t*)emalloc(max_args * sizeof(uintptr_t));
-    *args_len_out          = (unsigned long*)emalloc(max_args * sizeof(unsigned long));
-
-    if (!(*args_out) || !(*args_len_out)) {
-        if (*args_out)
-            efree(*args_out);
-        if (*args_len_out)
-            efree(*args_len_out);
+
+    if (!arena_alloc_args(arena, max_args, args_out, args_len_out)) {
         return 0;
     }
 
@@ -728,26 +604,19 @@ int prepare_geo_search_store_args(geo_command_args_t* args,
 
             /* Convert longitude and latitude to strings */
             size_t lon_str_len, lat_str_len;
-            char*  lon_str = double_to_string(zval_get_double(lon), &lon_str_len);
+            char*  lon_str = arena_printf(arena, &lon_str_len, "%.6g", zval_get_double(lon));
             if (!lon_str) {
-                efree(*args_out);
-                efree(*args_len_out);
                 return 0;
             }
-            (*args_out)[arg_idx]                       = (uintptr_t)lon_str;
-            (*args_len_out)[arg_idx++]                 = lon_str_len;
-            (*allocated_strings)[(*allocated_count)++] = lon_str;
+            (*args_out)[arg_idx]       = (uintptr_t)lon_str;
+            (*args_len_out)[arg_idx++] = lon_str_len;
 
-            char* lat_str = double_to_string(zval_get_double(lat), &lat_str_len);
+            char* lat_str = arena_printf(arena, &lat_str_len, "%.6g", zval_get_double(lat));
             if (!lat_str) {
-                free_allocated_strings(*allocated_strings, *allocated_count);
-                efree(*args_out);
-                efree(*args_len_out);
                 return 0;
             }
-            (*args_out)[arg_idx]                       = (uintptr_t)lat_str;
-            (*args_len_out)[arg_idx++]                 = lat_str_len;
-            (*allocated_strings)[(*allocated_count)++] = lat_str;
+            (*args_out)[arg_idx]       = (uintptr_t)lat_str;
+            (*args_len_out)[arg_idx++] = lat_str_len;
         }
     }
 
@@ -759,16 +628,12 @@ int prepare_geo_search_store_args(geo_command_args_t* args,
 
         /* Convert radius to string */
         size_t radius_str_len;
-        char*  radius_str = double_to_string(*args->by_radius, &radius_str_len);
+        char*  radius_str = arena_printf(arena, &radius_str_len, "%.6g", *args->by_radius);
         if (!radius_str) {
-            free_allocated_strings(*allocated_strings, *allocated_count);
-            efree(*args_out);
-            efree(*args_len_out);
             return 0;
         }
-        (*args_out)[arg_idx]                       = (uintptr_t)radius_str;
-        (*args_len_out)[arg_idx++]                 = radius_str_len;
-        (*allocated_strings)[(*allocated_count)++] = radius_str;
+        (*args_out)[arg_idx]       = (uintptr_t)radius_str;
+        (*args_len_out)[arg_idx++] = radius_str_len;
 
         (*args_out)[arg_idx]       = (uintptr_t)args->unit;
         (*args_len_out)[arg_idx++] = args->unit_len;
@@ -781,17 +646,10 @@ int prepare_geo_search_store_args(geo_command_args_t* args,
 
         /* Convert count to string */
         size_t count_str_len;
-        char*  count_str = long_to_string(args->radius_opts.count, &count_str_len);
-        if (!count_str) {
-            free_allocated_strings(*allocated_strings, *allocated_count);
-            efree(*args_out);
-            efree(*args_len_out);
-            return 0;
-        }
+        char*  count_str = arena_long_to_string(arena, args->radius_opts.count, &count_str_len);
 
-        (*args_out)[arg_idx]                       = (uintptr_t)count_str;
-        (*args_len_out)[arg_idx++]                 = count_str_len;
-        (*allocated_strings)[(*allocated_count)++] = count_str;
+        (*args_out)[arg_idx]       = (uintptr_t)count_str;
+        (*args_len_out)[arg_idx++] = count_str_len;
 
         /* Add ANY if specified */
         if (args->radius_opts.any) {
@@ -1232,79 +1090,49 @@ int execute_geo_generic_command(const void*            glide_client,
         return 0;
     }
 
-    uintptr_t*     arg_values        = NULL;
-    unsigned long* arg_lens          = NULL;
-    char**         allocated_strings = NULL;
-    int            allocated_count   = 0;
-    int            arg_count         = 0;
-    int            success           = 0;
+    uintptr_t*     arg_values = NULL;
+    unsigned long* arg_lens   = NULL;
+    int            arg_count  = 0;
+    int            success    = 0;
+    arg_arena_t    arena;
+
+    arena_init(&arena);
 
     /* Determine argument preparation method based on command type */
     switch (cmd_type) {
         case GeoAdd:
-            allocated_strings = (char**)emalloc(args->geo_args_count * sizeof(char*));
-            if (!allocated_strings) {
-                return 0;
-            }
-            arg_count = prepare_geo_add_args(
-                args, &arg_values, &arg_lens, &allocated_strings, &allocated_count);
+            arg_count = prepare_geo_add_args(args, &arena, &arg_values, &arg_lens);
             break;
 
         case GeoDist:
-            arg_count = prepare_geo_dist_args(args, &arg_values, &arg_lens);
+            arg_count = prepare_geo_dist_args(args, &arena, &arg_values, &arg_lens);
             break;
 
         case GeoHash:
         case GeoPos:
-            allocated_strings = (char**)emalloc(args->member_count * sizeof(char*));
-            if (!allocated_strings) {
-                return 0;
-            }
-            arg_count = prepare_geo_members_args(
-                args, &arg_values, &arg_lens, &allocated_strings, &allocated_count);
+            arg_count = prepare_geo_members_args(args, &arena, &arg_values, &arg_lens);
             break;
 
         case GeoRadius:
-            allocated_strings =
-                (char**)emalloc(10 * sizeof(char*)); /* Enough for typical options */
-            if (!allocated_strings) {
-                return 0;
-            }
-            arg_count = prepare_geo_radius_args(
-                args, &arg_values, &arg_lens, &allocated_strings, &allocated_count);
+            arg_count = prepare_geo_radius_args(args, &arena, &arg_values, &arg_lens);
             break;
 
         case GeoSearch:
-            allocated_strings = (char**)emalloc(10 * sizeof(char*));
-            if (!allocated_strings) {
-                return 0;
-            }
-            arg_count = prepare_geo_search_args(
-                args, &arg_values, &arg_lens, &allocated_strings, &allocated_count);
+            arg_count = prepare_geo_search_args(args, &arena, &arg_values, &arg_lens);
             break;
 
         case GeoSearchStore:
-            allocated_strings = (char**)emalloc(10 * sizeof(char*));
-            if (!allocated_strings) {
-                return 0;
-            }
-            arg_count = prepare_geo_search_store_args(
-                args, &arg_values, &arg_lens, &allocated_strings, &allocated_count);
+            arg_count = prepare_geo_search_store_args(args, &arena, &arg_values, &arg_lens);
             break;
 
         default:
             /* Unsupported command type */
-            return 0;
+            break;
     }
 
     /* Check if argument preparation was successful */
     if (arg_count <= 0) {
-        if (allocated_strings)
-            efree(allocated_strings);
-        if (arg_values)
-            efree(arg_values);
-        if (arg_lens)
-            efree(arg_lens);
+        arena_free(&arena);
         return 0;
     }
 
@@ -1316,19 +1144,8 @@ int execute_geo_generic_command(const void*            glide_client,
                                             arg_lens    /* argument lengths */
     );
 
-    /* Free allocated strings */
-    for (int i = 0; i < allocated_count; i++) {
-        if (allocated_strings[i]) {
-            efree(allocated_strings[i]);
-        }
-    }
-
-    if (allocated_strings)
-        efree(allocated_strings);
-    if (arg_values)
-        efree(arg_values);
-    if (arg_lens)
-        efree(arg_lens);
+    /* Free the arguments */
+    arena_free(&arena);
 
     /* Check if the command was successful */
     if (!result) {
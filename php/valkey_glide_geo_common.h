@@ -22,6 +22,7 @@
 #include <string.h>
 
 #include "command_response.h"
+#include "valkey_glide_arena.h"
 #include "valkey_glide_commands_common.h"
 
 /* ====================================================================
@@ -108,42 +109,39 @@ int parse_geo_radius_options(zval* options, geo_radius_options_t* opts);
 
 /* Argument preparation */
 int prepare_geo_key_args(geo_command_args_t* args,
+                         arg_arena_t*        arena,
                          uintptr_t**         args_out,
                          unsigned long**     args_len_out);
 
 int prepare_geo_members_args(geo_command_args_t* args,
+                             arg_arena_t*        arena,
                              uintptr_t**         args_out,
-                             unsigned long**     args_len_out,
-                             char***             allocated_strings,
-                             int*                allocated_count);
+                             unsigned long**     args_len_out);
 
 int prepare_geo_dist_args(geo_command_args_t* args,
+                          arg_arena_t*        arena,
                           uintptr_t**         args_out,
                           unsigned long**     args_len_out);
 
 int prepare_geo_add_args(geo_command_args_t* args,
+                         arg_arena_t*        arena,
                          uintptr_t**         args_out,
-                         unsigned long**     args_len_out,
-                         char***             allocated_strings,
-                         int*                allocated_count);
+                         unsigned long**     args_len_out);
 
 int prepare_geo_radius_args(geo_command_args_t* args,
+                            arg_arena_t*        arena,
                             uintptr_t**         args_out,
-                            unsigned long**     args_len_out,
-                            char***             allocated_strings,
-                            int*                allocated_count);
+                            unsigned long**     args_len_out);
 
 int prepare_geo_search_args(geo_command_args_t* args,
+                            arg_arena_t*        arena,
                             uintptr_t**         args_out,
-                            unsigned long**     args_len_out,
-                            char***             allocated_strings,
-                            int*                allocated_count);
+                            unsigned long**     args_len_out);
 
 int prepare_geo_search_store_args(geo_command_args_t* args,
+                                  arg_arena_t*        arena,
                                   uintptr_t**         args_out,
-                                  unsigned long**     args_len_out,
-                                  char***             allocated_strings,
-                                  int*                allocated_count);
+                                  unsigned long**     args_len_out);
 
 /* Result processing */
 int process_geo_int_result(CommandResult* result, void* output);
@@ -17,6 +17,8 @@
 #include "valkey_glide_hash_common.h"
 
 #include "common.h"
+#include "valkey_glide_near_cache.h"
+#include "valkey_glide_serializer.h"
 
 extern zend_class_entry* ce;
 extern zend_class_entry* get_valkey_glide_exception_ce();
@@ -32,62 +34,54 @@ int execute_h_generic_command(const void*          glide_client,
                               h_command_args_t*    args,
                               void*                result_ptr,
                               h_result_processor_t process_result) {
-    uintptr_t*     cmd_args          = NULL;
-    unsigned long* args_len          = NULL;
-    char**         allocated_strings = NULL;
-    int            allocated_count   = 0;
-    int            arg_count         = 0;
-    int            status            = 0;
+    uintptr_t*     cmd_args  = NULL;
+    unsigned long* args_len  = NULL;
+    int            arg_count = 0;
+    int            status    = 0;
+    arg_arena_t    arena;
 
     /* Validate basic arguments */
     VALIDATE_HASH_ARGS(glide_client, args->key);
 
+    arena_init(&arena);
+
     /* Prepare arguments based on command type */
     switch (cmd_type) {
         case HLen:
-            arg_count = prepare_h_key_only_args(
-                args, &cmd_args, &args_len, &allocated_strings, &allocated_count);
+            arg_count = prepare_h_key_only_args(args, &arena, &cmd_args, &args_len);
             break;
         case HGet:
         case HExists:
         case HStrlen:
-            arg_count = prepare_h_single_field_args(
-                args, &cmd_args, &args_len, &allocated_strings, &allocated_count);
+            arg_count = prepare_h_single_field_args(args, &arena, &cmd_args, &args_len);
             break;
         case HSetNX:
-            arg_count = prepare_h_field_value_args(
-                args, &cmd_args, &args_len, &allocated_strings, &allocated_count);
+            arg_count = prepare_h_field_value_args(args, &arena, &cmd_args, &args_len);
             break;
         case HDel:
         case HMGet:
-            arg_count = prepare_h_multi_field_args(
-                args, &cmd_args, &args_len, &allocated_strings, &allocated_count);
+            arg_count = prepare_h_multi_field_args(args, &arena, &cmd_args, &args_len);
             break;
         case HSet:
-            arg_count = prepare_h_set_args(
-                args, &cmd_args, &args_len, &allocated_strings, &allocated_count);
+            arg_count = prepare_h_set_args(args, &arena, &cmd_args, &args_len);
             break;
         case HMSet:
-            arg_count = prepare_h_mset_args(
-                args, &cmd_args, &args_len, &allocated_strings, &allocated_count);
+            arg_count = prepare_h_mset_args(args, &arena, &cmd_args, &args_len);
             break;
         case HIncrBy:
         case HIncrByFloat:
-            arg_count = prepare_h_incr_args(
-                args, &cmd_args, &args_len, &allocated_strings, &allocated_count);
+            arg_count = prepare_h_incr_args(args, &arena, &cmd_args, &args_len);
             break;
         case HRandField:
-            arg_count = prepare_h_randfield_args(
-                args, &cmd_args, &args_len, &allocated_strings, &allocated_count);
+            arg_count = prepare_h_randfield_args(args, &arena, &cmd_args, &args_len);
             break;
         case HKeys:
         case HVals:
         case HGetAll:
-            arg_count = prepare_h_key_only_args(
-                args, &cmd_args, &args_len, &allocated_strings, &allocated_count);
+            arg_count = prepare_h_key_only_args(args, &arena, &cmd_args, &args_len);
             break;
         default:
-            return 0;
+            goto cleanup;
     }
 
     if (arg_count <= 0) {
@@ -106,8 +100,7 @@ int execute_h_generic_command(const void*          glide_client,
     }
 
 cleanup:
-    /* Clean up allocated resources */
-    cleanup_h_command_args(allocated_strings, allocated_count, cmd_args, args_len);
+    arena_free(&arena);
     return status;
 }
 
@@ -119,50 +112,44 @@ int execute_h_simple_command(const void*       glide_client,
                              h_command_args_t* args,
                              void*             result_ptr,
                              int               response_type) {
-    uintptr_t*     cmd_args          = NULL;
-    unsigned long* args_len          = NULL;
-    char**         allocated_strings = NULL;
-    int            allocated_count   = 0;
-    int            arg_count         = 0;
-    int            status            = 0;
+    uintptr_t*     cmd_args  = NULL;
+    unsigned long* args_len  = NULL;
+    int            arg_count = 0;
+    int            status    = 0;
+    arg_arena_t    arena;
 
     /* Validate basic arguments */
     VALIDATE_HASH_ARGS(glide_client, args->key);
 
+    arena_init(&arena);
+
     /* Prepare arguments based on command type */
     switch (cmd_type) {
         case HLen:
         case HKeys:
         case HVals:
         case HGetAll:
-            arg_count = prepare_h_key_only_args(
-                args, &cmd_args, &args_len, &allocated_strings, &allocated_count);
+            arg_count = prepare_h_key_only_args(args, &arena, &cmd_args, &args_len);
             break;
         case HGet:
         case HExists:
         case HStrlen:
-            arg_count = prepare_h_single_field_args(
-                args, &cmd_args, &args_len, &allocated_strings, &allocated_count);
+            arg_count = prepare_h_single_field_args(args, &arena, &cmd_args, &args_len);
             break;
         case HSetNX:
-            arg_count = prepare_h_field_value_args(
-                args, &cmd_args, &args_len, &allocated_strings, &allocated_count);
+            arg_count = prepare_h_field_value_args(args, &arena, &cmd_args, &args_len);
             break;
         case HDel:
-            arg_count = prepare_h_multi_field_args(
-                args, &cmd_args, &args_len, &allocated_strings, &allocated_count);
+            arg_count = prepare_h_multi_field_args(args, &arena, &cmd_args, &args_len);
             break;
         case HSet:
-            arg_count = prepare_h_set_args(
-                args, &cmd_args, &args_len, &allocated_strings, &allocated_count);
+            arg_count = prepare_h_set_args(args, &arena, &cmd_args, &args_len);
             break;
         case HMSet:
-            arg_count = prepare_h_mset_args(
-                args, &cmd_args, &args_len, &allocated_strings, &allocated_count);
+            arg_count = prepare_h_mset_args(args, &arena, &cmd_args, &args_len);
             break;
         case HIncrBy:
-            arg_count = prepare_h_incr_args(
-                args, &cmd_args, &args_len, &allocated_strings, &allocated_count);
+            arg_count = prepare_h_incr_args(args, &arena, &cmd_args, &args_len);
             break;
         default:
             goto cleanup;
@@ -212,8 +199,7 @@ int execute_h_simple_command(const void*       glide_client,
     }
 
 cleanup:
-    /* Clean up allocated resources */
-    cleanup_h_command_args(allocated_strings, allocated_count, cmd_args, args_len);
+    arena_free(&arena);
     return status;
 }
 
@@ -225,21 +211,11 @@ cleanup:
  * Prepare arguments for single-key commands (HLEN, HKEYS, HVALS, HGETALL)
  */
 int prepare_h_key_only_args(h_command_args_t* args,
+                            arg_arena_t*      arena,
                             uintptr_t**       args_out,
-                            unsigned long**   args_len_out,
-                            char***           allocated_strings,
-                            int*              allocated_count) {
+                            unsigned long**   args_len_out) {
     /* Allocate argument arrays */
-    *args_out          = (uintptr_t*)emalloc(sizeof(uintptr_t));
-    *args_len_out      = (unsigned long*)emalloc(sizeof(unsigned long));
-    *allocated_strings = NULL;
-    *allocated_count   = 0;
-
-    if (!*args_out || !*args_len_out) {
-        if (*args_out)
-            efree(*args_out);
-        if (*args_len_out)
-            efree(*args_len_out);
+    if (!arena_alloc_args(arena, 1, args_out, args_len_out)) {
         return 0;
     }
 
@@ -254,25 +230,15 @@ int prepare_h_key_only_args(h_command_args_t* args,
  * Prepare arguments for single-field commands (HGET, HEXISTS, HSTRLEN)
  */
 int prepare_h_single_field_args(h_command_args_t* args,
+                                arg_arena_t*      arena,
                                 uintptr_t**       args_out,
-                                unsigned long**   args_len_out,
-                                char***           allocated_strings,
-                                int*              allocated_count) {
+                                unsigned long**   args_len_out) {
     if (!args->field) {
         return 0;
     }
 
     /* Allocate argument arrays */
-    *args_out          = (uintptr_t*)emalloc(2 * sizeof(uintptr_t));
-    *args_len_out      = (unsigned long*)emalloc(2 * sizeof(unsigned long));
-    *allocated_strings = NULL;
-    *allocated_count   = 0;
-
-    if (!*args_out || !*args_len_out) {
-        if (*args_out)
-            efree(*args_out);
-        if (*args_len_out)
-            efree(*args_len_out);
+    if (!arena_alloc_args(arena, 2, args_out, args_len_out)) {
         return 0;
     }
 
@@ -289,25 +255,21 @@ int prepare_h_single_field_args(h_command_args_t* args,
  * Prepare arguments for field-value commands (HSETNX)
  */
 int prepare_h_field_value_args(h_command_args_t* args,
+                               arg_arena_t*      arena,
                                uintptr_t**       args_out,
-                               unsigned long**   args_len_out,
-                               char***           allocated_strings,
-                               int*              allocated_count) {
+                               unsigned long**   args_len_out) {
     if (!args->field || !args->value) {
         return 0;
     }
 
     /* Allocate argument arrays */
-    *args_out          = (uintptr_t*)emalloc(3 * sizeof(uintptr_t));
-    *args_len_out      = (unsigned long*)emalloc(3 * sizeof(unsigned long));
-    *allocated_strings = NULL;
-    *allocated_count   = 0;
-
-    if (!*args_out || !*args_len_out) {
-        if (*args_out)
-            efree(*args_out);
-        if (*args_len_out)
-            efree(*args_len_out);
+    if (!arena_alloc_args(arena, 3, args_out, args_len_out)) {
+        return 0;
+    }
+
+    size_t value_len;
+    char*  value = valkey_glide_pack(args->serializer, arena, args->value, &value_len);
+    if (!value) {
         return 0;
     }
 
@@ -316,8 +278,8 @@ int prepare_h_field_value_args(h_command_args_t* args,
     (*args_len_out)[0] = args->key_len;
     (*args_out)[1]     = (uintptr_t)args->field;
     (*args_len_out)[1] = args->field_len;
-    (*args_out)[2]     = (uintptr_t)args->value;
-    (*args_len_out)[2] = args->value_len;
+    (*args_out)[2]     = (uintptr_t)value;
+    (*args_len_out)[2] = value_len;
 
     return 3;
 }
@@ -326,10 +288,9 @@ int prepare_h_field_value_args(h_command_args_t* args,
  * Prepare arguments for multi-field commands (HDEL, HMGET)
  */
 int prepare_h_multi_field_args(h_command_args_t* args,
+                               arg_arena_t*      arena,
                                uintptr_t**       args_out,
-                               unsigned long**   args_len_out,
-                               char***           allocated_strings,
-                               int*              allocated_count) {
+                               unsigned long**   args_len_out) {
     if (!args->fields || args->field_count <= 0) {
         return 0;
     }
@@ -338,18 +299,7 @@ int prepare_h_multi_field_args(h_command_args_t* args,
     unsigned long arg_count = 1 + args->field_count;
 
     /* Allocate argument arrays */
-    *args_out          = (uintptr_t*)emalloc(arg_count * sizeof(uintptr_t));
-    *args_len_out      = (unsigned long*)emalloc(arg_count * sizeof(unsigned long));
-    *allocated_strings = (char**)emalloc(args->field_count * sizeof(char*));
-    *allocated_count   = 0;
-
-    if (!*args_out || !*args_len_out || !*allocated_strings) {
-        if (*args_out)
-            efree(*args_out);
-        if (*args_len_out)
-            efree(*args_len_out);
-        if (*allocated_strings)
-            efree(*allocated_strings);
+    if (!arena_alloc_args(arena, arg_count, args_out, args_len_out)) {
         return 0;
     }
 
@@ -362,8 +312,7 @@ int prepare_h_multi_field_args(h_command_args_t* args,
                                       1,
                                       *args_out,
                                       *args_len_out,
-                                      *allocated_strings,
-                                      allocated_count,
+                                      arena,
                                       args->field_count);
 }
 
@@ -371,10 +320,9 @@ int prepare_h_multi_field_args(h_command_args_t* args,
  * Prepare arguments for HSET command (handles both formats)
  */
 int prepare_h_set_args(h_command_args_t* args,
+                       arg_arena_t*      arena,
                        uintptr_t**       args_out,
-                       unsigned long**   args_len_out,
-                       char***           allocated_strings,
-                       int*              allocated_count) {
+                       unsigned long**   args_len_out) {
     if (!args->field_values) {
         return 0;
     }
@@ -395,18 +343,7 @@ int prepare_h_set_args(h_command_args_t* args,
 
         /* Prepare command arguments: key + field-value pairs */
         unsigned long arg_count = 1 + (pairs_count * 2);
-        *args_out               = (uintptr_t*)emalloc(arg_count * sizeof(uintptr_t));
-        *args_len_out           = (unsigned long*)emalloc(arg_count * sizeof(unsigned long));
-        *allocated_strings      = (char**)emalloc((pairs_count * 2) * sizeof(char*));
-        *allocated_count        = 0;
-
-        if (!*args_out || !*args_len_out || !*allocated_strings) {
-            if (*args_out)
-                efree(*args_out);
-            if (*args_len_out)
-                efree(*args_len_out);
-            if (*allocated_strings)
-                efree(*allocated_strings);
+        if (!arena_alloc_args(arena, arg_count, args_out, args_len_out)) {
             return 0;
         }
 
@@ -416,7 +353,7 @@ int prepare_h_set_args(h_command_args_t* args,
 
         /* Process field-value pairs */
         return process_field_value_pairs(
-            z_array, *args_out, *args_len_out, 1, *allocated_strings, allocated_count);
+            z_array, *args_out, *args_len_out, 1, arena, args->serializer);
     } else {
         /* Original variadic usage */
         if (args->fv_count < 2 || args->fv_count % 2 != 0) {
@@ -425,18 +362,7 @@ int prepare_h_set_args(h_command_args_t* args,
 
         /* Prepare command arguments: key + field/value pairs */
         unsigned long arg_count = 1 + args->fv_count;
-        *args_out               = (uintptr_t*)emalloc(arg_count * sizeof(uintptr_t));
-        *args_len_out           = (unsigned long*)emalloc(arg_count * sizeof(unsigned long));
-        *allocated_strings      = (char**)emalloc(args->fv_count * sizeof(char*));
-        *allocated_count        = 0;
-
-        if (!*args_out || !*args_len_out || !*allocated_strings) {
-            if (*args_out)
-                efree(*args_out);
-            if (*args_len_out)
-                efree(*args_len_out);
-            if (*allocated_strings)
-                efree(*allocated_strings);
+        if (!arena_alloc_args(arena, arg_count, args_out, args_len_out)) {
             return 0;
         }
 
@@ -444,14 +370,19 @@ int prepare_h_set_args(h_command_args_t* args,
         (*args_out)[0]     = (uintptr_t)args->key;
         (*args_len_out)[0] = args->key_len;
 
-        /* Convert field/value pairs */
-        return convert_zval_array_to_args(args->field_values,
-                                          1,
-                                          *args_out,
-                                          *args_len_out,
-                                          *allocated_strings,
-                                          allocated_count,
-                                          args->fv_count);
+        /* Convert field/value pairs, packing the values */
+        for (int i = 0; i < args->fv_count; i++) {
+            size_t len;
+            char*  str = (i % 2) ? valkey_glide_pack(
+                                      args->serializer, arena, &args->field_values[i], &len)
+                                 : arena_zval_to_string(arena, &args->field_values[i], &len);
+            if (!str) {
+                return 0;
+            }
+            (*args_out)[1 + i]     = (uintptr_t)str;
+            (*args_len_out)[1 + i] = len;
+        }
+        return 1 + args->fv_count;
     }
 }
 
@@ -459,10 +390,9 @@ int prepare_h_set_args(h_command_args_t* args,
  * Prepare arguments for HMSET command
  */
 int prepare_h_mset_args(h_command_args_t* args,
+                        arg_arena_t*      arena,
                         uintptr_t**       args_out,
-                        unsigned long**   args_len_out,
-                        char***           allocated_strings,
-                        int*              allocated_count) {
+                        unsigned long**   args_len_out) {
     if (!args->field_values || args->fv_count <= 0) {
         return 0;
     }
@@ -472,18 +402,7 @@ int prepare_h_mset_args(h_command_args_t* args,
     int           pairs_count = zend_hash_num_elements(ht);
     unsigned long arg_count   = 1 + (pairs_count * 2);
 
-    *args_out          = (uintptr_t*)emalloc(arg_count * sizeof(uintptr_t));
-    *args_len_out      = (unsigned long*)emalloc(arg_count * sizeof(unsigned long));
-    *allocated_strings = (char**)emalloc((pairs_count * 2) * sizeof(char*));
-    *allocated_count   = 0;
-
-    if (!*args_out || !*args_len_out || !*allocated_strings) {
-        if (*args_out)
-            efree(*args_out);
-        if (*args_len_out)
-            efree(*args_len_out);
-        if (*allocated_strings)
-            efree(*allocated_strings);
+    if (!arena_alloc_args(arena, arg_count, args_out, args_len_out)) {
         return 0;
     }
 
@@ -493,34 +412,22 @@ int prepare_h_mset_args(h_command_args_t* args,
 
     /* Process field-value pairs */
     return process_field_value_pairs(
-        args->field_values, *args_out, *args_len_out, 1, *allocated_strings, allocated_count);
+        args->field_values, *args_out, *args_len_out, 1, arena, args->serializer);
 }
 
 /**
  * Prepare arguments for increment commands (HINCRBY, HINCRBYFLOAT)
  */
 int prepare_h_incr_args(h_command_args_t* args,
+                        arg_arena_t*      arena,
                         uintptr_t**       args_out,
-                        unsigned long**   args_len_out,
-                        char***           allocated_strings,
-                        int*              allocated_count) {
+                        unsigned long**   args_len_out) {
     if (!args->field) {
         return 0;
     }
 
     /* Allocate argument arrays */
-    *args_out          = (uintptr_t*)emalloc(3 * sizeof(uintptr_t));
-    *args_len_out      = (unsigned long*)emalloc(3 * sizeof(unsigned long));
-    *allocated_strings = (char**)emalloc(sizeof(char*));
-    *allocated_count   = 0;
-
-    if (!*args_out || !*args_len_out || !*allocated_strings) {
-        if (*args_out)
-            efree(*args_out);
-        if (*args_len_out)
-            efree(*args_len_out);
-        if (*allocated_strings)
-            efree(*allocated_strings);
+    if (!arena_alloc_args(arena, 3, args_out, args_len_out)) {
         return 0;
     }
 
@@ -536,22 +443,16 @@ int prepare_h_incr_args(h_command_args_t* args,
 
     if (args->float_incr != 0.0) {
         /* HINCRBYFLOAT */
-        incr_str = double_to_string(args->float_incr, &incr_len);
+        incr_str = arena_printf(arena, &incr_len, "%.6g", args->float_incr);
     } else {
         /* HINCRBY */
-        incr_str = long_to_string(args->increment, &incr_len);
+        incr_str = arena_long_to_string(arena, args->increment, &incr_len);
     }
 
     if (!incr_str) {
-        efree(*args_out);
-        efree(*args_len_out);
-        efree(*allocated_strings);
         return 0;
     }
 
-    (*allocated_strings)[0] = incr_str;
-    *allocated_count        = 1;
-
     (*args_out)[2]     = (uintptr_t)incr_str;
     (*args_len_out)[2] = incr_len;
 
@@ -562,10 +463,9 @@ int prepare_h_incr_args(h_command_args_t* args,
  * Prepare arguments for HRANDFIELD command
  */
 int prepare_h_randfield_args(h_command_args_t* args,
+                             arg_arena_t*      arena,
                              uintptr_t**       args_out,
-                             unsigned long**   args_len_out,
-                             char***           allocated_strings,
-                             int*              allocated_count) {
+                             unsigned long**   args_len_out) {
     /* Calculate argument count */
     unsigned long arg_count      = 1; /* key */
     int           need_count_str = 0;
@@ -582,18 +482,7 @@ int prepare_h_randfield_args(h_command_args_t* args,
         }
     }
 
-    *args_out          = (uintptr_t*)emalloc(arg_count * sizeof(uintptr_t));
-    *args_len_out      = (unsigned long*)emalloc(arg_count * sizeof(unsigned long));
-    *allocated_strings = need_count_str ? (char**)emalloc(sizeof(char*)) : NULL;
-    *allocated_count   = 0;
-
-    if (!*args_out || !*args_len_out || (need_count_str && !*allocated_strings)) {
-        if (*args_out)
-            efree(*args_out);
-        if (*args_len_out)
-            efree(*args_len_out);
-        if (*allocated_strings)
-            efree(*allocated_strings);
+    if (!arena_alloc_args(arena, arg_count, args_out, args_len_out)) {
         return 0;
     }
 
@@ -605,19 +494,11 @@ int prepare_h_randfield_args(h_command_args_t* args,
 
     /* Add count if needed */
     if (need_count_str) {
-        char* count_str = long_to_string(args->count, &(*args_len_out)[arg_idx]);
-        if (!count_str) {
-            efree(*args_out);
-            efree(*args_len_out);
-            if (*allocated_strings)
-                efree(*allocated_strings);
-            return 0;
-        }
-
-        (*allocated_strings)[0] = count_str;
-        *allocated_count        = 1;
+        size_t count_len;
+        char*  count_str = arena_long_to_string(arena, args->count, &count_len);
 
-        (*args_out)[arg_idx] = (uintptr_t)count_str;
+        (*args_out)[arg_idx]     = (uintptr_t)count_str;
+        (*args_len_out)[arg_idx] = count_len;
         arg_idx++;
     }
 
@@ -674,7 +555,10 @@ int process_h_mget_result(CommandResult* result, void* output) {
             struct CommandResponse* element = &result->response->array_value[i];
 
             if (element->response_type == String) {
-                ZVAL_STRINGL(&field_value, element->string_value, element->string_value_len);
+                valkey_glide_unpack(args->serializer,
+                                    element->string_value,
+                                    element->string_value_len,
+                                    &field_value);
             } else if (element->response_type == Null) {
                 ZVAL_FALSE(&field_value);
             } else {
@@ -824,19 +708,19 @@ int process_h_incrbyfloat_result(CommandResult* result, void* output) {
 }
 
 /**
- * Process results for HGETALL (convert flat array to associative)
+ * Process results for HGETALL (convert the field/value map to an associative array)
  */
 int process_h_getall_result(CommandResult* result, void* output) {
-    zval* return_value = (zval*)output;
+    h_command_args_t* args         = (h_command_args_t*)((void**)output)[0];
+    zval*             return_value = (zval*)((void**)output)[1];
 
     /* Check if the command was successful */
     if (!result || result->command_error) {
         return 0;
     }
 
-    /* Convert response to associative array */
-    return command_response_to_zval(
-        result->response, return_value, COMMAND_RESPONSE_ASSOSIATIVE_ARRAY_MAP, false);
+    /* Fill the associative array directly, unpacking and releasing the reply as it goes */
+    return command_response_consume_pairs(result->response, return_value, args->serializer);
 }
 
 /* ====================================================================
@@ -850,17 +734,15 @@ int convert_zval_array_to_args(zval*          z_array,
                                int            start_index,
                                uintptr_t*     args,
                                unsigned long* args_len,
-                               char**         allocated_strings,
-                               int*           allocated_count,
-                               int            max_allocations) {
+                               arg_arena_t*   arena,
+                               int            count) {
     int current_arg = start_index;
 
-    for (int i = 0; i < max_allocations; i++) {
+    for (int i = 0; i < count; i++) {
         zval*  value = &z_array[i];
         size_t str_len;
-        int    need_free;
 
-        char* str_val = zval_to_string_safe(value, &str_len, &need_free);
+        char* str_val = arena_zval_to_string(arena, value, &str_len);
         if (!str_val) {
             return 0;
         }
@@ -868,11 +750,6 @@ int convert_zval_array_to_args(zval*          z_array,
         args[current_arg]     = (uintptr_t)str_val;
         args_len[current_arg] = str_len;
 
-        if (need_free) {
-            allocated_strings[*allocated_count] = str_val;
-            (*allocated_count)++;
-        }
-
         current_arg++;
     }
 
@@ -882,12 +759,12 @@ int convert_zval_array_to_args(zval*          z_array,
 /**
  * Process field-value pairs from associative array
  */
-int process_field_value_pairs(zval*          field_values,
-                              uintptr_t*     args,
-                              unsigned long* args_len,
-                              int            start_index,
-                              char**         allocated_strings,
-                              int*           allocated_count) {
+int process_field_value_pairs(zval*                            field_values,
+                              uintptr_t*                       args,
+                              unsigned long*                   args_len,
+                              int                              start_index,
+                              arg_arena_t*                     arena,
+                              const valkey_glide_serializer_t* serializer) {
     HashTable*   ht = Z_ARRVAL_P(field_values);
     zval*        data;
     zend_string* hash_key;
@@ -902,58 +779,42 @@ int process_field_value_pairs(zval*          field_values,
             args_len[arg_idx] = ZSTR_LEN(hash_key);
         } else {
             /* Numeric index - convert to string */
-            char* field_str = long_to_string(num_idx, &args_len[arg_idx]);
-            if (!field_str) {
-                return 0;
-            }
-            args[arg_idx]                       = (uintptr_t)field_str;
-            allocated_strings[*allocated_count] = field_str;
-            (*allocated_count)++;
+            size_t field_len;
+            char*  field_str = arena_long_to_string(arena, num_idx, &field_len);
+
+            args[arg_idx]     = (uintptr_t)field_str;
+            args_len[arg_idx] = field_len;
         }
         arg_idx++;
 
         /* Add value with enhanced type handling */
-        size_t str_len;
-        int    need_free;
-        char*  str_val = NULL;
+        size_t      str_len;
+        const char* str_val = NULL;
+
+        /* Serialized values keep their type */
+        if (serializer) {
+            str_val = valkey_glide_pack(serializer, arena, data, &str_len);
+            if (!str_val) {
+                return 0;
+            }
+            args[arg_idx]     = (uintptr_t)str_val;
+            args_len[arg_idx] = str_len;
+            arg_idx++;
+            continue;
+        }
 
         /* Handle different zval types appropriately */
         switch (Z_TYPE_P(data)) {
             case IS_NULL:
                 /* Convert NULL to empty string */
-                str_val   = estrdup("");
-                str_len   = 0;
-                need_free = 1;
-                break;
-
-            case IS_FALSE:
-                /* Convert false to "0" */
-                str_val   = estrdup("0");
-                str_len   = 1;
-                need_free = 1;
-                break;
-
-            case IS_TRUE:
-                /* Convert true to "1" */
-                str_val   = estrdup("1");
-                str_len   = 1;
-                need_free = 1;
+                str_val = "";
+                str_len = 0;
                 break;
 
             case IS_ARRAY:
-                /* Convert array to JSON representation */
-                {
-                    smart_str json_str = {0};
-
-                    {
-                        /* Fallback to "Array" if JSON encoding fails */
-                        str_val   = estrdup("Array");
-                        str_len   = 5;
-                        need_free = 1;
-                        if (json_str.s)
-                            smart_str_free(&json_str);
-                    }
-                }
+                /* Arrays are sent as "Array", as PHP would print them */
+                str_val = "Array";
+                str_len = 5;
                 break;
 
             case IS_OBJECT:
@@ -961,54 +822,44 @@ int process_field_value_pairs(zval*          field_values,
                 if (Z_OBJ_HT_P(data)->cast_object) {
                     zval tmp;
                     if (Z_OBJ_HT_P(data)->cast_object(Z_OBJ_P(data), &tmp, IS_STRING) == SUCCESS) {
-                        str_val   = estrndup(Z_STRVAL(tmp), Z_STRLEN(tmp));
-                        str_len   = Z_STRLEN(tmp);
-                        need_free = 1;
+                        str_val = arena_strndup(arena, Z_STRVAL(tmp), Z_STRLEN(tmp));
+                        str_len = Z_STRLEN(tmp);
                         zval_ptr_dtor(&tmp);
                     } else {
                         /* Fallback to object class name */
                         zend_string* class_name = Z_OBJCE_P(data)->name;
-                        str_val   = estrndup(ZSTR_VAL(class_name), ZSTR_LEN(class_name));
-                        str_len   = ZSTR_LEN(class_name);
-                        need_free = 1;
+                        str_val                 = ZSTR_VAL(class_name);
+                        str_len                 = ZSTR_LEN(class_name);
                     }
                 } else {
                     /* No cast_object handler, use class name */
                     zend_string* class_name = Z_OBJCE_P(data)->name;
-                    str_val                 = estrndup(ZSTR_VAL(class_name), ZSTR_LEN(class_name));
+                    str_val                 = ZSTR_VAL(class_name);
                     str_len                 = ZSTR_LEN(class_name);
-                    need_free               = 1;
                 }
                 break;
 
             case IS_RESOURCE:
                 /* Convert resource to string representation */
-                str_val   = estrdup("Resource");
-                str_len   = 8;
-                need_free = 1;
+                str_val = "Resource";
+                str_len = 8;
                 break;
 
             default:
-                /* Use standard conversion for strings, numbers, etc. */
-                str_val = zval_to_string_safe(data, &str_len, &need_free);
+                /* Use standard conversion for strings, numbers, booleans, etc. */
+                str_val = arena_zval_to_string(arena, data, &str_len);
                 break;
         }
 
         if (!str_val) {
             /* Final fallback - should not happen with above handling */
-            str_val   = estrdup("unknown");
-            str_len   = 7;
-            need_free = 1;
+            str_val = "unknown";
+            str_len = 7;
         }
 
         args[arg_idx]     = (uintptr_t)str_val;
         args_len[arg_idx] = str_len;
 
-        if (need_free) {
-            allocated_strings[*allocated_count] = str_val;
-            (*allocated_count)++;
-        }
-
         arg_idx++;
     }
     ZEND_HASH_FOREACH_END();
@@ -1016,32 +867,6 @@ int process_field_value_pairs(zval*          field_values,
     return arg_idx;
 }
 
-/**
- * Safe cleanup for allocated argument strings
- */
-void cleanup_h_command_args(char**         allocated_strings,
-                            int            allocated_count,
-                            uintptr_t*     args,
-                            unsigned long* args_len) {
-    /* Free allocated strings */
-    if (allocated_strings) {
-        for (int i = 0; i < allocated_count; i++) {
-            if (allocated_strings[i]) {
-                efree(allocated_strings[i]);
-            }
-        }
-        efree(allocated_strings);
-    }
-
-    /* Free argument arrays */
-    if (args) {
-        efree(args);
-    }
-    if (args_len) {
-        efree(args_len);
-    }
-}
-
 /* ====================================================================
  * HASH COMMAND EXECUTION FUNCTIONS
  * ==================================================================== */
@@ -1123,15 +948,17 @@ int execute_h_del_command(const void* glide_client,
 /**
  * Execute HSET command using the framework
  */
-int execute_h_set_command(const void* glide_client,
-                          const char* key,
-                          size_t      key_len,
-                          zval*       z_args,
-                          int         argc,
-                          long*       output_value,
-                          int         is_array_arg) {
+int execute_h_set_command(const void*                      glide_client,
+                          const valkey_glide_serializer_t* serializer,
+                          const char*                      key,
+                          size_t                           key_len,
+                          zval*                            z_args,
+                          int                              argc,
+                          long*                            output_value,
+                          int                              is_array_arg) {
     h_command_args_t args = {0};
     args.glide_client     = glide_client;
+    args.serializer       = serializer;
     args.key              = key;
     args.key_len          = key_len;
     args.field_values     = z_args;
@@ -1144,22 +971,22 @@ int execute_h_set_command(const void* glide_client,
 /**
  * Execute HSETNX command using the framework
  */
-int execute_h_setnx_command(const void* glide_client,
-                            const char* key,
-                            size_t      key_len,
-                            char*       field,
-                            size_t      field_len,
-                            char*       value,
-                            size_t      value_len,
-                            int*        output_value) {
+int execute_h_setnx_command(const void*                      glide_client,
+                            const valkey_glide_serializer_t* serializer,
+                            const char*                      key,
+                            size_t                           key_len,
+                            char*                            field,
+                            size_t                           field_len,
+                            zval*                            value,
+                            int*                             output_value) {
     h_command_args_t args = {0};
     args.glide_client     = glide_client;
+    args.serializer       = serializer;
     args.key              = key;
     args.key_len          = key_len;
     args.field            = field;
     args.field_len        = field_len;
     args.value            = value;
-    args.value_len        = value_len;
 
     return execute_h_simple_command(glide_client, HSetNX, &args, output_value, H_RESPONSE_BOOL);
 }
@@ -1167,10 +994,15 @@ int execute_h_setnx_command(const void* glide_client,
 /**
  * Execute HMSET command using the framework
  */
-int execute_h_mset_command(
-    const void* glide_client, const char* key, size_t key_len, zval* keyvals, int keyvals_count) {
+int execute_h_mset_command(const void*                      glide_client,
+                           const valkey_glide_serializer_t* serializer,
+                           const char*                      key,
+                           size_t                           key_len,
+                           zval*                            keyvals,
+                           int                              keyvals_count) {
     h_command_args_t args = {0};
     args.glide_client     = glide_client;
+    args.serializer       = serializer;
     args.key              = key;
     args.key_len          = key_len;
     args.field_values     = keyvals;
@@ -1225,14 +1057,16 @@ int execute_h_incrbyfloat_command(const void* glide_client,
 /**
  * Execute HMGET command using the framework
  */
-int execute_h_mget_command(const void* glide_client,
-                           const char* key,
-                           size_t      key_len,
-                           zval*       fields,
-                           int         fields_count,
-                           zval*       return_value) {
+int execute_h_mget_command(const void*                      glide_client,
+                           const valkey_glide_serializer_t* serializer,
+                           const char*                      key,
+                           size_t                           key_len,
+                           zval*                            fields,
+                           int                              fields_count,
+                           zval*                            return_value) {
     h_command_args_t args = {0};
     args.glide_client     = glide_client;
+    args.serializer       = serializer;
     args.key              = key;
     args.key_len          = key_len;
     args.fields           = fields;
@@ -1275,17 +1109,19 @@ int execute_h_vals_command(const void* glide_client,
 /**
  * Execute HGETALL command using the framework
  */
-int execute_h_getall_command(const void* glide_client,
-                             const char* key,
-                             size_t      key_len,
-                             zval*       return_value) {
+int execute_h_getall_command(const void*                      glide_client,
+                             const valkey_glide_serializer_t* serializer,
+                             const char*                      key,
+                             size_t                           key_len,
+                             zval*                            return_value) {
     h_command_args_t args = {0};
     args.glide_client     = glide_client;
+    args.serializer       = serializer;
     args.key              = key;
     args.key_len          = key_len;
 
-    return execute_h_generic_command(
-        glide_client, HGetAll, &args, return_value, process_h_getall_result);
+    void* output[2] = {&args, return_value};
+    return execute_h_generic_command(glide_client, HGetAll, &args, output, process_h_getall_result);
 }
 
 /**
@@ -1352,13 +1188,35 @@ int execute_hget_command(zval* object, int argc, zval* return_value, zend_class_
         return 0;
     }
 
+    /* Serve the read from the near cache, filling it on a miss */
+    uint64_t fill_token = 0;
+    if (valkey_glide->near_cache) {
+        if (valkey_glide_near_cache_get_string(
+                valkey_glide->near_cache, HGet, key, key_len, field, field_len, return_value)) {
+            valkey_glide_unpack_zval(valkey_glide->serializer, return_value);
+            return 1;
+        }
+        fill_token = valkey_glide_near_cache_begin_fill(valkey_glide->near_cache);
+    }
+
     /* Execute the HGET command */
     int result = execute_h_get_command(
         valkey_glide->glide_client, key, key_len, field, field_len, &response, &response_len);
 
     /* Process the result */
     if (result == 1 && response != NULL) {
-        ZVAL_STRINGL(return_value, response, response_len);
+        if (valkey_glide->near_cache) {
+            valkey_glide_near_cache_put_string(valkey_glide->near_cache,
+                                               HGet,
+                                               key,
+                                               key_len,
+                                               field,
+                                               field_len,
+                                               response,
+                                               response_len,
+                                               fill_token);
+        }
+        valkey_glide_unpack(valkey_glide->serializer, response, response_len, return_value);
         efree(response);
         return 1;
     } else if (result == 0) {
@@ -1493,6 +1351,7 @@ int execute_hset_command(zval* object, int argc, zval* return_value, zend_class_
 
     /* Execute the HSET command */
     if (execute_h_set_command(valkey_glide->glide_client,
+                              valkey_glide->serializer,
                               key,
                               key_len,
                               z_args,
@@ -1511,22 +1370,15 @@ int execute_hset_command(zval* object, int argc, zval* return_value, zend_class_
  */
 int execute_hsetnx_command(zval* object, int argc, zval* return_value, zend_class_entry* ce) {
     valkey_glide_object* valkey_glide;
-    char *               key = NULL, *field = NULL, *val = NULL;
-    size_t               key_len, field_len, val_len;
+    char *               key = NULL, *field = NULL;
+    size_t               key_len, field_len;
+    zval*                z_value;
     int                  result;
 
     /* Parse parameters */
-    if (zend_parse_method_parameters(argc,
-                                     object,
-                                     "Osss",
-                                     &object,
-                                     ce,
-                                     &key,
-                                     &key_len,
-                                     &field,
-                                     &field_len,
-                                     &val,
-                                     &val_len) == FAILURE) {
+    if (zend_parse_method_parameters(
+            argc, object, "Ossz", &object, ce, &key, &key_len, &field, &field_len, &z_value) ==
+        FAILURE) {
         return 0;
     }
 
@@ -1535,10 +1387,19 @@ int execute_hsetnx_command(zval* object, int argc, zval* return_value, zend_clas
     if (!valkey_glide || !valkey_glide->glide_client) {
         return 0;
     }
+    if (!valkey_glide->serializer && Z_TYPE_P(z_value) > IS_STRING) {
+        return 0;
+    }
 
     /* Execute the HSETNX command */
-    if (execute_h_setnx_command(
-            valkey_glide->glide_client, key, key_len, field, field_len, val, val_len, &result)) {
+    if (execute_h_setnx_command(valkey_glide->glide_client,
+                                valkey_glide->serializer,
+                                key,
+                                key_len,
+                                field,
+                                field_len,
+                                z_value,
+                                &result)) {
         ZVAL_BOOL(return_value, result == 1);
         return 1;
     }
@@ -1573,8 +1434,12 @@ int execute_hmset_command(zval* object, int argc, zval* return_value, zend_class
     int keyvals_count = zend_hash_num_elements(keyvals_hash) * 2;
 
     if (keyvals_count > 0) {
-        if (execute_h_mset_command(
-                valkey_glide->glide_client, key, key_len, arr_keyvals, keyvals_count)) {
+        if (execute_h_mset_command(valkey_glide->glide_client,
+                                   valkey_glide->serializer,
+                                   key,
+                                   key_len,
+                                   arr_keyvals,
+                                   keyvals_count)) {
             ZVAL_TRUE(return_value);
             return 1;
         }
@@ -1725,8 +1590,13 @@ int execute_hmget_command(zval* object, int argc, zval* return_value, zend_class
     array_init(return_value);
 
     /* Execute the HMGET command */
-    int result = execute_h_mget_command(
-        valkey_glide->glide_client, key, key_len, field_array, i, return_value);
+    int result = execute_h_mget_command(valkey_glide->glide_client,
+                                        valkey_glide->serializer,
+                                        key,
+                                        key_len,
+                                        field_array,
+                                        i,
+                                        return_value);
 
     /* Free field array */
     for (int j = 0; j < i; j++) {
@@ -1786,7 +1656,11 @@ int execute_hvals_command(zval* object, int argc, zval* return_value, zend_class
     array_init(return_value);
 
     /* Execute the HVALS command */
-    return execute_h_vals_command(valkey_glide->glide_client, key, key_len, return_value);
+    if (!execute_h_vals_command(valkey_glide->glide_client, key, key_len, return_value)) {
+        return 0;
+    }
+    valkey_glide_unpack_zval(valkey_glide->serializer, return_value);
+    return 1;
 }
 
 /**
@@ -1808,11 +1682,29 @@ int execute_hgetall_command(zval* object, int argc, zval* return_value, zend_cla
         return 0;
     }
 
-    /* Initialize return array */
-    array_init(return_value);
+    /* Serve the read from the near cache, filling it on a miss */
+    uint64_t fill_token = 0;
+    if (valkey_glide->near_cache) {
+        if (valkey_glide_near_cache_get_hash(valkey_glide->near_cache, key, key_len, return_value)) {
+            valkey_glide_unpack_zval(valkey_glide->serializer, return_value);
+            return 1;
+        }
+        fill_token = valkey_glide_near_cache_begin_fill(valkey_glide->near_cache);
+    }
 
-    /* Execute the HGETALL command */
-    return execute_h_getall_command(valkey_glide->glide_client, key, key_len, return_value);
+    /* Execute the HGETALL command, which initializes the return array. The near cache keeps the
+     * values as they are stored, so they are only unpacked once cached */
+    if (!valkey_glide->near_cache) {
+        return execute_h_getall_command(
+            valkey_glide->glide_client, valkey_glide->serializer, key, key_len, return_value);
+    }
+    if (!execute_h_getall_command(valkey_glide->glide_client, NULL, key, key_len, return_value)) {
+        return 0;
+    }
+    valkey_glide_near_cache_put_hash(
+        valkey_glide->near_cache, key, key_len, return_value, fill_token);
+    valkey_glide_unpack_zval(valkey_glide->serializer, return_value);
+    return 1;
 }
 
 /**
@@ -23,6 +23,7 @@
 
 #include "command_response.h"
 #include "include/glide_bindings.h"
+#include "valkey_glide_arena.h"
 #include "valkey_glide_commands_common.h"
 
 /* ====================================================================
@@ -38,11 +39,13 @@ typedef struct _h_command_args_t {
     const char* key;          /* Hash key */
     size_t      key_len;      /* Hash key length */
 
+    /* Packs field values on writes and unpacks them on HMGET, NULL to leave them as they are */
+    const valkey_glide_serializer_t* serializer;
+
     /* Single field operations (HGET, HEXISTS, HSTRLEN, HSETNX) */
     char*  field;     /* Field name */
     size_t field_len; /* Field name length */
-    char*  value;     /* Field value */
-    size_t value_len; /* Field value length */
+    zval*  value;     /* Field value */
 
     /* Multi-field operations (HDEL, HMGET, HKEYS, HVALS) */
     zval* fields;      /* Array of field names */
@@ -106,73 +109,65 @@ int execute_h_simple_command(const void*       glide_client,
  * Prepare arguments for single-key commands (HLEN)
  */
 int prepare_h_key_only_args(h_command_args_t* args,
+                            arg_arena_t*      arena,
                             uintptr_t**       args_out,
-                            unsigned long**   args_len_out,
-                            char***           allocated_strings,
-                            int*              allocated_count);
+                            unsigned long**   args_len_out);
 
 /**
  * Prepare arguments for single-field commands (HGET, HEXISTS, HSTRLEN)
  */
 int prepare_h_single_field_args(h_command_args_t* args,
+                                arg_arena_t*      arena,
                                 uintptr_t**       args_out,
-                                unsigned long**   args_len_out,
-                                char***           allocated_strings,
-                                int*              allocated_count);
+                                unsigned long**   args_len_out);
 
 /**
  * Prepare arguments for field-value commands (HSETNX)
  */
 int prepare_h_field_value_args(h_command_args_t* args,
+                               arg_arena_t*      arena,
                                uintptr_t**       args_out,
-                               unsigned long**   args_len_out,
-                               char***           allocated_strings,
-                               int*              allocated_count);
+                               unsigned long**   args_len_out);
 
 /**
  * Prepare arguments for multi-field commands (HDEL, HMGET)
  */
 int prepare_h_multi_field_args(h_command_args_t* args,
+                               arg_arena_t*      arena,
                                uintptr_t**       args_out,
-                               unsigned long**   args_len_out,
-                               char***           allocated_strings,
-                               int*              allocated_count);
+                               unsigned long**   args_len_out);
 
 /**
  * Prepare arguments for HSET command (handles both formats)
  */
 int prepare_h_set_args(h_command_args_t* args,
+                       arg_arena_t*      arena,
                        uintptr_t**       args_out,
-                       unsigned long**   args_len_out,
-                       char***           allocated_strings,
-                       int*              allocated_count);
+                       unsigned long**   args_len_out);
 
 /**
  * Prepare arguments for HMSET command
  */
 int prepare_h_mset_args(h_command_args_t* args,
+                        arg_arena_t*      arena,
                         uintptr_t**       args_out,
-                        unsigned long**   args_len_out,
-                        char***           allocated_strings,
-                        int*              allocated_count);
+                        unsigned long**   args_len_out);
 
 /**
  * Prepare arguments for increment commands (HINCRBY, HINCRBYFLOAT)
  */
 int prepare_h_incr_args(h_command_args_t* args,
+                        arg_arena_t*      arena,
                         uintptr_t**       args_out,
-                        unsigned long**   args_len_out,
-                        char***           allocated_strings,
-                        int*              allocated_count);
+                        unsigned long**   args_len_out);
 
 /**
  * Prepare arguments for HRANDFIELD command
  */
 int prepare_h_randfield_args(h_command_args_t* args,
+                             arg_arena_t*      arena,
                              uintptr_t**       args_out,
-                             unsigned long**   args_len_out,
-                             char***           allocated_strings,
-                             int*              allocated_count);
+                             unsigned long**   args_len_out);
 
 /* ====================================================================
  * RESULT PROCESSING FUNCTIONS
@@ -204,27 +199,18 @@ int convert_zval_array_to_args(zval*          z_array,
                                int            start_index,
                                uintptr_t*     args,
                                unsigned long* args_len,
-                               char**         allocated_strings,
-                               int*           allocated_count,
-                               int            max_allocations);
+                               arg_arena_t*   arena,
+                               int            count);
 
 /**
  * Process field-value pairs from associative array
  */
-int process_field_value_pairs(zval*          field_values,
-                              uintptr_t*     args,
-                              unsigned long* args_len,
-                              int            start_index,
-                              char**         allocated_strings,
-                              int*           allocated_count);
-
-/**
- * Safe cleanup for allocated argument strings
- */
-void cleanup_h_command_args(char**         allocated_strings,
-                            int            allocated_count,
-                            uintptr_t*     args,
-                            unsigned long* args_len);
+int process_field_value_pairs(zval*                            field_values,
+                              uintptr_t*                       args,
+                              unsigned long*                   args_len,
+                              int                              start_index,
+                              arg_arena_t*                     arena,
+                              const valkey_glide_serializer_t* serializer);
 
 /* ====================================================================
  * RESPONSE TYPE CONSTANTS
@@ -287,25 +273,30 @@ int execute_h_del_command(const void* glide_client,
                           int         fields_count,
                           long*       output_value);
 
-int execute_h_set_command(const void* glide_client,
-                          const char* key,
-                          size_t      key_len,
-                          zval*       z_args,
-                          int         argc,
-                          long*       output_value,
-                          int         is_array_arg);
-
-int execute_h_setnx_command(const void* glide_client,
-                            const char* key,
-                            size_t      key_len,
-                            char*       field,
-                            size_t      field_len,
-                            char*       value,
-                            size_t      value_len,
-                            int*        output_value);
-
-int execute_h_mset_command(
-    const void* glide_client, const char* key, size_t key_len, zval* keyvals, int keyvals_count);
+int execute_h_set_command(const void*                      glide_client,
+                          const valkey_glide_serializer_t* serializer,
+                          const char*                      key,
+                          size_t                           key_len,
+                          zval*                            z_args,
+                          int                              argc,
+                          long*                            output_value,
+                          int                              is_array_arg);
+
+int execute_h_setnx_command(const void*                      glide_client,
+                            const valkey_glide_serializer_t* serializer,
+                            const char*                      key,
+                            size_t                           key_len,
+                            char*                            field,
+                            size_t                           field_len,
+                            zval*                            value,
+                            int*                             output_value);
+
+int execute_h_mset_command(const void*                      glide_client,
+                           const valkey_glide_serializer_t* serializer,
+                           const char*                      key,
+                           size_t                           key_len,
+                           zval*                            keyvals,
+                           int                              keyvals_count);
 
 int execute_h_incrby_command(const void* glide_client,
                              const char* key,
@@ -323,12 +314,13 @@ int execute_h_incrbyfloat_command(const void* glide_client,
                                   double      increment,
                                   double*     output_value);
 
-int execute_h_mget_command(const void* glide_client,
-                           const char* key,
-                           size_t      key_len,
-                           zval*       fields,
-                           int         fields_count,
-                           zval*       return_value);
+int execute_h_mget_command(const void*                      glide_client,
+                           const valkey_glide_serializer_t* serializer,
+                           const char*                      key,
+                           size_t                           key_len,
+                           zval*                            fields,
+                           int                              fields_count,
+                           zval*                            return_value);
 
 int execute_h_keys_command(const void* glide_client,
                            const char* key,
@@ -340,10 +332,11 @@ int execute_h_vals_command(const void* glide_client,
                            size_t      key_len,
                            zval*       return_value);
 
-int execute_h_getall_command(const void* glide_client,
-                             const char* key,
-                             size_t      key_len,
-                             zval*       return_value);
+int execute_h_getall_command(const void*                      glide_client,
+                             const valkey_glide_serializer_t* serializer,
+                             const char*                      key,
+                             size_t                           key_len,
+                             zval*                            return_value);
 
 int execute_h_strlen_command(const void* glide_client,
                              const char* key,
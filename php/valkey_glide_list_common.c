@@ -23,34 +23,6 @@ extern zend_class_entry* get_valkey_glide_exception_ce();
  * UTILITY FUNCTIONS
  * ==================================================================== */
 
-/**
- * Allocate command arguments arrays
- */
-int allocate_list_command_args(int count, uintptr_t** args_out, unsigned long** args_len_out) {
-    *args_out     = (uintptr_t*)emalloc(count * sizeof(uintptr_t));
-    *args_len_out = (unsigned long*)emalloc(count * sizeof(unsigned long));
-
-    if (!*args_out || !*args_len_out) {
-        if (*args_out)
-            efree(*args_out);
-        if (*args_len_out)
-            efree(*args_len_out);
-        return 0;
-    }
-
-    return 1;
-}
-
-/**
- * Free command arguments arrays
- */
-void free_list_command_args(uintptr_t* args, unsigned long* args_len) {
-    if (args)
-        efree(args);
-    if (args_len)
-        efree(args_len);
-}
-
 /**
  * Process a blocking result from a command
  */
@@ -86,70 +58,61 @@ int execute_list_generic_command(const void*             glide_client,
                                  list_command_args_t*    args,
                                  void*                   result_ptr,
                                  list_result_processor_t process_result) {
-    uintptr_t*     cmd_args          = NULL;
-    unsigned long* args_len          = NULL;
-    char**         allocated_strings = NULL;
-    int            allocated_count   = 0;
-    int            arg_count         = 0;
-    int            status            = 0;
+    uintptr_t*     cmd_args  = NULL;
+    unsigned long* args_len  = NULL;
+    int            arg_count = 0;
+    int            status    = 0;
+    arg_arena_t    arena;
+
+    arena_init(&arena);
 
     /* Prepare arguments based on command type */
     switch (cmd_type) {
         case LLen:
-            arg_count = prepare_list_key_only_args(args, &cmd_args, &args_len);
+            arg_count = prepare_list_key_only_args(args, &arena, &cmd_args, &args_len);
             break;
         case LPush:
         case RPush:
         case LPushX:
         case RPushX:
-            arg_count = prepare_list_key_values_args(
-                args, &cmd_args, &args_len, &allocated_strings, &allocated_count);
+            arg_count = prepare_list_key_values_args(args, &arena, &cmd_args, &args_len);
             break;
         case LPop:
         case RPop:
-            arg_count = prepare_list_key_count_args(
-                args, &cmd_args, &args_len, &allocated_strings, &allocated_count);
+            arg_count = prepare_list_key_count_args(args, &arena, &cmd_args, &args_len);
             break;
         case BLPop:
         case BRPop:
-            arg_count = prepare_list_blocking_args(
-                args, &cmd_args, &args_len, &allocated_strings, &allocated_count);
+            arg_count = prepare_list_blocking_args(args, &arena, &cmd_args, &args_len);
             break;
         case LRange:
-            arg_count = prepare_list_range_args(
-                args, &cmd_args, &args_len, &allocated_strings, &allocated_count);
+            arg_count = prepare_list_range_args(args, &arena, &cmd_args, &args_len);
             break;
         case LPos:
-            arg_count = prepare_list_position_args(
-                args, &cmd_args, &args_len, &allocated_strings, &allocated_count);
+            arg_count = prepare_list_position_args(args, &arena, &cmd_args, &args_len);
             break;
         case LInsert:
-            arg_count = prepare_list_insert_args(args, &cmd_args, &args_len);
+            arg_count = prepare_list_insert_args(args, &arena, &cmd_args, &args_len);
             break;
         case LIndex:
         case LSet:
-            arg_count = prepare_list_index_set_args(
-                args, &cmd_args, &args_len, &allocated_strings, &allocated_count);
+            arg_count = prepare_list_index_set_args(args, &arena, &cmd_args, &args_len);
             break;
         case LRem:
-            arg_count = prepare_list_rem_args(
-                args, &cmd_args, &args_len, &allocated_strings, &allocated_count);
+            arg_count = prepare_list_rem_args(args, &arena, &cmd_args, &args_len);
             break;
         case LTrim:
-            arg_count = prepare_list_trim_args(
-                args, &cmd_args, &args_len, &allocated_strings, &allocated_count);
+            arg_count = prepare_list_trim_args(args, &arena, &cmd_args, &args_len);
             break;
         case LMove:
         case BLMove:
         case RPopLPush:
         case BRPopLPush:
-            arg_count = prepare_list_move_args(
-                args, &cmd_args, &args_len, &allocated_strings, &allocated_count);
+            arg_count = prepare_list_move_args(args, &arena, &cmd_args, &args_len);
             break;
         case LMPop:
         case BLMPop:
-            arg_count = prepare_list_mpop_args(
-                args, &cmd_args, &args_len, &allocated_strings, &allocated_count);
+            arg_count = prepare_list_mpop_args(args, &arena, &cmd_args, &args_len);
             break;
         default:
             return 0;
@@ -171,47 +134,10 @@ int execute_list_generic_command(const void*             glide_client,
     }
 
 cleanup:
-    /* Free allocated strings */
-    FREE_LIST_ALLOCATED_STRINGS(allocated_strings, allocated_count);
-
-    /* Free command arguments */
-    free_list_command_args(cmd_args, args_len);
-
+    arena_free(&arena);
     return status;
 }
 
-/**
- * Allocate a string representation of a long integer
- */
-char* alloc_list_number_string(long value, size_t* len_out) {
-    char   temp[32];
-    size_t len    = snprintf(temp, sizeof(temp), "%ld", value);
-    char*  result = emalloc(len + 1);
-    if (result) {
-        memcpy(result, temp, len);
-        result[len] = '\0';
-        if (len_out)
-            *len_out = len;
-    }
-    return result;
-}
-
-/**
- * Allocate a string representation of a double
- */
-char* alloc_list_double_string(double value, size_t* len_out) {
-    char   temp[64];
-    size_t len    = snprintf(temp, sizeof(temp), "%.6f", value);
-    char*  result = emalloc(len + 1);
-    if (result) {
-        memcpy(result, temp, len);
-        result[len] = '\0';
-        if (len_out)
-            *len_out = len;
-    }
-    return result;
-}
-
 /* ====================================================================
  * OPTION PARSING FUNCTIONS
  * ==================================================================== */
@@ -354,12 +280,13 @@ int parse_list_mpop_options(const char*          direction,
  * Prepare arguments for key-only commands (LLEN)
  */
 int prepare_list_key_only_args(list_command_args_t* args,
+                               arg_arena_t*         arena,
                                uintptr_t**          args_out,
                                unsigned long**      args_len_out) {
     VALIDATE_LIST_CLIENT(args->glide_client);
     VALIDATE_LIST_KEY(args->key, args->key_len);
 
-    if (!allocate_list_command_args(1, args_out, args_len_out)) {
+    if (!arena_alloc_args(arena, 1, args_out, args_len_out)) {
         return 0;
     }
 
@@ -373,10 +300,9 @@ int prepare_list_key_only_args(list_command_args_t* args,
  * Prepare arguments for key+values commands (LPUSH, RPUSH, etc.)
  */
 int prepare_list_key_values_args(list_command_args_t* args,
+                                 arg_arena_t*         arena,
                                  uintptr_t**          args_out,
-                                 unsigned long**      args_len_out,
-                                 char***              allocated_strings,
-                                 int*                 allocated_count) {
+                                 unsigned long**      args_len_out) {
     VALIDATE_LIST_CLIENT(args->glide_client);
     VALIDATE_LIST_KEY(args->key, args->key_len);
     VALIDATE_LIST_VALUES(args->values, args->value_count);
@@ -399,18 +325,10 @@ int prepare_list_key_values_args(list_command_args_t* args,
         }
     }
 
-    if (!allocate_list_command_args(total_args, args_out, args_len_out)) {
+    if (!arena_alloc_args(arena, total_args, args_out, args_len_out)) {
         return 0;
     }
 
-    /* Initialize allocated strings tracking */
-    *allocated_strings = (char**)emalloc(total_args * sizeof(char*));
-    if (!*allocated_strings) {
-        free_list_command_args(*args_out, *args_len_out);
-        return 0;
-    }
-    *allocated_count = 0;
-
     /* First argument: key */
     (*args_out)[0]     = (uintptr_t)args->key;
     (*args_len_out)[0] = args->key_len;
@@ -428,15 +346,7 @@ int prepare_list_key_values_args(list_command_args_t* args,
         } else if (Z_TYPE_P(value) == IS_LONG) {
             /* Convert long to string */
             size_t str_len;
-            char*  str_val = alloc_list_number_string(Z_LVAL_P(value), &str_len);
-            if (!str_val) {
-                FREE_LIST_ALLOCATED_STRINGS(*allocated_strings, *allocated_count);
-                free_list_command_args(*args_out, *args_len_out);
-                return 0;
-            }
-
-            (*allocated_strings)[*allocated_count] = str_val;
-            (*allocated_count)++;
+            char*  str_val = arena_long_to_string(arena, Z_LVAL_P(value), &str_len);
 
             (*args_out)[arg_idx]     = (uintptr_t)str_val;
             (*args_len_out)[arg_idx] = str_len;
@@ -444,15 +354,7 @@ int prepare_list_key_values_args(list_command_args_t* args,
         } else if (Z_TYPE_P(value) == IS_DOUBLE) {
             /* Convert double to string */
             size_t str_len;
-            char*  str_val = alloc_list_double_string(Z_DVAL_P(value), &str_len);
-            if (!str_val) {
-                FREE_LIST_ALLOCATED_STRINGS(*allocated_strings, *allocated_count);
-                free_list_command_args(*args_out, *args_len_out);
-                return 0;
-            }
-
-            (*allocated_strings)[*allocated_count] = str_val;
-            (*allocated_count)++;
+            char*  str_val = arena_printf(arena, &str_len, "%.6f", Z_DVAL_P(value));
 
             (*args_out)[arg_idx]     = (uintptr_t)str_val;
             (*args_len_out)[arg_idx] = str_len;
@@ -469,15 +371,7 @@ int prepare_list_key_values_args(list_command_args_t* args,
                 } else if (Z_TYPE_P(z_item) == IS_LONG) {
                     /* Convert long to string */
                     size_t str_len;
-                    char*  str_val = alloc_list_number_string(Z_LVAL_P(z_item), &str_len);
-                    if (!str_val) {
-                        FREE_LIST_ALLOCATED_STRINGS(*allocated_strings, *allocated_count);
-                        free_list_command_args(*args_out, *args_len_out);
-                        return 0;
-                    }
-
-                    (*allocated_strings)[*allocated_count] = str_val;
-                    (*allocated_count)++;
+                    char*  str_val = arena_long_to_string(arena, Z_LVAL_P(z_item), &str_len);
 
                     (*args_out)[arg_idx]     = (uintptr_t)str_val;
                     (*args_len_out)[arg_idx] = str_len;
@@ -485,22 +379,12 @@ int prepare_list_key_values_args(list_command_args_t* args,
                 } else if (Z_TYPE_P(z_item) == IS_DOUBLE) {
                     /* Convert double to string */
                     size_t str_len;
-                    char*  str_val = alloc_list_double_string(Z_DVAL_P(z_item), &str_len);
-                    if (!str_val) {
-                        FREE_LIST_ALLOCATED_STRINGS(*allocated_strings, *allocated_count);
-                        free_list_command_args(*args_out, *args_len_out);
-                        return 0;
-                    }
-
-                    (*allocated_strings)[*allocated_count] = str_val;
-                    (*allocated_count)++;
+                    char*  str_val = arena_printf(arena, &str_len, "%.6f", Z_DVAL_P(z_item));
 
                     (*args_out)[arg_idx]     = (uintptr_t)str_val;
                     (*args_len_out)[arg_idx] = str_len;
                     arg_idx++;
                 } else {
-                    FREE_LIST_ALLOCATED_STRINGS(*allocated_strings, *allocated_count);
-                    free_list_command_args(*args_out, *args_len_out);
                     return 0;
                 }
             }
@@ -536,10 +420,9 @@ int process_list_zval_int_result(CommandResult* result, void* output) {
  * Prepare arguments for key+count commands (LPOP, RPOP)
  */
 int prepare_list_key_count_args(list_command_args_t* args,
+                                arg_arena_t*         arena,
                                 uintptr_t**          args_out,
-                                unsigned long**      args_len_out,
-                                char***              allocated_strings,
-                                int*                 allocated_count) {
+                                unsigned long**      args_len_out) {
     VALIDATE_LIST_CLIENT(args->glide_client);
     VALIDATE_LIST_KEY(args->key, args->key_len);
 
@@ -548,14 +431,10 @@ int prepare_list_key_count_args(list_command_args_t* args,
         arg_count = 2;
     }
 
-    if (!allocate_list_command_args(arg_count, args_out, args_len_out)) {
+    if (!arena_alloc_args(arena, arg_count, args_out, args_len_out)) {
         return 0;
     }
 
-    /* Initialize allocated strings tracking */
-    *allocated_strings = NULL;
-    *allocated_count   = 0;
-
     /* First argument: key */
     (*args_out)[0]     = (uintptr_t)args->key;
     (*args_len_out)[0] = args->key_len;
@@ -563,22 +442,7 @@ int prepare_list_key_count_args(list_command_args_t* args,
     /* Add count if provided */
     if (args->count > 0) {
         size_t count_len;
-        char*  count_str = alloc_list_number_string(args->count, &count_len);
-        if (!count_str) {
-            free_list_command_args(*args_out, *args_len_out);
-            return 0;
-        }
-
-        /* Track allocated string */
-        *allocated_strings = (char**)emalloc(sizeof(char*));
-        if (!*allocated_strings) {
-            efree(count_str);
-            free_list_command_args(*args_out, *args_len_out);
-            return 0;
-        }
-
-        (*allocated_strings)[0] = count_str;
-        *allocated_count        = 1;
+        char*  count_str = arena_long_to_string(arena, args->count, &count_len);
 
         (*args_out)[1]     = (uintptr_t)count_str;
         (*args_len_out)[1] = count_len;
@@ -689,10 +553,9 @@ int process_list_pop_result(CommandResult* result, void* output) {
  * Prepare arguments for blocking commands (BLPOP, BRPOP)
  */
 int prepare_list_blocking_args(list_command_args_t* args,
+                               arg_arena_t*         arena,
                                uintptr_t**          args_out,
-                               unsigned long**      args_len_out,
-                               char***              allocated_strings,
-                               int*                 allocated_count) {
+                               unsigned long**      args_len_out) {
     VALIDATE_LIST_CLIENT(args->glide_client);
 
     int keys_count = 0;
@@ -713,18 +576,10 @@ int prepare_list_blocking_args(list_command_args_t* args,
     /* Calculate the number of arguments: keys + timeout */
     unsigned long arg_count = keys_count + 1;
 
-    if (!allocate_list_command_args(arg_count, args_out, args_len_out)) {
+    if (!arena_alloc_args(arena, arg_count, args_out, args_len_out)) {
         return 0;
     }
 
-    /* Initialize allocated strings tracking */
-    *allocated_strings = (char**)emalloc(sizeof(char*));
-    if (!*allocated_strings) {
-        free_list_command_args(*args_out, *args_len_out);
-        return 0;
-    }
-    *allocated_count = 0;
-
     int arg_idx = 0;
 
     /* Add keys */
@@ -733,8 +588,6 @@ int prepare_list_blocking_args(list_command_args_t* args,
         zval*      z_key;
         ZEND_HASH_FOREACH_VAL(ht, z_key) {
             if (Z_TYPE_P(z_key) != IS_STRING) {
-                FREE_LIST_ALLOCATED_STRINGS(*allocated_strings, *allocated_count);
-                free_list_command_args(*args_out, *args_len_out);
                 return 0;
             }
             (*args_out)[arg_idx]     = (uintptr_t)Z_STRVAL_P(z_key);
@@ -754,15 +607,7 @@ int prepare_list_blocking_args(list_command_args_t* args,
 
     /* Add timeout */
     size_t timeout_len;
-    char*  timeout_str = alloc_list_double_string(args->blocking_opts.timeout, &timeout_len);
-    if (!timeout_str) {
-        FREE_LIST_ALLOCATED_STRINGS(*allocated_strings, *allocated_count);
-        free_list_command_args(*args_out, *args_len_out);
-        return 0;
-    }
-
-    (*allocated_strings)[*allocated_count] = timeout_str;
-    (*allocated_count)++;
+    char*  timeout_str = arena_printf(arena, &timeout_len, "%.6f", args->blocking_opts.timeout);
 
     (*args_out)[arg_idx]     = (uintptr_t)timeout_str;
     (*args_len_out)[arg_idx] = timeout_len;
@@ -932,55 +777,30 @@ int execute_list_mpop_command(
  * Prepare arguments for range commands (LRANGE)
  */
 int prepare_list_range_args(list_command_args_t* args,
+                            arg_arena_t*         arena,
                             uintptr_t**          args_out,
-                            unsigned long**      args_len_out,
-                            char***              allocated_strings,
-                            int*                 allocated_count) {
+                            unsigned long**      args_len_out) {
     VALIDATE_LIST_CLIENT(args->glide_client);
     VALIDATE_LIST_KEY(args->key, args->key_len);
 
-    if (!allocate_list_command_args(3, args_out, args_len_out)) {
+    if (!arena_alloc_args(arena, 3, args_out, args_len_out)) {
         return 0;
     }
 
-    /* Initialize allocated strings tracking */
-    *allocated_strings = (char**)emalloc(2 * sizeof(char*));
-    if (!*allocated_strings) {
-        free_list_command_args(*args_out, *args_len_out);
-        return 0;
-    }
-    *allocated_count = 0;
-
     /* First argument: key */
     (*args_out)[0]     = (uintptr_t)args->key;
     (*args_len_out)[0] = args->key_len;
 
     /* Second argument: start */
     size_t start_len;
-    char*  start_str = alloc_list_number_string(args->start, &start_len);
-    if (!start_str) {
-        FREE_LIST_ALLOCATED_STRINGS(*allocated_strings, *allocated_count);
-        free_list_command_args(*args_out, *args_len_out);
-        return 0;
-    }
-
-    (*allocated_strings)[*allocated_count] = start_str;
-    (*allocated_count)++;
+    char*  start_str = arena_long_to_string(arena, args->start, &start_len);
 
     (*args_out)[1]     = (uintptr_t)start_str;
     (*args_len_out)[1] = start_len;
 
     /* Third argument: end */
     size_t end_len;
-    char*  end_str = alloc_list_number_string(args->end, &end_len);
-    if (!end_str) {
-        FREE_LIST_ALLOCATED_STRINGS(*allocated_strings, *allocated_count);
-        free_list_command_args(*args_out, *args_len_out);
-        return 0;
-    }
-
-    (*allocated_strings)[*allocated_count] = end_str;
-    (*allocated_count)++;
+    char*  end_str = arena_long_to_string(arena, args->end, &end_len);
 
     (*args_out)[2]     = (uintptr_t)end_str;
     (*args_len_out)[2] = end_len;
@@ -992,10 +812,9 @@ int prepare_list_range_args(list_command_args_t* args,
  * Prepare arguments for position commands (LPOS)
  */
 int prepare_list_position_args(list_command_args_t* args,
+                               arg_arena_t*         arena,
                                uintptr_t**          args_out,
-                               unsigned long**      args_len_out,
-                               char***              allocated_strings,
-                               int*                 allocated_count) {
+                               unsigned long**      args_len_out) {
     VALIDATE_LIST_CLIENT(args->glide_client);
     VALIDATE_LIST_KEY(args->key, args->key_len);
 
@@ -1014,17 +833,9 @@ int prepare_list_position_args(list_command_args_t* args,
 
     unsigned long arg_count = 2 + opt_count; /* key + element + options */
 
-    if (!allocate_list_command_args(arg_count, args_out, args_len_out)) {
-        return 0;
-    }
-
-    /* Initialize allocated strings tracking */
-    *allocated_strings = (char**)emalloc(3 * sizeof(char*));
-    if (!*allocated_strings) {
-        free_list_command_args(*args_out, *args_len_out);
+    if (!arena_alloc_args(arena, arg_count, args_out, args_len_out)) {
         return 0;
     }
-    *allocated_count = 0;
 
     /* Key and element are first two arguments */
     (*args_out)[0]     = (uintptr_t)args->key;
@@ -1041,15 +852,7 @@ int prepare_list_position_args(list_command_args_t* args,
         arg_idx++;
 
         size_t rank_len;
-        char*  rank_str = alloc_list_number_string(args->position_opts.rank, &rank_len);
-        if (!rank_str) {
-            FREE_LIST_ALLOCATED_STRINGS(*allocated_strings, *allocated_count);
-            free_list_command_args(*args_out, *args_len_out);
-            return 0;
-        }
-
-        (*allocated_strings)[*allocated_count] = rank_str;
-        (*allocated_count)++;
+        char*  rank_str = arena_long_to_string(arena, args->position_opts.rank, &rank_len);
 
         (*args_out)[arg_idx]     = (uintptr_t)rank_str;
         (*args_len_out)[arg_idx] = rank_len;
@@ -1062,15 +865,7 @@ int prepare_list_position_args(list_command_args_t* args,
         arg_idx++;
 
         size_t count_len;
-        char*  count_str = alloc_list_number_string(args->position_opts.count, &count_len);
-        if (!count_str) {
-            FREE_LIST_ALLOCATED_STRINGS(*allocated_strings, *allocated_count);
-            free_list_command_args(*args_out, *args_len_out);
-            return 0;
-        }
-
-        (*allocated_strings)[*allocated_count] = count_str;
-        (*allocated_count)++;
+        char*  count_str = arena_long_to_string(arena, args->position_opts.count, &count_len);
 
         (*args_out)[arg_idx]     = (uintptr_t)count_str;
         (*args_len_out)[arg_idx] = count_len;
@@ -1083,15 +878,7 @@ int prepare_list_position_args(list_command_args_t* args,
         arg_idx++;
 
         size_t maxlen_len;
-        char*  maxlen_str = alloc_list_number_string(args->position_opts.maxlen, &maxlen_len);
-        if (!maxlen_str) {
-            FREE_LIST_ALLOCATED_STRINGS(*allocated_strings, *allocated_count);
-            free_list_command_args(*args_out, *args_len_out);
-            return 0;
-        }
-
-        (*allocated_strings)[*allocated_count] = maxlen_str;
-        (*allocated_count)++;
+        char*  maxlen_str = arena_long_to_string(arena, args->position_opts.maxlen, &maxlen_len);
 
         (*args_out)[arg_idx]     = (uintptr_t)maxlen_str;
         (*args_len_out)[arg_idx] = maxlen_len;
@@ -1105,6 +892,7 @@ int prepare_list_position_args(list_command_args_t* args,
  * Prepare arguments for insert commands (LINSERT)
  */
 int prepare_list_insert_args(list_command_args_t* args,
+                             arg_arena_t*         arena,
                              uintptr_t**          args_out,
                              unsigned long**      args_len_out) {
     VALIDATE_LIST_CLIENT(args->glide_client);
@@ -1116,7 +904,7 @@ int prepare_list_insert_args(list_command_args_t* args,
         return 0;
     }
 
-    if (!allocate_list_command_args(4, args_out, args_len_out)) {
+    if (!arena_alloc_args(arena, 4, args_out, args_len_out)) {
         return 0;
     }
 
@@ -1136,43 +924,26 @@ int prepare_list_insert_args(list_command_args_t* args,
  * Prepare arguments for index/set commands (LINDEX, LSET)
  */
 int prepare_list_index_set_args(list_command_args_t* args,
+                                arg_arena_t*         arena,
                                 uintptr_t**          args_out,
-                                unsigned long**      args_len_out,
-                                char***              allocated_strings,
-                                int*                 allocated_count) {
+                                unsigned long**      args_len_out) {
     VALIDATE_LIST_CLIENT(args->glide_client);
     VALIDATE_LIST_KEY(args->key, args->key_len);
 
     /* For LSET, we need value as well */
     unsigned long arg_count = (args->value) ? 3 : 2;
 
-    if (!allocate_list_command_args(arg_count, args_out, args_len_out)) {
+    if (!arena_alloc_args(arena, arg_count, args_out, args_len_out)) {
         return 0;
     }
 
-    /* Initialize allocated strings tracking */
-    *allocated_strings = (char**)emalloc(sizeof(char*));
-    if (!*allocated_strings) {
-        free_list_command_args(*args_out, *args_len_out);
-        return 0;
-    }
-    *allocated_count = 0;
-
     /* First argument: key */
     (*args_out)[0]     = (uintptr_t)args->key;
     (*args_len_out)[0] = args->key_len;
 
     /* Second argument: index */
     size_t index_len;
-    char*  index_str = alloc_list_number_string(args->index, &index_len);
-    if (!index_str) {
-        FREE_LIST_ALLOCATED_STRINGS(*allocated_strings, *allocated_count);
-        free_list_command_args(*args_out, *args_len_out);
-        return 0;
-    }
-
-    (*allocated_strings)[*allocated_count] = index_str;
-    (*allocated_count)++;
+    char*  index_str = arena_long_to_string(arena, args->index, &index_len);
 
     (*args_out)[1]     = (uintptr_t)index_str;
     (*args_len_out)[1] = index_len;
@@ -1190,10 +961,9 @@ int prepare_list_index_set_args(list_command_args_t* args,
  * Prepare arguments for remove commands (LREM)
  */
 int prepare_list_rem_args(list_command_args_t* args,
+                          arg_arena_t*         arena,
                           uintptr_t**          args_out,
-                          unsigned long**      args_len_out,
-                          char***              allocated_strings,
-                          int*                 allocated_count) {
+                          unsigned long**      args_len_out) {
     VALIDATE_LIST_CLIENT(args->glide_client);
     VALIDATE_LIST_KEY(args->key, args->key_len);
 
@@ -1201,33 +971,17 @@ int prepare_list_rem_args(list_command_args_t* args,
         return 0;
     }
 
-    if (!allocate_list_command_args(3, args_out, args_len_out)) {
+    if (!arena_alloc_args(arena, 3, args_out, args_len_out)) {
         return 0;
     }
 
-    /* Initialize allocated strings tracking */
-    *allocated_strings = (char**)emalloc(sizeof(char*));
-    if (!*allocated_strings) {
-        free_list_command_args(*args_out, *args_len_out);
-        return 0;
-    }
-    *allocated_count = 0;
-
     /* First argument: key */
     (*args_out)[0]     = (uintptr_t)args->key;
     (*args_len_out)[0] = args->key_len;
 
     /* Second argument: count */
     size_t count_len;
-    char*  count_str = alloc_list_number_string(args->count, &count_len);
-    if (!count_str) {
-        FREE_LIST_ALLOCATED_STRINGS(*allocated_strings, *allocated_count);
-        free_list_command_args(*args_out, *args_len_out);
-        return 0;
-    }
-
-    (*allocated_strings)[*allocated_count] = count_str;
-    (*allocated_count)++;
+    char*  count_str = arena_long_to_string(arena, args->count, &count_len);
 
     (*args_out)[1]     = (uintptr_t)count_str;
     (*args_len_out)[1] = count_len;
@@ -1243,24 +997,15 @@ int prepare_list_rem_args(list_command_args_t* args,
  * Prepare arguments for trim commands (LTRIM)
  */
 int prepare_list_trim_args(list_command_args_t* args,
+                           arg_arena_t*         arena,
                            uintptr_t**          args_out,
-                           unsigned long**      args_len_out,
-                           char***              allocated_strings,
-                           int*                 allocated_count) {
+                           unsigned long**      args_len_out) {
     VALIDATE_LIST_CLIENT(args->glide_client);
     VALIDATE_LIST_KEY(args->key, args->key_len);
 
-    if (!allocate_list_command_args(3, args_out, args_len_out)) {
-        return 0;
-    }
-
-    /* Initialize allocated strings tracking */
-    *allocated_strings = (char**)emalloc(2 * sizeof(char*));
-    if (!*allocated_strings) {
-        free_list_command_args(*args_out, *args_len_out);
+    if (!arena_alloc_args(arena, 3, args_out, args_len_out)) {
         return 0;
     }
-    *allocated_count = 0;
 
     /* First argument: key */
     (*args_out)[0]     = (uintptr_t)args->key;
@@ -1268,30 +1013,14 @@ int prepare_list_trim_args(list_command_args_t* args,
 
     /* Second argument: start */
     size_t start_len;
-    char*  start_str = alloc_list_number_string(args->start, &start_len);
-    if (!start_str) {
-        FREE_LIST_ALLOCATED_STRINGS(*allocated_strings, *allocated_count);
-        free_list_command_args(*args_out, *args_len_out);
-        return 0;
-    }
-
-    (*allocated_strings)[*allocated_count] = start_str;
-    (*allocated_count)++;
+    char*  start_str = arena_long_to_string(arena, args->start, &start_len);
 
     (*args_out)[1]     = (uintptr_t)start_str;
     (*args_len_out)[1] = start_len;
 
     /* Third argument: end */
     size_t end_len;
-    char*  end_str = alloc_list_number_string(args->end, &end_len);
-    if (!end_str) {
-        FREE_LIST_ALLOCATED_STRINGS(*allocated_strings, *allocated_count);
-        free_list_command_args(*args_out, *args_len_out);
-        return 0;
-    }
-
-    (*allocated_strings)[*allocated_count] = end_str;
-    (*allocated_count)++;
+    char*  end_str = arena_long_to_string(arena, args->end, &end_len);
 
     (*args_out)[2]     = (uintptr_t)end_str;
     (*args_len_out)[2] = end_len;
@@ -1303,10 +1032,9 @@ int prepare_list_trim_args(list_command_args_t* args,
  * Prepare arguments for move commands (LMOVE, BLMOVE, RPOPLPUSH, BRPOPLPUSH)
  */
 int prepare_list_move_args(list_command_args_t* args,
+                           arg_arena_t*         arena,
                            uintptr_t**          args_out,
-                           unsigned long**      args_len_out,
-                           char***              allocated_strings,
-                           int*                 allocated_count) {
+                           unsigned long**      args_len_out) {
     VALIDATE_LIST_CLIENT(args->glide_client);
     VALIDATE_LIST_KEY(args->key, args->key_len);
 
@@ -1328,18 +1056,10 @@ int prepare_list_move_args(list_command_args_t* args,
         arg_count++;
     }
 
-    if (!allocate_list_command_args(arg_count, args_out, args_len_out)) {
+    if (!arena_alloc_args(arena, arg_count, args_out, args_len_out)) {
         return 0;
     }
 
-    /* Initialize allocated strings tracking */
-    *allocated_strings = (char**)emalloc(sizeof(char*));
-    if (!*allocated_strings) {
-        free_list_command_args(*args_out, *args_len_out);
-        return 0;
-    }
-    *allocated_count = 0;
-
     unsigned int arg_idx = 0;
 
     /* First argument: source key */
@@ -1366,15 +1086,7 @@ int prepare_list_move_args(list_command_args_t* args,
     /* Add timeout for blocking commands */
     if (args->move_opts.has_timeout) {
         size_t timeout_len;
-        char*  timeout_str = alloc_list_double_string(args->move_opts.timeout, &timeout_len);
-        if (!timeout_str) {
-            FREE_LIST_ALLOCATED_STRINGS(*allocated_strings, *allocated_count);
-            free_list_command_args(*args_out, *args_len_out);
-            return 0;
-        }
-
-        (*allocated_strings)[*allocated_count] = timeout_str;
-        (*allocated_count)++;
+        char*  timeout_str = arena_printf(arena, &timeout_len, "%.6f", args->move_opts.timeout);
 
         (*args_out)[arg_idx]     = (uintptr_t)timeout_str;
         (*args_len_out)[arg_idx] = timeout_len;
@@ -1388,10 +1100,9 @@ int prepare_list_move_args(list_command_args_t* args,
  * Prepare arguments for MPOP commands (LMPOP, BLMPOP)
  */
 int prepare_list_mpop_args(list_command_args_t* args,
+                           arg_arena_t*         arena,
                            uintptr_t**          args_out,
-                           unsigned long**      args_len_out,
-                           char***              allocated_strings,
-                           int*                 allocated_count) {
+                           unsigned long**      args_len_out) {
     VALIDATE_LIST_CLIENT(args->glide_client);
 
     if (!args->keys || !args->mpop_opts.direction || args->mpop_opts.direction_len <= 0) {
@@ -1415,32 +1126,16 @@ int prepare_list_mpop_args(list_command_args_t* args,
     if (args->mpop_opts.has_count)
         arg_count += 2; /* COUNT + value */
 
-    if (!allocate_list_command_args(arg_count, args_out, args_len_out)) {
+    if (!arena_alloc_args(arena, arg_count, args_out, args_len_out)) {
         return 0;
     }
 
-    /* Initialize allocated strings tracking */
-    *allocated_strings = (char**)emalloc(3 * sizeof(char*)); /* timeout, numkeys, count */
-    if (!*allocated_strings) {
-        free_list_command_args(*args_out, *args_len_out);
-        return 0;
-    }
-    *allocated_count = 0;
-
     unsigned int arg_idx = 0;
 
     /* Add timeout for blocking commands (first argument) */
     if (args->mpop_opts.has_timeout) {
         size_t timeout_len;
-        char*  timeout_str = alloc_list_double_string(args->mpop_opts.timeout, &timeout_len);
-        if (!timeout_str) {
-            FREE_LIST_ALLOCATED_STRINGS(*allocated_strings, *allocated_count);
-            free_list_command_args(*args_out, *args_len_out);
-            return 0;
-        }
-
-        (*allocated_strings)[*allocated_count] = timeout_str;
-        (*allocated_count)++;
+        char*  timeout_str = arena_printf(arena, &timeout_len, "%.6f", args->mpop_opts.timeout);
 
         (*args_out)[arg_idx]     = (uintptr_t)timeout_str;
         (*args_len_out)[arg_idx] = timeout_len;
@@ -1449,15 +1144,7 @@ int prepare_list_mpop_args(list_command_args_t* args,
 
     /* Add numkeys */
     size_t numkeys_len;
-    char*  numkeys_str = alloc_list_number_string(keys_count, &numkeys_len);
-    if (!numkeys_str) {
-        FREE_LIST_ALLOCATED_STRINGS(*allocated_strings, *allocated_count);
-        free_list_command_args(*args_out, *args_len_out);
-        return 0;
-    }
-
-    (*allocated_strings)[*allocated_count] = numkeys_str;
-    (*allocated_count)++;
+    char*  numkeys_str = arena_long_to_string(arena, keys_count, &numkeys_len);
 
     (*args_out)[arg_idx]     = (uintptr_t)numkeys_str;
     (*args_len_out)[arg_idx] = numkeys_len;
@@ -1468,8 +1155,6 @@ int prepare_list_mpop_args(list_command_args_t* args,
     zval*      z_key;
     ZEND_HASH_FOREACH_VAL(ht, z_key) {
         if (Z_TYPE_P(z_key) != IS_STRING) {
-            FREE_LIST_ALLOCATED_STRINGS(*allocated_strings, *allocated_count);
-            free_list_command_args(*args_out, *args_len_out);
             return 0;
         }
         (*args_out)[arg_idx]     = (uintptr_t)Z_STRVAL_P(z_key);
@@ -1490,15 +1175,7 @@ int prepare_list_mpop_args(list_command_args_t* args,
         arg_idx++;
 
         size_t count_len;
-        char*  count_str = alloc_list_number_string(args->mpop_opts.count, &count_len);
-        if (!count_str) {
-            FREE_LIST_ALLOCATED_STRINGS(*allocated_strings, *allocated_count);
-            free_list_command_args(*args_out, *args_len_out);
-            return 0;
-        }
-
-        (*allocated_strings)[*allocated_count] = count_str;
-        (*allocated_count)++;
+        char*  count_str = arena_long_to_string(arena, args->mpop_opts.count, &count_len);
 
         (*args_out)[arg_idx]     = (uintptr_t)count_str;
         (*args_len_out)[arg_idx] = count_len;
@@ -24,6 +24,7 @@
 #include "command_response.h"
 #include "common.h"
 #include "include/glide_bindings.h"
+#include "valkey_glide_arena.h"
 #include "valkey_glide_commands_common.h"
 
 /* ====================================================================
@@ -132,21 +133,14 @@ typedef struct _list_command_args_t {
 /* Function pointer types */
 typedef int (*list_result_processor_t)(CommandResult* result, void* output);
 typedef int (*list_arg_preparation_func_t)(list_command_args_t* args,
+                                           arg_arena_t*         arena,
                                            uintptr_t**          args_out,
-                                           unsigned long**      args_len_out,
-                                           char***              allocated_strings,
-                                           int*                 allocated_count);
+                                           unsigned long**      args_len_out);
 
 /* ====================================================================
  * FUNCTION DECLARATIONS
  * ==================================================================== */
 
-/* Utility functions */
-int   allocate_list_command_args(int count, uintptr_t** args_out, unsigned long** args_len_out);
-void  free_list_command_args(uintptr_t* args, unsigned long* args_len);
-char* alloc_list_number_string(long value, size_t* len_out);
-char* alloc_list_double_string(double value, size_t* len_out);
-
 /* Generic command execution framework */
 int execute_list_generic_command(const void*             glide_client,
                                  enum RequestType        cmd_type,
@@ -174,72 +168,64 @@ int parse_list_mpop_options(const char*          direction,
 
 /* Argument preparation functions */
 int prepare_list_key_only_args(list_command_args_t* args,
+                               arg_arena_t*         arena,
                                uintptr_t**          args_out,
                                unsigned long**      args_len_out);
 
 int prepare_list_key_values_args(list_command_args_t* args,
+                                 arg_arena_t*         arena,
                                  uintptr_t**          args_out,
-                                 unsigned long**      args_len_out,
-                                 char***              allocated_strings,
-                                 int*                 allocated_count);
+                                 unsigned long**      args_len_out);
 
 int prepare_list_key_count_args(list_command_args_t* args,
+                                arg_arena_t*         arena,
                                 uintptr_t**          args_out,
-                                unsigned long**      args_len_out,
-                                char***              allocated_strings,
-                                int*                 allocated_count);
+                                unsigned long**      args_len_out);
 
 int prepare_list_blocking_args(list_command_args_t* args,
+                               arg_arena_t*         arena,
                                uintptr_t**          args_out,
-                               unsigned long**      args_len_out,
-                               char***              allocated_strings,
-                               int*                 allocated_count);
+                               unsigned long**      args_len_out);
 
 int prepare_list_range_args(list_command_args_t* args,
+                            arg_arena_t*         arena,
                             uintptr_t**          args_out,
-                            unsigned long**      args_len_out,
-                            char***              allocated_strings,
-                            int*                 allocated_count);
+                            unsigned long**      args_len_out);
 
 int prepare_list_position_args(list_command_args_t* args,
+                               arg_arena_t*         arena,
                                uintptr_t**          args_out,
-                               unsigned long**      args_len_out,
-                               char***              allocated_strings,
-                               int*                 allocated_count);
+                               unsigned long**      args_len_out);
 
 int prepare_list_move_args(list_command_args_t* args,
+                           arg_arena_t*         arena,
                            uintptr_t**          args_out,
-                           unsigned long**      args_len_out,
-                           char***              allocated_strings,
-                           int*                 allocated_count);
+                           unsigned long**      args_len_out);
 
 int prepare_list_mpop_args(list_command_args_t* args,
+                           arg_arena_t*         arena,
                            uintptr_t**          args_out,
-                           unsigned long**      args_len_out,
-                           char***              allocated_strings,
-                           int*                 allocated_count);
+                           unsigned long**      args_len_out);
 
 int prepare_list_insert_args(list_command_args_t* args,
+                             arg_arena_t*         arena,
                              uintptr_t**          args_out,
                              unsigned long**      args_len_out);
 
 int prepare_list_index_set_args(list_command_args_t* args,
+                                arg_arena_t*         arena,
                                 uintptr_t**          args_out,
-                                unsigned long**      args_len_out,
-                                char***              allocated_strings,
-                                int*                 allocated_count);
+                                unsigned long**      args_len_out);
 
 int prepare_list_rem_args(list_command_args_t* args,
+                          arg_arena_t*         arena,
                           uintptr_t**          args_out,
-                          unsigned long**      args_len_out,
-                          char***              allocated_strings,
-                          int*                 allocated_count);
+                          unsigned long**      args_len_out);
 
 int prepare_list_trim_args(list_command_args_t* args,
+                           arg_arena_t*         arena,
                            uintptr_t**          args_out,
-                           unsigned long**      args_len_out,
-                           char***              allocated_strings,
-                           int*                 allocated_count);
+                           unsigned long**      args_len_out);
 
 /* Result processing functions */
 int process_list_int_result(CommandResult* result, void* output);
@@ -324,25 +310,6 @@ int execute_list_mpop_command(
         return 0;                           \
     }
 
-/* Memory management macros */
-#define FREE_LIST_ALLOCATED_STRINGS(strings, count) \
-    do {                                            \
-        if (strings) {                              \
-            for (int _i = 0; _i < (count); _i++) {  \
-                if ((strings)[_i]) {                \
-                    efree((strings)[_i]);           \
-                }                                   \
-            }                                       \
-            efree(strings);                         \
-        }                                           \
-    } while (0)
-
-#define CLEANUP_LIST_COMMAND_ARGS(args, args_len, strings, str_count) \
-    do {                                                              \
-        free_list_command_args((args), (args_len));                   \
-        FREE_LIST_ALLOCATED_STRINGS((strings), (str_count));          \
-    } while (0)
-
 /* ====================================================================
  * LIST COMMAND MACROS
  * ==================================================================== */
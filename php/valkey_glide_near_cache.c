@@ -0,0 +1,832 @@
+/*
+  +----------------------------------------------------------------------+
+  | Copyright (c) 2023-2025 The PHP Group                                |
+  +----------------------------------------------------------------------+
+  | This source file is subject to version 3.01 of the PHP license,      |
+  | that is bundled with this package in the file LICENSE, and is        |
+  | available through the world-wide-web at the following url:           |
+  | http://www.php.net/license/3_01.txt                                  |
+  | If you did not receive a copy of the PHP license and are unable to   |
+  | obtain it through the world-wide-web, please send a note to          |
+  | license@php.net so we can mail you a copy immediately.               |
+  +----------------------------------------------------------------------+
+*/
+
+#include "valkey_glide_near_cache.h"
+
+#include <inttypes.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "valkey_glide_commands_common.h"
+
+#define NEAR_CACHE_DEFAULT_MAX_BYTES (8 * 1024 * 1024)
+#define NEAR_CACHE_DEFAULT_TTL 60
+#define NEAR_CACHE_ENTRY_OVERHEAD 96
+#define NEAR_CACHE_MIN_BUCKETS 64
+#define NEAR_CACHE_MAX_BUCKETS 65536
+/* Longest argument invalidated locally by a write */
+#define NEAR_CACHE_MAX_NOTED_KEY 1024
+
+typedef struct near_cache_entry {
+    struct near_cache_entry* next;       /* Chain of the lookup bucket */
+    struct near_cache_entry* key_next;   /* Chain of the key bucket */
+    struct near_cache_entry* lru_prev;   /* Towards the most recently used entry */
+    struct near_cache_entry* lru_next;   /* Towards the least recently used entry */
+    uint64_t                 hash;       /* Hash of type, key and field */
+    uint64_t                 key_hash;   /* Hash of the key alone */
+    time_t                   expires_at; /* 0 if the entry never expires */
+    enum RequestType         type;
+    size_t                   key_len;
+    size_t                   field_len;
+    size_t                   value_len;
+    size_t                   bytes;  /* Bytes accounted against max_bytes */
+    char                     data[]; /* key, field, then value */
+} near_cache_entry;
+
+struct valkey_glide_near_cache {
+    struct valkey_glide_near_cache* next;
+    char*                           identity; /* Address, database, mode, TLS and user served */
+    const void*                     tracking_client;
+
+    /* Settings, copied from the configuration of the first attached client */
+    size_t  max_bytes;
+    long    ttl;
+    char**  prefixes;
+    size_t* prefix_lens;
+    int     prefix_count;
+
+    /* Everything below is guarded by lock */
+    pthread_mutex_t    lock;
+    near_cache_entry** buckets;
+    near_cache_entry** key_buckets;
+    size_t             bucket_mask;
+    near_cache_entry*  lru_head;
+    near_cache_entry*  lru_tail;
+    size_t             bytes;
+
+    /* Fill race protection: every invalidation bumps invalidation_seq */
+    uint64_t  invalidation_seq;
+    uint64_t  flush_seq;      /* invalidation_seq at the last flush */
+    uint64_t* invalidated_at; /* invalidation_seq at the last invalidation, per key bucket */
+};
+
+/* Attached clients, so that commands sent through execute_command() can find their cache */
+typedef struct near_cache_attachment {
+    struct near_cache_attachment* next;
+    const void*                   glide_client;
+    valkey_glide_near_cache_t*    cache;
+    valkey_glide_near_cache_t**   slot;
+} near_cache_attachment;
+
+/* Process-wide state, guarded by caches_lock; the lock order is caches_lock, then cache->lock */
+static pthread_mutex_t            caches_lock     = PTHREAD_MUTEX_INITIALIZER;
+static valkey_glide_near_cache_t* caches          = NULL;
+static near_cache_attachment*     attachments     = NULL;
+static bool                       near_cache_used = false;
+
+/* Helper: FNV-1a, continuing from hash */
+static uint64_t fnv1a(uint64_t hash, const void* data, size_t len) {
+    const unsigned char* bytes = data;
+    for (size_t i = 0; i < len; i++) {
+        hash ^= bytes[i];
+        hash *= 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+static uint64_t hash_key(const char* key, size_t key_len) {
+    return fnv1a(0xcbf29ce484222325ULL, key, key_len);
+}
+
+static uint64_t hash_request(uint64_t         key_hash,
+                             enum RequestType type,
+                             const char*      field,
+                             size_t           field_len) {
+    uint64_t hash = fnv1a(key_hash, &type, sizeof(type));
+    return field ? fnv1a(hash, field, field_len) : hash;
+}
+
+valkey_glide_near_cache_configuration_t* parse_valkey_glide_near_cache_configuration(
+    zval* near_cache_zval) {
+    if (!near_cache_zval) {
+        return NULL;
+    }
+    if (Z_TYPE_P(near_cache_zval) == IS_TRUE) {
+        valkey_glide_near_cache_configuration_t* config =
+            ecalloc(1, sizeof(valkey_glide_near_cache_configuration_t));
+        config->max_bytes = NEAR_CACHE_DEFAULT_MAX_BYTES;
+        config->ttl       = NEAR_CACHE_DEFAULT_TTL;
+        return config;
+    }
+    if (Z_TYPE_P(near_cache_zval) != IS_ARRAY) {
+        return NULL;
+    }
+    HashTable* near_cache_ht = Z_ARRVAL_P(near_cache_zval);
+
+    valkey_glide_near_cache_configuration_t* config =
+        ecalloc(1, sizeof(valkey_glide_near_cache_configuration_t));
+    config->max_bytes = NEAR_CACHE_DEFAULT_MAX_BYTES;
+    config->ttl       = NEAR_CACHE_DEFAULT_TTL;
+
+    zval* max_bytes_val = zend_hash_str_find(near_cache_ht, "max_bytes", 9);
+    if (max_bytes_val && Z_TYPE_P(max_bytes_val) == IS_LONG) {
+        config->max_bytes = Z_LVAL_P(max_bytes_val);
+    }
+    zval* ttl_val = zend_hash_str_find(near_cache_ht, "ttl", 3);
+    if (ttl_val && Z_TYPE_P(ttl_val) == IS_LONG && Z_LVAL_P(ttl_val) >= 0) {
+        config->ttl = Z_LVAL_P(ttl_val);
+    }
+    if (config->max_bytes <= 0) {
+        efree(config);
+        return NULL;
+    }
+
+    zval* prefixes_val = zend_hash_str_find(near_cache_ht, "prefixes", 8);
+    if (prefixes_val && Z_TYPE_P(prefixes_val) == IS_ARRAY &&
+        zend_hash_num_elements(Z_ARRVAL_P(prefixes_val)) > 0) {
+        HashTable* prefixes_ht = Z_ARRVAL_P(prefixes_val);
+        uint32_t   count       = zend_hash_num_elements(prefixes_ht);
+        config->prefixes       = ecalloc(count, sizeof(char*));
+        config->prefix_lens    = ecalloc(count, sizeof(size_t));
+
+        zval* prefix;
+        ZEND_HASH_FOREACH_VAL(prefixes_ht, prefix) {
+            if (Z_TYPE_P(prefix) == IS_STRING) {
+                config->prefixes[config->prefix_count]    = Z_STRVAL_P(prefix);
+                config->prefix_lens[config->prefix_count] = Z_STRLEN_P(prefix);
+                config->prefix_count++;
+            }
+        }
+        ZEND_HASH_FOREACH_END();
+    }
+
+    return config;
+}
+
+void free_valkey_glide_near_cache_configuration(valkey_glide_near_cache_configuration_t* config) {
+    if (config) {
+        if (config->prefixes) {
+            efree(config->prefixes);
+        }
+        if (config->prefix_lens) {
+            efree(config->prefix_lens);
+        }
+        efree(config);
+    }
+}
+
+/* Helper: whether the cache holds entries for this key at all */
+static bool matches_prefixes(const valkey_glide_near_cache_t* cache,
+                             const char*                      key,
+                             size_t                           key_len) {
+    if (cache->prefix_count == 0) {
+        return true;
+    }
+    for (int i = 0; i < cache->prefix_count; i++) {
+        if (key_len >= cache->prefix_lens[i] &&
+            memcmp(key, cache->prefixes[i], cache->prefix_lens[i]) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/* Helper: unlink an entry from the LRU list. The cache lock must be held */
+static void lru_unlink(valkey_glide_near_cache_t* cache, near_cache_entry* entry) {
+    if (entry->lru_prev) {
+        entry->lru_prev->lru_next = entry->lru_next;
+    } else {
+        cache->lru_head = entry->lru_next;
+    }
+    if (entry->lru_next) {
+        entry->lru_next->lru_prev = entry->lru_prev;
+    } else {
+        cache->lru_tail = entry->lru_prev;
+    }
+    entry->lru_prev = entry->lru_next = NULL;
+}
+
+/* Helper: make an entry the most recently used one. The cache lock must be held */
+static void lru_push_front(valkey_glide_near_cache_t* cache, near_cache_entry* entry) {
+    entry->lru_prev = NULL;
+    entry->lru_next = cache->lru_head;
+    if (cache->lru_head) {
+        cache->lru_head->lru_prev = entry;
+    } else {
+        cache->lru_tail = entry;
+    }
+    cache->lru_head = entry;
+}
+
+/* Helper: remove an entry from every index and free it. The cache lock must be held */
+static void remove_entry(valkey_glide_near_cache_t* cache, near_cache_entry* entry) {
+    near_cache_entry** link = &cache->buckets[entry->hash & cache->bucket_mask];
+    while (*link != entry) {
+        link = &(*link)->next;
+    }
+    *link = entry->next;
+
+    link = &cache->key_buckets[entry->key_hash & cache->bucket_mask];
+    while (*link != entry) {
+        link = &(*link)->key_next;
+    }
+    *link = entry->key_next;
+
+    lru_unlink(cache, entry);
+    cache->bytes -= entry->bytes;
+    free(entry);
+}
+
+/* Helper: find a live entry, dropping it if it expired. The cache lock must be held */
+static near_cache_entry* find_entry(valkey_glide_near_cache_t* cache,
+                                    enum RequestType           type,
+                                    const char*                key,
+                                    size_t                     key_len,
+                                    const char*                field,
+                                    size_t                     field_len) {
+    uint64_t hash = hash_request(hash_key(key, key_len), type, field, field_len);
+    size_t   len  = field ? field_len : 0;
+    for (near_cache_entry* entry = cache->buckets[hash & cache->bucket_mask]; entry;
+         entry                   = entry->next) {
+        if (entry->hash != hash || entry->type != type || entry->key_len != key_len ||
+            entry->field_len != len || memcmp(entry->data, key, key_len) != 0 ||
+            (len && memcmp(entry->data + key_len, field, len) != 0)) {
+            continue;
+        }
+        if (entry->expires_at && entry->expires_at <= time(NULL)) {
+            remove_entry(cache, entry);
+            return NULL;
+        }
+        return entry;
+    }
+    return NULL;
+}
+
+/* Helper: drop every entry read from a key. The cache lock must be held */
+static void invalidate_locked(valkey_glide_near_cache_t* cache, const char* key, size_t key_len) {
+    uint64_t key_hash = hash_key(key, key_len);
+    cache->invalidated_at[key_hash & cache->bucket_mask] = ++cache->invalidation_seq;
+
+    near_cache_entry* entry = cache->key_buckets[key_hash & cache->bucket_mask];
+    while (entry) {
+        near_cache_entry* next = entry->key_next;
+        if (entry->key_hash == key_hash && entry->key_len == key_len &&
+            memcmp(entry->data, key, key_len) == 0) {
+            remove_entry(cache, entry);
+        }
+        entry = next;
+    }
+}
+
+/* Helper: drop every entry. The cache lock must be held */
+static void flush_locked(valkey_glide_near_cache_t* cache) {
+    while (cache->lru_head) {
+        remove_entry(cache, cache->lru_head);
+    }
+    cache->flush_seq = ++cache->invalidation_seq;
+}
+
+/*
+ * Helper: whether a key was invalidated since the fill token was taken. Keys sharing its bucket
+ * count as invalidated too, which only costs a fill. The cache lock must be held
+ */
+static bool invalidated_since(valkey_glide_near_cache_t* cache, uint64_t key_hash, uint64_t token) {
+    return cache->flush_seq > token || cache->invalidated_at[key_hash & cache->bucket_mask] > token;
+}
+
+/* Helper: store an entry unless its key was invalidated since the token was taken */
+static void put_entry(valkey_glide_near_cache_t* cache,
+                      enum RequestType           type,
+                      const char*                key,
+                      size_t                     key_len,
+                      const char*                field,
+                      size_t                     field_len,
+                      const char*                value,
+                      size_t                     value_len,
+                      uint64_t                   token) {
+    size_t len   = field ? field_len : 0;
+    size_t bytes = sizeof(near_cache_entry) + key_len + len + value_len;
+    if (bytes + NEAR_CACHE_ENTRY_OVERHEAD > cache->max_bytes ||
+        !matches_prefixes(cache, key, key_len)) {
+        return;
+    }
+
+    /* Copied outside the lock, which the invalidation thread also takes */
+    near_cache_entry* entry = malloc(bytes);
+    if (!entry) {
+        return;
+    }
+    entry->key_hash   = hash_key(key, key_len);
+    entry->hash       = hash_request(entry->key_hash, type, field, field_len);
+    entry->expires_at = cache->ttl > 0 ? time(NULL) + cache->ttl : 0;
+    entry->type       = type;
+    entry->key_len    = key_len;
+    entry->field_len  = len;
+    entry->value_len  = value_len;
+    entry->bytes      = bytes + NEAR_CACHE_ENTRY_OVERHEAD;
+    memcpy(entry->data, key, key_len);
+    if (len) {
+        memcpy(entry->data + key_len, field, len);
+    }
+    memcpy(entry->data + key_len + len, value, value_len);
+
+    pthread_mutex_lock(&cache->lock);
+    if (invalidated_since(cache, entry->key_hash, token)) {
+        pthread_mutex_unlock(&cache->lock);
+        free(entry);
+        return;
+    }
+    near_cache_entry* existing = find_entry(cache, type, key, key_len, field, field_len);
+    if (existing) {
+        remove_entry(cache, existing);
+    }
+
+    near_cache_entry** bucket     = &cache->buckets[entry->hash & cache->bucket_mask];
+    near_cache_entry** key_bucket = &cache->key_buckets[entry->key_hash & cache->bucket_mask];
+    entry->next                   = *bucket;
+    *bucket                       = entry;
+    entry->key_next               = *key_bucket;
+    *key_bucket                   = entry;
+    lru_push_front(cache, entry);
+    cache->bytes += entry->bytes;
+
+    while (cache->bytes > cache->max_bytes) {
+        remove_entry(cache, cache->lru_tail);
+    }
+    pthread_mutex_unlock(&cache->lock);
+}
+
+/* Receives the invalidations of the tracking clients, on a client thread */
+static void near_cache_invalidation_callback(uintptr_t      client_ptr,
+                                             enum PushKind  kind,
+                                             const uint8_t* message,
+                                             int64_t        message_len,
+                                             const uint8_t* channel,
+                                             int64_t        channel_len,
+                                             const uint8_t* pattern,
+                                             int64_t        pattern_len) {
+    if (kind != PushInvalidate) {
+        return;
+    }
+
+    pthread_mutex_lock(&caches_lock);
+    for (valkey_glide_near_cache_t* cache = caches; cache; cache = cache->next) {
+        if ((uintptr_t)cache->tracking_client != client_ptr) {
+            continue;
+        }
+        pthread_mutex_lock(&cache->lock);
+        if (message) {
+            invalidate_locked(cache, (const char*)message, (size_t)message_len);
+        } else {
+            /* Flushed server or lost connection: invalidations may have been missed */
+            flush_locked(cache);
+        }
+        pthread_mutex_unlock(&cache->lock);
+        break;
+    }
+    pthread_mutex_unlock(&caches_lock);
+}
+
+/* Helper: release a cache whose tracking client is closed */
+static void free_cache(valkey_glide_near_cache_t* cache) {
+    while (cache->lru_head) {
+        remove_entry(cache, cache->lru_head);
+    }
+    for (int i = 0; i < cache->prefix_count; i++) {
+        free(cache->prefixes[i]);
+    }
+    free(cache->prefixes);
+    free(cache->prefix_lens);
+    free(cache->buckets);
+    free(cache->key_buckets);
+    free(cache->invalidated_at);
+    free(cache->identity);
+    pthread_mutex_destroy(&cache->lock);
+    free(cache);
+}
+
+/* Helper: allocate an empty cache from the configuration. Memory is persistent */
+static valkey_glide_near_cache_t* new_cache(const char*                                    identity,
+                                            const valkey_glide_near_cache_configuration_t* config) {
+    valkey_glide_near_cache_t* cache = calloc(1, sizeof(valkey_glide_near_cache_t));
+    if (!cache) {
+        return NULL;
+    }
+    cache->identity  = strdup(identity);
+    cache->max_bytes = (size_t)config->max_bytes;
+    cache->ttl       = config->ttl;
+
+    /* About one bucket per 256 cached bytes */
+    size_t buckets = NEAR_CACHE_MIN_BUCKETS;
+    while (buckets < NEAR_CACHE_MAX_BUCKETS && buckets * 256 < cache->max_bytes) {
+        buckets <<= 1;
+    }
+    cache->bucket_mask    = buckets - 1;
+    cache->buckets        = calloc(buckets, sizeof(near_cache_entry*));
+    cache->key_buckets    = calloc(buckets, sizeof(near_cache_entry*));
+    cache->invalidated_at = calloc(buckets, sizeof(uint64_t));
+
+    if (config->prefix_count > 0) {
+        cache->prefixes    = calloc(config->prefix_count, sizeof(char*));
+        cache->prefix_lens = calloc(config->prefix_count, sizeof(size_t));
+        if (cache->prefixes && cache->prefix_lens) {
+            for (int i = 0; i < config->prefix_count; i++) {
+                cache->prefixes[i] = malloc(config->prefix_lens[i] ? config->prefix_lens[i] : 1);
+                if (!cache->prefixes[i]) {
+                    break;
+                }
+                memcpy(cache->prefixes[i], config->prefixes[i], config->prefix_lens[i]);
+                cache->prefix_lens[i] = config->prefix_lens[i];
+                cache->prefix_count++;
+            }
+        }
+    }
+    pthread_mutex_init(&cache->lock, NULL);
+
+    if (!cache->identity || !cache->buckets || !cache->key_buckets || !cache->invalidated_at ||
+        cache->prefix_count != config->prefix_count) {
+        free_cache(cache);
+        return NULL;
+    }
+    return cache;
+}
+
+valkey_glide_near_cache_t* valkey_glide_near_cache_attach(
+    valkey_glide_client_configuration_t* config,
+    bool                                 is_cluster,
+    const void*                          glide_client,
+    valkey_glide_near_cache_t**          slot) {
+    if (!glide_client || !config->base.advanced_config ||
+        !config->base.advanced_config->near_cache_config) {
+        return NULL;
+    }
+    const valkey_glide_near_cache_configuration_t* near_cache_config =
+        config->base.advanced_config->near_cache_config;
+
+    /*
+     * Clients of the same server, database, TLS mode and credentials share a cache; a client
+     * authenticated as another user may not be allowed to read what this one cached
+     */
+    char        identity[512];
+    const char* host     = "localhost";
+    int         port     = 6379;
+    const char* username = "";
+    const char* tls_mode = "plain";
+    uint64_t    auth     = hash_key("", 0);
+    if (config->base.addresses && config->base.addresses_count > 0) {
+        host = config->base.addresses[0].host;
+        port = config->base.addresses[0].port;
+    }
+    if (config->base.credentials) {
+        const char* password = config->base.credentials->password;
+        if (config->base.credentials->username) {
+            username = config->base.credentials->username;
+        }
+        /* The username is hashed too, so that a truncated identity still tells users apart */
+        auth = fnv1a(auth, username, strlen(username) + 1);
+        if (password) {
+            auth = fnv1a(auth, password, strlen(password) + 1);
+        }
+    }
+    if (config->base.use_tls) {
+        tls_mode = config->base.advanced_config->tls_config &&
+                           config->base.advanced_config->tls_config->use_insecure_tls
+                       ? "insecure-tls"
+                       : "tls";
+    }
+    snprintf(identity,
+             sizeof(identity),
+             "%s:%s:%d/%d;%s;%016" PRIx64 ";%s",
+             is_cluster ? "cluster" : "standalone",
+             host,
+             port,
+             is_cluster || config->database_id < 0 ? 0 : config->database_id,
+             tls_mode,
+             auth,
+             username);
+
+    near_cache_attachment* attachment = malloc(sizeof(near_cache_attachment));
+    if (!attachment) {
+        return NULL;
+    }
+
+    pthread_mutex_lock(&caches_lock);
+    valkey_glide_near_cache_t* cache = caches;
+    while (cache && strcmp(cache->identity, identity) != 0) {
+        cache = cache->next;
+    }
+    pthread_mutex_unlock(&caches_lock);
+
+    if (!cache) {
+        /*
+         * Invalidations pushed before the cache is published are dropped, which is safe as it is
+         * empty and no fill can start before this function returns
+         */
+        cache = new_cache(identity, near_cache_config);
+        if (!cache) {
+            free(attachment);
+            return NULL;
+        }
+        cache->tracking_client = create_glide_tracking_client(
+            config, is_cluster, near_cache_config, near_cache_invalidation_callback);
+        if (!cache->tracking_client) {
+            free_cache(cache);
+            free(attachment);
+            return NULL;
+        }
+
+        pthread_mutex_lock(&caches_lock);
+        valkey_glide_near_cache_t* existing = caches;
+        while (existing && strcmp(existing->identity, identity) != 0) {
+            existing = existing->next;
+        }
+        if (!existing) {
+            cache->next = caches;
+            caches      = cache;
+        }
+        pthread_mutex_unlock(&caches_lock);
+
+        /* Another thread created the same cache meanwhile */
+        if (existing) {
+            close_glide_client(cache->tracking_client);
+            free_cache(cache);
+            cache = existing;
+        }
+    }
+
+    pthread_mutex_lock(&caches_lock);
+    attachment->glide_client = glide_client;
+    attachment->cache        = cache;
+    attachment->slot         = slot;
+    attachment->next         = attachments;
+    attachments              = attachment;
+    near_cache_used          = true;
+    pthread_mutex_unlock(&caches_lock);
+
+    return cache;
+}
+
+void valkey_glide_near_cache_detach(const void* glide_client) {
+    if (!near_cache_used || !glide_client) {
+        return;
+    }
+
+    pthread_mutex_lock(&caches_lock);
+    near_cache_attachment** link = &attachments;
+    while (*link && (*link)->glide_client != glide_client) {
+        link = &(*link)->next;
+    }
+    near_cache_attachment* attachment = *link;
+    if (attachment) {
+        *link = attachment->next;
+    }
+    pthread_mutex_unlock(&caches_lock);
+
+    free(attachment);
+}
+
+uint64_t valkey_glide_near_cache_begin_fill(valkey_glide_near_cache_t* cache) {
+    pthread_mutex_lock(&cache->lock);
+    uint64_t token = cache->invalidation_seq;
+    pthread_mutex_unlock(&cache->lock);
+    return token;
+}
+
+int valkey_glide_near_cache_get_string(valkey_glide_near_cache_t* cache,
+                                       enum RequestType           type,
+                                       const char*                key,
+                                       size_t                     key_len,
+                                       const char*                field,
+                                       size_t                     field_len,
+                                       zval*                      return_value) {
+    if (!matches_prefixes(cache, key, key_len)) {
+        return 0;
+    }
+
+    pthread_mutex_lock(&cache->lock);
+    near_cache_entry* entry = find_entry(cache, type, key, key_len, field, field_len);
+    if (!entry) {
+        pthread_mutex_unlock(&cache->lock);
+        return 0;
+    }
+    lru_unlink(cache, entry);
+    lru_push_front(cache, entry);
+    ZVAL_STRINGL(return_value, entry->data + entry->key_len + entry->field_len, entry->value_len);
+    pthread_mutex_unlock(&cache->lock);
+    return 1;
+}
+
+void valkey_glide_near_cache_put_string(valkey_glide_near_cache_t* cache,
+                                        enum RequestType           type,
+                                        const char*                key,
+                                        size_t                     key_len,
+                                        const char*                field,
+                                        size_t                     field_len,
+                                        const char*                value,
+                                        size_t                     value_len,
+                                        uint64_t                   token) {
+    put_entry(cache, type, key, key_len, field, field_len, value, value_len, token);
+}
+
+/*
+ * HGETALL replies are stored as a field count followed by, for each field, a tag (0 for a
+ * string key, 1 for an integer key), the key, then the value. Lengths are size_t and
+ * integer keys zend_long, all copied unaligned
+ */
+int valkey_glide_near_cache_get_hash(valkey_glide_near_cache_t* cache,
+                                     const char*                key,
+                                     size_t                     key_len,
+                                     zval*                      return_value) {
+    if (!matches_prefixes(cache, key, key_len)) {
+        return 0;
+    }
+
+    pthread_mutex_lock(&cache->lock);
+    near_cache_entry* entry = find_entry(cache, HGetAll, key, key_len, NULL, 0);
+    if (!entry) {
+        pthread_mutex_unlock(&cache->lock);
+        return 0;
+    }
+    lru_unlink(cache, entry);
+    lru_push_front(cache, entry);
+
+    const char* pos = entry->data + entry->key_len;
+    uint32_t    count;
+    memcpy(&count, pos, sizeof(count));
+    pos += sizeof(count);
+
+    array_init_size(return_value, count);
+    for (uint32_t i = 0; i < count; i++) {
+        char        tag   = *pos++;
+        zend_long   index = 0;
+        size_t      field_len;
+        const char* field = NULL;
+        if (tag) {
+            memcpy(&index, pos, sizeof(index));
+            pos += sizeof(index);
+        } else {
+            memcpy(&field_len, pos, sizeof(field_len));
+            pos += sizeof(field_len);
+            field = pos;
+            pos += field_len;
+        }
+        size_t value_len;
+        memcpy(&value_len, pos, sizeof(value_len));
+        pos += sizeof(value_len);
+
+        zval value;
+        ZVAL_STRINGL(&value, pos, value_len);
+        pos += value_len;
+        if (field) {
+            zend_hash_str_update(Z_ARRVAL_P(return_value), field, field_len, &value);
+        } else {
+            zend_hash_index_update(Z_ARRVAL_P(return_value), index, &value);
+        }
+    }
+    pthread_mutex_unlock(&cache->lock);
+    return 1;
+}
+
+void valkey_glide_near_cache_put_hash(valkey_glide_near_cache_t* cache,
+                                      const char*                key,
+                                      size_t                     key_len,
+                                      zval*                      value,
+                                      uint64_t                   token) {
+    if (Z_TYPE_P(value) != IS_ARRAY || !matches_prefixes(cache, key, key_len)) {
+        return;
+    }
+    HashTable* ht = Z_ARRVAL_P(value);
+
+    size_t       size = sizeof(uint32_t);
+    zend_ulong   index;
+    zend_string* field;
+    zval*        field_value;
+    ZEND_HASH_FOREACH_KEY_VAL(ht, index, field, field_value) {
+        if (Z_TYPE_P(field_value) != IS_STRING) {
+            return;
+        }
+        size += 1 + (field ? sizeof(size_t) + ZSTR_LEN(field) : sizeof(zend_long)) +
+                sizeof(size_t) + Z_STRLEN_P(field_value);
+    }
+    ZEND_HASH_FOREACH_END();
+    if (size + key_len > cache->max_bytes) {
+        return;
+    }
+
+    char*    buffer = emalloc(size);
+    char*    pos    = buffer;
+    uint32_t count  = zend_hash_num_elements(ht);
+    memcpy(pos, &count, sizeof(count));
+    pos += sizeof(count);
+    ZEND_HASH_FOREACH_KEY_VAL(ht, index, field, field_value) {
+        *pos++ = field ? 0 : 1;
+        if (field) {
+            size_t field_len = ZSTR_LEN(field);
+            memcpy(pos, &field_len, sizeof(field_len));
+            pos += sizeof(field_len);
+            memcpy(pos, ZSTR_VAL(field), field_len);
+            pos += field_len;
+        } else {
+            zend_long long_index = (zend_long)index;
+            memcpy(pos, &long_index, sizeof(long_index));
+            pos += sizeof(long_index);
+        }
+        size_t value_len = Z_STRLEN_P(field_value);
+        memcpy(pos, &value_len, sizeof(value_len));
+        pos += sizeof(value_len);
+        memcpy(pos, Z_STRVAL_P(field_value), value_len);
+        pos += value_len;
+    }
+    ZEND_HASH_FOREACH_END();
+
+    put_entry(cache, HGetAll, key, key_len, NULL, 0, buffer, size, token);
+    efree(buffer);
+}
+
+void valkey_glide_near_cache_note_command(const void*          glide_client,
+                                          enum RequestType     type,
+                                          unsigned long        arg_count,
+                                          const uintptr_t*     args,
+                                          const unsigned long* args_len) {
+    if (!near_cache_used) {
+        return;
+    }
+    switch (type) {
+        /* Reads leave the cache untouched */
+        case Get:
+        case HGet:
+        case HGetAll:
+        case MGet:
+        case HMGet:
+        case Exists:
+        case Ping:
+            return;
+        default:
+            break;
+    }
+
+    pthread_mutex_lock(&caches_lock);
+    near_cache_attachment** link = &attachments;
+    while (*link && (*link)->glide_client != glide_client) {
+        link = &(*link)->next;
+    }
+    near_cache_attachment* attachment = *link;
+    if (!attachment) {
+        pthread_mutex_unlock(&caches_lock);
+        return;
+    }
+    valkey_glide_near_cache_t* cache = attachment->cache;
+
+    if (type == Select) {
+        /* The cache serves the configured database only */
+        *attachment->slot = NULL;
+        *link             = attachment->next;
+        pthread_mutex_unlock(&caches_lock);
+        free(attachment);
+        return;
+    }
+
+    pthread_mutex_lock(&cache->lock);
+    if (type == FlushAll || type == FlushDB || type == SwapDb) {
+        flush_locked(cache);
+    } else {
+        /*
+         * Any argument may be a key; dropping a few unrelated entries is harmless. Large values
+         * are skipped, their keys are still invalidated by the tracking client
+         */
+        for (unsigned long i = 0; i < arg_count; i++) {
+            if (args_len[i] <= NEAR_CACHE_MAX_NOTED_KEY &&
+                matches_prefixes(cache, (const char*)args[i], args_len[i])) {
+                invalidate_locked(cache, (const char*)args[i], args_len[i]);
+            }
+        }
+    }
+    pthread_mutex_unlock(&cache->lock);
+    pthread_mutex_unlock(&caches_lock);
+}
+
+void valkey_glide_near_cache_shutdown(void) {
+    pthread_mutex_lock(&caches_lock);
+    valkey_glide_near_cache_t* cache      = caches;
+    near_cache_attachment*     attachment = attachments;
+    caches                                = NULL;
+    attachments                           = NULL;
+    near_cache_used                       = false;
+    pthread_mutex_unlock(&caches_lock);
+
+    while (attachment) {
+        near_cache_attachment* next = attachment->next;
+        free(attachment);
+        attachment = next;
+    }
+    while (cache) {
+        valkey_glide_near_cache_t* next = cache->next;
+        /* Closing the client stops its invalidation callbacks */
+        close_glide_client(cache->tracking_client);
+        free_cache(cache);
+        cache = next;
+    }
+}
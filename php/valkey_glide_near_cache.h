@@ -0,0 +1,109 @@
+/*
+  +----------------------------------------------------------------------+
+  | Copyright (c) 2023-2025 The PHP Group                                |
+  +----------------------------------------------------------------------+
+  | This source file is subject to version 3.01 of the PHP license,      |
+  | that is bundled with this package in the file LICENSE, and is        |
+  | available through the world-wide-web at the following url:           |
+  | http://www.php.net/license/3_01.txt                                  |
+  | If you did not receive a copy of the PHP license and are unable to   |
+  | obtain it through the world-wide-web, please send a note to          |
+  | license@php.net so we can mail you a copy immediately.               |
+  +----------------------------------------------------------------------+
+*/
+
+#ifndef VALKEY_GLIDE_NEAR_CACHE_H
+#define VALKEY_GLIDE_NEAR_CACHE_H
+
+#include <stdint.h>
+
+#include "common.h"
+
+/*
+ * Parse the 'near_cache' entry of the advanced configuration array:
+ *   ['max_bytes' => int, 'ttl' => int, 'prefixes' => [string, ...]]
+ * Returns a newly allocated configuration, or NULL if the near cache is not enabled.
+ * Strings point into near_cache_zval, which must outlive the returned configuration.
+ * Free with free_valkey_glide_near_cache_configuration()
+ */
+valkey_glide_near_cache_configuration_t* parse_valkey_glide_near_cache_configuration(
+    zval* near_cache_zval);
+void free_valkey_glide_near_cache_configuration(valkey_glide_near_cache_configuration_t* config);
+
+/*
+ * Attach a client to the near cache of its server, creating the cache on first use.
+ * Caches live for the whole worker process and are shared by every client connected to the
+ * same address and database with the same TLS mode and credentials, so entries survive across
+ * requests. Each cache owns a tracking client in broadcast mode whose invalidation pushes keep
+ * it coherent with the server.
+ * The slot is cleared if the client later switches database.
+ * Returns the cache, or NULL if the near cache is disabled or the tracking client failed
+ */
+valkey_glide_near_cache_t* valkey_glide_near_cache_attach(
+    valkey_glide_client_configuration_t* config,
+    bool                                 is_cluster,
+    const void*                          glide_client,
+    valkey_glide_near_cache_t**          slot);
+
+/* Detach a client attached by valkey_glide_near_cache_attach(); unknown clients are ignored */
+void valkey_glide_near_cache_detach(const void* glide_client);
+
+/*
+ * Start a fill: returns a token to pass to the put functions once the server replied.
+ * A reply is only cached if its key was not invalidated since the token was taken
+ */
+uint64_t valkey_glide_near_cache_begin_fill(valkey_glide_near_cache_t* cache);
+
+/*
+ * Serve a GET (field is NULL) or HGET from the cache.
+ * Returns 1 and sets return_value on a hit, 0 on a miss
+ */
+int valkey_glide_near_cache_get_string(valkey_glide_near_cache_t* cache,
+                                       enum RequestType           type,
+                                       const char*                key,
+                                       size_t                     key_len,
+                                       const char*                field,
+                                       size_t                     field_len,
+                                       zval*                      return_value);
+
+/* Cache the reply of a GET (field is NULL) or HGET */
+void valkey_glide_near_cache_put_string(valkey_glide_near_cache_t* cache,
+                                        enum RequestType           type,
+                                        const char*                key,
+                                        size_t                     key_len,
+                                        const char*                field,
+                                        size_t                     field_len,
+                                        const char*                value,
+                                        size_t                     value_len,
+                                        uint64_t                   token);
+
+/*
+ * Serve an HGETALL from the cache.
+ * Returns 1 and sets return_value to a new array on a hit, 0 on a miss
+ */
+int valkey_glide_near_cache_get_hash(valkey_glide_near_cache_t* cache,
+                                     const char*                key,
+                                     size_t                     key_len,
+                                     zval*                      return_value);
+
+/* Cache the reply of an HGETALL; arrays holding non-string values are not cached */
+void valkey_glide_near_cache_put_hash(valkey_glide_near_cache_t* cache,
+                                      const char*                key,
+                                      size_t                     key_len,
+                                      zval*                      value,
+                                      uint64_t                   token);
+
+/*
+ * Drop the entries a command sent by glide_client may have modified, so that the client reads
+ * its own writes before the invalidation push arrives. Cheap when no cache is in use
+ */
+void valkey_glide_near_cache_note_command(const void*          glide_client,
+                                          enum RequestType     type,
+                                          unsigned long        arg_count,
+                                          const uintptr_t*     args,
+                                          const unsigned long* args_len);
+
+/* Close the tracking clients and release every cache; called at module shutdown */
+void valkey_glide_near_cache_shutdown(void);
+
+#endif /* VALKEY_GLIDE_NEAR_CACHE_H */
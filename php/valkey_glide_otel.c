@@ -0,0 +1,154 @@
+/*
+  +----------------------------------------------------------------------+
+  | Copyright (c) 2023-2025 The PHP Group                                |
+  +----------------------------------------------------------------------+
+  | This source file is subject to version 3.01 of the PHP license,      |
+  | that is bundled with this package in the file LICENSE, and is        |
+  | available through the world-wide-web at the following url:           |
+  | http://www.php.net/license/3_01.txt                                  |
+  | If you did not receive a copy of the PHP license and are unable to   |
+  | obtain it through the world-wide-web, please send a note to          |
+  | license@php.net so we can mail you a copy immediately.               |
+  +----------------------------------------------------------------------+
+*/
+
+#include "valkey_glide_otel.h"
+
+#include <time.h>
+
+#include "include/glide_bindings.h"
+
+/* Process-wide tracing state; 0 means tracing is disabled */
+static uint32_t otel_sample_percentage = 0;
+static bool     otel_initialized       = false;
+
+/* Sampling state, per thread under ZTS; seeded on first use, 0 until then */
+ZEND_TLS uint64_t otel_rng_state = 0;
+
+/* Helper: read an endpoint string from a ['endpoint' => ...] array */
+static char* find_endpoint(HashTable* ht, const char* section, size_t section_len) {
+    zval* section_val = zend_hash_str_find(ht, section, section_len);
+    if (!section_val || Z_TYPE_P(section_val) != IS_ARRAY) {
+        return NULL;
+    }
+    zval* endpoint_val = zend_hash_str_find(Z_ARRVAL_P(section_val), "endpoint", 8);
+    if (!endpoint_val || Z_TYPE_P(endpoint_val) != IS_STRING) {
+        return NULL;
+    }
+    return Z_STRVAL_P(endpoint_val);
+}
+
+valkey_glide_otel_configuration_t* parse_valkey_glide_otel_configuration(zval* otel_zval) {
+    if (!otel_zval || Z_TYPE_P(otel_zval) != IS_ARRAY) {
+        return NULL;
+    }
+    HashTable* otel_ht = Z_ARRVAL_P(otel_zval);
+
+    char* traces_endpoint  = find_endpoint(otel_ht, "traces", 6);
+    char* metrics_endpoint = find_endpoint(otel_ht, "metrics", 7);
+    if (!traces_endpoint && !metrics_endpoint) {
+        return NULL;
+    }
+
+    valkey_glide_otel_configuration_t* config =
+        ecalloc(1, sizeof(valkey_glide_otel_configuration_t));
+    config->traces_endpoint   = traces_endpoint;
+    config->metrics_endpoint  = metrics_endpoint;
+    config->sample_percentage = -1; /* Not set */
+    config->flush_interval_ms = -1; /* Not set */
+
+    zval* traces_val = zend_hash_str_find(otel_ht, "traces", 6);
+    if (traces_endpoint && traces_val) {
+        zval* sample_val =
+            zend_hash_str_find(Z_ARRVAL_P(traces_val), "sample_percentage", 17);
+        if (sample_val && Z_TYPE_P(sample_val) == IS_LONG) {
+            config->sample_percentage = Z_LVAL_P(sample_val);
+        }
+    }
+
+    zval* flush_val = zend_hash_str_find(otel_ht, "flush_interval_ms", 17);
+    if (flush_val && Z_TYPE_P(flush_val) == IS_LONG) {
+        config->flush_interval_ms = Z_LVAL_P(flush_val);
+    }
+
+    return config;
+}
+
+void free_valkey_glide_otel_configuration(valkey_glide_otel_configuration_t* config) {
+    if (config) {
+        efree(config);
+    }
+}
+
+int valkey_glide_otel_init(const valkey_glide_otel_configuration_t* config) {
+    if (!config || otel_initialized) {
+        return 1;
+    }
+
+    OpenTelemetryTracesConfig  traces_config  = {0};
+    OpenTelemetryMetricsConfig metrics_config = {0};
+    OpenTelemetryConfig        otel_config    = {0};
+
+    if (config->traces_endpoint) {
+        traces_config.endpoint              = config->traces_endpoint;
+        traces_config.has_sample_percentage = config->sample_percentage >= 0;
+        traces_config.sample_percentage =
+            config->sample_percentage >= 0 ? (uint32_t)config->sample_percentage : 0;
+        otel_config.traces = &traces_config;
+    }
+    if (config->metrics_endpoint) {
+        metrics_config.endpoint = config->metrics_endpoint;
+        otel_config.metrics     = &metrics_config;
+    }
+    otel_config.has_flush_interval_ms = config->flush_interval_ms >= 0;
+    otel_config.flush_interval_ms     = config->flush_interval_ms;
+
+    const char* error = init_open_telemetry(&otel_config);
+    if (error) {
+        php_error_docref(NULL, E_WARNING, "Error initializing OpenTelemetry: %s", error);
+        free_c_string((char*)error);
+        return 0;
+    }
+
+    otel_initialized = true;
+    if (config->traces_endpoint) {
+        /* Mirrors the core default of 1% when no percentage is given */
+        otel_sample_percentage =
+            config->sample_percentage >= 0 ? (uint32_t)config->sample_percentage : 1;
+    }
+    return 1;
+}
+
+/* Helper: decide whether the current request is sampled (xorshift64*) */
+static bool should_sample(void) {
+    if (otel_sample_percentage == 0) {
+        return false;
+    }
+    if (otel_sample_percentage >= 100) {
+        return true;
+    }
+    if (otel_rng_state == 0) {
+        /* The address differs between threads, so they don't share a sequence */
+        otel_rng_state = ((uint64_t)time(NULL) << 32) ^ (uint64_t)(uintptr_t)&otel_rng_state;
+        otel_rng_state |= 1;
+    }
+    otel_rng_state ^= otel_rng_state >> 12;
+    otel_rng_state ^= otel_rng_state << 25;
+    otel_rng_state ^= otel_rng_state >> 27;
+    uint64_t value = otel_rng_state * 0x2545F4914F6CDD1DULL;
+    return (value >> 32) % 100 < otel_sample_percentage;
+}
+
+uint64_t valkey_glide_otel_start_span(enum RequestType request_type) {
+    return should_sample() ? create_otel_span(request_type) : 0;
+}
+
+uint64_t valkey_glide_otel_start_batch_span(void) {
+    return should_sample() ? create_batch_otel_span() : 0;
+}
+
+void valkey_glide_otel_end_span(uint64_t span_ptr) {
+    if (span_ptr) {
+        drop_otel_span(span_ptr);
+    }
+}
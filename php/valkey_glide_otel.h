@@ -0,0 +1,54 @@
+/*
+  +----------------------------------------------------------------------+
+  | Copyright (c) 2023-2025 The PHP Group                                |
+  +----------------------------------------------------------------------+
+  | This source file is subject to version 3.01 of the PHP license,      |
+  | that is bundled with this package in the file LICENSE, and is        |
+  | available through the world-wide-web at the following url:           |
+  | http://www.php.net/license/3_01.txt                                  |
+  | If you did not receive a copy of the PHP license and are unable to   |
+  | obtain it through the world-wide-web, please send a note to          |
+  | license@php.net so we can mail you a copy immediately.               |
+  +----------------------------------------------------------------------+
+*/
+
+#ifndef VALKEY_GLIDE_OTEL_H
+#define VALKEY_GLIDE_OTEL_H
+
+#include <stdint.h>
+
+#include "common.h"
+
+/*
+ * Parse the 'otel' entry of the advanced configuration array:
+ *   ['traces'  => ['endpoint' => string, 'sample_percentage' => int],
+ *    'metrics' => ['endpoint' => string],
+ *    'flush_interval_ms' => int]
+ * Returns a newly allocated configuration, or NULL if no exporter is configured.
+ * Strings point into otel_zval, which must outlive the returned configuration.
+ * Free with free_valkey_glide_otel_configuration()
+ */
+valkey_glide_otel_configuration_t* parse_valkey_glide_otel_configuration(zval* otel_zval);
+void free_valkey_glide_otel_configuration(valkey_glide_otel_configuration_t* config);
+
+/*
+ * Initialize OpenTelemetry for this process from the given configuration.
+ * OpenTelemetry is process-wide: only the first successful call takes effect.
+ * Returns 1 on success (or when config is NULL), 0 on error
+ */
+int valkey_glide_otel_init(const valkey_glide_otel_configuration_t* config);
+
+/*
+ * Create a span for a command if this request is sampled.
+ * Returns 0 without allocating when tracing is disabled or the request is not sampled.
+ * The span must be released with valkey_glide_otel_end_span()
+ */
+uint64_t valkey_glide_otel_start_span(enum RequestType request_type);
+
+/* Same as valkey_glide_otel_start_span() for a batch */
+uint64_t valkey_glide_otel_start_batch_span(void);
+
+/* Release a span created by valkey_glide_otel_start_span(); 0 is ignored */
+void valkey_glide_otel_end_span(uint64_t span_ptr);
+
+#endif /* VALKEY_GLIDE_OTEL_H */
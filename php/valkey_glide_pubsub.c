@@ -0,0 +1,583 @@
+/*
+  +----------------------------------------------------------------------+
+  | Copyright (c) 2023-2025 The PHP Group                                |
+  +----------------------------------------------------------------------+
+  | This source file is subject to version 3.01 of the PHP license,      |
+  | that is bundled with this package in the file LICENSE, and is        |
+  | available through the world-wide-web at the following url:           |
+  | http://www.php.net/license/3_01.txt                                  |
+  | If you did not receive a copy of the PHP license and are unable to   |
+  | obtain it through the world-wide-web, please send a note to          |
+  | license@php.net so we can mail you a copy immediately.               |
+  +----------------------------------------------------------------------+
+*/
+
+#include "valkey_glide_pubsub.h"
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "valkey_glide_commands_common.h"
+#include "valkey_glide_core_common.h"
+
+#define PUBSUB_KINDS 3
+#define PUBSUB_MIN_BUFFER 16
+#define PUBSUB_MAX_BUFFER (1 << 20)
+/* The subscribe() loop wakes up at least this often, in case a wakeup was missed */
+#define PUBSUB_WAIT_MS 100
+
+typedef struct pubsub_message {
+    enum PushKind kind;
+    size_t        channel_len;
+    size_t        message_len;
+    size_t        pattern_len;
+    char          data[]; /* channel, message, then pattern */
+} pubsub_message_t;
+
+/* A ring slot. seq is the position it can be written at, plus 1 once the message is written */
+typedef struct pubsub_slot {
+    atomic_size_t     seq;
+    pubsub_message_t* message;
+} pubsub_slot_t;
+
+struct valkey_glide_pubsub {
+    const void* subscriber_client; /* NULL while nothing is subscribed */
+    uint8_t*    request;           /* Serialized connection request */
+    size_t      request_len;
+    size_t      buffer_size;
+    bool        in_loop; /* subscribe() is dispatching messages */
+
+    /* Channels, patterns and shard channels, indexed by VALKEY_GLIDE_PUBSUB_* */
+    HashTable subscriptions[PUBSUB_KINDS];
+
+    /*
+     * Bounded ring, written without locks by the client threads (the old and the new subscriber
+     * clients overlap while the subscriptions change) and read by PHP only.
+     * Allocated on the first subscription
+     */
+    pubsub_slot_t*        ring;
+    size_t                ring_mask;
+    atomic_size_t         head; /* Next position claimed by a writer */
+    size_t                tail; /* Next position read */
+    atomic_uint_least64_t dropped;
+
+    /* Wakes up the subscribe() loop when it waits for messages */
+    pthread_mutex_t wait_lock;
+    pthread_cond_t  wait_cond;
+    atomic_bool     waiting;
+};
+
+/* Helper: store a message, or return false if the ring is full. Called by the client threads */
+static bool ring_push(valkey_glide_pubsub_t* pubsub, pubsub_message_t* message) {
+    size_t         pos = atomic_load_explicit(&pubsub->head, memory_order_relaxed);
+    pubsub_slot_t* slot;
+    for (;;) {
+        slot          = &pubsub->ring[pos & pubsub->ring_mask];
+        size_t   seq  = atomic_load_explicit(&slot->seq, memory_order_acquire);
+        intptr_t diff = (intptr_t)seq - (intptr_t)pos;
+        if (diff == 0) {
+            if (atomic_compare_exchange_weak_explicit(
+                    &pubsub->head, &pos, pos + 1, memory_order_relaxed, memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            /* Not read yet since the previous lap */
+            return false;
+        } else {
+            pos = atomic_load_explicit(&pubsub->head, memory_order_relaxed);
+        }
+    }
+    slot->message = message;
+    /* Sequentially consistent, to be ordered with the load of waiting that follows */
+    atomic_store(&slot->seq, pos + 1);
+    return true;
+}
+
+/* Helper: whether the oldest message is written. Called by PHP only */
+static bool ring_ready(valkey_glide_pubsub_t* pubsub) {
+    return pubsub->ring &&
+           atomic_load(&pubsub->ring[pubsub->tail & pubsub->ring_mask].seq) == pubsub->tail + 1;
+}
+
+/* Helper: take the oldest message, NULL if there is none. Called by PHP only */
+static pubsub_message_t* ring_pop(valkey_glide_pubsub_t* pubsub) {
+    if (!pubsub->ring) {
+        return NULL;
+    }
+    pubsub_slot_t* slot = &pubsub->ring[pubsub->tail & pubsub->ring_mask];
+    if (atomic_load_explicit(&slot->seq, memory_order_acquire) != pubsub->tail + 1) {
+        return NULL;
+    }
+    pubsub_message_t* message = slot->message;
+    /* Writable again on the next lap */
+    atomic_store_explicit(&slot->seq, pubsub->tail + pubsub->ring_mask + 1, memory_order_release);
+    pubsub->tail++;
+    return message;
+}
+
+/*
+ * Receives the pushes of the subscriber clients, on a client thread. They are opened with their
+ * valkey_glide_pubsub_t as push context, so client_ptr is the destination of the message
+ */
+static void pubsub_message_callback(uintptr_t      client_ptr,
+                                    enum PushKind  kind,
+                                    const uint8_t* message,
+                                    int64_t        message_len,
+                                    const uint8_t* channel,
+                                    int64_t        channel_len,
+                                    const uint8_t* pattern,
+                                    int64_t        pattern_len) {
+    if (kind != PushMessage && kind != PushPMessage && kind != PushSMessage) {
+        return;
+    }
+    if (!pattern) {
+        pattern_len = 0;
+    }
+
+    /* The data is only valid during the call */
+    pubsub_message_t* copy =
+        malloc(sizeof(pubsub_message_t) + channel_len + message_len + pattern_len);
+    if (!copy) {
+        return;
+    }
+    copy->kind        = kind;
+    copy->channel_len = (size_t)channel_len;
+    copy->message_len = (size_t)message_len;
+    copy->pattern_len = (size_t)pattern_len;
+    memcpy(copy->data, channel, copy->channel_len);
+    memcpy(copy->data + copy->channel_len, message, copy->message_len);
+    memcpy(copy->data + copy->channel_len + copy->message_len, pattern, copy->pattern_len);
+
+    valkey_glide_pubsub_t* pubsub = (valkey_glide_pubsub_t*)client_ptr;
+    if (!ring_push(pubsub, copy)) {
+        atomic_fetch_add_explicit(&pubsub->dropped, 1, memory_order_relaxed);
+        free(copy);
+        return;
+    }
+    if (atomic_load(&pubsub->waiting)) {
+        pthread_mutex_lock(&pubsub->wait_lock);
+        pthread_cond_signal(&pubsub->wait_cond);
+        pthread_mutex_unlock(&pubsub->wait_lock);
+    }
+}
+
+/* Helper: wait until a message is buffered or PUBSUB_WAIT_MS elapse */
+static void pubsub_wait(valkey_glide_pubsub_t* pubsub) {
+    struct timespec deadline;
+    clock_gettime(CLOCK_REALTIME, &deadline);
+    deadline.tv_nsec += PUBSUB_WAIT_MS * 1000000L;
+    if (deadline.tv_nsec >= 1000000000L) {
+        deadline.tv_sec += 1;
+        deadline.tv_nsec -= 1000000000L;
+    }
+
+    pthread_mutex_lock(&pubsub->wait_lock);
+    atomic_store(&pubsub->waiting, true);
+    /* Pairs with ring_push(): either it sees waiting, or this sees its message */
+    if (!ring_ready(pubsub)) {
+        pthread_cond_timedwait(&pubsub->wait_cond, &pubsub->wait_lock, &deadline);
+    }
+    atomic_store(&pubsub->waiting, false);
+    pthread_mutex_unlock(&pubsub->wait_lock);
+}
+
+/* Helper: warn once about the messages dropped since the last call */
+static void pubsub_report_dropped(valkey_glide_pubsub_t* pubsub) {
+    uint64_t dropped = atomic_exchange_explicit(&pubsub->dropped, 0, memory_order_relaxed);
+    if (dropped > 0) {
+        php_error_docref(NULL,
+                         E_WARNING,
+                         "%llu Pub/Sub messages were dropped because the buffer was full",
+                         (unsigned long long)dropped);
+    }
+}
+
+static size_t pubsub_subscription_count(valkey_glide_pubsub_t* pubsub) {
+    size_t count = 0;
+    for (int kind = 0; kind < PUBSUB_KINDS; kind++) {
+        count += zend_hash_num_elements(&pubsub->subscriptions[kind]);
+    }
+    return count;
+}
+
+/* Helper: make client the subscriber client, closing the previous one */
+static void pubsub_switch_client(valkey_glide_pubsub_t* pubsub, const void* client) {
+    const void* previous      = pubsub->subscriber_client;
+    pubsub->subscriber_client = client;
+
+    /* Closing the client stops its callbacks */
+    if (previous) {
+        close_glide_client(previous);
+    }
+}
+
+/*
+ * Helper: replace the subscriber client with one subscribed to the current subscriptions, or
+ * close it if there are none. The old client is closed once the new one is subscribed, so
+ * messages published meanwhile may be received twice, but none is missed.
+ * Returns false, keeping the old client, if the new one can't connect
+ */
+static bool pubsub_connect(valkey_glide_pubsub_t* pubsub) {
+    if (pubsub_subscription_count(pubsub) == 0) {
+        pubsub_switch_client(pubsub, NULL);
+        return true;
+    }
+
+    if (!pubsub->ring) {
+        pubsub->ring = calloc(pubsub->buffer_size, sizeof(pubsub_slot_t));
+        if (!pubsub->ring) {
+            return false;
+        }
+        for (size_t i = 0; i < pubsub->buffer_size; i++) {
+            atomic_init(&pubsub->ring[i].seq, i);
+        }
+        pubsub->ring_mask = pubsub->buffer_size - 1;
+    }
+
+    ConnectionRequest__PubSubChannelsOrPatterns                          lists[PUBSUB_KINDS];
+    ConnectionRequest__PubSubSubscriptions__ChannelsOrPatternsByTypeEntry entries[PUBSUB_KINDS];
+    ConnectionRequest__PubSubSubscriptions__ChannelsOrPatternsByTypeEntry* entry_ptrs[PUBSUB_KINDS];
+    ConnectionRequest__PubSubSubscriptions subscriptions =
+        CONNECTION_REQUEST__PUB_SUB_SUBSCRIPTIONS__INIT;
+    subscriptions.channels_or_patterns_by_type = entry_ptrs;
+
+    for (int kind = 0; kind < PUBSUB_KINDS; kind++) {
+        uint32_t count = zend_hash_num_elements(&pubsub->subscriptions[kind]);
+        if (count == 0) {
+            continue;
+        }
+
+        ConnectionRequest__PubSubChannelsOrPatterns list =
+            CONNECTION_REQUEST__PUB_SUB_CHANNELS_OR_PATTERNS__INIT;
+        list.channels_or_patterns = ecalloc(count, sizeof(ProtobufCBinaryData));
+
+        zend_string* name;
+        ZEND_HASH_FOREACH_STR_KEY(&pubsub->subscriptions[kind], name) {
+            ProtobufCBinaryData* item = &list.channels_or_patterns[list.n_channels_or_patterns++];
+            item->data                = (uint8_t*)ZSTR_VAL(name);
+            item->len                 = ZSTR_LEN(name);
+        }
+        ZEND_HASH_FOREACH_END();
+
+        size_t n = subscriptions.n_channels_or_patterns_by_type++;
+        lists[n] = list;
+        ConnectionRequest__PubSubSubscriptions__ChannelsOrPatternsByTypeEntry entry =
+            CONNECTION_REQUEST__PUB_SUB_SUBSCRIPTIONS__CHANNELS_OR_PATTERNS_BY_TYPE_ENTRY__INIT;
+        entry.key     = kind;
+        entry.value   = &lists[n];
+        entries[n]    = entry;
+        entry_ptrs[n] = &entries[n];
+    }
+
+    /* Messages pushed before create_client() returns already carry their destination */
+    const void* client = create_glide_subscriber_client(pubsub->request,
+                                                        pubsub->request_len,
+                                                        &subscriptions,
+                                                        pubsub_message_callback,
+                                                        (uintptr_t)pubsub);
+    if (client) {
+        pubsub_switch_client(pubsub, client);
+    }
+
+    for (size_t i = 0; i < subscriptions.n_channels_or_patterns_by_type; i++) {
+        efree(lists[i].channels_or_patterns);
+    }
+    return client != NULL;
+}
+
+valkey_glide_pubsub_t* valkey_glide_pubsub_create(
+    valkey_glide_client_configuration_t* config, long buffer_size) {
+    valkey_glide_pubsub_t* pubsub = calloc(1, sizeof(valkey_glide_pubsub_t));
+    if (!pubsub) {
+        return NULL;
+    }
+
+    /* The ring size is a power of 2, so that positions map to slots with a mask */
+    if (buffer_size > PUBSUB_MAX_BUFFER) {
+        buffer_size = PUBSUB_MAX_BUFFER;
+    }
+    pubsub->buffer_size = PUBSUB_MIN_BUFFER;
+    while ((long)pubsub->buffer_size < buffer_size) {
+        pubsub->buffer_size <<= 1;
+    }
+
+    size_t   len;
+    uint8_t* request = create_glide_connection_request(config, false, &len);
+    if (!request) {
+        free(pubsub);
+        return NULL;
+    }
+    pubsub->request = malloc(len);
+    if (!pubsub->request) {
+        efree(request);
+        free(pubsub);
+        return NULL;
+    }
+    memcpy(pubsub->request, request, len);
+    pubsub->request_len = len;
+    efree(request);
+
+    for (int kind = 0; kind < PUBSUB_KINDS; kind++) {
+        zend_hash_init(&pubsub->subscriptions[kind], 8, NULL, NULL, 1);
+    }
+    pthread_mutex_init(&pubsub->wait_lock, NULL);
+    pthread_cond_init(&pubsub->wait_cond, NULL);
+    return pubsub;
+}
+
+void valkey_glide_pubsub_free(valkey_glide_pubsub_t* pubsub) {
+    if (!pubsub) {
+        return;
+    }
+
+    pubsub_switch_client(pubsub, NULL);
+
+    pubsub_message_t* message;
+    while ((message = ring_pop(pubsub))) {
+        free(message);
+    }
+    for (int kind = 0; kind < PUBSUB_KINDS; kind++) {
+        zend_hash_destroy(&pubsub->subscriptions[kind]);
+    }
+    pthread_mutex_destroy(&pubsub->wait_lock);
+    pthread_cond_destroy(&pubsub->wait_cond);
+    free(pubsub->ring);
+    free(pubsub->request);
+    free(pubsub);
+}
+
+/* Helper: the message as ['kind' => ..., 'channel' => ..., 'message' => ..., 'pattern' => ...] */
+static void pubsub_message_to_zval(const pubsub_message_t* message, zval* z_message) {
+    array_init_size(z_message, 4);
+    add_assoc_string(z_message,
+                     "kind",
+                     message->kind == PushPMessage   ? "pmessage"
+                     : message->kind == PushSMessage ? "smessage"
+                                                     : "message");
+    add_assoc_stringl(z_message, "channel", message->data, message->channel_len);
+    add_assoc_stringl(
+        z_message, "message", message->data + message->channel_len, message->message_len);
+    if (message->kind == PushPMessage) {
+        add_assoc_stringl(z_message,
+                          "pattern",
+                          message->data + message->channel_len + message->message_len,
+                          message->pattern_len);
+    }
+}
+
+/*
+ * Helper: call cb for every message until nothing is subscribed, with ($valkey_glide, $channel,
+ * $message), or ($valkey_glide, $pattern, $channel, $message) for patterns.
+ * Returns 0 if the callback failed or threw
+ */
+static int pubsub_run_loop(valkey_glide_pubsub_t* pubsub,
+                           zval*                  object,
+                           zend_fcall_info*       fci,
+                           zend_fcall_info_cache* fcc) {
+    int status      = 1;
+    pubsub->in_loop = true;
+
+    while (pubsub_subscription_count(pubsub) > 0) {
+        pubsub_report_dropped(pubsub);
+        pubsub_message_t* message = ring_pop(pubsub);
+        if (!message) {
+            pubsub_wait(pubsub);
+            continue;
+        }
+
+        zval args[4];
+        int  arg_count = 0;
+        ZVAL_COPY(&args[arg_count++], object);
+        if (message->kind == PushPMessage) {
+            ZVAL_STRINGL(&args[arg_count++],
+                         message->data + message->channel_len + message->message_len,
+                         message->pattern_len);
+        }
+        ZVAL_STRINGL(&args[arg_count++], message->data, message->channel_len);
+        ZVAL_STRINGL(
+            &args[arg_count++], message->data + message->channel_len, message->message_len);
+        free(message);
+
+        zval retval;
+        ZVAL_UNDEF(&retval);
+        fci->retval      = &retval;
+        fci->params      = args;
+        fci->param_count = arg_count;
+        bool failed      = zend_call_function(fci, fcc) == FAILURE || EG(exception);
+
+        zval_ptr_dtor(&retval);
+        for (int i = 0; i < arg_count; i++) {
+            zval_ptr_dtor(&args[i]);
+        }
+        if (failed) {
+            status = 0;
+            break;
+        }
+    }
+
+    pubsub->in_loop = false;
+    return status;
+}
+
+int execute_subscribe_command(
+    zval* object, int argc, zval* return_value, zend_class_entry* ce, int kind) {
+    zval*                 z_channels;
+    zend_fcall_info       fci = empty_fcall_info;
+    zend_fcall_info_cache fcc = empty_fcall_info_cache;
+
+    if (zend_parse_method_parameters(argc, object, "Oa|f!", &object, ce, &z_channels, &fci, &fcc) ==
+        FAILURE) {
+        return 0;
+    }
+
+    valkey_glide_object* valkey_glide =
+        VALKEY_GLIDE_PHP_ZVAL_GET_OBJECT(valkey_glide_object, object);
+    if (!valkey_glide || !valkey_glide->pubsub) {
+        return 0;
+    }
+    valkey_glide_pubsub_t* pubsub = valkey_glide->pubsub;
+    HashTable*             set    = &pubsub->subscriptions[kind];
+
+    /* Remember the new names, to forget them if the subscription fails */
+    HashTable added;
+    zend_hash_init(&added, zend_hash_num_elements(Z_ARRVAL_P(z_channels)), NULL, NULL, 0);
+
+    zval* z_channel;
+    ZEND_HASH_FOREACH_VAL(Z_ARRVAL_P(z_channels), z_channel) {
+        zend_string* name = zval_get_string(z_channel);
+        if (zend_hash_str_add_empty_element(set, ZSTR_VAL(name), ZSTR_LEN(name))) {
+            zend_hash_add_empty_element(&added, name);
+        }
+        zend_string_release(name);
+    }
+    ZEND_HASH_FOREACH_END();
+
+    int status = 1;
+    if (zend_hash_num_elements(&added) > 0 && !pubsub_connect(pubsub)) {
+        zend_string* name;
+        ZEND_HASH_FOREACH_STR_KEY(&added, name) {
+            zend_hash_str_del(set, ZSTR_VAL(name), ZSTR_LEN(name));
+        }
+        ZEND_HASH_FOREACH_END();
+        status = 0;
+    }
+    zend_hash_destroy(&added);
+
+    /* A callback given from within the loop joins it instead of nesting another */
+    if (status && ZEND_FCI_INITIALIZED(fci) && !pubsub->in_loop) {
+        status = pubsub_run_loop(pubsub, object, &fci, &fcc);
+    }
+
+    ZVAL_BOOL(return_value, status);
+    return 1;
+}
+
+int execute_unsubscribe_command(
+    zval* object, int argc, zval* return_value, zend_class_entry* ce, int kind) {
+    zval* z_channels;
+
+    if (zend_parse_method_parameters(argc, object, "Oa", &object, ce, &z_channels) == FAILURE) {
+        return 0;
+    }
+
+    valkey_glide_object* valkey_glide =
+        VALKEY_GLIDE_PHP_ZVAL_GET_OBJECT(valkey_glide_object, object);
+    if (!valkey_glide || !valkey_glide->pubsub) {
+        return 0;
+    }
+    valkey_glide_pubsub_t* pubsub = valkey_glide->pubsub;
+    HashTable*             set    = &pubsub->subscriptions[kind];
+    uint32_t               before = zend_hash_num_elements(set);
+
+    /* channel => whether it was subscribed; no channel at all means every one */
+    array_init(return_value);
+    if (zend_hash_num_elements(Z_ARRVAL_P(z_channels)) == 0) {
+        zend_string* name;
+        ZEND_HASH_FOREACH_STR_KEY(set, name) {
+            add_assoc_bool_ex(return_value, ZSTR_VAL(name), ZSTR_LEN(name), 1);
+        }
+        ZEND_HASH_FOREACH_END();
+        zend_hash_clean(set);
+    } else {
+        zval* z_channel;
+        ZEND_HASH_FOREACH_VAL(Z_ARRVAL_P(z_channels), z_channel) {
+            zend_string* name = zval_get_string(z_channel);
+            add_assoc_bool_ex(return_value,
+                              ZSTR_VAL(name),
+                              ZSTR_LEN(name),
+                              zend_hash_str_del(set, ZSTR_VAL(name), ZSTR_LEN(name)) == SUCCESS);
+            zend_string_release(name);
+        }
+        ZEND_HASH_FOREACH_END();
+    }
+
+    if (zend_hash_num_elements(set) != before && !pubsub_connect(pubsub)) {
+        zval_ptr_dtor(return_value);
+        return 0;
+    }
+    return 1;
+}
+
+int execute_get_messages_command(zval* object, int argc, zval* return_value, zend_class_entry* ce) {
+    zend_long max = 1000;
+
+    if (zend_parse_method_parameters(argc, object, "O|l", &object, ce, &max) == FAILURE) {
+        return 0;
+    }
+
+    valkey_glide_object* valkey_glide =
+        VALKEY_GLIDE_PHP_ZVAL_GET_OBJECT(valkey_glide_object, object);
+    if (!valkey_glide || !valkey_glide->pubsub) {
+        return 0;
+    }
+    valkey_glide_pubsub_t* pubsub = valkey_glide->pubsub;
+
+    pubsub_report_dropped(pubsub);
+    array_init(return_value);
+    pubsub_message_t* message;
+    for (zend_long i = 0; i < max && (message = ring_pop(pubsub)); i++) {
+        zval z_message;
+        pubsub_message_to_zval(message, &z_message);
+        add_next_index_zval(return_value, &z_message);
+        free(message);
+    }
+    return 1;
+}
+
+int execute_publish_command(zval* object, int argc, zval* return_value, zend_class_entry* ce) {
+    valkey_glide_object* valkey_glide;
+    char *               channel = NULL, *message = NULL;
+    size_t               channel_len = 0, message_len = 0;
+    long                 result_value = 0;
+
+    if (zend_parse_method_parameters(
+            argc, object, "Oss", &object, ce, &channel, &channel_len, &message, &message_len) ==
+        FAILURE) {
+        return 0;
+    }
+
+    valkey_glide = VALKEY_GLIDE_PHP_ZVAL_GET_OBJECT(valkey_glide_object, object);
+    if (!valkey_glide || !valkey_glide->glide_client) {
+        return 0;
+    }
+
+    core_command_args_t args = {0};
+    args.glide_client        = valkey_glide->glide_client;
+    args.cmd_type            = Publish;
+    args.key                 = channel;
+    args.key_len             = channel_len;
+
+    args.args[0].type                  = CORE_ARG_TYPE_STRING;
+    args.args[0].data.string_arg.value = message;
+    args.args[0].data.string_arg.len   = message_len;
+    args.arg_count                     = 1;
+
+    if (execute_core_command(&args, &result_value, process_core_int_result)) {
+        ZVAL_LONG(return_value, result_value);
+        return 1;
+    }
+    return 0;
+}
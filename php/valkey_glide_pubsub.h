@@ -0,0 +1,57 @@
+/*
+  +----------------------------------------------------------------------+
+  | Copyright (c) 2023-2025 The PHP Group                                |
+  +----------------------------------------------------------------------+
+  | This source file is subject to version 3.01 of the PHP license,      |
+  | that is bundled with this package in the file LICENSE, and is        |
+  | available through the world-wide-web at the following url:           |
+  | http://www.php.net/license/3_01.txt                                  |
+  | If you did not receive a copy of the PHP license and are unable to   |
+  | obtain it through the world-wide-web, please send a note to          |
+  | license@php.net so we can mail you a copy immediately.               |
+  +----------------------------------------------------------------------+
+*/
+
+#ifndef VALKEY_GLIDE_PUBSUB_H
+#define VALKEY_GLIDE_PUBSUB_H
+
+#include "common.h"
+
+/*
+ * Pub/Sub for the standalone client.
+ *
+ * Subscriptions are set when a connection is created, so each ValkeyGlide object subscribes
+ * through a dedicated subscriber client, which is replaced whenever the subscriptions change.
+ * The client thread receiving the messages copies them into a bounded ring buffer; PHP drains
+ * it either from the blocking loop of subscribe() or with getMessages(), which never waits.
+ * Messages arriving while the buffer is full are dropped and reported by a warning.
+ */
+
+/* Subscription kinds, numbered as PubSubChannelType in connection_request.proto */
+#define VALKEY_GLIDE_PUBSUB_EXACT 0
+#define VALKEY_GLIDE_PUBSUB_PATTERN 1
+#define VALKEY_GLIDE_PUBSUB_SHARDED 2
+
+/* Messages buffered per client when the 'pubsub_buffer_size' advanced option is not set */
+#define VALKEY_GLIDE_PUBSUB_DEFAULT_BUFFER 16384
+
+/*
+ * Keep what the client needs to open subscriber clients later. buffer_size is rounded up to a
+ * power of 2 and capped at 1048576 messages. Memory is persistent
+ */
+valkey_glide_pubsub_t* valkey_glide_pubsub_create(
+    valkey_glide_client_configuration_t* config, long buffer_size);
+/* Close the subscriber client and release the buffered messages */
+void valkey_glide_pubsub_free(valkey_glide_pubsub_t* pubsub);
+
+/* subscribe(), psubscribe() and ssubscribe(), blocking in the callback loop if one is given */
+int execute_subscribe_command(
+    zval* object, int argc, zval* return_value, zend_class_entry* ce, int kind);
+/* unsubscribe(), punsubscribe() and sunsubscribe() */
+int execute_unsubscribe_command(
+    zval* object, int argc, zval* return_value, zend_class_entry* ce, int kind);
+/* getMessages(): up to max buffered messages, without waiting */
+int execute_get_messages_command(zval* object, int argc, zval* return_value, zend_class_entry* ce);
+int execute_publish_command(zval* object, int argc, zval* return_value, zend_class_entry* ce);
+
+#endif /* VALKEY_GLIDE_PUBSUB_H */
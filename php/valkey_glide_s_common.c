@@ -19,42 +19,10 @@
 #include "command_response.h"
 #include "common.h"
 
-/* Import the string conversion functions from command_response.c */
-extern char* long_to_string(long value, size_t* len);
-extern char* double_to_string(double value, size_t* len);
-
 /* ====================================================================
  * UTILITY FUNCTIONS
  * ==================================================================== */
 
-/**
- * Allocate command arguments arrays
- */
-int allocate_s_command_args(int count, uintptr_t** args_out, unsigned long** args_len_out) {
-    *args_out     = (uintptr_t*)emalloc(count * sizeof(uintptr_t));
-    *args_len_out = (unsigned long*)emalloc(count * sizeof(unsigned long));
-
-    if (!*args_out || !*args_len_out) {
-        if (*args_out)
-            efree(*args_out);
-        if (*args_len_out)
-            efree(*args_len_out);
-        return 0;
-    }
-
-    return 1;
-}
-
-/**
- * Free command arguments arrays
- */
-void cleanup_s_command_args(uintptr_t* args, unsigned long* args_len) {
-    if (args)
-        efree(args);
-    if (args_len)
-        efree(args_len);
-}
-
 /**
  * Convert a single zval to string with proper cleanup handling
  */
@@ -92,10 +60,13 @@ int convert_single_zval_to_string(zval*        input,
 /**
  * Convert array of zvals to string arguments
  */
-int convert_zval_to_string_args(
-    zval* input, int count, uintptr_t** args_out, unsigned long** args_len_out, int offset) {
-    int  i;
-    zval temp;
+int convert_zval_to_string_args(zval*           input,
+                                int             count,
+                                arg_arena_t*    arena,
+                                uintptr_t**     args_out,
+                                unsigned long** args_len_out,
+                                int             offset) {
+    int i;
 
     for (i = 0; i < count; i++) {
         zval* element = &input[i];
@@ -103,35 +74,20 @@ int convert_zval_to_string_args(
         if (Z_TYPE_P(element) == IS_STRING) {
             (*args_out)[offset + i]     = (uintptr_t)Z_STRVAL_P(element);
             (*args_len_out)[offset + i] = Z_STRLEN_P(element);
-        } else if (Z_TYPE_P(element) == IS_OBJECT) {
-            /* Handle object conversion specially */
-            zval tmp_zval;
-            ZVAL_COPY(&tmp_zval, element);
-            zend_std_cast_object_tostring(&tmp_zval, &tmp_zval, IS_STRING);
-
-            /* Create a permanent copy of the string before freeing the zval */
-            size_t str_len  = Z_STRLEN(tmp_zval);
-            char*  str_copy = emalloc(str_len + 1);
-            memcpy(str_copy, Z_STRVAL(tmp_zval), str_len);
-            str_copy[str_len] = '\0';
-
-            (*args_out)[offset + i]     = (uintptr_t)str_copy;
-            (*args_len_out)[offset + i] = str_len;
-            zval_dtor(&tmp_zval);
-        } else {
-            /* Convert other types to string */
-            ZVAL_COPY(&temp, element);
-            convert_to_string(&temp);
+        } else if (Z_TYPE_P(element) == IS_LONG) {
+            size_t len;
+            char*  str = arena_long_to_string(arena, Z_LVAL_P(element), &len);
 
-            /* Create a permanent copy of the string before freeing the zval */
-            size_t str_len  = Z_STRLEN(temp);
-            char*  str_copy = emalloc(str_len + 1);
-            memcpy(str_copy, Z_STRVAL(temp), str_len);
-            str_copy[str_len] = '\0';
+            (*args_out)[offset + i]     = (uintptr_t)str;
+            (*args_len_out)[offset + i] = len;
+        } else {
+            /* Objects go through __toString(), other types through PHP's string conversion */
+            zend_string* str  = zval_get_string(element);
+            char*        copy = arena_strndup(arena, ZSTR_VAL(str), ZSTR_LEN(str));
 
-            (*args_out)[offset + i]     = (uintptr_t)str_copy;
-            (*args_len_out)[offset + i] = str_len;
-            zval_dtor(&temp);
+            (*args_out)[offset + i]     = (uintptr_t)copy;
+            (*args_len_out)[offset + i] = ZSTR_LEN(str);
+            zend_string_release(str);
         }
     }
 
@@ -162,6 +118,7 @@ char* alloc_long_string(long value, size_t* len_out) {
  * Prepare arguments for key + members commands (SADD, SREM, SMISMEMBER)
  */
 int prepare_s_key_members_args(s_command_args_t* args,
+                               arg_arena_t*      arena,
                                uintptr_t**       args_out,
                                unsigned long**   args_len_out) {
     if (!args->glide_client || !args->key || args->key_len == 0 || !args->members ||
@@ -171,7 +128,7 @@ int prepare_s_key_members_args(s_command_args_t* args,
 
     unsigned long arg_count = 1 + args->members_count; /* key + members */
 
-    if (!allocate_s_command_args(arg_count, args_out, args_len_out)) {
+    if (!arena_alloc_args(arena, arg_count, args_out, args_len_out)) {
         return 0;
     }
 
@@ -180,7 +137,8 @@ int prepare_s_key_members_args(s_command_args_t* args,
     (*args_len_out)[0] = args->key_len;
 
     /* Convert and set member arguments */
-    convert_zval_to_string_args(args->members, args->members_count, args_out, args_len_out, 1);
+    convert_zval_to_string_args(
+        args->members, args->members_count, arena, args_out, args_len_out, 1);
 
     return arg_count;
 }
@@ -189,13 +147,14 @@ int prepare_s_key_members_args(s_command_args_t* args,
  * Prepare arguments for key-only commands (SCARD, SMEMBERS)
  */
 int prepare_s_key_only_args(s_command_args_t* args,
+                            arg_arena_t*      arena,
                             uintptr_t**       args_out,
                             unsigned long**   args_len_out) {
     if (!args->glide_client || !args->key || args->key_len == 0) {
         return 0;
     }
 
-    if (!allocate_s_command_args(1, args_out, args_len_out)) {
+    if (!arena_alloc_args(arena, 1, args_out, args_len_out)) {
         return 0;
     }
 
@@ -209,6 +168,7 @@ int prepare_s_key_only_args(s_command_args_t* args,
  * Prepare arguments for key + member commands (SISMEMBER)
  */
 int prepare_s_key_member_args(s_command_args_t* args,
+                              arg_arena_t*      arena,
                               uintptr_t**       args_out,
                               unsigned long**   args_len_out) {
     if (!args->glide_client || !args->key || args->key_len == 0 || !args->member ||
@@ -216,7 +176,7 @@ int prepare_s_key_member_args(s_command_args_t* args,
         return 0;
     }
 
-    if (!allocate_s_command_args(2, args_out, args_len_out)) {
+    if (!arena_alloc_args(arena, 2, args_out, args_len_out)) {
         return 0;
     }
 
@@ -232,6 +192,7 @@ int prepare_s_key_member_args(s_command_args_t* args,
  * Prepare arguments for key + count commands (SPOP, SRANDMEMBER)
  */
 int prepare_s_key_count_args(s_command_args_t* args,
+                             arg_arena_t*      arena,
                              uintptr_t**       args_out,
                              unsigned long**   args_len_out) {
     if (!args->glide_client || !args->key || args->key_len == 0) {
@@ -240,7 +201,7 @@ int prepare_s_key_count_args(s_command_args_t* args,
 
     unsigned long arg_count = args->has_count ? 2 : 1;
 
-    if (!allocate_s_command_args(arg_count, args_out, args_len_out)) {
+    if (!arena_alloc_args(arena, arg_count, args_out, args_len_out)) {
         return 0;
     }
 
@@ -248,13 +209,11 @@ int prepare_s_key_count_args(s_command_args_t* args,
     (*args_len_out)[0] = args->key_len;
 
     if (args->has_count) {
-        char* count_str = alloc_long_string(args->count, NULL);
-        if (!count_str) {
-            cleanup_s_command_args(*args_out, *args_len_out);
-            return 0;
-        }
+        size_t count_len;
+        char*  count_str = arena_long_to_string(arena, args->count, &count_len);
+
         (*args_out)[1]     = (uintptr_t)count_str;
-        (*args_len_out)[1] = strlen(count_str);
+        (*args_len_out)[1] = count_len;
     }
 
     return arg_count;
@@ -264,17 +223,18 @@ int prepare_s_key_count_args(s_command_args_t* args,
  * Prepare arguments for multi-key commands (SINTER, SUNION, SDIFF)
  */
 int prepare_s_multi_key_args(s_command_args_t* args,
+                             arg_arena_t*      arena,
                              uintptr_t**       args_out,
                              unsigned long**   args_len_out) {
     if (!args->glide_client || !args->keys || args->keys_count <= 0) {
         return 0;
     }
 
-    if (!allocate_s_command_args(args->keys_count, args_out, args_len_out)) {
+    if (!arena_alloc_args(arena, args->keys_count, args_out, args_len_out)) {
         return 0;
     }
 
-    convert_zval_to_string_args(args->keys, args->keys_count, args_out, args_len_out, 0);
+    convert_zval_to_string_args(args->keys, args->keys_count, arena, args_out, args_len_out, 0);
 
     return args->keys_count;
 }
@@ -283,6 +243,7 @@ int prepare_s_multi_key_args(s_command_args_t* args,
  * Prepare arguments for multi-key + limit commands (SINTERCARD)
  */
 int prepare_s_multi_key_limit_args(s_command_args_t* args,
+                                   arg_arena_t*      arena,
                                    uintptr_t**       args_out,
                                    unsigned long**   args_len_out) {
     if (!args->glide_client || !args->keys || args->keys_count <= 0) {
@@ -292,35 +253,30 @@ int prepare_s_multi_key_limit_args(s_command_args_t* args,
     unsigned long arg_count =
         1 + args->keys_count + (args->has_limit ? 2 : 0); /* numkeys + keys + [LIMIT value] */
 
-    if (!allocate_s_command_args(arg_count, args_out, args_len_out)) {
+    if (!arena_alloc_args(arena, arg_count, args_out, args_len_out)) {
         return 0;
     }
 
     /* First argument is the number of keys */
-    char* numkeys_str = alloc_long_string(args->keys_count, NULL);
-    if (!numkeys_str) {
-        cleanup_s_command_args(*args_out, *args_len_out);
-        return 0;
-    }
+    size_t numkeys_len;
+    char*  numkeys_str = arena_long_to_string(arena, args->keys_count, &numkeys_len);
+
     (*args_out)[0]     = (uintptr_t)numkeys_str;
-    (*args_len_out)[0] = strlen(numkeys_str);
+    (*args_len_out)[0] = numkeys_len;
 
     /* Add keys */
-    convert_zval_to_string_args(args->keys, args->keys_count, args_out, args_len_out, 1);
+    convert_zval_to_string_args(args->keys, args->keys_count, arena, args_out, args_len_out, 1);
 
     /* Add LIMIT if specified */
     if (args->has_limit) {
         (*args_out)[1 + args->keys_count]     = (uintptr_t)"LIMIT";
         (*args_len_out)[1 + args->keys_count] = 5;
 
-        char* limit_str = alloc_long_string(args->limit, NULL);
-        if (!limit_str) {
-            efree((void*)(*args_out)[0]); /* Free numkeys_str */
-            cleanup_s_command_args(*args_out, *args_len_out);
-            return 0;
-        }
+        size_t limit_len;
+        char*  limit_str = arena_long_to_string(arena, args->limit, &limit_len);
+
         (*args_out)[2 + args->keys_count]     = (uintptr_t)limit_str;
-        (*args_len_out)[2 + args->keys_count] = strlen(limit_str);
+        (*args_len_out)[2 + args->keys_count] = limit_len;
     }
 
     return arg_count;
@@ -330,6 +286,7 @@ int prepare_s_multi_key_limit_args(s_command_args_t* args,
  * Prepare arguments for destination + multi-key commands (SINTERSTORE, SUNIONSTORE, SDIFFSTORE)
  */
 int prepare_s_dst_multi_key_args(s_command_args_t* args,
+                                 arg_arena_t*      arena,
                                  uintptr_t**       args_out,
                                  unsigned long**   args_len_out) {
     if (!args->glide_client || !args->dst_key || args->dst_key_len == 0 || !args->keys ||
@@ -339,7 +296,7 @@ int prepare_s_dst_multi_key_args(s_command_args_t* args,
 
     unsigned long arg_count = 1 + args->keys_count; /* destination + keys */
 
-    if (!allocate_s_command_args(arg_count, args_out, args_len_out)) {
+    if (!arena_alloc_args(arena, arg_count, args_out, args_len_out)) {
         return 0;
     }
 
@@ -348,7 +305,7 @@ int prepare_s_dst_multi_key_args(s_command_args_t* args,
     (*args_len_out)[0] = args->dst_key_len;
 
     /* Add source keys */
-    convert_zval_to_string_args(args->keys, args->keys_count, args_out, args_len_out, 1);
+    convert_zval_to_string_args(args->keys, args->keys_count, arena, args_out, args_len_out, 1);
 
     return arg_count;
 }
@@ -357,6 +314,7 @@ int prepare_s_dst_multi_key_args(s_command_args_t* args,
  * Prepare arguments for two-key + member commands (SMOVE)
  */
 int prepare_s_two_key_member_args(s_command_args_t* args,
+                                  arg_arena_t*      arena,
                                   uintptr_t**       args_out,
                                   unsigned long**   args_len_out) {
     if (!args->glide_client || !args->src_key || args->src_key_len == 0 || !args->dst_key ||
@@ -364,7 +322,7 @@ int prepare_s_two_key_member_args(s_command_args_t* args,
         return 0;
     }
 
-    if (!allocate_s_command_args(3, args_out, args_len_out)) {
+    if (!arena_alloc_args(arena, 3, args_out, args_len_out)) {
         return 0;
     }
 
@@ -382,6 +340,7 @@ int prepare_s_two_key_member_args(s_command_args_t* args,
  * Prepare arguments for scan commands (SCAN, SSCAN)
  */
 int prepare_s_scan_args(s_command_args_t* args,
+                        arg_arena_t*      arena,
                         uintptr_t**       args_out,
                         unsigned long**   args_len_out) {
     if (!args->glide_client || !args->cursor) {
@@ -396,7 +355,7 @@ int prepare_s_scan_args(s_command_args_t* args,
     unsigned long arg_count =
         (has_key ? 1 : 0) + 1 + (has_pattern ? 2 : 0) + (has_count ? 2 : 0) + (has_type ? 2 : 0);
 
-    if (!allocate_s_command_args(arg_count, args_out, args_len_out)) {
+    if (!arena_alloc_args(arena, arg_count, args_out, args_len_out)) {
         return 0;
     }
 
@@ -433,14 +392,11 @@ int prepare_s_scan_args(s_command_args_t* args,
         (*args_len_out)[arg_idx] = 5;
         arg_idx++;
 
-        char* count_str = alloc_long_string(args->count, NULL);
-        if (!count_str) {
-            efree((void*)(*args_out)[has_key ? 1 : 0]); /* Free cursor_str */
-            cleanup_s_command_args(*args_out, *args_len_out);
-            return 0;
-        }
+        size_t count_len;
+        char*  count_str = arena_long_to_string(arena, args->count, &count_len);
+
         (*args_out)[arg_idx]     = (uintptr_t)count_str;
-        (*args_len_out)[arg_idx] = strlen(count_str);
+        (*args_len_out)[arg_idx] = count_len;
         arg_idx++;
     }
 
@@ -461,13 +417,14 @@ int prepare_s_scan_args(s_command_args_t* args,
  * Prepare arguments for server commands
  */
 int prepare_s_server_args(s_command_args_t* args,
+                          arg_arena_t*      arena,
                           uintptr_t**       args_out,
                           unsigned long**   args_len_out) {
     if (!args->glide_client) {
         return 0;
     }
 
-    if (!allocate_s_command_args(1, args_out, args_len_out)) {
+    if (!arena_alloc_args(arena, 1, args_out, args_len_out)) {
         return 0;
     }
 
@@ -634,12 +591,11 @@ int process_s_scan_response(CommandResult*    result,
 
         /* If there are elements in this final batch, return them using robust conversion */
         if (elements_resp->array_value_len > 0) {
-            return command_response_to_zval(elements_resp,
-                                            return_value,
-                                            (cmd_type == HScan || cmd_type == ZScan)
-                                                ? COMMAND_RESPONSE_SCAN_ASSOSIATIVE_ARRAY
-                                                : COMMAND_RESPONSE_NOT_ASSOSIATIVE,
-                                            false);
+            if (cmd_type == HScan || cmd_type == ZScan) {
+                return command_response_consume_pairs(elements_resp, return_value, NULL);
+            }
+            return command_response_to_zval(
+                elements_resp, return_value, COMMAND_RESPONSE_NOT_ASSOSIATIVE, false);
         } else {
             /* No elements in final batch - return FALSE to terminate loop */
             array_init(return_value);
@@ -659,13 +615,12 @@ int process_s_scan_response(CommandResult*    result,
     (*args->cursor)[cursor_len] = '\0';
 
 
-    /* Use command_response_to_zval for robust element processing */
-    return command_response_to_zval(elements_resp,
-                                    return_value,
-                                    (cmd_type == HScan || cmd_type == ZScan)
-                                        ? COMMAND_RESPONSE_SCAN_ASSOSIATIVE_ARRAY
-                                        : COMMAND_RESPONSE_NOT_ASSOSIATIVE,
-                                    false);
+    /* Field/value pairs go straight into an associative array */
+    if (cmd_type == HScan || cmd_type == ZScan) {
+        return command_response_consume_pairs(elements_resp, return_value, NULL);
+    }
+    return command_response_to_zval(
+        elements_resp, return_value, COMMAND_RESPONSE_NOT_ASSOSIATIVE, false);
 }
 
 /* ====================================================================
@@ -686,46 +641,49 @@ int execute_s_generic_command(const void*          glide_client,
     int            arg_count = 0;
     int            status    = 0;
     CommandResult* result    = NULL;
+    arg_arena_t    arena;
 
     /* Validate basic parameters */
     if (!glide_client || !args) {
         return 0;
     }
 
+    arena_init(&arena);
+
     /* Prepare arguments based on category */
     switch (category) {
         case S_CMD_KEY_MEMBERS:
-            arg_count = prepare_s_key_members_args(args, &cmd_args, &args_len);
+            arg_count = prepare_s_key_members_args(args, &arena, &cmd_args, &args_len);
             break;
         case S_CMD_KEY_ONLY:
-            arg_count = prepare_s_key_only_args(args, &cmd_args, &args_len);
+            arg_count = prepare_s_key_only_args(args, &arena, &cmd_args, &args_len);
             break;
         case S_CMD_KEY_MEMBER:
-            arg_count = prepare_s_key_member_args(args, &cmd_args, &args_len);
+            arg_count = prepare_s_key_member_args(args, &arena, &cmd_args, &args_len);
             break;
         case S_CMD_KEY_COUNT:
-            arg_count = prepare_s_key_count_args(args, &cmd_args, &args_len);
+            arg_count = prepare_s_key_count_args(args, &arena, &cmd_args, &args_len);
             break;
         case S_CMD_MULTI_KEY:
-            arg_count = prepare_s_multi_key_args(args, &cmd_args, &args_len);
+            arg_count = prepare_s_multi_key_args(args, &arena, &cmd_args, &args_len);
             break;
         case S_CMD_MULTI_KEY_LIMIT:
-            arg_count = prepare_s_multi_key_limit_args(args, &cmd_args, &args_len);
+            arg_count = prepare_s_multi_key_limit_args(args, &arena, &cmd_args, &args_len);
             break;
         case S_CMD_DST_MULTI_KEY:
-            arg_count = prepare_s_dst_multi_key_args(args, &cmd_args, &args_len);
+            arg_count = prepare_s_dst_multi_key_args(args, &arena, &cmd_args, &args_len);
             break;
         case S_CMD_TWO_KEY_MEMBER:
-            arg_count = prepare_s_two_key_member_args(args, &cmd_args, &args_len);
+            arg_count = prepare_s_two_key_member_args(args, &arena, &cmd_args, &args_len);
             break;
         case S_CMD_SCAN:
-            arg_count = prepare_s_scan_args(args, &cmd_args, &args_len);
+            arg_count = prepare_s_scan_args(args, &arena, &cmd_args, &args_len);
             break;
         case S_CMD_SERVER:
-            arg_count = prepare_s_server_args(args, &cmd_args, &args_len);
+            arg_count = prepare_s_server_args(args, &arena, &cmd_args, &args_len);
             break;
         default:
-            return 0;
+            break;
     }
 
     if (arg_count <= 0 || !cmd_args || !args_len) {
@@ -765,63 +723,7 @@ int execute_s_generic_command(const void*          glide_client,
     }
 
 cleanup:
-    /* Clean up allocated strings for specific categories */
-    if (cmd_args && args_len) {
-        if (category == S_CMD_KEY_COUNT && args->has_count && arg_count > 1) {
-            efree((void*)cmd_args[1]); /* Free count string */
-        } else if (category == S_CMD_MULTI_KEY_LIMIT) {
-            efree((void*)cmd_args[0]); /* Free numkeys string */
-            if (args->has_limit && arg_count > 2 + args->keys_count) {
-                efree((void*)cmd_args[2 + args->keys_count]); /* Free limit string */
-            }
-        } else if (category == S_CMD_SCAN) {
-            /* No need to free cursor string anymore - it's directly referenced */
-            if (args->has_count) {
-                /* Find and free count string */
-                int has_key   = (args->key && args->key_len > 0);
-                int count_idx = (has_key ? 1 : 0) + 1 + (args->pattern ? 2 : 0) + 1;
-                if (count_idx < arg_count) {
-                    efree((void*)cmd_args[count_idx]);
-                }
-            }
-        }
-
-        /* Clean up allocated strings from convert_zval_to_string_args for member-based commands */
-        if (category == S_CMD_KEY_MEMBERS || category == S_CMD_MULTI_KEY ||
-            category == S_CMD_DST_MULTI_KEY) {
-            int start_idx = 0, count = 0;
-
-            if (category == S_CMD_KEY_MEMBERS) {
-                start_idx = 1; /* Skip key, clean up member strings */
-                count     = args->members_count;
-            } else if (category == S_CMD_MULTI_KEY) {
-                start_idx = 0; /* Clean up all key strings */
-                count     = args->keys_count;
-            } else if (category == S_CMD_DST_MULTI_KEY) {
-                start_idx = 1; /* Skip destination key, clean up source key strings */
-                count     = args->keys_count;
-            }
-
-            /* Free converted strings - check if they were allocated by our conversion function */
-            for (int i = 0; i < count && (start_idx + i) < arg_count; i++) {
-                /* Only free if it's not pointing to original string data */
-                if (args->members && category == S_CMD_KEY_MEMBERS) {
-                    zval* element = &args->members[i];
-                    if (Z_TYPE_P(element) != IS_STRING && cmd_args[start_idx + i] != 0) {
-                        efree((void*)cmd_args[start_idx + i]);
-                    }
-                } else if (args->keys &&
-                           (category == S_CMD_MULTI_KEY || category == S_CMD_DST_MULTI_KEY)) {
-                    zval* element = &args->keys[i];
-                    if (Z_TYPE_P(element) != IS_STRING && cmd_args[start_idx + i] != 0) {
-                        efree((void*)cmd_args[start_idx + i]);
-                    }
-                }
-            }
-        }
-    }
-
-    cleanup_s_command_args(cmd_args, args_len);
+    arena_free(&arena);
     return status;
 }
 
@@ -2148,14 +2050,12 @@ int execute_cluster_scan_command(const void* glide_client,
     if (has_type && type && type_len > 0)
         arg_count += 2; /* TYPE + type_value */
 
-    uintptr_t*     args      = NULL;
-    unsigned long* args_len  = NULL;
-    char*          count_str = NULL;
-
-    if (arg_count > 0) {
-        args     = emalloc(arg_count * sizeof(uintptr_t));
-        args_len = emalloc(arg_count * sizeof(unsigned long));
+    uintptr_t*     args     = NULL;
+    unsigned long* args_len = NULL;
+    arg_arena_t    arena;
 
+    arena_init(&arena);
+    if (arena_alloc_args(&arena, arg_count, &args, &args_len)) {
         int idx = 0;
 
         /* Add MATCH pattern */
@@ -2170,17 +2070,14 @@ int execute_cluster_scan_command(const void* glide_client,
 
         /* Add COUNT */
         if (has_count) {
-            count_str = alloc_long_string(count, NULL);
-            if (!count_str) {
-                efree(args);
-                efree(args_len);
-                return 0;
-            }
+            size_t count_len;
+            char*  count_str = arena_long_to_string(&arena, count, &count_len);
+
             args[idx]     = (uintptr_t)"COUNT";
             args_len[idx] = 5;
             idx++;
             args[idx]     = (uintptr_t)count_str;
-            args_len[idx] = strlen(count_str);
+            args_len[idx] = count_len;
             idx++;
         }
 
@@ -2217,17 +2114,7 @@ int execute_cluster_scan_command(const void* glide_client,
         free_command_result(result);
     }
 
-    /* Cleanup */
-    if (count_str) {
-        efree(count_str);
-    }
-    if (args) {
-        efree(args);
-    }
-    if (args_len) {
-        efree(args_len);
-    }
-
+    arena_free(&arena);
     return success;
 }
 
@@ -23,6 +23,7 @@
 
 #include "command_response.h"
 #include "include/glide_bindings.h"
+#include "valkey_glide_arena.h"
 #include "valkey_glide_commands_common.h"
 
 /* ====================================================================
@@ -134,31 +135,43 @@ int execute_s_generic_command(const void*          glide_client,
 
 /* Argument preparation functions */
 int prepare_s_key_members_args(s_command_args_t* args,
+                               arg_arena_t*      arena,
                                uintptr_t**       args_out,
                                unsigned long**   args_len_out);
 int prepare_s_key_only_args(s_command_args_t* args,
+                            arg_arena_t*      arena,
                             uintptr_t**       args_out,
                             unsigned long**   args_len_out);
 int prepare_s_key_member_args(s_command_args_t* args,
+                              arg_arena_t*      arena,
                               uintptr_t**       args_out,
                               unsigned long**   args_len_out);
 int prepare_s_key_count_args(s_command_args_t* args,
+                             arg_arena_t*      arena,
                              uintptr_t**       args_out,
                              unsigned long**   args_len_out);
 int prepare_s_multi_key_args(s_command_args_t* args,
+                             arg_arena_t*      arena,
                              uintptr_t**       args_out,
                              unsigned long**   args_len_out);
 int prepare_s_multi_key_limit_args(s_command_args_t* args,
+                                   arg_arena_t*      arena,
                                    uintptr_t**       args_out,
                                    unsigned long**   args_len_out);
 int prepare_s_dst_multi_key_args(s_command_args_t* args,
+                                 arg_arena_t*      arena,
                                  uintptr_t**       args_out,
                                  unsigned long**   args_len_out);
 int prepare_s_two_key_member_args(s_command_args_t* args,
+                                  arg_arena_t*      arena,
                                   uintptr_t**       args_out,
                                   unsigned long**   args_len_out);
-int prepare_s_scan_args(s_command_args_t* args, uintptr_t** args_out, unsigned long** args_len_out);
+int prepare_s_scan_args(s_command_args_t* args,
+                        arg_arena_t*      arena,
+                        uintptr_t**       args_out,
+                        unsigned long**   args_len_out);
 int prepare_s_server_args(s_command_args_t* args,
+                          arg_arena_t*      arena,
                           uintptr_t**       args_out,
                           unsigned long**   args_len_out);
 
@@ -174,10 +187,12 @@ int process_s_scan_response(CommandResult*    result,
                             zval*             return_value);
 
 /* Utility functions */
-int  allocate_s_command_args(int count, uintptr_t** args_out, unsigned long** args_len_out);
-void cleanup_s_command_args(uintptr_t* args, unsigned long* args_len);
-int  convert_zval_to_string_args(
-     zval* input, int count, uintptr_t** args_out, unsigned long** args_len_out, int offset);
+int   convert_zval_to_string_args(zval*           input,
+                                  int             count,
+                                  arg_arena_t*    arena,
+                                  uintptr_t**     args_out,
+                                  unsigned long** args_len_out,
+                                  int             offset);
 int   convert_single_zval_to_string(zval*        input,
                                     const char** str_out,
                                     size_t*      len_out,
@@ -0,0 +1,497 @@
+/*
+  +----------------------------------------------------------------------+
+  | Copyright (c) 2023-2025 The PHP Group                                |
+  +----------------------------------------------------------------------+
+  | This source file is subject to version 3.01 of the PHP license,      |
+  | that is bundled with this package in the file LICENSE, and is        |
+  | available through the world-wide-web at the following url:           |
+  | http://www.php.net/license/3_01.txt                                  |
+  | If you did not receive a copy of the PHP license and are unable to   |
+  | obtain it through the world-wide-web, please send a note to          |
+  | license@php.net so we can mail you a copy immediately.               |
+  +----------------------------------------------------------------------+
+*/
+
+#include "valkey_glide_serializer.h"
+
+#include <string.h>
+
+#include "ext/json/php_json.h"
+#include "ext/standard/php_var.h"
+
+#ifdef HAVE_VALKEY_GLIDE_IGBINARY
+#include "ext/igbinary/igbinary.h"
+#endif
+#ifdef HAVE_VALKEY_GLIDE_MSGPACK
+#include "ext/msgpack/php_msgpack.h"
+#endif
+#ifdef HAVE_VALKEY_GLIDE_ZSTD
+#include <zstd.h>
+#endif
+#ifdef HAVE_VALKEY_GLIDE_LZ4
+#include <lz4.h>
+#include <lz4hc.h>
+
+/* phpredis' framing: CRC-8 of the uncompressed length, then the length as a native int */
+#define LZ4_HEADER_SIZE (sizeof(uint8_t) + sizeof(int))
+/* LZ4 expands a byte to at most 255 bytes */
+#define LZ4_MAX_RATIO 255
+#endif
+
+/* The server's default proto-max-bulk-len: a header claiming more than this is not trusted */
+#define MAX_UNCOMPRESSED_LEN (512 * 1024 * 1024)
+
+struct valkey_glide_serializer {
+    int       serializer;  /* VALKEY_GLIDE_SERIALIZER_* */
+    int       compression; /* VALKEY_GLIDE_COMPRESSION_* */
+    int       level;       /* 0 for the codec's default */
+    zend_long min_size;    /* Shorter values are not compressed */
+};
+
+static int serializer_supported(zend_long serializer) {
+    switch (serializer) {
+        case VALKEY_GLIDE_SERIALIZER_NONE:
+        case VALKEY_GLIDE_SERIALIZER_PHP:
+        case VALKEY_GLIDE_SERIALIZER_JSON:
+            return 1;
+#ifdef HAVE_VALKEY_GLIDE_IGBINARY
+        case VALKEY_GLIDE_SERIALIZER_IGBINARY:
+            return 1;
+#endif
+#ifdef HAVE_VALKEY_GLIDE_MSGPACK
+        case VALKEY_GLIDE_SERIALIZER_MSGPACK:
+            return 1;
+#endif
+        default:
+            return 0;
+    }
+}
+
+static int compression_supported(zend_long compression) {
+    switch (compression) {
+        case VALKEY_GLIDE_COMPRESSION_NONE:
+            return 1;
+#ifdef HAVE_VALKEY_GLIDE_ZSTD
+        case VALKEY_GLIDE_COMPRESSION_ZSTD:
+            return 1;
+#endif
+#ifdef HAVE_VALKEY_GLIDE_LZ4
+        case VALKEY_GLIDE_COMPRESSION_LZ4:
+            return 1;
+#endif
+        default:
+            return 0;
+    }
+}
+
+int valkey_glide_serializer_set_option(valkey_glide_serializer_t** serializer,
+                                       zend_long                   option,
+                                       zval*                       value) {
+    zend_long number = zval_get_long(value);
+
+    switch (option) {
+        case VALKEY_GLIDE_OPT_SERIALIZER:
+            if (!serializer_supported(number)) {
+                return 0;
+            }
+            break;
+        case VALKEY_GLIDE_OPT_COMPRESSION:
+            if (!compression_supported(number)) {
+                return 0;
+            }
+            break;
+        case VALKEY_GLIDE_OPT_COMPRESSION_LEVEL:
+            if (number < INT_MIN || number > INT_MAX) {
+                return 0;
+            }
+            break;
+        case VALKEY_GLIDE_OPT_COMPRESSION_MIN_SIZE:
+            if (number < 0) {
+                return 0;
+            }
+            break;
+        default:
+            return 0;
+    }
+
+    valkey_glide_serializer_t* options = *serializer;
+    if (!options) {
+        options              = ecalloc(1, sizeof(*options));
+        options->min_size    = VALKEY_GLIDE_COMPRESSION_DEFAULT_MIN_SIZE;
+        options->serializer  = VALKEY_GLIDE_SERIALIZER_NONE;
+        options->compression = VALKEY_GLIDE_COMPRESSION_NONE;
+    }
+
+    switch (option) {
+        case VALKEY_GLIDE_OPT_SERIALIZER:
+            options->serializer = (int)number;
+            break;
+        case VALKEY_GLIDE_OPT_COMPRESSION:
+            options->compression = (int)number;
+            break;
+        case VALKEY_GLIDE_OPT_COMPRESSION_LEVEL:
+            options->level = (int)number;
+            break;
+        default:
+            options->min_size = number;
+            break;
+    }
+
+    if (options->serializer == VALKEY_GLIDE_SERIALIZER_NONE &&
+        options->compression == VALKEY_GLIDE_COMPRESSION_NONE && options->level == 0 &&
+        options->min_size == VALKEY_GLIDE_COMPRESSION_DEFAULT_MIN_SIZE) {
+        efree(options);
+        options = NULL;
+    }
+    *serializer = options;
+    return 1;
+}
+
+int valkey_glide_serializer_get_option(const valkey_glide_serializer_t* serializer,
+                                       zend_long                        option,
+                                       zval*                            return_value) {
+    switch (option) {
+        case VALKEY_GLIDE_OPT_SERIALIZER:
+            ZVAL_LONG(return_value,
+                      serializer ? serializer->serializer : VALKEY_GLIDE_SERIALIZER_NONE);
+            return 1;
+        case VALKEY_GLIDE_OPT_COMPRESSION:
+            ZVAL_LONG(return_value,
+                      serializer ? serializer->compression : VALKEY_GLIDE_COMPRESSION_NONE);
+            return 1;
+        case VALKEY_GLIDE_OPT_COMPRESSION_LEVEL:
+            ZVAL_LONG(return_value, serializer ? serializer->level : 0);
+            return 1;
+        case VALKEY_GLIDE_OPT_COMPRESSION_MIN_SIZE:
+            ZVAL_LONG(return_value,
+                      serializer ? serializer->min_size
+                                 : VALKEY_GLIDE_COMPRESSION_DEFAULT_MIN_SIZE);
+            return 1;
+        default:
+            return 0;
+    }
+}
+
+void valkey_glide_serializer_free(valkey_glide_serializer_t* serializer) {
+    if (serializer) {
+        efree(serializer);
+    }
+}
+
+/* ====================================================================
+ * SERIALIZATION
+ * ==================================================================== */
+
+/* Serialize value into buf. Returns 0 on failure */
+static int serialize_value(int serializer, zval* value, smart_str* buf) {
+    switch (serializer) {
+        case VALKEY_GLIDE_SERIALIZER_PHP: {
+            php_serialize_data_t var_hash;
+
+            PHP_VAR_SERIALIZE_INIT(var_hash);
+            php_var_serialize(buf, value, &var_hash);
+            PHP_VAR_SERIALIZE_DESTROY(var_hash);
+            return !EG(exception);
+        }
+        case VALKEY_GLIDE_SERIALIZER_JSON:
+            return php_json_encode(buf, value, 0) == SUCCESS;
+#ifdef HAVE_VALKEY_GLIDE_IGBINARY
+        case VALKEY_GLIDE_SERIALIZER_IGBINARY: {
+            uint8_t* bytes;
+            size_t   len;
+
+            if (igbinary_serialize(&bytes, &len, value) != 0) {
+                return 0;
+            }
+            smart_str_appendl(buf, (const char*)bytes, len);
+            efree(bytes);
+            return 1;
+        }
+#endif
+#ifdef HAVE_VALKEY_GLIDE_MSGPACK
+        case VALKEY_GLIDE_SERIALIZER_MSGPACK:
+            php_msgpack_serialize(buf, value);
+            return 1;
+#endif
+        default:
+            return 0;
+    }
+}
+
+/* Unserialize data into out. Returns 0, with out undefined, if data isn't a serialized value */
+static int unserialize_value(int serializer, const char* data, size_t len, zval* out) {
+    switch (serializer) {
+        case VALKEY_GLIDE_SERIALIZER_PHP: {
+            php_unserialize_data_t var_hash;
+            const unsigned char*   pos = (const unsigned char*)data;
+            int                    ok  = 0;
+
+            /* As unserialize() does: the value lives in var_hash until it is complete */
+            PHP_VAR_UNSERIALIZE_INIT(var_hash);
+            zval* tmp = var_tmp_var(&var_hash);
+            if (php_var_unserialize(tmp, &pos, pos + len, &var_hash)) {
+                ZVAL_COPY(out, tmp);
+                ok = 1;
+            }
+            PHP_VAR_UNSERIALIZE_DESTROY(var_hash);
+            return ok;
+        }
+        case VALKEY_GLIDE_SERIALIZER_JSON:
+            return php_json_decode_ex(out,
+                                      data,
+                                      len,
+                                      PHP_JSON_OBJECT_AS_ARRAY,
+                                      PHP_JSON_PARSER_DEFAULT_DEPTH) == SUCCESS;
+#ifdef HAVE_VALKEY_GLIDE_IGBINARY
+        case VALKEY_GLIDE_SERIALIZER_IGBINARY:
+            /* igbinary output starts with its format version, 1 or 2 */
+            if (len < 5 || (memcmp(data, "\x00\x00\x00\x01", 4) != 0 &&
+                            memcmp(data, "\x00\x00\x00\x02", 4) != 0)) {
+                return 0;
+            }
+            return igbinary_unserialize((const uint8_t*)data, len, out) == 0;
+#endif
+#ifdef HAVE_VALKEY_GLIDE_MSGPACK
+        case VALKEY_GLIDE_SERIALIZER_MSGPACK:
+            return php_msgpack_unserialize(out, (char*)data, len) == SUCCESS;
+#endif
+        default:
+            return 0;
+    }
+}
+
+/* ====================================================================
+ * COMPRESSION
+ * ==================================================================== */
+
+#ifdef HAVE_VALKEY_GLIDE_LZ4
+static uint8_t crc8(const unsigned char* input, size_t len) {
+    uint8_t crc = 0xFF;
+
+    while (len--) {
+        crc ^= *input++;
+        for (int i = 0; i < 8; i++) {
+            crc = (crc & 0x80) ? (uint8_t)(crc << 1) ^ 0x31 : (uint8_t)(crc << 1);
+        }
+    }
+    return crc;
+}
+#endif
+
+/*
+ * Compress data into the arena. Returns NULL if the codec failed or the value wouldn't get
+ * smaller, in which case it is sent uncompressed
+ */
+static char* compress_value(const valkey_glide_serializer_t* serializer,
+                            arg_arena_t*                     arena,
+                            const char*                      data,
+                            size_t                           len,
+                            size_t*                          out_len) {
+    switch (serializer->compression) {
+#ifdef HAVE_VALKEY_GLIDE_ZSTD
+        case VALKEY_GLIDE_COMPRESSION_ZSTD: {
+            int    level = serializer->level > 0 ? MIN(serializer->level, ZSTD_maxCLevel())
+                                                 : ZSTD_CLEVEL_DEFAULT;
+            size_t bound = ZSTD_compressBound(len);
+            char*  out   = arena_alloc(arena, bound);
+            size_t size  = ZSTD_compress(out, bound, data, len, level);
+
+            if (ZSTD_isError(size) || size >= len) {
+                return NULL;
+            }
+            *out_len = size;
+            return out;
+        }
+#endif
+#ifdef HAVE_VALKEY_GLIDE_LZ4
+        case VALKEY_GLIDE_COMPRESSION_LZ4: {
+            if (len > LZ4_MAX_INPUT_SIZE) {
+                return NULL;
+            }
+
+            int   src_len = (int)len;
+            int   bound   = LZ4_compressBound(src_len);
+            char* out     = arena_alloc(arena, LZ4_HEADER_SIZE + bound);
+            int   size    = serializer->level > 0
+                                ? LZ4_compress_HC(data,
+                                                  out + LZ4_HEADER_SIZE,
+                                                  src_len,
+                                                  bound,
+                                                  MIN(serializer->level, LZ4HC_CLEVEL_MAX))
+                                : LZ4_compress_default(data, out + LZ4_HEADER_SIZE, src_len, bound);
+
+            if (size <= 0 || LZ4_HEADER_SIZE + (size_t)size >= len) {
+                return NULL;
+            }
+            out[0] = (char)crc8((const unsigned char*)&src_len, sizeof(src_len));
+            memcpy(out + 1, &src_len, sizeof(src_len));
+            *out_len = LZ4_HEADER_SIZE + size;
+            return out;
+        }
+#endif
+        default:
+            return NULL;
+    }
+}
+
+/* Uncompress data. Returns NULL if it isn't compressed with the configured codec */
+static zend_string* uncompress_value(const valkey_glide_serializer_t* serializer,
+                                     const char*                      data,
+                                     size_t                           len) {
+    switch (serializer->compression) {
+#ifdef HAVE_VALKEY_GLIDE_ZSTD
+        case VALKEY_GLIDE_COMPRESSION_ZSTD: {
+            unsigned long long size = ZSTD_getFrameContentSize(data, len);
+            if (size == ZSTD_CONTENTSIZE_ERROR || size == ZSTD_CONTENTSIZE_UNKNOWN ||
+                size > MAX_UNCOMPRESSED_LEN) {
+                return NULL;
+            }
+
+            zend_string* out     = zend_string_alloc(size, 0);
+            size_t       written = ZSTD_decompress(ZSTR_VAL(out), size, data, len);
+            if (ZSTD_isError(written) || written != size) {
+                zend_string_efree(out);
+                return NULL;
+            }
+            ZSTR_VAL(out)[size] = '\0';
+            return out;
+        }
+#endif
+#ifdef HAVE_VALKEY_GLIDE_LZ4
+        case VALKEY_GLIDE_COMPRESSION_LZ4: {
+            int size;
+
+            if (len <= LZ4_HEADER_SIZE || len - LZ4_HEADER_SIZE > INT_MAX) {
+                return NULL;
+            }
+            memcpy(&size, data + 1, sizeof(size));
+            if (size <= 0 || (uint8_t)data[0] != crc8((const unsigned char*)&size, sizeof(size))) {
+                return NULL;
+            }
+            /* Don't allocate for a size the input couldn't possibly expand to */
+            if ((size_t)size > MAX_UNCOMPRESSED_LEN ||
+                (size_t)size > (len - LZ4_HEADER_SIZE) * LZ4_MAX_RATIO) {
+                return NULL;
+            }
+
+            zend_string* out     = zend_string_alloc(size, 0);
+            int          written = LZ4_decompress_safe(data + LZ4_HEADER_SIZE,
+                                              ZSTR_VAL(out),
+                                              (int)(len - LZ4_HEADER_SIZE),
+                                              size);
+            if (written != size) {
+                zend_string_efree(out);
+                return NULL;
+            }
+            ZSTR_VAL(out)[size] = '\0';
+            return out;
+        }
+#endif
+        default:
+            return NULL;
+    }
+}
+
+/* ====================================================================
+ * PACKING
+ * ==================================================================== */
+
+char* valkey_glide_pack(const valkey_glide_serializer_t* serializer,
+                        arg_arena_t*                     arena,
+                        zval*                            value,
+                        size_t*                          len) {
+    smart_str   buf = {0};
+    const char* data;
+    size_t      data_len;
+
+    if (!serializer) {
+        return arena_zval_to_string(arena, value, len);
+    }
+
+    ZVAL_DEREF(value);
+    if (serializer->serializer == VALKEY_GLIDE_SERIALIZER_NONE) {
+        data = arena_zval_to_string(arena, value, &data_len);
+    } else {
+        if (!serialize_value(serializer->serializer, value, &buf)) {
+            smart_str_free(&buf);
+            return NULL;
+        }
+        data     = buf.s ? ZSTR_VAL(buf.s) : "";
+        data_len = buf.s ? ZSTR_LEN(buf.s) : 0;
+    }
+
+    char* packed = NULL;
+    if (serializer->compression != VALKEY_GLIDE_COMPRESSION_NONE &&
+        data_len >= (size_t)serializer->min_size) {
+        packed = compress_value(serializer, arena, data, data_len, len);
+    }
+    if (!packed) {
+        /* Serialized bytes must outlive buf; the other ones already do */
+        packed = buf.s ? arena_strndup(arena, data, data_len) : (char*)data;
+        *len   = data_len;
+    }
+
+    smart_str_free(&buf);
+    return packed;
+}
+
+void valkey_glide_unpack(const valkey_glide_serializer_t* serializer,
+                         const char*                      data,
+                         size_t                           len,
+                         zval*                            out) {
+    zend_string* uncompressed = NULL;
+
+    if (!serializer) {
+        ZVAL_STRINGL(out, data, len);
+        return;
+    }
+
+    if (serializer->compression != VALKEY_GLIDE_COMPRESSION_NONE) {
+        uncompressed = uncompress_value(serializer, data, len);
+        if (uncompressed) {
+            data = ZSTR_VAL(uncompressed);
+            len  = ZSTR_LEN(uncompressed);
+        }
+    }
+
+    if (serializer->serializer != VALKEY_GLIDE_SERIALIZER_NONE &&
+        unserialize_value(serializer->serializer, data, len, out)) {
+        if (uncompressed) {
+            zend_string_release(uncompressed);
+        }
+        return;
+    }
+
+    if (uncompressed) {
+        ZVAL_STR(out, uncompressed);
+    } else {
+        ZVAL_STRINGL(out, data, len);
+    }
+}
+
+void valkey_glide_unpack_zval(const valkey_glide_serializer_t* serializer, zval* value) {
+    zval unpacked;
+
+    if (!serializer) {
+        return;
+    }
+
+    if (Z_TYPE_P(value) == IS_STRING) {
+        valkey_glide_unpack(serializer, Z_STRVAL_P(value), Z_STRLEN_P(value), &unpacked);
+        zval_ptr_dtor(value);
+        ZVAL_COPY_VALUE(value, &unpacked);
+    } else if (Z_TYPE_P(value) == IS_ARRAY) {
+        zval* element;
+
+        SEPARATE_ARRAY(value);
+        ZEND_HASH_FOREACH_VAL(Z_ARRVAL_P(value), element) {
+            if (Z_TYPE_P(element) == IS_STRING) {
+                valkey_glide_unpack(
+                    serializer, Z_STRVAL_P(element), Z_STRLEN_P(element), &unpacked);
+                zval_ptr_dtor(element);
+                ZVAL_COPY_VALUE(element, &unpacked);
+            }
+        }
+        ZEND_HASH_FOREACH_END();
+    }
+}
@@ -0,0 +1,70 @@
+/*
+  +----------------------------------------------------------------------+
+  | Copyright (c) 2023-2025 The PHP Group                                |
+  +----------------------------------------------------------------------+
+  | This source file is subject to version 3.01 of the PHP license,      |
+  | that is bundled with this package in the file LICENSE, and is        |
+  | available through the world-wide-web at the following url:           |
+  | http://www.php.net/license/3_01.txt                                  |
+  | If you did not receive a copy of the PHP license and are unable to   |
+  | obtain it through the world-wide-web, please send a note to          |
+  | license@php.net so we can mail you a copy immediately.               |
+  +----------------------------------------------------------------------+
+*/
+
+#ifndef VALKEY_GLIDE_SERIALIZER_H
+#define VALKEY_GLIDE_SERIALIZER_H
+
+#include "common.h"
+#include "valkey_glide_arena.h"
+
+/*
+ * Serialization and compression of values, set with setOption().
+ *
+ * Values are serialized, then compressed when they are at least the minimum compression size
+ * and compressing makes them smaller; reading reverses both steps. Bytes that don't uncompress
+ * or unserialize, e.g. values written before the options were set, are returned as they are.
+ * Only values are packed: keys, hash fields and numeric arguments are sent verbatim.
+ *
+ * The options and their values are the VALKEY_GLIDE_OPT_*, _SERIALIZER_* and _COMPRESSION_*
+ * constants of common.h.
+ */
+
+#define VALKEY_GLIDE_COMPRESSION_DEFAULT_MIN_SIZE 64
+
+/*
+ * Apply setOption(). Returns 1 if the option is one of the above and the value is supported
+ * by this build. The options are allocated on first use and released once they are all back
+ * to their defaults, so that a NULL serializer always means values are sent verbatim
+ */
+int valkey_glide_serializer_set_option(valkey_glide_serializer_t** serializer,
+                                       zend_long                   option,
+                                       zval*                       value);
+
+/* Apply getOption(): returns 0 for options that aren't handled here */
+int valkey_glide_serializer_get_option(const valkey_glide_serializer_t* serializer,
+                                       zend_long                        option,
+                                       zval*                            return_value);
+
+void valkey_glide_serializer_free(valkey_glide_serializer_t* serializer);
+
+/*
+ * Pack a value into a command argument. Strings are used in place when there is nothing to do,
+ * other bytes are written in the arena. Without a serializer, this is arena_zval_to_string().
+ * Returns NULL if the value can't be serialized
+ */
+char* valkey_glide_pack(const valkey_glide_serializer_t* serializer,
+                        arg_arena_t*                     arena,
+                        zval*                            value,
+                        size_t*                          len);
+
+/* Unpack the bytes of a reply into out; without a serializer, out is a string */
+void valkey_glide_unpack(const valkey_glide_serializer_t* serializer,
+                         const char*                      data,
+                         size_t                           len,
+                         zval*                            out);
+
+/* Unpack a string in place, or the string values of an array (its keys are kept) */
+void valkey_glide_unpack_zval(const valkey_glide_serializer_t* serializer, zval* value);
+
+#endif /* VALKEY_GLIDE_SERIALIZER_H */
@@ -22,10 +22,6 @@
 #include "valkey_glide_commands_common.h"
 #include "valkey_glide_core_common.h"
 
-/* Import the string conversion functions from command_response.c */
-extern char* long_to_string(long value, size_t* len);
-extern char* double_to_string(double value, size_t* len);
-
 /* Execute a TYPE command using the Valkey Glide client - MIGRATED TO CORE FRAMEWORK */
 int execute_type_command(zval* object, int argc, zval* return_value, zend_class_entry* ce) {
     valkey_glide_object* valkey_glide;
@@ -157,6 +153,7 @@ static void build_sort_args(const char*     key,
                             zval*           sort_pattern,
                             zend_bool*      alpha_out,
                             zend_bool*      desc_out,
+                            arg_arena_t*    arena,
                             uintptr_t**     args_ptr,
                             unsigned long** args_len_ptr,
                             unsigned long*  arg_count_ptr) {
@@ -212,19 +209,9 @@ static void build_sort_args(const char*     key,
         max_args++; /* DESC */
 
     /* Allocate arrays for arguments */
-    uintptr_t*     args     = (uintptr_t*)emalloc(max_args * sizeof(uintptr_t));
-    unsigned long* args_len = (unsigned long*)emalloc(max_args * sizeof(unsigned long));
-
-    if (!args || !args_len) {
-        if (args)
-            efree(args);
-        if (args_len)
-            efree(args_len);
-        *args_ptr      = NULL;
-        *args_len_ptr  = NULL;
-        *arg_count_ptr = 0;
-        return;
-    }
+    uintptr_t*     args;
+    unsigned long* args_len;
+    arena_alloc_args(arena, max_args, &args, &args_len);
 
     /* Current argument index */
     unsigned long arg_idx = 0;
@@ -274,28 +261,17 @@ static void build_sort_args(const char*     key,
                         arg_idx++;
 
                         /* Add offset */
-                        char*  offset_str;
-                        size_t offset_len;
-                        long   offset_val = zval_get_long(z_offset);
-                        offset_str        = long_to_string(offset_val, &offset_len);
-                        if (offset_str) {
-                            args[arg_idx]     = (uintptr_t)offset_str;
-                            args_len[arg_idx] = offset_len;
-                            arg_idx++;
-
-                            /* Add count */
-                            char*  count_str;
-                            size_t count_len;
-                            long   count_val = zval_get_long(z_count);
-                            count_str        = long_to_string(count_val, &count_len);
-                            if (count_str) {
-                                args[arg_idx]     = (uintptr_t)count_str;
-                                args_len[arg_idx] = count_len;
-                                arg_idx++;
-                            } else {
-                                efree(offset_str);
-                            }
-                        }
+                        size_t len;
+                        args[arg_idx] =
+                            (uintptr_t)arena_long_to_string(arena, zval_get_long(z_offset), &len);
+                        args_len[arg_idx] = len;
+                        arg_idx++;
+
+                        /* Add count */
+                        args[arg_idx] =
+                            (uintptr_t)arena_long_to_string(arena, zval_get_long(z_count), &len);
+                        args_len[arg_idx] = len;
+                        arg_idx++;
                     }
                 }
             }
@@ -313,28 +289,17 @@ static void build_sort_args(const char*     key,
                 arg_idx++;
 
                 /* Add offset */
-                char*  offset_str;
-                size_t offset_len;
-                long   offset_val = zval_get_long(z_offset);
-                offset_str        = long_to_string(offset_val, &offset_len);
-                if (offset_str) {
-                    args[arg_idx]     = (uintptr_t)offset_str;
-                    args_len[arg_idx] = offset_len;
-                    arg_idx++;
-
-                    /* Add count */
-                    char*  count_str;
-                    size_t count_len;
-                    long   count_val = zval_get_long(z_count);
-                    count_str        = long_to_string(count_val, &count_len);
-                    if (count_str) {
-                        args[arg_idx]     = (uintptr_t)count_str;
-                        args_len[arg_idx] = count_len;
-                        arg_idx++;
-                    } else {
-                        efree(offset_str);
-                    }
-                }
+                size_t len;
+                args[arg_idx] =
+                    (uintptr_t)arena_long_to_string(arena, zval_get_long(z_offset), &len);
+                args_len[arg_idx] = len;
+                arg_idx++;
+
+                /* Add count */
+                args[arg_idx] =
+                    (uintptr_t)arena_long_to_string(arena, zval_get_long(z_count), &len);
+                args_len[arg_idx] = len;
+                arg_idx++;
             }
         }
 
@@ -411,32 +376,6 @@ static void build_sort_args(const char*     key,
     *arg_count_ptr = arg_idx;
 }
 
-/* Free memory allocated for SORT command arguments */
-static void free_sort_args(uintptr_t* args, unsigned long* args_len, unsigned long arg_count) {
-    if (args && args_len) {
-        /* Free any dynamically allocated argument strings (offset and count) */
-        for (unsigned long i = 0; i < arg_count; i++) {
-            /* Skip key, BY, GET, LIMIT, STORE, ALPHA, DESC, ASC and any string that was
-               directly extracted from a zval (not allocated) */
-            if (strcmp((const char*)args[i], "BY") != 0 &&
-                strcmp((const char*)args[i], "GET") != 0 &&
-                strcmp((const char*)args[i], "LIMIT") != 0 &&
-                strcmp((const char*)args[i], "STORE") != 0 &&
-                strcmp((const char*)args[i], "ALPHA") != 0 &&
-                strcmp((const char*)args[i], "DESC") != 0 &&
-                strcmp((const char*)args[i], "ASC") != 0 && i > 0 && /* Skip key */
-                ((i > 1 && strcmp((const char*)args[i - 1], "LIMIT") ==
-                               0) || /* Only free offset and count */
-                 (i > 2 && strcmp((const char*)args[i - 2], "LIMIT") == 0))) {
-                efree((void*)args[i]);
-            }
-        }
-
-        efree(args);
-        efree(args_len);
-    }
-}
-
 /* Execute a SORT command using the Valkey Glide client */
 int execute_sort_command(zval* object, int argc, zval* return_value, zend_class_entry* ce) {
     valkey_glide_object* valkey_glide;
@@ -457,18 +396,13 @@ int execute_sort_command(zval* object, int argc, zval* return_value, zend_class_
     /* If we have a Glide client, use it */
     if (valkey_glide->glide_client) {
         /* Build command arguments */
+        arg_arena_t    arena;
         uintptr_t*     args      = NULL;
         unsigned long* args_len  = NULL;
         unsigned long  arg_count = 0;
-        build_sort_args(key, key_len, z_opts, &alpha, &desc, &args, &args_len, &arg_count);
-
-        if (!args || !args_len || arg_count == 0) {
-            if (args)
-                efree(args);
-            if (args_len)
-                efree(args_len);
-            return 0;
-        }
+        arena_init(&arena);
+        build_sort_args(
+            key, key_len, z_opts, &alpha, &desc, &arena, &args, &args_len, &arg_count);
 
         /* Execute the command */
         CommandResult* cmd_result = execute_command(valkey_glide->glide_client,
@@ -478,8 +412,8 @@ int execute_sort_command(zval* object, int argc, zval* return_value, zend_class_
                                                     args_len   /* argument lengths */
         );
 
-        /* Free the argument arrays */
-        free_sort_args(args, args_len, arg_count);
+        /* Free the arguments */
+        arena_free(&arena);
 
         /* Check if we have a valid result */
         if (!cmd_result || !cmd_result->response) {
@@ -672,18 +606,13 @@ int execute_sort_ro_command(zval* object, int argc, zval* return_value, zend_cla
     /* If we have a Glide client, use it */
     if (valkey_glide->glide_client) {
         /* Build command arguments */
+        arg_arena_t    arena;
         uintptr_t*     args      = NULL;
         unsigned long* args_len  = NULL;
         unsigned long  arg_count = 0;
-        build_sort_args(key, key_len, z_opts, &alpha, &desc, &args, &args_len, &arg_count);
-
-        if (!args || !args_len || arg_count == 0) {
-            if (args)
-                efree(args);
-            if (args_len)
-                efree(args_len);
-            return 0;
-        }
+        arena_init(&arena);
+        build_sort_args(
+            key, key_len, z_opts, &alpha, &desc, &arena, &args, &args_len, &arg_count);
 
         /* Execute the command */
         CommandResult* cmd_result = execute_command(valkey_glide->glide_client,
@@ -693,8 +622,8 @@ int execute_sort_ro_command(zval* object, int argc, zval* return_value, zend_cla
                                                     args_len      /* argument lengths */
         );
 
-        /* Free the argument arrays */
-        free_sort_args(args, args_len, arg_count);
+        /* Free the arguments */
+        arena_free(&arena);
 
         /* Check if we have a valid result */
         if (!cmd_result || !cmd_result->response) {
@@ -744,18 +673,13 @@ int execute_sortasc_command(zval* object, int argc, zval* return_value, zend_cla
     /* If we have a Glide client, use it */
     if (valkey_glide->glide_client) {
         /* Build command arguments */
+        arg_arena_t    arena;
         uintptr_t*     args      = NULL;
         unsigned long* args_len  = NULL;
         unsigned long  arg_count = 0;
-        build_sort_args(key, key_len, z_opts, &alpha, &desc, &args, &args_len, &arg_count);
-
-        if (!args || !args_len || arg_count == 0) {
-            if (args)
-                efree(args);
-            if (args_len)
-                efree(args_len);
-            return 0;
-        }
+        arena_init(&arena);
+        build_sort_args(
+            key, key_len, z_opts, &alpha, &desc, &arena, &args, &args_len, &arg_count);
 
         /* Execute the command */
         CommandResult* cmd_result = execute_command(valkey_glide->glide_client,
@@ -765,8 +689,8 @@ int execute_sortasc_command(zval* object, int argc, zval* return_value, zend_cla
                                                     args_len   /* argument lengths */
         );
 
-        /* Free the argument arrays */
-        free_sort_args(args, args_len, arg_count);
+        /* Free the arguments */
+        arena_free(&arena);
 
         /* Check if we have a valid result */
         if (!cmd_result || !cmd_result->response) {
@@ -816,18 +740,13 @@ int execute_sortascalpha_command(zval* object, int argc, zval* return_value, zen
     /* If we have a Glide client, use it */
     if (valkey_glide->glide_client) {
         /* Build command arguments */
+        arg_arena_t    arena;
         uintptr_t*     args      = NULL;
         unsigned long* args_len  = NULL;
         unsigned long  arg_count = 0;
-        build_sort_args(key, key_len, z_opts, &alpha, &desc, &args, &args_len, &arg_count);
-
-        if (!args || !args_len || arg_count == 0) {
-            if (args)
-                efree(args);
-            if (args_len)
-                efree(args_len);
-            return 0;
-        }
+        arena_init(&arena);
+        build_sort_args(
+            key, key_len, z_opts, &alpha, &desc, &arena, &args, &args_len, &arg_count);
 
         /* Execute the command */
         CommandResult* cmd_result = execute_command(valkey_glide->glide_client,
@@ -837,8 +756,8 @@ int execute_sortascalpha_command(zval* object, int argc, zval* return_value, zen
                                                     args_len   /* argument lengths */
         );
 
-        /* Free the argument arrays */
-        free_sort_args(args, args_len, arg_count);
+        /* Free the arguments */
+        arena_free(&arena);
 
         /* Check if we have a valid result */
         if (!cmd_result || !cmd_result->response) {
@@ -888,18 +807,13 @@ int execute_sortdesc_command(zval* object, int argc, zval* return_value, zend_cl
     /* If we have a Glide client, use it */
     if (valkey_glide->glide_client) {
         /* Build command arguments */
+        arg_arena_t    arena;
         uintptr_t*     args      = NULL;
         unsigned long* args_len  = NULL;
         unsigned long  arg_count = 0;
-        build_sort_args(key, key_len, z_opts, &alpha, &desc, &args, &args_len, &arg_count);
-
-        if (!args || !args_len || arg_count == 0) {
-            if (args)
-                efree(args);
-            if (args_len)
-                efree(args_len);
-            return 0;
-        }
+        arena_init(&arena);
+        build_sort_args(
+            key, key_len, z_opts, &alpha, &desc, &arena, &args, &args_len, &arg_count);
 
         /* Execute the command */
         CommandResult* cmd_result = execute_command(valkey_glide->glide_client,
@@ -909,8 +823,8 @@ int execute_sortdesc_command(zval* object, int argc, zval* return_value, zend_cl
                                                     args_len   /* argument lengths */
         );
 
-        /* Free the argument arrays */
-        free_sort_args(args, args_len, arg_count);
+        /* Free the arguments */
+        arena_free(&arena);
 
         /* Check if we have a valid result */
         if (!cmd_result || !cmd_result->response) {
@@ -963,18 +877,13 @@ int execute_sortdescalpha_command(zval*             object,
     /* If we have a Glide client, use it */
     if (valkey_glide->glide_client) {
         /* Build command arguments */
+        arg_arena_t    arena;
         uintptr_t*     args      = NULL;
         unsigned long* args_len  = NULL;
         unsigned long  arg_count = 0;
-        build_sort_args(key, key_len, z_opts, &alpha, &desc, &args, &args_len, &arg_count);
-
-        if (!args || !args_len || arg_count == 0) {
-            if (args)
-                efree(args);
-            if (args_len)
-                efree(args_len);
-            return 0;
-        }
+        arena_init(&arena);
+        build_sort_args(
+            key, key_len, z_opts, &alpha, &desc, &arena, &args, &args_len, &arg_count);
 
         /* Execute the command */
         CommandResult* cmd_result = execute_command(valkey_glide->glide_client,
@@ -984,8 +893,8 @@ int execute_sortdescalpha_command(zval*             object,
                                                     args_len   /* argument lengths */
         );
 
-        /* Free the argument arrays */
-        free_sort_args(args, args_len, arg_count);
+        /* Free the arguments */
+        arena_free(&arena);
 
         /* Check if we have a valid result */
         if (!cmd_result || !cmd_result->response) {
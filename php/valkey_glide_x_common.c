@@ -327,50 +327,6 @@ int parse_x_claim_options(zval* options, x_claim_options_t* opts) {
  * UTILITY FUNCTIONS
  * ==================================================================== */
 
-/**
- * Allocate command arguments arrays
- */
-int allocate_command_args(int count, uintptr_t** args_out, unsigned long** args_len_out) {
-    *args_out     = (uintptr_t*)emalloc(count * sizeof(uintptr_t));
-    *args_len_out = (unsigned long*)emalloc(count * sizeof(unsigned long));
-
-    if (!*args_out || !*args_len_out) {
-        if (*args_out)
-            efree(*args_out);
-        if (*args_len_out)
-            efree(*args_len_out);
-        return 0;
-    }
-
-    return 1;
-}
-
-/**
- * Free command arguments arrays
- */
-void free_command_args(uintptr_t* args, unsigned long* args_len) {
-    if (args)
-        efree(args);
-    if (args_len)
-        efree(args_len);
-}
-
-/**
- * Allocate a string representation of a number
- */
-char* alloc_number_string(long value, size_t* len_out) {
-    char   temp[32];
-    size_t len    = snprintf(temp, sizeof(temp), "%ld", value);
-    char*  result = emalloc(len + 1);
-    if (result) {
-        memcpy(result, temp, len);
-        result[len] = '\0';
-        if (len_out)
-            *len_out = len;
-    }
-    return result;
-}
-
 /**
  * Generic command execution framework
  */
@@ -379,12 +335,13 @@ int execute_x_generic_command(const void*          glide_client,
                               x_command_args_t*    args,
                               void*                result_ptr,
                               x_result_processor_t process_result) {
-    uintptr_t*     cmd_args          = NULL;
-    unsigned long* args_len          = NULL;
-    char**         allocated_strings = NULL;
-    int            allocated_count   = 0;
-    int            arg_count         = 0;
-    int            status            = 0;
+    arg_arena_t    arena;
+    uintptr_t*     cmd_args  = NULL;
+    unsigned long* args_len  = NULL;
+    int            arg_count = 0;
+    int            status    = 0;
+
+    arena_init(&arena);
 
     /* Prepare arguments based on command type */
     switch (cmd_type) {
@@ -393,51 +350,48 @@ int execute_x_generic_command(const void*          glide_client,
         case XGroupDelConsumer:
         case XGroupDestroy:
         case XGroupSetId:
-            arg_count = prepare_x_group_args(args, &cmd_args, &args_len);
+            arg_count = prepare_x_group_args(args, &arena, &cmd_args, &args_len);
             break;
         case XLen:
-            arg_count = prepare_x_len_args(args, &cmd_args, &args_len);
+            arg_count = prepare_x_len_args(args, &arena, &cmd_args, &args_len);
             break;
         case XDel:
-            arg_count = prepare_x_del_args(args, &cmd_args, &args_len);
+            arg_count = prepare_x_del_args(args, &arena, &cmd_args, &args_len);
             break;
         case XAck:
-            arg_count = prepare_x_ack_args(args, &cmd_args, &args_len);
+            arg_count = prepare_x_ack_args(args, &arena, &cmd_args, &args_len);
             break;
         case XAdd:
-            arg_count = prepare_x_add_args(
-                args, &cmd_args, &args_len, &allocated_strings, &allocated_count);
+            arg_count = prepare_x_add_args(args, &arena, &cmd_args, &args_len);
             break;
         case XTrim:
-            arg_count = prepare_x_trim_args(args, &cmd_args, &args_len);
+            arg_count = prepare_x_trim_args(args, &arena, &cmd_args, &args_len);
             break;
         case XRange:
         case XRevRange:
 
-            arg_count = prepare_x_range_args(args, &cmd_args, &args_len);
+            arg_count = prepare_x_range_args(args, &arena, &cmd_args, &args_len);
             break;
         case XPending:
-            arg_count = prepare_x_pending_args(args, &cmd_args, &args_len);
+            arg_count = prepare_x_pending_args(args, &arena, &cmd_args, &args_len);
             break;
         case XRead:
-            arg_count = prepare_x_read_args(args, &cmd_args, &args_len);
+            arg_count = prepare_x_read_args(args, &arena, &cmd_args, &args_len);
             break;
         case XReadGroup:
 
-            arg_count = prepare_x_readgroup_args(args, &cmd_args, &args_len);
+            arg_count = prepare_x_readgroup_args(args, &arena, &cmd_args, &args_len);
             break;
         case XAutoClaim:
-            arg_count = prepare_x_autoclaim_args(args, &cmd_args, &args_len);
+            arg_count = prepare_x_autoclaim_args(args, &arena, &cmd_args, &args_len);
             break;
         case XClaim:
-            arg_count = prepare_x_claim_args(args, &cmd_args, &args_len);
+            arg_count = prepare_x_claim_args(args, &arena, &cmd_args, &args_len);
             break;
         case XInfoGroups:
         case XInfoConsumers:
         case XInfoStream:
-            /* XINFO commands need special handling for allocated strings */
-            arg_count = prepare_x_info_args(
-                args, &cmd_args, &args_len, &allocated_strings, &allocated_count);
+            arg_count = prepare_x_info_args(args, &arena, &cmd_args, &args_len);
             break;
         default:
             printf("Unknown command type: %d\n", cmd_type);
@@ -461,56 +415,8 @@ int execute_x_generic_command(const void*          glide_client,
     }
 
 cleanup:
-    /* Free allocated strings for complex commands */
-    if (allocated_strings) {
-        for (int i = 0; i < allocated_count; i++) {
-            if (allocated_strings[i]) {
-                efree(allocated_strings[i]);
-            }
-        }
-        efree(allocated_strings);
-    }
-
-    /* Handle special cleanup for specific commands that allocate individual strings */
-    /* Note: These are handled before general cleanup to avoid double-free */
-    if (cmd_type == XTrim && args->trim_opts.has_limit && cmd_args && arg_count > 0) {
-        /* XTRIM allocates limit string - find and free it */
-        /* The limit string is added after LIMIT keyword, scan backwards to find it */
-        for (int i = arg_count - 1; i >= 0; i--) {
-            /* Look for the pattern: LIMIT followed by allocated string */
-            if (i > 0 && cmd_args[i - 1] == (uintptr_t)"LIMIT") {
-                /* This should be our allocated limit string */
-                char* potential_str = (char*)cmd_args[i];
-                /* Simple validation: check if it looks like a number string */
-                if (potential_str && potential_str[0] >= '0' && potential_str[0] <= '9') {
-                    efree(potential_str);
-                }
-                break;
-            }
-        }
-    }
-
-    if ((cmd_type == XRange || cmd_type == XRevRange) && args->range_opts.has_count && cmd_args &&
-        arg_count > 0) {
-        /* XRANGE/XREVRANGE allocates count string - find and free it */
-        /* The count string is added after COUNT keyword, scan backwards to find it */
-        for (int i = arg_count - 1; i >= 0; i--) {
-            /* Look for the pattern: COUNT followed by allocated string */
-            if (i > 0 && cmd_args[i - 1] == (uintptr_t)"COUNT") {
-                /* This should be our allocated count string */
-                char* potential_str = (char*)cmd_args[i];
-                /* Simple validation: check if it looks like a number string */
-                if (potential_str && potential_str[0] >= '0' && potential_str[0] <= '9') {
-                    efree(potential_str);
-                }
-                break;
-            }
-        }
-    }
-
-    /* Free command arguments arrays (but not the individual string contents as they may be
-     * references) */
-    free_command_args(cmd_args, args_len);
+    /* Free the argument arrays and the strings formatted for them */
+    arena_free(&arena);
 
     return status;
 }
@@ -746,19 +652,14 @@ int process_x_info_result(CommandResult* result, void* output) {
  * Prepare arguments for XINFO command.
  */
 int prepare_x_info_args(x_command_args_t* args,
+                        arg_arena_t*      arena,
                         uintptr_t**       args_out,
-                        unsigned long**   args_len_out,
-                        char***           allocated_strings,
-                        int*              allocated_count) {
+                        unsigned long**   args_len_out) {
     /* Check if client and arguments are valid */
     if (!args->glide_client || !args->subcommand || args->subcommand_len <= 0) {
         return 0;
     }
 
-    /* Initialize allocated strings tracking */
-    *allocated_strings = NULL;
-    *allocated_count   = 0;
-
     /* Calculate arg count based on subcommand */
     unsigned long    arg_count    = 0;
     enum RequestType command_type = 0;
@@ -793,7 +694,6 @@ int prepare_x_info_args(x_command_args_t* args,
         /* Count options */
         unsigned long extra_args = 0;
         zend_bool     has_full   = 0;
-        zend_bool     has_count  = 0;
 
         if (args->args_count >= 2) {
             /* Check if FULL option is present */
@@ -802,39 +702,26 @@ int prepare_x_info_args(x_command_args_t* args,
                 has_full = 1;
                 extra_args += 1; /* FULL */
 
-                /* Check for COUNT option */
+                /* Check for COUNT option, as it is added below */
                 if (args->args_count >= 3 && Z_TYPE(args->args[2]) != IS_NULL) {
-                    if (Z_TYPE(args->args[2]) == IS_LONG) {
-                        long count_value = Z_LVAL(args->args[2]);
-                        if (count_value != -1) {
-                            has_count = 1;
-                            extra_args += 2; /* COUNT + value */
-                        }
+                    if ((Z_TYPE(args->args[2]) == IS_LONG && Z_LVAL(args->args[2]) != -1) ||
+                        (Z_TYPE(args->args[2]) == IS_STRING &&
+                         (Z_STRLEN(args->args[2]) != 2 ||
+                          strcmp(Z_STRVAL(args->args[2]), "-1") != 0))) {
+                        extra_args += 2; /* COUNT + value */
                     }
                 }
             }
         }
 
         arg_count = 1 + extra_args; /* key + options */
-
-        /* Allocate memory to track dynamic strings */
-        if (has_count) {
-            *allocated_strings = (char**)ecalloc(1, sizeof(char*));
-            if (!*allocated_strings) {
-                return 0;
-            }
-        }
     } else {
         /* Unknown subcommand */
         return 0;
     }
 
     /* Allocate memory for arguments */
-    if (!allocate_command_args(arg_count, args_out, args_len_out)) {
-        if (*allocated_strings) {
-            efree(*allocated_strings);
-            *allocated_strings = NULL;
-        }
+    if (!arena_alloc_args(arena, arg_count, args_out, args_len_out)) {
         return 0;
     }
 
@@ -923,18 +810,12 @@ int prepare_x_info_args(x_command_args_t* args,
                     arg_idx++;
 
                     /* Convert count to string */
-                    char   count_str[32];
-                    size_t count_str_len =
-                        snprintf(count_str, sizeof(count_str), "%ld", count_value);
-                    char* count_copy = estrndup(count_str, count_str_len);
-                    if (count_copy) {
-                        (*allocated_strings)[*allocated_count] = count_copy;
-                        (*allocated_count)++;
-
-                        (*args_out)[arg_idx]     = (uintptr_t)count_copy;
-                        (*args_len_out)[arg_idx] = count_str_len;
-                        arg_idx++;
-                    }
+                    size_t count_str_len;
+                    char*  count_str = arena_long_to_string(arena, count_value, &count_str_len);
+
+                    (*args_out)[arg_idx]     = (uintptr_t)count_str;
+                    (*args_len_out)[arg_idx] = count_str_len;
+                    arg_idx++;
                 }
             }
         }
@@ -950,21 +831,17 @@ int prepare_x_info_args(x_command_args_t* args,
 /**
  * Prepare arguments for XLEN command.
  */
-int prepare_x_len_args(x_command_args_t* args, uintptr_t** args_out, unsigned long** args_len_out) {
+int prepare_x_len_args(x_command_args_t* args,
+                       arg_arena_t*      arena,
+                       uintptr_t**       args_out,
+                       unsigned long**   args_len_out) {
     /* Check if client and key are valid */
     if (!args->glide_client || !args->key || args->key_len <= 0) {
         return 0;
     }
 
     /* Allocate memory for arguments */
-    *args_out     = (uintptr_t*)emalloc(sizeof(uintptr_t));
-    *args_len_out = (unsigned long*)emalloc(sizeof(unsigned long));
-
-    if (!*args_out || !*args_len_out) {
-        if (*args_out)
-            efree(*args_out);
-        if (*args_len_out)
-            efree(*args_len_out);
+    if (!arena_alloc_args(arena, 1, args_out, args_len_out)) {
         return 0;
     }
 
@@ -978,7 +855,10 @@ int prepare_x_len_args(x_command_args_t* args, uintptr_t** args_out, unsigned lo
 /**
  * Prepare arguments for XACK command.
  */
-int prepare_x_ack_args(x_command_args_t* args, uintptr_t** args_out, unsigned long** args_len_out) {
+int prepare_x_ack_args(x_command_args_t* args,
+                       arg_arena_t*      arena,
+                       uintptr_t**       args_out,
+                       unsigned long**   args_len_out) {
     /* Check if client and arguments are valid */
     if (!args->glide_client || !args->key || args->key_len <= 0 || !args->group ||
         args->group_len <= 0 || !args->ids || args->id_count <= 0) {
@@ -987,14 +867,7 @@ int prepare_x_ack_args(x_command_args_t* args, uintptr_t** args_out, unsigned lo
 
     /* Prepare command arguments: key + group + IDs */
     unsigned long arg_count = 2 + args->id_count;
-    *args_out               = (uintptr_t*)emalloc(arg_count * sizeof(uintptr_t));
-    *args_len_out           = (unsigned long*)emalloc(arg_count * sizeof(unsigned long));
-
-    if (!*args_out || !*args_len_out) {
-        if (*args_out)
-            efree(*args_out);
-        if (*args_len_out)
-            efree(*args_len_out);
+    if (!arena_alloc_args(arena, arg_count, args_out, args_len_out)) {
         return 0;
     }
 
@@ -1025,7 +898,10 @@ int prepare_x_ack_args(x_command_args_t* args, uintptr_t** args_out, unsigned lo
 /**
  * Prepare arguments for XDEL command.
  */
-int prepare_x_del_args(x_command_args_t* args, uintptr_t** args_out, unsigned long** args_len_out) {
+int prepare_x_del_args(x_command_args_t* args,
+                       arg_arena_t*      arena,
+                       uintptr_t**       args_out,
+                       unsigned long**   args_len_out) {
     /* Check if client and arguments are valid */
     if (!args->glide_client || !args->key || args->key_len <= 0 || !args->ids ||
         args->id_count <= 0) {
@@ -1034,14 +910,7 @@ int prepare_x_del_args(x_command_args_t* args, uintptr_t** args_out, unsigned lo
 
     /* Prepare command arguments: key + IDs */
     unsigned long arg_count = 1 + args->id_count;
-    *args_out               = (uintptr_t*)emalloc(arg_count * sizeof(uintptr_t));
-    *args_len_out           = (unsigned long*)emalloc(arg_count * sizeof(unsigned long));
-
-    if (!*args_out || !*args_len_out) {
-        if (*args_out)
-            efree(*args_out);
-        if (*args_len_out)
-            efree(*args_len_out);
+    if (!arena_alloc_args(arena, arg_count, args_out, args_len_out)) {
         return 0;
     }
 
@@ -1069,6 +938,7 @@ int prepare_x_del_args(x_command_args_t* args, uintptr_t** args_out, unsigned lo
  * Prepare arguments for XRANGE/XREVRANGE commands.
  */
 int prepare_x_range_args(x_command_args_t* args,
+                         arg_arena_t*      arena,
                          uintptr_t**       args_out,
                          unsigned long**   args_len_out) {
     /* Check if client and arguments are valid */
@@ -1079,15 +949,7 @@ int prepare_x_range_args(x_command_args_t* args,
 
     /* Calculate total args: key + start + end + (COUNT + count_value) */
     unsigned long arg_count = 1 + 1 + 1 + (args->range_opts.has_count ? 2 : 0);
-    *args_out               = (uintptr_t*)emalloc(arg_count * sizeof(uintptr_t));
-    *args_len_out           = (unsigned long*)emalloc(arg_count * sizeof(unsigned long));
-
-    /* Check if memory allocation was successful */
-    if (!*args_out || !*args_len_out) {
-        if (*args_out)
-            efree(*args_out);
-        if (*args_len_out)
-            efree(*args_len_out);
+    if (!arena_alloc_args(arena, arg_count, args_out, args_len_out)) {
         return 0;
     }
 
@@ -1117,20 +979,12 @@ int prepare_x_range_args(x_command_args_t* args,
         arg_idx++;
 
         /* Convert count to string */
-        char          count_str[32];
-        unsigned long count_str_len =
-            snprintf(count_str, sizeof(count_str), "%ld", args->range_opts.count);
-
-        /* Allocate memory for the string */
-        char* count_str_copy = emalloc(count_str_len + 1);
-        if (count_str_copy) {
-            memcpy(count_str_copy, count_str, count_str_len);
-            count_str_copy[count_str_len] = '\0';
-
-            (*args_out)[arg_idx]     = (uintptr_t)count_str_copy;
-            (*args_len_out)[arg_idx] = count_str_len;
-            arg_idx++;
-        }
+        size_t count_str_len;
+        char*  count_str = arena_long_to_string(arena, args->range_opts.count, &count_str_len);
+
+        (*args_out)[arg_idx]     = (uintptr_t)count_str;
+        (*args_len_out)[arg_idx] = count_str_len;
+        arg_idx++;
     }
 
     return arg_count;
@@ -1140,10 +994,9 @@ int prepare_x_range_args(x_command_args_t* args,
  * Prepare arguments for XADD command.
  */
 int prepare_x_add_args(x_command_args_t* args,
+                       arg_arena_t*      arena,
                        uintptr_t**       args_out,
-                       unsigned long**   args_len_out,
-                       char***           allocated_strings,
-                       int*              allocated_count) {
+                       unsigned long**   args_len_out) {
     /* Check if client and arguments are valid */
     if (!args->glide_client || !args->key || args->key_len <= 0 || !args->id || args->id_len <= 0 ||
         !args->field_values || args->fv_count <= 0) {
@@ -1164,20 +1017,7 @@ int prepare_x_add_args(x_command_args_t* args,
 
     /* Calculate total args: key + options + ID + field/value pairs (each entry is a pair) */
     unsigned long arg_count = 1 + extra_args + 1 + (args->fv_count * 2);
-    *args_out               = (uintptr_t*)emalloc(arg_count * sizeof(uintptr_t));
-    *args_len_out           = (unsigned long*)emalloc(arg_count * sizeof(unsigned long));
-
-    /* Allocate array to track temporary string allocations */
-    *allocated_strings = (char**)ecalloc(args->fv_count + 5, sizeof(char*));
-    *allocated_count   = 0;
-
-    if (!*args_out || !*args_len_out || !*allocated_strings) {
-        if (*args_out)
-            efree(*args_out);
-        if (*args_len_out)
-            efree(*args_len_out);
-        if (*allocated_strings)
-            efree(*allocated_strings);
+    if (!arena_alloc_args(arena, arg_count, args_out, args_len_out)) {
         return 0;
     }
 
@@ -1196,10 +1036,6 @@ int prepare_x_add_args(x_command_args_t* args,
 
     /* Add MAXLEN/MINID if specified */
     if (args->add_opts.has_maxlen) {
-        char          maxlen_str[64];
-        unsigned long maxlen_str_len = 0;
-        maxlen_str_len = snprintf(maxlen_str, sizeof(maxlen_str), "%ld", args->add_opts.maxlen);
-
         if (args->add_opts.minid_strategy) {
             (*args_out)[arg_idx]     = (uintptr_t)"MINID";
             (*args_len_out)[arg_idx] = sizeof("MINID") - 1;
@@ -1216,16 +1052,13 @@ int prepare_x_add_args(x_command_args_t* args,
             arg_idx++;
         }
 
-        /* Add the threshold value - need to allocate a copy for persistence */
-        char* maxlen_str_copy = estrndup(maxlen_str, maxlen_str_len);
-        if (maxlen_str_copy) {
-            (*allocated_strings)[*allocated_count] = maxlen_str_copy;
-            (*allocated_count)++;
+        /* Add the threshold value */
+        size_t maxlen_str_len;
+        char*  maxlen_str = arena_long_to_string(arena, args->add_opts.maxlen, &maxlen_str_len);
 
-            (*args_out)[arg_idx]     = (uintptr_t)maxlen_str_copy;
-            (*args_len_out)[arg_idx] = maxlen_str_len;
-            arg_idx++;
-        }
+        (*args_out)[arg_idx]     = (uintptr_t)maxlen_str;
+        (*args_len_out)[arg_idx] = maxlen_str_len;
+        arg_idx++;
     }
 
     /* Add stream ID */
@@ -1246,28 +1079,12 @@ int prepare_x_add_args(x_command_args_t* args,
             arg_idx++;
 
             /* Add field value, convert to string if needed */
-            if (Z_TYPE_P(z_value) != IS_STRING) {
-                zval temp;
-                ZVAL_COPY(&temp, z_value);
-                convert_to_string(&temp);
-
-                /* Create persistent copy of the string */
-                char* str_copy = estrndup(Z_STRVAL(temp), Z_STRLEN(temp));
-                if (str_copy) {
-                    (*allocated_strings)[*allocated_count] = str_copy;
-                    (*allocated_count)++;
-
-                    (*args_out)[arg_idx]     = (uintptr_t)str_copy;
-                    (*args_len_out)[arg_idx] = Z_STRLEN(temp);
-                    arg_idx++;
-                }
+            size_t value_len;
+            char*  value = arena_zval_to_string(arena, z_value, &value_len);
 
-                zval_dtor(&temp);
-            } else {
-                (*args_out)[arg_idx]     = (uintptr_t)Z_STRVAL_P(z_value);
-                (*args_len_out)[arg_idx] = Z_STRLEN_P(z_value);
-                arg_idx++;
-            }
+            (*args_out)[arg_idx]     = (uintptr_t)value;
+            (*args_len_out)[arg_idx] = value_len;
+            arg_idx++;
         }
     }
     ZEND_HASH_FOREACH_END();
@@ -1279,6 +1096,7 @@ int prepare_x_add_args(x_command_args_t* args,
  * Prepare arguments for XGROUP command.
  */
 int prepare_x_group_args(x_command_args_t* args,
+                         arg_arena_t*      arena,
                          uintptr_t**       args_out,
                          unsigned long**   args_len_out) {
     /* Check if client and arguments are valid */
@@ -1287,7 +1105,7 @@ int prepare_x_group_args(x_command_args_t* args,
     }
 
     /* Allocate memory for arguments */
-    if (!allocate_command_args(args->args_count, args_out, args_len_out)) {
+    if (!arena_alloc_args(arena, args->args_count, args_out, args_len_out)) {
         return 0;
     }
 
@@ -1318,6 +1136,7 @@ int prepare_x_group_args(x_command_args_t* args,
  * Prepare arguments for XPENDING command.
  */
 int prepare_x_pending_args(x_command_args_t* args,
+                           arg_arena_t*      arena,
                            uintptr_t**       args_out,
                            unsigned long**   args_len_out) {
     /* Check if client and arguments are valid */
@@ -1341,7 +1160,7 @@ int prepare_x_pending_args(x_command_args_t* args,
     unsigned long arg_count = 2 + extra_args;
 
     /* Allocate memory for arguments */
-    if (!allocate_command_args(arg_count, args_out, args_len_out)) {
+    if (!arena_alloc_args(arena, arg_count, args_out, args_len_out)) {
         return 0;
     }
 
@@ -1370,23 +1189,12 @@ int prepare_x_pending_args(x_command_args_t* args,
 
     if (args->pending_opts.has_count) {
         /* Convert count to string */
-        char          count_str[32];
-        unsigned long count_str_len =
-            snprintf(count_str, sizeof(count_str), "%ld", args->pending_opts.count);
-
-        /* Allocate memory for the count string */
-        char* count_str_copy = emalloc(count_str_len + 1);
-        if (count_str_copy) {
-            memcpy(count_str_copy, count_str, count_str_len);
-            count_str_copy[count_str_len] = '\0';
-
-            (*args_out)[arg_idx]     = (uintptr_t)count_str_copy;
-            (*args_len_out)[arg_idx] = count_str_len;
-            arg_idx++;
+        size_t count_str_len;
+        char*  count_str = arena_long_to_string(arena, args->pending_opts.count, &count_str_len);
 
-            /* This needs to be freed later */
-            (*args_out)[arg_count - 1] = (uintptr_t)count_str_copy;
-        }
+        (*args_out)[arg_idx]     = (uintptr_t)count_str;
+        (*args_len_out)[arg_idx] = count_str_len;
+        arg_idx++;
     }
 
     if (args->pending_opts.consumer) {
@@ -1402,6 +1210,7 @@ int prepare_x_pending_args(x_command_args_t* args,
  * Prepare arguments for XREADGROUP command.
  */
 int prepare_x_readgroup_args(x_command_args_t* args,
+                             arg_arena_t*      arena,
                              uintptr_t**       args_out,
                              unsigned long**   args_len_out) {
     /* Check if client and arguments are valid */
@@ -1434,7 +1243,7 @@ int prepare_x_readgroup_args(x_command_args_t* args,
     unsigned long arg_count = 3 + extra_args + 1 + streams_count + ids_count;
 
     /* Allocate memory for arguments */
-    if (!allocate_command_args(arg_count, args_out, args_len_out)) {
+    if (!arena_alloc_args(arena, arg_count, args_out, args_len_out)) {
         return 0;
     }
 
@@ -1461,20 +1270,12 @@ int prepare_x_readgroup_args(x_command_args_t* args,
         arg_idx++;
 
         /* Convert count to string */
-        char          count_str[32];
-        unsigned long count_str_len =
-            snprintf(count_str, sizeof(count_str), "%ld", args->read_opts.count);
-
-        /* Allocate memory for the count string */
-        char* count_str_copy = emalloc(count_str_len + 1);
-        if (count_str_copy) {
-            memcpy(count_str_copy, count_str, count_str_len);
-            count_str_copy[count_str_len] = '\0';
-
-            (*args_out)[arg_idx]     = (uintptr_t)count_str_copy;
-            (*args_len_out)[arg_idx] = count_str_len;
-            arg_idx++;
-        }
+        size_t count_str_len;
+        char*  count_str = arena_long_to_string(arena, args->read_opts.count, &count_str_len);
+
+        (*args_out)[arg_idx]     = (uintptr_t)count_str;
+        (*args_len_out)[arg_idx] = count_str_len;
+        arg_idx++;
     }
 
     /* Add BLOCK if specified */
@@ -1484,20 +1285,12 @@ int prepare_x_readgroup_args(x_command_args_t* args,
         arg_idx++;
 
         /* Convert block to string */
-        char          block_str[32];
-        unsigned long block_str_len =
-            snprintf(block_str, sizeof(block_str), "%ld", args->read_opts.block);
-
-        /* Allocate memory for the block string */
-        char* block_str_copy = emalloc(block_str_len + 1);
-        if (block_str_copy) {
-            memcpy(block_str_copy, block_str, block_str_len);
-            block_str_copy[block_str_len] = '\0';
-
-            (*args_out)[arg_idx]     = (uintptr_t)block_str_copy;
-            (*args_len_out)[arg_idx] = block_str_len;
-            arg_idx++;
-        }
+        size_t block_str_len;
+        char*  block_str = arena_long_to_string(arena, args->read_opts.block, &block_str_len);
+
+        (*args_out)[arg_idx]     = (uintptr_t)block_str;
+        (*args_len_out)[arg_idx] = block_str_len;
+        arg_idx++;
     }
 
     /* Add NOACK if specified */
@@ -1543,6 +1336,7 @@ int prepare_x_readgroup_args(x_command_args_t* args,
  * Prepare arguments for XREAD command.
  */
 int prepare_x_read_args(x_command_args_t* args,
+                        arg_arena_t*      arena,
                         uintptr_t**       args_out,
                         unsigned long**   args_len_out) {
     /* Check if client and arguments are valid */
@@ -1574,7 +1368,7 @@ int prepare_x_read_args(x_command_args_t* args,
     unsigned long arg_count = extra_args + 1 + streams_count + ids_count;
 
     /* Allocate memory for arguments */
-    if (!allocate_command_args(arg_count, args_out, args_len_out)) {
+    if (!arena_alloc_args(arena, arg_count, args_out, args_len_out)) {
         return 0;
     }
 
@@ -1588,20 +1382,12 @@ int prepare_x_read_args(x_command_args_t* args,
         arg_idx++;
 
         /* Convert count to string */
-        char          count_str[32];
-        unsigned long count_str_len =
-            snprintf(count_str, sizeof(count_str), "%ld", args->read_opts.count);
-
-        /* Allocate memory for the count string */
-        char* count_str_copy = emalloc(count_str_len + 1);
-        if (count_str_copy) {
-            memcpy(count_str_copy, count_str, count_str_len);
-            count_str_copy[count_str_len] = '\0';
-
-            (*args_out)[arg_idx]     = (uintptr_t)count_str_copy;
-            (*args_len_out)[arg_idx] = count_str_len;
-            arg_idx++;
-        }
+        size_t count_str_len;
+        char*  count_str = arena_long_to_string(arena, args->read_opts.count, &count_str_len);
+
+        (*args_out)[arg_idx]     = (uintptr_t)count_str;
+        (*args_len_out)[arg_idx] = count_str_len;
+        arg_idx++;
     }
 
     /* Add BLOCK if specified */
@@ -1611,20 +1397,12 @@ int prepare_x_read_args(x_command_args_t* args,
         arg_idx++;
 
         /* Convert block to string */
-        char          block_str[32];
-        unsigned long block_str_len =
-            snprintf(block_str, sizeof(block_str), "%ld", args->read_opts.block);
-
-        /* Allocate memory for the block string */
-        char* block_str_copy = emalloc(block_str_len + 1);
-        if (block_str_copy) {
-            memcpy(block_str_copy, block_str, block_str_len);
-            block_str_copy[block_str_len] = '\0';
-
-            (*args_out)[arg_idx]     = (uintptr_t)block_str_copy;
-            (*args_len_out)[arg_idx] = block_str_len;
-            arg_idx++;
-        }
+        size_t block_str_len;
+        char*  block_str = arena_long_to_string(arena, args->read_opts.block, &block_str_len);
+
+        (*args_out)[arg_idx]     = (uintptr_t)block_str;
+        (*args_len_out)[arg_idx] = block_str_len;
+        arg_idx++;
     }
 
     /* Add NOACK if specified */
@@ -1670,6 +1448,7 @@ int prepare_x_read_args(x_command_args_t* args,
  * Prepare arguments for XCLAIM command.
  */
 int prepare_x_claim_args(x_command_args_t* args,
+                         arg_arena_t*      arena,
                          uintptr_t**       args_out,
                          unsigned long**   args_len_out) {
     /* Check if client and arguments are valid */
@@ -1696,7 +1475,7 @@ int prepare_x_claim_args(x_command_args_t* args,
     unsigned long arg_count = 4 + extra_args + args->id_count;
 
     /* Allocate memory for arguments */
-    if (!allocate_command_args(arg_count, args_out, args_len_out)) {
+    if (!arena_alloc_args(arena, arg_count, args_out, args_len_out)) {
         return 0;
     }
 
@@ -1715,27 +1494,12 @@ int prepare_x_claim_args(x_command_args_t* args,
     arg_idx++;
 
     /* Convert min_idle_time to string */
-    char          min_idle_str[32];
-    unsigned long min_idle_str_len =
-        snprintf(min_idle_str, sizeof(min_idle_str), "%ld", args->min_idle_time);
-
-    /* Allocate memory for the min_idle_time string */
-    char* min_idle_str_copy = emalloc(min_idle_str_len + 1);
-    if (min_idle_str_copy) {
-        memcpy(min_idle_str_copy, min_idle_str, min_idle_str_len);
-        min_idle_str_copy[min_idle_str_len] = '\0';
-
-        (*args_out)[arg_idx]     = (uintptr_t)min_idle_str_copy;
-        (*args_len_out)[arg_idx] = min_idle_str_len;
-        arg_idx++;
+    size_t min_idle_str_len;
+    char*  min_idle_str = arena_long_to_string(arena, args->min_idle_time, &min_idle_str_len);
 
-        /* This string needs to be freed later */
-        // TODO: Track this string for cleanup
-    } else {
-        /* Failed to allocate memory for min_idle_time */
-        free_command_args(*args_out, *args_len_out);
-        return 0;
-    }
+    (*args_out)[arg_idx]     = (uintptr_t)min_idle_str;
+    (*args_len_out)[arg_idx] = min_idle_str_len;
+    arg_idx++;
 
     /* Add all message IDs */
     zval* z_id;
@@ -1756,23 +1520,12 @@ int prepare_x_claim_args(x_command_args_t* args,
         arg_idx++;
 
         /* Convert idle to string */
-        char          idle_str[32];
-        unsigned long idle_str_len =
-            snprintf(idle_str, sizeof(idle_str), "%ld", args->claim_opts.idle);
-
-        /* Allocate memory for the idle string */
-        char* idle_str_copy = emalloc(idle_str_len + 1);
-        if (idle_str_copy) {
-            memcpy(idle_str_copy, idle_str, idle_str_len);
-            idle_str_copy[idle_str_len] = '\0';
-
-            (*args_out)[arg_idx]     = (uintptr_t)idle_str_copy;
-            (*args_len_out)[arg_idx] = idle_str_len;
-            arg_idx++;
+        size_t idle_str_len;
+        char*  idle_str = arena_long_to_string(arena, args->claim_opts.idle, &idle_str_len);
 
-            /* This string needs to be freed later */
-            // TODO: Track this string for cleanup
-        }
+        (*args_out)[arg_idx]     = (uintptr_t)idle_str;
+        (*args_len_out)[arg_idx] = idle_str_len;
+        arg_idx++;
     }
 
     if (args->claim_opts.has_time) {
@@ -1781,23 +1534,12 @@ int prepare_x_claim_args(x_command_args_t* args,
         arg_idx++;
 
         /* Convert time to string */
-        char          time_str[32];
-        unsigned long time_str_len =
-            snprintf(time_str, sizeof(time_str), "%ld", args->claim_opts.time);
-
-        /* Allocate memory for the time string */
-        char* time_str_copy = emalloc(time_str_len + 1);
-        if (time_str_copy) {
-            memcpy(time_str_copy, time_str, time_str_len);
-            time_str_copy[time_str_len] = '\0';
-
-            (*args_out)[arg_idx]     = (uintptr_t)time_str_copy;
-            (*args_len_out)[arg_idx] = time_str_len;
-            arg_idx++;
+        size_t time_str_len;
+        char*  time_str = arena_long_to_string(arena, args->claim_opts.time, &time_str_len);
 
-            /* This string needs to be freed later */
-            // TODO: Track this string for cleanup
-        }
+        (*args_out)[arg_idx]     = (uintptr_t)time_str;
+        (*args_len_out)[arg_idx] = time_str_len;
+        arg_idx++;
     }
 
     if (args->claim_opts.has_retrycount) {
@@ -1806,23 +1548,12 @@ int prepare_x_claim_args(x_command_args_t* args,
         arg_idx++;
 
         /* Convert retrycount to string */
-        char          retry_str[32];
-        unsigned long retry_str_len =
-            snprintf(retry_str, sizeof(retry_str), "%ld", args->claim_opts.retrycount);
-
-        /* Allocate memory for the retry string */
-        char* retry_str_copy = emalloc(retry_str_len + 1);
-        if (retry_str_copy) {
-            memcpy(retry_str_copy, retry_str, retry_str_len);
-            retry_str_copy[retry_str_len] = '\0';
-
-            (*args_out)[arg_idx]     = (uintptr_t)retry_str_copy;
-            (*args_len_out)[arg_idx] = retry_str_len;
-            arg_idx++;
+        size_t retry_str_len;
+        char*  retry_str = arena_long_to_string(arena, args->claim_opts.retrycount, &retry_str_len);
 
-            /* This string needs to be freed later */
-            // TODO: Track this string for cleanup
-        }
+        (*args_out)[arg_idx]     = (uintptr_t)retry_str;
+        (*args_len_out)[arg_idx] = retry_str_len;
+        arg_idx++;
     }
 
     if (args->claim_opts.force) {
@@ -1844,6 +1575,7 @@ int prepare_x_claim_args(x_command_args_t* args,
  * Prepare arguments for XAUTOCLAIM command.
  */
 int prepare_x_autoclaim_args(x_command_args_t* args,
+                             arg_arena_t*      arena,
                              uintptr_t**       args_out,
                              unsigned long**   args_len_out) {
     /* Check if client and arguments are valid */
@@ -1864,7 +1596,7 @@ int prepare_x_autoclaim_args(x_command_args_t* args,
     unsigned long arg_count = 5 + extra_args;
 
     /* Allocate memory for arguments */
-    if (!allocate_command_args(arg_count, args_out, args_len_out)) {
+    if (!arena_alloc_args(arena, arg_count, args_out, args_len_out)) {
         return 0;
     }
 
@@ -1883,27 +1615,12 @@ int prepare_x_autoclaim_args(x_command_args_t* args,
     arg_idx++;
 
     /* Convert min_idle_time to string */
-    char          min_idle_str[32];
-    unsigned long min_idle_str_len =
-        snprintf(min_idle_str, sizeof(min_idle_str), "%ld", args->min_idle_time);
-
-    /* Allocate memory for the min_idle_time string */
-    char* min_idle_str_copy = emalloc(min_idle_str_len + 1);
-    if (min_idle_str_copy) {
-        memcpy(min_idle_str_copy, min_idle_str, min_idle_str_len);
-        min_idle_str_copy[min_idle_str_len] = '\0';
-
-        (*args_out)[arg_idx]     = (uintptr_t)min_idle_str_copy;
-        (*args_len_out)[arg_idx] = min_idle_str_len;
-        arg_idx++;
+    size_t min_idle_str_len;
+    char*  min_idle_str = arena_long_to_string(arena, args->min_idle_time, &min_idle_str_len);
 
-        /* This string needs to be freed later */
-        // TODO: Track this string for cleanup
-    } else {
-        /* Failed to allocate memory for min_idle_time */
-        free_command_args(*args_out, *args_len_out);
-        return 0;
-    }
+    (*args_out)[arg_idx]     = (uintptr_t)min_idle_str;
+    (*args_len_out)[arg_idx] = min_idle_str_len;
+    arg_idx++;
 
     /* Add start ID */
     (*args_out)[arg_idx]     = (uintptr_t)args->start;
@@ -1917,23 +1634,12 @@ int prepare_x_autoclaim_args(x_command_args_t* args,
         arg_idx++;
 
         /* Convert count to string */
-        char          count_str[32];
-        unsigned long count_str_len =
-            snprintf(count_str, sizeof(count_str), "%ld", args->claim_opts.count);
-
-        /* Allocate memory for the count string */
-        char* count_str_copy = emalloc(count_str_len + 1);
-        if (count_str_copy) {
-            memcpy(count_str_copy, count_str, count_str_len);
-            count_str_copy[count_str_len] = '\0';
-
-            (*args_out)[arg_idx]     = (uintptr_t)count_str_copy;
-            (*args_len_out)[arg_idx] = count_str_len;
-            arg_idx++;
+        size_t count_str_len;
+        char*  count_str = arena_long_to_string(arena, args->claim_opts.count, &count_str_len);
 
-            /* This string needs to be freed later */
-            // TODO: Track this string for cleanup
-        }
+        (*args_out)[arg_idx]     = (uintptr_t)count_str;
+        (*args_len_out)[arg_idx] = count_str_len;
+        arg_idx++;
     }
 
     /* Add JUSTID if specified */
@@ -1950,6 +1656,7 @@ int prepare_x_autoclaim_args(x_command_args_t* args,
  * Prepare arguments for XTRIM command.
  */
 int prepare_x_trim_args(x_command_args_t* args,
+                        arg_arena_t*      arena,
                         uintptr_t**       args_out,
                         unsigned long**   args_len_out) {
     /* Check if client and arguments are valid */
@@ -1961,14 +1668,7 @@ int prepare_x_trim_args(x_command_args_t* args,
     /* Calculate total args: key + strategy + [~] + threshold + [LIMIT + value] */
     unsigned long arg_count =
         1 + 1 + (args->trim_opts.approximate ? 1 : 0) + 1 + (args->trim_opts.has_limit ? 2 : 0);
-    *args_out     = (uintptr_t*)emalloc(arg_count * sizeof(uintptr_t));
-    *args_len_out = (unsigned long*)emalloc(arg_count * sizeof(unsigned long));
-
-    if (!*args_out || !*args_len_out) {
-        if (*args_out)
-            efree(*args_out);
-        if (*args_len_out)
-            efree(*args_len_out);
+    if (!arena_alloc_args(arena, arg_count, args_out, args_len_out)) {
         return 0;
     }
 
@@ -2002,20 +1702,12 @@ int prepare_x_trim_args(x_command_args_t* args,
         arg_idx++;
 
         /* Convert limit to string */
-        char          limit_str[32];
-        unsigned long limit_str_len =
-            snprintf(limit_str, sizeof(limit_str), "%ld", args->trim_opts.limit);
-
-        /* Need to allocate memory for the string */
-        char* limit_str_copy = emalloc(limit_str_len + 1);
-        if (limit_str_copy) {
-            memcpy(limit_str_copy, limit_str, limit_str_len);
-            limit_str_copy[limit_str_len] = '\0';
-
-            (*args_out)[arg_idx]     = (uintptr_t)limit_str_copy;
-            (*args_len_out)[arg_idx] = limit_str_len;
-            arg_idx++;
-        }
+        size_t limit_str_len;
+        char*  limit_str = arena_long_to_string(arena, args->trim_opts.limit, &limit_str_len);
+
+        (*args_out)[arg_idx]     = (uintptr_t)limit_str;
+        (*args_len_out)[arg_idx] = limit_str_len;
+        arg_idx++;
     }
 
     return arg_count;
@@ -20,6 +20,7 @@
 #include "command_response.h"
 #include "include/glide_bindings.h"
 #include "valkey_glide_list_common.h"
+#include "valkey_glide_otel.h"
 #include "valkey_glide_s_common.h"
 #include "valkey_glide_z_common.h"
 
@@ -47,10 +48,6 @@
 #include <ext/session/php_session.h>
 #endif
 
-/* Import the string conversion functions from command_response.c */
-extern char* long_to_string(long value, size_t* len);
-extern char* double_to_string(double value, size_t* len);
-
 int execute_zrandmember_command(zval* object, int argc, zval* return_value, zend_class_entry* ce) {
     char*     key = NULL;
     size_t    key_len;
@@ -1678,12 +1675,10 @@ int prepare_mpop_arguments(const void*     glide_client,
                            const char*     from,
                            size_t          from_len,
                            long            count,
+                           arg_arena_t*    arena,
                            unsigned long*  arg_count_ptr,
                            uintptr_t**     args_ptr,
-                           unsigned long** args_len_ptr,
-                           char**          numkeys_str_ptr,
-                           char**          timeout_str_ptr,
-                           char**          count_str_ptr) {
+                           unsigned long** args_len_ptr) {
     /* Get the number of keys */
     int keys_count = 0;
     if (Z_TYPE_P(keys) == IS_ARRAY) {
@@ -1702,16 +1697,14 @@ int prepare_mpop_arguments(const void*     glide_client,
     if (is_blocking) {
         arg_count++; /* Add timeout for blocking commands */
     }
+    if (count > 1) {
+        arg_count += 2; /* COUNT + value */
+    }
 
     /* Allocate memory for arguments */
-    uintptr_t*     args     = (uintptr_t*)emalloc(arg_count * sizeof(uintptr_t));
-    unsigned long* args_len = (unsigned long*)emalloc(arg_count * sizeof(unsigned long));
-
-    if (!args || !args_len) {
-        if (args)
-            efree(args);
-        if (args_len)
-            efree(args_len);
+    uintptr_t*     args;
+    unsigned long* args_len;
+    if (!arena_alloc_args(arena, arg_count, &args, &args_len)) {
         return 0;
     }
 
@@ -1722,35 +1715,19 @@ int prepare_mpop_arguments(const void*     glide_client,
     if (is_blocking) {
         /* Convert timeout to string */
         size_t timeout_len;
-        char*  timeout_str = alloc_list_double_string(timeout, &timeout_len);
-        if (!timeout_str) {
-            efree(args);
-            efree(args_len);
-            return 0;
-        }
+        char*  timeout_str = arena_printf(arena, &timeout_len, "%.6f", timeout);
+
         args[arg_idx]     = (uintptr_t)timeout_str;
         args_len[arg_idx] = timeout_len;
-        *timeout_str_ptr  = timeout_str;
         arg_idx++;
     }
 
     /* Add numkeys first (this should be the first argument after timeout for blocking commands) */
     size_t numkeys_len;
-    char*  numkeys_str = alloc_list_number_string(keys_count, &numkeys_len);
-    if (!numkeys_str) {
-        efree(args);
-        efree(args_len);
-        if (is_blocking) {
-            efree(*timeout_str_ptr);
-            *timeout_str_ptr = NULL;
-        }
-        return 0;
-    }
-    /* Debug output to see the value being passed */
+    char*  numkeys_str = arena_long_to_string(arena, keys_count, &numkeys_len);
 
     args[arg_idx]     = (uintptr_t)numkeys_str;
     args_len[arg_idx] = numkeys_len;
-    *numkeys_str_ptr  = numkeys_str;
     arg_idx++;
 
     /* Add keys */
@@ -1758,14 +1735,6 @@ int prepare_mpop_arguments(const void*     glide_client,
     zval*      z_key;
     ZEND_HASH_FOREACH_VAL(ht, z_key) {
         if (Z_TYPE_P(z_key) != IS_STRING) {
-            efree(args);
-            efree(args_len);
-            efree(numkeys_str);
-            *numkeys_str_ptr = NULL;
-            if (is_blocking) {
-                efree(*timeout_str_ptr);
-                *timeout_str_ptr = NULL;
-            }
             return 0;
         }
         args[arg_idx]     = (uintptr_t)Z_STRVAL_P(z_key);
@@ -1781,29 +1750,6 @@ int prepare_mpop_arguments(const void*     glide_client,
 
     /* Add COUNT if count > 1 */
     if (count > 1) {
-        /* Increase arg_count for COUNT and its value */
-        arg_count += 2;
-
-        /* Reallocate args and args_len arrays */
-        uintptr_t*     new_args = (uintptr_t*)erealloc(args, arg_count * sizeof(uintptr_t));
-        unsigned long* new_args_len =
-            (unsigned long*)erealloc(args_len, arg_count * sizeof(unsigned long));
-
-        if (!new_args || !new_args_len) {
-            efree(args);
-            efree(args_len);
-            efree(numkeys_str);
-            *numkeys_str_ptr = NULL;
-            if (is_blocking) {
-                efree(*timeout_str_ptr);
-                *timeout_str_ptr = NULL;
-            }
-            return 0;
-        }
-
-        args     = new_args;
-        args_len = new_args_len;
-
         /* Add COUNT keyword */
         args[arg_idx]     = (uintptr_t)"COUNT";
         args_len[arg_idx] = 5;
@@ -1811,21 +1757,10 @@ int prepare_mpop_arguments(const void*     glide_client,
 
         /* Add count value */
         size_t count_len;
-        char*  count_str = alloc_list_number_string(count, &count_len);
-        if (!count_str) {
-            efree(args);
-            efree(args_len);
-            efree(numkeys_str);
-            *numkeys_str_ptr = NULL;
-            if (is_blocking) {
-                efree(*timeout_str_ptr);
-                *timeout_str_ptr = NULL;
-            }
-            return 0;
-        }
+        char*  count_str = arena_long_to_string(arena, count, &count_len);
+
         args[arg_idx]     = (uintptr_t)count_str;
         args_len[arg_idx] = count_len;
-        *count_str_ptr    = count_str;
         arg_idx++;
     }
 
@@ -1855,12 +1790,12 @@ int execute_zmpop_command1(const void* glide_client,
     int is_blocking = (strncmp(cmd, "B", 1) == 0);
 
     /* Prepare for argument construction */
-    unsigned long  arg_count   = 0;
-    uintptr_t*     args        = NULL;
-    unsigned long* args_len    = NULL;
-    char*          numkeys_str = NULL;
-    char*          timeout_str = NULL;
-    char*          count_str   = NULL;
+    unsigned long  arg_count = 0;
+    uintptr_t*     args      = NULL;
+    unsigned long* args_len  = NULL;
+    arg_arena_t    arena;
+
+    arena_init(&arena);
 
     /* Prepare the arguments */
     int keys_count = prepare_mpop_arguments(glide_client,
@@ -1870,14 +1805,13 @@ int execute_zmpop_command1(const void* glide_client,
                                             from,
                                             from_len,
                                             count,
+                                            &arena,
                                             &arg_count,
                                             &args,
-                                            &args_len,
-                                            &numkeys_str,
-                                            &timeout_str,
-                                            &count_str);
+                                            &args_len);
 
-    if (keys_count < 0) {
+    if (keys_count <= 0) {
+        arena_free(&arena);
         return 0;
     }
 
@@ -1885,6 +1819,7 @@ int execute_zmpop_command1(const void* glide_client,
     enum RequestType cmd_type = is_blocking ? BZMPop : ZMPop;
 
     /* Execute the command */
+    uint64_t       span_ptr   = valkey_glide_otel_start_span(cmd_type);
     CommandResult* cmd_result = command(glide_client,
                                         0,         /* channel */
                                         cmd_type,  /* command type */
@@ -1893,18 +1828,12 @@ int execute_zmpop_command1(const void* glide_client,
                                         args_len,  /* argument lengths */
                                         NULL,      /* route bytes */
                                         0,         /* route bytes length */
-                                        0          /* span_ptr */
+                                        span_ptr   /* span_ptr */
     );
+    valkey_glide_otel_end_span(span_ptr);
 
     /* Free the argument strings */
-    if (numkeys_str)
-        efree(numkeys_str);
-    if (timeout_str)
-        efree(timeout_str);
-    if (count_str)
-        efree(count_str);
-    efree(args);
-    efree(args_len);
+    arena_free(&arena);
 
     /* Check if the command was successful */
     if (!cmd_result) {
@@ -2144,24 +2073,18 @@ int execute_bzpopmax_command_internal(
     unsigned long arg_count = keys_count + 1; /* keys + timeout */
 
     /* Allocate argument arrays */
-    uintptr_t*     args     = (uintptr_t*)emalloc(arg_count * sizeof(uintptr_t));
-    unsigned long* args_len = (unsigned long*)emalloc(arg_count * sizeof(unsigned long));
-
-    if (!args || !args_len) {
-        if (args)
-            efree(args);
-        if (args_len)
-            efree(args_len);
-        return 0;
-    }
+    arg_arena_t    arena;
+    uintptr_t*     args;
+    unsigned long* args_len;
+    arena_init(&arena);
+    arena_alloc_args(&arena, arg_count, &args, &args_len);
 
     /* Add keys as arguments */
     int i;
     for (i = 0; i < keys_count; i++) {
         zval* key = &keys[i];
         if (Z_TYPE_P(key) != IS_STRING) {
-            efree(args);
-            efree(args_len);
+            arena_free(&arena);
             return 0;
         }
         args[i]     = (uintptr_t)Z_STRVAL_P(key);
@@ -2170,13 +2093,7 @@ int execute_bzpopmax_command_internal(
 
     /* Add timeout as the last argument */
     size_t timeout_len;
-    char*  timeout_str = double_to_string(timeout, &timeout_len);
-    if (!timeout_str) {
-        efree(args);
-        efree(args_len);
-        return 0;
-    }
-    args[keys_count]     = (uintptr_t)timeout_str;
+    args[keys_count]     = (uintptr_t)arena_printf(&arena, &timeout_len, "%.6g", timeout);
     args_len[keys_count] = timeout_len;
 
     /* Execute the command */
@@ -2187,12 +2104,8 @@ int execute_bzpopmax_command_internal(
                                             args_len   /* argument lengths */
     );
 
-    /* Free the timeout string */
-    efree(timeout_str);
-
-    /* Free the argument arrays */
-    efree(args);
-    efree(args_len);
+    /* Free the arguments */
+    arena_free(&arena);
 
     /* Process the result */
     int status = 0;
@@ -2379,24 +2292,18 @@ int execute_bzpopmin_command_internal(
     unsigned long arg_count = keys_count + 1; /* keys + timeout */
 
     /* Allocate argument arrays */
-    uintptr_t*     args     = (uintptr_t*)emalloc(arg_count * sizeof(uintptr_t));
-    unsigned long* args_len = (unsigned long*)emalloc(arg_count * sizeof(unsigned long));
-
-    if (!args || !args_len) {
-        if (args)
-            efree(args);
-        if (args_len)
-            efree(args_len);
-        return 0;
-    }
+    arg_arena_t    arena;
+    uintptr_t*     args;
+    unsigned long* args_len;
+    arena_init(&arena);
+    arena_alloc_args(&arena, arg_count, &args, &args_len);
 
     /* Add keys as arguments */
     int i;
     for (i = 0; i < keys_count; i++) {
         zval* key = &keys[i];
         if (Z_TYPE_P(key) != IS_STRING) {
-            efree(args);
-            efree(args_len);
+            arena_free(&arena);
             return 0;
         }
         args[i]     = (uintptr_t)Z_STRVAL_P(key);
@@ -2405,13 +2312,7 @@ int execute_bzpopmin_command_internal(
 
     /* Add timeout as the last argument */
     size_t timeout_len;
-    char*  timeout_str = double_to_string(timeout, &timeout_len);
-    if (!timeout_str) {
-        efree(args);
-        efree(args_len);
-        return 0;
-    }
-    args[keys_count]     = (uintptr_t)timeout_str;
+    args[keys_count]     = (uintptr_t)arena_printf(&arena, &timeout_len, "%.6g", timeout);
     args_len[keys_count] = timeout_len;
 
     /* Execute the command */
@@ -2422,12 +2323,8 @@ int execute_bzpopmin_command_internal(
                                             args_len   /* argument lengths */
     );
 
-    /* Free the timeout string */
-    efree(timeout_str);
-
-    /* Free the argument arrays */
-    efree(args);
-    efree(args_len);
+    /* Free the arguments */
+    arena_free(&arena);
 
     /* Process the result */
     int status = 0;
@@ -23,10 +23,6 @@
 #include "command_response.h"
 #include "valkey_glide_commands_common.h"
 
-/* Import the string conversion functions from command_response.c */
-extern char* long_to_string(long value, size_t* len);
-extern char* double_to_string(double value, size_t* len);
-
 /* ====================================================================
  * OPTIONS PARSING HELPERS
  * ==================================================================== */
@@ -263,16 +259,13 @@ int parse_store_options(zval* weights, zval* options, store_options_t* opts) {
  * Returns 1 on success, 0 on failure
  */
 /* Helper function to prepare keys array from zval */
-int prepare_keys_array(zval* keys, int keys_count, uintptr_t** args, unsigned long** args_len) {
-    /* Allocate memory for arguments */
-    *args     = (uintptr_t*)emalloc(keys_count * sizeof(uintptr_t));
-    *args_len = (unsigned long*)emalloc(keys_count * sizeof(unsigned long));
-
-    if (!(*args) || !(*args_len)) {
-        if (*args)
-            efree(*args);
-        if (*args_len)
-            efree(*args_len);
+int prepare_keys_array(zval*           keys,
+                       int             keys_count,
+                       arg_arena_t*    arena,
+                       uintptr_t**     args,
+                       unsigned long** args_len) {
+    /* Allocate the argument arrays in the arena */
+    if (!arena_alloc_args(arena, keys_count, args, args_len)) {
         return 0;
     }
 
@@ -303,8 +296,7 @@ int create_limit_args(range_options_t* opts,
                       uintptr_t*       args,
                       unsigned long*   args_len,
                       int              start_idx,
-                      char**           allocated_strings,
-                      int*             allocated_count) {
+                      arg_arena_t*     arena) {
     if (!opts->has_limit) {
         return 0;
     }
@@ -315,22 +307,14 @@ int create_limit_args(range_options_t* opts,
 
     /* Add offset parameter */
     size_t len;
-    char*  offset_str = long_to_string(opts->limit_offset, &len);
-    if (!offset_str) {
-        return 0;
-    }
-    args[start_idx + 1]                     = (uintptr_t)offset_str;
-    args_len[start_idx + 1]                 = len;
-    allocated_strings[(*allocated_count)++] = offset_str;
+    char*  offset_str       = arena_long_to_string(arena, opts->limit_offset, &len);
+    args[start_idx + 1]     = (uintptr_t)offset_str;
+    args_len[start_idx + 1] = len;
 
     /* Add count parameter */
-    char* count_str = long_to_string(opts->limit_count, &len);
-    if (!count_str) {
-        return 0;
-    }
-    args[start_idx + 2]                     = (uintptr_t)count_str;
-    args_len[start_idx + 2]                 = len;
-    allocated_strings[(*allocated_count)++] = count_str;
+    char* count_str         = arena_long_to_string(arena, opts->limit_count, &len);
+    args[start_idx + 2]     = (uintptr_t)count_str;
+    args_len[start_idx + 2] = len;
 
     return 3; /* LIMIT + offset + count */
 }
@@ -472,40 +456,36 @@ int execute_z_generic_command(const void*          glide_client,
         return 0;
     }
 
-    uintptr_t*     arg_values        = NULL;
-    unsigned long* arg_lens          = NULL;
-    char**         allocated_strings = NULL;
-    int            allocated_count   = 0;
-    int            arg_count         = 0;
-    int            success           = 0;
+    arg_arena_t    arena;
+    uintptr_t*     arg_values = NULL;
+    unsigned long* arg_lens   = NULL;
+    int            arg_count  = 0;
+    int            success    = 0;
+
+    arena_init(&arena);
 
     /* Determine argument preparation method based on command type */
     switch (cmd_type) {
         case ZCard:
-            arg_count = prepare_z_key_args(args, &arg_values, &arg_lens);
+            arg_count = prepare_z_key_args(args, &arena, &arg_values, &arg_lens);
             break;
 
         case ZScore:
         case ZRank:
         case ZRevRank:
-            arg_count = prepare_z_member_args(args, &arg_values, &arg_lens);
+            arg_count = prepare_z_member_args(args, &arena, &arg_values, &arg_lens);
             break;
 
         case ZCount:
         case ZLexCount:
         case ZRemRangeByScore:
         case ZRemRangeByLex:
-            arg_count = prepare_z_range_args(args, &arg_values, &arg_lens);
+            arg_count = prepare_z_range_args(args, &arena, &arg_values, &arg_lens);
             break;
 
         case ZRem:
         case ZMScore:
-            allocated_strings = (char**)emalloc(args->member_count * sizeof(char*));
-            if (!allocated_strings) {
-                return 0;
-            }
-            arg_count = prepare_z_members_args(
-                args, &arg_values, &arg_lens, &allocated_strings, &allocated_count);
+            arg_count = prepare_z_members_args(args, &arena, &arg_values, &arg_lens);
             break;
 
         case ZRange:
@@ -514,30 +494,15 @@ int execute_z_generic_command(const void*          glide_client,
         case ZRangeByLex:
         case ZRevRangeByScore:
         case ZRevRangeByLex:
-            allocated_strings =
-                (char**)emalloc(10 * sizeof(char*)); /* Enough for typical options */
-            if (!allocated_strings) {
-                return 0;
-            }
-            arg_count = prepare_z_complex_range_args(
-                args, &arg_values, cmd_type, &arg_lens, &allocated_strings, &allocated_count);
+            arg_count =
+                prepare_z_complex_range_args(args, &arena, &arg_values, cmd_type, &arg_lens);
             cmd_type = ZRange;
             break;
 
-        case ZIncrBy:
-            arg_count         = 3; /* key + increment + member */
-            arg_values        = (uintptr_t*)emalloc(arg_count * sizeof(uintptr_t));
-            arg_lens          = (unsigned long*)emalloc(arg_count * sizeof(unsigned long));
-            allocated_strings = (char**)emalloc(1 * sizeof(char*));
-
-            if (!arg_values || !arg_lens || !allocated_strings) {
-                if (arg_values)
-                    efree(arg_values);
-                if (arg_lens)
-                    efree(arg_lens);
-                if (allocated_strings)
-                    efree(allocated_strings);
-                return 0;
+        case ZIncrBy: {
+            arg_count = 3; /* key + increment + member */
+            if (!arena_alloc_args(&arena, arg_count, &arg_values, &arg_lens)) {
+                break;
             }
 
             /* Set arguments */
@@ -545,41 +510,21 @@ int execute_z_generic_command(const void*          glide_client,
             arg_lens[0]   = args->key_len;
 
             /* Add increment parameter */
-            char increment_str[64];
-            int  increment_str_len =
-                snprintf(increment_str, sizeof(increment_str), "%.17g", args->increment);
-            char* increment_str_copy = estrndup(increment_str, increment_str_len);
-            if (!increment_str_copy) {
-                efree(arg_values);
-                efree(arg_lens);
-                efree(allocated_strings);
-                return 0;
-            }
-
-            arg_values[1]        = (uintptr_t)increment_str_copy;
-            arg_lens[1]          = increment_str_len;
-            allocated_strings[0] = increment_str_copy;
-            allocated_count      = 1;
+            size_t increment_len;
+            char*  increment_str = arena_double_to_string(&arena, args->increment, &increment_len);
+            arg_values[1]        = (uintptr_t)increment_str;
+            arg_lens[1]          = increment_len;
 
             /* Add member parameter */
             arg_values[2] = (uintptr_t)args->member;
             arg_lens[2]   = args->member_len;
             break;
+        }
 
-        case ZRemRangeByRank:
-            arg_count         = 3; /* key + start + stop */
-            arg_values        = (uintptr_t*)emalloc(arg_count * sizeof(uintptr_t));
-            arg_lens          = (unsigned long*)emalloc(arg_count * sizeof(unsigned long));
-            allocated_strings = (char**)emalloc(2 * sizeof(char*));
-
-            if (!arg_values || !arg_lens || !allocated_strings) {
-                if (arg_values)
-                    efree(arg_values);
-                if (arg_lens)
-                    efree(arg_lens);
-                if (allocated_strings)
-                    efree(allocated_strings);
-                return 0;
+        case ZRemRangeByRank: {
+            arg_count = 3; /* key + start + stop */
+            if (!arena_alloc_args(&arena, arg_count, &arg_values, &arg_lens)) {
+                break;
             }
 
             /* Set arguments */
@@ -587,128 +532,61 @@ int execute_z_generic_command(const void*          glide_client,
             arg_lens[0]   = args->key_len;
 
             /* Add start and end parameters */
-            char start_str[32], end_str[32];
-            int  start_str_len = snprintf(start_str, sizeof(start_str), "%ld", args->start);
-            int  end_str_len   = snprintf(end_str, sizeof(end_str), "%ld", args->end);
-
-            char* start_str_copy = estrndup(start_str, start_str_len);
-            char* end_str_copy   = estrndup(end_str, end_str_len);
-            if (!start_str_copy || !end_str_copy) {
-                if (start_str_copy)
-                    efree(start_str_copy);
-                efree(arg_values);
-                efree(arg_lens);
-                efree(allocated_strings);
-                return 0;
-            }
-
-            arg_values[1]        = (uintptr_t)start_str_copy;
-            arg_lens[1]          = start_str_len;
-            allocated_strings[0] = start_str_copy;
-
-            arg_values[2]        = (uintptr_t)end_str_copy;
-            arg_lens[2]          = end_str_len;
-            allocated_strings[1] = end_str_copy;
-            allocated_count      = 2;
+            size_t len;
+            char*  start_str = arena_long_to_string(&arena, args->start, &len);
+            arg_values[1]    = (uintptr_t)start_str;
+            arg_lens[1]      = len;
+
+            char* end_str = arena_long_to_string(&arena, args->end, &len);
+            arg_values[2] = (uintptr_t)end_str;
+            arg_lens[2]   = len;
             break;
+        }
 
         case ZDiffStore:
         case ZInterStore:
         case ZUnionStore:
-            allocated_strings = (char**)emalloc(20 * sizeof(char*)); /* Enough for store commands */
-            if (!allocated_strings) {
-                return 0;
-            }
-            arg_count = prepare_z_store_args(
-                args, &arg_values, &arg_lens, &allocated_strings, &allocated_count);
+            arg_count = prepare_z_store_args(args, &arena, &arg_values, &arg_lens);
             break;
 
         case ZInterCard:
-            allocated_strings = (char**)emalloc(5 * sizeof(char*)); /* Enough for ZINTERCARD */
-            if (!allocated_strings) {
-                return 0;
-            }
-            arg_count = prepare_z_intercard_args(
-                args, &arg_values, &arg_lens, &allocated_strings, &allocated_count);
+            arg_count = prepare_z_intercard_args(args, &arena, &arg_values, &arg_lens);
             break;
 
         case ZUnion:
-            allocated_strings = (char**)emalloc(20 * sizeof(char*)); /* Enough for ZUNION */
-            if (!allocated_strings) {
-                return 0;
-            }
-            arg_count = prepare_z_union_args(
-                args, &arg_values, &arg_lens, &allocated_strings, &allocated_count);
+        case ZInter:
+            arg_count = prepare_z_union_args(args, &arena, &arg_values, &arg_lens);
             break;
 
         case ZPopMax:
         case ZPopMin:
-            allocated_strings = (char**)emalloc(2 * sizeof(char*)); /* Enough for ZPOP commands */
-            if (!allocated_strings) {
-                return 0;
-            }
-            arg_count = prepare_z_pop_args(
-                args, &arg_values, &arg_lens, &allocated_strings, &allocated_count);
+            arg_count = prepare_z_pop_args(args, &arena, &arg_values, &arg_lens);
             break;
 
         case ZRangeStore:
-            allocated_strings = (char**)emalloc(10 * sizeof(char*)); /* Enough for ZRANGESTORE */
-            if (!allocated_strings) {
-                return 0;
-            }
-            arg_count = prepare_z_rangestore_args(
-                args, &arg_values, &arg_lens, &allocated_strings, &allocated_count);
+            arg_count = prepare_z_rangestore_args(args, &arena, &arg_values, &arg_lens);
             break;
 
         case ZAdd:
-            allocated_strings = (char**)emalloc(20 * sizeof(char*)); /* Enough for ZADD */
-            if (!allocated_strings) {
-                return 0;
-            }
-            arg_count = prepare_z_zadd_args(
-                args, &arg_values, &arg_lens, &allocated_strings, &allocated_count);
+            arg_count = prepare_z_zadd_args(args, &arena, &arg_values, &arg_lens);
             break;
 
         case ZDiff:
-            allocated_strings = (char**)emalloc(5 * sizeof(char*)); /* Enough for ZDIFF */
-            if (!allocated_strings) {
-                return 0;
-            }
-            arg_count = prepare_z_zdiff_args(
-                args, &arg_values, &arg_lens, &allocated_strings, &allocated_count);
-            break;
-
-        case ZInter:
-            allocated_strings = (char**)emalloc(20 * sizeof(char*)); /* Enough for ZINTER */
-            if (!allocated_strings) {
-                return 0;
-            }
-            arg_count = prepare_z_union_args(
-                args, &arg_values, &arg_lens, &allocated_strings, &allocated_count);
+            arg_count = prepare_z_zdiff_args(args, &arena, &arg_values, &arg_lens);
             break;
 
         case ZRandMember:
-            allocated_strings = (char**)emalloc(2 * sizeof(char*)); /* Enough for ZRANDMEMBER */
-            if (!allocated_strings) {
-                return 0;
-            }
-            arg_count = prepare_z_randmember_args(
-                args, &arg_values, &arg_lens, &allocated_strings, &allocated_count);
+            arg_count = prepare_z_randmember_args(args, &arena, &arg_values, &arg_lens);
             break;
 
         default:
             /* Unsupported command type */
-            return 0;
+            break;
     }
 
     /* Check if argument preparation was successful */
-    if (arg_count <= 0) {
-        if (arg_values)
-            efree(arg_values);
-        if (arg_lens)
-            efree(arg_lens);
-        if (allocated_strings)
-            efree(allocated_strings);
+    if (arg_count <= 0 || !arg_values) {
+        arena_free(&arena);
         return 0;
     }
 
@@ -716,19 +594,8 @@ int execute_z_generic_command(const void*          glide_client,
     CommandResult* result =
         execute_command(glide_client, cmd_type, arg_count, arg_values, arg_lens);
 
-    /* Free allocated strings */
-    int i;
-    for (i = 0; i < allocated_count; i++) {
-        if (allocated_strings[i]) {
-            efree(allocated_strings[i]);
-        }
-    }
-    if (allocated_strings)
-        efree(allocated_strings);
-    if (arg_values)
-        efree(arg_values);
-    if (arg_lens)
-        efree(arg_lens);
+    /* The arguments are only borrowed by the command */
+    arena_free(&arena);
 
     /* Check if the command was successful */
     if (!result) {
@@ -757,21 +624,17 @@ int execute_z_generic_command(const void*          glide_client,
 /**
  * Prepare basic Z-command arguments (just key)
  */
-int prepare_z_key_args(z_command_args_t* args, uintptr_t** args_out, unsigned long** args_len_out) {
+int prepare_z_key_args(z_command_args_t* args,
+                       arg_arena_t*      arena,
+                       uintptr_t**       args_out,
+                       unsigned long**   args_len_out) {
     if (!args || !args->key || !args_out || !args_len_out) {
         return 0;
     }
 
     unsigned long arg_count = 1; /* just key */
 
-    *args_out     = (uintptr_t*)emalloc(arg_count * sizeof(uintptr_t));
-    *args_len_out = (unsigned long*)emalloc(arg_count * sizeof(unsigned long));
-
-    if (!(*args_out) || !(*args_len_out)) {
-        if (*args_out)
-            efree(*args_out);
-        if (*args_len_out)
-            efree(*args_len_out);
+    if (!arena_alloc_args(arena, arg_count, args_out, args_len_out)) {
         return 0;
     }
 
@@ -783,30 +646,19 @@ int prepare_z_key_args(z_command_args_t* args, uintptr_t** args_out, unsigned lo
 }
 
 int prepare_z_pop_args(z_command_args_t* args,
+                       arg_arena_t*      arena,
                        uintptr_t**       args_out,
-                       unsigned long**   args_len_out,
-                       char***           allocated_strings,
-                       int*              allocated_count) {
-    if (!args || !args->key || !args_out || !args_len_out || !allocated_strings ||
-        !allocated_count) {
+                       unsigned long**   args_len_out) {
+    if (!args || !args->key || !args_out || !args_len_out) {
         return 0;
     }
 
-    *allocated_count = 0;
-
     unsigned long arg_count = 1;
     if (args->start > 1) {
         arg_count++;
     }
 
-    *args_out     = (uintptr_t*)emalloc(arg_count * sizeof(uintptr_t));
-    *args_len_out = (unsigned long*)emalloc(arg_count * sizeof(unsigned long));
-
-    if (!(*args_out) || !(*args_len_out)) {
-        if (*args_out)
-            efree(*args_out);
-        if (*args_len_out)
-            efree(*args_len_out);
+    if (!arena_alloc_args(arena, arg_count, args_out, args_len_out)) {
         return 0;
     }
 
@@ -814,17 +666,10 @@ int prepare_z_pop_args(z_command_args_t* args,
     (*args_len_out)[0] = args->key_len;
 
     if (args->start > 1) {
-        char count_str[32];
-        snprintf(count_str, sizeof(count_str), "%ld", args->start);
-        char* count_str_copy = estrdup(count_str);
-        if (!count_str_copy) {
-            efree(*args_out);
-            efree(*args_len_out);
-            return 0;
-        }
-        (*args_out)[1]                             = (uintptr_t)count_str_copy;
-        (*args_len_out)[1]                         = strlen(count_str);
-        (*allocated_strings)[(*allocated_count)++] = count_str_copy;
+        size_t len;
+        char*  count_str   = arena_long_to_string(arena, args->start, &len);
+        (*args_out)[1]     = (uintptr_t)count_str;
+        (*args_len_out)[1] = len;
     }
 
     return arg_count;
@@ -834,6 +679,7 @@ int prepare_z_pop_args(z_command_args_t* args,
  * Prepare member-based Z-command arguments (key + member)
  */
 int prepare_z_member_args(z_command_args_t* args,
+                          arg_arena_t*      arena,
                           uintptr_t**       args_out,
                           unsigned long**   args_len_out) {
     if (!args || !args->key || !args->member || !args_out || !args_len_out) {
@@ -846,14 +692,7 @@ int prepare_z_member_args(z_command_args_t* args,
         arg_count++; /* Add WITHSCORE parameter */
     }
 
-    *args_out     = (uintptr_t*)emalloc(arg_count * sizeof(uintptr_t));
-    *args_len_out = (unsigned long*)emalloc(arg_count * sizeof(unsigned long));
-
-    if (!(*args_out) || !(*args_len_out)) {
-        if (*args_out)
-            efree(*args_out);
-        if (*args_len_out)
-            efree(*args_len_out);
+    if (!arena_alloc_args(arena, arg_count, args_out, args_len_out)) {
         return 0;
     }
 
@@ -878,6 +717,7 @@ int prepare_z_member_args(z_command_args_t* args,
  * Prepare range-based Z-command arguments (key + min + max)
  */
 int prepare_z_range_args(z_command_args_t* args,
+                         arg_arena_t*      arena,
                          uintptr_t**       args_out,
                          unsigned long**   args_len_out) {
     if (!args || !args->key || !args->min || !args->max || !args_out || !args_len_out) {
@@ -886,14 +726,7 @@ int prepare_z_range_args(z_command_args_t* args,
 
     unsigned long arg_count = 3; /* key + min + max */
 
-    *args_out     = (uintptr_t*)emalloc(arg_count * sizeof(uintptr_t));
-    *args_len_out = (unsigned long*)emalloc(arg_count * sizeof(unsigned long));
-
-    if (!(*args_out) || !(*args_len_out)) {
-        if (*args_out)
-            efree(*args_out);
-        if (*args_len_out)
-            efree(*args_len_out);
+    if (!arena_alloc_args(arena, arg_count, args_out, args_len_out)) {
         return 0;
     }
 
@@ -914,28 +747,18 @@ int prepare_z_range_args(z_command_args_t* args,
  * Prepare multi-member Z-command arguments (key + multiple members)
  */
 int prepare_z_members_args(z_command_args_t* args,
+                           arg_arena_t*      arena,
                            uintptr_t**       args_out,
-                           unsigned long**   args_len_out,
-                           char***           allocated_strings,
-                           int*              allocated_count) {
+                           unsigned long**   args_len_out) {
     if (!args || !args->key || !args->members || args->member_count <= 0 || !args_out ||
-        !args_len_out || !allocated_strings || !allocated_count) {
+        !args_len_out) {
         return 0;
     }
 
-    *allocated_count = 0;
-
     /* Prepare command arguments */
     unsigned long arg_count = 1 + args->member_count; /* key + members */
 
-    *args_out     = (uintptr_t*)emalloc(arg_count * sizeof(uintptr_t));
-    *args_len_out = (unsigned long*)emalloc(arg_count * sizeof(unsigned long));
-
-    if (!(*args_out) || !(*args_len_out)) {
-        if (*args_out)
-            efree(*args_out);
-        if (*args_len_out)
-            efree(*args_len_out);
+    if (!arena_alloc_args(arena, arg_count, args_out, args_len_out)) {
         return 0;
     }
 
@@ -953,28 +776,11 @@ int prepare_z_members_args(z_command_args_t* args,
             (*args_len_out)[i + 1] = Z_STRLEN_P(z_member);
         } else {
             /* Convert non-string values to string */
-            char*  str_val   = NULL;
-            size_t str_len   = 0;
-            int    need_free = 0;
-
-            str_val = zval_to_string_safe(z_member, &str_len, &need_free);
-
-            if (!str_val) {
-                int j;
-                for (j = 0; j < *allocated_count; j++) {
-                    efree((*allocated_strings)[j]);
-                }
-                efree(*args_out);
-                efree(*args_len_out);
-                return 0;
-            }
+            size_t str_len = 0;
+            char*  str_val = arena_zval_to_string(arena, z_member, &str_len);
 
             (*args_out)[i + 1]     = (uintptr_t)str_val;
             (*args_len_out)[i + 1] = str_len;
-
-            if (need_free) {
-                (*allocated_strings)[(*allocated_count)++] = str_val;
-            }
         }
     }
 
@@ -987,31 +793,19 @@ int prepare_z_members_args(z_command_args_t* args,
 static int convert_zval_to_string_arg(zval*          z_value,
                                       uintptr_t*     arg_ptr,
                                       unsigned long* arg_len_ptr,
-                                      char***        allocated_strings,
-                                      int*           allocated_count) {
+                                      arg_arena_t*   arena) {
     if (Z_TYPE_P(z_value) == IS_STRING) {
         *arg_ptr     = (uintptr_t)Z_STRVAL_P(z_value);
         *arg_len_ptr = Z_STRLEN_P(z_value);
         return 1;
     } else {
         /* Convert non-string values to string */
-        char*  str_val   = NULL;
-        size_t str_len   = 0;
-        int    need_free = 0;
-
-        str_val = zval_to_string_safe(z_value, &str_len, &need_free);
-
-        if (!str_val) {
-            return 0;
-        }
+        size_t str_len = 0;
+        char*  str_val = arena_zval_to_string(arena, z_value, &str_len);
 
         *arg_ptr     = (uintptr_t)str_val;
         *arg_len_ptr = str_len;
 
-        if (need_free) {
-            (*allocated_strings)[(*allocated_count)++] = str_val;
-        }
-
         return 1;
     }
 }
@@ -1020,18 +814,14 @@ static int convert_zval_to_string_arg(zval*          z_value,
  * Prepare complex range Z-command arguments with options
  */
 int prepare_z_complex_range_args(z_command_args_t* args,
+                                 arg_arena_t*      arena,
                                  uintptr_t**       args_out,
                                  enum RequestType  cmd_type,
-                                 unsigned long**   args_len_out,
-                                 char***           allocated_strings,
-                                 int*              allocated_count) {
-    if (!args || !args->key || !args->z_start || !args->z_end || !args_out || !args_len_out ||
-        !allocated_strings || !allocated_count) {
+                                 unsigned long**   args_len_out) {
+    if (!args || !args->key || !args->z_start || !args->z_end || !args_out || !args_len_out) {
         return 0;
     }
 
-    *allocated_count = 0;
-
     /* Parse range options */
     range_options_t range_opts = {0};
     if (!parse_range_options(args->options, &range_opts)) {
@@ -1073,14 +863,7 @@ int prepare_z_complex_range_args(z_command_args_t* args,
         arg_count += 3; /* Add LIMIT + offset + count parameters */
 
     /* Allocate memory for arguments */
-    *args_out     = (uintptr_t*)emalloc(arg_count * sizeof(uintptr_t));
-    *args_len_out = (unsigned long*)emalloc(arg_count * sizeof(unsigned long));
-
-    if (!(*args_out) || !(*args_len_out)) {
-        if (*args_out)
-            efree(*args_out);
-        if (*args_len_out)
-            efree(*args_len_out);
+    if (!arena_alloc_args(arena, arg_count, args_out, args_len_out)) {
         return 0;
     }
 
@@ -1092,24 +875,11 @@ int prepare_z_complex_range_args(z_command_args_t* args,
     if (!convert_zval_to_string_arg(args->z_start,
                                     &((*args_out)[1]),
                                     &((*args_len_out)[1]),
-                                    allocated_strings,
-                                    allocated_count)) {
-        efree(*args_out);
-        efree(*args_len_out);
+                                    arena)) {
         return 0;
     }
 
-    if (!convert_zval_to_string_arg(args->z_end,
-                                    &((*args_out)[2]),
-                                    &((*args_len_out)[2]),
-                                    allocated_strings,
-                                    allocated_count)) {
-        int i;
-        for (i = 0; i < *allocated_count; i++) {
-            efree((*allocated_strings)[i]);
-        }
-        efree(*args_out);
-        efree(*args_len_out);
+    if (!convert_zval_to_string_arg(args->z_end, &((*args_out)[2]), &((*args_len_out)[2]), arena)) {
         return 0;
     }
 
@@ -1143,8 +913,7 @@ int prepare_z_complex_range_args(z_command_args_t* args,
     /* Add LIMIT parameter if required */
     if (range_opts.has_limit) {
         /* Add LIMIT + offset + count using common helper */
-        arg_idx += create_limit_args(
-            &range_opts, *args_out, *args_len_out, arg_idx, *allocated_strings, allocated_count);
+        arg_idx += create_limit_args(&range_opts, *args_out, *args_len_out, arg_idx, arena);
     }
 
     /* Add WITHSCORES if required - add it last as per ValkeyGlide command syntax */
@@ -1162,17 +931,14 @@ int prepare_z_complex_range_args(z_command_args_t* args,
  * Prepare store command arguments (destination + numkeys + keys + weights + aggregate)
  */
 int prepare_z_store_args(z_command_args_t* args,
+                         arg_arena_t*      arena,
                          uintptr_t**       args_out,
-                         unsigned long**   args_len_out,
-                         char***           allocated_strings,
-                         int*              allocated_count) {
+                         unsigned long**   args_len_out) {
     if (!args || !args->key || !args->members || args->member_count <= 0 || !args_out ||
-        !args_len_out || !allocated_strings || !allocated_count) {
+        !args_len_out) {
         return 0;
     }
 
-    *allocated_count = 0;
-
     /* Parse store options */
     store_options_t store_opts = {0};
     parse_store_options(args->weights, args->options, &store_opts);
@@ -1192,14 +958,7 @@ int prepare_z_store_args(z_command_args_t* args,
     }
 
     /* Allocate final args arrays */
-    *args_out     = (uintptr_t*)emalloc(arg_count * sizeof(uintptr_t));
-    *args_len_out = (unsigned long*)emalloc(arg_count * sizeof(unsigned long));
-
-    if (!(*args_out) || !(*args_len_out)) {
-        if (*args_out)
-            efree(*args_out);
-        if (*args_len_out)
-            efree(*args_len_out);
+    if (!arena_alloc_args(arena, arg_count, args_out, args_len_out)) {
         return 0;
     }
 
@@ -1208,17 +967,10 @@ int prepare_z_store_args(z_command_args_t* args,
     (*args_len_out)[0] = args->key_len;
 
     /* Add numkeys as the second argument */
-    char numkeys_str[32];
-    snprintf(numkeys_str, sizeof(numkeys_str), "%d", args->member_count);
-    char* numkeys_str_copy = estrdup(numkeys_str);
-    if (!numkeys_str_copy) {
-        efree(*args_out);
-        efree(*args_len_out);
-        return 0;
-    }
-    (*args_out)[1]                             = (uintptr_t)numkeys_str_copy;
-    (*args_len_out)[1]                         = strlen(numkeys_str);
-    (*allocated_strings)[(*allocated_count)++] = numkeys_str_copy;
+    size_t numkeys_len;
+    char*  numkeys_str = arena_long_to_string(arena, args->member_count, &numkeys_len);
+    (*args_out)[1]     = (uintptr_t)numkeys_str;
+    (*args_len_out)[1] = numkeys_len;
 
     /* Add keys starting from index 2 */
     HashTable* keys_hash = Z_ARRVAL_P(args->members); /* members field is reused for keys */
@@ -1248,28 +1000,12 @@ int prepare_z_store_args(z_command_args_t* args,
         ZEND_HASH_FOREACH_VAL(weights_hash, weight) {
             char*  weight_str = NULL;
             size_t weight_len = 0;
-            int    need_free  = 0;
 
-            weight_str = zval_to_string_safe(weight, &weight_len, &need_free);
-
-            if (!weight_str) {
-                /* Cleanup on error */
-                int j;
-                for (j = 0; j < *allocated_count; j++) {
-                    efree((*allocated_strings)[j]);
-                }
-                efree(*args_out);
-                efree(*args_len_out);
-                return 0;
-            }
+            weight_str = arena_zval_to_string(arena, weight, &weight_len);
 
             (*args_out)[offset]     = (uintptr_t)weight_str;
             (*args_len_out)[offset] = weight_len;
 
-            if (need_free) {
-                (*allocated_strings)[(*allocated_count)++] = weight_str;
-            }
-
             offset++;
         }
         ZEND_HASH_FOREACH_END();
@@ -1281,22 +1017,8 @@ int prepare_z_store_args(z_command_args_t* args,
         (*args_len_out)[offset] = 9;
         offset++;
 
-        const char* agg_str      = Z_STRVAL_P(store_opts.aggregate);
-        char*       agg_str_copy = estrdup(agg_str);
-        if (!agg_str_copy) {
-            /* Cleanup on error */
-            int j;
-            for (j = 0; j < *allocated_count; j++) {
-                efree((*allocated_strings)[j]);
-            }
-            efree(*args_out);
-            efree(*args_len_out);
-            return 0;
-        }
-
-        (*args_out)[offset]                        = (uintptr_t)agg_str_copy;
-        (*args_len_out)[offset]                    = Z_STRLEN_P(store_opts.aggregate);
-        (*allocated_strings)[(*allocated_count)++] = agg_str_copy;
+        (*args_out)[offset]     = (uintptr_t)Z_STRVAL_P(store_opts.aggregate);
+        (*args_len_out)[offset] = Z_STRLEN_P(store_opts.aggregate);
     }
 
     return arg_count;
@@ -1306,17 +1028,13 @@ int prepare_z_store_args(z_command_args_t* args,
  * Prepare ZINTERCARD command arguments (numkeys + keys + optional LIMIT)
  */
 int prepare_z_intercard_args(z_command_args_t* args,
+                             arg_arena_t*      arena,
                              uintptr_t**       args_out,
-                             unsigned long**   args_len_out,
-                             char***           allocated_strings,
-                             int*              allocated_count) {
-    if (!args || !args->members || args->member_count <= 0 || !args_out || !args_len_out ||
-        !allocated_strings || !allocated_count) {
+                             unsigned long**   args_len_out) {
+    if (!args || !args->members || args->member_count <= 0 || !args_out || !args_len_out) {
         return 0;
     }
 
-    *allocated_count = 0;
-
     /* Calculate total arguments (numkeys + keys + LIMIT if present) */
     unsigned long arg_count = 1 + args->member_count; /* +1 for numkeys */
     int           has_limit = 0;
@@ -1333,29 +1051,15 @@ int prepare_z_intercard_args(z_command_args_t* args,
     }
 
     /* Allocate final args arrays */
-    *args_out     = (uintptr_t*)emalloc(arg_count * sizeof(uintptr_t));
-    *args_len_out = (unsigned long*)emalloc(arg_count * sizeof(unsigned long));
-
-    if (!(*args_out) || !(*args_len_out)) {
-        if (*args_out)
-            efree(*args_out);
-        if (*args_len_out)
-            efree(*args_len_out);
+    if (!arena_alloc_args(arena, arg_count, args_out, args_len_out)) {
         return 0;
     }
 
     /* Add numkeys as the first argument */
-    char numkeys_str[32];
-    snprintf(numkeys_str, sizeof(numkeys_str), "%d", args->member_count);
-    char* numkeys_str_copy = estrdup(numkeys_str);
-    if (!numkeys_str_copy) {
-        efree(*args_out);
-        efree(*args_len_out);
-        return 0;
-    }
-    (*args_out)[0]                             = (uintptr_t)numkeys_str_copy;
-    (*args_len_out)[0]                         = strlen(numkeys_str);
-    (*allocated_strings)[(*allocated_count)++] = numkeys_str_copy;
+    size_t numkeys_len;
+    char*  numkeys_str = arena_long_to_string(arena, args->member_count, &numkeys_len);
+    (*args_out)[0]     = (uintptr_t)numkeys_str;
+    (*args_len_out)[0] = numkeys_len;
 
     /* Add keys starting from index 1 */
     HashTable* keys_hash = Z_ARRVAL_P(args->members); /* members field is reused for keys */
@@ -1381,22 +1085,10 @@ int prepare_z_intercard_args(z_command_args_t* args,
         offset++;
 
         /* Add limit value */
-        char limit_str[32];
-        snprintf(limit_str, sizeof(limit_str), "%ld", limit);
-        char* limit_str_copy = estrdup(limit_str);
-        if (!limit_str_copy) {
-            /* Cleanup on error */
-            int j;
-            for (j = 0; j < *allocated_count; j++) {
-                efree((*allocated_strings)[j]);
-            }
-            efree(*args_out);
-            efree(*args_len_out);
-            return 0;
-        }
-        (*args_out)[offset]                        = (uintptr_t)limit_str_copy;
-        (*args_len_out)[offset]                    = strlen(limit_str);
-        (*allocated_strings)[(*allocated_count)++] = limit_str_copy;
+        size_t limit_len;
+        char*  limit_str        = arena_long_to_string(arena, limit, &limit_len);
+        (*args_out)[offset]     = (uintptr_t)limit_str;
+        (*args_len_out)[offset] = limit_len;
     }
 
     return arg_count;
@@ -1406,17 +1098,13 @@ int prepare_z_intercard_args(z_command_args_t* args,
  * Prepare ZUNION command arguments (numkeys + keys + WEIGHTS + AGGREGATE + WITHSCORES if present)
  */
 int prepare_z_union_args(z_command_args_t* args,
+                         arg_arena_t*      arena,
                          uintptr_t**       args_out,
-                         unsigned long**   args_len_out,
-                         char***           allocated_strings,
-                         int*              allocated_count) {
-    if (!args || !args->members || args->member_count <= 0 || !args_out || !args_len_out ||
-        !allocated_strings || !allocated_count) {
+                         unsigned long**   args_len_out) {
+    if (!args || !args->members || args->member_count <= 0 || !args_out || !args_len_out) {
         return 0;
     }
 
-    *allocated_count = 0;
-
     /* Parse union options */
     store_options_t union_opts = {0};
     parse_store_options(args->weights, args->options, &union_opts);
@@ -1439,29 +1127,15 @@ int prepare_z_union_args(z_command_args_t* args,
     }
 
     /* Allocate final args arrays */
-    *args_out     = (uintptr_t*)emalloc(arg_count * sizeof(uintptr_t));
-    *args_len_out = (unsigned long*)emalloc(arg_count * sizeof(unsigned long));
-
-    if (!(*args_out) || !(*args_len_out)) {
-        if (*args_out)
-            efree(*args_out);
-        if (*args_len_out)
-            efree(*args_len_out);
+    if (!arena_alloc_args(arena, arg_count, args_out, args_len_out)) {
         return 0;
     }
 
     /* Add numkeys as the first argument */
-    char numkeys_str[32];
-    snprintf(numkeys_str, sizeof(numkeys_str), "%d", args->member_count);
-    char* numkeys_str_copy = estrdup(numkeys_str);
-    if (!numkeys_str_copy) {
-        efree(*args_out);
-        efree(*args_len_out);
-        return 0;
-    }
-    (*args_out)[0]                             = (uintptr_t)numkeys_str_copy;
-    (*args_len_out)[0]                         = strlen(numkeys_str);
-    (*allocated_strings)[(*allocated_count)++] = numkeys_str_copy;
+    size_t numkeys_len;
+    char*  numkeys_str = arena_long_to_string(arena, args->member_count, &numkeys_len);
+    (*args_out)[0]     = (uintptr_t)numkeys_str;
+    (*args_len_out)[0] = numkeys_len;
 
     /* Add keys starting from index 1 */
     HashTable*   keys_hash = Z_ARRVAL_P(args->members); /* members field is reused for keys */
@@ -1490,28 +1164,12 @@ int prepare_z_union_args(z_command_args_t* args,
         ZEND_HASH_FOREACH_VAL(weights_hash, weight) {
             char*  weight_str = NULL;
             size_t weight_len = 0;
-            int    need_free  = 0;
 
-            weight_str = zval_to_string_safe(weight, &weight_len, &need_free);
-
-            if (!weight_str) {
-                /* Cleanup on error */
-                int j;
-                for (j = 0; j < *allocated_count; j++) {
-                    efree((*allocated_strings)[j]);
-                }
-                efree(*args_out);
-                efree(*args_len_out);
-                return 0;
-            }
+            weight_str = arena_zval_to_string(arena, weight, &weight_len);
 
             (*args_out)[offset]     = (uintptr_t)weight_str;
             (*args_len_out)[offset] = weight_len;
 
-            if (need_free) {
-                (*allocated_strings)[(*allocated_count)++] = weight_str;
-            }
-
             offset++;
         }
         ZEND_HASH_FOREACH_END();
@@ -1525,22 +1183,8 @@ int prepare_z_union_args(z_command_args_t* args,
         offset++;
 
         /* Add aggregate value */
-        const char* agg_str      = Z_STRVAL_P(union_opts.aggregate);
-        char*       agg_str_copy = estrdup(agg_str);
-        if (!agg_str_copy) {
-            /* Cleanup on error */
-            int j;
-            for (j = 0; j < *allocated_count; j++) {
-                efree((*allocated_strings)[j]);
-            }
-            efree(*args_out);
-            efree(*args_len_out);
-            return 0;
-        }
-
-        (*args_out)[offset]                        = (uintptr_t)agg_str_copy;
-        (*args_len_out)[offset]                    = Z_STRLEN_P(union_opts.aggregate);
-        (*allocated_strings)[(*allocated_count)++] = agg_str_copy;
+        (*args_out)[offset]     = (uintptr_t)Z_STRVAL_P(union_opts.aggregate);
+        (*args_len_out)[offset] = Z_STRLEN_P(union_opts.aggregate);
         offset++;
     }
 
@@ -1559,17 +1203,14 @@ int prepare_z_union_args(z_command_args_t* args,
  * Prepare ZRANGESTORE command arguments (dst + src + start + end + range options)
  */
 int prepare_z_rangestore_args(z_command_args_t* args,
+                              arg_arena_t*      arena,
                               uintptr_t**       args_out,
-                              unsigned long**   args_len_out,
-                              char***           allocated_strings,
-                              int*              allocated_count) {
+                              unsigned long**   args_len_out) {
     if (!args || !args->key || !args->member || !args->z_start || !args->z_end || !args_out ||
-        !args_len_out || !allocated_strings || !allocated_count) {
+        !args_len_out) {
         return 0;
     }
 
-    *allocated_count = 0;
-
     /* Parse range options */
     range_options_t range_opts = {0};
     parse_range_options(args->options, &range_opts);
@@ -1586,14 +1227,7 @@ int prepare_z_rangestore_args(z_command_args_t* args,
         arg_count += 3; /* LIMIT + offset + count */
 
     /* Allocate final args arrays */
-    *args_out     = (uintptr_t*)emalloc(arg_count * sizeof(uintptr_t));
-    *args_len_out = (unsigned long*)emalloc(arg_count * sizeof(unsigned long));
-
-    if (!(*args_out) || !(*args_len_out)) {
-        if (*args_out)
-            efree(*args_out);
-        if (*args_len_out)
-            efree(*args_len_out);
+    if (!arena_alloc_args(arena, arg_count, args_out, args_len_out)) {
         return 0;
     }
 
@@ -1604,30 +1238,14 @@ int prepare_z_rangestore_args(z_command_args_t* args,
     (*args_len_out)[1] = args->member_len;
 
     /* Add start and end using framework helper */
-    int    need_free = 0;
     size_t len       = 0;
-    char*  str       = zval_to_string_safe(args->z_start, &len, &need_free);
-    if (!str) {
-        efree(*args_out);
-        efree(*args_len_out);
-        return 0;
-    }
+    char*  str       = arena_zval_to_string(arena, args->z_start, &len);
     (*args_out)[2]     = (uintptr_t)str;
     (*args_len_out)[2] = len;
-    if (need_free)
-        (*allocated_strings)[(*allocated_count)++] = str;
-
-    str = zval_to_string_safe(args->z_end, &len, &need_free);
-    if (!str) {
-        free_allocated_strings(*allocated_strings, *allocated_count);
-        efree(*args_out);
-        efree(*args_len_out);
-        return 0;
-    }
+
+    str = arena_zval_to_string(arena, args->z_end, &len);
     (*args_out)[3]     = (uintptr_t)str;
     (*args_len_out)[3] = len;
-    if (need_free)
-        (*allocated_strings)[(*allocated_count)++] = str;
 
     /* Add range options */
     unsigned int offset = 4;
@@ -1646,8 +1264,7 @@ int prepare_z_rangestore_args(z_command_args_t* args,
         offset++;
     }
     if (range_opts.has_limit) {
-        offset += create_limit_args(
-            &range_opts, *args_out, *args_len_out, offset, *allocated_strings, allocated_count);
+        offset += create_limit_args(&range_opts, *args_out, *args_len_out, offset, arena);
     }
 
     return arg_count;
@@ -1657,17 +1274,14 @@ int prepare_z_rangestore_args(z_command_args_t* args,
  * Prepare ZADD command arguments (key + options + score-member pairs)
  */
 int prepare_z_zadd_args(z_command_args_t* args,
+                        arg_arena_t*      arena,
                         uintptr_t**       args_out,
-                        unsigned long**   args_len_out,
-                        char***           allocated_strings,
-                        int*              allocated_count) {
+                        unsigned long**   args_len_out) {
     if (!args || !args->key || !args->members || args->member_count < 2 || !args_out ||
-        !args_len_out || !allocated_strings || !allocated_count) {
+        !args_len_out) {
         return 0;
     }
 
-    *allocated_count = 0;
-
     /* Parse ZADD options from the first element if it's an array */
     zadd_options_t zadd_opts       = {0};
     int            first_score_idx = 0;
@@ -1697,14 +1311,7 @@ int prepare_z_zadd_args(z_command_args_t* args,
     unsigned long arg_count = 1 + num_options + (score_member_pairs * 2);
 
     /* Allocate final args arrays */
-    *args_out     = (uintptr_t*)emalloc(arg_count * sizeof(uintptr_t));
-    *args_len_out = (unsigned long*)emalloc(arg_count * sizeof(unsigned long));
-
-    if (!(*args_out) || !(*args_len_out)) {
-        if (*args_out)
-            efree(*args_out);
-        if (*args_len_out)
-            efree(*args_len_out);
+    if (!arena_alloc_args(arena, arg_count, args_out, args_len_out)) {
         return 0;
     }
 
@@ -1741,42 +1348,28 @@ int prepare_z_zadd_args(z_command_args_t* args,
 
     /* Add score-member pairs using existing framework helpers */
     for (int i = first_score_idx; i < args->member_count; i += 2) {
-        /* Score - use existing zval_to_string_safe */
+        /* Score - formatted as zval_to_string_safe() would */
         zval*  score     = &args->members[i];
         char*  score_str = NULL;
         size_t score_len = 0;
-        int    need_free = 0;
 
         if (Z_TYPE_P(score) == IS_DOUBLE) {
-            score_str = double_to_string(Z_DVAL_P(score), &score_len);
-            need_free = 1;
+            score_str = arena_printf(arena, &score_len, "%.6g", Z_DVAL_P(score));
         } else if (Z_TYPE_P(score) == IS_LONG) {
-            score_str = long_to_string(Z_LVAL_P(score), &score_len);
-            need_free = 1;
+            score_str = arena_long_to_string(arena, Z_LVAL_P(score), &score_len);
         } else if (Z_TYPE_P(score) == IS_STRING) {
             score_str = Z_STRVAL_P(score);
             score_len = Z_STRLEN_P(score);
         } else {
-            /* Cleanup and return error */
-            free_allocated_strings(*allocated_strings, *allocated_count);
-            efree(*args_out);
-            efree(*args_len_out);
             return 0;
         }
 
         (*args_out)[arg_idx]       = (uintptr_t)score_str;
         (*args_len_out)[arg_idx++] = score_len;
-        if (need_free) {
-            (*allocated_strings)[(*allocated_count)++] = score_str;
-        }
 
         /* Member - validate it's a string */
         zval* member = &args->members[i + 1];
         if (Z_TYPE_P(member) != IS_STRING) {
-            /* Cleanup and return error */
-            free_allocated_strings(*allocated_strings, *allocated_count);
-            efree(*args_out);
-            efree(*args_len_out);
             return 0;
         }
         (*args_out)[arg_idx]       = (uintptr_t)Z_STRVAL_P(member);
@@ -1790,17 +1383,13 @@ int prepare_z_zadd_args(z_command_args_t* args,
  * Prepare ZDIFF command arguments (numkeys + keys + optional WITHSCORES)
  */
 int prepare_z_zdiff_args(z_command_args_t* args,
+                         arg_arena_t*      arena,
                          uintptr_t**       args_out,
-                         unsigned long**   args_len_out,
-                         char***           allocated_strings,
-                         int*              allocated_count) {
-    if (!args || !args->members || args->member_count <= 0 || !args_out || !args_len_out ||
-        !allocated_strings || !allocated_count) {
+                         unsigned long**   args_len_out) {
+    if (!args || !args->members || args->member_count <= 0 || !args_out || !args_len_out) {
         return 0;
     }
 
-    *allocated_count = 0;
-
     /* Parse ZDIFF options (only WITHSCORES supported) */
     store_options_t zdiff_opts = {0};
     parse_store_options(NULL, args->options, &zdiff_opts);
@@ -1812,29 +1401,15 @@ int prepare_z_zdiff_args(z_command_args_t* args,
     }
 
     /* Allocate final args arrays */
-    *args_out     = (uintptr_t*)emalloc(arg_count * sizeof(uintptr_t));
-    *args_len_out = (unsigned long*)emalloc(arg_count * sizeof(unsigned long));
-
-    if (!(*args_out) || !(*args_len_out)) {
-        if (*args_out)
-            efree(*args_out);
-        if (*args_len_out)
-            efree(*args_len_out);
+    if (!arena_alloc_args(arena, arg_count, args_out, args_len_out)) {
         return 0;
     }
 
     /* Add numkeys as the first argument */
-    char numkeys_str[32];
-    snprintf(numkeys_str, sizeof(numkeys_str), "%d", args->member_count);
-    char* numkeys_str_copy = estrdup(numkeys_str);
-    if (!numkeys_str_copy) {
-        efree(*args_out);
-        efree(*args_len_out);
-        return 0;
-    }
-    (*args_out)[0]                             = (uintptr_t)numkeys_str_copy;
-    (*args_len_out)[0]                         = strlen(numkeys_str);
-    (*allocated_strings)[(*allocated_count)++] = numkeys_str_copy;
+    size_t numkeys_len;
+    char*  numkeys_str = arena_long_to_string(arena, args->member_count, &numkeys_len);
+    (*args_out)[0]     = (uintptr_t)numkeys_str;
+    (*args_len_out)[0] = numkeys_len;
 
     /* Add keys starting from index 1 */
     HashTable*   keys_hash = Z_ARRVAL_P(args->members); /* members field is reused for keys */
@@ -1865,17 +1440,13 @@ int prepare_z_zdiff_args(z_command_args_t* args,
  * Prepare ZRANDMEMBER command arguments (key + optional count + optional WITHSCORES)
  */
 int prepare_z_randmember_args(z_command_args_t* args,
+                              arg_arena_t*      arena,
                               uintptr_t**       args_out,
-                              unsigned long**   args_len_out,
-                              char***           allocated_strings,
-                              int*              allocated_count) {
-    if (!args || !args->key || !args_out || !args_len_out || !allocated_strings ||
-        !allocated_count) {
+                              unsigned long**   args_len_out) {
+    if (!args || !args->key || !args_out || !args_len_out) {
         return 0;
     }
 
-    *allocated_count = 0;
-
     /* Calculate argument count: key + optional count + optional WITHSCORES */
     unsigned long arg_count = 1; /* key */
     if (args->start != 1)        /* reuse start field for count */
@@ -1887,14 +1458,7 @@ int prepare_z_randmember_args(z_command_args_t* args,
     }
 
     /* Allocate final args arrays */
-    *args_out     = (uintptr_t*)emalloc(arg_count * sizeof(uintptr_t));
-    *args_len_out = (unsigned long*)emalloc(arg_count * sizeof(unsigned long));
-
-    if (!(*args_out) || !(*args_len_out)) {
-        if (*args_out)
-            efree(*args_out);
-        if (*args_len_out)
-            efree(*args_len_out);
+    if (!arena_alloc_args(arena, arg_count, args_out, args_len_out)) {
         return 0;
     }
 
@@ -1905,17 +1469,10 @@ int prepare_z_randmember_args(z_command_args_t* args,
 
     /* Add count if not default (1) */
     if (args->start != 1) {
-        char count_str[32];
-        snprintf(count_str, sizeof(count_str), "%ld", args->start);
-        char* count_str_copy = estrdup(count_str);
-        if (!count_str_copy) {
-            efree(*args_out);
-            efree(*args_len_out);
-            return 0;
-        }
-        (*args_out)[arg_idx]                       = (uintptr_t)count_str_copy;
-        (*args_len_out)[arg_idx]                   = strlen(count_str);
-        (*allocated_strings)[(*allocated_count)++] = count_str_copy;
+        size_t len;
+        char*  count_str         = arena_long_to_string(arena, args->start, &len);
+        (*args_out)[arg_idx]     = (uintptr_t)count_str;
+        (*args_len_out)[arg_idx] = len;
         arg_idx++;
     }
 
@@ -19,6 +19,7 @@
 
 #include "common.h"
 #include "include/glide_bindings.h"
+#include "valkey_glide_arena.h"
 
 /* ====================================================================
  * STRUCTURE DEFINITIONS
@@ -166,12 +167,16 @@ int process_z_rank_result(CommandResult* result, void* output);
 /**
  * Prepare basic Z-command arguments (just key)
  */
-int prepare_z_key_args(z_command_args_t* args, uintptr_t** args_out, unsigned long** args_len_out);
+int prepare_z_key_args(z_command_args_t* args,
+                       arg_arena_t*      arena,
+                       uintptr_t**       args_out,
+                       unsigned long**   args_len_out);
 
 /**
  * Prepare member-based Z-command arguments (key + member)
  */
 int prepare_z_member_args(z_command_args_t* args,
+                          arg_arena_t*      arena,
                           uintptr_t**       args_out,
                           unsigned long**   args_len_out);
 
@@ -179,6 +184,7 @@ int prepare_z_member_args(z_command_args_t* args,
  * Prepare range-based Z-command arguments (key + min + max)
  */
 int prepare_z_range_args(z_command_args_t* args,
+                         arg_arena_t*      arena,
                          uintptr_t**       args_out,
                          unsigned long**   args_len_out);
 
@@ -186,92 +192,82 @@ int prepare_z_range_args(z_command_args_t* args,
  * Prepare multi-member Z-command arguments (key + multiple members)
  */
 int prepare_z_members_args(z_command_args_t* args,
+                           arg_arena_t*      arena,
                            uintptr_t**       args_out,
-                           unsigned long**   args_len_out,
-                           char***           allocated_strings,
-                           int*              allocated_count);
+                           unsigned long**   args_len_out);
 
 /**
  * Prepare complex range Z-command arguments with options
  */
 int prepare_z_complex_range_args(z_command_args_t* args,
+                                 arg_arena_t*      arena,
                                  uintptr_t**       args_out,
                                  enum RequestType  cmd_type,
-                                 unsigned long**   args_len_out,
-                                 char***           allocated_strings,
-                                 int*              allocated_count);
+                                 unsigned long**   args_len_out);
 
 /**
  * Prepare store command arguments (destination + numkeys + keys + weights + aggregate)
  */
 int prepare_z_store_args(z_command_args_t* args,
+                         arg_arena_t*      arena,
                          uintptr_t**       args_out,
-                         unsigned long**   args_len_out,
-                         char***           allocated_strings,
-                         int*              allocated_count);
+                         unsigned long**   args_len_out);
 
 /**
  * Prepare ZINTERCARD command arguments (numkeys + keys + optional LIMIT)
  */
 int prepare_z_intercard_args(z_command_args_t* args,
+                             arg_arena_t*      arena,
                              uintptr_t**       args_out,
-                             unsigned long**   args_len_out,
-                             char***           allocated_strings,
-                             int*              allocated_count);
+                             unsigned long**   args_len_out);
 
 /**
  * Prepare ZUNION command arguments (numkeys + keys + WEIGHTS + AGGREGATE + WITHSCORES)
  */
 int prepare_z_union_args(z_command_args_t* args,
+                         arg_arena_t*      arena,
                          uintptr_t**       args_out,
-                         unsigned long**   args_len_out,
-                         char***           allocated_strings,
-                         int*              allocated_count);
+                         unsigned long**   args_len_out);
 
 /**
  * Prepare ZPOP command arguments (key + optional count)
  */
 int prepare_z_pop_args(z_command_args_t* args,
+                       arg_arena_t*      arena,
                        uintptr_t**       args_out,
-                       unsigned long**   args_len_out,
-                       char***           allocated_strings,
-                       int*              allocated_count);
+                       unsigned long**   args_len_out);
 
 /**
  * Prepare ZRANGESTORE command arguments (dst + src + start + end + range options)
  */
 int prepare_z_rangestore_args(z_command_args_t* args,
+                              arg_arena_t*      arena,
                               uintptr_t**       args_out,
-                              unsigned long**   args_len_out,
-                              char***           allocated_strings,
-                              int*              allocated_count);
+                              unsigned long**   args_len_out);
 
 /**
  * Prepare ZADD command arguments (key + options + score-member pairs)
  */
 int prepare_z_zadd_args(z_command_args_t* args,
+                        arg_arena_t*      arena,
                         uintptr_t**       args_out,
-                        unsigned long**   args_len_out,
-                        char***           allocated_strings,
-                        int*              allocated_count);
+                        unsigned long**   args_len_out);
 
 /**
  * Prepare ZDIFF command arguments (numkeys + keys + optional WITHSCORES)
  */
 int prepare_z_zdiff_args(z_command_args_t* args,
+                         arg_arena_t*      arena,
                          uintptr_t**       args_out,
-                         unsigned long**   args_len_out,
-                         char***           allocated_strings,
-                         int*              allocated_count);
+                         unsigned long**   args_len_out);
 
 /**
  * Prepare ZRANDMEMBER command arguments (key + optional count + optional WITHSCORES)
  */
 int prepare_z_randmember_args(z_command_args_t* args,
+                              arg_arena_t*      arena,
                               uintptr_t**       args_out,
-                              unsigned long**   args_len_out,
-                              char***           allocated_strings,
-                              int*              allocated_count);
+                              unsigned long**   args_len_out);
 
 /* ====================================================================
  * OPTIONS PARSING HELPERS
@@ -303,7 +299,11 @@ int parse_store_options(zval* weights, zval* options, store_options_t* opts);
  * Prepare keys array from zval for multi-key operations
  * Returns keys count on success, 0 on failure
  */
-int prepare_keys_array(zval* keys, int keys_count, uintptr_t** args, unsigned long** args_len);
+int prepare_keys_array(zval*           keys,
+                       int             keys_count,
+                       arg_arena_t*    arena,
+                       uintptr_t**     args,
+                       unsigned long** args_len);
 
 /**
  * Create LIMIT arguments (offset, count)
@@ -313,8 +313,7 @@ int create_limit_args(range_options_t* opts,
                       uintptr_t*       args,
                       unsigned long*   args_len,
                       int              start_idx,
-                      char**           allocated_strings,
-                      int*             allocated_count);
+                      arg_arena_t*     arena);
 
 /* ====================================================================
  * RESPONSE PROCESSING HELPERS
@@ -345,12 +344,10 @@ int prepare_mpop_arguments(const void*     glide_client,
                            const char*     from,
                            size_t          from_len,
                            long            count,
+                           arg_arena_t*    arena,
                            unsigned long*  arg_count_ptr,
                            uintptr_t**     args_ptr,
-                           unsigned long** args_len_ptr,
-                           char**          numkeys_str_ptr,
-                           char**          timeout_str_ptr,
-                           char**          count_str_ptr);
+                           unsigned long** args_len_ptr);
 /* ====================================================================
  * Z COMMAND IMPLEMENTATION FUNCTIONS (THIN WRAPPERS)
  * ==================================================================== */
@@ -12,6 +12,7 @@
 #include <ext/spl/spl_exceptions.h>
 #include <ext/standard/info.h>
 
+#include "collection_scan_iterator.h"
 #include "command_response.h" /* Include command_response.h for string conversion functions */
 #include "valkey_glide_commands_common.h"
 #include "valkey_glide_geo_common.h"
@@ -170,6 +171,11 @@ ZPOPMIN_METHOD_IMPL(ValkeyGlide)
 ZSCAN_METHOD_IMPL(ValkeyGlide)
 /* }}} */
 
+/* {{{ proto CollectionScanIterator ValkeyGlide::zscanIterator(string key,
+ *                                    [string pattern, long count, long maxCount]) */
+COLLECTION_SCAN_ITERATOR_METHOD_IMPL(ValkeyGlide, zscanIterator, ZScan)
+/* }}} */
+
 /* {{{ proto ValkeyGlide|array|false ValkeyGlide::zmpop(array $keys, string $from, int $count = 1)
  */
 ZMPOP_METHOD_IMPL(ValkeyGlide)
@@ -651,9 +657,11 @@ PHP_METHOD(ValkeyGlide, reset) {
 /* }}} */
 
 /* {{{ proto boolean ValkeyGlide::setOption(long option, mixed value) */
-PHP_METHOD(ValkeyGlide, setOption) {
-    RETURN_FALSE;
-}
+SETOPTION_METHOD_IMPL(ValkeyGlide)
+/* }}} */
+
+/* {{{ proto mixed ValkeyGlide::getOption(long option) */
+GETOPTION_METHOD_IMPL(ValkeyGlide)
 /* }}} */
 
 /* {{{ proto boolean ValkeyGlide::select(int dbindex) */
@@ -893,6 +901,11 @@ SCAN_METHOD_IMPL(ValkeyGlide)
 SSCAN_METHOD_IMPL(ValkeyGlide)
 /* }}} */
 
+/* {{{ proto CollectionScanIterator ValkeyGlide::sscanIterator(string key,
+ *                                    [string pattern, long count, long maxCount]) */
+COLLECTION_SCAN_ITERATOR_METHOD_IMPL(ValkeyGlide, sscanIterator, SScan)
+/* }}} */
+
 /* {{{ proto long ValkeyGlide::copy(string $source, string $destination, array $options = null) */
 COPY_METHOD_IMPL(ValkeyGlide)
 /* }}} */
@@ -901,6 +914,11 @@ COPY_METHOD_IMPL(ValkeyGlide)
 HSCAN_METHOD_IMPL(ValkeyGlide)
 /* }}} */
 
+/* {{{ proto CollectionScanIterator ValkeyGlide::hscanIterator(string key,
+ *                                    [string pattern, long count, long maxCount]) */
+COLLECTION_SCAN_ITERATOR_METHOD_IMPL(ValkeyGlide, hscanIterator, HScan)
+/* }}} */
+
 /* {{{ proto long ValkeyGlide::pfadd(string key, array elements) */
 PFADD_METHOD_IMPL(ValkeyGlide)
 /* }}} */